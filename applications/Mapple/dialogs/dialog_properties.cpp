@@ -30,6 +30,7 @@
 #include <easy3d/core/point_cloud.h>
 #include <easy3d/core/surface_mesh.h>
 #include <easy3d/core/graph.h>
+#include <easy3d/core/scalar_field_statistics.h>
 #include <easy3d/util/file_system.h>
 #include <easy3d/util/string.h>
 #include <easy3d/renderer/renderer.h>
@@ -1033,13 +1034,10 @@ namespace internal {
         else
             color_name += name.substr(2);
 
-        FT min_value = max<FT>();
-        FT max_value = -max<FT>();
-        for (auto v : model->vertices()) {
-            auto value = values[v];
-            min_value = std::min(min_value, value);
-            max_value = std::max(max_value, value);
-        }
+        // the statistics are cached (and shared with the rendering of the scalar field)
+        const auto stats = ScalarFieldStatistics::get(values.array());
+        const FT min_value = static_cast<FT>(stats->min_value());
+        const FT max_value = static_cast<FT>(stats->max_value());
 
         if (epsilon_equal(min_value, max_value, epsilon<FT>())) {
             LOG(ERROR) << "scalar field has an invalid range: [" << min_value << ", " << max_value << "]";
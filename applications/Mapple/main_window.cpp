@@ -64,6 +64,7 @@
 #include <easy3d/fileio/point_cloud_io_ptx.h>
 #include <easy3d/fileio/translator.h>
 #include <easy3d/algo/point_cloud_normals.h>
+#include <easy3d/algo/point_transform.h>
 #include <easy3d/algo/surface_mesh_components.h>
 #include <easy3d/algo/surface_mesh_topology.h>
 #include <easy3d/algo/surface_mesh_triangulation.h>
@@ -998,6 +999,7 @@ void MainWindow::createActionsForViewMenu() {
 
     connect(ui->actionShowEasy3DLogo, SIGNAL(toggled(bool)), viewer_, SLOT(showEasy3DLogo(bool)));
     connect(ui->actionShowFrameRate, SIGNAL(toggled(bool)), viewer_, SLOT(showFrameRate(bool)));
+    connect(ui->actionShowFrameProfiler, SIGNAL(toggled(bool)), viewer_, SLOT(showFrameProfiler(bool)));
     connect(ui->actionShowAxes, SIGNAL(toggled(bool)), viewer_, SLOT(showAxes(bool)));
 
     connect(ui->actionShowCameraPath, SIGNAL(toggled(bool)), this, SLOT(setShowCameraPath(bool)));
@@ -2102,23 +2104,9 @@ void MainWindow::applyManipulatedTransformation() {
 
     for (auto m : models) {
         auto model = m.get();
-        mat4 manip = model->manipulator()->matrix();
-        auto &points = model->points();
-        for (auto &p: points)
-            p = manip * p;
-
-        if (dynamic_cast<SurfaceMesh *>(model)) {
-            dynamic_cast<SurfaceMesh *>(model)->update_vertex_normals();
-        } else if (dynamic_cast<PointCloud *>(model)) {
-            auto cloud = dynamic_cast<PointCloud *>(model);
-            auto normal = cloud->get_vertex_property<vec3>("v:normal");
-            if (normal) {
-                const mat3 &N = transform::normal_matrix(manip);
-                for (auto v: cloud->vertices())
-                    normal[v] = N * normal[v];
-                // vector fields...
-            }
-        }
+        const mat4 manip = model->manipulator()->matrix();
+        // transforms the points and the normals
+        PointTransform::apply(model, manip);
         model->manipulator()->reset();
         model->renderer()->update();
     }
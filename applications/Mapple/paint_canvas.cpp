@@ -54,6 +54,8 @@
 #include <easy3d/renderer/soft_shadow.h>
 #include <easy3d/renderer/dual_depth_peeling.h>
 #include <easy3d/renderer/eye_dome_lighting.h>
+#include <easy3d/renderer/progressive_refinement.h>
+#include <easy3d/renderer/frame_profiler.h>
 #include <easy3d/renderer/opengl_util.h>
 #include <easy3d/renderer/opengl_error.h>
 #include <easy3d/renderer/clipping_plane.h>
@@ -89,6 +91,7 @@ PaintCanvas::PaintCanvas(MainWindow* window)
         , texter_(nullptr)
         , show_easy3d_logo_(true)
         , show_frame_rate_(false)
+        , show_frame_profiler_(false)
         , dpi_scaling_(1.0)
         , samples_(0)
         , camera_(nullptr)
@@ -112,6 +115,7 @@ PaintCanvas::PaintCanvas(MainWindow* window)
         , show_coordinates_under_mouse_(false)
         , model_idx_(-1)
         , ssao_(nullptr)
+        , refinement_(nullptr)
 {
     // like Qt::StrongFocus plus the widget accepts focus by using the mouse wheel.
     setFocusPolicy(Qt::StrongFocus);
@@ -129,6 +133,7 @@ PaintCanvas::PaintCanvas(MainWindow* window)
     transparency_ = setting::effect_transparency_enabled ? (new DualDepthPeeling(camera_)) : nullptr;
     shadow_ = setting::effect_shadow_enabled ? (new SoftShadow(camera_)) : nullptr;
     edl_ = setting::effect_edl_enabled ? (new EyeDomeLighting(camera_)) : nullptr;
+    refinement_ = new ProgressiveRefinement;
  }
 
 
@@ -154,6 +159,7 @@ void PaintCanvas::cleanup() {
     delete shadow_;
     delete transparency_;
     delete edl_;
+    delete refinement_;
     delete texter_;
     delete model_picker_;
     delete surface_mesh_picker_;
@@ -161,6 +167,7 @@ void PaintCanvas::cleanup() {
 
     ShaderManager::terminate();
     TextureManager::terminate();
+    FrameProfiler::instance()->clear();
 }
 
 
@@ -268,6 +275,13 @@ void PaintCanvas::showFrameRate(bool b) {
 }
 
 
+void PaintCanvas::showFrameProfiler(bool b) {
+    show_frame_profiler_ = b;
+    FrameProfiler::instance()->set_enabled(b);
+    update();
+}
+
+
 void PaintCanvas::showAxes(bool b) {
     if (drawable_axes_) {
         drawable_axes_->set_visible(b);
@@ -401,6 +415,7 @@ void PaintCanvas::mouseReleaseEvent(QMouseEvent *e) {
         if (e->button() == Qt::LeftButton || e->button() == Qt::RightButton)
             show_manip_sphere_ = false;
         camera_->frame()->action_end();
+        refinement_->end_interaction();
         update();
     }
 
@@ -494,6 +509,7 @@ void PaintCanvas::mouseMoveEvent(QMouseEvent *e) {
                 }
             }
 
+            refinement_->begin_interaction();
             int dx = x - mouse_current_pos_.x();
             int dy = y - mouse_current_pos_.y();
             auto axis = ManipulatedFrame::NONE;
@@ -627,6 +643,7 @@ void PaintCanvas::wheelEvent(QWheelEvent *e) {
         const int delta = e->angleDelta().y();
         if (delta <= -1 || delta >= 1) {
             int dy = e->angleDelta().y() > 0 ? 1 : -1;
+            refinement_->touch();
             camera_->frame()->action_zoom(dy, camera_);
         }
     }
@@ -1169,6 +1186,18 @@ void PaintCanvas::paintGL() {
     }
 #endif
 
+    // render a decimated subset of the scene while the camera moves
+    FrameProfiler::instance()->begin_frame();
+    const std::size_t decimation = refinement_->begin_frame();
+    for (auto m : models_) {
+        for (auto d : m->renderer()->points_drawables())
+            d->set_decimation(decimation);
+        for (auto d : m->renderer()->lines_drawables())
+            d->set_decimation(decimation);
+        for (auto d : m->renderer()->triangles_drawables())
+            d->set_decimation(decimation);
+    }
+
     preDraw();
 
     draw();
@@ -1176,6 +1205,12 @@ void PaintCanvas::paintGL() {
     // Add visual hints: axis, camera, grid...
     postDraw();
 
+    // restore the full detail and the filters progressively over the following frames
+    refinement_->end_frame();
+    if (refinement_->needs_refinement())
+        update();
+    FrameProfiler::instance()->end_frame();
+
     Q_EMIT drawFinished();
 }
 
@@ -1362,6 +1397,18 @@ void PaintCanvas::postDraw() {
             texter_->draw(fps_string.toStdString(), 20.0f * dpiScaling(), 50.0f * dpiScaling(), 16, 1);
     }
 
+    // draw the timing of the scopes of the last profiled frame
+    if (show_frame_profiler_ && texter_ && texter_->num_fonts() >=2) {
+        const float font_size = 12.0f;
+        float y = 70.0f * dpiScaling();
+        for (const auto &line : FrameProfiler::instance()->report()) {
+            y += font_size * 1.5f * dpiScaling();
+            if (y > static_cast<float>(height()) * dpiScaling())
+                break;
+            texter_->draw(line, 20.0f * dpiScaling(), y, font_size, 1, vec3(0.8f, 0.2f, 0.0f));
+        }
+    }
+
     // shown only when it is not animating
     if (walkThrough() && !walkThrough()->interpolator()->is_interpolation_started())
         walkThrough()->draw();
@@ -1924,27 +1971,36 @@ void PaintCanvas::draw() {
             surfaces.push_back(d.get());
     }
 
-    if (edl())
+    // the expensive filters are skipped while the camera moves
+    const bool filters = refinement_->effects_allowed();
+
+    if (edl() && filters)
         edl()->begin();
 
-    if (shadow()) {
+    if (shadow() && filters) {
         shadow()->draw(surfaces); easy3d_debug_log_gl_error
         return;
-    } else if (transparency()) {
+    } else if (transparency() && filters) {
         transparency()->draw(surfaces); easy3d_debug_log_gl_error
         return;
     }
     else if (ssao()) {
-        auto ssao_texture = ssao()->generate(models());
+        const unsigned int ssao_texture = filters ? ssao()->generate(models()) : 0;
         for (const auto m : models_) {
             if (!m->renderer()->is_visible())
                 continue;
-            for (auto d : m->renderer()->lines_drawables())
+            for (auto d : m->renderer()->lines_drawables()) {
+                d->enable_ssao(filters);
                 d->set_ssao_texture(ssao_texture);
-            for (auto d : m->renderer()->points_drawables())
+            }
+            for (auto d : m->renderer()->points_drawables()) {
+                d->enable_ssao(filters);
                 d->set_ssao_texture(ssao_texture);
-            for (auto d : m->renderer()->triangles_drawables())
+            }
+            for (auto d : m->renderer()->triangles_drawables()) {
+                d->enable_ssao(filters);
                 d->set_ssao_texture(ssao_texture);
+            }
         }
     }
 
@@ -1981,7 +2037,7 @@ void PaintCanvas::draw() {
         }
     }
 
-    if (edl())
+    if (edl() && filters)
         edl()->end();
 #endif
 
@@ -47,6 +47,7 @@ namespace easy3d {
     class Shadow;
     class Transparency;
     class EyeDomeLighting;
+    class ProgressiveRefinement;
     class TextRenderer;
     class ModelPicker;
     class SurfaceMeshPicker;
@@ -159,6 +160,7 @@ public slots:
 
     void showEasy3DLogo(bool);
     void showFrameRate(bool);
+    void showFrameProfiler(bool);
     void showAxes(bool);
 
     void enableSelectModel(bool b) { allow_select_model_ = b; }
@@ -291,6 +293,7 @@ protected:
 
     bool show_easy3d_logo_;
     bool show_frame_rate_;
+    bool show_frame_profiler_;
 
     float  dpi_scaling_;
     int    samples_;
@@ -335,6 +338,9 @@ protected:
     easy3d::Shadow* shadow_;
 
     easy3d::EyeDomeLighting* edl_;
+
+    // decimated rendering and no filters while the camera moves
+    easy3d::ProgressiveRefinement* refinement_;
 };
 
 
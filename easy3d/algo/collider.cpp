@@ -26,6 +26,10 @@
 
 #include <easy3d/algo/collider.h>
 #include <easy3d/util/stop_watch.h>
+#include <easy3d/util/thread_pool.h>
+
+#include <map>
+#include <algorithm>
 
 #include <3rd_party/opcode/Opcode.h>
 
@@ -35,44 +39,160 @@ using namespace IceMaths;
 
 namespace internal {
 
+    // Builds the Opcode model (i.e., the AABB tree) of a triangle mesh. The vertices are not copied: the mesh
+    // interface directly references the point array of the mesh. Only the triangle indices are collected.
+    Opcode::Model* build_model(const easy3d::SurfaceMesh* mesh) {
+        if (!mesh->is_triangle_mesh()) {
+            LOG(WARNING) << "mesh (" << mesh->name() << ") is not a triangle mesh";
+            return nullptr;
+        }
+
+        if (mesh->n_vertices() <= 0 || mesh->n_faces() <= 0) {
+            LOG(WARNING) << "invalid geometry";
+            return nullptr;
+        }
+
+        if (mesh->has_garbage()) {
+            LOG(WARNING) << "mesh (" << mesh->name() << ") has garbage. Call collect_garbage() first";
+            return nullptr;
+        }
+
+        static_assert(sizeof(Point) == sizeof(easy3d::vec3), "Opcode points and easy3d::vec3 must be layout-compatible");
+        const auto vertices = reinterpret_cast<const Point*>(mesh->points().data());
+
+        auto indices = new IndexedTriangle[mesh->n_faces()];
+        for (const auto& f : mesh->faces()) {
+            auto h = mesh->halfedge(f);
+            const auto v0 = mesh->target(h).idx();
+            h = mesh->next(h);
+            const auto v1 = mesh->target(h).idx();
+            h = mesh->next(h);
+            const auto v2 = mesh->target(h).idx();
+            indices[f.idx()] = IndexedTriangle(v0, v1, v2);
+        }
+
+        auto mesh_interface = new MeshInterface();
+        mesh_interface->SetNbTriangles(mesh->n_faces());
+        mesh_interface->SetNbVertices(mesh->n_vertices());
+        mesh_interface->SetPointers(indices, vertices);
+
+        udword degenerated_faces = mesh_interface->CheckTopology();
+        if (degenerated_faces != 0) {
+            LOG(WARNING) << "model has " << degenerated_faces << " degenerated faces and cannot be processed";
+            delete [] indices;
+            delete mesh_interface;
+            return nullptr;
+        }
+        if (!mesh_interface->IsValid()) {
+            LOG(WARNING) << "the mesh if not valid and cannot be processed";
+            delete [] indices;
+            delete mesh_interface;
+            return nullptr;
+        }
+
+        BuildSettings settings;
+        settings.mLimit = 1;
+        settings.mRules = SPLIT_SPLATTER_POINTS | SPLIT_GEOM_CENTER;
+
+        OPCODECREATE data;
+        data.mIMesh = mesh_interface;
+        data.mCanRemap = false;
+        data.mKeepOriginal = false;
+        data.mNoLeaf = true;
+        data.mQuantized = true;
+        data.mSettings = settings;
+
+        auto model = new Opcode::Model();
+        if (!model->Build(data)) {
+            LOG(WARNING) << "failed building AABB tree for the mesh";
+            delete [] indices;
+            delete mesh_interface;
+            delete model;
+            return nullptr;
+        }
+        return model;
+    }
+
+
+    // Releases an Opcode model created by build_model(). The vertices are owned by the mesh.
+    void destroy_model(Opcode::Model* model) {
+        if (!model)
+            return;
+        auto mesh_interface = model->GetMeshInterface();
+        delete [] mesh_interface->GetTris();
+        delete mesh_interface;
+        delete model;
+    }
+
+
+    // Opcode requires the 'world' matrix, which is the transpose of easy3d's matrix
+    Matrix4x4 to_opcode(const easy3d::mat4& m) {
+        Matrix4x4 result;
+        for (auto i = 0; i < 4; ++i) {
+            for (auto j = 0; j < 4; ++j)
+                result[i][j] = m(j, i);
+        }
+        return result;
+    }
+
+
+    // Creates the collider for the narrow phase (i.e., reports all intersecting face pairs)
+    AABBTreeCollider* create_tree_collider() {
+        auto collider = new AABBTreeCollider;
+        collider->SetFirstContact(false);
+        collider->SetTemporalCoherence(false);
+        collider->SetPrimitiveTests(true);
+        const char* msg = collider->ValidateSettings();
+        if (msg) {
+            LOG(WARNING) << "failed setting AABB tree collider: " << msg;
+            delete collider;
+            return nullptr;
+        }
+        return collider;
+    }
+
+
+    // Tests two models and collects the intersecting face pairs into 'result'
+    bool collide(AABBTreeCollider* collider, Opcode::Model* model0, Opcode::Model* model1,
+                 const Matrix4x4& trans0, const Matrix4x4& trans1,
+                 std::vector<std::pair<easy3d::SurfaceMesh::Face, easy3d::SurfaceMesh::Face> >& result)
+    {
+        result.clear();
+
+        BVTCache cache;
+        cache.Model0 = model0;
+        cache.Model1 = model1;
+        if (!collider->Collide(cache, &trans0, &trans1)) {
+            LOG(WARNING) << "failed detecting collision";
+            return false;
+        }
+
+        if (collider->GetContactStatus()) {
+            const udword num = collider->GetNbPairs();
+            result.resize(num);
+            const Pair* pairs = collider->GetPairs();
+            for (udword i = 0; i < num; ++i) {
+                const Pair& pair = pairs[i];
+                result[i] = { easy3d::SurfaceMesh::Face(static_cast<int>(pair.id0)), easy3d::SurfaceMesh::Face(static_cast<int>(pair.id1)) };
+            }
+        }
+        return true;
+    }
+
+
     class ColliderImpl {
     public:
-        ColliderImpl(easy3d::SurfaceMesh *mesh0, easy3d::SurfaceMesh *mesh1) {
-            model0_ = build(mesh0);
-            model1_ = build(mesh1);
+        ColliderImpl(easy3d::SurfaceMesh *mesh0, easy3d::SurfaceMesh *mesh1) : collider_(nullptr) {
+            model0_ = build_model(mesh0);
+            model1_ = build_model(mesh1);
             if (!model0_ || !model1_)
                 return;
-
-            cache_ = new BVTCache;
-            cache_->Model0 = model0_;
-            cache_->Model1 = model1_;
-
-            collider_ = new AABBTreeCollider;
-            collider_->SetFirstContact(false);
-            collider_->SetTemporalCoherence(false);
-            collider_->SetPrimitiveTests(true);
-            const char* msg = collider_->ValidateSettings();
-            if (msg) {
-                LOG(WARNING) << "failed setting AABB tree collider: " << msg;
-                delete collider_;
-                collider_ = nullptr;
-            }
+            collider_ = create_tree_collider();
         }
 
         ~ColliderImpl() {
-            auto mesh0_interface = model0_->GetMeshInterface();
-            delete [] mesh0_interface->GetTris();
-            delete [] mesh0_interface->GetVerts();
-            delete mesh0_interface;
-            delete model0_;
-
-            auto mesh1_interface = model1_->GetMeshInterface();
-            delete [] mesh1_interface->GetTris();
-            delete [] mesh1_interface->GetVerts();
-            delete mesh1_interface;
-            delete model1_;
-
-            delete cache_;
+            destroy_model(model0_);
+            destroy_model(model1_);
             delete collider_;
         }
 
@@ -84,97 +204,180 @@ namespace internal {
                 return result;
             }
 
-            Matrix4x4 trans0, trans1;
-            for (auto i = 0; i < 4; ++i) {
-                for (auto j = 0; j < 4; ++j) {
-                    // ToDo: Why transpose? (opcode requires 'world' matrix)
-                    trans0[i][j] = t0(j, i);
-                    trans1[i][j] = t1(j, i);
-                }
-            }
-
-            if (!collider_->Collide(*cache_, &trans0, &trans1)) {
-                LOG(WARNING) << "failed detecting collision";
-                return result;
-            }
-
-            if (collider_->GetContactStatus()) {
-                const udword num = collider_->GetNbPairs();
-                result.resize(num);
-                const Pair* pairs = collider_->GetPairs();
-                for (udword i = 0; i < num; ++i) {
-                    const Pair& pair = pairs[i];
-                    result[i] = { easy3d::SurfaceMesh::Face(static_cast<int>(pair.id0)), easy3d::SurfaceMesh::Face(static_cast<int>(pair.id1)) };
-                }
-            }
+            collide(collider_, model0_, model1_, to_opcode(t0), to_opcode(t1), result);
             return result;
         }
 
     private:
-        Opcode::Model* build(const easy3d::SurfaceMesh* mesh) {
-            if (!mesh->is_triangle_mesh()) {
-                LOG(WARNING) << "the first mesh (" << mesh->name() << ") is not a triangle mesh";
-                return nullptr;
-            }
+        Opcode::Model* model0_;
+        Opcode::Model* model1_;
+        AABBTreeCollider* collider_;
+    };
+
+
+    class SceneColliderImpl {
+    public:
+        typedef easy3d::SceneCollider::Contact Contact;
+
+        SceneColliderImpl() : broad_phase_pairs_(0), narrow_phase_pairs_(0) {}
+
+        ~SceneColliderImpl() {
+            for (auto& body : bodies_)
+                destroy_model(body.model);
+        }
 
-            if (mesh->n_vertices() <= 0 || mesh->n_faces() <= 0) {
-                LOG(WARNING) << "invalid geometry";
-                return nullptr;
+        int add_mesh(easy3d::SurfaceMesh *mesh, const easy3d::mat4 &transform) {
+            if (!mesh)
+                return -1;
+            Opcode::Model* model = build_model(mesh);
+            if (!model)
+                return -1;
+
+            Body body;
+            body.mesh = mesh;
+            body.model = model;
+            body.local_box = mesh->bounding_box(true);
+            body.revision = 0;
+            bodies_.push_back(body);
+
+            const int id = static_cast<int>(bodies_.size()) - 1;
+            set_transform(id, transform);
+            order_.push_back(id);
+            return id;
+        }
+
+        void set_transform(int id, const easy3d::mat4 &transform) {
+            Body& body = bodies_[id];
+            body.transform = transform;
+            body.world = to_opcode(transform);
+            ++body.revision;
+
+            // the world bounding box of the (transformed) local bounding box
+            body.world_box.clear();
+            const easy3d::vec3& a = body.local_box.min_point();
+            const easy3d::vec3& b = body.local_box.max_point();
+            for (int i = 0; i < 8; ++i) {
+                const easy3d::vec3 corner((i & 1) ? b.x : a.x, (i & 2) ? b.y : a.y, (i & 4) ? b.z : a.z);
+                body.world_box.grow(transform * corner);
             }
+        }
 
-            const auto& pts = mesh->points();
-            auto vertices = new Point[pts.size()];
-            for (std::size_t i=0; i<pts.size(); ++i)
-                    vertices[i].Set(pts[i]);
-
-            auto indices = new IndexedTriangle[mesh->n_faces()];
-            for (const auto& f : mesh->faces()) {
-                    std::vector<int> ids;
-                    for (const auto& v : mesh->vertices(f))
-                            ids.push_back(v.idx());
-                    indices[f.idx()] = IndexedTriangle(ids[0], ids[1], ids[2]);
-                }
+        std::size_t num_meshes() const { return bodies_.size(); }
 
-            auto mesh_interface = new MeshInterface();
-            mesh_interface->SetNbTriangles(mesh->n_faces());
-            mesh_interface->SetNbVertices(mesh->n_vertices());
-            mesh_interface->SetPointers(indices, vertices);
+        const easy3d::mat4& transform(int id) const { return bodies_[id].transform; }
 
-            udword degenerated_faces = mesh_interface->CheckTopology();
-            if (degenerated_faces != 0) {
-                LOG(WARNING) << "model has " << degenerated_faces << " degenerated faces and cannot be processed";
-                return nullptr;
+        // sweep and prune along the x-axis
+        std::vector< std::pair<int, int> > broad_phase() {
+            // the order of the previous frame is almost sorted, for which insertion sort runs in near linear time
+            for (std::size_t i = 1; i < order_.size(); ++i) {
+                const int id = order_[i];
+                const float key = bodies_[id].world_box.min_coord(0);
+                std::size_t j = i;
+                while (j > 0 && bodies_[order_[j - 1]].world_box.min_coord(0) > key) {
+                    order_[j] = order_[j - 1];
+                    --j;
+                }
+                order_[j] = id;
             }
-            if (!mesh_interface->IsValid()) {
-                LOG(WARNING) << "the mesh if not valid and cannot be processed";
-                return nullptr;
+
+            std::vector< std::pair<int, int> > pairs;
+            for (std::size_t i = 0; i < order_.size(); ++i) {
+                const easy3d::Box3& bi = bodies_[order_[i]].world_box;
+                for (std::size_t j = i + 1; j < order_.size(); ++j) {
+                    const easy3d::Box3& bj = bodies_[order_[j]].world_box;
+                    if (bj.min_coord(0) > bi.max_coord(0))
+                        break;
+                    if (bj.min_coord(1) > bi.max_coord(1) || bi.min_coord(1) > bj.max_coord(1) ||
+                        bj.min_coord(2) > bi.max_coord(2) || bi.min_coord(2) > bj.max_coord(2))
+                        continue;
+                    pairs.push_back(std::make_pair(std::min(order_[i], order_[j]), std::max(order_[i], order_[j])));
+                }
             }
+            std::sort(pairs.begin(), pairs.end());
+            return pairs;
+        }
 
-            BuildSettings settings;
-            settings.mLimit = 1;
-            settings.mRules = SPLIT_SPLATTER_POINTS | SPLIT_GEOM_CENTER;
-
-            OPCODECREATE data;
-            data.mIMesh = mesh_interface;
-            data.mCanRemap = false;
-            data.mKeepOriginal = false;
-            data.mNoLeaf = true;
-            data.mQuantized = true;
-            data.mSettings = settings;
-
-            auto model = new Opcode::Model();
-            if (!model->Build(data)) {
-                LOG(WARNING) << "failed building AABB tree for the mesh";
-                return nullptr;
+        std::vector<Contact> detect() {
+            const auto pairs = broad_phase();
+            broad_phase_pairs_ = pairs.size();
+
+            // reuse the results of the pairs for which neither of the two meshes has moved
+            std::map<std::pair<int, int>, CachedPair> cache;
+            std::vector<std::size_t> jobs;
+            for (std::size_t i = 0; i < pairs.size(); ++i) {
+                const auto& p = pairs[i];
+                CachedPair& entry = cache[p];
+                auto pos = cache_.find(p);
+                if (pos != cache_.end() &&
+                    pos->second.revision0 == bodies_[p.first].revision &&
+                    pos->second.revision1 == bodies_[p.second].revision)
+                    entry = pos->second;
+                else {
+                    entry.revision0 = bodies_[p.first].revision;
+                    entry.revision1 = bodies_[p.second].revision;
+                    jobs.push_back(i);
+                }
             }
-            return model;
+            narrow_phase_pairs_ = jobs.size();
+
+            // narrow phase, in parallel (each chunk of pairs has its own tree collider)
+            std::vector< std::vector<std::pair<easy3d::SurfaceMesh::Face, easy3d::SurfaceMesh::Face> > > results(jobs.size());
+            const std::size_t chunk_size = 8;
+            const std::size_t num_chunks = (jobs.size() + chunk_size - 1) / chunk_size;
+            easy3d::parallel_for(std::size_t(0), num_chunks, [&](std::size_t chunk) {
+                AABBTreeCollider* collider = create_tree_collider();
+                if (!collider)
+                    return;
+                for (std::size_t j = chunk * chunk_size; j < std::min(jobs.size(), (chunk + 1) * chunk_size); ++j) {
+                    const auto& p = pairs[jobs[j]];
+                    const Body& b0 = bodies_[p.first];
+                    const Body& b1 = bodies_[p.second];
+                    collide(collider, b0.model, b1.model, b0.world, b1.world, results[j]);
+                }
+                delete collider;
+            }, 1);
+            for (std::size_t j = 0; j < jobs.size(); ++j)
+                cache[pairs[jobs[j]]].faces.swap(results[j]);
+            cache_.swap(cache);
+
+            std::vector<Contact> contacts;
+            for (const auto& entry : cache_) {
+                if (entry.second.faces.empty())
+                    continue;
+                Contact c;
+                c.mesh0 = entry.first.first;
+                c.mesh1 = entry.first.second;
+                c.faces = entry.second.faces;
+                contacts.push_back(c);
+            }
+            return contacts;
         }
 
+        std::size_t broad_phase_pairs() const { return broad_phase_pairs_; }
+        std::size_t narrow_phase_pairs() const { return narrow_phase_pairs_; }
+
     private:
-        Opcode::Model* model0_;
-        Opcode::Model* model1_;
-        BVTCache* cache_;
-        AABBTreeCollider* collider_;
+        struct Body {
+            easy3d::SurfaceMesh* mesh;
+            Opcode::Model* model;
+            easy3d::Box3 local_box;
+            easy3d::Box3 world_box;
+            easy3d::mat4 transform;
+            Matrix4x4 world;
+            unsigned int revision;  // incremented whenever the transformation changes
+        };
+        std::vector<Body> bodies_;
+        std::vector<int> order_;    // the bodies sorted by the minimum x-coordinates of their world bounding boxes
+
+        struct CachedPair {
+            unsigned int revision0;
+            unsigned int revision1;
+            std::vector<std::pair<easy3d::SurfaceMesh::Face, easy3d::SurfaceMesh::Face> > faces;
+        };
+        std::map<std::pair<int, int>, CachedPair> cache_;
+
+        std::size_t broad_phase_pairs_;
+        std::size_t narrow_phase_pairs_;
     };
 }
 
@@ -184,7 +387,7 @@ namespace easy3d {
 
     Collider::Collider(SurfaceMesh *mesh0, SurfaceMesh *mesh1) {
         StopWatch w;
-        collider_ = new internal::ColliderImpl(mesh0, mesh1);
+        collider_ = new ::internal::ColliderImpl(mesh0, mesh1);
         LOG(INFO) << "building the collider (AABB trees): " << w.time_string();
     }
 
@@ -197,4 +400,63 @@ namespace easy3d {
     std::vector<std::pair<SurfaceMesh::Face, SurfaceMesh::Face> > Collider::detect(const mat4 &t0, const mat4 &t1) const {
         return collider_->detect(t0, t1);
     }
+
+
+    SceneCollider::SceneCollider() {
+        collider_ = new ::internal::SceneColliderImpl;
+    }
+
+
+    SceneCollider::~SceneCollider() {
+        delete collider_;
+    }
+
+
+    int SceneCollider::add_mesh(SurfaceMesh *mesh, const mat4 &transform) {
+        return collider_->add_mesh(mesh, transform);
+    }
+
+
+    void SceneCollider::set_transform(int id, const mat4 &transform) {
+        if (id < 0 || id >= static_cast<int>(collider_->num_meshes())) {
+            LOG(WARNING) << "invalid mesh id: " << id;
+            return;
+        }
+        collider_->set_transform(id, transform);
+    }
+
+
+    const mat4 &SceneCollider::transform(int id) const {
+        if (id < 0 || id >= static_cast<int>(collider_->num_meshes())) {
+            LOG(ERROR) << "invalid mesh id: " << id;
+            static const mat4 identity = mat4::identity();
+            return identity;
+        }
+        return collider_->transform(id);
+    }
+
+
+    std::size_t SceneCollider::num_meshes() const {
+        return collider_->num_meshes();
+    }
+
+
+    std::vector<std::pair<int, int> > SceneCollider::candidate_pairs() {
+        return collider_->broad_phase();
+    }
+
+
+    std::vector<SceneCollider::Contact> SceneCollider::detect() {
+        return collider_->detect();
+    }
+
+
+    std::size_t SceneCollider::num_broad_phase_pairs() const {
+        return collider_->broad_phase_pairs();
+    }
+
+
+    std::size_t SceneCollider::num_narrow_phase_pairs() const {
+        return collider_->narrow_phase_pairs();
+    }
 }
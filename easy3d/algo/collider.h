@@ -33,6 +33,7 @@
 
 namespace internal {
     class ColliderImpl;
+    class SceneColliderImpl;
 }
 
 
@@ -55,6 +56,8 @@ namespace easy3d {
          * efficient collision detection.
          * @param mesh0 The first mesh (must be triangle mesh).
          * @param mesh1 The second mesh (must be triangle mesh).
+         * @note The AABB trees reference the vertices of the meshes (instead of keeping a copy of them). So the meshes
+         *      must be alive and their vertices must not change during the lifetime of the collider.
          */
         Collider(SurfaceMesh* mesh0, SurfaceMesh* mesh1);
         ~Collider();
@@ -71,6 +74,90 @@ namespace easy3d {
         internal::ColliderImpl* collider_;
     };
 
+
+    /**
+     * \brief Efficient collision detection for scenes consisting of many meshes.
+     * \details This class generalizes Collider to an arbitrary number of triangle meshes. Each mesh is registered
+     *      once (and its AABB tree is built once). Each call to detect() reports the intersecting face pairs of all
+     *      pairs of colliding meshes:
+     *          - the broad phase finds the pairs of meshes whose (transformed) bounding boxes overlap, using an
+     *            incremental sweep-and-prune;
+     *          - the narrow phase tests the candidate pairs in parallel using Opcode;
+     *          - the result of a pair is reused if neither of its meshes has been moved since the last call. So if
+     *            only a few meshes move, only the pairs involving them are re-tested.
+     *      Example usage:
+     *      \code
+     *          SceneCollider collider;
+     *          for (auto mesh : meshes)
+     *              collider.add_mesh(mesh, transformation_of(mesh));
+     *          // for each frame
+     *          collider.set_transform(id, new_transformation); // for the meshes that have moved
+     *          const auto contacts = collider.detect();
+     *      \endcode
+     * \class SceneCollider easy3d/algo/collider.h
+     */
+    class SceneCollider {
+    public:
+        /// \brief The intersecting face pairs of two colliding meshes.
+        struct Contact {
+            int mesh0;  ///< The id of the first mesh.
+            int mesh1;  ///< The id of the second mesh (always greater than \c mesh0).
+            std::vector< std::pair<SurfaceMesh::Face, SurfaceMesh::Face> > faces; ///< The intersecting face pairs.
+        };
+
+    public:
+        SceneCollider();
+        ~SceneCollider();
+
+        /// \brief Copying is not allowed (the collider owns its implementation).
+        SceneCollider(const SceneCollider &) = delete;
+        /// \brief Copying is not allowed (the collider owns its implementation).
+        SceneCollider &operator=(const SceneCollider &) = delete;
+
+        /**
+         * \brief Registers a mesh. Its AABB tree is built immediately.
+         * @param mesh The mesh (must be a triangle mesh without garbage).
+         * @param transform The initial transformation of the mesh.
+         * @return The id of the mesh, i.e., the number of meshes registered before it. -1 if the mesh is not valid.
+         * @note The AABB tree references the vertices of the mesh (instead of keeping a copy of them). So the mesh
+         *      must be alive and its vertices must not change during the lifetime of the collider.
+         */
+        int add_mesh(SurfaceMesh* mesh, const mat4& transform = mat4::identity());
+
+        /// \brief Returns the number of registered meshes.
+        std::size_t num_meshes() const;
+
+        /**
+         * \brief Updates the transformation of a mesh. Only the pairs involving the meshes whose transformations
+         *      have been updated are re-tested in the next call to detect().
+         */
+        void set_transform(int id, const mat4& transform);
+
+        /// \brief Returns the current transformation of a mesh (or the identity if \p id is invalid).
+        const mat4& transform(int id) const;
+
+        /**
+         * \brief Performs collision detection for all meshes.
+         * @return The contacts (i.e., the intersecting face pairs) of all colliding mesh pairs, ordered by the ids
+         *      of the meshes.
+         */
+        std::vector<Contact> detect();
+
+        /**
+         * \brief Runs only the broad phase.
+         * @return The pairs of mesh ids whose transformed bounding boxes overlap.
+         */
+        std::vector< std::pair<int, int> > candidate_pairs();
+
+        /// \brief Returns the number of candidate pairs found by the broad phase in the last call to detect().
+        std::size_t num_broad_phase_pairs() const;
+        /// \brief Returns the number of pairs actually tested by the narrow phase in the last call to detect().
+        std::size_t num_narrow_phase_pairs() const;
+
+    private:
+        internal::SceneColliderImpl* collider_;
+    };
+
 }
 
 #endif  // EASY3D_ALGO_COLLIDER_H
\ No newline at end of file
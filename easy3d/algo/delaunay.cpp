@@ -10,6 +10,8 @@
 
 
 #include <easy3d/algo/delaunay.h>
+#include <easy3d/kdtree/kdtree_search_nanoflann.h>
+#include <easy3d/util/thread_pool.h>
 #include <algorithm>
 
 
@@ -27,6 +29,47 @@ namespace easy3d {
             }
             return result;
         }
+
+        inline double orient_2d(const float *a, const float *b, const float *c) {
+            return (double(b[0]) - a[0]) * (double(c[1]) - a[1]) - (double(b[1]) - a[1]) * (double(c[0]) - a[0]);
+        }
+
+        inline double orient_3d(const float *a, const float *b, const float *c, const float *d) {
+            const double ab[3] = {double(b[0]) - a[0], double(b[1]) - a[1], double(b[2]) - a[2]};
+            const double ac[3] = {double(c[0]) - a[0], double(c[1]) - a[1], double(c[2]) - a[2]};
+            const double ad[3] = {double(d[0]) - a[0], double(d[1]) - a[1], double(d[2]) - a[2]};
+            return ab[0] * (ac[1] * ad[2] - ac[2] * ad[1])
+                 - ab[1] * (ac[0] * ad[2] - ac[2] * ad[0])
+                 + ab[2] * (ac[0] * ad[1] - ac[1] * ad[0]);
+        }
+
+        // Returns true if the point p and the vertex lf of cell c are strictly on the opposite sides of the face of
+        // cell c opposite to vertex lf, i.e., the walk towards p has to cross this face.
+        inline bool separates(const Delaunay *dt, unsigned int c, unsigned int lf, const float *p) {
+            const float *face[3] = {nullptr, nullptr, nullptr};
+            for (unsigned int lv = 0, k = 0; lv < dt->cell_size(); ++lv) {
+                if (lv != lf)
+                    face[k++] = dt->vertex_ptr(dt->cell_vertex(c, lv));
+            }
+            const float *opposite = dt->vertex_ptr(dt->cell_vertex(c, lf));
+            if (dt->dimension() == 2) {
+                const double s_v = orient_2d(face[0], face[1], opposite);
+                const double s_p = orient_2d(face[0], face[1], p);
+                return (s_v > 0 && s_p < 0) || (s_v < 0 && s_p > 0);
+            } else {
+                const double s_v = orient_3d(face[0], face[1], face[2], opposite);
+                const double s_p = orient_3d(face[0], face[1], face[2], p);
+                return (s_v > 0 && s_p < 0) || (s_v < 0 && s_p > 0);
+            }
+        }
+
+        inline bool contains(const Delaunay *dt, unsigned int c, const float *p) {
+            for (unsigned int lf = 0; lf < dt->cell_size(); ++lf) {
+                if (separates(dt, c, lf, p))
+                    return false;
+            }
+            return true;
+        }
     }
     // \endcond
 
@@ -42,10 +85,13 @@ namespace easy3d {
         cell_to_v_ = nullptr;
         cell_to_cell_ = nullptr;
         is_locked_ = false;
+        kdtree_ = nullptr;
     }
 
 
-    Delaunay::~Delaunay() = default;
+    Delaunay::~Delaunay() {
+        delete kdtree_;
+    }
 
 
     void Delaunay::set_vertices(unsigned int nb_vertices, const float *vertices) {
@@ -54,6 +100,24 @@ namespace easy3d {
         if (nb_vertices_ < dimension() + 1) {
             LOG(WARNING) << "only " << nb_vertices << " vertices? not enough for Delaunay triangulation";
         }
+        build_kdtree();
+    }
+
+
+    void Delaunay::build_kdtree() {
+        delete kdtree_;
+        kdtree_ = nullptr;
+        kdtree_points_.clear();
+        if (nb_vertices_ == 0 || dimension() > 3)
+            return;
+
+        kdtree_points_.resize(nb_vertices_, vec3(0.0f, 0.0f, 0.0f));
+        for (unsigned int i = 0; i < nb_vertices_; ++i) {
+            const float *v = vertex_ptr(i);
+            for (unsigned int d = 0; d < dimension(); ++d)
+                kdtree_points_[i][d] = v[d];
+        }
+        kdtree_ = new KdTreeSearch_NanoFLANN(kdtree_points_);
     }
 
 
@@ -72,9 +136,17 @@ namespace easy3d {
 
 
     unsigned int Delaunay::nearest_vertex(const float *p) const {
-        // Inefficient implementation (but at least it works).
-        std::cerr << "TODO: replace with line walk (or maybe we could use kd-tree here)" << std::endl;
         assert(nb_vertices() > 0);
+        if (kdtree_) {
+            vec3 q(0.0f, 0.0f, 0.0f);
+            for (unsigned int d = 0; d < dimension(); ++d)
+                q[d] = p[d];
+            const int v = kdtree_->find_closest_point(q);
+            if (v >= 0)
+                return static_cast<unsigned int>(v);
+        }
+
+        // no kd-tree for dimensions higher than 3
         unsigned int result = 0;
         float d = internal::squared_distance(dimension(), vertex_ptr(0), p);
         for (unsigned int i = 1; i < nb_vertices(); i++) {
@@ -87,6 +159,78 @@ namespace easy3d {
         return result;
     }
 
+
+    void Delaunay::nearest_vertices(unsigned int nb_points, const float *points, std::vector<unsigned int> &result) const {
+        result.resize(nb_points);
+        if (nb_points == 0 || nb_vertices() == 0)
+            return;
+
+        parallel_for(std::size_t(0), static_cast<std::size_t>(nb_points), [&](std::size_t i) {
+            result[i] = nearest_vertex(points + i * dimension());
+        });
+    }
+
+
+    int Delaunay::locate(const float *p, int hint) const {
+        if (nb_cells() == 0 || dimension() > 3)
+            return -1;
+
+        // jump: start from the given cell, or from a cell incident to the nearest vertex
+        int c = hint;
+        if (c < 0 || c >= static_cast<int>(nb_cells())) {
+            c = vertex_cell(nearest_vertex(p));
+            if (c < 0) // the nearest vertex is a duplicated one (not in the triangulation)
+                c = 0;
+        }
+
+        // walk: cross a face separating the current cell and p, until no such face exists. The face tested first
+        // rotates with the steps, which avoids cycling in degenerate configurations.
+        for (unsigned int step = 0; step < nb_cells(); ++step) {
+            bool moved = false;
+            for (unsigned int k = 0; k < cell_size(); ++k) {
+                const unsigned int lf = (k + step) % cell_size();
+                if (internal::separates(this, c, lf, p)) {
+                    c = cell_adjacent(c, lf);
+                    if (c < 0)  // crossed a face of the convex hull
+                        return -1;
+                    moved = true;
+                    break;
+                }
+            }
+            if (!moved)
+                return c;
+        }
+
+        // should not happen for a valid triangulation, but we don't want to return a wrong answer
+        LOG(WARNING) << "point location by walking failed. Fall back to exhaustive search";
+        for (unsigned int i = 0; i < nb_cells(); ++i) {
+            if (internal::contains(this, i, p))
+                return static_cast<int>(i);
+        }
+        return -1;
+    }
+
+
+    void Delaunay::locate(unsigned int nb_points, const float *points, std::vector<int> &result) const {
+        result.resize(nb_points);
+        if (nb_points == 0)
+            return;
+
+        // the points are processed in chunks, and each chunk walks from its previous result
+        const std::size_t num = nb_points;
+        const std::size_t chunk_size = 1024;
+        const std::size_t num_chunks = (num + chunk_size - 1) / chunk_size;
+        parallel_for(std::size_t(0), num_chunks, [&](std::size_t chunk) {
+            int hint = -1;
+            for (std::size_t i = chunk * chunk_size; i < std::min(num, (chunk + 1) * chunk_size); ++i) {
+                const int c = locate(points + i * dimension(), hint);
+                result[i] = c;
+                if (c >= 0)
+                    hint = c;
+            }
+        }, 1);
+    }
+
     void Delaunay::get_neighbors(unsigned int v, std::vector<unsigned int> &neighbors) const {
         assert(v < nb_vertices());
         if (neighbors_.empty()) {
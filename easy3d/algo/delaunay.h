@@ -18,6 +18,8 @@
 
 namespace easy3d {
 
+    class KdTreeSearch;
+
     /**
      * @brief Base class for Delaunay triangulation.
      * @details This class provides the base functionality for Delaunay triangulation in 2D and 3D.
@@ -37,6 +39,11 @@ namespace easy3d {
         /// @brief Virtual destructor.
         virtual ~Delaunay();
 
+        /// @brief Copying is not allowed (the triangulation owns its kd-tree).
+        Delaunay(const Delaunay &) = delete;
+        /// @brief Copying is not allowed (the triangulation owns its kd-tree).
+        Delaunay &operator=(const Delaunay &) = delete;
+
         /**
          * @brief Returns the dimension of the triangulation.
          * @return The dimension (2 for 2D, 3 for 3D).
@@ -99,11 +106,43 @@ namespace easy3d {
 
         /**
          * @brief Finds the index of the nearest vertex to a given point.
+         * @details The query is answered by a kd-tree built once in set_vertices(), i.e., O(log n) per query.
          * @param p A pointer to the coordinates of the point.
          * @return The index of the nearest vertex.
          */
         virtual unsigned int nearest_vertex(const float *p) const;
 
+        /**
+         * @brief Finds the nearest vertices for a batch of points.
+         * @details The queries are independent and are processed in parallel.
+         * @param nb_points The number of query points.
+         * @param points A pointer to the coordinates of the query points, of size `nb_points * dimension()`.
+         * @param result Returns the index of the nearest vertex of each query point.
+         */
+        void nearest_vertices(unsigned int nb_points, const float *points, std::vector<unsigned int> &result) const;
+
+        /**
+         * @brief Finds the cell (i.e., triangle in 2D or tetrahedron in 3D) containing a given point.
+         * @details This is a jump-and-walk point location: the walk starts from the cell \p hint (if valid) or from a
+         *      cell incident to the nearest vertex (found by the kd-tree), and then crosses the faces that separate
+         *      the current cell from the query point until the point is inside the current cell.
+         * @param p A pointer to the coordinates of the point.
+         * @param hint The cell from which the walk starts. Pass a negative value to let the kd-tree choose one. For
+         *      spatially coherent queries (e.g., grid points), the result of the previous query is a good hint.
+         * @return The index of the cell containing \p p, or -1 if \p p is outside the convex hull of the vertices.
+         */
+        int locate(const float *p, int hint = -1) const;
+
+        /**
+         * @brief Finds the containing cells for a batch of points.
+         * @details The points are processed in parallel. Within each thread the result of a query is used as the
+         *      hint of the next one, so spatially coherent batches (e.g., grid points in scanline order) are cheap.
+         * @param nb_points The number of query points.
+         * @param points A pointer to the coordinates of the query points, of size `nb_points * dimension()`.
+         * @param result Returns the index of the cell containing each query point (-1 if outside the convex hull).
+         */
+        void locate(unsigned int nb_points, const float *points, std::vector<int> &result) const;
+
         /**
          * @brief Returns the index of the `lv`-th vertex in the `c`-th cell.
          * @param c The index of the cell.
@@ -209,6 +248,8 @@ namespace easy3d {
 
         void update_neighbors();
 
+        void build_kdtree();
+
         void set_next_around_vertex(unsigned int c1, unsigned int lv, unsigned int c2) {
             assert(c1 < nb_cells());
             assert(c2 < nb_cells());
@@ -230,6 +271,9 @@ namespace easy3d {
         std::vector<int> cicl_;         ///< Circular linked list for navigating around vertices.
         std::vector<std::vector<unsigned int>> neighbors_; ///< Neighbors of each vertex.
         bool is_locked_;                ///< Whether the triangulation is locked.
+
+        std::vector<vec3> kdtree_points_; ///< The vertices in 3D (2D vertices have z = 0), indexed by the kd-tree.
+        KdTreeSearch *kdtree_;          ///< The kd-tree for nearest vertex queries.
     };
 
 }   // namespace easy3d
@@ -70,6 +70,38 @@ namespace easy3d {
             return nearest_vertex(p.data());
         }
 
+        using Delaunay::nearest_vertices;
+        using Delaunay::locate;
+
+        /**
+         * @brief Finds the nearest vertices for a batch of 2D points.
+         * @param points The query points.
+         * @param result Returns the index of the nearest vertex of each query point.
+         */
+        void nearest_vertices(const std::vector<vec2> &points, std::vector<unsigned int> &result) const {
+            Delaunay::nearest_vertices(static_cast<unsigned int>(points.size()), points.empty() ? nullptr : points[0].data(), result);
+        }
+
+        /**
+         * @brief Finds the triangle containing a given 2D point.
+         * @param p The 2D point.
+         * @param hint The triangle from which the walk starts. A negative value lets the kd-tree choose one.
+         * @return The index of the triangle containing \p p, or -1 if \p p is outside the convex hull.
+         * @see Delaunay::locate()
+         */
+        int locate(const vec2 &p, int hint = -1) const {
+            return Delaunay::locate(p.data(), hint);
+        }
+
+        /**
+         * @brief Finds the containing triangles for a batch of 2D points.
+         * @param points The query points.
+         * @param result Returns the index of the triangle containing each query point (-1 if outside the convex hull).
+         */
+        void locate(const std::vector<vec2> &points, std::vector<int> &result) const {
+            Delaunay::locate(static_cast<unsigned int>(points.size()), points.empty() ? nullptr : points[0].data(), result);
+        }
+
         /**
          * @brief Returns the coordinates of the vertex with index `i`.
          * @param i The index of the vertex.
@@ -28,17 +28,29 @@
 #include <easy3d/algo/gaussian_noise.h>
 
 #include <chrono>
-#include <random>
 
+#include <easy3d/algo/point_transform.h>
 #include <easy3d/core/point_cloud.h>
 #include <easy3d/core/surface_mesh.h>
-#include <easy3d/core/random.h>
 #include <easy3d/util/logging.h>
 
 
 namespace easy3d {
 
+    namespace internal {
+        // a trivial time-based seed
+        uint64_t time_seed() {
+            return static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+        }
+    }
+
+
     void GaussianNoise::apply(SurfaceMesh *mesh, float sigma) {
+        apply(mesh, sigma, internal::time_seed());
+    }
+
+
+    void GaussianNoise::apply(SurfaceMesh *mesh, float sigma, uint64_t seed) {
         if (!mesh) {
             LOG(WARNING) << "empty surface mesh";
             return;
@@ -49,21 +61,7 @@ namespace easy3d {
             return;
         }
 
-        // Define random generator with Gaussian distribution
-        const double mean = 0.0;
-        // construct a trivial random generator engine from a time-based seed:
-        unsigned int seed = (unsigned int) std::chrono::system_clock::now().time_since_epoch().count();
-        std::default_random_engine generator(seed);
-        std::normal_distribution<double> distribution(mean, sigma);
-
-        auto points = mesh->get_vertex_property<vec3>("v:point");
-        for (auto v : mesh->vertices()) {
-            double offset = distribution(generator);
-            vec3 dir(random_float(-1.0f, 1.0f), random_float(-1.0f, 1.0f),
-                     random_float(-1.0f, 1.0f));
-            dir = normalize(dir);
-            points[v] = points[v] + dir * offset;
-        }
+        PointTransform::add_noise(mesh, sigma, seed);
 
         // update normals if exist
         if (mesh->get_vertex_property<vec3>("v:normal"))
@@ -74,6 +72,11 @@ namespace easy3d {
 
 
     void GaussianNoise::apply(PointCloud *cloud, float sigma) {
+        apply(cloud, sigma, internal::time_seed());
+    }
+
+
+    void GaussianNoise::apply(PointCloud *cloud, float sigma, uint64_t seed) {
         if (!cloud) {
             LOG(WARNING) << "empty point cloud";
             return;
@@ -84,21 +87,7 @@ namespace easy3d {
             return;
         }
 
-        // Define random generator with Gaussian distribution
-        const double mean = 0.0;
-        // construct a trivial random generator engine from a time-based seed:
-        unsigned int seed = (unsigned int) std::chrono::system_clock::now().time_since_epoch().count();
-        std::default_random_engine generator(seed);
-        std::normal_distribution<double> distribution(mean, sigma);
-
-        auto points = cloud->get_vertex_property<vec3>("v:point");
-        for (auto v : cloud->vertices()) {
-            double offset = distribution(generator);
-            vec3 dir(random_float(-1.0f, 1.0f), random_float(-1.0f, 1.0f),
-                     random_float(-1.0f, 1.0f));
-            dir = normalize(dir);
-            points[v] = points[v] + dir * offset;
-        }
+        PointTransform::add_noise(cloud, sigma, seed);
     }
 
-}
\ No newline at end of file
+}
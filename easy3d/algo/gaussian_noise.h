@@ -27,6 +27,8 @@
 #ifndef EASY3D_ALGO_GAUSSIAN_NOISE_H
 #define EASY3D_ALGO_GAUSSIAN_NOISE_H
 
+#include <cstdint>
+
 
 namespace easy3d {
 
@@ -34,6 +36,9 @@ namespace easy3d {
     class PointCloud;
 
     /// \brief Add Gaussian noise to 3D models.
+    /// \details The noise is generated in parallel (see PointTransform::add_noise()). The functions taking a seed
+    ///     give the same result for the same seed, no matter how many threads are used. The others use a
+    ///     time-based seed.
     /// \class GaussianNoise easy3d/algo/gaussian_noise.h
     class GaussianNoise {
     public:
@@ -46,6 +51,8 @@ namespace easy3d {
          *              mean), about 95 percent are within two standard deviations (μ ± 2σ).
          */
         static void apply(SurfaceMesh *mesh, float sigma);
+        /// \brief Add Gaussian noise to the surface mesh, using a specified \p seed.
+        static void apply(SurfaceMesh *mesh, float sigma, uint64_t seed);
 
         /**
          * \brief Add Gaussian noise (that has a normal distribution) to a point cloud.
@@ -55,6 +62,8 @@ namespace easy3d {
          *              mean), about 95 percent are within two standard deviations (μ ± 2σ).
          */
         static void apply(PointCloud *cloud, float sigma);
+        /// \brief Add Gaussian noise to the point cloud, using a specified \p seed.
+        static void apply(PointCloud *cloud, float sigma, uint64_t seed);
     };
 
 }
@@ -30,6 +30,12 @@
 #include <easy3d/kdtree/kdtree_search_nanoflann.h>
 
 #include <easy3d/util/stop_watch.h>
+#include <easy3d/util/thread_pool.h>
+
+#include <unordered_map>
+#include <limits>
+#include <algorithm>
+#include <cmath>
 
 
 #ifdef HAS_BOOST
@@ -75,8 +81,7 @@ namespace easy3d {
         w.restart();
         LOG(INFO) << "estimating normals...";
 
-#pragma omp parallel for
-        for (int i = 0; i < num; ++i) {
+        parallel_for(0, num, [&](int i) {
             const vec3 &p = points[i];
             std::vector<int> neighbors;
             kdtree.find_closest_k_points(p, static_cast<int>(k), neighbors);
@@ -95,7 +100,7 @@ namespace easy3d {
             if (compute_curvature)
                 (*curvatures)[i] = float(
                         pca.eigen_value(2) / (pca.eigen_value(0) + pca.eigen_value(1) + pca.eigen_value(2)));
-        }
+        });
 
         LOG(INFO) << "done. " << w.time_string();
         return true;
@@ -461,4 +466,357 @@ namespace easy3d {
 
 #endif
 
+
+    //-------------------------------------------------------------------------------------------------------------
+
+
+    /// A sparse voxel grid, in which each (non-empty) cell stores the indices of the points it contains.
+    class IncrementalPointCloudNormals::VoxelGrid {
+    public:
+        VoxelGrid(const vec3 &origin, float cell_size)
+                : origin_(origin), cell_size_(cell_size), lo_{0, 0, 0}, hi_{0, 0, 0} {}
+
+        struct Key {
+            int x, y, z;
+            bool operator==(const Key &other) const { return x == other.x && y == other.y && z == other.z; }
+        };
+
+        struct KeyHash {
+            std::size_t operator()(const Key &k) const {
+                return (static_cast<std::size_t>(k.x) * 73856093u) ^ (static_cast<std::size_t>(k.y) * 19349663u) ^
+                       (static_cast<std::size_t>(k.z) * 83492791u);
+            }
+        };
+
+        struct Cell {
+            std::vector<int> points;
+            float max_radius2 = 0.0f;   // an upper bound of the radius2 of its points
+        };
+
+        Key key(const vec3 &p) const {
+            return {static_cast<int>(std::floor((p.x - origin_.x) / cell_size_)),
+                    static_cast<int>(std::floor((p.y - origin_.y) / cell_size_)),
+                    static_cast<int>(std::floor((p.z - origin_.z) / cell_size_))};
+        }
+
+        void insert(int idx, const vec3 &p) {
+            const Key k = key(p);
+            if (cells_.empty()) {
+                lo_ = k;
+                hi_ = k;
+            } else {
+                lo_ = {std::min(lo_.x, k.x), std::min(lo_.y, k.y), std::min(lo_.z, k.z)};
+                hi_ = {std::max(hi_.x, k.x), std::max(hi_.y, k.y), std::max(hi_.z, k.z)};
+            }
+            cells_[k].points.push_back(idx);
+        }
+
+        Cell *cell(const Key &k) {
+            auto pos = cells_.find(k);
+            return pos == cells_.end() ? nullptr : &pos->second;
+        }
+
+        const Cell *cell(const Key &k) const {
+            auto pos = cells_.find(k);
+            return pos == cells_.end() ? nullptr : &pos->second;
+        }
+
+        std::size_t num_cells() const { return cells_.size(); }
+
+        const vec3 &origin() const { return origin_; }
+
+        // calls func(key, cell) for each non-empty cell at the Chebyshev distance r from the cell c
+        template<typename Function>
+        void for_each_cell_in_ring(const Key &c, int r, const Function &func) const {
+            for (int x = std::max(c.x - r, lo_.x); x <= std::min(c.x + r, hi_.x); ++x) {
+                for (int y = std::max(c.y - r, lo_.y); y <= std::min(c.y + r, hi_.y); ++y) {
+                    // inside the ring, only the two cells on the top and bottom faces
+                    const bool on_face = (std::abs(x - c.x) == r || std::abs(y - c.y) == r);
+                    const int step = on_face ? 1 : 2 * r;
+                    for (int z = c.z - r; z <= c.z + r; z += step) {
+                        if (z < lo_.z || z > hi_.z)
+                            continue;
+                        const Key k{x, y, z};
+                        const Cell *cl = cell(k);
+                        if (cl)
+                            func(k, *cl);
+                    }
+                }
+            }
+        }
+
+        // calls func(key, cell) for each non-empty cell
+        template<typename Function>
+        void for_each_cell(const Function &func) const {
+            for (const auto &entry : cells_)
+                func(entry.first, entry.second);
+        }
+
+        // the squared distance from p to the cell k
+        float distance2_to_cell(const vec3 &p, const Key &k) const {
+            const int idx[3] = {k.x, k.y, k.z};
+            float d2 = 0.0f;
+            for (int i = 0; i < 3; ++i) {
+                const float lo = origin_[i] + static_cast<float>(idx[i]) * cell_size_;
+                const float d = std::max(std::max(lo - p[i], p[i] - (lo + cell_size_)), 0.0f);
+                d2 += d * d;
+            }
+            return d2;
+        }
+
+        // the distance from p to the boundary of the block of cells within the Chebyshev distance r from c
+        float distance_to_block_boundary(const vec3 &p, const Key &c, int r) const {
+            const int idx[3] = {c.x, c.y, c.z};
+            float d = std::numeric_limits<float>::max();
+            for (int i = 0; i < 3; ++i) {
+                const float lo = origin_[i] + static_cast<float>(idx[i] - r) * cell_size_;
+                const float hi = origin_[i] + static_cast<float>(idx[i] + r + 1) * cell_size_;
+                d = std::min(d, std::min(p[i] - lo, hi - p[i]));
+            }
+            return d;
+        }
+
+        // whether the block of cells within the Chebyshev distance r from c covers all the cells
+        bool covers_all(const Key &c, int r) const {
+            return c.x - r <= lo_.x && c.y - r <= lo_.y && c.z - r <= lo_.z &&
+                   c.x + r >= hi_.x && c.y + r >= hi_.y && c.z + r >= hi_.z;
+        }
+
+        // the k nearest points (sorted by increasing distance) and the squared distance to the k-th one
+        void find_closest_k_points(const vec3 &p, const std::vector<vec3> &points, unsigned int k,
+                                   std::vector<int> &neighbors, float &radius2) const {
+            // a max-heap of (squared distance, index)
+            std::vector<std::pair<float, int> > heap;
+            heap.reserve(k + 1);
+            const Key c = key(p);
+            for (int r = 0;; ++r) {
+                for_each_cell_in_ring(c, r, [&](const Key &, const Cell &cl) {
+                    for (int idx : cl.points) {
+                        const float d2 = distance2(p, points[idx]);
+                        if (heap.size() < k) {
+                            heap.emplace_back(d2, idx);
+                            std::push_heap(heap.begin(), heap.end());
+                        } else if (d2 < heap.front().first) {
+                            std::pop_heap(heap.begin(), heap.end());
+                            heap.back() = std::make_pair(d2, idx);
+                            std::push_heap(heap.begin(), heap.end());
+                        }
+                    }
+                });
+                if (covers_all(c, r))
+                    break;
+                if (heap.size() == k) {
+                    const float d = distance_to_block_boundary(p, c, r);
+                    if (heap.front().first <= d * d)
+                        break;
+                }
+            }
+            std::sort_heap(heap.begin(), heap.end());
+            neighbors.resize(heap.size());
+            for (std::size_t i = 0; i < heap.size(); ++i)
+                neighbors[i] = heap[i].second;
+            // with fewer than k points, any new point will be a neighbor
+            radius2 = heap.size() < k ? std::numeric_limits<float>::max() : heap.back().first;
+        }
+
+    private:
+        vec3 origin_;
+        float cell_size_;
+        Key lo_, hi_;   // the range of the keys of the non-empty cells
+        std::unordered_map<Key, Cell, KeyHash> cells_;
+    };
+
+
+    IncrementalPointCloudNormals::IncrementalPointCloudNormals(PointCloud *cloud, unsigned int k,
+                                                               bool compute_curvature, float cell_size)
+            : cloud_(cloud), k_(std::max(k, 1u)), compute_curvature_(compute_curvature), cell_size_(cell_size),
+              auto_cell_size_(cell_size <= 0.0f), num_processed_(0), max_radius2_(0.0f) {
+        LOG_IF(!cloud, ERROR) << "null input point cloud";
+    }
+
+
+    IncrementalPointCloudNormals::~IncrementalPointCloudNormals() = default;
+
+
+    void IncrementalPointCloudNormals::reset() {
+        grid_.reset();
+        radius2_.clear();
+        max_radius2_ = 0.0f;
+        num_processed_ = 0;
+        if (auto_cell_size_)
+            cell_size_ = 0.0f;
+    }
+
+
+    const IncrementalPointCloudNormals::BatchStats &IncrementalPointCloudNormals::update() {
+        last_batch_ = BatchStats();
+        if (!cloud_)
+            return last_batch_;
+
+        StopWatch w;
+        const PointCloud *cloud = cloud_;
+        const std::vector<vec3> &points = cloud->points();
+        const std::size_t num = points.size();
+        if (num < num_processed_)
+            reset();
+        if (num == num_processed_)
+            return last_batch_;
+
+        const std::size_t first = num_processed_;
+        if (!grid_) {
+            Box3 box;
+            for (std::size_t i = first; i < num; ++i)
+                box.grow(points[i]);
+            if (cell_size_ <= 0.0f) {
+                // about k points in each cell if the points are evenly distributed in the bounding box
+                const float diagonal = box.diagonal_length();
+                const auto n = static_cast<float>(num - first);
+                cell_size_ = diagonal * std::cbrt(std::min(static_cast<float>(k_) / n, 1.0f));
+                if (cell_size_ <= 0.0f)
+                    cell_size_ = 1.0f;
+            }
+            grid_.reset(new VoxelGrid(box.min_point(), cell_size_));
+        }
+
+        for (std::size_t i = first; i < num; ++i)
+            grid_->insert(static_cast<int>(i), points[i]);
+
+        // As the point cloud grows denser, the grid is rebuilt with smaller cells to keep about k points in each
+        // cell (assuming the points are sampled from surfaces). The cells shrink geometrically, so the grid is
+        // rebuilt a logarithmic number of times.
+        while (auto_cell_size_ && static_cast<double>(num) > 4.0 * k_ * static_cast<double>(grid_->num_cells())) {
+            const std::size_t num_cells = grid_->num_cells();
+            cell_size_ *= std::sqrt(static_cast<float>(k_ * num_cells) / static_cast<float>(num));
+            grid_.reset(new VoxelGrid(grid_->origin(), cell_size_));
+            for (std::size_t i = 0; i < num; ++i)
+                grid_->insert(static_cast<int>(i), points[i]);
+            for (std::size_t i = 0; i < first; ++i) {
+                VoxelGrid::Cell *cl = grid_->cell(grid_->key(points[i]));
+                cl->max_radius2 = std::max(cl->max_radius2, radius2_[i]);
+            }
+            if (grid_->num_cells() == num_cells) // e.g., duplicated points
+                break;
+        }
+
+        // The neighborhood of an existing point changes if a new point is closer than its current k-th neighbor.
+        // The radii of the existing points never grow, so the maximum radius of each cell remains an upper bound.
+        std::vector<char> changed(first, 0);
+        if (first > 0) {
+            // the new points grouped by cells
+            std::unordered_map<VoxelGrid::Key, std::vector<int>, VoxelGrid::KeyHash> fresh;
+            for (std::size_t i = first; i < num; ++i)
+                fresh[grid_->key(points[i])].push_back(static_cast<int>(i));
+
+            auto check_cells = [&](const VoxelGrid::Key &key, const VoxelGrid::Cell &cl,
+                                   const VoxelGrid::Key &fresh_key, const std::vector<int> &fresh_points) {
+                // the squared distance between the two cells
+                const int offsets[3] = {fresh_key.x - key.x, fresh_key.y - key.y, fresh_key.z - key.z};
+                float d2 = 0.0f;
+                for (int offset : offsets) {
+                    const float d = static_cast<float>(std::max(std::abs(offset) - 1, 0)) * cell_size_;
+                    d2 += d * d;
+                }
+                if (d2 >= cl.max_radius2)
+                    return;
+                for (int idx : cl.points) {
+                    const auto q = static_cast<std::size_t>(idx);
+                    if (q >= first || changed[q])
+                        continue;
+                    for (int i : fresh_points) {
+                        if (distance2(points[i], points[q]) < radius2_[q]) {
+                            changed[q] = 1;
+                            break;
+                        }
+                    }
+                }
+            };
+
+            // only the cells within the maximum radius from the new points can have affected points
+            const double rings = std::ceil(std::sqrt(static_cast<double>(max_radius2_)) / cell_size_);
+            std::size_t visited = 0;
+            auto visit = [&](const VoxelGrid::Key &key, const VoxelGrid::Cell &cl,
+                             const VoxelGrid::Key &fresh_key, const std::vector<int> &fresh_points) {
+                ++visited;
+                if (cl.max_radius2 > 0.0f) // not only new points (or duplicated ones)
+                    check_cells(key, cl, fresh_key, fresh_points);
+            };
+            // visit all the cells if there are fewer than those within the maximum radius (e.g., the first batches)
+            if (std::pow(2.0 * rings + 1.0, 3.0) > static_cast<double>(grid_->num_cells())) {
+                for (const auto &entry : fresh) {
+                    grid_->for_each_cell([&](const VoxelGrid::Key &key, const VoxelGrid::Cell &cl) {
+                        visit(key, cl, entry.first, entry.second);
+                    });
+                }
+            } else {
+                const int r = static_cast<int>(rings);
+                for (const auto &entry : fresh) {
+                    for (int i = 0; i <= r; ++i) {
+                        grid_->for_each_cell_in_ring(entry.first, i, [&](const VoxelGrid::Key &key,
+                                                                         const VoxelGrid::Cell &cl) {
+                            visit(key, cl, entry.first, entry.second);
+                        });
+                    }
+                }
+            }
+            last_batch_.visited_cells = visited;
+        }
+
+        std::vector<int> targets;
+        for (std::size_t i = 0; i < first; ++i) {
+            if (changed[i])
+                targets.push_back(static_cast<int>(i));
+        }
+        last_batch_.updated_points = targets.size();
+        last_batch_.new_points = num - first;
+        for (std::size_t i = first; i < num; ++i)
+            targets.push_back(static_cast<int>(i));
+
+        radius2_.resize(num, 0.0f);
+        std::vector<vec3> &normals = cloud_->vertex_property<vec3>("v:normal").vector();
+        std::vector<float> *curvatures = nullptr;
+        if (compute_curvature_)
+            curvatures = &(cloud_->vertex_property<float>("v:curvature").vector());
+
+        // the same as PointCloudNormals::estimate()
+        const VoxelGrid &grid = *grid_;
+        parallel_for(std::size_t(0), targets.size(), [&](std::size_t j) {
+            const int i = targets[j];
+            std::vector<int> neighbors;
+            grid.find_closest_k_points(points[i], points, k_, neighbors, radius2_[i]);
+
+            PrincipalAxes<3> pca;
+            pca.begin();
+            for (auto idx : neighbors)
+                pca.add(points[idx]);
+            pca.end();
+
+            // the eigen vector corresponding to the smallest eigen value
+            normals[i] = pca.axis<float>(2);
+            if (normals[i].z < 0) // almost have positive Z
+                normals[i] = -normals[i];
+
+            if (curvatures)
+                (*curvatures)[i] = float(
+                        pca.eigen_value(2) / (pca.eigen_value(0) + pca.eigen_value(1) + pca.eigen_value(2)));
+        });
+
+        for (std::size_t i = first; i < num; ++i) {
+            VoxelGrid::Cell *cl = grid_->cell(grid_->key(points[i]));
+            cl->max_radius2 = std::max(cl->max_radius2, radius2_[i]);
+        }
+
+        // With fewer than k points, the radii are unbounded. Then all the points have been updated, and the
+        // bound is computed from scratch.
+        if (max_radius2_ == std::numeric_limits<float>::max())
+            max_radius2_ = *std::max_element(radius2_.begin(), radius2_.end());
+        else {
+            for (int i : targets)
+                max_radius2_ = std::max(max_radius2_, radius2_[i]);
+        }
+
+        num_processed_ = num;
+        last_batch_.seconds = w.elapsed_seconds(5);
+        return last_batch_;
+    }
+
 }
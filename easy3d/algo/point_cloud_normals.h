@@ -27,6 +27,10 @@
 #ifndef EASY3D_ALGO_POINT_CLOUD_NORMALS_H
 #define EASY3D_ALGO_POINT_CLOUD_NORMALS_H
 
+#include <memory>
+#include <vector>
+#include <cstddef>
+
 
 namespace easy3d {
 
@@ -63,6 +67,90 @@ namespace easy3d {
     };
 
 
+
+    /**
+     * \brief Estimates the normals of a growing point cloud incrementally, e.g., when the points of a live scan
+     *      arrive in batches.
+     * \details The points are indexed by a hashed voxel grid, which (unlike a kd-tree) is updated by inserting the
+     *      new points only. Each call to update() processes the points added to the point cloud since the last
+     *      call: it estimates the normals of the new points and re-estimates those of the existing points whose k
+     *      nearest neighbors have changed (i.e., a new point is closer than their current k-th neighbor). These
+     *      points are searched for only in the cells around the new points, within the largest k-th neighbor
+     *      distance of the processed points. So the cost of a batch depends on its size (and the sampling density)
+     *      rather than on the size of the whole point cloud. The normals are
+     *      written into the "v:normal" property in place, and the results are the same as those of
+     *      PointCloudNormals::estimate() on the whole point cloud.
+     *      Example usage:
+     *      \code
+     *          IncrementalPointCloudNormals estimator(cloud, 16);
+     *          while (scanning) {
+     *              cloud->add_vertices(next_batch());
+     *              const auto& stats = estimator.update();
+     *              LOG(INFO) << stats.new_points << " new points, " << stats.updated_points << " updated points";
+     *          }
+     *      \endcode
+     * \note The points must not be modified or deleted between the updates, except by clearing the point cloud.
+     * \class IncrementalPointCloudNormals easy3d/algo/point_cloud_normals.h
+     */
+    class IncrementalPointCloudNormals {
+    public:
+        /// \brief The cost of processing a batch of points.
+        struct BatchStats {
+            std::size_t new_points = 0;       ///< the number of new points
+            std::size_t updated_points = 0;   ///< the number of existing points whose normals were re-estimated
+            std::size_t visited_cells = 0;    ///< the number of non-empty cells searched for the affected points
+            double seconds = 0.0;             ///< the time (in seconds) of processing the batch
+        };
+
+        /**
+         * \brief Constructor.
+         * \param cloud The point cloud, which may be empty (or already have some points).
+         * \param k The number of neighboring points to construct the covariance matrix.
+         * \param compute_curvature Whether to also compute the curvature (stored in "v:curvature").
+         * \param cell_size The size of the cells of the voxel grid. If it is not positive, it is derived from the
+         *      first batch of points, such that a cell contains about k points on average.
+         */
+        explicit IncrementalPointCloudNormals(PointCloud *cloud, unsigned int k = 16, bool compute_curvature = false,
+                                              float cell_size = 0.0f);
+        ~IncrementalPointCloudNormals();
+
+        /**
+         * \brief Estimates the normals of the points added since the last call, and updates the normals of the
+         *      existing points affected by the new points.
+         * \details If the point cloud has fewer points than processed before (e.g., it has been cleared), all the
+         *      points are processed again.
+         * \return The cost of processing the batch.
+         */
+        const BatchStats &update();
+
+        /// \brief Returns the cost of the last batch.
+        const BatchStats &last_batch() const { return last_batch_; }
+
+        /// \brief Returns the number of points that have been processed.
+        std::size_t num_processed() const { return num_processed_; }
+
+        /// \brief Forgets all the processed points, i.e., the next update() processes all the points.
+        void reset();
+
+    private:
+        PointCloud *cloud_;
+        unsigned int k_;
+        bool compute_curvature_;
+        float cell_size_;
+        bool auto_cell_size_;
+
+        std::size_t num_processed_;
+        // the squared distance of each processed point to its k-th nearest neighbor
+        std::vector<float> radius2_;
+        // an upper bound of radius2_ (it may be loose because the radii only shrink)
+        float max_radius2_;
+        BatchStats last_batch_;
+
+        class VoxelGrid;
+        std::unique_ptr<VoxelGrid> grid_;
+    };
+
+
 } // namespace easy3d
 
 
@@ -27,11 +27,15 @@
 #include <easy3d/algo/point_cloud_poisson_reconstruction.h>
 
 #include <algorithm>
+#include <unordered_map>
+#include <cmath>
 
 #include <easy3d/core/surface_mesh.h>
+#include <easy3d/core/surface_mesh_builder.h>
 #include <easy3d/core/point_cloud.h>
 #include <easy3d/util/file_system.h>
 #include <easy3d/util/stop_watch.h>
+#include <easy3d/util/thread_pool.h>
 
 #include <3rd_party/poisson/MyTime.h>
 #include <3rd_party/poisson/MemoryUsage.h>
@@ -92,24 +96,109 @@ namespace easy3d {
 
 
     PoissonReconstruction::PoissonReconstruction()
-            : depth_(8), samples_per_node_(1.0f), triangulate_mesh_(true) {
+            : depth_(8), samples_per_node_(1.0f), triangulate_mesh_(true), chunk_size_(65536), tiles_(1),
+              tile_overlap_(0.1f) {
         // other default parameters
         full_depth_ = 5;
         cgDepth_ = 0;
         scale_ = 1.1f;
         pointWeight_ = 4.0f;
         gsIter_ = 8;
-        threads_ = omp_get_num_procs();
-        LOG(INFO) << "number of threads: " << threads_;
+        threads_ = static_cast<int>(ThreadPool::instance()->num_threads());
 
         verbose_ = false;
     }
 
     PoissonReconstruction::~PoissonReconstruction() = default;
 
+
+    void PoissonReconstruction::set_threads(int n) {
+        threads_ = (n > 0) ? n : static_cast<int>(ThreadPool::instance()->num_threads());
+    }
+
+
     // \cond
     namespace internal {
 
+        // Streams the (transformed) points of a point cloud into the octree chunk by chunk. The points are read from
+        // the property arrays of the point cloud directly, optionally through a list of point indices.
+        class PointCloudStream : public OrientedPointStreamWithData<REAL, Point3D<REAL> > {
+        public:
+            PointCloudStream(const float *pts, const float *nms, const float *cls, std::size_t num,
+                             const std::vector<int> *indices, const XForm4x4<REAL> &xForm,
+                             std::size_t chunk_size, int threads)
+                    : pts_(pts), nms_(nms), cls_(cls), indices_(indices), xForm_(xForm),
+                      chunk_size_(std::max<std::size_t>(chunk_size, 1)), threads_(threads), next_(0), pos_(0) {
+                num_ = indices ? indices->size() : num;
+                for (int i = 0; i < 3; i++)
+                    for (int j = 0; j < 3; j++)
+                        normalXForm_(i, j) = xForm(i, j);
+                normalXForm_ = normalXForm_.transpose().inverse();
+            }
+
+            void reset() override {
+                next_ = 0;
+                pos_ = 0;
+                points_.clear();
+                colors_.clear();
+            }
+
+            bool nextPoint(OrientedPoint3D<REAL> &p, Point3D<REAL> &d) override {
+                if (pos_ == points_.size()) {
+                    if (!read_chunk())
+                        return false;
+                }
+                p = points_[pos_];
+                if (cls_)
+                    d = colors_[pos_];
+                ++pos_;
+                return true;
+            }
+
+        private:
+            bool read_chunk() {
+                if (next_ >= num_)
+                    return false;
+                const std::size_t count = std::min(chunk_size_, num_ - next_);
+                points_.resize(count);
+                if (cls_)
+                    colors_.resize(count);
+
+#pragma omp parallel for num_threads(threads_)
+                for (int i = 0; i < static_cast<int>(count); ++i) {
+                    const std::size_t idx = indices_ ? static_cast<std::size_t>((*indices_)[next_ + i]) : next_ + i;
+                    const float *p = pts_ + idx * 3;
+                    const float *n = nms_ + idx * 3;
+                    points_[i].p = xForm_ * Point3D<REAL>(p[0], p[1], p[2]);
+                    points_[i].n = normalXForm_ * Point3D<REAL>(n[0], n[1], n[2]);
+                    if (cls_) {   // the color range in Misha's code is [0, 255]
+                        const float *c = cls_ + idx * 3;
+                        colors_[i] = Point3D<REAL>(c[0] * 255, c[1] * 255, c[2] * 255);
+                    }
+                }
+
+                next_ += count;
+                pos_ = 0;
+                return true;
+            }
+
+        private:
+            const float *pts_;
+            const float *nms_;
+            const float *cls_;
+            const std::vector<int> *indices_;
+            std::size_t num_;
+            XForm4x4<REAL> xForm_;
+            XForm3x3<REAL> normalXForm_;
+            std::size_t chunk_size_;
+            int threads_;
+
+            std::size_t next_;  // the next point to read
+            std::size_t pos_;   // the next point in the current chunk
+            std::vector<OrientedPoint3D<REAL> > points_;
+            std::vector<Point3D<REAL> > colors_;
+        };
+
         template<class Vertex>
         SurfaceMesh *
         convert_to_mesh(CoredFileMeshData<Vertex> &mesh, const XForm4x4<REAL> &iXForm,
@@ -202,6 +291,35 @@ namespace easy3d {
             return nullptr;
         }
 
+        LOG(INFO) << "Screened Poisson Reconstruction (V9.0.1)";
+        StopWatch w;
+        profile_ = Profile();
+
+        SurfaceMesh *result = nullptr;
+        if (tiles_ > 1)
+            result = reconstruct_tiled(cloud, density_attr_name);
+        else
+            result = reconstruct(cloud, nullptr, cloud->bounding_box(), density_attr_name);
+
+        profile_.total = w.elapsed_seconds(3);
+        if (result) {
+            const std::string &file_name = file_system::name_less_extension(cloud->name()) + "_Poisson.ply";
+            result->set_name(file_name);
+        }
+        LOG(INFO) << "total reconstruction time: " << w.time_string();
+        if (verbose_) {
+            LOG(INFO) << " - Profile (s): octree " << profile_.octree << ", solve " << profile_.solve
+                      << ", extraction " << profile_.extraction << ", stitching " << profile_.stitching;
+        }
+
+        return result;
+    }
+
+
+    SurfaceMesh *PoissonReconstruction::reconstruct(const PointCloud *cloud, const std::vector<int> *indices,
+                                                    const Box3 &box, const std::string &density_attr_name) const {
+        PointCloud::VertexProperty<vec3> normals = cloud->get_vertex_property<vec3>("v:normal");
+
         typedef typename Octree<REAL>::template DensityEstimator<WEIGHT_DEGREE> DensityEstimator;
         typedef typename Octree<REAL>::template InterpolationInfo<false> InterpolationInfo;
 
@@ -222,12 +340,7 @@ namespace easy3d {
             kernelDepth = depth_;
         }
 
-        //////////////////////////////////////////////////////////////////////////
-
-        LOG(INFO) << "Screened Poisson Reconstruction (V9.0.1)";
-        StopWatch t, w;
-
-        //////////////////////////////////////////////////////////////////////////
+        StopWatch t, stage;
 
         int pointCount;
 
@@ -254,8 +367,6 @@ namespace easy3d {
 
             xForm = XForm4x4<REAL>::Identity();
             {
-                const Box3 &box = cloud->bounding_box();
-
                 Point3D<REAL> min_p(box.min_coord(0), box.min_coord(1), box.min_coord(2)), max_p(box.max_coord(0), box.max_coord(1), box.max_coord(2));
                 Point3D<REAL> center = (max_p + min_p) / 2;
                 REAL scale = std::max<REAL>(max_p[0] - min_p[0],
@@ -269,8 +380,8 @@ namespace easy3d {
                 xForm = (sXForm * tXForm) * xForm;
             }
 
-            pointCount = tree.init<Point3D<REAL> >(cloud->n_vertices(), pts, nms, cls, xForm, maxSolveDepth, false,
-                                                   *samples, sampleData);
+            internal::PointCloudStream stream(pts, nms, cls, cloud->n_vertices(), indices, xForm, chunk_size_, threads_);
+            pointCount = tree.init<Point3D<REAL> >(stream, maxSolveDepth, false, *samples, sampleData);
             iXForm = xForm.inverse();
 
 #pragma omp parallel for num_threads(threads_)
@@ -338,6 +449,8 @@ namespace easy3d {
                 LOG(INFO) << "memory usage: " << float(MemoryInfo::Usage()) / (1 << 20) << " MB. "
                           << t.time_string();
             }
+            profile_.octree += stage.elapsed_seconds(3);
+            stage.restart();
 
             // Add the FEM constraints
             {
@@ -395,6 +508,8 @@ namespace easy3d {
                 LOG(INFO) << "memory usage: " << float(MemoryInfo::Usage()) / (1 << 20) << " MB. "
                           << t.time_string();
             }
+            profile_.solve += stage.elapsed_seconds(3);
+            stage.restart();
         }
 
         // 	CoredFileMeshData< PlyVertex< Real > > mesh;		// no depth recorded, so can not trim
@@ -477,10 +592,202 @@ namespace easy3d {
 
         PointCloud::VertexProperty<vec3> colors = cloud->get_vertex_property<vec3>("v:color");
         SurfaceMesh *result = internal::convert_to_mesh(mesh, iXForm, density_attr_name, colors);
-        const std::string &file_name = file_system::name_less_extension(cloud->name()) + "_Poisson.ply";
-        result->set_name(file_name);
-        LOG(INFO) << "total reconstruction time: " << w.time_string();
+        profile_.extraction += stage.elapsed_seconds(3);
+        return result;
+    }
 
+
+    SurfaceMesh *PoissonReconstruction::reconstruct_tiled(const PointCloud *cloud, const std::string &density_attr_name) const {
+        const Box3 &box = cloud->bounding_box();
+        const float edge = box.max_range() / static_cast<float>(tiles_);
+        int dims[3];
+        for (int d = 0; d < 3; ++d)
+            dims[d] = std::max(1, static_cast<int>(std::ceil(box.range(d) / edge - 1e-4f)));
+
+        // The reconstruction of a tile spans (tile + overlap) * scale. We enlarge it slightly such that the size of a
+        // tile is a multiple of the finest grid cell, so the grids of all tiles are aligned and the iso-surfaces of
+        // neighboring tiles intersect the same grid edges near the tile boundaries.
+        const float resolution = std::ldexp(1.0f, depth_);
+        const float span = edge * (1.0f + 2.0f * std::max(tile_overlap_, 0.0f)) * scale_;
+        const int cells_per_tile = std::max(1, static_cast<int>(std::floor(edge * resolution / span)));
+        const float cell = edge / static_cast<float>(cells_per_tile);
+        const float half_size = cell * resolution / scale_ * 0.5f;  // the half size of the reconstruction box
+        const float margin = half_size - edge * 0.5f;
+
+        // assign the points to the tiles (with the overlap)
+        const std::vector<vec3> &points = cloud->points();
+        std::vector<std::vector<int> > tile_points(dims[0] * dims[1] * dims[2]);
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            const vec3 &p = points[i];
+            int lo[3], hi[3];
+            for (int d = 0; d < 3; ++d) {
+                lo[d] = static_cast<int>(std::floor((p[d] - margin - box.min_coord(d)) / edge));
+                hi[d] = static_cast<int>(std::floor((p[d] + margin - box.min_coord(d)) / edge));
+                lo[d] = std::min(std::max(lo[d], 0), dims[d] - 1);
+                hi[d] = std::min(std::max(hi[d], 0), dims[d] - 1);
+            }
+            for (int x = lo[0]; x <= hi[0]; ++x) {
+                for (int y = lo[1]; y <= hi[1]; ++y) {
+                    for (int z = lo[2]; z <= hi[2]; ++z)
+                        tile_points[(x * dims[1] + y) * dims[2] + z].push_back(static_cast<int>(i));
+                }
+            }
+        }
+
+        auto result = new SurfaceMesh;
+        auto density = result->add_vertex_property<float>(density_attr_name);
+        const bool has_colors = cloud->get_vertex_property<vec3>("v:color");
+        SurfaceMesh::VertexProperty<vec3> color;
+        if (has_colors)
+            color = result->add_vertex_property<vec3>("v:color");
+
+        SurfaceMeshBuilder builder(result);
+        builder.begin_surface();
+
+        // The vertices near the tile boundaries, hashed by their positions on a grid of the welding tolerance. Each
+        // entry records the vertex and the tile it comes from.
+        const float tolerance = 0.5f * cell;
+        std::unordered_map<int64_t, std::vector<std::pair<SurfaceMesh::Vertex, int> > > seam_vertices;
+        auto cell_key = [](int64_t x, int64_t y, int64_t z) -> int64_t {
+            return ((x & 0x1FFFFF) << 42) | ((y & 0x1FFFFF) << 21) | (z & 0x1FFFFF);
+        };
+
+        int num_tiles = 0;
+        for (int x = 0; x < dims[0]; ++x) {
+            for (int y = 0; y < dims[1]; ++y) {
+                for (int z = 0; z < dims[2]; ++z) {
+                    const int tile = (x * dims[1] + y) * dims[2] + z;
+                    std::vector<int> &indices = tile_points[tile];
+                    if (indices.size() < 10) {
+                        std::vector<int>().swap(indices);
+                        continue;
+                    }
+
+                    const int idx[3] = {x, y, z};
+                    vec3 lo, hi;
+                    for (int d = 0; d < 3; ++d) {
+                        lo[d] = box.min_coord(d) + static_cast<float>(idx[d]) * edge;
+                        hi[d] = lo[d] + edge;
+                    }
+                    const vec3 center = (lo + hi) * 0.5f;
+                    const vec3 extent(half_size, half_size, half_size);
+
+                    LOG(INFO) << "reconstructing tile (" << x << ", " << y << ", " << z << ") with "
+                              << indices.size() << " points...";
+                    SurfaceMesh *mesh = reconstruct(cloud, &indices, Box3(center - extent, center + extent),
+                                                    density_attr_name);
+                    std::vector<int>().swap(indices);
+                    if (!mesh)
+                        continue;
+                    ++num_tiles;
+
+                    StopWatch w;
+                    auto mesh_density = mesh->get_vertex_property<float>(density_attr_name);
+                    auto mesh_color = mesh->get_vertex_property<vec3>("v:color");
+
+                    // crop: keep the faces whose centers are within the tile (the outer tiles are unbounded outwards)
+                    auto inside = [&](const vec3 &c) -> bool {
+                        for (int d = 0; d < 3; ++d) {
+                            if ((idx[d] > 0 && c[d] < lo[d]) || (idx[d] < dims[d] - 1 && c[d] >= hi[d]))
+                                return false;
+                        }
+                        return true;
+                    };
+                    auto near_seam = [&](const vec3 &p) -> bool {
+                        for (int d = 0; d < 3; ++d) {
+                            if ((idx[d] > 0 && std::abs(p[d] - lo[d]) < 2 * cell) ||
+                                (idx[d] < dims[d] - 1 && std::abs(p[d] - hi[d]) < 2 * cell))
+                                return true;
+                        }
+                        return false;
+                    };
+
+                    std::vector<SurfaceMesh::Vertex> vertex_map(mesh->vertices_size());
+                    auto get_vertex = [&](SurfaceMesh::Vertex v) -> SurfaceMesh::Vertex {
+                        if (vertex_map[v.idx()].is_valid())
+                            return vertex_map[v.idx()];
+
+                        const vec3 &p = mesh->position(v);
+                        const bool seam = near_seam(p);
+                        const int64_t cx = static_cast<int64_t>(std::floor(p.x / tolerance));
+                        const int64_t cy = static_cast<int64_t>(std::floor(p.y / tolerance));
+                        const int64_t cz = static_cast<int64_t>(std::floor(p.z / tolerance));
+                        if (seam) { // weld with the closest vertex from another tile
+                            SurfaceMesh::Vertex closest;
+                            float min_dist = tolerance * tolerance;
+                            for (int64_t i = cx - 1; i <= cx + 1; ++i) {
+                                for (int64_t j = cy - 1; j <= cy + 1; ++j) {
+                                    for (int64_t k = cz - 1; k <= cz + 1; ++k) {
+                                        auto pos = seam_vertices.find(cell_key(i, j, k));
+                                        if (pos == seam_vertices.end())
+                                            continue;
+                                        for (const auto &entry : pos->second) {
+                                            if (entry.second == tile)
+                                                continue;
+                                            const float dist = distance2(result->position(entry.first), p);
+                                            if (dist < min_dist) {
+                                                min_dist = dist;
+                                                closest = entry.first;
+                                            }
+                                        }
+                                    }
+                                }
+                            }
+                            if (closest.is_valid()) {
+                                vertex_map[v.idx()] = closest;
+                                return closest;
+                            }
+                        }
+
+                        SurfaceMesh::Vertex vv = builder.add_vertex(p);
+                        density[vv] = mesh_density[v];
+                        if (has_colors && mesh_color)
+                            color[vv] = mesh_color[v];
+                        if (seam)
+                            seam_vertices[cell_key(cx, cy, cz)].emplace_back(vv, tile);
+                        vertex_map[v.idx()] = vv;
+                        return vv;
+                    };
+
+                    std::vector<SurfaceMesh::Vertex> face_vertices;
+                    for (auto f : mesh->faces()) {
+                        vec3 c(0, 0, 0);
+                        int n = 0;
+                        for (auto v : mesh->vertices(f)) {
+                            c += mesh->position(v);
+                            ++n;
+                        }
+                        if (!inside(c / static_cast<float>(n)))
+                            continue;
+
+                        face_vertices.clear();
+                        for (auto v : mesh->vertices(f))
+                            face_vertices.push_back(get_vertex(v));
+
+                        // welding may collapse a face
+                        std::vector<SurfaceMesh::Vertex> unique = face_vertices;
+                        std::sort(unique.begin(), unique.end());
+                        if (std::unique(unique.begin(), unique.end()) != unique.end())
+                            continue;
+                        builder.add_face(face_vertices);
+                    }
+                    delete mesh;
+                    profile_.stitching += w.elapsed_seconds(3);
+                }
+            }
+        }
+
+        StopWatch w;
+        builder.end_surface(false);
+        profile_.stitching += w.elapsed_seconds(3);
+
+        if (result->n_faces() == 0) {
+            LOG(ERROR) << "reconstructed mesh has 0 facet";
+            delete result;
+            return nullptr;
+        }
+        LOG(INFO) << "stitched " << num_tiles << " tiles: " << result->n_vertices() << " vertices, "
+                  << result->n_faces() << " faces";
         return result;
     }
 
@@ -29,6 +29,9 @@
 
 
 #include <string>
+#include <vector>
+
+#include <easy3d/core/types.h>
 
 
 namespace easy3d {
@@ -71,6 +74,62 @@ namespace easy3d {
          */
         void set_samples_per_node(float s) { samples_per_node_ = s; }
 
+        /**
+         * \brief Set the number of threads.
+         * \param n The number of threads used by the parallel stages (i.e., loading the points, evaluating the
+         *      solution, and extracting the iso-surface). A non-positive value means using the number of threads of
+         *      the shared ThreadPool (see easy3d::initialize()), which is the default, so the OpenMP threads of this
+         *      class do not outnumber those of the rest of the library. It has no effect if Easy3D was built without
+         *      OpenMP.
+         */
+        void set_threads(int n);
+        /**
+         * \brief Return the number of threads.
+         */
+        int threads() const { return threads_; }
+
+        /**
+         * \brief Set the number of points read from the point cloud at a time.
+         * \param n The chunk size. The points are streamed from the point cloud into the octree chunk by chunk, and
+         *      each chunk is transformed in parallel. Only one chunk of transformed points exists at a time, i.e.,
+         *      the input points are never duplicated. The default value is 65536.
+         */
+        void set_chunk_size(std::size_t n) { chunk_size_ = n; }
+
+        /**
+         * \brief Set the number of tiles for large inputs.
+         * \param n The number of tiles along the longest side of the bounding box. The default value 1 reconstructs
+         *      the whole point cloud at once. For n > 1, the bounding box is partitioned into n cubic tiles along its
+         *      longest side (and as many as needed along the other sides). Each tile and its overlap with the
+         *      neighbors is reconstructed independently at the specified depth, so the memory is bounded by a single
+         *      tile, while the effective resolution of the whole model is about 2^depth x n. The iso-surfaces are
+         *      then cropped to the tiles and stitched by welding the vertices along the tile boundaries.
+         * \note Small cracks may remain along the tile boundaries where the independent solutions disagree. Use a
+         *      larger overlap to reduce the disagreement.
+         */
+        void set_tiles(int n) { tiles_ = n; }
+        /**
+         * \brief Set the overlap between neighboring tiles.
+         * \param r The overlap, relative to the size of a tile. The default value is 0.1.
+         */
+        void set_tile_overlap(float r) { tile_overlap_ = r; }
+
+        /**
+         * \brief The time (in seconds) spent in each stage of the last reconstruction.
+         * \details For the tiled reconstruction, the time of each stage is accumulated over all tiles.
+         */
+        struct Profile {
+            double octree = 0.0;    ///< Loading the points into the octree, density estimation, and the normal field.
+            double solve = 0.0;     ///< Setting up the constraints and solving the linear system.
+            double extraction = 0.0;///< Computing the iso-value and extracting the iso-surface by marching cubes.
+            double stitching = 0.0; ///< Cropping and stitching the tiles (tiled reconstruction only).
+            double total = 0.0;     ///< The total reconstruction time.
+        };
+        /**
+         * \brief Return the per-stage profile of the last reconstruction.
+         */
+        const Profile &profile() const { return profile_; }
+
         /**
          * \brief Perform Poisson surface reconstruction.
          * \param cloud The input point cloud.
@@ -133,6 +192,13 @@ namespace easy3d {
          */
         void set_verbose(bool v) { verbose_ = v; }
 
+    private:
+        // Reconstructs the surface from the points (all points if indices is nullptr) within the box.
+        SurfaceMesh *reconstruct(const PointCloud *cloud, const std::vector<int> *indices, const Box3 &box,
+                                 const std::string &density_attr_name) const;
+        // Reconstructs each tile independently and stitches the results.
+        SurfaceMesh *reconstruct_tiled(const PointCloud *cloud, const std::string &density_attr_name) const;
+
     private:
         /*
         This integer is the maximum depth of the tree that will be used for surface
@@ -177,6 +243,11 @@ namespace easy3d {
         int gsIter_;
         int threads_;
         bool verbose_;
+
+        std::size_t chunk_size_;
+        int tiles_;
+        float tile_overlap_;
+        mutable Profile profile_;
     };
 
 } // namespace easy3d
@@ -26,6 +26,7 @@
 
 #include <easy3d/algo/point_cloud_ransac.h>
 #include <easy3d/core/point_cloud.h>
+#include <easy3d/util/thread_pool.h>
 
 #include <3rd_party/ransac/RansacShapeDetector.h>
 #include <3rd_party/ransac/PlanePrimitiveShapeConstructor.h>
@@ -277,8 +278,7 @@ namespace easy3d {
 
         const std::vector<vec3> &nms = normals.vector();
         const std::vector<vec3> &pts = cloud->points();
-#pragma omp parallel for
-        for (int i = 0; i < pts.size(); ++i) {
+        parallel_for(std::size_t(0), pts.size(), [&](std::size_t i) {
             const vec3 &p = pts[i];
             const vec3 &n = nms[i];
             pc[i] = Point(
@@ -286,7 +286,7 @@ namespace easy3d {
                     Vec3f(n.x, n.y, n.z)
             );
             pc[i].index = i;
-        }
+        });
 
         return internal::do_detect(cloud, pc, types_, plane_primitives_, cylinder_primitives_, min_support, dist_thresh, bitmap_reso, normal_thresh, overlook_prob);
     }
@@ -327,8 +327,7 @@ namespace easy3d {
 
         const std::vector<vec3> &nms = normals.vector();
         const std::vector<vec3> &pts = cloud->points();
-#pragma omp parallel for
-        for (int index = 0; index < vertices.size(); ++index) {
+        parallel_for(std::size_t(0), vertices.size(), [&](std::size_t index) {
             std::size_t idx = vertices[index];
             const vec3 &p = pts[idx];
             const vec3 &n = nms[idx];
@@ -337,7 +336,7 @@ namespace easy3d {
                     Vec3f(n.x, n.y, n.z)
             );
             pc[index].index = idx;
-        }
+        });
 
         return internal::do_detect(cloud, pc, types_, plane_primitives_, cylinder_primitives_, min_support, dist_thresh, bitmap_reso, normal_thresh, overlook_prob);
     }
@@ -338,4 +338,26 @@ namespace easy3d {
     }
 
 
+    //----- grid simplification of a point cloud processed chunk by chunk ----------------------------------
+
+
+    StreamingGridSimplification::StreamingGridSimplification(float cell_size) : cell_size_(cell_size) {
+        assert(cell_size > 0);
+    }
+
+
+    void StreamingGridSimplification::apply(PointCloud *chunk) {
+        const auto &points = chunk->points();
+        for (auto v : chunk->vertices()) {
+            // the same rounding as PointCloudSimplification::grid_simplification()
+            const vec3 &p = points[v.idx()];
+            const Cell cell = {static_cast<int64_t>(std::floor(p.x / cell_size_)),
+                               static_cast<int64_t>(std::floor(p.y / cell_size_)),
+                               static_cast<int64_t>(std::floor(p.z / cell_size_))};
+            if (!cells_.insert(cell).second) // if not inserted
+                chunk->delete_vertex(v);
+        }
+        chunk->collect_garbage();
+    }
+
 }
@@ -29,6 +29,8 @@
 
 
 #include <vector>
+#include <cstdint>
+#include <unordered_set>
 
 #include <easy3d/core/point_cloud.h>
 
@@ -96,6 +98,48 @@ namespace easy3d {
     };
 
 
+    /**
+     * \brief Grid simplification of a point cloud that is processed chunk by chunk (e.g., by PointCloudStream).
+     * \class StreamingGridSimplification easy3d/algo/point_cloud_simplification.h
+     * \details Like PointCloudSimplification::grid_simplification(), the grid is aligned with the origin, so both
+     *      give the same cells. In addition, the occupied cells are remembered across the chunks. So the first point
+     *      of each cell is kept, no matter which chunk it belongs to. The memory is proportional to
+     *      the number of occupied cells (i.e., the number of points after simplification). Example usage:
+     *      \code
+     *          StreamingGridSimplification grid(cell_size);
+     *          PointCloudStream::process("input.las", "output.ply", [&](PointCloud *chunk) { grid.apply(chunk); });
+     *      \endcode
+     */
+    class StreamingGridSimplification {
+    public:
+        /// \brief Constructor. \p cell_size is the size of the cells of the grid.
+        explicit StreamingGridSimplification(float cell_size);
+
+        /**
+         * \brief Simplifies a chunk by deleting its points that fall into the cells already occupied (by the previous
+         *      points of this chunk or of the previous chunks). The garbage of the chunk is collected.
+         */
+        void apply(PointCloud *chunk);
+
+        /// \brief Returns the number of cells occupied so far, i.e., the number of points kept.
+        std::size_t num_cells() const { return cells_.size(); }
+
+    private:
+        struct Cell {
+            int64_t x, y, z;
+            bool operator==(const Cell &c) const { return x == c.x && y == c.y && z == c.z; }
+        };
+        struct CellHash {
+            std::size_t operator()(const Cell &c) const {
+                return static_cast<std::size_t>((c.x * 73856093) ^ (c.y * 19349663) ^ (c.z * 83492791));
+            }
+        };
+
+        float cell_size_;
+        std::unordered_set<Cell, CellHash> cells_;
+    };
+
+
 } // namespace easy3d
 
 
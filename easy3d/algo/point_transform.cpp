@@ -0,0 +1,124 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#include <easy3d/algo/point_transform.h>
+
+#include <cmath>
+
+#include <easy3d/core/point_cloud.h>
+#include <easy3d/core/surface_mesh.h>
+#include <easy3d/core/graph.h>
+#include <easy3d/core/poly_mesh.h>
+#include <easy3d/core/point_kernels.h>
+#include <easy3d/core/random.h>
+#include <easy3d/core/constant.h>
+#include <easy3d/util/logging.h>
+
+
+namespace easy3d {
+
+    namespace internal {
+        // the "v:normal" property and (for meshes) the "f:normal" property of a model
+        std::vector<std::vector<vec3> *> normal_properties(Model *model) {
+            std::vector<std::vector<vec3> *> normals;
+            if (auto cloud = dynamic_cast<PointCloud *>(model)) {
+                if (auto prop = cloud->get_vertex_property<vec3>("v:normal"))
+                    normals.push_back(&prop.vector());
+            } else if (auto mesh = dynamic_cast<SurfaceMesh *>(model)) {
+                if (auto prop = mesh->get_vertex_property<vec3>("v:normal"))
+                    normals.push_back(&prop.vector());
+                if (auto prop = mesh->get_face_property<vec3>("f:normal"))
+                    normals.push_back(&prop.vector());
+            } else if (auto graph = dynamic_cast<Graph *>(model)) {
+                if (auto prop = graph->get_vertex_property<vec3>("v:normal"))
+                    normals.push_back(&prop.vector());
+            } else if (auto poly = dynamic_cast<PolyMesh *>(model)) {
+                if (auto prop = poly->get_vertex_property<vec3>("v:normal"))
+                    normals.push_back(&prop.vector());
+                if (auto prop = poly->get_face_property<vec3>("f:normal"))
+                    normals.push_back(&prop.vector());
+            }
+            return normals;
+        }
+    }
+
+
+    void PointTransform::apply(Model *model, const mat4 &m) {
+        if (!model) {
+            LOG(WARNING) << "null model";
+            return;
+        }
+
+        kernels::transform(model->points(), m);
+        model->touch_geometry();
+
+        const std::vector<std::vector<vec3> *> normals = internal::normal_properties(model);
+        if (normals.empty())
+            return;
+
+        const mat3 sub(m);
+        if (determinant(sub) == 0.0f) {
+            LOG(WARNING) << "the transformation is degenerate (normals not transformed)";
+            return;
+        }
+        // the normal matrix, without translation
+        const mat4 normal_matrix(transpose(inverse(sub)));
+        for (auto prop : normals) {
+            kernels::transform(*prop, normal_matrix);
+            kernels::normalize(*prop);
+        }
+    }
+
+
+    void PointTransform::add_noise(Model *model, float sigma, uint64_t seed) {
+        if (!model) {
+            LOG(WARNING) << "null model";
+            return;
+        }
+
+        if (sigma <= 0) {
+            LOG(WARNING) << "sigma must be positive";
+            return;
+        }
+
+        const CounterRandom random(seed);
+        for_each_point(model, [&](std::size_t i, vec3 &p) {
+            const CounterRandom::Block r = random(i);
+            // the offset following N(0, sigma), by the Box-Muller transform
+            const double u = CounterRandom::to_float(r[0]);
+            const double v = CounterRandom::to_float(r[1]);
+            const double offset = sigma * std::sqrt(-2.0 * std::log(u)) * std::cos(2.0 * M_PI * v);
+            // the direction uniformly distributed on the unit sphere
+            const double z = 2.0 * CounterRandom::to_float(r[2]) - 1.0;
+            const double phi = 2.0 * M_PI * CounterRandom::to_float(r[3]);
+            const double s = std::sqrt(std::max(1.0 - z * z, 0.0));
+            const vec3 dir(static_cast<float>(s * std::cos(phi)), static_cast<float>(s * std::sin(phi)),
+                           static_cast<float>(z));
+            p += dir * static_cast<float>(offset);
+        });
+    }
+
+}
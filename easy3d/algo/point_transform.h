@@ -0,0 +1,93 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#ifndef EASY3D_ALGO_POINT_TRANSFORM_H
+#define EASY3D_ALGO_POINT_TRANSFORM_H
+
+#include <cstdint>
+
+#include <easy3d/core/model.h>
+#include <easy3d/util/thread_pool.h>
+
+
+namespace easy3d {
+
+    /**
+     * \brief Parallel transformations of the points (and normals) of models, e.g., for data augmentation.
+     * \details The transformations work on all types of models, i.e., PointCloud, SurfaceMesh, Graph, and PolyMesh.
+     *      The points are processed in parallel, and the results do not depend on the number of threads: the
+     *      matrices are applied by the vectorized kernels (see easy3d::kernels), and the noise of each point is
+     *      generated by a counter-based random number generator (see CounterRandom) from the seed and the index of
+     *      the point.
+     *      Example usage:
+     *      \code
+     *          PointTransform::apply(cloud, mat4::rotation(vec3(0, 0, 1), angle) * mat4::scale(s));
+     *          PointTransform::add_noise(cloud, sigma, seed);
+     *          PointTransform::for_each_point(cloud, [&](std::size_t i, vec3 &p) { p.z += height(p.x, p.y); });
+     *      \endcode
+     * \class PointTransform easy3d/algo/point_transform.h
+     */
+    class PointTransform {
+    public:
+        /**
+         * \brief Transforms a model by an affine transformation.
+         * \details The points are transformed by \p m (the last row of which is ignored). The normals, i.e., the
+         *      "v:normal" property and (for meshes) the "f:normal" property, are transformed by the inverse transpose
+         *      of the upper-left 3x3 sub-matrix of \p m and then normalized.
+         */
+        static void apply(Model *model, const mat4 &m);
+
+        /**
+         * \brief Applies a (e.g., non-rigid) transformation to the points in parallel.
+         * \param func The transformation, i.e., void func(std::size_t i, vec3 &p) modifying the i-th point p. It is
+         *      called concurrently for different points. The normals are not changed.
+         */
+        template<typename Function>
+        static void for_each_point(Model *model, const Function &func);
+
+        /**
+         * \brief Adds Gaussian noise to the points.
+         * \details Each point is moved along a random direction (uniformly distributed on the unit sphere) by a
+         *      distance following the normal distribution N(0, sigma). The noise of the i-th point depends only on
+         *      \p seed and i, so the result is reproducible with the same seed. The normals are not changed.
+         */
+        static void add_noise(Model *model, float sigma, uint64_t seed);
+    };
+
+
+    template<typename Function>
+    void PointTransform::for_each_point(Model *model, const Function &func) {
+        if (!model)
+            return;
+        std::vector<vec3> &points = model->points();
+        parallel_for(std::size_t(0), points.size(), [&](std::size_t i) { func(i, points[i]); });
+        model->touch_geometry();
+    }
+
+}
+
+
+#endif  // EASY3D_ALGO_POINT_TRANSFORM_H
@@ -181,44 +181,81 @@ namespace easy3d {
         auto points = mesh_->get_vertex_property<vec3>("v:point");
         for (auto v : vertices_)
             points[v] = points[v] + offset;
+        mesh_->touch_geometry();
     }
 
 
     std::vector<SurfaceMeshComponent> SurfaceMeshComponent::extract(SurfaceMesh *mesh, bool descending) {
+        return extract(mesh, 0, descending);
+    }
+
+
+    std::vector<SurfaceMeshComponent> SurfaceMeshComponent::extract(SurfaceMesh *mesh, std::size_t min_faces, bool descending) {
         auto component_id = mesh->add_vertex_property<int>("SurfaceMeshComponentExtractor::extract::component_id");
-        int nb_components = SurfaceMeshEnumerator::enumerate_connected_components(mesh, component_id);
+        const int nb_components = SurfaceMeshEnumerator::enumerate_connected_components(mesh, component_id);
+
+        // An element belongs to the component of a representative vertex: a face to the target of its halfedge, an
+        // edge to its first vertex, and a halfedge to its target.
+        // Counting sort: count the elements of each component, and then fill the exactly sized arrays in a single
+        // pass. Components with fewer than 'min_faces' faces are never materialized.
+        std::vector<std::size_t> n_faces(nb_components, 0);
+        for (auto f : mesh->faces())
+            ++n_faces[component_id[mesh->target(mesh->halfedge(f))]];
+
+        std::vector<int> slot(nb_components, -1); // the index of each component in the result (-1: skipped)
         std::vector<SurfaceMeshComponent> result;
-        for (int i = 0; i < nb_components; i++) {
-            result.emplace_back(SurfaceMeshComponent(mesh));
+        for (int i = 0; i < nb_components; ++i) {
+            if (n_faces[i] >= min_faces) {
+                slot[i] = static_cast<int>(result.size());
+                result.emplace_back(SurfaceMeshComponent(mesh));
+            }
         }
 
-        for (auto v : mesh->vertices()) {
-            int idx = component_id[v];
-            result[idx].vertices_.push_back(v);
-        }
+        if (!result.empty()) {
+            std::vector<std::size_t> n_vertices(nb_components, 0), n_edges(nb_components, 0);
+            for (auto v : mesh->vertices())
+                ++n_vertices[component_id[v]];
+            for (auto e : mesh->edges())
+                ++n_edges[component_id[mesh->vertex(e, 0)]];
+            for (int i = 0; i < nb_components; ++i) {
+                if (slot[i] < 0)
+                    continue;
+                SurfaceMeshComponent &comp = result[slot[i]];
+                comp.vertices_.reserve(n_vertices[i]);
+                comp.faces_.reserve(n_faces[i]);
+                comp.edges_.reserve(n_edges[i]);
+                comp.halfedges_.reserve(n_edges[i] * 2); // each edge has two halfedges in the same component
+            }
 
-        for (auto f : mesh->faces()) {
-            auto v = mesh->vertices(f).begin();
-            int idx = component_id[*v];
-            result[idx].faces_.push_back(f);
-        }
+            for (auto v : mesh->vertices()) {
+                const int idx = slot[component_id[v]];
+                if (idx >= 0)
+                    result[idx].vertices_.push_back(v);
+            }
 
-        for (auto e : mesh->edges()) {
-            auto v = mesh->vertex(e, 0);
-            int idx = component_id[v];
-            result[idx].edges_.push_back(e);
-        }
+            for (auto f : mesh->faces()) {
+                const int idx = slot[component_id[mesh->target(mesh->halfedge(f))]];
+                if (idx >= 0)
+                    result[idx].faces_.push_back(f);
+            }
 
-        for (auto h : mesh->halfedges()) {
-            auto v = mesh->target(h);
-            int idx = component_id[v];
-            result[idx].halfedges_.push_back(h);
+            for (auto e : mesh->edges()) {
+                const int idx = slot[component_id[mesh->vertex(e, 0)]];
+                if (idx >= 0)
+                    result[idx].edges_.push_back(e);
+            }
+
+            for (auto h : mesh->halfedges()) {
+                const int idx = slot[component_id[mesh->target(h)]];
+                if (idx >= 0)
+                    result[idx].halfedges_.push_back(h);
+            }
         }
 
         mesh->remove_vertex_property(component_id);
-        
+
         if (descending) {
-            std::sort(result.begin(), result.end(), 
+            std::stable_sort(result.begin(), result.end(),
                 [](const SurfaceMeshComponent& a, const SurfaceMeshComponent& b) { return a.n_faces() > b.n_faces(); }
             );
         }
@@ -228,70 +265,44 @@ namespace easy3d {
 
 
     SurfaceMeshComponent SurfaceMeshComponent::extract(SurfaceMesh *mesh, SurfaceMesh::Face face) {
-        auto component_id = mesh->add_vertex_property<int>("SurfaceMeshComponentExtractor::extract::component_id");
-        SurfaceMeshEnumerator::enumerate_connected_components(mesh, component_id);
-
-        SurfaceMeshComponent result(mesh);
-        auto vertex = mesh->vertices(face).begin();
-        int comp_id = component_id[*vertex];
-
-        for (auto v : mesh->vertices()) {
-            if (component_id[v] == comp_id)
-                result.vertices_.push_back(v);
-        }
-
-        for (auto f : mesh->faces()) {
-            auto v = mesh->vertices(f).begin();
-            if (component_id[*v] == comp_id)
-                result.faces_.push_back(f);
-        }
-
-        for (auto e : mesh->edges()) {
-            auto v = mesh->vertex(e, 0);
-            if (component_id[v] == comp_id)
-                result.edges_.push_back(e);
-        }
-
-        for (auto h : mesh->halfedges()) {
-            auto v = mesh->target(h);
-            if (component_id[v] == comp_id)
-                result.halfedges_.push_back(h);
-        }
-
-        return result;
+        return extract(mesh, mesh->target(mesh->halfedge(face)));
     }
 
 
     SurfaceMeshComponent SurfaceMeshComponent::extract(SurfaceMesh *mesh, SurfaceMesh::Vertex vertex) {
-        auto component_id = mesh->add_vertex_property<int>("SurfaceMeshComponentExtractor::extract::component_id");
-        SurfaceMeshEnumerator::enumerate_connected_components(mesh, component_id);
-
         SurfaceMeshComponent result(mesh);
-        int comp_id = component_id[vertex];
 
-        for (auto v : mesh->vertices()) {
-            if (component_id[v] == comp_id)
-                result.vertices_.push_back(v);
-        }
-
-        for (auto f : mesh->faces()) {
-            auto v = mesh->vertices(f).begin();
-            if (component_id[*v] == comp_id)
-                result.faces_.push_back(f);
-        }
-
-        for (auto e : mesh->edges()) {
-            auto v = mesh->vertex(e, 0);
-            if (component_id[v] == comp_id)
-                result.edges_.push_back(e);
-        }
-
-        for (auto h : mesh->halfedges()) {
-            auto v = mesh->target(h);
-            if (component_id[v] == comp_id)
-                result.halfedges_.push_back(h);
+        // only the component containing the seed is visited
+        auto visited = mesh->add_vertex_property<bool>("SurfaceMeshComponentExtractor::extract::visited", false);
+        std::vector<SurfaceMesh::Vertex> stack(1, vertex);
+        visited[vertex] = true;
+        while (!stack.empty()) {
+            const auto v = stack.back();
+            stack.pop_back();
+            result.vertices_.push_back(v);
+            for (auto h : mesh->halfedges(v)) {
+                const auto w = mesh->target(h);
+                if (!visited[w]) {
+                    visited[w] = true;
+                    stack.push_back(w);
+                }
+                // the incoming halfedge of v
+                const auto in = mesh->opposite(h);
+                result.halfedges_.push_back(in);
+                if (in.idx() % 2 == 0) // v is the first vertex of the edge
+                    result.edges_.push_back(mesh->edge(in));
+                const auto f = mesh->face(in);
+                if (f.is_valid() && mesh->halfedge(f) == in)
+                    result.faces_.push_back(f);
+            }
         }
+        mesh->remove_vertex_property(visited);
 
+        // keep the same order as the elements in the mesh
+        std::sort(result.vertices_.begin(), result.vertices_.end());
+        std::sort(result.faces_.begin(), result.faces_.end());
+        std::sort(result.edges_.begin(), result.edges_.end());
+        std::sort(result.halfedges_.begin(), result.halfedges_.end());
         return result;
     }
 
@@ -47,6 +47,18 @@ namespace easy3d {
          */
         static std::vector<SurfaceMeshComponent> extract(SurfaceMesh *mesh, bool descending = true);
 
+        /**
+         * \brief Extracts the connected components that have at least \p min_faces faces.
+         * \details The connected components are labeled using a parallel union-find over the edges, and the elements
+         *      are bucketed into exactly sized arrays per component. Smaller components (e.g., tiny floating
+         *      fragments in scanned data) are counted but never materialized.
+         * \param mesh The surface mesh from which to extract components.
+         * \param min_faces The minimum number of faces of the components to be extracted.
+         * \param descending If true, the components are sorted in descending order by the number of faces.
+         * \return A vector of extracted SurfaceMeshComponent objects.
+         */
+        static std::vector<SurfaceMeshComponent> extract(SurfaceMesh *mesh, std::size_t min_faces, bool descending);
+
         /**
          * \brief Extracts a single connected component from the given seed face.
          * \param mesh The surface mesh from which to extract the component.
@@ -11,7 +11,7 @@
 
 #include <easy3d/algo/surface_mesh_curvature.h>
 #include <easy3d/algo/surface_mesh_geometry.h>
-#include <easy3d/core/eigen_solver.h>
+#include <easy3d/util/thread_pool.h>
 
 
 namespace easy3d {
@@ -27,40 +27,48 @@ namespace easy3d {
 
     //-----------------------------------------------------------------------------
 
-    void SurfaceMeshCurvature::analyze(unsigned int post_smoothing_steps) {
-        double kmin, kmax, mean, gauss;
-        double area, sum_angles;
-        double weight, sum_weights;
-        vec3 p0, p1, p2, laplace;
+    void SurfaceMeshCurvature::analyze(unsigned int post_smoothing_steps, bool lazy) {
+        // nothing to do if the mesh has not changed since the last analysis with the same parameters
+        const std::string key = "curvature:analyze:" + std::to_string(post_smoothing_steps);
+        if (lazy && mesh_->is_up_to_date(key, &min_curvature_.array()))
+            return;
+
+        const int nv = static_cast<int>(mesh_->vertices_size());
+        const int ne = static_cast<int>(mesh_->edges_size());
 
         // cotan weight per edge
         auto cotan = mesh_->add_edge_property<double>("curv:cotan");
-        for (auto e : mesh_->edges())
-            cotan[e] = geom::cotan_weight(mesh_, e);
+        parallel_for(0, ne, [&](int i) {
+            const SurfaceMesh::Edge e(i);
+            if (!mesh_->is_deleted(e))
+                cotan[e] = geom::cotan_weight(mesh_, e);
+        });
 
         // Voronoi area per vertex
         // Laplace per vertex
         // angle sum per vertex
         // -> mean, Gauss -> min, max curvature
-        for (auto v : mesh_->vertices()) {
-            kmin = kmax = 0.0;
+        parallel_for(0, nv, [&](int i) {
+            const SurfaceMesh::Vertex v(i);
+            if (mesh_->is_deleted(v))
+                return;
 
+            double kmin = 0.0, kmax = 0.0;
             if (!mesh_->is_isolated(v) && !mesh_->is_border(v)) {
-                laplace = vec3(0.0f);
-                sum_weights = 0.0;
-                sum_angles = 0.0;
-                p0 = mesh_->position(v);
+                vec3 laplace(0.0f);
+                double sum_weights = 0.0;
+                double sum_angles = 0.0;
+                const vec3 p0 = mesh_->position(v);
 
                 // Voronoi area
-                area = geom::voronoi_area(mesh_, v);
+                const double area = geom::voronoi_area(mesh_, v);
 
                 // Laplace & angle sum
                 for (auto vh : mesh_->halfedges(v)) {
-                    p1 = mesh_->position(mesh_->target(vh));
-                    p2 = mesh_->position(
-                            mesh_->target(mesh_->prev_around_source(vh)));
+                    vec3 p1 = mesh_->position(mesh_->target(vh));
+                    vec3 p2 = mesh_->position(mesh_->target(mesh_->prev_around_source(vh)));
 
-                    weight = cotan[mesh_->edge(vh)];
+                    const double weight = cotan[mesh_->edge(vh)];
                     sum_weights += weight;
                     laplace += weight * p1;
 
@@ -70,11 +78,11 @@ namespace easy3d {
                     p2.normalize();
                     sum_angles += std::acos(geom::clamp_cos(dot(p1, p2)));
                 }
-                laplace -= sum_weights * mesh_->position(v);
+                laplace -= sum_weights * p0;
                 laplace /= 2.0 * area;
 
-                mean = float(0.5) * norm(laplace);
-                gauss = (2.0 * M_PI - sum_angles) / area;
+                const double mean = float(0.5) * norm(laplace);
+                const double gauss = (2.0 * M_PI - sum_angles) / area;
 
                 const double s = std::sqrt(std::max(0.0, mean * mean - gauss));
                 kmin = mean - s;
@@ -83,81 +91,123 @@ namespace easy3d {
 
             min_curvature_[v] = static_cast<float>(kmin);
             max_curvature_[v] = static_cast<float>(kmax);
-        }
-
-        // boundary vertices: interpolate from interior neighbors
-        for (auto v : mesh_->vertices()) {
-            if (mesh_->is_border(v)) {
-                kmin = kmax = sum_weights = 0.0;
-
-                for (auto vh : mesh_->halfedges(v)) {
-                    v = mesh_->target(vh);
-                    if (!mesh_->is_border(v)) {
-                        weight = cotan[mesh_->edge(vh)];
-                        sum_weights += weight;
-                        kmin += weight * min_curvature_[v];
-                        kmax += weight * max_curvature_[v];
-                    }
-                }
-
-                if (sum_weights) {
-                    kmin /= sum_weights;
-                    kmax /= sum_weights;
+        });
+
+        // boundary vertices: interpolate from interior neighbors (which are not written in this loop)
+        parallel_for(0, nv, [&](int i) {
+            const SurfaceMesh::Vertex v(i);
+            if (mesh_->is_deleted(v) || !mesh_->is_border(v))
+                return;
+
+            double kmin = 0.0, kmax = 0.0, sum_weights = 0.0;
+            for (auto vh : mesh_->halfedges(v)) {
+                const auto vv = mesh_->target(vh);
+                if (!mesh_->is_border(vv)) {
+                    const double weight = cotan[mesh_->edge(vh)];
+                    sum_weights += weight;
+                    kmin += weight * min_curvature_[vv];
+                    kmax += weight * max_curvature_[vv];
                 }
+            }
 
-                min_curvature_[v] = static_cast<float>(kmin);
-                max_curvature_[v] = static_cast<float>(kmax);
+            if (sum_weights) {
+                kmin /= sum_weights;
+                kmax /= sum_weights;
             }
-        }
+
+            min_curvature_[v] = static_cast<float>(kmin);
+            max_curvature_[v] = static_cast<float>(kmax);
+        });
 
         // clean-up properties
         mesh_->remove_edge_property(cotan);
 
         // smooth curvature values
         smooth_curvatures(post_smoothing_steps);
+
+        mark_computed(key);
+    }
+
+    //-----------------------------------------------------------------------------
+
+    namespace internal {
+
+        // Computes the eigenvalues (in decreasing order) of a symmetric 3x3 matrix using the closed-form
+        // (trigonometric) solution of the characteristic polynomial. This is much faster than the iterative
+        // EigenSolver and is accurate enough for the curvature tensor, of which the eigenvectors are not needed.
+        void symmetric_eigen_values(const dmat3 &m, double &eval1, double &eval2, double &eval3) {
+            const double p1 = m(0, 1) * m(0, 1) + m(0, 2) * m(0, 2) + m(1, 2) * m(1, 2);
+            const double q = (m(0, 0) + m(1, 1) + m(2, 2)) / 3.0;
+            const double d0 = m(0, 0) - q, d1 = m(1, 1) - q, d2 = m(2, 2) - q;
+            const double p2 = d0 * d0 + d1 * d1 + d2 * d2 + 2.0 * p1;
+            if (p2 <= std::numeric_limits<double>::min()) {    // a multiple of the identity matrix
+                eval1 = eval2 = eval3 = q;
+                return;
+            }
+
+            // B = (m - q * I) / p, and the eigenvalues of m are q + p * (the eigenvalues of B)
+            const double p = std::sqrt(p2 / 6.0);
+            const double b01 = m(0, 1) / p, b02 = m(0, 2) / p, b12 = m(1, 2) / p;
+            const double b00 = d0 / p, b11 = d1 / p, b22 = d2 / p;
+            const double det = b00 * (b11 * b22 - b12 * b12) - b01 * (b01 * b22 - b12 * b02) +
+                               b02 * (b01 * b12 - b11 * b02);
+            const double r = std::max(-1.0, std::min(1.0, det * 0.5));
+            const double phi = std::acos(r) / 3.0;
+
+            eval1 = q + 2.0 * p * std::cos(phi);
+            eval3 = q + 2.0 * p * std::cos(phi + (2.0 * M_PI / 3.0));
+            eval2 = 3.0 * q - eval1 - eval3;   // the trace is invariant
+        }
+
     }
 
     //-----------------------------------------------------------------------------
 
     void SurfaceMeshCurvature::analyze_tensor(unsigned int post_smoothing_steps,
-                                              bool two_ring_neighborhood) {
+                                              bool two_ring_neighborhood, bool lazy) {
+        // nothing to do if the mesh has not changed since the last analysis with the same parameters
+        const std::string key = "curvature:tensor:" + std::to_string(post_smoothing_steps) + (two_ring_neighborhood ? ":2" : ":1");
+        if (lazy && mesh_->is_up_to_date(key, &min_curvature_.array()))
+            return;
+
+        const int nv = static_cast<int>(mesh_->vertices_size());
+        const int ne = static_cast<int>(mesh_->edges_size());
+        const int nf = static_cast<int>(mesh_->faces_size());
+
         auto area = mesh_->add_vertex_property<double>("curv:area", 0.0);
         auto normal = mesh_->add_face_property<dvec3>("curv:normal");
         auto evec = mesh_->add_edge_property<dvec3>("curv:evec", dvec3(0, 0, 0));
         auto angle = mesh_->add_edge_property<double>("curv:angle", 0.0);
 
-        dvec3 n0, n1, ev;
-        double l, A, beta, a1, a2, a3;
-        dmat3 tensor;
-
-        double eval1, eval2, eval3, kmin, kmax;
-        dvec3 evec1, evec2, evec3;
-
-        std::vector<SurfaceMesh::Vertex> neighborhood;
-        neighborhood.reserve(15);
-
         // precompute Voronoi area per vertex
-        for (auto v : mesh_->vertices()) {
-            area[v] = geom::voronoi_area(mesh_, v);
-        }
+        parallel_for(0, nv, [&](int i) {
+            const SurfaceMesh::Vertex v(i);
+            if (!mesh_->is_deleted(v))
+                area[v] = geom::voronoi_area(mesh_, v);
+        });
 
         // precompute face normals
-        for (auto f : mesh_->faces()) {
-            normal[f] = (dvec3) mesh_->compute_face_normal(f);
-        }
+        parallel_for(0, nf, [&](int i) {
+            const SurfaceMesh::Face f(i);
+            if (!mesh_->is_deleted(f))
+                normal[f] = (dvec3) mesh_->compute_face_normal(f);
+        });
 
         // precompute dihedralAngle*edge_length*edge per edge
-        for (auto e : mesh_->edges()) {
+        parallel_for(0, ne, [&](int i) {
+            const SurfaceMesh::Edge e(i);
+            if (mesh_->is_deleted(e))
+                return;
             auto h0 = mesh_->halfedge(e, 0);
             auto h1 = mesh_->halfedge(e, 1);
             auto f0 = mesh_->face(h0);
             auto f1 = mesh_->face(h1);
             if (f0.is_valid() && f1.is_valid()) {
-                n0 = normal[f0];
-                n1 = normal[f1];
-                ev = (dvec3) mesh_->position(mesh_->target(h0));
+                const dvec3 &n0 = normal[f0];
+                const dvec3 &n1 = normal[f1];
+                dvec3 ev = (dvec3) mesh_->position(mesh_->target(h0));
                 ev -= (dvec3) mesh_->position(mesh_->target(h1));
-                l = norm(ev);
+                double l = norm(ev);
                 if (l != 0) {   // avoid overflow in case of 0-length edges
                     ev /= l;
                     l *= 0.5; // only consider half of the edge (matching Voronoi area)
@@ -165,63 +215,55 @@ namespace easy3d {
                     evec[e] = std::sqrt(l) * ev;
                 }
             }
-        }
+        });
 
         // compute curvature tensor for each vertex
-        for (auto v : mesh_->vertices()) {
-            kmin = 0.0;
-            kmax = 0.0;
+        parallel_for(0, nv, [&](int i) {
+            const SurfaceMesh::Vertex v(i);
+            if (mesh_->is_deleted(v))
+                return;
 
-            if (!mesh_->is_isolated(v)) {
-                // one-ring or two-ring neighborhood?
-                neighborhood.clear();
-                neighborhood.push_back(v);
-                if (two_ring_neighborhood) {
-                    for (auto vv : mesh_->vertices(v))
-                        neighborhood.push_back(vv);
-                }
+            double kmin = 0.0;
+            double kmax = 0.0;
 
-                A = 0.0;
-                tensor = dmat3(0.0);
+            if (!mesh_->is_isolated(v)) {
+                double A = 0.0;
+                dmat3 tensor(0.0);
 
-                // compute tensor over vertex neighborhood stored in vertices
-                for (auto nit : neighborhood) {
-                    // accumulate tensor from dihedral angles around vertices
+                // accumulate the tensor from dihedral angles around a vertex, and its area
+                auto accumulate = [&](SurfaceMesh::Vertex nit) {
                     for (auto hv : mesh_->halfedges(nit)) {
                         auto ee = mesh_->edge(hv);
-                        ev = evec[ee];
-                        beta = angle[ee];
-                        for (int i = 0; i < 3; ++i)
-                            for (int j = 0; j < 3; ++j)
-                                tensor(i, j) += beta * ev[i] * ev[j];
+                        const dvec3 &ev = evec[ee];
+                        const double beta = angle[ee];
+                        for (int r = 0; r < 3; ++r)
+                            for (int c = 0; c < 3; ++c)
+                                tensor(r, c) += beta * ev[r] * ev[c];
                     }
-
-                    // accumulate area
                     A += area[nit];
+                };
+
+                // one-ring or two-ring neighborhood?
+                accumulate(v);
+                if (two_ring_neighborhood) {
+                    for (auto vv : mesh_->vertices(v))
+                        accumulate(vv);
                 }
 
                 // normalize tensor by accumulated
                 if (A != 0)     // avoid overflow in case of 0-area
                     tensor /= A;
 
-                // Eigen-decomposition
-                EigenSolver<dmat3, double> solver(3);
-                solver.solve(tensor, EigenSolver<dmat3, double>::DECREASING);
-                eval1 = solver.eigen_value(0);
-                eval2 = solver.eigen_value(1);
-                eval3 = solver.eigen_value(2);
-                for (int i = 0; i < 3; ++i) {
-                    evec1[i] = solver.eigen_vector(i, 0);
-                    evec2[i] = solver.eigen_vector(i, 1);
-                    evec3[i] = solver.eigen_vector(i, 2);
-                }
+                // eigenvalues in decreasing order
+                double eval1, eval2, eval3;
+                internal::symmetric_eigen_values(tensor, eval1, eval2, eval3);
 
                 // curvature values:
                 //   normal vector -> eval with the smallest absolute value
                 //   evals are sorted in decreasing order
-                a1 = fabs(eval1);
-                a2 = fabs(eval2);
-                a3 = fabs(eval3);
+                const double a1 = fabs(eval1);
+                const double a2 = fabs(eval2);
+                const double a3 = fabs(eval3);
                 if (a1 < a2) {
                     if (a1 < a3) {
                         // e1 is normal
@@ -249,7 +291,7 @@ namespace easy3d {
 
             min_curvature_[v] = static_cast<float>(kmin);
             max_curvature_[v] = static_cast<float>(kmax);
-        }
+        });
 
         // clean-up properties
         mesh_->remove_vertex_property(area);
@@ -259,31 +301,53 @@ namespace easy3d {
 
         // smooth curvature values
         smooth_curvatures(post_smoothing_steps);
+
+        mark_computed(key);
+    }
+
+    //-----------------------------------------------------------------------------
+
+    void SurfaceMeshCurvature::mark_computed(const std::string &key) {
+        min_curvature_.array().touch();
+        max_curvature_.array().touch();
+        // touching the properties also invalidates the results recorded under other keys (i.e., other methods or
+        // parameters), because they were recorded against an older revision of the properties.
+        mesh_->mark_up_to_date(key, &min_curvature_.array());
     }
 
     //-----------------------------------------------------------------------------
 
     void SurfaceMeshCurvature::smooth_curvatures(unsigned int iterations) {
-        double kmin, kmax;
-        double weight, sum_weights;
+        if (iterations == 0)
+            return;
+
+        const int nv = static_cast<int>(mesh_->vertices_size());
+        const int ne = static_cast<int>(mesh_->edges_size());
 
         // properties
         auto vfeature = mesh_->get_vertex_property<bool>("v:feature");
         auto cotan = mesh_->add_edge_property<double>("curv:cotan");
 
-        // cotan weight per edge
-        for (auto e : mesh_->edges()) {
-            cotan[e] = geom::cotan_weight(mesh_, e);
-        }
-
-        for (unsigned int i = 0; i < iterations; ++i) {
-            for (auto v : mesh_->vertices()) {
+        // cotan weight per edge (negative weights are ignored)
+        parallel_for(0, ne, [&](int i) {
+            const SurfaceMesh::Edge e(i);
+            if (!mesh_->is_deleted(e))
+                cotan[e] = std::max(0.0, geom::cotan_weight(mesh_, e));
+        });
+
+        // Jacobi iterations, i.e., each iteration reads the values of the previous one. So the vertices can be
+        // processed in parallel and the result does not depend on the number of threads.
+        std::vector<float> kmin_prev, kmax_prev;
+        for (unsigned int iter = 0; iter < iterations; ++iter) {
+            kmin_prev = min_curvature_.vector();
+            kmax_prev = max_curvature_.vector();
+            parallel_for(0, nv, [&](int i) {
+                const SurfaceMesh::Vertex v(i);
                 // don't smooth feature vertices
-                if (vfeature && vfeature[v])
-                    continue;
-
-                kmin = kmax = sum_weights = 0.0;
+                if (mesh_->is_deleted(v) || (vfeature && vfeature[v]))
+                    return;
 
+                double kmin = 0.0, kmax = 0.0, sum_weights = 0.0;
                 for (auto vh : mesh_->halfedges(v)) {
                     auto tv = mesh_->target(vh);
 
@@ -291,17 +355,17 @@ namespace easy3d {
                     if (vfeature && vfeature[tv])
                         continue;
 
-                    weight = std::max(0.0, geom::cotan_weight(mesh_, mesh_->edge(vh)));
+                    const double weight = cotan[mesh_->edge(vh)];
                     sum_weights += weight;
-                    kmin += weight * min_curvature_[tv];
-                    kmax += weight * max_curvature_[tv];
+                    kmin += weight * kmin_prev[tv.idx()];
+                    kmax += weight * kmax_prev[tv.idx()];
                 }
 
                 if (std::abs(sum_weights) > std::numeric_limits<float>::min()) {
                     min_curvature_[v] = static_cast<float>(kmin / sum_weights);
                     max_curvature_[v] = static_cast<float>(kmax / sum_weights);
                 }
-            }
+            });
         }
 
         // remove property
@@ -312,26 +376,31 @@ namespace easy3d {
 
     void SurfaceMeshCurvature::compute_mean_curvature() {
         auto curvatures = mesh_->vertex_property<float>("v:curv-mean");
-        for (auto v : mesh_->vertices()) {
+        parallel_for(0, static_cast<int>(mesh_->vertices_size()), [&](int i) {
 //            curvatures[v] = fabs(mean_curvature(v));
+            const SurfaceMesh::Vertex v(i);
             curvatures[v] = mean_curvature(v);
-        }
+        });
     }
 
     //-----------------------------------------------------------------------------
 
     void SurfaceMeshCurvature::compute_gauss_curvature() {
         auto curvatures = mesh_->vertex_property<float>("v:curv-gauss");
-        for (auto v : mesh_->vertices())
+        parallel_for(0, static_cast<int>(mesh_->vertices_size()), [&](int i) {
+            const SurfaceMesh::Vertex v(i);
             curvatures[v] = gauss_curvature(v);
+        });
     }
 
     //-----------------------------------------------------------------------------
 
     void SurfaceMeshCurvature::compute_max_abs_curvature() {
         auto curvatures = mesh_->vertex_property<float>("v:curv-max_abs");
-        for (auto v : mesh_->vertices())
+        parallel_for(0, static_cast<int>(mesh_->vertices_size()), [&](int i) {
+            const SurfaceMesh::Vertex v(i);
             curvatures[v] = max_abs_curvature(v);
+        });
     }
 
 } // namespace easy3d
\ No newline at end of file
@@ -41,17 +41,23 @@ namespace easy3d {
         /**
          * \brief Computes principle curvature information for each vertex.
          * \param post_smoothing_steps Number of smoothing iterations to apply after computing curvatures.
+         * \param lazy If \c true, the computation is skipped if the mesh has not changed since the last analysis
+         *      with the same parameters. Modifications of the vertex positions are not tracked, so only use it if
+         *      such modifications are followed by Model::touch_geometry().
          * \details Upon finish, the principle curvatures are stored as vertex properties "v:curv-min" and "v:curv-max".
          */
-        void analyze(unsigned int post_smoothing_steps = 0);
+        void analyze(unsigned int post_smoothing_steps = 0, bool lazy = false);
 
         /**
          * \brief Computes principle curvature information for each vertex using tensor analysis.
          * \param post_smoothing_steps Number of smoothing iterations to apply after computing curvatures.
          * \param two_ring_neighborhood If true, uses a two-ring neighborhood for the analysis.
+         * \param lazy If \c true, the computation is skipped if the mesh has not changed since the last analysis
+         *      with the same parameters (see analyze()).
          * \details Upon finish, the principle curvatures are stored as vertex properties "v:curv-min" and "v:curv-max".
          */
-        void analyze_tensor(unsigned int post_smoothing_steps = 0, bool two_ring_neighborhood = false);
+        void analyze_tensor(unsigned int post_smoothing_steps = 0, bool two_ring_neighborhood = false,
+                            bool lazy = false);
 
         /**
          * Computes the mean curvature.
@@ -116,6 +122,9 @@ namespace easy3d {
         //! smooth curvature values
         void smooth_curvatures(unsigned int iterations);
 
+        //! records the curvature values as computed (under \p key) for the current state of the mesh
+        void mark_computed(const std::string &key);
+
     private:
         SurfaceMesh *mesh_;
         SurfaceMesh::VertexProperty<float> min_curvature_;
@@ -10,12 +10,77 @@
 
 
 #include <easy3d/algo/surface_mesh_enumerator.h>
+#include <easy3d/util/thread_pool.h>
 
 #include <stack>
+#include <atomic>
 
 
 namespace easy3d {
 
+    namespace internal {
+
+        // A concurrent (lock-free) union-find. Roots are linked by compare-and-swap and paths are compressed
+        // (by halving) during find(). The root of each set is always its element with the smallest index, so the
+        // labels assigned by label() do not depend on the order in which unite() has been called.
+        class UnionFind {
+        public:
+            explicit UnionFind(std::size_t n) : parent_(n) {
+                for (std::size_t i = 0; i < n; ++i)
+                    parent_[i].store(static_cast<int>(i), std::memory_order_relaxed);
+            }
+
+            int find(int x) {
+                while (true) {
+                    int p = parent_[x].load(std::memory_order_relaxed);
+                    if (p == x)
+                        return x;
+                    const int gp = parent_[p].load(std::memory_order_relaxed);
+                    if (p != gp) // path halving
+                        parent_[x].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+                    x = gp;
+                }
+            }
+
+            void unite(int a, int b) {
+                while (true) {
+                    a = find(a);
+                    b = find(b);
+                    if (a == b)
+                        return;
+                    if (a < b)
+                        std::swap(a, b);
+                    // link the root with the larger index to the one with the smaller index
+                    int expected = a;
+                    if (parent_[a].compare_exchange_strong(expected, b, std::memory_order_relaxed))
+                        return;
+                }
+            }
+
+            // Assigns consecutive labels to the sets, in the order of their smallest (valid) elements.
+            // Returns the number of sets.
+            template <typename IsValid>
+            int label(std::vector<int>& labels, IsValid is_valid) {
+                int num = 0;
+                for (std::size_t i = 0; i < parent_.size(); ++i) {
+                    if (!is_valid(static_cast<int>(i)))
+                        continue;
+                    const int root = find(static_cast<int>(i));
+                    if (root == static_cast<int>(i))
+                        labels[i] = num++;
+                    else
+                        labels[i] = labels[root]; // the root has a smaller index and has been labeled
+                }
+                return num;
+            }
+
+        private:
+            std::vector< std::atomic<int> > parent_;
+        };
+
+    }
+
+
     void SurfaceMeshEnumerator::propagate_connected_component(SurfaceMesh *mesh, SurfaceMesh::VertexProperty<int> id,
                                                               SurfaceMesh::Vertex seed, int cur_id) {
         std::stack<SurfaceMesh::Vertex> stack;
@@ -37,16 +102,20 @@ namespace easy3d {
 
 
     int SurfaceMeshEnumerator::enumerate_connected_components(SurfaceMesh *mesh, SurfaceMesh::VertexProperty<int> id) {
-        id.vector().assign(mesh->n_vertices(), -1);
-
-        int cur_id = 0;
-        for (auto v : mesh->vertices()) {
-            if (id[v] == -1) {
-                propagate_connected_component(mesh, id, v, cur_id);
-                ++cur_id;
-            }
-        }
-        return cur_id;
+        // union of the two end points of every edge
+        internal::UnionFind uf(mesh->vertices_size());
+        const auto num_edges = static_cast<int>(mesh->edges_size());
+        parallel_for(0, num_edges, [&](int i) {
+            const SurfaceMesh::Edge e(i);
+            if (mesh->has_garbage() && mesh->is_deleted(e))
+                return;
+            uf.unite(mesh->vertex(e, 0).idx(), mesh->vertex(e, 1).idx());
+        });
+
+        id.vector().assign(mesh->vertices_size(), -1);
+        return uf.label(id.vector(), [mesh](int i) -> bool {
+            return !mesh->has_garbage() || !mesh->is_deleted(SurfaceMesh::Vertex(i));
+        });
     }
 
 
@@ -76,17 +145,23 @@ namespace easy3d {
 
 
     int SurfaceMeshEnumerator::enumerate_connected_components(SurfaceMesh *mesh, SurfaceMesh::FaceProperty<int> id) {
-        id.vector().assign(mesh->n_faces(), -1);
-
-        int cur_id = 0;
-        for (auto f : mesh->faces()) {
-            if (id[f] == -1) {
-                propagate_connected_component(mesh, id, f, cur_id);
-                ++cur_id;
-            }
-        }
-
-        return cur_id;
+        // union of the two incident faces of every interior edge
+        internal::UnionFind uf(mesh->faces_size());
+        const auto num_edges = static_cast<int>(mesh->edges_size());
+        parallel_for(0, num_edges, [&](int i) {
+            const SurfaceMesh::Edge e(i);
+            if (mesh->has_garbage() && mesh->is_deleted(e))
+                return;
+            const auto f0 = mesh->face(mesh->halfedge(e, 0));
+            const auto f1 = mesh->face(mesh->halfedge(e, 1));
+            if (f0.is_valid() && f1.is_valid())
+                uf.unite(f0.idx(), f1.idx());
+        });
+
+        id.vector().assign(mesh->faces_size(), -1);
+        return uf.label(id.vector(), [mesh](int i) -> bool {
+            return !mesh->has_garbage() || !mesh->is_deleted(SurfaceMesh::Face(i));
+        });
     }
 
 
@@ -26,6 +26,8 @@ namespace easy3d {
 
         /**
          * \brief Enumerates the connected components of a surface mesh from its vertices.
+         * \details The components are labeled by a parallel union-find over the edges. The components are numbered in
+         *      the order of their first vertices.
          * @param mesh The input mesh.
          * @param id The vertex property storing the result.
          * @return The number of connected components.
@@ -34,6 +36,8 @@ namespace easy3d {
 
         /**
          * \brief Enumerates the connected components of a surface mesh from its faces.
+         * \details The components are labeled by a parallel union-find over the edges. The components are numbered in
+         *      the order of their first faces.
          * @param mesh The input mesh.
          * @param id The face property storing the result.
          * @return The number of connected components.
@@ -159,6 +159,7 @@ namespace easy3d {
                 const auto &tmp = X.row(i);
                 points_[vertices[i]] = vec3(static_cast<float>(tmp(0)), static_cast<float>(tmp(1)), static_cast<float>(tmp(2)));
             }
+            mesh_->touch_geometry();
         }
     }
 
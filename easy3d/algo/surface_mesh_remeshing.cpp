@@ -656,6 +656,8 @@ namespace easy3d {
             }
         }
 
+        mesh_->touch_geometry();
+
         // remove property
         mesh_->remove_vertex_property(update);
     }
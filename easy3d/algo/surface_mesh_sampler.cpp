@@ -51,16 +51,28 @@ namespace easy3d {
             const_cast<SurfaceMesh *>(mesh)->update_vertex_normals();
             const_cast<SurfaceMesh *>(mesh)->update_face_normals();
 
+            // the samples are collected and then added to the point cloud at once
+            std::vector<vec3> samples, sample_normals;
+            auto add_samples = [&]() {
+                if (samples.empty())
+                    return;
+                const PointCloud::Vertex first = cloud->add_vertices(samples);
+                std::copy(sample_normals.begin(), sample_normals.end(), normals.vector().begin() + first.idx());
+                samples.clear();
+                sample_normals.clear();
+            };
+
             // add all mesh vertices (even the requested number is smaller than the
             // number of vertices in the mesh).
             auto mesh_vertex_normals = mesh->get_vertex_property<vec3>("v:normal");
             for (auto p : mesh->vertices()) {
-                PointCloud::Vertex v = cloud->add_vertex(mesh_points[p]);
+                samples.push_back(mesh_points[p]);
                 if (mesh_vertex_normals)
-                    normals[v] = mesh_vertex_normals[p];
+                    sample_normals.push_back(mesh_vertex_normals[p]);
                 else
-                    normals[v] = mesh->compute_vertex_normal(p);
+                    sample_normals.push_back(mesh->compute_vertex_normal(p));
             }
+            add_samples();
 
             // now we may still need some points
             int num_needed = num - static_cast<int>(cloud->n_vertices());
@@ -99,6 +111,9 @@ namespace easy3d {
                 }
             }
 
+            samples.reserve(num_needed);
+            sample_normals.reserve(num_needed);
+
             float density = static_cast<float>(num_needed) / surface_area;
             float samples_error = 0.0f;
             std::size_t triangle_num = triangles.size();
@@ -145,8 +160,8 @@ namespace easy3d {
                     for (std::size_t i = 0; i < 3; i++)
                         p = p + c[i] * mesh_points[tri[i]];
 
-                    PointCloud::Vertex v = cloud->add_vertex(p);
-                    normals[v] = n;
+                    samples.push_back(p);
+                    sample_normals.push_back(n);
                 }
 
                 num_generated += quant_samples_num;
@@ -154,6 +169,8 @@ namespace easy3d {
                 progress.next();
             }
 
+            add_samples();
+
             LOG(INFO) << "done. resulted point cloud has " << cloud->n_vertices() << " points";
             return cloud;
         };
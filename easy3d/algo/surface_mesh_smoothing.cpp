@@ -27,7 +27,6 @@ namespace easy3d {
     //-----------------------------------------------------------------------------
 
     SurfaceMeshSmoothing::SurfaceMeshSmoothing(SurfaceMesh *mesh) : mesh_(mesh) {
-        how_many_edge_weights_ = 0;
     }
 
     //-----------------------------------------------------------------------------
@@ -46,6 +45,9 @@ namespace easy3d {
 
     void SurfaceMeshSmoothing::compute_edge_weights(bool use_uniform_laplace) {
         auto eweight = mesh_->edge_property<float>("e:cotan");
+        const std::string key = use_uniform_laplace ? "e:cotan:uniform" : "e:cotan";
+        if (mesh_->is_up_to_date(key, &eweight.array()))
+            return;
 
         if (use_uniform_laplace) {
             for (auto e : mesh_->edges())
@@ -55,13 +57,18 @@ namespace easy3d {
                 eweight[e] = static_cast<float>(std::max(0.0, geom::cotan_weight(mesh_, e)));
         }
 
-        how_many_edge_weights_ = mesh_->n_edges();
+        // the uniform weights depend only on the topology
+        eweight.array().touch();
+        mesh_->mark_up_to_date(key, &eweight.array(), use_uniform_laplace);
     }
 
     //-----------------------------------------------------------------------------
 
     void SurfaceMeshSmoothing::compute_vertex_weights(bool use_uniform_laplace) {
         auto vweight = mesh_->vertex_property<float>("v:area");
+        const std::string key = use_uniform_laplace ? "v:area:uniform" : "v:area";
+        if (mesh_->is_up_to_date(key, &vweight.array()))
+            return;
 
         if (use_uniform_laplace) {
             for (auto v : mesh_->vertices())
@@ -70,6 +77,9 @@ namespace easy3d {
             for (auto v : mesh_->vertices())
                 vweight[v] = static_cast<float>(0.5 / geom::voronoi_area(mesh_, v));
         }
+
+        vweight.array().touch();
+        mesh_->mark_up_to_date(key, &vweight.array(), use_uniform_laplace);
     }
 
     //-----------------------------------------------------------------------------
@@ -79,11 +89,9 @@ namespace easy3d {
         if (!mesh_->n_vertices())
             return;
 
-        // compute Laplace weight per edge: cotan or uniform
+        // compute Laplace weight per edge: cotan or uniform (if they are outdated)
+        compute_edge_weights(use_uniform_laplace);
         auto eweight = mesh_->get_edge_property<float>("e:cotan");
-        if (!eweight || how_many_edge_weights_ != mesh_->n_edges())
-            compute_edge_weights(use_uniform_laplace);
-        eweight = mesh_->get_edge_property<float>("e:cotan");
 
         auto points = mesh_->get_vertex_property<vec3>("v:point");
         auto laplace = mesh_->add_vertex_property<vec3>("v:laplace");
@@ -117,6 +125,7 @@ namespace easy3d {
                 points[v] += 0.5f * laplace[v];
             }
         }
+        mesh_->touch_geometry();
 
         // clean-up custom properties
         mesh_->remove_vertex_property(laplace);
@@ -130,14 +139,10 @@ namespace easy3d {
         if (!mesh_->n_vertices())
             return;
 
-        // compute edge weights if they don't exist or if the mesh changed
-        auto eweight = mesh_->get_edge_property<float>("e:cotan");
-        if (!eweight || how_many_edge_weights_ != mesh_->n_edges())
-            compute_edge_weights(use_uniform_laplace);
-        eweight = mesh_->get_edge_property<float>("e:cotan");
-
-        // compute vertex weights
+        // compute edge and vertex weights if they don't exist or if the mesh changed
+        compute_edge_weights(use_uniform_laplace);
         compute_vertex_weights(use_uniform_laplace);
+        auto eweight = mesh_->get_edge_property<float>("e:cotan");
 
         // store center and area
         vec3 center_before;
@@ -232,6 +237,8 @@ namespace easy3d {
                 mesh_->position(v) += trans;
         }
 
+        mesh_->touch_geometry();
+
         // clean-up
         mesh_->remove_vertex_property(idx);
     }
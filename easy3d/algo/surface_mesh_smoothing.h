@@ -66,12 +66,14 @@ namespace easy3d {
     private:
         /**
          * \brief Initialize cotan/uniform Laplace weights.
+         * \details The weights are kept (see Model::is_up_to_date()) until the mesh is modified.
          * \param use_uniform_laplace Decide whether to use uniform Laplacian or cotan Laplacian.
          */
         void compute_edge_weights(bool use_uniform_laplace);
 
         /**
          * \brief Initialize cotan/uniform Laplace weights.
+         * \details The weights are kept (see Model::is_up_to_date()) until the mesh is modified.
          * \param use_uniform_laplace Decide whether to use uniform Laplacian or cotan Laplacian.
          */
         void compute_vertex_weights(bool use_uniform_laplace);
@@ -79,10 +81,6 @@ namespace easy3d {
     private:
         //! the mesh
         SurfaceMesh *mesh_;
-
-        // remember for how many edges we computed weights
-        // recompute if numbers change (i.e. mesh has changed)
-        unsigned int how_many_edge_weights_;
     };
 
 } // namespace easy3d
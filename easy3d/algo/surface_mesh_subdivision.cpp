@@ -13,128 +13,512 @@
 #include <easy3d/algo/surface_mesh_subdivision.h>
 #include <easy3d/core/surface_mesh.h>
 #include <easy3d/algo/surface_mesh_geometry.h>
+#include <easy3d/util/thread_pool.h>
 
 
 namespace easy3d {
 
-    bool SurfaceMeshSubdivision::catmull_clark(SurfaceMesh *mesh) {
-        if (!mesh)
-            return false;
+    namespace internal {
+
+        // Computes the Catmull-Clark points of the faces, edges, and (the new positions of) the vertices of a mesh.
+        // The points are computed in parallel and are indexed by the indices of the elements.
+        void catmull_clark_points(const SurfaceMesh *mesh, std::vector<vec3> &vpoint, std::vector<vec3> &epoint,
+                                  std::vector<vec3> &fpoint) {
+            const int nv = static_cast<int>(mesh->vertices_size());
+            const int ne = static_cast<int>(mesh->edges_size());
+            const int nf = static_cast<int>(mesh->faces_size());
+            vpoint.resize(nv);
+            epoint.resize(ne);
+            fpoint.resize(nf);
+
+            const auto &points = mesh->points();
+            auto vfeature = mesh->get_vertex_property<bool>("v:feature");
+            auto efeature = mesh->get_edge_property<bool>("e:feature");
+
+            // compute face vertices
+            parallel_for(0, nf, [&](int i) {
+                const SurfaceMesh::Face f(i);
+                if (!mesh->is_deleted(f))
+                    fpoint[i] = geom::centroid(mesh, f);
+            });
+
+            // compute edge vertices
+            parallel_for(0, ne, [&](int i) {
+                const SurfaceMesh::Edge e(i);
+                if (mesh->is_deleted(e))
+                    return;
+                // boundary or feature edge?
+                if (mesh->is_border(e) || (efeature && efeature[e])) {
+                    epoint[i] = 0.5f * (points[mesh->vertex(e, 0).idx()] + points[mesh->vertex(e, 1).idx()]);
+                }
 
-        auto points = mesh->vertex_property<vec3>("v:point");
-        auto vfeature = mesh->get_vertex_property<bool>("v:feature");
-        auto efeature = mesh->get_edge_property<bool>("e:feature");
+                    // interior edge
+                else {
+                    vec3 p(0, 0, 0);
+                    p += points[mesh->vertex(e, 0).idx()];
+                    p += points[mesh->vertex(e, 1).idx()];
+                    p += fpoint[mesh->face(e, 0).idx()];
+                    p += fpoint[mesh->face(e, 1).idx()];
+                    p *= 0.25f;
+                    epoint[i] = p;
+                }
+            });
+
+            // compute new positions for old vertices
+            parallel_for(0, nv, [&](int i) {
+                const SurfaceMesh::Vertex v(i);
+                if (mesh->is_deleted(v))
+                    return;
+                // isolated vertex?
+                if (mesh->is_isolated(v)) {
+                    vpoint[i] = points[i];
+                }
 
-        // reserve memory
-        std::size_t nv = mesh->n_vertices();
-        std::size_t ne = mesh->n_edges();
-        std::size_t nf = mesh->n_faces();
-        mesh->reserve(nv + ne + nf, 2 * ne + 4 * nf, 4 * nf);
+                    // boundary vertex?
+                else if (mesh->is_border(v)) {
+                    auto h1 = mesh->out_halfedge(v);
+                    auto h0 = mesh->prev(h1);
 
-        // get properties
-        auto vpoint = mesh->add_vertex_property<vec3>("catmull:vpoint");
-        auto epoint = mesh->add_edge_property<vec3>("catmull:epoint");
-        auto fpoint = mesh->add_face_property<vec3>("catmull:fpoint");
+                    vec3 p = points[i];
+                    p *= 6.0;
+                    p += points[mesh->target(h1).idx()];
+                    p += points[mesh->source(h0).idx()];
+                    p *= 0.125;
 
-        // compute face vertices
-        for (auto f : mesh->faces())
-            fpoint[f] = geom::centroid(mesh, f);
+                    vpoint[i] = p;
+                }
 
-        // compute edge vertices
-        for (auto e : mesh->edges()) {
-            // boundary or feature edge?
-            if (mesh->is_border(e) || (efeature && efeature[e])) {
-                epoint[e] = 0.5f * (points[mesh->vertex(e, 0)] +
-                                    points[mesh->vertex(e, 1)]);
-            }
+                    // interior feature vertex?
+                else if (vfeature && vfeature[v]) {
+                    vec3 p = points[i];
+                    p *= 6.0;
+                    int count(0);
+
+                    for (auto h : mesh->halfedges(v)) {
+                        if (efeature && efeature[mesh->edge(h)]) {
+                            p += points[mesh->target(h).idx()];
+                            ++count;
+                        }
+                    }
 
-                // interior edge
-            else {
-                vec3 p(0, 0, 0);
-                p += points[mesh->vertex(e, 0)];
-                p += points[mesh->vertex(e, 1)];
-                p += fpoint[mesh->face(e, 0)];
-                p += fpoint[mesh->face(e, 1)];
-                p *= 0.25f;
-                epoint[e] = p;
-            }
+                    if (count == 2) // vertex is on feature edge
+                    {
+                        p *= 0.125;
+                        vpoint[i] = p;
+                    } else // keep fixed
+                    {
+                        vpoint[i] = points[i];
+                    }
+                }
+
+                    // interior vertex
+                else {
+                    // weights from SIGGRAPH paper "Subdivision Surfaces in Character Animation"
+
+                    const auto k = static_cast<float>(mesh->valence(v));
+                    vec3 p(0, 0, 0);
+
+                    for (auto vv : mesh->vertices(v))
+                        p += points[vv.idx()];
+
+                    for (auto f : mesh->faces(v))
+                        p += fpoint[f.idx()];
+
+                    p /= (k * k);
+
+                    p += ((k - 2.0f) / k) * points[i];
+
+                    vpoint[i] = p;
+                }
+            });
         }
 
-        // compute new positions for old vertices
-        for (auto v : mesh->vertices()) {
-            // isolated vertex?
-            if (mesh->is_isolated(v)) {
-                vpoint[v] = points[v];
-            }
 
-                // boundary vertex?
-            else if (mesh->is_border(v)) {
-                auto h1 = mesh->out_halfedge(v);
-                auto h0 = mesh->prev(h1);
+        // Computes the Loop points of the edges and (the new positions of) the vertices of a triangle mesh.
+        // The points are computed in parallel and are indexed by the indices of the elements.
+        void loop_points(const SurfaceMesh *mesh, std::vector<vec3> &vpoint, std::vector<vec3> &epoint) {
+            const int nv = static_cast<int>(mesh->vertices_size());
+            const int ne = static_cast<int>(mesh->edges_size());
+            vpoint.resize(nv);
+            epoint.resize(ne);
+
+            const auto &points = mesh->points();
+            auto vfeature = mesh->get_vertex_property<bool>("v:feature");
+            auto efeature = mesh->get_edge_property<bool>("e:feature");
+
+            // compute vertex positions
+            parallel_for(0, nv, [&](int i) {
+                const SurfaceMesh::Vertex v(i);
+                if (mesh->is_deleted(v))
+                    return;
+                // isolated vertex?
+                if (mesh->is_isolated(v)) {
+                    vpoint[i] = points[i];
+                }
 
-                vec3 p = points[v];
-                p *= 6.0;
-                p += points[mesh->target(h1)];
-                p += points[mesh->source(h0)];
-                p *= 0.125;
+                    // boundary vertex?
+                else if (mesh->is_border(v)) {
+                    auto h1 = mesh->out_halfedge(v);
+                    auto h0 = mesh->prev(h1);
 
-                vpoint[v] = p;
-            }
+                    vec3 p = points[i];
+                    p *= 6.0;
+                    p += points[mesh->target(h1).idx()];
+                    p += points[mesh->source(h0).idx()];
+                    p *= 0.125;
+                    vpoint[i] = p;
+                }
 
-                // interior feature vertex?
-            else if (vfeature && vfeature[v]) {
-                vec3 p = points[v];
-                p *= 6.0;
-                int count(0);
+                    // interior feature vertex?
+                else if (vfeature && vfeature[v]) {
+                    vec3 p = points[i];
+                    p *= 6.0;
+                    int count(0);
+
+                    for (auto h : mesh->halfedges(v)) {
+                        if (efeature && efeature[mesh->edge(h)]) {
+                            p += points[mesh->target(h).idx()];
+                            ++count;
+                        }
+                    }
 
-                for (auto h : mesh->halfedges(v)) {
-                    if (efeature[mesh->edge(h)]) {
-                        p += points[mesh->target(h)];
-                        ++count;
+                    if (count == 2) // vertex is on feature edge
+                    {
+                        p *= 0.125;
+                        vpoint[i] = p;
+                    } else // keep fixed
+                    {
+                        vpoint[i] = points[i];
                     }
                 }
 
-                if (count == 2) // vertex is on feature edge
-                {
+                    // interior vertex
+                else {
+                    vec3 p(0, 0, 0);
+                    float k(0);
+
+                    for (auto vv : mesh->vertices(v)) {
+                        p += points[vv.idx()];
+                        ++k;
+                    }
+                    p /= k;
+
+                    auto beta = static_cast<float>(0.625 - std::pow(0.375 + 0.25 * std::cos(2.0 * M_PI / k), 2.0));
+
+                    vpoint[i] = points[i] * (float) (1.0 - beta) + beta * p;
+                }
+            });
+
+            // compute edge positions
+            parallel_for(0, ne, [&](int i) {
+                const SurfaceMesh::Edge e(i);
+                if (mesh->is_deleted(e))
+                    return;
+                // boundary or feature edge?
+                if (mesh->is_border(e) || (efeature && efeature[e])) {
+                    epoint[i] = (points[mesh->vertex(e, 0).idx()] + points[mesh->vertex(e, 1).idx()]) * float(0.5);
+                }
+
+                    // interior edge
+                else {
+                    auto h0 = mesh->halfedge(e, 0);
+                    auto h1 = mesh->halfedge(e, 1);
+                    vec3 p = points[mesh->target(h0).idx()];
+                    p += points[mesh->target(h1).idx()];
+                    p *= 3.0;
+                    p += points[mesh->target(mesh->next(h0)).idx()];
+                    p += points[mesh->target(mesh->next(h1)).idx()];
                     p *= 0.125;
-                    vpoint[v] = p;
-                } else // keep fixed
-                {
-                    vpoint[v] = points[v];
+                    epoint[i] = p;
                 }
+            });
+        }
+
+
+        // Out-of-place subdivision. Each level generates the refined mesh from the (garbage-free) coarse one, with
+        // the following numbering:
+        //  - vertices: the old vertices keep their indices, followed by one vertex per edge (and one vertex per face
+        //    for Catmull-Clark), in the order of the edges (and faces). This is the same as the in-place methods.
+        //  - edges: the old edge e is split into edges 2e and 2e+1, which are followed by the edges inserted inside
+        //    the faces. Each corner of a face (i.e., a non-border halfedge) contributes one inner edge.
+        //  - faces: each corner of a face contributes one face. For Loop, they are followed by the central faces.
+        // So the refined connectivity of an element can be written directly (and in parallel) from the coarse one.
+        class RefinedMesh {
+        public:
+            RefinedMesh(const SurfaceMesh *coarse, SurfaceMesh *fine) : coarse_(coarse), fine_(fine) {
+                nv_ = static_cast<int>(coarse->vertices_size());
+                ne_ = static_cast<int>(coarse->edges_size());
+                nh_ = 2 * ne_;
+                // number the corners, i.e., the non-border halfedges
+                corner_.resize(nh_);
+                nc_ = 0;
+                for (int h = 0; h < nh_; ++h)
+                    corner_[h] = coarse->is_border(SurfaceMesh::Halfedge(h)) ? -1 : nc_++;
             }
 
-                // interior vertex
-            else {
-                // weights from SIGGRAPH paper "Subdivision Surfaces in Character Animation"
+            // number of corners of the coarse mesh
+            int num_corners() const { return nc_; }
+
+            // allocates the refined mesh and sets its vertex positions
+            void allocate(const std::vector<std::vector<vec3> *> &points, int num_inner_edges, int num_faces) {
+                fine_->clear();
+                int nv = 0;
+                for (auto p : points)
+                    nv += static_cast<int>(p->size());
+                fine_->resize(nv, 2 * ne_ + num_inner_edges, num_faces);
+                vconn_ = fine_->vertex_property<SurfaceMesh::VertexConnectivity>("v:connectivity");
+                hconn_ = fine_->halfedge_property<SurfaceMesh::HalfedgeConnectivity>("h:connectivity");
+                fconn_ = fine_->face_property<SurfaceMesh::FaceConnectivity>("f:connectivity");
+                auto it = fine_->points().begin();
+                for (auto p : points)
+                    it = std::copy(p->begin(), p->end(), it);
+            }
 
-                const auto k = static_cast<float>(mesh->valence(v));
-                vec3 p(0, 0, 0);
+            // the first half of the coarse halfedge h (from its source to the edge point)
+            static SurfaceMesh::Halfedge first(int h) { return SurfaceMesh::Halfedge(h & 1 ? 2 * h + 1 : 2 * h); }
+            // the second half of the coarse halfedge h (from the edge point to its target)
+            static SurfaceMesh::Halfedge second(int h) { return SurfaceMesh::Halfedge(h & 1 ? 2 * h - 1 : 2 * h + 2); }
+            // the two halfedges of the inner edge contributed by the corner h
+            SurfaceMesh::Halfedge inner(int h, int i) const { return SurfaceMesh::Halfedge(2 * (nh_ + corner_[h]) + i); }
+            // the face contributed by the corner h
+            SurfaceMesh::Face corner_face(int h) const { return SurfaceMesh::Face(corner_[h]); }
+            // the point of the edge of the coarse halfedge h
+            SurfaceMesh::Vertex edge_point(int h) const { return SurfaceMesh::Vertex(nv_ + h / 2); }
+
+            SurfaceMesh::HalfedgeConnectivity &connectivity(SurfaceMesh::Halfedge h) { return hconn_[h]; }
+            SurfaceMesh::FaceConnectivity &connectivity(SurfaceMesh::Face f) { return fconn_[f]; }
+
+            // connects the halves of the coarse halfedge h if it is a border halfedge. Otherwise, sets their targets
+            // and the links that are the same for both methods.
+            void split_halfedge(int h) {
+                const SurfaceMesh::Halfedge hh(h);
+                auto &a = hconn_[first(h)];
+                a.vertex_ = edge_point(h);
+                a.prev_ = second(coarse_->prev(hh).idx());
+                auto &b = hconn_[second(h)];
+                b.vertex_ = coarse_->target(hh);
+                b.next_ = first(coarse_->next(hh).idx());
+                if (coarse_->is_border(hh)) {
+                    a.next_ = second(h);
+                    b.prev_ = first(h);
+                }
+            }
 
-                for (auto vv : mesh->vertices(v))
-                    p += points[vv];
+            // sets the outgoing halfedges of the old vertices and the edge points
+            void set_vertex_halfedges() {
+                parallel_for(0, nv_, [this](int i) {
+                    const auto h = coarse_->out_halfedge(SurfaceMesh::Vertex(i));
+                    // the first half starts from the vertex, and it is a border halfedge if h is
+                    vconn_[SurfaceMesh::Vertex(i)].halfedge_ = h.is_valid() ? first(h.idx()) : SurfaceMesh::Halfedge();
+                });
+                parallel_for(0, ne_, [this](int e) {
+                    // use the second half of the border halfedge (if any), so border vertices have border halfedges
+                    const int h = coarse_->is_border(SurfaceMesh::Halfedge(2 * e + 1)) ? 2 * e + 1 : 2 * e;
+                    vconn_[edge_point(h)].halfedge_ = second(h);
+                });
+            }
+
+            void set_vertex_halfedge(SurfaceMesh::Vertex v, SurfaceMesh::Halfedge h) { vconn_[v].halfedge_ = h; }
+
+            // transfers the feature vertices and edges (an edge point of a feature edge is a feature vertex)
+            void transfer_features() {
+                auto vfeature = coarse_->get_vertex_property<bool>("v:feature");
+                auto efeature = coarse_->get_edge_property<bool>("e:feature");
+                if (vfeature) {
+                    auto feature = fine_->vertex_property<bool>("v:feature", false);
+                    for (int v = 0; v < nv_; ++v)
+                        feature[SurfaceMesh::Vertex(v)] = vfeature[SurfaceMesh::Vertex(v)];
+                }
+                if (efeature) {
+                    auto vertex_feature = fine_->vertex_property<bool>("v:feature", false);
+                    auto edge_feature = fine_->edge_property<bool>("e:feature", false);
+                    for (int e = 0; e < ne_; ++e) {
+                        if (efeature[SurfaceMesh::Edge(e)]) {
+                            vertex_feature[edge_point(2 * e)] = true;
+                            edge_feature[SurfaceMesh::Edge(2 * e)] = true;
+                            edge_feature[SurfaceMesh::Edge(2 * e + 1)] = true;
+                        }
+                    }
+                }
+            }
+
+        private:
+            const SurfaceMesh *coarse_;
+            SurfaceMesh *fine_;
+            int nv_, ne_, nh_, nc_;
+            std::vector<int> corner_;
+            SurfaceMesh::VertexProperty<SurfaceMesh::VertexConnectivity> vconn_;
+            SurfaceMesh::HalfedgeProperty<SurfaceMesh::HalfedgeConnectivity> hconn_;
+            SurfaceMesh::FaceProperty<SurfaceMesh::FaceConnectivity> fconn_;
+        };
+
+
+        // one level of Catmull-Clark subdivision. Each corner h of a face f gives the quad
+        //      (edge point of h) -> (target of h) -> (edge point of next(h)) -> (face point of f).
+        void catmull_clark(const SurfaceMesh *coarse, SurfaceMesh *fine) {
+            std::vector<vec3> vpoint, epoint, fpoint;
+            catmull_clark_points(coarse, vpoint, epoint, fpoint);
+
+            RefinedMesh refined(coarse, fine);
+            const int nc = refined.num_corners();
+            refined.allocate({&vpoint, &epoint, &fpoint}, nc, nc);
+
+            const int fp = static_cast<int>(vpoint.size() + epoint.size());   // index of the first face point
+            parallel_for(0, static_cast<int>(coarse->halfedges_size()), [&](int h) {
+                refined.split_halfedge(h);
+                const SurfaceMesh::Halfedge hh(h);
+                const auto f = coarse->face(hh);
+                if (!f.is_valid())
+                    return;
+
+                const int next = coarse->next(hh).idx();
+                const int prev = coarse->prev(hh).idx();
+                const auto quad = refined.corner_face(h);
+                const auto prev_quad = refined.corner_face(prev);
+
+                const auto to_face = refined.inner(h, 0);     // from the edge point to the face point
+                const auto from_face = refined.inner(h, 1);   // from the face point to the edge point
+
+                auto &a = refined.connectivity(RefinedMesh::first(h));
+                a.face_ = prev_quad;
+                a.next_ = to_face;
+                auto &b = refined.connectivity(RefinedMesh::second(h));
+                b.face_ = quad;
+                b.prev_ = from_face;
+
+                auto &c0 = refined.connectivity(to_face);
+                c0.vertex_ = SurfaceMesh::Vertex(fp + f.idx());
+                c0.face_ = prev_quad;
+                c0.next_ = refined.inner(prev, 1);
+                c0.prev_ = RefinedMesh::first(h);
+
+                auto &c1 = refined.connectivity(from_face);
+                c1.vertex_ = refined.edge_point(h);
+                c1.face_ = quad;
+                c1.next_ = RefinedMesh::second(h);
+                c1.prev_ = refined.inner(next, 0);
+
+                refined.connectivity(quad).halfedge_ = RefinedMesh::second(h);
+            });
+
+            refined.set_vertex_halfedges();
+            parallel_for(0, static_cast<int>(coarse->faces_size()), [&](int f) {
+                const int h = coarse->halfedge(SurfaceMesh::Face(f)).idx();
+                refined.set_vertex_halfedge(SurfaceMesh::Vertex(fp + f), refined.inner(h, 1));
+            });
+
+            refined.transfer_features();
+        }
 
-                for (auto f : mesh->faces(v))
-                    p += fpoint[f];
 
-                p /= (k * k);
+        // one level of Loop subdivision. Each corner h of a triangle gives the triangle
+        //      (edge point of h) -> (target of h) -> (edge point of next(h)),
+        // and the edge points of each triangle form the central triangle.
+        void loop(const SurfaceMesh *coarse, SurfaceMesh *fine) {
+            std::vector<vec3> vpoint, epoint;
+            loop_points(coarse, vpoint, epoint);
+
+            RefinedMesh refined(coarse, fine);
+            const int nc = refined.num_corners();
+            refined.allocate({&vpoint, &epoint}, nc, nc + static_cast<int>(coarse->faces_size()));
+
+            parallel_for(0, static_cast<int>(coarse->halfedges_size()), [&](int h) {
+                refined.split_halfedge(h);
+                const SurfaceMesh::Halfedge hh(h);
+                const auto f = coarse->face(hh);
+                if (!f.is_valid())
+                    return;
+
+                const int next = coarse->next(hh).idx();
+                const int prev = coarse->prev(hh).idx();
+                const auto corner = refined.corner_face(h);
+                const auto prev_corner = refined.corner_face(prev);
+                const SurfaceMesh::Face center(nc + f.idx());
+
+                const auto out = refined.inner(h, 0);   // from the edge point of next(h) to the edge point of h
+                const auto in = refined.inner(h, 1);    // from the edge point of h to the edge point of next(h)
+
+                auto &a = refined.connectivity(RefinedMesh::first(h));
+                a.face_ = prev_corner;
+                a.next_ = refined.inner(prev, 0);
+                auto &b = refined.connectivity(RefinedMesh::second(h));
+                b.face_ = corner;
+                b.prev_ = out;
+
+                auto &co = refined.connectivity(out);
+                co.vertex_ = refined.edge_point(h);
+                co.face_ = corner;
+                co.next_ = RefinedMesh::second(h);
+                co.prev_ = RefinedMesh::first(next);
+
+                auto &ci = refined.connectivity(in);
+                ci.vertex_ = refined.edge_point(next);
+                ci.face_ = center;
+                ci.next_ = refined.inner(next, 1);
+                ci.prev_ = refined.inner(prev, 1);
+
+                refined.connectivity(corner).halfedge_ = RefinedMesh::second(h);
+            });
+
+            parallel_for(0, static_cast<int>(coarse->faces_size()), [&](int f) {
+                const int h = coarse->halfedge(SurfaceMesh::Face(f)).idx();
+                refined.connectivity(SurfaceMesh::Face(nc + f)).halfedge_ = refined.inner(h, 1);
+            });
+            refined.set_vertex_halfedges();
+
+            refined.transfer_features();
+        }
 
-                p += ((k - 2.0f) / k) * points[v];
 
-                vpoint[v] = p;
+        // applies a subdivision level function several times, alternating between the mesh and a temporary mesh
+        // such that the last level is generated into the mesh.
+        template<typename Level>
+        void subdivide(SurfaceMesh *mesh, unsigned int levels, Level level) {
+            if (mesh->has_garbage())
+                mesh->collect_garbage();
+
+            SurfaceMesh temp;
+            if (levels % 2 == 1)
+                temp = *mesh;
+            for (unsigned int k = 0; k < levels; ++k) {
+                if ((levels - 1 - k) % 2 == 0)
+                    level(&temp, mesh);
+                else
+                    level(mesh, &temp);
             }
         }
 
+    }
+
+
+    bool SurfaceMeshSubdivision::catmull_clark(SurfaceMesh *mesh) {
+        if (!mesh)
+            return false;
+
+        auto vfeature = mesh->get_vertex_property<bool>("v:feature");
+        auto efeature = mesh->get_edge_property<bool>("e:feature");
+
+        // reserve memory
+        std::size_t nv = mesh->n_vertices();
+        std::size_t ne = mesh->n_edges();
+        std::size_t nf = mesh->n_faces();
+        mesh->reserve(nv + ne + nf, 2 * ne + 4 * nf, 4 * nf);
+
+        // compute face, edge, and vertex points
+        std::vector<vec3> vpoint, epoint, fpoint;
+        internal::catmull_clark_points(mesh, vpoint, epoint, fpoint);
+
         // assign new positions to old vertices
+        auto points = mesh->vertex_property<vec3>("v:point");
         for (auto v : mesh->vertices()) {
-            points[v] = vpoint[v];
+            points[v] = vpoint[v.idx()];
         }
 
         // split edges
         for (auto e : mesh->edges()) {
             // feature edge?
             if (efeature && efeature[e]) {
-                auto h = mesh->insert_vertex(e, epoint[e]);
+                auto h = mesh->insert_vertex(e, epoint[e.idx()]);
                 auto v = mesh->target(h);
                 auto e0 = mesh->edge(h);
                 auto e1 = mesh->edge(mesh->next(h));
@@ -146,7 +530,7 @@ namespace easy3d {
 
                 // normal edge
             else {
-                mesh->insert_vertex(e, epoint[e]);
+                mesh->insert_vertex(e, epoint[e.idx()]);
             }
         }
 
@@ -156,7 +540,7 @@ namespace easy3d {
             mesh->insert_edge(h0, mesh->next(mesh->next(h0)));
 
             auto h1 = mesh->next(h0);
-            mesh->insert_vertex(mesh->edge(h1), fpoint[f]);
+            mesh->insert_vertex(mesh->edge(h1), fpoint[f.idx()]);
 
             auto h =
                     mesh->next(mesh->next(mesh->next(h1)));
@@ -167,11 +551,15 @@ namespace easy3d {
             }
         }
 
-        // clean-up properties
-        mesh->remove_vertex_property(vpoint);
-        mesh->remove_edge_property(epoint);
-        mesh->remove_face_property(fpoint);
+        return true;
+    }
+
+
+    bool SurfaceMeshSubdivision::catmull_clark(SurfaceMesh *mesh, unsigned int levels) {
+        if (!mesh)
+            return false;
 
+        internal::subdivide(mesh, levels, internal::catmull_clark);
         return true;
     }
 
@@ -185,7 +573,6 @@ namespace easy3d {
             return false;
         }
 
-        auto points = mesh->vertex_property<vec3>("v:point");
         auto vfeature = mesh->get_vertex_property<bool>("v:feature");
         auto efeature = mesh->get_edge_property<bool>("e:feature");
 
@@ -195,103 +582,21 @@ namespace easy3d {
         std::size_t nf = mesh->n_faces();
         mesh->reserve(nv + ne, 2 * ne + 3 * nf, 4 * nf);
 
-        // add properties
-        auto vpoint = mesh->add_vertex_property<vec3>("loop:vpoint");
-        auto epoint = mesh->add_edge_property<vec3>("loop:epoint");
-
-        // compute vertex positions
-        for (auto v : mesh->vertices()) {
-            // isolated vertex?
-            if (mesh->is_isolated(v)) {
-                vpoint[v] = points[v];
-            }
-
-                // boundary vertex?
-            else if (mesh->is_border(v)) {
-                auto h1 = mesh->out_halfedge(v);
-                auto h0 = mesh->prev(h1);
-
-                vec3 p = points[v];
-                p *= 6.0;
-                p += points[mesh->target(h1)];
-                p += points[mesh->source(h0)];
-                p *= 0.125;
-                vpoint[v] = p;
-            }
-
-                // interior feature vertex?
-            else if (vfeature && vfeature[v]) {
-                vec3 p = points[v];
-                p *= 6.0;
-                int count(0);
-
-                for (auto h : mesh->halfedges(v)) {
-                    if (efeature[mesh->edge(h)]) {
-                        p += points[mesh->target(h)];
-                        ++count;
-                    }
-                }
-
-                if (count == 2) // vertex is on feature edge
-                {
-                    p *= 0.125;
-                    vpoint[v] = p;
-                } else // keep fixed
-                {
-                    vpoint[v] = points[v];
-                }
-            }
-
-                // interior vertex
-            else {
-                vec3 p(0, 0, 0);
-                float k(0);
-
-                for (auto vv : mesh->vertices(v)) {
-                    p += points[vv];
-                    ++k;
-                }
-                p /= k;
-
-                auto beta = static_cast<float>(0.625 - std::pow(0.375 + 0.25 * std::cos(2.0 * M_PI / k), 2.0));
-
-                vpoint[v] = points[v] * (float) (1.0 - beta) + beta * p;
-            }
-        }
-
-        // compute edge positions
-        for (auto e : mesh->edges()) {
-            // boundary or feature edge?
-            if (mesh->is_border(e) || (efeature && efeature[e])) {
-                epoint[e] =
-                        (points[mesh->vertex(e, 0)] + points[mesh->vertex(e, 1)]) *
-                        float(0.5);
-            }
-
-                // interior edge
-            else {
-                auto h0 = mesh->halfedge(e, 0);
-                auto h1 = mesh->halfedge(e, 1);
-                vec3 p = points[mesh->target(h0)];
-                p += points[mesh->target(h1)];
-                p *= 3.0;
-                p += points[mesh->target(mesh->next(h0))];
-                p += points[mesh->target(mesh->next(h1))];
-                p *= 0.125;
-                epoint[e] = p;
-            }
-        }
+        // compute vertex and edge positions
+        std::vector<vec3> vpoint, epoint;
+        internal::loop_points(mesh, vpoint, epoint);
 
         // set new vertex positions
+        auto points = mesh->vertex_property<vec3>("v:point");
         for (auto v : mesh->vertices()) {
-            points[v] = vpoint[v];
+            points[v] = vpoint[v.idx()];
         }
 
         // insert new vertices on edges
         for (auto e : mesh->edges()) {
             // feature edge?
             if (efeature && efeature[e]) {
-                auto h = mesh->insert_vertex(e, epoint[e]);
+                auto h = mesh->insert_vertex(e, epoint[e.idx()]);
                 auto v = mesh->target(h);
                 auto e0 = mesh->edge(h);
                 auto e1 = mesh->edge(mesh->next(h));
@@ -303,7 +608,7 @@ namespace easy3d {
 
                 // normal edge
             else {
-                mesh->insert_vertex(e, epoint[e]);
+                mesh->insert_vertex(e, epoint[e.idx()]);
             }
         }
 
@@ -318,10 +623,20 @@ namespace easy3d {
             mesh->insert_edge(h, mesh->next(mesh->next(h)));
         }
 
-        // clean-up properties
-        mesh->remove_vertex_property(vpoint);
-        mesh->remove_edge_property(epoint);
+        return true;
+    }
+
+
+    bool SurfaceMeshSubdivision::loop(SurfaceMesh *mesh, unsigned int levels) {
+        if (!mesh)
+            return false;
+
+        if (!mesh->is_triangle_mesh()) {
+            LOG(WARNING) << "the Loop subdivision method works only for triangle meshes";
+            return false;
+        }
 
+        internal::subdivide(mesh, levels, internal::loop);
         return true;
     }
 
@@ -28,6 +28,20 @@ namespace easy3d {
          */
         static bool catmull_clark(SurfaceMesh *mesh);
 
+        /**
+         * \brief The Catmull-Clark subdivision applied \p levels times, each level building the refined mesh out of
+         *      place.
+         * \details Instead of splitting the edges and faces of the mesh one by one, the new vertex positions are
+         *      computed in parallel and the connectivity of the refined mesh is generated directly (also in parallel).
+         *      This is much faster than calling catmull_clark(SurfaceMesh*) repeatedly, and it results in the same
+         *      geometry. The vertex positions and the feature flags ("v:feature" and "e:feature") are transferred to
+         *      the refined mesh, while the other properties are removed.
+         * \param mesh The surface mesh to be subdivided. It is replaced by the refined mesh.
+         * \param levels The number of subdivision levels.
+         * \return True if the subdivision was successful, false otherwise.
+         */
+        static bool catmull_clark(SurfaceMesh *mesh, unsigned int levels);
+
         /**
          * \brief The Loop subdivision.
          * \param mesh The surface mesh to be subdivided.
@@ -35,6 +49,15 @@ namespace easy3d {
          */
         static bool loop(SurfaceMesh *mesh);
 
+        /**
+         * \brief The Loop subdivision applied \p levels times, each level building the refined mesh out of place.
+         * \details See catmull_clark(SurfaceMesh*, unsigned int) for details.
+         * \param mesh The surface (triangle) mesh to be subdivided. It is replaced by the refined mesh.
+         * \param levels The number of subdivision levels.
+         * \return True if the subdivision was successful, false otherwise.
+         */
+        static bool loop(SurfaceMesh *mesh, unsigned int levels);
+
         /**
          * \brief The sqrt3 subdivision.
          * \param mesh The surface mesh to be subdivided.
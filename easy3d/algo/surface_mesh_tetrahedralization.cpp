@@ -175,19 +175,20 @@ namespace easy3d {
             p += 3;
         }
 
-        int *t = volume->tetrahedronlist;
-        for (int i = 0; i < volume->numberoftetrahedra; i++) {
-            PolyMesh::Cell c = mesh->add_tetra(
-                    PolyMesh::Vertex(t[0] - volume->firstnumber),
-                    PolyMesh::Vertex(t[1] - volume->firstnumber),
-                    PolyMesh::Vertex(t[2] - volume->firstnumber),
-                    PolyMesh::Vertex(t[3] - volume->firstnumber)
-                    );
-
-            if (tag_regions_)
-                region[c] = volume->tetrahedronattributelist[i];
-
-            t += 4;
+        // all tetrahedra are added at once (see PolyMesh::add_tetras())
+        const int *t = volume->tetrahedronlist;
+        std::vector<unsigned int> indices(t, t + volume->numberoftetrahedra * 4);
+        for (auto& id : indices)
+            id -= volume->firstnumber;
+        if (mesh->add_tetras(indices) != static_cast<unsigned int>(volume->numberoftetrahedra)) {
+            LOG(ERROR) << "tetrahedral mesh has invalid tetrahedra";
+            delete mesh;
+            return nullptr;
+        }
+
+        if (tag_regions_) {
+            for (auto c : mesh->cells())
+                region[c] = volume->tetrahedronattributelist[c.idx()];
         }
 
         return mesh;
@@ -0,0 +1,432 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#include <easy3d/algo/surface_mesh_validation.h>
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+#include <easy3d/util/thread_pool.h>
+#include <easy3d/util/string.h>
+#include <easy3d/util/logging.h>
+
+
+namespace easy3d {
+
+    namespace internal {
+
+        // lexicographic order of points, exact comparison.
+        inline bool lexicographically_smaller(const vec3 &a, const vec3 &b) {
+            if (a.x != b.x) return a.x < b.x;
+            if (a.y != b.y) return a.y < b.y;
+            return a.z < b.z;
+        }
+
+        // the vertex positions of a face in lexicographic order, used to identify duplicate faces.
+        inline void sorted_positions(const SurfaceMesh *mesh, SurfaceMesh::Face f, std::vector<vec3> &points) {
+            points.clear();
+            for (auto v : mesh->vertices(f))
+                points.push_back(mesh->position(v));
+            std::sort(points.begin(), points.end(), lexicographically_smaller);
+        }
+
+        inline uint64_t hash_positions(const std::vector<vec3> &points) {
+            uint64_t h = 1469598103934665603ull;    // FNV-1a
+            for (const auto &p : points) {
+                for (int i = 0; i < 3; ++i) {
+                    uint32_t bits;
+                    std::memcpy(&bits, &p[i], sizeof(bits));
+                    h = (h ^ bits) * 1099511628211ull;
+                }
+            }
+            return h;
+        }
+
+        // union-find with path halving
+        inline int find_root(std::vector<int> &parent, int i) {
+            while (parent[i] != i) {
+                parent[i] = parent[parent[i]];
+                i = parent[i];
+            }
+            return i;
+        }
+
+    }
+
+
+    bool SurfaceMeshValidation::Report::is_clean() const {
+        return isolated_vertices == 0 && non_manifold_vertices == 0 && degenerate_faces == 0 &&
+               duplicate_faces == 0 && unstitched_borders == 0 && incompatible_borders == 0 && small_components == 0;
+    }
+
+
+    std::string SurfaceMeshValidation::Report::to_string() const {
+        return string::printf("isolated vertices: %zu, non-manifold vertices: %zu, degenerate faces: %zu, "
+                              "duplicate faces: %zu, unstitched border edges: %zu, incompatible border edges: %zu, "
+                              "components: %zu (small: %zu, with %zu faces)",
+                              isolated_vertices, non_manifold_vertices, degenerate_faces, duplicate_faces,
+                              unstitched_borders, incompatible_borders, components, small_components,
+                              small_component_faces);
+    }
+
+
+    SurfaceMeshValidation::SurfaceMeshValidation(SurfaceMesh *mesh)
+            : mesh_(mesh), degenerate_threshold_(1e-6f), min_component_size_(10) {
+    }
+
+
+    const SurfaceMeshValidation::Report &SurfaceMeshValidation::validate(int problems) {
+        report_ = Report();
+        isolated_vertices_.clear();
+        non_manifold_vertices_.clear();
+        degenerate_faces_.clear();
+        duplicate_faces_.clear();
+        small_component_faces_.clear();
+
+        if (problems & (ISOLATED_VERTICES | NON_MANIFOLD_VERTICES))
+            check_vertices(problems);
+        if (problems & (DEGENERATE_FACES | DUPLICATE_FACES))
+            check_faces(problems);
+        if (problems & COINCIDENT_BORDERS)
+            check_borders();
+        if (problems & SMALL_COMPONENTS)
+            check_components();
+
+        return report_;
+    }
+
+
+    void SurfaceMeshValidation::check_vertices(int problems) {
+        const int nv = static_cast<int>(mesh_->vertices_size());
+        // 0: ok, 1: isolated, 2: non-manifold
+        std::vector<unsigned char> status(nv, 0);
+        parallel_for(0, nv, [&](int i) {
+            const SurfaceMesh::Vertex v(i);
+            if (mesh_->is_deleted(v))
+                return;
+            if (mesh_->is_isolated(v))
+                status[i] = 1;
+            else if (!mesh_->is_manifold(v))
+                status[i] = 2;
+        });
+
+        for (int i = 0; i < nv; ++i) {
+            if (status[i] == 1 && (problems & ISOLATED_VERTICES))
+                isolated_vertices_.emplace_back(i);
+            else if (status[i] == 2 && (problems & NON_MANIFOLD_VERTICES))
+                non_manifold_vertices_.emplace_back(i);
+        }
+        report_.isolated_vertices = isolated_vertices_.size();
+        report_.non_manifold_vertices = non_manifold_vertices_.size();
+    }
+
+
+    void SurfaceMeshValidation::check_faces(int problems) {
+        const int nf = static_cast<int>(mesh_->faces_size());
+        const float min_height = degenerate_threshold_ * mesh_->bounding_box(true).diagonal_length();
+        const bool check_duplicates = (problems & DUPLICATE_FACES);
+        const bool check_degenerate = (problems & DEGENERATE_FACES);
+
+        std::vector<unsigned char> degenerate(nf, 0);
+        std::vector<uint64_t> hashes(check_duplicates ? nf : 0);
+        parallel_for(0, nf, [&](int i) {
+            const SurfaceMesh::Face f(i);
+            if (mesh_->is_deleted(f))
+                return;
+
+            if (check_degenerate) {
+                // the area (Newell's method, also valid for non-planar polygons) and the longest edge
+                vec3 normal(0, 0, 0);
+                float longest = 0.0f;
+                for (auto h : mesh_->halfedges(f)) {
+                    const vec3 &p = mesh_->position(mesh_->source(h));
+                    const vec3 &q = mesh_->position(mesh_->target(h));
+                    normal += cross(p, q);
+                    longest = std::max(longest, distance2(p, q));
+                }
+                longest = std::sqrt(longest);
+                // height = 2 * area / longest = |normal| / longest
+                if (longest <= min_height || normal.length() < min_height * longest)
+                    degenerate[i] = 1;
+            }
+
+            if (check_duplicates) {
+                thread_local std::vector<vec3> points;
+                internal::sorted_positions(mesh_, f, points);
+                hashes[i] = internal::hash_positions(points);
+            }
+        });
+
+        if (check_degenerate) {
+            for (int i = 0; i < nf; ++i) {
+                if (degenerate[i])
+                    degenerate_faces_.emplace_back(i);
+            }
+            report_.degenerate_faces = degenerate_faces_.size();
+        }
+
+        if (check_duplicates) {
+            std::vector<int> order;
+            order.reserve(mesh_->n_faces());
+            for (auto f : mesh_->faces())
+                order.push_back(f.idx());
+            std::sort(order.begin(), order.end(), [&](int a, int b) {
+                return hashes[a] < hashes[b] || (hashes[a] == hashes[b] && a < b);
+            });
+
+            // within a group of equal hashes, a face is a duplicate if it has the same vertex positions as an
+            // earlier (i.e., lower index) face that is not a duplicate itself.
+            std::vector<vec3> pi, pj;
+            std::vector<char> is_duplicate;
+            for (std::size_t begin = 0, end = 0; begin < order.size(); begin = end) {
+                end = begin + 1;
+                while (end < order.size() && hashes[order[end]] == hashes[order[begin]])
+                    ++end;
+                if (end - begin == 1)
+                    continue;
+                is_duplicate.assign(end - begin, 0);
+                for (std::size_t i = begin; i < end; ++i) {
+                    if (is_duplicate[i - begin])
+                        continue;
+                    internal::sorted_positions(mesh_, SurfaceMesh::Face(order[i]), pi);
+                    for (std::size_t j = i + 1; j < end; ++j) {
+                        if (is_duplicate[j - begin])
+                            continue;
+                        internal::sorted_positions(mesh_, SurfaceMesh::Face(order[j]), pj);
+                        if (pi == pj) {
+                            is_duplicate[j - begin] = 1;
+                            duplicate_faces_.emplace_back(order[j]);
+                        }
+                    }
+                }
+            }
+            report_.duplicate_faces = duplicate_faces_.size();
+        }
+    }
+
+
+    void SurfaceMeshValidation::check_borders() {
+        const int nh = static_cast<int>(mesh_->halfedges_size());
+        std::vector<unsigned char> border(nh, 0);
+        parallel_for(0, nh, [&](int i) {
+            const SurfaceMesh::Halfedge h(i);
+            if (!mesh_->is_deleted(mesh_->edge(h)) && mesh_->is_border(h))
+                border[i] = 1;
+        });
+
+        // each border edge is represented by its end points going from the lexicographically smaller one to the
+        // larger one, and a flag telling if it has the same direction.
+        struct BorderEdge {
+            vec3 a, b;
+            bool forward;
+        };
+        std::vector<BorderEdge> edges;
+        for (int i = 0; i < nh; ++i) {
+            if (!border[i])
+                continue;
+            const SurfaceMesh::Halfedge h(i);
+            const vec3 &s = mesh_->position(mesh_->source(h));
+            const vec3 &t = mesh_->position(mesh_->target(h));
+            if (s == t)
+                continue;
+            if (internal::lexicographically_smaller(s, t))
+                edges.push_back({s, t, true});
+            else
+                edges.push_back({t, s, false});
+        }
+
+        const auto less = [](const BorderEdge &e0, const BorderEdge &e1) {
+            if (e0.a != e1.a) return internal::lexicographically_smaller(e0.a, e1.a);
+            return internal::lexicographically_smaller(e0.b, e1.b);
+        };
+        std::sort(edges.begin(), edges.end(), less);
+
+        for (std::size_t begin = 0, end = 0; begin < edges.size(); begin = end) {
+            end = begin + 1;
+            while (end < edges.size() && edges[end].a == edges[begin].a && edges[end].b == edges[begin].b)
+                ++end;
+            if (end - begin == 1)
+                continue;
+            std::size_t num_forward = 0;
+            for (std::size_t i = begin; i < end; ++i)
+                num_forward += edges[i].forward;
+            const std::size_t num_backward = (end - begin) - num_forward;
+            // an edge is unstitched if an opposite one exists, and incompatible if another one with the same
+            // direction exists.
+            if (num_forward > 0 && num_backward > 0)
+                report_.unstitched_borders += end - begin;
+            if (num_forward > 1)
+                report_.incompatible_borders += num_forward;
+            if (num_backward > 1)
+                report_.incompatible_borders += num_backward;
+        }
+    }
+
+
+    void SurfaceMeshValidation::check_components() {
+        const int nf = static_cast<int>(mesh_->faces_size());
+        std::vector<int> parent(nf);
+        std::iota(parent.begin(), parent.end(), 0);
+        for (auto e : mesh_->edges()) {
+            const auto f0 = mesh_->face(e, 0);
+            const auto f1 = mesh_->face(e, 1);
+            if (f0.is_valid() && f1.is_valid()) {
+                const int r0 = internal::find_root(parent, f0.idx());
+                const int r1 = internal::find_root(parent, f1.idx());
+                if (r0 != r1)
+                    parent[std::max(r0, r1)] = std::min(r0, r1);
+            }
+        }
+
+        std::vector<std::size_t> size(nf, 0);
+        for (auto f : mesh_->faces())
+            ++size[internal::find_root(parent, f.idx())];
+
+        for (int i = 0; i < nf; ++i) {
+            if (size[i] == 0)
+                continue;
+            ++report_.components;
+            if (size[i] < min_component_size_) {
+                ++report_.small_components;
+                report_.small_component_faces += size[i];
+            }
+        }
+        for (auto f : mesh_->faces()) {
+            if (size[internal::find_root(parent, f.idx())] < min_component_size_)
+                small_component_faces_.push_back(f);
+        }
+    }
+
+
+    SurfaceMeshValidation::Report SurfaceMeshValidation::repair(int problems) {
+        validate(problems);
+
+        Report fixed;
+        // delete the problematic faces
+        const auto delete_faces = [this](const std::vector<SurfaceMesh::Face> &faces) -> std::size_t {
+            std::size_t count = 0;
+            for (auto f : faces) {
+                if (!mesh_->is_deleted(f)) {
+                    mesh_->delete_face(f);
+                    ++count;
+                }
+            }
+            return count;
+        };
+        if (problems & DUPLICATE_FACES)
+            fixed.duplicate_faces = delete_faces(duplicate_faces_);
+        if (problems & DEGENERATE_FACES)
+            fixed.degenerate_faces = delete_faces(degenerate_faces_);
+        if (problems & SMALL_COMPONENTS) {
+            fixed.small_component_faces = delete_faces(small_component_faces_);
+            fixed.small_components = report_.small_components;
+        }
+
+        // the deletion may have made more vertices non-manifold, so they are collected again.
+        if (problems & NON_MANIFOLD_VERTICES) {
+            if (!duplicate_faces_.empty() || !degenerate_faces_.empty() || !small_component_faces_.empty()) {
+                non_manifold_vertices_.clear();
+                check_vertices(NON_MANIFOLD_VERTICES);
+            }
+            for (auto v : non_manifold_vertices_) {
+                if (split_fans(v) > 0)
+                    ++fixed.non_manifold_vertices;
+            }
+        }
+
+        // vertices that became isolated by deleting faces have already been deleted by delete_face().
+        if (problems & ISOLATED_VERTICES) {
+            for (auto v : isolated_vertices_) {
+                if (!mesh_->is_deleted(v) && mesh_->is_isolated(v)) {
+                    mesh_->delete_vertex(v);
+                    ++fixed.isolated_vertices;
+                }
+            }
+        }
+
+        if (mesh_->has_garbage())
+            mesh_->collect_garbage();
+
+        // the collected elements are no longer valid after the garbage collection
+        validate(0);
+
+        LOG_IF(fixed.duplicate_faces > 0, INFO) << fixed.duplicate_faces << " duplicate faces deleted";
+        LOG_IF(fixed.degenerate_faces > 0, INFO) << fixed.degenerate_faces << " degenerate faces deleted";
+        LOG_IF(fixed.small_components > 0, INFO) << fixed.small_components << " small components ("
+                                                 << fixed.small_component_faces << " faces) deleted";
+        LOG_IF(fixed.non_manifold_vertices > 0, INFO) << fixed.non_manifold_vertices << " non-manifold vertices split";
+        LOG_IF(fixed.isolated_vertices > 0, INFO) << fixed.isolated_vertices << " isolated vertices deleted";
+        return fixed;
+    }
+
+
+    std::size_t SurfaceMeshValidation::split_fans(SurfaceMesh::Vertex v) {
+        // the outgoing halfedges in clockwise order, starting from a border halfedge. Each border halfedge starts
+        // a fan, i.e., a sequence of faces connected by edges around v.
+        std::vector<SurfaceMesh::Halfedge> outgoing;
+        const auto h0 = mesh_->out_halfedge(v);
+        auto h = h0;
+        do {
+            outgoing.push_back(h);
+            h = mesh_->next_around_source(h);
+        } while (h != h0);
+        const auto first = std::find_if(outgoing.begin(), outgoing.end(), [this](SurfaceMesh::Halfedge h) {
+            return mesh_->is_border(h);
+        });
+        if (first == outgoing.end())
+            return 0;
+        std::rotate(outgoing.begin(), first, outgoing.end());
+
+        std::vector<std::size_t> starts;
+        for (std::size_t i = 0; i < outgoing.size(); ++i) {
+            if (mesh_->is_border(outgoing[i]))
+                starts.push_back(i);
+        }
+        if (starts.size() < 2)
+            return 0;
+        starts.push_back(outgoing.size());
+
+        const vec3 p = mesh_->position(v);
+        for (std::size_t k = 0; k + 1 < starts.size(); ++k) {
+            const auto start = outgoing[starts[k]];
+            const auto last = outgoing[starts[k + 1] - 1];
+            // close the border loop of this fan (the incoming border halfedge used to lead to the next fan)
+            mesh_->set_next(mesh_->opposite(last), start);
+            if (k == 0) {
+                mesh_->set_out_halfedge(v, start);
+                continue;
+            }
+            const auto u = mesh_->add_vertex(p);
+            for (std::size_t i = starts[k]; i < starts[k + 1]; ++i)
+                mesh_->set_target(mesh_->opposite(outgoing[i]), u);
+            mesh_->set_out_halfedge(u, start);
+        }
+        mesh_->touch_topology();  // the connectivity has been modified by the low-level setters
+        return starts.size() - 2;
+    }
+
+} // namespace easy3d
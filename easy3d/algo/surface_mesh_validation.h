@@ -0,0 +1,158 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#ifndef EASY3D_ALGO_SURFACE_MESH_VALIDATION_H
+#define EASY3D_ALGO_SURFACE_MESH_VALIDATION_H
+
+
+#include <string>
+#include <vector>
+
+#include <easy3d/core/surface_mesh.h>
+
+
+namespace easy3d {
+
+    /**
+     * \brief Validation and repair of the topology of a surface mesh.
+     * \class SurfaceMeshValidation easy3d/algo/surface_mesh_validation.h
+     * \details All checks are computed in a few parallel passes over the vertices, faces, and edges of the mesh and
+     *      summarized in a compact Report. The selected problems can then be repaired in a single batch, followed by
+     *      a single garbage collection. Example usage:
+     *      \code
+     *          SurfaceMeshValidation validation(mesh);
+     *          const auto& report = validation.validate();
+     *          if (!report.is_clean()) {
+     *              LOG(INFO) << report.to_string();
+     *              validation.repair(SurfaceMeshValidation::ISOLATED_VERTICES | SurfaceMeshValidation::DUPLICATE_FACES);
+     *          }
+     *      \endcode
+     * \note Non-manifold edges cannot exist in a SurfaceMesh (they are already resolved when the mesh is built, see
+     *      SurfaceMeshBuilder), so they are not checked. Coincident border edges are reported but not repaired: use
+     *      Surfacer::stitch_borders() and Surfacer::merge_reversible_connected_components() for that.
+     */
+    class SurfaceMeshValidation {
+    public:
+        /// \brief The problems that can be detected (and some of them repaired). They can be combined as bit flags.
+        enum Problem {
+            ISOLATED_VERTICES = 1 << 0,         ///< Vertices not incident to any face. Repair: deleted.
+            NON_MANIFOLD_VERTICES = 1 << 1,     ///< Vertices shared by several fans of faces. Repair: each extra fan gets its own copy of the vertex.
+            DEGENERATE_FACES = 1 << 2,          ///< Faces with (almost) zero area. Repair: deleted.
+            DUPLICATE_FACES = 1 << 3,           ///< Faces having the same vertex positions as another face. Repair: all but the first one are deleted.
+            COINCIDENT_BORDERS = 1 << 4,        ///< Border edges at the same location as another border edge (detection only).
+            SMALL_COMPONENTS = 1 << 5,          ///< Connected components with too few faces. Repair: deleted.
+            ALL = ISOLATED_VERTICES | NON_MANIFOLD_VERTICES | DEGENERATE_FACES | DUPLICATE_FACES |
+                  COINCIDENT_BORDERS | SMALL_COMPONENTS
+        };
+
+        /// \brief The summary of a validation (or the numbers of elements fixed by a repair).
+        struct Report {
+            std::size_t isolated_vertices = 0;      ///< Number of isolated vertices.
+            std::size_t non_manifold_vertices = 0;  ///< Number of non-manifold vertices.
+            std::size_t degenerate_faces = 0;       ///< Number of degenerate faces.
+            std::size_t duplicate_faces = 0;        ///< Number of duplicate faces (not counting the first copy).
+            std::size_t unstitched_borders = 0;     ///< Number of border edges coincident with an opposite border edge.
+            std::size_t incompatible_borders = 0;   ///< Number of border edges coincident with an equally oriented border edge.
+            std::size_t components = 0;             ///< Number of connected components.
+            std::size_t small_components = 0;       ///< Number of small connected components.
+            std::size_t small_component_faces = 0;  ///< Number of faces in the small connected components.
+
+            /// \brief Returns true if no problem was found.
+            bool is_clean() const;
+            /// \brief Returns a one-line summary of the report.
+            std::string to_string() const;
+        };
+
+    public:
+        /**
+         * \brief Constructor.
+         * \param mesh The surface mesh to validate (and repair).
+         */
+        explicit SurfaceMeshValidation(SurfaceMesh *mesh);
+
+        /**
+         * \brief Sets the threshold for degenerate faces.
+         * \param t A face is degenerate if its height (i.e., twice its area divided by its longest edge) is smaller
+         *      than \p t times the diagonal length of the bounding box of the mesh. The default value is 1e-6.
+         */
+        void set_degenerate_threshold(float t) { degenerate_threshold_ = t; }
+
+        /**
+         * \brief Sets the minimum size of a connected component.
+         * \param n Components with less than \p n faces are small components. The default value is 10.
+         */
+        void set_min_component_size(std::size_t n) { min_component_size_ = n; }
+
+        /**
+         * \brief Checks the mesh for the specified problems.
+         * \param problems The problems to check, a combination of the Problem flags. Default is ALL.
+         * \return The report. Only the entries related to the checked problems are filled in.
+         */
+        const Report &validate(int problems = ALL);
+
+        /**
+         * \brief Repairs the specified problems in a single batch.
+         * \details The problematic faces are deleted first, then the non-manifold vertices (including those caused
+         *      by the deletions) are split, and the isolated vertices are deleted. The garbage is collected only
+         *      once at the end, after which the report of the last validation is cleared (call validate() again to
+         *      check the repaired mesh).
+         * \param problems The problems to repair, a combination of the Problem flags. Default is ALL.
+         * \return The numbers of elements fixed, e.g., Report::duplicate_faces is the number of deleted duplicate
+         *      faces and Report::non_manifold_vertices the number of split vertices.
+         */
+        Report repair(int problems = ALL);
+
+        /// \brief Returns the report of the last validation.
+        const Report &report() const { return report_; }
+
+    private:
+        void check_vertices(int problems);
+        void check_faces(int problems);
+        void check_borders();
+        void check_components();
+
+        // splits the fans of a non-manifold vertex, returns the number of new vertices.
+        std::size_t split_fans(SurfaceMesh::Vertex v);
+
+    private:
+        SurfaceMesh *mesh_;     //!< The surface mesh to validate.
+
+        float degenerate_threshold_;
+        std::size_t min_component_size_;
+
+        Report report_;
+        // the elements found by the last validation
+        std::vector<SurfaceMesh::Vertex> isolated_vertices_;
+        std::vector<SurfaceMesh::Vertex> non_manifold_vertices_;
+        std::vector<SurfaceMesh::Face> degenerate_faces_;
+        std::vector<SurfaceMesh::Face> duplicate_faces_;
+        std::vector<SurfaceMesh::Face> small_component_faces_;
+    };
+
+} // namespace easy3d
+
+
+#endif  // EASY3D_ALGO_SURFACE_MESH_VALIDATION_H
@@ -0,0 +1,481 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#include <easy3d/algo/virtual_scanner.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <easy3d/core/point_cloud.h>
+#include <easy3d/core/surface_mesh.h>
+#include <easy3d/util/logging.h>
+#include <easy3d/util/stop_watch.h>
+#include <easy3d/util/thread_pool.h>
+
+
+namespace easy3d {
+
+    namespace internal {
+
+        // A counter-based random number generator (SplitMix64). The noise of a ray only depends on the seed and the
+        // index of the ray, so the result does not depend on the order in which the rays are processed.
+        inline uint64_t splitmix64(uint64_t x) {
+            x += 0x9E3779B97F4A7C15ull;
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+            return x ^ (x >> 31);
+        }
+
+        // returns a normally distributed number (mean 0, standard deviation 1) for the given seed and counter
+        inline float gaussian(unsigned int seed, std::size_t counter) {
+            const uint64_t r = splitmix64((static_cast<uint64_t>(seed) << 32) ^ splitmix64(counter));
+            // two uniform numbers in (0, 1] and [0, 1), then the Box-Muller transform
+            const double u1 = (static_cast<double>(r >> 40) + 1.0) / 16777216.0;
+            const double u2 = static_cast<double>(r & 0xFFFFFF) / 16777216.0;
+            return static_cast<float>(std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * M_PI * u2));
+        }
+
+        // builds an orthonormal frame (x, y, z) with z aligned with the given direction
+        inline void make_frame(const vec3 &dir, vec3 &x, vec3 &y, vec3 &z) {
+            z = normalize(dir);
+            const vec3 ref = std::abs(z.x) < 0.9f ? vec3(1, 0, 0) : vec3(0, 1, 0);
+            x = normalize(cross(ref, z));
+            y = cross(z, x);
+        }
+
+        // slab test. Returns true if the ray hits the box within [0, t_max].
+        inline bool hit_box(const vec3 &bmin, const vec3 &bmax, const vec3 &origin, const vec3 &inv_dir, float t_max) {
+            float t0 = 0.0f, t1 = t_max;
+            for (int i = 0; i < 3; ++i) {
+                float near = (bmin[i] - origin[i]) * inv_dir[i];
+                float far = (bmax[i] - origin[i]) * inv_dir[i];
+                if (near > far)
+                    std::swap(near, far);
+                t0 = near > t0 ? near : t0;
+                t1 = far < t1 ? far : t1;
+                if (t0 > t1)
+                    return false;
+            }
+            return true;
+        }
+
+    }
+
+
+    VirtualScanner::PinholeSensor::PinholeSensor(const vec3 &position, const vec3 &target, const vec3 &up,
+                                                 float fov, int width, int height)
+            : position_(position), tan_half_fov_(std::tan(fov * 0.5f * static_cast<float>(M_PI) / 180.0f))
+            , width_(std::max(width, 1)), height_(std::max(height, 1))
+    {
+        z_ = normalize(target - position);
+        x_ = normalize(cross(z_, up));
+        y_ = cross(x_, z_);
+    }
+
+
+    void VirtualScanner::PinholeSensor::ray(std::size_t i, vec3 &origin, vec3 &dir) const {
+        const auto row = static_cast<int>(i / width_);
+        const auto col = static_cast<int>(i % width_);
+        const float aspect = static_cast<float>(width_) / static_cast<float>(height_);
+        // pixel center in normalized device coordinates, the first row is at the top
+        const float u = (2.0f * (static_cast<float>(col) + 0.5f) / static_cast<float>(width_) - 1.0f) * aspect * tan_half_fov_;
+        const float v = (1.0f - 2.0f * (static_cast<float>(row) + 0.5f) / static_cast<float>(height_)) * tan_half_fov_;
+        origin = position_;
+        dir = normalize(z_ + x_ * u + y_ * v);
+    }
+
+
+    VirtualScanner::SphericalSensor::SphericalSensor(const vec3 &position, int azimuth_steps, int elevation_steps,
+                                                     float min_elevation, float max_elevation, const vec3 &up)
+            : position_(position), azimuth_steps_(std::max(azimuth_steps, 1)), elevation_steps_(std::max(elevation_steps, 1))
+            , min_elevation_(min_elevation * static_cast<float>(M_PI) / 180.0f)
+            , max_elevation_(max_elevation * static_cast<float>(M_PI) / 180.0f)
+    {
+        internal::make_frame(up, x_, y_, z_);
+    }
+
+
+    void VirtualScanner::SphericalSensor::ray(std::size_t i, vec3 &origin, vec3 &dir) const {
+        const auto azimuth_idx = static_cast<int>(i / elevation_steps_);
+        const auto elevation_idx = static_cast<int>(i % elevation_steps_);
+        const float azimuth = 2.0f * static_cast<float>(M_PI) * static_cast<float>(azimuth_idx) / static_cast<float>(azimuth_steps_);
+        const float elevation = (elevation_steps_ == 1) ? 0.5f * (min_elevation_ + max_elevation_) :
+                min_elevation_ + (max_elevation_ - min_elevation_) * static_cast<float>(elevation_idx) / static_cast<float>(elevation_steps_ - 1);
+        const float ce = std::cos(elevation);
+        origin = position_;
+        dir = x_ * (ce * std::cos(azimuth)) + y_ * (ce * std::sin(azimuth)) + z_ * std::sin(elevation);
+    }
+
+
+    VirtualScanner::MultiBeamSensor::MultiBeamSensor(const vec3 &position, int num_beams, float min_elevation,
+                                                     float max_elevation, int azimuth_steps, const vec3 &up)
+            : position_(position), azimuth_steps_(std::max(azimuth_steps, 1))
+    {
+        num_beams = std::max(num_beams, 1);
+        for (int i = 0; i < num_beams; ++i) {
+            const float elevation = (num_beams == 1) ? 0.5f * (min_elevation + max_elevation) :
+                    min_elevation + (max_elevation - min_elevation) * static_cast<float>(i) / static_cast<float>(num_beams - 1);
+            elevations_.push_back(elevation * static_cast<float>(M_PI) / 180.0f);
+        }
+        init_frame(up);
+    }
+
+
+    VirtualScanner::MultiBeamSensor::MultiBeamSensor(const vec3 &position, const std::vector<float> &elevations,
+                                                     int azimuth_steps, const vec3 &up)
+            : position_(position), azimuth_steps_(std::max(azimuth_steps, 1))
+    {
+        for (auto e : elevations)
+            elevations_.push_back(e * static_cast<float>(M_PI) / 180.0f);
+        std::sort(elevations_.begin(), elevations_.end());
+        if (elevations_.empty())
+            elevations_.push_back(0.0f);
+        init_frame(up);
+    }
+
+
+    void VirtualScanner::MultiBeamSensor::init_frame(const vec3 &up) {
+        internal::make_frame(up, x_, y_, z_);
+    }
+
+
+    void VirtualScanner::MultiBeamSensor::ray(std::size_t i, vec3 &origin, vec3 &dir) const {
+        const std::size_t beam = i % elevations_.size();
+        const std::size_t firing = i / elevations_.size();
+        const float azimuth = 2.0f * static_cast<float>(M_PI) * static_cast<float>(firing) / static_cast<float>(azimuth_steps_);
+        const float elevation = elevations_[beam];
+        const float ce = std::cos(elevation);
+        origin = position_;
+        dir = x_ * (ce * std::cos(azimuth)) + y_ * (ce * std::sin(azimuth)) + z_ * std::sin(elevation);
+    }
+
+
+    VirtualScanner::VirtualScanner()
+            : num_meshes_(0), dirty_(false), min_range_(0.0f), max_range_(std::numeric_limits<float>::max())
+            , noise_sigma_(0.0f), seed_(0), packet_size_(256)
+    {
+    }
+
+
+    void VirtualScanner::add_mesh(const SurfaceMesh *mesh, const mat4 &transform, float reflectance) {
+        if (!mesh || mesh->n_faces() == 0) {
+            LOG(WARNING) << "empty surface mesh";
+            return;
+        }
+
+        const int mesh_id = static_cast<int>(num_meshes_);
+        const auto &points = mesh->points();
+        std::vector<vec3> pts(points.size());
+        for (std::size_t i = 0; i < points.size(); ++i)
+            pts[i] = transform * points[i];
+
+        std::vector<int> ids;
+        for (auto f : mesh->faces()) {
+            ids.clear();
+            for (auto v : mesh->vertices(f))
+                ids.push_back(v.idx());
+            // triangle fan for general polygons
+            for (std::size_t k = 1; k + 1 < ids.size(); ++k) {
+                Triangle t;
+                t.v0 = pts[ids[0]];
+                t.e1 = pts[ids[k]] - t.v0;
+                t.e2 = pts[ids[k + 1]] - t.v0;
+                t.normal = cross(t.e1, t.e2);
+                const float len = length(t.normal);
+                if (len < std::numeric_limits<float>::min())
+                    continue; // degenerate
+                t.normal /= len;
+                t.mesh = mesh_id;
+                t.face = f.idx();
+                triangles_.push_back(t);
+            }
+        }
+
+        reflectance_.push_back(reflectance);
+        ++num_meshes_;
+        dirty_ = true;
+    }
+
+
+    void VirtualScanner::clear() {
+        triangles_.clear();
+        reflectance_.clear();
+        nodes_.clear();
+        num_meshes_ = 0;
+        dirty_ = false;
+    }
+
+
+    void VirtualScanner::build() {
+        nodes_.clear();
+        if (triangles_.empty()) {
+            dirty_ = false;
+            return;
+        }
+
+        StopWatch w;
+        const int leaf_size = 4;
+
+        std::vector<vec3> centers(triangles_.size());
+        for (std::size_t i = 0; i < triangles_.size(); ++i) {
+            const Triangle &t = triangles_[i];
+            centers[i] = t.v0 + (t.e1 + t.e2) / 3.0f;
+        }
+        std::vector<int> order(triangles_.size());
+        for (std::size_t i = 0; i < order.size(); ++i)
+            order[i] = static_cast<int>(i);
+
+        // the BVH of n triangles (with leaves of size >= 1) has at most 2n - 1 nodes
+        nodes_.reserve(2 * triangles_.size());
+        nodes_.push_back(Node());
+
+        struct Task {
+            int node;
+            int begin, end;
+        };
+        std::vector<Task> stack;
+        stack.push_back({0, 0, static_cast<int>(order.size())});
+        while (!stack.empty()) {
+            const Task task = stack.back();
+            stack.pop_back();
+
+            // bounding box of the triangles and their centers
+            vec3 bmin(std::numeric_limits<float>::max()), bmax(-std::numeric_limits<float>::max());
+            vec3 cmin = bmin, cmax = bmax;
+            for (int i = task.begin; i < task.end; ++i) {
+                const Triangle &t = triangles_[order[i]];
+                const vec3 v[3] = {t.v0, t.v0 + t.e1, t.v0 + t.e2};
+                for (const auto &p : v) {
+                    bmin = comp_min(bmin, p);
+                    bmax = comp_max(bmax, p);
+                }
+                cmin = comp_min(cmin, centers[order[i]]);
+                cmax = comp_max(cmax, centers[order[i]]);
+            }
+
+            Node &node = nodes_[task.node];
+            node.bmin = bmin;
+            node.bmax = bmax;
+
+            const vec3 extent = cmax - cmin;
+            int axis = 0;
+            if (extent[1] > extent[axis]) axis = 1;
+            if (extent[2] > extent[axis]) axis = 2;
+
+            const int count = task.end - task.begin;
+            if (count <= leaf_size || extent[axis] <= 0.0f) { // leaf
+                node.index = task.begin;
+                node.count = count;
+                node.axis = axis;
+                continue;
+            }
+
+            // split at the median of the centers along the longest axis
+            const int mid = task.begin + count / 2;
+            std::nth_element(order.begin() + task.begin, order.begin() + mid, order.begin() + task.end,
+                             [&](int a, int b) -> bool { return centers[a][axis] < centers[b][axis]; });
+
+            const int left = static_cast<int>(nodes_.size());
+            node.index = left;
+            node.count = 0;
+            node.axis = axis;
+            nodes_.push_back(Node());   // 'node' may be invalid from now on
+            nodes_.push_back(Node());
+            stack.push_back({left + 1, mid, task.end});
+            stack.push_back({left, task.begin, mid});
+        }
+
+        // reorder the triangles such that the triangles of each leaf are contiguous
+        std::vector<Triangle> sorted(triangles_.size());
+        for (std::size_t i = 0; i < order.size(); ++i)
+            sorted[i] = triangles_[order[i]];
+        triangles_.swap(sorted);
+
+        dirty_ = false;
+        LOG(INFO) << "BVH built (" << triangles_.size() << " triangles, " << nodes_.size() << " nodes). "
+                  << w.time_string();
+    }
+
+
+    bool VirtualScanner::intersect(const vec3 &origin, const vec3 &dir, float t_max, Hit &hit) const {
+        if (nodes_.empty())
+            return false;
+
+        const float inf = std::numeric_limits<float>::max();
+        const vec3 inv_dir(dir.x != 0.0f ? 1.0f / dir.x : inf,
+                           dir.y != 0.0f ? 1.0f / dir.y : inf,
+                           dir.z != 0.0f ? 1.0f / dir.z : inf);
+
+        hit.t = t_max;
+        hit.triangle = -1;
+
+        int stack[64];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const Node &node = nodes_[stack[--top]];
+            if (!internal::hit_box(node.bmin, node.bmax, origin, inv_dir, hit.t))
+                continue;
+
+            if (node.count > 0) { // leaf: Möller–Trumbore ray-triangle intersection
+                for (int i = node.index; i < node.index + node.count; ++i) {
+                    const Triangle &tri = triangles_[i];
+                    const vec3 p = cross(dir, tri.e2);
+                    const float det = dot(tri.e1, p);
+                    if (std::abs(det) < 1e-12f)
+                        continue;
+                    const float inv_det = 1.0f / det;
+                    const vec3 s = origin - tri.v0;
+                    const float u = dot(s, p) * inv_det;
+                    if (u < 0.0f || u > 1.0f)
+                        continue;
+                    const vec3 q = cross(s, tri.e1);
+                    const float v = dot(dir, q) * inv_det;
+                    if (v < 0.0f || u + v > 1.0f)
+                        continue;
+                    const float t = dot(tri.e2, q) * inv_det;
+                    if (t > 0.0f && t < hit.t) {
+                        hit.t = t;
+                        hit.triangle = i;
+                    }
+                }
+            } else if (top + 2 <= 64) {
+                // visit the near child first (it is pushed last)
+                if (dir[node.axis] > 0.0f) {
+                    stack[top++] = node.index + 1;
+                    stack[top++] = node.index;
+                } else {
+                    stack[top++] = node.index;
+                    stack[top++] = node.index + 1;
+                }
+            }
+        }
+        return hit.triangle >= 0;
+    }
+
+
+    bool VirtualScanner::intersect(const vec3 &origin, const vec3 &dir, float &t, int &mesh, int &face) {
+        if (dirty_)
+            build();
+
+        Hit hit;
+        if (!intersect(origin, dir, max_range_, hit))
+            return false;
+        t = hit.t;
+        mesh = triangles_[hit.triangle].mesh;
+        face = triangles_[hit.triangle].face;
+        return true;
+    }
+
+
+    PointCloud *VirtualScanner::scan(const Sensor &sensor) {
+        if (dirty_)
+            build();
+
+        if (nodes_.empty()) {
+            LOG(WARNING) << "the scene is empty";
+            return nullptr;
+        }
+
+        StopWatch w;
+        const std::size_t num = sensor.num_rays();
+        const auto num_packets = static_cast<int>((num + packet_size_ - 1) / packet_size_);
+
+        std::vector<Hit> hits(num);
+        parallel_for(0, num_packets, [&](int p) {
+            const std::size_t begin = static_cast<std::size_t>(p) * packet_size_;
+            const std::size_t end = std::min(begin + packet_size_, num);
+            vec3 origin, dir;
+            for (std::size_t i = begin; i < end; ++i) {
+                sensor.ray(i, origin, dir);
+                Hit &hit = hits[i];
+                if (!intersect(origin, dir, max_range_, hit) || hit.t < min_range_)
+                    hit.triangle = -1;
+            }
+        }, 1);
+
+        std::size_t num_hits = 0;
+        for (const auto &h : hits)
+            num_hits += (h.triangle >= 0);
+        if (num_hits == 0) {
+            LOG(WARNING) << "nothing was captured by the sensor";
+            return nullptr;
+        }
+
+        auto cloud = new PointCloud;
+        cloud->resize(static_cast<unsigned int>(num_hits));
+        auto points = cloud->get_vertex_property<vec3>("v:point");
+        auto normals = cloud->add_vertex_property<vec3>("v:normal");
+        auto intensities = cloud->add_vertex_property<float>("v:intensity");
+        auto ranges = cloud->add_vertex_property<float>("v:range");
+        auto beams = cloud->add_vertex_property<int>("v:beam");
+        auto meshes = cloud->add_vertex_property<int>("v:mesh");
+        auto faces = cloud->add_vertex_property<int>("v:face");
+
+        // offsets of the hits in the output, so the rays can be processed in parallel again
+        std::vector<std::size_t> offsets(num_packets + 1, 0);
+        for (int p = 0; p < num_packets; ++p) {
+            const std::size_t begin = static_cast<std::size_t>(p) * packet_size_;
+            const std::size_t end = std::min(begin + packet_size_, num);
+            std::size_t count = 0;
+            for (std::size_t i = begin; i < end; ++i)
+                count += (hits[i].triangle >= 0);
+            offsets[p + 1] = offsets[p] + count;
+        }
+
+        parallel_for(0, num_packets, [&](int p) {
+            const std::size_t begin = static_cast<std::size_t>(p) * packet_size_;
+            const std::size_t end = std::min(begin + packet_size_, num);
+            std::size_t idx = offsets[p];
+            vec3 origin, dir;
+            for (std::size_t i = begin; i < end; ++i) {
+                const Hit &hit = hits[i];
+                if (hit.triangle < 0)
+                    continue;
+                sensor.ray(i, origin, dir);
+                const Triangle &tri = triangles_[hit.triangle];
+                float t = hit.t;
+                if (noise_sigma_ > 0.0f)
+                    t = std::max(0.0f, t + noise_sigma_ * internal::gaussian(seed_, i));
+
+                const PointCloud::Vertex v(static_cast<int>(idx++));
+                points[v] = origin + dir * t;
+                const float cos_incidence = dot(tri.normal, dir);
+                normals[v] = cos_incidence > 0.0f ? -tri.normal : tri.normal;
+                intensities[v] = reflectance_[tri.mesh] * std::abs(cos_incidence);
+                ranges[v] = t;
+                beams[v] = sensor.beam(i);
+                meshes[v] = tri.mesh;
+                faces[v] = tri.face;
+            }
+        }, 1);
+
+        LOG(INFO) << num_hits << " points captured (" << num << " rays). " << w.time_string();
+        return cloud;
+    }
+
+} // namespace easy3d
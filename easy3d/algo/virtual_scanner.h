@@ -0,0 +1,280 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#ifndef EASY3D_ALGO_VIRTUAL_SCANNER_H
+#define EASY3D_ALGO_VIRTUAL_SCANNER_H
+
+#include <vector>
+
+#include <easy3d/core/types.h>
+
+
+namespace easy3d {
+
+    class SurfaceMesh;
+    class PointCloud;
+
+    /**
+     * \brief A CPU ray-casting virtual scanner that simulates (LiDAR, depth camera, terrestrial) scanning of a scene.
+     * \details The scene consists of one or more surface meshes (each with an optional rigid/affine transformation).
+     *      The triangles of all meshes are organized in a bounding volume hierarchy (BVH), and the rays generated by a
+     *      sensor model are cast in parallel packets. Since no OpenGL context is involved, scanning can run headless
+     *      and it is not limited by the resolution of the viewport.
+     *      The generated point cloud has the following per-point properties:
+     *          - "v:normal": the normal of the hit surface, oriented toward the sensor;
+     *          - "v:intensity": an intensity-like value in [0, 1], i.e., the reflectance of the hit mesh attenuated
+     *            by the cosine of the incidence angle;
+     *          - "v:range": the distance from the sensor to the measured point (noise included);
+     *          - "v:beam": the index of the beam (i.e., the ring of a multi-beam LiDAR, or the row of a camera);
+     *          - "v:mesh": the index of the hit mesh (in the order the meshes were added);
+     *          - "v:face": the index of the hit face in the hit mesh.
+     *      Example usage:
+     *      \code
+     *          VirtualScanner scanner;
+     *          scanner.add_mesh(mesh);
+     *          scanner.set_noise(0.01f);
+     *          VirtualScanner::MultiBeamSensor lidar(vec3(0, 0, 2), 32, -30.0f, 10.0f, 1800);
+     *          PointCloud* cloud = scanner.scan(lidar);
+     *      \endcode
+     * \class VirtualScanner easy3d/algo/virtual_scanner.h
+     */
+    class VirtualScanner {
+    public:
+        /**
+         * \brief The base class of all sensor models. A sensor model is essentially a generator of rays.
+         * \details The rays of a sensor are indexed, and the i-th ray can be generated independently of the others.
+         *      This allows casting the rays in parallel.
+         */
+        class Sensor {
+        public:
+            virtual ~Sensor() = default;
+            /// \brief Returns the number of rays emitted by the sensor in a single scan.
+            virtual std::size_t num_rays() const = 0;
+            /**
+             * \brief Generates the i-th ray.
+             * \param i The index of the ray, which is in [0, num_rays()).
+             * \param origin Returns the origin of the ray.
+             * \param dir Returns the (unit) direction of the ray.
+             */
+            virtual void ray(std::size_t i, vec3 &origin, vec3 &dir) const = 0;
+            /// \brief Returns the beam index (i.e., the ring of a LiDAR, or the row of a camera) of the i-th ray.
+            virtual int beam(std::size_t i) const = 0;
+        };
+
+        /**
+         * \brief A pinhole (i.e., perspective) sensor, e.g., a depth camera.
+         * \details The rays pass through the centers of the pixels of a \p width x \p height image.
+         */
+        class PinholeSensor : public Sensor {
+        public:
+            /**
+             * \brief Constructor.
+             * \param position The position of the sensor.
+             * \param target The point the sensor looks at.
+             * \param up The up vector of the sensor.
+             * \param fov The vertical field of view (in degrees).
+             * \param width The horizontal resolution (in pixels).
+             * \param height The vertical resolution (in pixels).
+             */
+            PinholeSensor(const vec3 &position, const vec3 &target, const vec3 &up, float fov, int width, int height);
+            std::size_t num_rays() const override { return static_cast<std::size_t>(width_) * height_; }
+            void ray(std::size_t i, vec3 &origin, vec3 &dir) const override;
+            int beam(std::size_t i) const override { return static_cast<int>(i / width_); }
+
+        private:
+            vec3 position_;
+            vec3 x_, y_, z_; // the camera frame: right, up, and view direction
+            float tan_half_fov_;
+            int width_, height_;
+        };
+
+        /**
+         * \brief A spherical sensor, e.g., a terrestrial laser scanner.
+         * \details The rays are emitted on a regular grid of azimuth angles (over 360 degrees) and elevation angles
+         *      (in [\p min_elevation, \p max_elevation]).
+         */
+        class SphericalSensor : public Sensor {
+        public:
+            /**
+             * \brief Constructor.
+             * \param position The position of the sensor.
+             * \param azimuth_steps The number of rays in the horizontal direction.
+             * \param elevation_steps The number of rays in the vertical direction.
+             * \param min_elevation The minimum elevation angle (in degrees, w.r.t. the horizontal plane).
+             * \param max_elevation The maximum elevation angle (in degrees, w.r.t. the horizontal plane).
+             * \param up The up direction of the sensor.
+             */
+            SphericalSensor(const vec3 &position, int azimuth_steps, int elevation_steps,
+                            float min_elevation = -90.0f, float max_elevation = 90.0f, const vec3 &up = vec3(0, 0, 1));
+            std::size_t num_rays() const override { return static_cast<std::size_t>(azimuth_steps_) * elevation_steps_; }
+            void ray(std::size_t i, vec3 &origin, vec3 &dir) const override;
+            int beam(std::size_t i) const override { return static_cast<int>(i % elevation_steps_); }
+
+        private:
+            vec3 position_;
+            vec3 x_, y_, z_; // the sensor frame (z_ is the up direction)
+            int azimuth_steps_, elevation_steps_;
+            float min_elevation_, max_elevation_; // in radians
+        };
+
+        /**
+         * \brief A rotating multi-beam sensor, e.g., a spinning LiDAR (Velodyne, Ouster, Hesai).
+         * \details A set of beams with fixed elevation angles rotates about the up axis. Each revolution is sampled at
+         *      \p azimuth_steps azimuth angles. Within a firing, the beams are ordered as their elevation angles.
+         */
+        class MultiBeamSensor : public Sensor {
+        public:
+            /**
+             * \brief Constructor with uniformly distributed beams.
+             * \param position The position of the sensor.
+             * \param num_beams The number of beams (e.g., 16, 32, 64, 128).
+             * \param min_elevation The elevation angle of the lowest beam (in degrees).
+             * \param max_elevation The elevation angle of the highest beam (in degrees).
+             * \param azimuth_steps The number of firings per revolution.
+             * \param up The rotation axis of the sensor.
+             */
+            MultiBeamSensor(const vec3 &position, int num_beams, float min_elevation, float max_elevation,
+                            int azimuth_steps, const vec3 &up = vec3(0, 0, 1));
+            /**
+             * \brief Constructor with explicitly given beam elevation angles (in degrees). This allows simulating
+             *      sensors with non-uniform beam distributions.
+             */
+            MultiBeamSensor(const vec3 &position, const std::vector<float> &elevations, int azimuth_steps,
+                            const vec3 &up = vec3(0, 0, 1));
+            std::size_t num_rays() const override { return elevations_.size() * azimuth_steps_; }
+            void ray(std::size_t i, vec3 &origin, vec3 &dir) const override;
+            int beam(std::size_t i) const override { return static_cast<int>(i % elevations_.size()); }
+
+        private:
+            void init_frame(const vec3 &up);
+
+        private:
+            vec3 position_;
+            vec3 x_, y_, z_; // the sensor frame (z_ is the rotation axis)
+            std::vector<float> elevations_; // in radians
+            int azimuth_steps_;
+        };
+
+    public:
+        VirtualScanner();
+
+        /**
+         * \brief Adds a mesh to the scene.
+         * \details Non-triangular faces are triangulated on the fly (as triangle fans). The mesh is not referenced
+         *      after this call, i.e., it can be safely modified or destroyed afterward.
+         * \param mesh The surface mesh.
+         * \param transform The transformation applied to the mesh (e.g., to place it in the scene).
+         * \param reflectance The reflectance of the mesh surface, which scales the "v:intensity" values of the points
+         *      sampled from this mesh.
+         */
+        void add_mesh(const SurfaceMesh *mesh, const mat4 &transform = mat4::identity(), float reflectance = 1.0f);
+
+        /// \brief Removes all meshes from the scene.
+        void clear();
+
+        /// \brief Returns the number of meshes in the scene.
+        std::size_t num_meshes() const { return num_meshes_; }
+
+        /// \brief Sets the valid range of the sensor. Hits closer than \p min or farther than \p max are discarded.
+        void set_range(float min, float max) { min_range_ = min; max_range_ = max; }
+
+        /**
+         * \brief Sets the standard deviation of the Gaussian noise added to the measured ranges (i.e., along the
+         *      rays). Default: 0 (no noise).
+         */
+        void set_noise(float sigma) { noise_sigma_ = sigma; }
+
+        /**
+         * \brief Sets the seed of the noise generator. The noise of each ray is derived from the seed and the index
+         *      of the ray, so the result is identical regardless of the number of threads.
+         */
+        void set_seed(unsigned int seed) { seed_ = seed; }
+
+        /// \brief Sets the number of rays in each packet, i.e., the unit of work distributed among threads.
+        void set_packet_size(std::size_t size) { packet_size_ = size > 0 ? size : 1; }
+
+        /**
+         * \brief Scans the scene with a sensor.
+         * \details The BVH is (re)built on the first call after the scene has changed.
+         * \param sensor The sensor model.
+         * \return The captured point cloud (with per-point properties as described in the class description), or
+         *      \c nullptr if nothing was hit. The caller is responsible for deleting the point cloud.
+         */
+        PointCloud *scan(const Sensor &sensor);
+
+        /**
+         * \brief Casts a single ray into the scene.
+         * \param origin The origin of the ray.
+         * \param dir The (unit) direction of the ray.
+         * \param t Returns the distance to the closest hit.
+         * \param mesh Returns the index of the hit mesh.
+         * \param face Returns the index of the hit face in the hit mesh.
+         * \return \c true if the ray hits the scene within the maximum range.
+         */
+        bool intersect(const vec3 &origin, const vec3 &dir, float &t, int &mesh, int &face);
+
+    private:
+        void build();
+
+        struct Hit {
+            float t;
+            int triangle;
+        };
+        bool intersect(const vec3 &origin, const vec3 &dir, float t_max, Hit &hit) const;
+
+        // a triangle stored for the Möller–Trumbore ray-triangle intersection test
+        struct Triangle {
+            vec3 v0, e1, e2;
+            vec3 normal;
+            int mesh;
+            int face;
+        };
+
+        // a node of the (flattened) BVH. The children of an interior node are stored at 'index' and 'index + 1'.
+        // A leaf node refers to 'count' triangles starting at 'index'.
+        struct Node {
+            vec3 bmin, bmax;
+            int index;
+            int count; // 0 for interior nodes
+            int axis;  // the splitting axis of an interior node
+        };
+
+        std::vector<Triangle> triangles_;
+        std::vector<float> reflectance_; // per mesh
+        std::vector<Node> nodes_;
+        std::size_t num_meshes_;
+        bool dirty_;
+
+        float min_range_;
+        float max_range_;
+        float noise_sigma_;
+        unsigned int seed_;
+        std::size_t packet_size_;
+    };
+
+} // namespace easy3d
+
+#endif  // EASY3D_ALGO_VIRTUAL_SCANNER_H
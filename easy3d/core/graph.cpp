@@ -54,6 +54,8 @@ namespace easy3d {
     {
         if (this != &rhs)
         {
+            touch_topology();
+
             // deep copy of property containers
             vprops_ = rhs.vprops_;
             eprops_ = rhs.eprops_;
@@ -83,6 +85,8 @@ namespace easy3d {
     {
         if (this != &rhs)
         {
+            touch_topology();
+
             // clear properties
             vprops_.clear();
             eprops_.clear();
@@ -122,6 +126,8 @@ namespace easy3d {
 
     void Graph::clear()
     {
+        touch_topology();
+
         //---- clear without removing properties
 
         vprops_.resize(0);
@@ -171,21 +177,17 @@ namespace easy3d {
                 output << "\t" << p << std::endl;
         }
 
-		props = vertex_properties();
-		if (!props.empty())
+		if (vprops_.n_properties() > 0)
 		{
             output << "vertex properties:\n";
-            for (const auto& p : props)
-                output << "\t" << p << std::endl;
+            vprops_.print_statistics(output);
 		}
 
 
-        props = edge_properties();
-		if (!props.empty())
+        if (eprops_.n_properties() > 0)
 		{
             output << "edge properties:\n";
-            for (const auto& p : props)
-                output << "\t" << p << std::endl;
+            eprops_.print_statistics(output);
 		}
 
 		props = model_properties();
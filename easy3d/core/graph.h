@@ -800,6 +800,7 @@ namespace easy3d {
 		 * \param ne The number of edges.
 		 */
 		void resize(unsigned int nv, unsigned int ne) {
+			touch_topology();
 			vprops_.resize(nv);
 			eprops_.resize(ne);
 		}
@@ -1258,6 +1259,7 @@ namespace easy3d {
 		Vertex new_vertex()
 		{
 			vprops_.push_back();
+			touch_topology();
 			return Vertex(static_cast<int>(vertices_size() - 1));
 		}
 
@@ -1265,6 +1267,7 @@ namespace easy3d {
 		Edge new_edge()
 		{
 			eprops_.push_back();
+			touch_topology();
 			return Edge(static_cast<int>(edges_size() - 1));
 		}
 
@@ -1286,6 +1289,8 @@ namespace easy3d {
 		unsigned int deleted_vertices_;
 		unsigned int deleted_edges_;
 		bool garbage_;
+
+		friend class BinaryContainer;
 	};
 
 
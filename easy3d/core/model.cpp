@@ -25,13 +25,16 @@
  ********************************************************************/
 
 #include <easy3d/core/model.h>
+#include <easy3d/core/property.h>
+#include <easy3d/core/point_kernels.h>
 #include <easy3d/util/logging.h>
 
 
 namespace easy3d {
 
     Model::Model(const std::string &name /* = "unknown" */)
-            : name_(name), bbox_known_(false), renderer_(nullptr), manipulator_(nullptr) {
+            : name_(name), bbox_known_(false), bbox_revision_(0), geometry_revision_(0), topology_revision_(0),
+              renderer_(nullptr), manipulator_(nullptr) {
 //        std::cerr << "Model::Model() called: " << name_ << std::endl;
     }
 
@@ -42,14 +45,15 @@ namespace easy3d {
     }
 
     const Box3 &Model::bounding_box(bool recompute) const {
-        if (!bbox_known_ || recompute) {
+        const std::size_t revision = geometry_revision_;   // read before computing, so a concurrent change is not lost
+        if (!bbox_known_ || recompute || bbox_revision_ != revision) {
             Box3 &box = const_cast<Model *>(this)->bbox_;
-            box.clear();
-            for (const auto &p: points())
-                box.grow(p);
+            box = kernels::bounding_box(points());
 
-            if (box.is_valid())
+            if (box.is_valid()) {
                 const_cast<Model *>(this)->bbox_known_ = true;
+                const_cast<Model *>(this)->bbox_revision_ = revision;
+            }
             else
                 LOG(WARNING) << "model has no valid geometry";
         }
@@ -57,6 +61,33 @@ namespace easy3d {
     }
 
 
+    bool Model::is_up_to_date(const std::string &name, const BasePropertyArray *data) const {
+        const auto pos = derived_data_.find(name);
+        if (pos == derived_data_.end())
+            return false;
+        const DerivedData &d = pos->second;
+        if (d.revision != (d.topology_only ? topology_revision_ : geometry_revision_))
+            return false;
+        if (data && (d.data_id != data->id() || d.data_revision != data->revision()))
+            return false;
+        return true;
+    }
+
+
+    void Model::mark_up_to_date(const std::string &name, const BasePropertyArray *data, bool topology_only) {
+        DerivedData &d = derived_data_[name];
+        d.revision = topology_only ? topology_revision_ : geometry_revision_;
+        d.topology_only = topology_only;
+        d.data_id = data ? data->id() : 0;
+        d.data_revision = data ? data->revision() : 0;
+    }
+
+
+    void Model::mark_outdated(const std::string &name) {
+        derived_data_.erase(name);
+    }
+
+
     void Model::invalidate_bounding_box() {
         bbox_.clear();
         bbox_known_ = false;
@@ -31,6 +31,8 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <atomic>
+#include <unordered_map>
 
 #include <easy3d/core/types.h>
 
@@ -39,6 +41,7 @@ namespace easy3d {
 
     class Renderer;
     class Manipulator;
+    class BasePropertyArray;
 
     /**
      * \brief The base class of renderable 3D models.
@@ -63,7 +66,8 @@ namespace easy3d {
         /**
          * \brief The bounding box of the model.
          * \param recompute If \c true, or if the bounding box is not known, it computes and returns the bounding
-         *      box of the model. Otherwise, it returns the known bounding box.
+         *      box of the model. Otherwise, it returns the known bounding box. The known bounding box is also
+         *      recomputed if the geometry has changed since it was computed (see geometry_revision()).
          * \note Manipulation transformation is not handled.
          * \see invalidate_bounding_box().
          */
@@ -75,6 +79,62 @@ namespace easy3d {
          */
         void invalidate_bounding_box();
 
+        /// \name Revisions and cached derived data
+        //@{
+        /**
+         * \brief The geometry revision of the model.
+         * \details It is incremented whenever the topology of the model is changed through its interface (e.g.,
+         *      adding/deleting elements or changing the connectivity) and by touch_geometry(). Modifications of the
+         *      vertex positions (through points(), position(), or a "v:point" property handle) are not tracked: call
+         *      touch_geometry() after such modifications. Drawable::update() does this for the model of a drawable.
+         *      The revisions can be incremented from any thread (e.g., by a drawable updated on a worker thread).
+         */
+        std::size_t geometry_revision() const { return geometry_revision_; }
+        /**
+         * \brief The topology revision of the model.
+         * \details It is incremented whenever elements are added or deleted, or the connectivity is changed.
+         */
+        std::size_t topology_revision() const { return topology_revision_; }
+        /// \brief Marks the geometry of the model as modified.
+        void touch_geometry() { ++geometry_revision_; }
+        /// \brief Marks the topology (and thus also the geometry) of the model as modified.
+        void touch_topology() { ++topology_revision_; ++geometry_revision_; }
+
+        /**
+         * \brief Tests if the derived data \p name is up to date.
+         * \details Data derived from the model (e.g., normals, cotan weights, curvatures) can be registered by
+         *      mark_up_to_date() after it has been computed, so that it is only recomputed when needed. Example usage:
+         *      \code
+         *          auto weights = mesh->edge_property<float>("e:cotan");
+         *          if (!mesh->is_up_to_date("e:cotan", &weights.array())) {
+         *              ... // compute the weights
+         *              mesh->mark_up_to_date("e:cotan", &weights.array());
+         *          }
+         *      \endcode
+         * \param name The name of the derived data.
+         * \param data The property array storing the derived data (optional). If provided, the derived data is
+         *      also outdated if the array is not the one given to mark_up_to_date() or if it has been modified
+         *      since then (see BasePropertyArray::revision()).
+         * \return \c true if the derived data was marked up to date and the revision it depends on (geometry or
+         *      topology) has not changed since then.
+         */
+        bool is_up_to_date(const std::string &name, const BasePropertyArray *data = nullptr) const;
+        /**
+         * \brief Marks the derived data \p name as up to date with the current revisions.
+         * \param name The name of the derived data.
+         * \param data The property array storing the derived data (optional).
+         * \param topology_only \c true if the derived data depends only on the topology (e.g., valences), and
+         *      \c false if it also depends on the geometry (default).
+         * \note If the derived data was written through the element access operator of \p data (i.e., operator[]),
+         *      call BasePropertyArray::touch() before marking it, which outdates any other derived data stored in
+         *      the same array.
+         */
+        void mark_up_to_date(const std::string &name, const BasePropertyArray *data = nullptr,
+                             bool topology_only = false);
+        /// \brief Marks the derived data \p name as outdated, so it will be recomputed the next time it is needed.
+        void mark_outdated(const std::string &name);
+        //@}
+
         /** \brief The vertices of the model. */
         virtual std::vector<vec3>& points() = 0;
         /** \brief The vertices of the model. */
@@ -112,6 +172,19 @@ namespace easy3d {
 
         Box3		bbox_;
         bool		bbox_known_;
+        std::size_t bbox_revision_;
+
+        std::atomic<std::size_t> geometry_revision_;
+        std::atomic<std::size_t> topology_revision_;
+
+        // the revisions for which the derived data was computed
+        struct DerivedData {
+            std::size_t revision;
+            bool topology_only;
+            std::size_t data_id;
+            std::size_t data_revision;
+        };
+        std::unordered_map<std::string, DerivedData> derived_data_;
 
         std::shared_ptr<Renderer> renderer_;         // for rendering
         std::shared_ptr<Manipulator> manipulator_;   // for manipulation
@@ -50,6 +50,8 @@ namespace easy3d {
     {
         if (this != &rhs)
         {
+            touch_topology();
+
             // deep copy of property containers
             vprops_ = rhs.vprops_;
             mprops_ = rhs.mprops_;
@@ -91,6 +93,8 @@ namespace easy3d {
     {
         if (this != &rhs)
         {
+            touch_topology();
+
             // clear properties
             vprops_.clear();
             mprops_.clear();
@@ -121,6 +125,8 @@ namespace easy3d {
 
     void PointCloud::clear()
     {
+        touch_topology();
+
         //---- clear without removing properties
 
         vprops_.resize(0);
@@ -153,12 +159,10 @@ namespace easy3d {
                 output << "\t" << p << std::endl;
         }
 
-        props = vertex_properties();
-		if (!props.empty())
+        if (vprops_.n_properties() > 0)
 		{
             output << "vertex properties:\n";
-            for (const auto& p : props)
-                output << "\t" << p << std::endl;
+            vprops_.print_statistics(output);
 		}
 
 		props = model_properties();
@@ -182,6 +186,17 @@ namespace easy3d {
     }
 
 
+    PointCloud::Vertex PointCloud::add_vertices(const std::vector<vec3>& points)
+    {
+        if (points.empty())
+            return Vertex();
+        const auto first = vprops_.append(points.size());
+        std::copy(points.begin(), points.end(), vpoint_.vector().begin() + static_cast<std::ptrdiff_t>(first));
+        touch_topology();
+        return Vertex(static_cast<int>(first));
+    }
+
+
     //-----------------------------------------------------------------------------
 
 
@@ -189,6 +204,8 @@ namespace easy3d {
     {
         if (vdeleted_[v])  return;
 
+        touch_topology();
+
         // mark v as deleted
         vdeleted_[v] = true;
         deleted_vertices_++;
@@ -201,6 +218,8 @@ namespace easy3d {
 
     void PointCloud::collect_garbage()
     {
+        touch_topology();
+
         int  nV = static_cast<int>(vertices_size());
 
         // setup handle mapping
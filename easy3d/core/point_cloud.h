@@ -401,6 +401,16 @@ namespace easy3d {
          */
         Vertex add_vertex(const vec3& p);
 
+        /**
+         * \brief Add new vertices with positions \c points.
+         * \details All the vertex properties grow once (see PropertyContainer::append()), which is much faster than
+         *      calling add_vertex() for each point, e.g., when the points are streamed in chunks.
+         * \param points The positions of the new vertices.
+         * \return The first added vertex. The added vertices are contiguous, i.e., the i-th one is
+         *      Vertex(first.idx() + i). An invalid vertex is returned if \c points is empty.
+         */
+        Vertex add_vertices(const std::vector<vec3>& points);
+
         //@}
 
 
@@ -430,7 +440,7 @@ namespace easy3d {
          * \brief Resize space for vertices and their currently associated properties.
          * \param nv The new size for the vertices.
          */
-        void resize(unsigned int nv) { vprops_.resize(nv); }
+        void resize(unsigned int nv) { touch_topology(); vprops_.resize(nv); }
 
         /**
          * \brief Are there deleted vertices?
@@ -713,6 +723,7 @@ namespace easy3d {
         Vertex new_vertex()
         {
             vprops_.push_back();
+            touch_topology();
             return Vertex(static_cast<int>(vertices_size()-1));
         }
 
@@ -727,6 +738,8 @@ namespace easy3d {
 
         unsigned int	deleted_vertices_;
         bool			garbage_;
+
+        friend class BinaryContainer;
     };
 
 
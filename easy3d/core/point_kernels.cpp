@@ -0,0 +1,798 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#include <easy3d/core/point_kernels.h>
+#include <easy3d/util/thread_pool.h>
+#include <easy3d/util/logging.h>
+
+#include <atomic>
+#include <limits>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EASY3D_KERNELS_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define EASY3D_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+// GCC and Clang need the AVX2 functions to be marked (the other functions are compiled for the baseline SSE2), so
+// they can be selected at runtime. MSVC accepts the AVX2 intrinsics anywhere.
+#if defined(EASY3D_KERNELS_X86) && (defined(__GNUC__) || defined(__clang__))
+#define EASY3D_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define EASY3D_TARGET_AVX2
+#endif
+
+// The helpers shared by the SSE2 and AVX2 code must be inlined, so they are compiled with the VEX encoding in the
+// AVX2 functions (switching between the encodings of the SSE and AVX instructions is costly).
+#if defined(_MSC_VER) && !defined(__clang__)
+#define EASY3D_FORCE_INLINE __forceinline
+#else
+#define EASY3D_FORCE_INLINE inline __attribute__((always_inline))
+#endif
+
+
+namespace easy3d {
+
+    namespace kernels {
+
+        static_assert(sizeof(vec3) == 3 * sizeof(float), "the kernels assume vec3 is made of three packed floats");
+        static_assert(sizeof(vec2) == 2 * sizeof(float), "the kernels assume vec2 is made of two packed floats");
+
+        namespace internal {
+
+            // The coefficients of an affine (or projective) transformation, row by row.
+            struct Rows {
+                explicit Rows(const mat4 &m) {
+                    for (int r = 0; r < 4; ++r)
+                        for (int c = 0; c < 4; ++c)
+                            v[r * 4 + c] = m(r, c);
+                }
+                float v[16];
+            };
+
+            //------------------------------------ scalar ------------------------------------
+
+            void bbox_scalar(const float *f, std::size_t n, float *lo, float *hi) {
+                for (std::size_t i = 0; i < 3 * n; ++i) {
+                    lo[i % 3] = std::min(lo[i % 3], f[i]);
+                    hi[i % 3] = std::max(hi[i % 3], f[i]);
+                }
+            }
+
+            void range_scalar(const float *v, std::size_t n, float &lo, float &hi) {
+                for (std::size_t i = 0; i < n; ++i) {
+                    lo = std::min(lo, v[i]);
+                    hi = std::max(hi, v[i]);
+                }
+            }
+
+            void translate_scalar(float *f, std::size_t n, const float *t) {
+                for (std::size_t i = 0; i < 3 * n; ++i)
+                    f[i] += t[i % 3];
+            }
+
+            void transform_scalar(float *f, std::size_t n, const float *m) {
+                for (std::size_t i = 0; i < n; ++i, f += 3) {
+                    const float x = f[0], y = f[1], z = f[2];
+                    f[0] = m[0] * x + m[1] * y + m[2] * z + m[3];
+                    f[1] = m[4] * x + m[5] * y + m[6] * z + m[7];
+                    f[2] = m[8] * x + m[9] * y + m[10] * z + m[11];
+                }
+            }
+
+            void project_scalar(const float *f, std::size_t n, const float *m, float *out) {
+                for (std::size_t i = 0; i < n; ++i, f += 3, out += 2) {
+                    const float x = m[0] * f[0] + m[1] * f[1] + m[2] * f[2] + m[3];
+                    const float y = m[4] * f[0] + m[5] * f[1] + m[6] * f[2] + m[7];
+                    const float w = m[12] * f[0] + m[13] * f[1] + m[14] * f[2] + m[15];
+                    out[0] = 0.5f * (x / w) + 0.5f;
+                    out[1] = 0.5f * (y / w) + 0.5f;
+                }
+            }
+
+            void distance_scalar(const float *f, std::size_t n, const float *p, float *out) {
+                for (std::size_t i = 0; i < n; ++i, f += 3)
+                    out[i] = p[0] * f[0] + p[1] * f[1] + p[2] * f[2] + p[3];
+            }
+
+            void normalize_scalar(float *f, std::size_t n) {
+                for (std::size_t i = 0; i < n; ++i, f += 3) {
+                    float s = std::sqrt(f[0] * f[0] + f[1] * f[1] + f[2] * f[2]);
+                    s = (s > std::numeric_limits<float>::min()) ? 1.0f / s : 0.0f;
+                    f[0] *= s;
+                    f[1] *= s;
+                    f[2] *= s;
+                }
+            }
+
+#ifdef EASY3D_KERNELS_X86
+            //------------------------------------- SSE2 -------------------------------------
+
+            // shuffle(a, b, i0, i1, i2, i3) = (a[i0], a[i1], b[i2], b[i3])
+#define EASY3D_SHUFFLE(a, b, i0, i1, i2, i3) _mm_shuffle_ps(a, b, _MM_SHUFFLE(i3, i2, i1, i0))
+
+            // loads 4 points (x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3) as (x0 x1 x2 x3), (y0 ...), and (z0 ...)
+            EASY3D_FORCE_INLINE void load4(const float *p, __m128 &x, __m128 &y, __m128 &z) {
+                const __m128 r0 = _mm_loadu_ps(p), r1 = _mm_loadu_ps(p + 4), r2 = _mm_loadu_ps(p + 8);
+                x = EASY3D_SHUFFLE(r0, EASY3D_SHUFFLE(r1, r2, 2, 2, 1, 1), 0, 3, 0, 2);
+                y = EASY3D_SHUFFLE(EASY3D_SHUFFLE(r0, r1, 1, 1, 0, 0), EASY3D_SHUFFLE(r1, r2, 3, 3, 2, 2), 0, 2, 0, 2);
+                z = EASY3D_SHUFFLE(EASY3D_SHUFFLE(r0, r1, 2, 2, 1, 1), r2, 0, 2, 0, 3);
+            }
+
+            // the inverse of load4()
+            EASY3D_FORCE_INLINE void store4(float *p, __m128 x, __m128 y, __m128 z) {
+                _mm_storeu_ps(p, EASY3D_SHUFFLE(EASY3D_SHUFFLE(x, y, 0, 0, 0, 0), EASY3D_SHUFFLE(z, x, 0, 0, 1, 1), 0, 2, 0, 2));
+                _mm_storeu_ps(p + 4, EASY3D_SHUFFLE(EASY3D_SHUFFLE(y, z, 1, 1, 1, 1), EASY3D_SHUFFLE(x, y, 2, 2, 2, 2), 0, 2, 0, 2));
+                _mm_storeu_ps(p + 8, EASY3D_SHUFFLE(EASY3D_SHUFFLE(z, x, 2, 2, 3, 3), EASY3D_SHUFFLE(y, z, 3, 3, 3, 3), 0, 2, 0, 2));
+            }
+
+            void bbox_sse2(const float *f, std::size_t n, float *lo, float *hi) {
+                // 4 points are 12 floats, i.e., 3 registers in which the coordinates repeat with a period of 3
+                const std::size_t m = 3 * (n / 4 * 4);
+                if (m > 0) {
+                    __m128 l[3], h[3];
+                    for (int k = 0; k < 3; ++k)
+                        l[k] = h[k] = _mm_loadu_ps(f + 4 * k);
+                    for (std::size_t i = 12; i < m; i += 12) {
+                        for (int k = 0; k < 3; ++k) {
+                            const __m128 v = _mm_loadu_ps(f + i + 4 * k);
+                            l[k] = _mm_min_ps(l[k], v);
+                            h[k] = _mm_max_ps(h[k], v);
+                        }
+                    }
+                    float ls[12], hs[12];
+                    for (int k = 0; k < 3; ++k) {
+                        _mm_storeu_ps(ls + 4 * k, l[k]);
+                        _mm_storeu_ps(hs + 4 * k, h[k]);
+                    }
+                    for (int k = 0; k < 12; ++k) {
+                        lo[k % 3] = std::min(lo[k % 3], ls[k]);
+                        hi[k % 3] = std::max(hi[k % 3], hs[k]);
+                    }
+                }
+                bbox_scalar(f + m, n % 4, lo, hi);
+            }
+
+            void range_sse2(const float *v, std::size_t n, float &lo, float &hi) {
+                const std::size_t m = n / 4 * 4;
+                if (m > 0) {
+                    __m128 l = _mm_loadu_ps(v), h = l;
+                    for (std::size_t i = 4; i < m; i += 4) {
+                        const __m128 x = _mm_loadu_ps(v + i);
+                        l = _mm_min_ps(l, x);
+                        h = _mm_max_ps(h, x);
+                    }
+                    float ls[4], hs[4];
+                    _mm_storeu_ps(ls, l);
+                    _mm_storeu_ps(hs, h);
+                    range_scalar(ls, 4, lo, hi);
+                    range_scalar(hs, 4, lo, hi);
+                }
+                range_scalar(v + m, n - m, lo, hi);
+            }
+
+            void translate_sse2(float *f, std::size_t n, const float *t) {
+                float ts[12];
+                for (int k = 0; k < 12; ++k)
+                    ts[k] = t[k % 3];
+                const __m128 t0 = _mm_loadu_ps(ts), t1 = _mm_loadu_ps(ts + 4), t2 = _mm_loadu_ps(ts + 8);
+                const std::size_t m = 3 * (n / 4 * 4);
+                for (std::size_t i = 0; i < m; i += 12) {
+                    _mm_storeu_ps(f + i, _mm_add_ps(_mm_loadu_ps(f + i), t0));
+                    _mm_storeu_ps(f + i + 4, _mm_add_ps(_mm_loadu_ps(f + i + 4), t1));
+                    _mm_storeu_ps(f + i + 8, _mm_add_ps(_mm_loadu_ps(f + i + 8), t2));
+                }
+                translate_scalar(f + m, n % 4, t);
+            }
+
+            // a * x + b * y + c * z + d, evaluated in the same order as the scalar code
+            EASY3D_FORCE_INLINE __m128 dot_sse2(const float *row, __m128 x, __m128 y, __m128 z) {
+                const __m128 r = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(row[0]), x), _mm_mul_ps(_mm_set1_ps(row[1]), y));
+                return _mm_add_ps(_mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(row[2]), z)), _mm_set1_ps(row[3]));
+            }
+
+            void transform_sse2(float *f, std::size_t n, const float *m) {
+                const std::size_t k = n / 4 * 4;
+                for (std::size_t i = 0; i < k; i += 4) {
+                    __m128 x, y, z;
+                    load4(f + 3 * i, x, y, z);
+                    store4(f + 3 * i, dot_sse2(m, x, y, z), dot_sse2(m + 4, x, y, z), dot_sse2(m + 8, x, y, z));
+                }
+                transform_scalar(f + 3 * k, n - k, m);
+            }
+
+            void project_sse2(const float *f, std::size_t n, const float *m, float *out) {
+                const __m128 half = _mm_set1_ps(0.5f);
+                const std::size_t k = n / 4 * 4;
+                for (std::size_t i = 0; i < k; i += 4) {
+                    __m128 x, y, z;
+                    load4(f + 3 * i, x, y, z);
+                    const __m128 w = dot_sse2(m + 12, x, y, z);
+                    const __m128 px = _mm_add_ps(_mm_mul_ps(half, _mm_div_ps(dot_sse2(m, x, y, z), w)), half);
+                    const __m128 py = _mm_add_ps(_mm_mul_ps(half, _mm_div_ps(dot_sse2(m + 4, x, y, z), w)), half);
+                    _mm_storeu_ps(out + 2 * i, _mm_unpacklo_ps(px, py));
+                    _mm_storeu_ps(out + 2 * i + 4, _mm_unpackhi_ps(px, py));
+                }
+                project_scalar(f + 3 * k, n - k, m, out + 2 * k);
+            }
+
+            void distance_sse2(const float *f, std::size_t n, const float *p, float *out) {
+                const std::size_t k = n / 4 * 4;
+                for (std::size_t i = 0; i < k; i += 4) {
+                    __m128 x, y, z;
+                    load4(f + 3 * i, x, y, z);
+                    _mm_storeu_ps(out + i, dot_sse2(p, x, y, z));
+                }
+                distance_scalar(f + 3 * k, n - k, p, out + k);
+            }
+
+            void normalize_sse2(float *f, std::size_t n) {
+                const __m128 one = _mm_set1_ps(1.0f);
+                const __m128 tiny = _mm_set1_ps(std::numeric_limits<float>::min());
+                const std::size_t k = n / 4 * 4;
+                for (std::size_t i = 0; i < k; i += 4) {
+                    __m128 x, y, z;
+                    load4(f + 3 * i, x, y, z);
+                    const __m128 len2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+                    const __m128 len = _mm_sqrt_ps(len2);
+                    const __m128 s = _mm_and_ps(_mm_cmpgt_ps(len, tiny), _mm_div_ps(one, len));
+                    store4(f + 3 * i, _mm_mul_ps(x, s), _mm_mul_ps(y, s), _mm_mul_ps(z, s));
+                }
+                normalize_scalar(f + 3 * k, n - k);
+            }
+
+            //------------------------------------- AVX2 -------------------------------------
+
+            // loads 8 points as (x0 ... x7), (y0 ... y7), and (z0 ... z7)
+            EASY3D_TARGET_AVX2 EASY3D_FORCE_INLINE void load8(const float *p, __m256 &x, __m256 &y, __m256 &z) {
+                __m128 x0, y0, z0, x1, y1, z1;
+                load4(p, x0, y0, z0);
+                load4(p + 12, x1, y1, z1);
+                x = _mm256_insertf128_ps(_mm256_castps128_ps256(x0), x1, 1);
+                y = _mm256_insertf128_ps(_mm256_castps128_ps256(y0), y1, 1);
+                z = _mm256_insertf128_ps(_mm256_castps128_ps256(z0), z1, 1);
+            }
+
+            // the inverse of load8()
+            EASY3D_TARGET_AVX2 EASY3D_FORCE_INLINE void store8(float *p, __m256 x, __m256 y, __m256 z) {
+                store4(p, _mm256_castps256_ps128(x), _mm256_castps256_ps128(y), _mm256_castps256_ps128(z));
+                store4(p + 12, _mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1), _mm256_extractf128_ps(z, 1));
+            }
+
+            EASY3D_TARGET_AVX2 void bbox_avx2(const float *f, std::size_t n, float *lo, float *hi) {
+                // 8 points are 24 floats, i.e., 3 registers in which the coordinates repeat with a period of 3
+                const std::size_t m = 3 * (n / 8 * 8);
+                if (m > 0) {
+                    __m256 l[3], h[3];
+                    for (int k = 0; k < 3; ++k)
+                        l[k] = h[k] = _mm256_loadu_ps(f + 8 * k);
+                    for (std::size_t i = 24; i < m; i += 24) {
+                        for (int k = 0; k < 3; ++k) {
+                            const __m256 v = _mm256_loadu_ps(f + i + 8 * k);
+                            l[k] = _mm256_min_ps(l[k], v);
+                            h[k] = _mm256_max_ps(h[k], v);
+                        }
+                    }
+                    float ls[24], hs[24];
+                    for (int k = 0; k < 3; ++k) {
+                        _mm256_storeu_ps(ls + 8 * k, l[k]);
+                        _mm256_storeu_ps(hs + 8 * k, h[k]);
+                    }
+                    for (int k = 0; k < 24; ++k) {
+                        lo[k % 3] = std::min(lo[k % 3], ls[k]);
+                        hi[k % 3] = std::max(hi[k % 3], hs[k]);
+                    }
+                }
+                bbox_sse2(f + m, n % 8, lo, hi);
+            }
+
+            EASY3D_TARGET_AVX2 void range_avx2(const float *v, std::size_t n, float &lo, float &hi) {
+                const std::size_t m = n / 8 * 8;
+                if (m > 0) {
+                    __m256 l = _mm256_loadu_ps(v), h = l;
+                    for (std::size_t i = 8; i < m; i += 8) {
+                        const __m256 x = _mm256_loadu_ps(v + i);
+                        l = _mm256_min_ps(l, x);
+                        h = _mm256_max_ps(h, x);
+                    }
+                    float ls[8], hs[8];
+                    _mm256_storeu_ps(ls, l);
+                    _mm256_storeu_ps(hs, h);
+                    range_scalar(ls, 8, lo, hi);
+                    range_scalar(hs, 8, lo, hi);
+                }
+                range_sse2(v + m, n - m, lo, hi);
+            }
+
+            EASY3D_TARGET_AVX2 void translate_avx2(float *f, std::size_t n, const float *t) {
+                float ts[24];
+                for (int k = 0; k < 24; ++k)
+                    ts[k] = t[k % 3];
+                const __m256 t0 = _mm256_loadu_ps(ts), t1 = _mm256_loadu_ps(ts + 8), t2 = _mm256_loadu_ps(ts + 16);
+                const std::size_t m = 3 * (n / 8 * 8);
+                for (std::size_t i = 0; i < m; i += 24) {
+                    _mm256_storeu_ps(f + i, _mm256_add_ps(_mm256_loadu_ps(f + i), t0));
+                    _mm256_storeu_ps(f + i + 8, _mm256_add_ps(_mm256_loadu_ps(f + i + 8), t1));
+                    _mm256_storeu_ps(f + i + 16, _mm256_add_ps(_mm256_loadu_ps(f + i + 16), t2));
+                }
+                translate_sse2(f + m, n % 8, t);
+            }
+
+            // a * x + b * y + c * z + d
+            EASY3D_TARGET_AVX2 EASY3D_FORCE_INLINE __m256 dot_avx2(const float *row, __m256 x, __m256 y, __m256 z) {
+                const __m256 r = _mm256_fmadd_ps(_mm256_set1_ps(row[2]), z, _mm256_set1_ps(row[3]));
+                return _mm256_fmadd_ps(_mm256_set1_ps(row[0]), x, _mm256_fmadd_ps(_mm256_set1_ps(row[1]), y, r));
+            }
+
+            EASY3D_TARGET_AVX2 void transform_avx2(float *f, std::size_t n, const float *m) {
+                const std::size_t k = n / 8 * 8;
+                for (std::size_t i = 0; i < k; i += 8) {
+                    __m256 x, y, z;
+                    load8(f + 3 * i, x, y, z);
+                    store8(f + 3 * i, dot_avx2(m, x, y, z), dot_avx2(m + 4, x, y, z), dot_avx2(m + 8, x, y, z));
+                }
+                transform_sse2(f + 3 * k, n - k, m);
+            }
+
+            EASY3D_TARGET_AVX2 void project_avx2(const float *f, std::size_t n, const float *m, float *out) {
+                const __m256 half = _mm256_set1_ps(0.5f);
+                const std::size_t k = n / 8 * 8;
+                for (std::size_t i = 0; i < k; i += 8) {
+                    __m256 x, y, z;
+                    load8(f + 3 * i, x, y, z);
+                    const __m256 w = dot_avx2(m + 12, x, y, z);
+                    const __m256 px = _mm256_fmadd_ps(half, _mm256_div_ps(dot_avx2(m, x, y, z), w), half);
+                    const __m256 py = _mm256_fmadd_ps(half, _mm256_div_ps(dot_avx2(m + 4, x, y, z), w), half);
+                    // the unpacking works within the 128-bit lanes
+                    const __m256 lo = _mm256_unpacklo_ps(px, py);   // (p0 p1 | p4 p5)
+                    const __m256 hi = _mm256_unpackhi_ps(px, py);   // (p2 p3 | p6 p7)
+                    _mm256_storeu_ps(out + 2 * i, _mm256_permute2f128_ps(lo, hi, 0x20));
+                    _mm256_storeu_ps(out + 2 * i + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+                }
+                project_sse2(f + 3 * k, n - k, m, out + 2 * k);
+            }
+
+            EASY3D_TARGET_AVX2 void distance_avx2(const float *f, std::size_t n, const float *p, float *out) {
+                const std::size_t k = n / 8 * 8;
+                for (std::size_t i = 0; i < k; i += 8) {
+                    __m256 x, y, z;
+                    load8(f + 3 * i, x, y, z);
+                    _mm256_storeu_ps(out + i, dot_avx2(p, x, y, z));
+                }
+                distance_sse2(f + 3 * k, n - k, p, out + k);
+            }
+
+            EASY3D_TARGET_AVX2 void normalize_avx2(float *f, std::size_t n) {
+                const __m256 one = _mm256_set1_ps(1.0f);
+                const __m256 tiny = _mm256_set1_ps(std::numeric_limits<float>::min());
+                const std::size_t k = n / 8 * 8;
+                for (std::size_t i = 0; i < k; i += 8) {
+                    __m256 x, y, z;
+                    load8(f + 3 * i, x, y, z);
+                    // no FMA here, so the results are the same as the scalar code
+                    const __m256 len2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)),
+                                                      _mm256_mul_ps(z, z));
+                    const __m256 len = _mm256_sqrt_ps(len2);
+                    const __m256 s = _mm256_and_ps(_mm256_cmp_ps(len, tiny, _CMP_GT_OQ), _mm256_div_ps(one, len));
+                    store8(f + 3 * i, _mm256_mul_ps(x, s), _mm256_mul_ps(y, s), _mm256_mul_ps(z, s));
+                }
+                normalize_sse2(f + 3 * k, n - k);
+            }
+
+#undef EASY3D_SHUFFLE
+
+            bool cpu_supports_avx2() {
+#if defined(__GNUC__) || defined(__clang__)
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#elif defined(_MSC_VER)
+                int info[4];
+                __cpuid(info, 1);
+                const bool fma = (info[2] & (1 << 12)) != 0;
+                const bool osxsave = (info[2] & (1 << 27)) != 0;
+                if (!fma || !osxsave || (_xgetbv(0) & 0x6) != 0x6)   // the OS saves the YMM registers
+                    return false;
+                __cpuidex(info, 7, 0);
+                return (info[1] & (1 << 5)) != 0;
+#else
+                return false;
+#endif
+            }
+
+#endif  // EASY3D_KERNELS_X86
+
+#ifdef EASY3D_KERNELS_NEON
+            //------------------------------------- NEON -------------------------------------
+
+            void bbox_neon(const float *f, std::size_t n, float *lo, float *hi) {
+                const std::size_t m = n / 4 * 4;
+                if (m > 0) {
+                    // the structured loads deinterleave the coordinates
+                    float32x4x3_t l = vld3q_f32(f), h = l;
+                    for (std::size_t i = 4; i < m; i += 4) {
+                        const float32x4x3_t v = vld3q_f32(f + 3 * i);
+                        for (int k = 0; k < 3; ++k) {
+                            l.val[k] = vminq_f32(l.val[k], v.val[k]);
+                            h.val[k] = vmaxq_f32(h.val[k], v.val[k]);
+                        }
+                    }
+                    for (int k = 0; k < 3; ++k) {
+                        lo[k] = std::min(lo[k], vminvq_f32(l.val[k]));
+                        hi[k] = std::max(hi[k], vmaxvq_f32(h.val[k]));
+                    }
+                }
+                bbox_scalar(f + 3 * m, n - m, lo, hi);
+            }
+
+            void range_neon(const float *v, std::size_t n, float &lo, float &hi) {
+                const std::size_t m = n / 4 * 4;
+                if (m > 0) {
+                    float32x4_t l = vld1q_f32(v), h = l;
+                    for (std::size_t i = 4; i < m; i += 4) {
+                        const float32x4_t x = vld1q_f32(v + i);
+                        l = vminq_f32(l, x);
+                        h = vmaxq_f32(h, x);
+                    }
+                    lo = std::min(lo, vminvq_f32(l));
+                    hi = std::max(hi, vmaxvq_f32(h));
+                }
+                range_scalar(v + m, n - m, lo, hi);
+            }
+
+            void translate_neon(float *f, std::size_t n, const float *t) {
+                const float32x4_t tx = vdupq_n_f32(t[0]), ty = vdupq_n_f32(t[1]), tz = vdupq_n_f32(t[2]);
+                const std::size_t m = n / 4 * 4;
+                for (std::size_t i = 0; i < m; i += 4) {
+                    float32x4x3_t v = vld3q_f32(f + 3 * i);
+                    v.val[0] = vaddq_f32(v.val[0], tx);
+                    v.val[1] = vaddq_f32(v.val[1], ty);
+                    v.val[2] = vaddq_f32(v.val[2], tz);
+                    vst3q_f32(f + 3 * i, v);
+                }
+                translate_scalar(f + 3 * m, n - m, t);
+            }
+
+            // a * x + b * y + c * z + d, evaluated in the same order as the scalar code
+            inline float32x4_t dot_neon(const float *row, const float32x4x3_t &v) {
+                const float32x4_t r = vaddq_f32(vmulq_n_f32(v.val[0], row[0]), vmulq_n_f32(v.val[1], row[1]));
+                return vaddq_f32(vaddq_f32(r, vmulq_n_f32(v.val[2], row[2])), vdupq_n_f32(row[3]));
+            }
+
+            void transform_neon(float *f, std::size_t n, const float *m) {
+                const std::size_t k = n / 4 * 4;
+                for (std::size_t i = 0; i < k; i += 4) {
+                    const float32x4x3_t v = vld3q_f32(f + 3 * i);
+                    float32x4x3_t r;
+                    r.val[0] = dot_neon(m, v);
+                    r.val[1] = dot_neon(m + 4, v);
+                    r.val[2] = dot_neon(m + 8, v);
+                    vst3q_f32(f + 3 * i, r);
+                }
+                transform_scalar(f + 3 * k, n - k, m);
+            }
+
+            void project_neon(const float *f, std::size_t n, const float *m, float *out) {
+                const float32x4_t half = vdupq_n_f32(0.5f);
+                const std::size_t k = n / 4 * 4;
+                for (std::size_t i = 0; i < k; i += 4) {
+                    const float32x4x3_t v = vld3q_f32(f + 3 * i);
+                    const float32x4_t w = dot_neon(m + 12, v);
+                    float32x4x2_t r;
+                    r.val[0] = vaddq_f32(vmulq_f32(half, vdivq_f32(dot_neon(m, v), w)), half);
+                    r.val[1] = vaddq_f32(vmulq_f32(half, vdivq_f32(dot_neon(m + 4, v), w)), half);
+                    vst2q_f32(out + 2 * i, r);
+                }
+                project_scalar(f + 3 * k, n - k, m, out + 2 * k);
+            }
+
+            void distance_neon(const float *f, std::size_t n, const float *p, float *out) {
+                const std::size_t k = n / 4 * 4;
+                for (std::size_t i = 0; i < k; i += 4)
+                    vst1q_f32(out + i, dot_neon(p, vld3q_f32(f + 3 * i)));
+                distance_scalar(f + 3 * k, n - k, p, out + k);
+            }
+
+            void normalize_neon(float *f, std::size_t n) {
+                const float32x4_t one = vdupq_n_f32(1.0f);
+                const float32x4_t zero = vdupq_n_f32(0.0f);
+                const float32x4_t tiny = vdupq_n_f32(std::numeric_limits<float>::min());
+                const std::size_t k = n / 4 * 4;
+                for (std::size_t i = 0; i < k; i += 4) {
+                    float32x4x3_t v = vld3q_f32(f + 3 * i);
+                    const float32x4_t len2 = vaddq_f32(vaddq_f32(vmulq_f32(v.val[0], v.val[0]),
+                                                                 vmulq_f32(v.val[1], v.val[1])),
+                                                       vmulq_f32(v.val[2], v.val[2]));
+                    const float32x4_t len = vsqrtq_f32(len2);
+                    const float32x4_t s = vbslq_f32(vcgtq_f32(len, tiny), vdivq_f32(one, len), zero);
+                    for (int c = 0; c < 3; ++c)
+                        v.val[c] = vmulq_f32(v.val[c], s);
+                    vst3q_f32(f + 3 * i, v);
+                }
+                normalize_scalar(f + 3 * k, n - k);
+            }
+
+#endif  // EASY3D_KERNELS_NEON
+
+            std::atomic<int> &current_instruction_set() {
+                static std::atomic<int> isa(best_instruction_set());
+                return isa;
+            }
+
+            // The number of points processed by a task. Smaller arrays are processed by the calling thread.
+            const std::size_t chunk_size = 1 << 16;
+
+            // runs kernel(first, count) on chunks of the n elements (in parallel if there are several chunks)
+            template<typename Kernel>
+            void for_each_chunk(std::size_t n, const Kernel &kernel) {
+                if (n <= chunk_size) {
+                    kernel(std::size_t(0), n);
+                    return;
+                }
+                const std::size_t num_chunks = (n + chunk_size - 1) / chunk_size;
+                parallel_for(std::size_t(0), num_chunks, [&](std::size_t c) {
+                    const std::size_t first = c * chunk_size;
+                    kernel(first, std::min(chunk_size, n - first));
+                }, 1);
+            }
+
+        }
+
+
+        InstructionSet best_instruction_set() {
+#if defined(EASY3D_KERNELS_X86)
+            static const InstructionSet best = internal::cpu_supports_avx2() ? AVX2 : SSE2;
+            return best;
+#elif defined(EASY3D_KERNELS_NEON)
+            return NEON;
+#else
+            return SCALAR;
+#endif
+        }
+
+
+        InstructionSet instruction_set() {
+            return static_cast<InstructionSet>(internal::current_instruction_set().load());
+        }
+
+
+        InstructionSet set_instruction_set(InstructionSet isa) {
+            const InstructionSet best = best_instruction_set();
+            bool supported = (isa == SCALAR || isa == best);
+#if defined(EASY3D_KERNELS_X86)
+            supported = supported || isa == SSE2;
+#endif
+            LOG_IF(!supported, WARNING) << "instruction set " << instruction_set_name(isa)
+                                        << " is not supported. Using " << instruction_set_name(best);
+            internal::current_instruction_set() = supported ? isa : best;
+            return instruction_set();
+        }
+
+
+        std::string instruction_set_name(InstructionSet isa) {
+            switch (isa) {
+                case SSE2: return "SSE2";
+                case AVX2: return "AVX2";
+                case NEON: return "NEON";
+                default: return "scalar";
+            }
+        }
+
+
+        Box3 bounding_box(const vec3 *points, std::size_t n) {
+            if (n == 0)
+                return Box3();
+
+            const auto isa = instruction_set();
+            const float *f = points->data();
+            const std::size_t num_chunks = (n + internal::chunk_size - 1) / internal::chunk_size;
+            std::vector<float> ranges(6 * num_chunks);
+            internal::for_each_chunk(n, [&](std::size_t first, std::size_t count) {
+                float *lo = ranges.data() + 6 * (first / internal::chunk_size), *hi = lo + 3;
+                for (int k = 0; k < 3; ++k)
+                    lo[k] = hi[k] = f[3 * first + k];
+                switch (isa) {
+#if defined(EASY3D_KERNELS_X86)
+                    case AVX2: internal::bbox_avx2(f + 3 * first, count, lo, hi); break;
+                    case SSE2: internal::bbox_sse2(f + 3 * first, count, lo, hi); break;
+#elif defined(EASY3D_KERNELS_NEON)
+                    case NEON: internal::bbox_neon(f + 3 * first, count, lo, hi); break;
+#endif
+                    default: internal::bbox_scalar(f + 3 * first, count, lo, hi);
+                }
+            });
+
+            vec3 lo(ranges.data()), hi(ranges.data() + 3);
+            for (std::size_t c = 1; c < num_chunks; ++c) {
+                for (int k = 0; k < 3; ++k) {
+                    lo[k] = std::min(lo[k], ranges[6 * c + k]);
+                    hi[k] = std::max(hi[k], ranges[6 * c + 3 + k]);
+                }
+            }
+            return Box3(lo, hi);
+        }
+
+
+        void translate(vec3 *points, std::size_t n, const vec3 &t) {
+            const auto isa = instruction_set();
+            float *f = points->data();
+            internal::for_each_chunk(n, [&](std::size_t first, std::size_t count) {
+                switch (isa) {
+#if defined(EASY3D_KERNELS_X86)
+                    case AVX2: internal::translate_avx2(f + 3 * first, count, t.data()); break;
+                    case SSE2: internal::translate_sse2(f + 3 * first, count, t.data()); break;
+#elif defined(EASY3D_KERNELS_NEON)
+                    case NEON: internal::translate_neon(f + 3 * first, count, t.data()); break;
+#endif
+                    default: internal::translate_scalar(f + 3 * first, count, t.data());
+                }
+            });
+        }
+
+
+        void transform(vec3 *points, std::size_t n, const mat4 &m) {
+            const auto isa = instruction_set();
+            const internal::Rows rows(m);
+            float *f = points->data();
+            internal::for_each_chunk(n, [&](std::size_t first, std::size_t count) {
+                switch (isa) {
+#if defined(EASY3D_KERNELS_X86)
+                    case AVX2: internal::transform_avx2(f + 3 * first, count, rows.v); break;
+                    case SSE2: internal::transform_sse2(f + 3 * first, count, rows.v); break;
+#elif defined(EASY3D_KERNELS_NEON)
+                    case NEON: internal::transform_neon(f + 3 * first, count, rows.v); break;
+#endif
+                    default: internal::transform_scalar(f + 3 * first, count, rows.v);
+                }
+            });
+        }
+
+
+        void project(const vec3 *points, std::size_t n, const mat4 &m, vec2 *result) {
+            const auto isa = instruction_set();
+            const internal::Rows rows(m);
+            const float *f = points->data();
+            float *out = result->data();
+            internal::for_each_chunk(n, [&](std::size_t first, std::size_t count) {
+                switch (isa) {
+#if defined(EASY3D_KERNELS_X86)
+                    case AVX2: internal::project_avx2(f + 3 * first, count, rows.v, out + 2 * first); break;
+                    case SSE2: internal::project_sse2(f + 3 * first, count, rows.v, out + 2 * first); break;
+#elif defined(EASY3D_KERNELS_NEON)
+                    case NEON: internal::project_neon(f + 3 * first, count, rows.v, out + 2 * first); break;
+#endif
+                    default: internal::project_scalar(f + 3 * first, count, rows.v, out + 2 * first);
+                }
+            });
+        }
+
+
+        void distance_to_plane(const vec3 *points, std::size_t n, const Plane3 &plane, float *distances) {
+            const auto isa = instruction_set();
+            const float p[4] = {plane.a(), plane.b(), plane.c(), plane.d()};
+            const float *f = points->data();
+            internal::for_each_chunk(n, [&](std::size_t first, std::size_t count) {
+                switch (isa) {
+#if defined(EASY3D_KERNELS_X86)
+                    case AVX2: internal::distance_avx2(f + 3 * first, count, p, distances + first); break;
+                    case SSE2: internal::distance_sse2(f + 3 * first, count, p, distances + first); break;
+#elif defined(EASY3D_KERNELS_NEON)
+                    case NEON: internal::distance_neon(f + 3 * first, count, p, distances + first); break;
+#endif
+                    default: internal::distance_scalar(f + 3 * first, count, p, distances + first);
+                }
+            });
+        }
+
+
+        void normalize(vec3 *vectors, std::size_t n) {
+            const auto isa = instruction_set();
+            float *f = vectors->data();
+            internal::for_each_chunk(n, [&](std::size_t first, std::size_t count) {
+                switch (isa) {
+#if defined(EASY3D_KERNELS_X86)
+                    case AVX2: internal::normalize_avx2(f + 3 * first, count); break;
+                    case SSE2: internal::normalize_sse2(f + 3 * first, count); break;
+#elif defined(EASY3D_KERNELS_NEON)
+                    case NEON: internal::normalize_neon(f + 3 * first, count); break;
+#endif
+                    default: internal::normalize_scalar(f + 3 * first, count);
+                }
+            });
+        }
+
+
+        void SoAPoints::assign(const vec3 *points, std::size_t n) {
+            x_.resize(n);
+            y_.resize(n);
+            z_.resize(n);
+            internal::for_each_chunk(n, [&](std::size_t first, std::size_t count) {
+                for (std::size_t i = first; i < first + count; ++i) {
+                    x_[i] = points[i].x;
+                    y_[i] = points[i].y;
+                    z_[i] = points[i].z;
+                }
+            });
+        }
+
+
+        void SoAPoints::store(vec3 *points) const {
+            internal::for_each_chunk(size(), [&](std::size_t first, std::size_t count) {
+                for (std::size_t i = first; i < first + count; ++i)
+                    points[i] = vec3(x_[i], y_[i], z_[i]);
+            });
+        }
+
+
+        Box3 bounding_box(const SoAPoints &points) {
+            const std::size_t n = points.size();
+            if (n == 0)
+                return Box3();
+
+            const auto isa = instruction_set();
+            const std::vector<float> *coords[3] = {&points.x(), &points.y(), &points.z()};
+            vec3 lo, hi;
+            // the three coordinates are contiguous arrays, which need no shuffling
+            parallel_for(0, 3, [&](int k) {
+                const float *v = coords[k]->data();
+                float l = v[0], h = v[0];
+                switch (isa) {
+#if defined(EASY3D_KERNELS_X86)
+                    case AVX2: internal::range_avx2(v, n, l, h); break;
+                    case SSE2: internal::range_sse2(v, n, l, h); break;
+#elif defined(EASY3D_KERNELS_NEON)
+                    case NEON: internal::range_neon(v, n, l, h); break;
+#endif
+                    default: internal::range_scalar(v, n, l, h);
+                }
+                lo[k] = l;
+                hi[k] = h;
+            }, 1);
+            return Box3(lo, hi);
+        }
+
+
+        void distance_to_plane(const SoAPoints &points, const Plane3 &plane, std::vector<float> &distances) {
+            const std::size_t n = points.size();
+            distances.resize(n);
+            const float a = plane.a(), b = plane.b(), c = plane.c(), d = plane.d();
+            const float *x = points.x().data(), *y = points.y().data(), *z = points.z().data();
+            float *out = distances.data();
+            // the loop over contiguous arrays is vectorized by the compiler
+            internal::for_each_chunk(n, [&](std::size_t first, std::size_t count) {
+                for (std::size_t i = first; i < first + count; ++i)
+                    out[i] = a * x[i] + b * y[i] + c * z[i] + d;
+            });
+        }
+
+    }
+
+}
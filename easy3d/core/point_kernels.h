@@ -0,0 +1,172 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#ifndef EASY3D_CORE_POINT_KERNELS_H
+#define EASY3D_CORE_POINT_KERNELS_H
+
+#include <string>
+#include <vector>
+
+#include <easy3d/core/types.h>
+
+
+namespace easy3d {
+
+    /**
+     * \brief Vectorized kernels processing arrays of points (or vectors).
+     * \namespace easy3d::kernels
+     * \details The kernels work directly on the positions stored as arrays of vec3 (i.e., arrays of structures with
+     *      a 12-byte stride), which are converted to/from the structure-of-arrays layout in SIMD registers. They use
+     *      SSE2 or AVX2 (with FMA) on x86 and NEON on ARM, and the best instruction set supported by the CPU is
+     *      selected at runtime. Large arrays are further split into chunks processed in parallel by the shared
+     *      ThreadPool. The results are the same as those of the straightforward scalar loops, except for
+     *      transform(), project(), and distance_to_plane(), which may differ in the last bit when FMA is used.
+     *
+     *      Example usage:
+     *      \code
+     *          auto& points = cloud->points();
+     *          const Box3 box = kernels::bounding_box(points);
+     *          kernels::translate(points, -box.center());
+     *          cloud->touch_geometry();
+     *      \endcode
+     *      For algorithms running several kernels on the same (static) positions, a SoAPoints mirror of the
+     *      positions avoids the conversion of the layout in each kernel.
+     */
+    namespace kernels {
+
+        /// \brief The instruction sets the kernels can use.
+        enum InstructionSet {
+            SCALAR, ///< plain C++ (no explicit SIMD)
+            SSE2,   ///< x86 SSE2 (4 floats per register)
+            AVX2,   ///< x86 AVX2 and FMA (8 floats per register)
+            NEON    ///< ARM NEON (4 floats per register)
+        };
+
+        /// \brief Returns the instruction set currently used by the kernels.
+        InstructionSet instruction_set();
+        /**
+         * \brief Sets the instruction set to be used by the kernels, e.g., SCALAR for comparison.
+         * \details If the CPU does not support \p isa, the best supported instruction set is used.
+         * \return The instruction set actually used.
+         */
+        InstructionSet set_instruction_set(InstructionSet isa);
+        /// \brief Returns the best instruction set supported by the CPU (detected at runtime).
+        InstructionSet best_instruction_set();
+        /// \brief Returns the name of an instruction set, e.g., "AVX2".
+        std::string instruction_set_name(InstructionSet isa);
+
+        /// \brief Computes the bounding box of \p n points. The box is invalid if \p n is 0.
+        Box3 bounding_box(const vec3 *points, std::size_t n);
+        /// \brief Translates \p n points by \p t.
+        void translate(vec3 *points, std::size_t n, const vec3 &t);
+        /// \brief Transforms \p n points by the affine transformation \p m (i.e., the last row of \p m is ignored).
+        void transform(vec3 *points, std::size_t n, const mat4 &m);
+        /**
+         * \brief Projects \p n points by the projective transformation \p m (e.g., the model-view-projection matrix
+         *      of a camera), and maps the resulting x and y coordinates from [-1, 1] to [0, 1].
+         * \param result The projected points, which must have room for \p n elements.
+         */
+        void project(const vec3 *points, std::size_t n, const mat4 &m, vec2 *result);
+        /**
+         * \brief Computes the signed distances of \p n points to a plane.
+         * \param distances The distances, which must have room for \p n elements. They are scaled by the length of
+         *      the normal of the plane if the normal is not a unit vector.
+         */
+        void distance_to_plane(const vec3 *points, std::size_t n, const Plane3 &plane, float *distances);
+        /// \brief Normalizes \p n vectors (in place). Zero vectors remain zero (same as vec3::normalize()).
+        void normalize(vec3 *vectors, std::size_t n);
+
+        /// \brief Computes the bounding box of the points. The box is invalid if \p points is empty.
+        inline Box3 bounding_box(const std::vector<vec3> &points) {
+            return bounding_box(points.data(), points.size());
+        }
+        /// \brief Translates the points by \p t.
+        inline void translate(std::vector<vec3> &points, const vec3 &t) {
+            translate(points.data(), points.size(), t);
+        }
+        /// \brief Transforms the points by the affine transformation \p m.
+        inline void transform(std::vector<vec3> &points, const mat4 &m) {
+            transform(points.data(), points.size(), m);
+        }
+        /// \brief Projects the points by the projective transformation \p m (see project()).
+        inline void project(const std::vector<vec3> &points, const mat4 &m, std::vector<vec2> &result) {
+            result.resize(points.size());
+            project(points.data(), points.size(), m, result.data());
+        }
+        /// \brief Computes the signed distances of the points to a plane.
+        inline void distance_to_plane(const std::vector<vec3> &points, const Plane3 &plane,
+                                      std::vector<float> &distances) {
+            distances.resize(points.size());
+            distance_to_plane(points.data(), points.size(), plane, distances.data());
+        }
+        /// \brief Normalizes the vectors (in place).
+        inline void normalize(std::vector<vec3> &vectors) {
+            normalize(vectors.data(), vectors.size());
+        }
+
+
+        /**
+         * \brief A structure-of-arrays mirror of point positions.
+         * \details The coordinates are stored in three separate arrays, which can be processed by SIMD instructions
+         *      without any shuffling. Creating the mirror costs a copy of the positions, so it is profitable only if
+         *      several kernels are run on the same positions. The mirror is not synchronized with the positions:
+         *      call assign() again after the positions are modified.
+         */
+        class SoAPoints {
+        public:
+            SoAPoints() = default;
+            /// \brief Constructs the mirror of the points.
+            explicit SoAPoints(const std::vector<vec3> &points) { assign(points.data(), points.size()); }
+
+            /// \brief Copies the \p n points into the mirror.
+            void assign(const vec3 *points, std::size_t n);
+            /// \brief Copies the mirrored points back into \p points, which must have room for size() elements.
+            void store(vec3 *points) const;
+
+            /// \brief Returns the number of points.
+            std::size_t size() const { return x_.size(); }
+
+            /// \brief Returns the x coordinates of the points.
+            const std::vector<float> &x() const { return x_; }
+            /// \brief Returns the y coordinates of the points.
+            const std::vector<float> &y() const { return y_; }
+            /// \brief Returns the z coordinates of the points.
+            const std::vector<float> &z() const { return z_; }
+
+        private:
+            std::vector<float> x_, y_, z_;
+        };
+
+        /// \brief Computes the bounding box of mirrored points.
+        Box3 bounding_box(const SoAPoints &points);
+        /// \brief Computes the signed distances of mirrored points to a plane.
+        void distance_to_plane(const SoAPoints &points, const Plane3 &plane, std::vector<float> &distances);
+
+    }
+
+}
+
+#endif  // EASY3D_CORE_POINT_KERNELS_H
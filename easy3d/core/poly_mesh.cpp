@@ -27,32 +27,17 @@
 #include <easy3d/core/poly_mesh.h>
 
 #include <cmath>
+#include <cstdint>
 #include <fstream>
 
 #include <easy3d/util/logging.h>
+#include <easy3d/util/thread_pool.h>
 
 
 namespace easy3d {
 
     namespace internal {
 
-        template<typename T>
-        inline void read(std::istream &input, std::set<T>& data) {
-            unsigned int size(0);
-            input.read((char*)&size, sizeof(unsigned int));
-            std::vector<T> array(size);
-            input.read((char*)array.data(), size * sizeof(T));
-            data = std::set<T>(array.begin(), array.end());
-        }
-
-        template<typename T>
-        inline void write(std::ostream &output, const std::set<T>& data) {
-            unsigned int size = static_cast<unsigned int>(data.size());
-            output.write((char*)&size, sizeof(unsigned int));
-            std::vector<T> array(data.begin(), data.end());
-            output.write((char*)array.data(), size * sizeof(T));
-        }
-
         template<typename T>
         inline void read(std::istream &input, std::vector<T>& data) {
             unsigned int size(0);
@@ -67,6 +52,119 @@ namespace easy3d {
             output.write((char*)&size, sizeof(unsigned int));
             output.write((char*)data.data(), size * sizeof(T));
         }
+
+        // the key of an edge: its two vertex indices (the smaller one first)
+        inline uint64_t edge_key(int a, int b) {
+            if (a > b)
+                std::swap(a, b);
+            return (static_cast<uint64_t>(a) << 32) | static_cast<uint32_t>(b);
+        }
+
+        // mixes the bits of a 64-bit key (the finalizer of SplitMix64)
+        inline std::size_t mix(uint64_t k) {
+            k ^= k >> 31;
+            k *= 0x94D049BB133111EBull;
+            k ^= k >> 29;
+            return static_cast<std::size_t>(k);
+        }
+
+        // an open-addressing hash table mapping the keys of the edges to their indices
+        class EdgeTable {
+        public:
+            explicit EdgeTable(std::size_t n) : size_(0) { rehash(n); }
+            // returns the index of the edge \p key. If it is not in the table, it is added with \p index.
+            std::pair<int, bool> insert(uint64_t key, int index) {
+                if ((size_ + 1) * 2 > keys_.size())
+                    rehash(keys_.size());
+                for (std::size_t i = mix(key) & mask_; ; i = (i + 1) & mask_) {
+                    if (indices_[i] < 0) {
+                        keys_[i] = key;
+                        indices_[i] = index;
+                        ++size_;
+                        return {index, true};
+                    }
+                    else if (keys_[i] == key)
+                        return {indices_[i], false};
+                }
+            }
+        private:
+            void rehash(std::size_t n) {
+                std::size_t capacity = 16;
+                while (capacity < n * 2) capacity <<= 1;
+                std::vector<uint64_t> keys(capacity);
+                std::vector<int> indices(capacity, -1);
+                keys.swap(keys_);
+                indices.swap(indices_);
+                mask_ = capacity - 1;
+                size_ = 0;
+                for (std::size_t i = 0; i < keys.size(); ++i) {
+                    if (indices[i] >= 0)
+                        insert(keys[i], indices[i]);
+                }
+            }
+        private:
+            std::vector<uint64_t> keys_;
+            std::vector<int> indices_;
+            std::size_t mask_;
+            std::size_t size_;
+        };
+
+        // an open-addressing hash table mapping the faces (each identified by its sorted vertex indices) to their
+        // indices
+        class FaceTable {
+        public:
+            explicit FaceTable(std::size_t n) : offsets_(1, 0) {
+                keys_.reserve(n * 3);
+                offsets_.reserve(n + 1);
+                hashes_.reserve(n);
+                indices_.reserve(n);
+                rehash(n);
+            }
+            // returns the index of the face having the (sorted) vertices \p key. If it is not in the table, it is
+            // added with \p index.
+            std::pair<int, bool> insert(const std::vector<int>& key, int index) {
+                if ((hashes_.size() + 1) * 2 > slots_.size())
+                    rehash(slots_.size());
+                uint64_t h = key.size();
+                for (auto v : key)
+                    h = h * 0x9E3779B97F4A7C15ull + static_cast<uint32_t>(v);
+                const std::size_t hash = mix(h);
+                for (std::size_t i = hash & mask_; ; i = (i + 1) & mask_) {
+                    const int f = slots_[i];
+                    if (f < 0) {
+                        slots_[i] = static_cast<int>(hashes_.size());
+                        hashes_.push_back(hash);
+                        indices_.push_back(index);
+                        keys_.insert(keys_.end(), key.begin(), key.end());
+                        offsets_.push_back(keys_.size());
+                        return {index, true};
+                    }
+                    else if (hashes_[f] == hash && offsets_[f + 1] - offsets_[f] == key.size() &&
+                             std::equal(key.begin(), key.end(), keys_.begin() + offsets_[f]))
+                        return {indices_[f], false};
+                }
+            }
+        private:
+            void rehash(std::size_t n) {
+                std::size_t capacity = 16;
+                while (capacity < n * 2) capacity <<= 1;
+                slots_.assign(capacity, -1);
+                mask_ = capacity - 1;
+                for (std::size_t f = 0; f < hashes_.size(); ++f) {
+                    std::size_t i = hashes_[f] & mask_;
+                    while (slots_[i] >= 0)
+                        i = (i + 1) & mask_;
+                    slots_[i] = static_cast<int>(f);
+                }
+            }
+        private:
+            std::vector<int> keys_;             // the sorted vertex indices of all faces
+            std::vector<std::size_t> offsets_;  // the start of each face in keys_
+            std::vector<std::size_t> hashes_;   // the hash value of each face
+            std::vector<int> indices_;          // the index of each face
+            std::vector<int> slots_;
+            std::size_t mask_;
+        };
     }
 
 
@@ -152,6 +250,8 @@ namespace easy3d {
     {
         if (this != &rhs)
         {
+            touch_topology();
+
             // deep copy of property containers
             vprops_ = rhs.vprops_;
             eprops_ = rhs.eprops_;
@@ -180,6 +280,8 @@ namespace easy3d {
     {
         if (this != &rhs)
         {
+            touch_topology();
+
             // clear properties
             vprops_.clear();
             eprops_.clear();
@@ -310,6 +412,8 @@ namespace easy3d {
 
     void PolyMesh::clear()
     {
+        touch_topology();
+
         //---- clear without removing properties
 
         vprops_.resize(0);
@@ -352,44 +456,34 @@ namespace easy3d {
                 output << "\t" << p << std::endl;
         }
 
-        props = vertex_properties();
-        if (!props.empty())
+        if (vprops_.n_properties() > 0)
         {
             output << "vertex properties:\n";
-            for (const auto& p : props)
-                output << "\t" << p << std::endl;
+            vprops_.print_statistics(output);
         }
 
-        props = edge_properties();
-        if (!props.empty())
+        if (eprops_.n_properties() > 0)
         {
-            output<< "edge properties:\n";
-            for (const auto& p : props)
-                output << "\t" << p << std::endl;
+            output << "edge properties:\n";
+            eprops_.print_statistics(output);
         }
 
-        props = halfface_properties();
-        if (!props.empty())
+        if (hprops_.n_properties() > 0)
         {
             output << "halfface properties:\n";
-            for (const auto& p : props)
-                output << "\t" << p << std::endl;
+            hprops_.print_statistics(output);
         }
 
-        props = face_properties();
-        if (!props.empty())
+        if (fprops_.n_properties() > 0)
         {
             output << "face properties:\n";
-            for (const auto& p : props)
-                output << "\t" << p << std::endl;
+            fprops_.print_statistics(output);
         }
 
-        props = cell_properties();
-        if (!props.empty())
+        if (cprops_.n_properties() > 0)
         {
             output << "cell properties:\n";
-            for (const auto& p : props)
-                output << "\t" << p << std::endl;
+            cprops_.print_statistics(output);
         }
 
         props = model_properties();
@@ -406,6 +500,9 @@ namespace easy3d {
 
 
     PolyMesh::Edge PolyMesh::find_edge(Vertex a, Vertex b) const {
+        // scan the shorter one of the two incidence lists
+        if (edges(b).size() < edges(a).size())
+            std::swap(a, b);
         for (auto e : edges(a)) {
             if (vertex(e, 0) == b || vertex(e, 1) == b)
                 return e;
@@ -462,13 +559,13 @@ namespace easy3d {
                 if (!e.is_valid())
                     e = new_edge(s, t);
 
-                econn_[e].halffaces_.insert(h);
-                econn_[e].halffaces_.insert(oh);
-                hconn_[h].edges_.insert(e);
-                hconn_[oh].edges_.insert(e);
+                insert(econn_[e].halffaces_, h);
+                insert(econn_[e].halffaces_, oh);
+                insert(hconn_[h].edges_, e);
+                insert(hconn_[oh].edges_, e);
 
-                vconn_[s].halffaces_.insert(h);
-                vconn_[s].halffaces_.insert(oh);
+                insert(vconn_[s].halffaces_, h);
+                insert(vconn_[s].halffaces_, oh);
             }
         }
 
@@ -483,12 +580,12 @@ namespace easy3d {
         for (auto f : faces) {
             hconn_[f].cell_ = c;
             for (auto v : vertices(f)) {
-                vconn_[v].cells_.insert(c);
-                cconn_[c].vertices_.insert(v);
+                insert(vconn_[v].cells_, c);
+                insert(cconn_[c].vertices_, v);
             }
             for (auto e : edges(f)) {
-                cconn_[c].edges_.insert(e);
-                econn_[e].cells_.insert(c);
+                insert(cconn_[c].edges_, e);
+                insert(econn_[e].cells_, c);
             }
         }
 
@@ -516,6 +613,276 @@ namespace easy3d {
     }
 
 
+    template <typename CellFaces>
+    unsigned int PolyMesh::add_cells_in_bulk(std::size_t num_cells, const CellFaces& cell_faces) {
+        const auto nv = n_vertices();
+        const auto ne0 = n_edges();
+        const auto nf0 = n_faces();
+        const auto nc0 = n_cells();
+
+        // a tetrahedral mesh has about 1.2 edges and 2 faces per cell (the tables grow if needed)
+        internal::EdgeTable edge_table(ne0 + num_cells * 3 / 2);
+        internal::FaceTable face_table(nf0 + num_cells * 2);
+
+        // the existing edges and faces, so the new cells are also connected to them
+        std::vector<int> key;
+        for (auto e : edges())
+            edge_table.insert(internal::edge_key(vertex(e, 0).idx(), vertex(e, 1).idx()), e.idx());
+        for (auto f : faces()) {
+            key.clear();
+            for (auto v : vertices(f))
+                key.push_back(v.idx());
+            std::sort(key.begin(), key.end());
+            face_table.insert(key, f.idx());
+        }
+
+        // match the faces and edges of the new cells and number the new ones
+        std::vector<Vertex> new_edges;                      // two vertices per new edge
+        std::vector<Vertex> new_faces;                      // the vertices of each new face (i.e., its first halfface)
+        std::vector<Edge> new_face_edges;                   // the edges of each new face (aligned with new_faces)
+        std::vector<std::size_t> new_face_offsets(1, 0);    // the start of each new face in new_faces
+        std::vector<Vertex> cell_vertices;                  // the vertices of each new cell
+        std::vector<std::size_t> cell_vertex_offsets(1, 0); // the start of each new cell in cell_vertices
+        std::vector<HalfFace> cell_halffaces;               // the halffaces of each new cell
+        std::vector<std::size_t> cell_face_offsets(1, 0);   // the start of each new cell in cell_halffaces
+        new_edges.reserve(num_cells * 3);
+        new_faces.reserve(num_cells * 6);
+        new_face_edges.reserve(num_cells * 6);
+        new_face_offsets.reserve(num_cells * 2 + 1);
+        cell_vertices.reserve(num_cells * 4);
+        cell_vertex_offsets.reserve(num_cells + 1);
+        cell_halffaces.reserve(num_cells * 4);
+        cell_face_offsets.reserve(num_cells + 1);
+
+        // whether the loop of vertices \c loop has the same orientation as the first halfface of face \c f (an
+        // existing face if f < nf0, or a new one otherwise)
+        const auto same_orientation = [&](int f, const unsigned int* loop, std::size_t n) -> bool {
+            const Vertex* vts = (f < static_cast<int>(nf0)) ? hconn_[HalfFace(f * 2)].vertices_.data()
+                                                            : new_faces.data() + new_face_offsets[f - nf0];
+            const std::size_t start = std::find(vts, vts + n, Vertex(static_cast<int>(loop[0]))) - vts;
+            for (std::size_t k = 1; k < n; ++k) {
+                if (vts[(start + k) % n].idx() != static_cast<int>(loop[k]))
+                    return false;
+            }
+            return true;
+        };
+
+        std::vector<unsigned int> sizes, loops; // the faces of a cell
+        std::size_t num_skipped = 0;
+        for (std::size_t i = 0; i < num_cells; ++i) {
+            sizes.clear();
+            loops.clear();
+            cell_faces(i, sizes, loops);
+
+            // each face must have at least 3 distinct and valid vertices
+            bool valid = !sizes.empty();
+            std::size_t total = 0;
+            for (std::size_t j = 0; valid && j < sizes.size(); ++j) {
+                valid = sizes[j] >= 3 && total + sizes[j] <= loops.size();
+                if (valid) {
+                    key.assign(loops.begin() + total, loops.begin() + total + sizes[j]);
+                    std::sort(key.begin(), key.end());
+                    valid = key.back() < static_cast<int>(nv) && key.front() >= 0 &&
+                            std::adjacent_find(key.begin(), key.end()) == key.end();
+                }
+                total += sizes[j];
+            }
+            if (!valid || total != loops.size()) {
+                ++num_skipped;
+                continue;
+            }
+
+            const unsigned int* loop = loops.data();
+            for (auto n : sizes) {
+                key.assign(loop, loop + n);
+                std::sort(key.begin(), key.end());
+                const int id = static_cast<int>(nf0 + new_face_offsets.size() - 1);
+                const auto pos = face_table.insert(key, id);
+                if (pos.second) { // a new face
+                    for (std::size_t k = 0; k < n; ++k) {
+                        const int s = static_cast<int>(loop[k]);
+                        const int t = static_cast<int>(loop[(k + 1) % n]);
+                        const int eid = static_cast<int>(ne0 + new_edges.size() / 2);
+                        const auto epos = edge_table.insert(internal::edge_key(s, t), eid);
+                        if (epos.second)
+                            new_edges.insert(new_edges.end(), {Vertex(s), Vertex(t)});
+                        new_faces.emplace_back(s);
+                        new_face_edges.emplace_back(epos.first);
+                    }
+                    new_face_offsets.push_back(new_faces.size());
+                    cell_halffaces.emplace_back(id * 2);
+                }
+                else // an existing face: use the halfface having the same orientation
+                    cell_halffaces.emplace_back(pos.first * 2 + (same_orientation(pos.first, loop, n) ? 0 : 1));
+                loop += n;
+            }
+            cell_face_offsets.push_back(cell_halffaces.size());
+
+            key.assign(loops.begin(), loops.end());
+            std::sort(key.begin(), key.end());
+            key.erase(std::unique(key.begin(), key.end()), key.end());
+            for (auto v : key)
+                cell_vertices.emplace_back(v);
+            cell_vertex_offsets.push_back(cell_vertices.size());
+        }
+        LOG_IF(num_skipped > 0, WARNING) << num_skipped << " cells skipped (invalid or repeated vertex indices)";
+
+        // allocate all the new elements at once
+        const std::size_t ne = new_edges.size() / 2;
+        const std::size_t nf = new_face_offsets.size() - 1;
+        const std::size_t nc = cell_face_offsets.size() - 1;
+        touch_topology();
+        eprops_.resize(ne0 + ne);
+        fprops_.resize(nf0 + nf);
+        hprops_.resize((nf0 + nf) * 2);
+        cprops_.resize(nc0 + nc);
+
+        // count the new incidences of each vertex, so each incidence list grows only once
+        std::vector<unsigned int> num_edges(nv, 0), num_halffaces(nv, 0), num_cells_of(nv, 0);
+        for (auto v : new_edges)     ++num_edges[v.idx()];
+        for (auto v : new_faces)     num_halffaces[v.idx()] += 2;
+        for (auto v : cell_vertices) ++num_cells_of[v.idx()];
+        parallel_for(0u, nv, [&](unsigned int i) {
+            auto& conn = vconn_[Vertex(static_cast<int>(i))];
+            conn.vertices_.reserve(conn.vertices_.size() + num_edges[i]);
+            conn.edges_.reserve(conn.edges_.size() + num_edges[i]);
+            conn.halffaces_.reserve(conn.halffaces_.size() + num_halffaces[i]);
+            conn.cells_.reserve(conn.cells_.size() + num_cells_of[i]);
+        });
+
+        // the new elements have larger indices than the existing ones, so appending them (in the order of their
+        // indices) keeps the incidence lists sorted. The only exception is the vertex-vertex incidence.
+        for (std::size_t i = 0; i < ne; ++i) {
+            const Edge e(static_cast<int>(ne0 + i));
+            const Vertex s = new_edges[i * 2], t = new_edges[i * 2 + 1];
+            econn_[e].vertices_ = {s, t};
+            vconn_[s].edges_.push_back(e);
+            vconn_[t].edges_.push_back(e);
+            vconn_[s].vertices_.push_back(t);
+            vconn_[t].vertices_.push_back(s);
+        }
+
+        for (std::size_t i = 0; i < nf; ++i) {
+            const HalfFace h(static_cast<int>((nf0 + i) * 2)), oh(static_cast<int>((nf0 + i) * 2 + 1));
+            const auto begin = new_face_offsets[i], end = new_face_offsets[i + 1];
+            auto& hc = hconn_[h];
+            auto& ohc = hconn_[oh];
+            hc.vertices_.assign(new_faces.begin() + begin, new_faces.begin() + end);
+            ohc.vertices_.assign(hc.vertices_.rbegin(), hc.vertices_.rend());
+            hc.opposite_ = oh;
+            ohc.opposite_ = h;
+            hc.edges_.assign(new_face_edges.begin() + begin, new_face_edges.begin() + end);
+            std::sort(hc.edges_.begin(), hc.edges_.end());
+            ohc.edges_ = hc.edges_;
+            for (auto e : hc.edges_) {
+                econn_[e].halffaces_.push_back(h);
+                econn_[e].halffaces_.push_back(oh);
+            }
+            for (auto v : hc.vertices_) {
+                vconn_[v].halffaces_.push_back(h);
+                vconn_[v].halffaces_.push_back(oh);
+            }
+        }
+
+        for (std::size_t i = 0; i < nc; ++i) {
+            const Cell c(static_cast<int>(nc0 + i));
+            auto& cc = cconn_[c];
+            cc.halffaces_.assign(cell_halffaces.begin() + cell_face_offsets[i],
+                                 cell_halffaces.begin() + cell_face_offsets[i + 1]);
+            cc.vertices_.assign(cell_vertices.begin() + cell_vertex_offsets[i],
+                                cell_vertices.begin() + cell_vertex_offsets[i + 1]);
+            cc.edges_.clear();
+            for (auto h : cc.halffaces_) {
+                hconn_[h].cell_ = c;
+                cc.edges_.insert(cc.edges_.end(), hconn_[h].edges_.begin(), hconn_[h].edges_.end());
+            }
+            std::sort(cc.edges_.begin(), cc.edges_.end());
+            cc.edges_.erase(std::unique(cc.edges_.begin(), cc.edges_.end()), cc.edges_.end());
+            for (auto v : cc.vertices_)
+                vconn_[v].cells_.push_back(c);
+            for (auto e : cc.edges_)
+                econn_[e].cells_.push_back(c);
+        }
+
+        parallel_for(0u, nv, [&](unsigned int i) {
+            if (num_edges[i] > 0) {
+                auto& vts = vconn_[Vertex(static_cast<int>(i))].vertices_;
+                std::sort(vts.begin(), vts.end());
+            }
+        });
+
+        return static_cast<unsigned int>(nc);
+    }
+
+
+    unsigned int PolyMesh::add_tetras(const std::vector<unsigned int>& indices) {
+        LOG_IF(indices.size() % 4 != 0, WARNING) << "the number of indices (" << indices.size()
+                                                 << ") is not a multiple of 4";
+        // the faces of a tetrahedron, the same as in add_tetra(Vertex, Vertex, Vertex, Vertex)
+        static const int facet_vertex[4][3] = {{1, 2, 3}, {0, 3, 2}, {3, 0, 1}, {2, 1, 0}};
+        return add_cells_in_bulk(indices.size() / 4, [&](std::size_t i, std::vector<unsigned int>& sizes,
+                                                         std::vector<unsigned int>& loops) {
+            const unsigned int* t = indices.data() + i * 4;
+            for (const auto& fv : facet_vertex) {
+                sizes.push_back(3);
+                loops.insert(loops.end(), {t[fv[0]], t[fv[1]], t[fv[2]]});
+            }
+        });
+    }
+
+
+    unsigned int PolyMesh::add_hexas(const std::vector<unsigned int>& indices) {
+        LOG_IF(indices.size() % 8 != 0, WARNING) << "the number of indices (" << indices.size()
+                                                 << ") is not a multiple of 8";
+        // the faces of a hexahedron, the same as in add_hexa()
+        static const int facet_vertex[6][4] = {
+                {0, 3, 2, 1}, {0, 4, 7, 3}, {4, 5, 6, 7}, {1, 2, 6, 5}, {2, 3, 7, 6}, {0, 1, 5, 4}
+        };
+        return add_cells_in_bulk(indices.size() / 8, [&](std::size_t i, std::vector<unsigned int>& sizes,
+                                                         std::vector<unsigned int>& loops) {
+            const unsigned int* h = indices.data() + i * 8;
+            for (const auto& fv : facet_vertex) {
+                sizes.push_back(4);
+                loops.insert(loops.end(), {h[fv[0]], h[fv[1]], h[fv[2]], h[fv[3]]});
+            }
+        });
+    }
+
+
+    unsigned int PolyMesh::add_cells(const std::vector<unsigned int>& cells) {
+        // locate the cells in the sequence
+        std::vector<std::size_t> starts;
+        std::size_t pos = 0;
+        while (pos < cells.size()) {
+            const std::size_t start = pos;
+            const std::size_t num_faces = cells[pos++];
+            bool complete = true;
+            for (std::size_t j = 0; j < num_faces && complete; ++j) {
+                complete = pos < cells.size() && pos + cells[pos] < cells.size();
+                if (complete)
+                    pos += cells[pos] + 1;
+            }
+            if (!complete) {
+                LOG(WARNING) << "the sequence of cells ends with an incomplete cell";
+                break;
+            }
+            starts.push_back(start);
+        }
+
+        return add_cells_in_bulk(starts.size(), [&](std::size_t i, std::vector<unsigned int>& sizes,
+                                                    std::vector<unsigned int>& loops) {
+            std::size_t p = starts[i];
+            const std::size_t num_faces = cells[p++];
+            for (std::size_t j = 0; j < num_faces; ++j) {
+                const unsigned int n = cells[p++];
+                sizes.push_back(n);
+                loops.insert(loops.end(), cells.begin() + p, cells.begin() + p + n);
+                p += n;
+            }
+        });
+    }
+
+
     PolyMesh::Cell PolyMesh::add_hexa(Vertex v0, Vertex v1, Vertex v2, Vertex v3,
                                       Vertex v4, Vertex v5, Vertex v6, Vertex v7) {
         // for each face, its normal points outside the cell.
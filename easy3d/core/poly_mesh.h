@@ -29,7 +29,8 @@
 
 #include <easy3d/core/model.h>
 
-#include <set>
+#include <vector>
+#include <algorithm>
 
 #include <easy3d/core/types.h>
 #include <easy3d/core/property.h>
@@ -222,10 +223,10 @@ namespace easy3d {
          * \sa EdgeConnectivity, HalfFaceConnectivity, CellConnectivity
          */
         struct VertexConnectivity {
-            std::set<Vertex>     vertices_;  ///< The vertices connected to this vertex.
-            std::set<Edge>       edges_;     ///< The edges incident to this vertex.
-            std::set<HalfFace>   halffaces_; ///< The halffaces incident to this vertex.
-            std::set<Cell>       cells_;     ///< The cells incident to this vertex.
+            std::vector<Vertex>     vertices_;  ///< The vertices connected to this vertex (sorted, unique).
+            std::vector<Edge>       edges_;     ///< The edges incident to this vertex (sorted, unique).
+            std::vector<HalfFace>   halffaces_; ///< The halffaces incident to this vertex (sorted, unique).
+            std::vector<Cell>       cells_;     ///< The cells incident to this vertex (sorted, unique).
             /**
              * This type stores the vertex connectivity
              * \sa EdgeConnectivity, HalfFaceConnectivity, CellConnectivity
@@ -244,8 +245,8 @@ namespace easy3d {
          */
         struct EdgeConnectivity {
             std::vector<Vertex>  vertices_;  ///< The vertices connected to this edge.
-            std::set<HalfFace>   halffaces_; ///< The halffaces incident to this edge.
-            std::set<Cell>       cells_;     ///< The cells incident to this edge.
+            std::vector<HalfFace>   halffaces_; ///< The halffaces incident to this edge (sorted, unique).
+            std::vector<Cell>       cells_;     ///< The cells incident to this edge (sorted, unique).
             /**
              * \brief Reads the edge connectivity from an input stream.
              * \param in The input stream.
@@ -264,7 +265,7 @@ namespace easy3d {
          */
         struct HalfFaceConnectivity {
             std::vector<Vertex> vertices_; ///< The vertices connected to this halfface.
-            std::set<Edge>      edges_;    ///< The edges incident to this halfface.
+            std::vector<Edge>   edges_;    ///< The edges incident to this halfface (sorted, unique).
             Cell                cell_;     ///< The cell incident to this halfface.
             HalfFace            opposite_; ///< The opposite halfface.
             /**
@@ -284,8 +285,8 @@ namespace easy3d {
          * \sa VertexConnectivity, EdgeConnectivity, HalfFaceConnectivity
          */
         struct CellConnectivity {
-            std::set<Vertex>        vertices_;    ///< The vertices connected to this cell.
-            std::set<Edge>          edges_;       ///< The edges incident to this cell.
+            std::vector<Vertex>     vertices_;    ///< The vertices connected to this cell (sorted, unique).
+            std::vector<Edge>       edges_;       ///< The edges incident to this cell (sorted, unique).
             std::vector<HalfFace>   halffaces_;   ///< The halffaces incident to this cell.
             /**
              * \brief Reads the cell connectivity from an input stream.
@@ -1083,6 +1084,39 @@ namespace easy3d {
          * \sa add_vertex()
          */
         Cell add_tetra(Vertex v0, Vertex v1, Vertex v2, Vertex v3);
+        /**
+         * \brief Add a set of tetrahedra in a single pass.
+         * \param indices The vertex indices of the tetrahedra, four per tetrahedron (each in the same order as in
+         *      add_tetra(Vertex, Vertex, Vertex, Vertex)). The vertices must have been created by add_vertex().
+         * \return The number of tetrahedra added. Tetrahedra with invalid or repeated vertex indices are skipped.
+         * \details The result is identical to calling add_tetra(Vertex, Vertex, Vertex, Vertex) for each tetrahedron,
+         *      but the shared faces and edges are matched using hash tables (instead of searching the incidence
+         *      lists of the vertices), and all new elements are allocated at once. So it is much faster for large
+         *      meshes. The new tetrahedra are also connected to the existing faces and edges of the mesh.
+         * \sa add_tetra(), add_hexas(), add_cells()
+         */
+        unsigned int add_tetras(const std::vector<unsigned int>& indices);
+        /**
+         * \brief Add a set of hexahedra in a single pass.
+         * \param indices The vertex indices of the hexahedra, eight per hexahedron (each in the same order as in
+         *      add_hexa()). The vertices must have been created by add_vertex().
+         * \return The number of hexahedra added. Hexahedra with invalid or repeated vertex indices are skipped.
+         * \details The result is identical to calling add_hexa() for each hexahedron. See add_tetras() for details.
+         * \sa add_hexa(), add_tetras(), add_cells()
+         */
+        unsigned int add_hexas(const std::vector<unsigned int>& indices);
+        /**
+         * \brief Add a set of general polyhedral cells in a single pass.
+         * \param cells The cells given as a flat sequence. Each cell is given by its number of faces followed by its
+         *      faces, and each face is given by its number of vertices followed by its vertex indices (ordered such
+         *      that the face normal points outside the cell). E.g., {4, 3, 1, 2, 3, 3, 0, 3, 2, 3, 3, 0, 1, 3, 2, 1, 0}
+         *      is a single tetrahedron. This is also the layout of the cells in the PLM format.
+         * \return The number of cells added. Cells having a face with invalid or repeated vertex indices are skipped.
+         * \details The result is identical to adding the faces of each cell by add_face() and then the cell by
+         *      add_cell(). See add_tetras() for details.
+         * \sa add_cell(), add_tetras(), add_hexas()
+         */
+        unsigned int add_cells(const std::vector<unsigned int>& cells);
         /**
          * \brief Add a new hexahedron connecting vertices \c v0, \c v1, \c v2, \c v3, \c v4, \c v5, \c v6, \c v7.
          * \param v0 The first vertex created by add_vertex().
@@ -1186,6 +1220,7 @@ namespace easy3d {
          * \details nf is the number of faces. For halffaces, nh = 2 * nf.
          */
         void resize(unsigned int nv, unsigned int ne, unsigned int nf, unsigned int nc) {
+            touch_topology();
             vprops_.resize(nv);
             eprops_.resize(ne);
             hprops_.resize(2 * nf);
@@ -1810,9 +1845,9 @@ namespace easy3d {
         /**
          * \brief Returns the vertices around vertex \c v.
          * \param v The vertex.
-         * \return A set of adjacent vertices.
+         * \return A sorted vector of adjacent vertices.
          */
-        const std::set<Vertex>& vertices(Vertex v) const {
+        const std::vector<Vertex>& vertices(Vertex v) const {
             return vconn_[v].vertices_;
         }
 
@@ -1878,54 +1913,54 @@ namespace easy3d {
         /**
          * \brief Returns the set of vertices around cell \c c.
          * \param c The Cell.
-         * \return A set of vertices.
+         * \return A sorted vector of vertices.
          */
-        const std::set<Vertex>& vertices(Cell c) const {
+        const std::vector<Vertex>& vertices(Cell c) const {
             return cconn_[c].vertices_;
         }
 
         /**
          * \brief Returns the set of edges around vertex \c v.
          * \param v The Vertex.
-         * \return A set of edges.
+         * \return A sorted vector of edges.
          */
-        const std::set<Edge>& edges(Vertex v) const {
+        const std::vector<Edge>& edges(Vertex v) const {
             return vconn_[v].edges_;
         }
 
         /**
          * \brief Returns the set of edges around halfface \c h.
          * \param h The HalfFace.
-         * \return A set of edges.
+         * \return A sorted vector of edges.
          */
-        const std::set<Edge>& edges(HalfFace h) const {
+        const std::vector<Edge>& edges(HalfFace h) const {
             return hconn_[h].edges_;
         }
 
         /**
          * \brief Returns the set of edges around cell \c c.
          * \param c The Cell.
-         * \return A set of edges.
+         * \return A sorted vector of edges.
          */
-        const std::set<Edge>& edges(Cell c) const {
+        const std::vector<Edge>& edges(Cell c) const {
             return cconn_[c].edges_;
         }
         
         /**
          * \brief Returns the set of halffaces around vertex \c v.
          * \param v The Vertex.
-         * \return A set of halffaces.
+         * \return A sorted vector of halffaces.
          */
-        const std::set<HalfFace>& halffaces(Vertex v) const {
+        const std::vector<HalfFace>& halffaces(Vertex v) const {
             return vconn_[v].halffaces_;
         }
 
         /**
          * \brief Returns the set of halffaces around edge \c e.
          * \param e The Edge.
-         * \return A set of halffaces.
+         * \return A sorted vector of halffaces.
          */
-        const std::set<HalfFace>& halffaces(Edge e) const {
+        const std::vector<HalfFace>& halffaces(Edge e) const {
             return econn_[e].halffaces_;
         }
 
@@ -1941,18 +1976,18 @@ namespace easy3d {
         /**
          * \brief Returns the set of cells around vertex \c v.
          * \param v The Vertex.
-         * \return A set of cells.
+         * \return A sorted vector of cells.
          */
-        const std::set<Cell>& cells(Vertex v) const {
+        const std::vector<Cell>& cells(Vertex v) const {
             return vconn_[v].cells_;
         }
 
         /**
          * \brief Returns the set of cells around edge \c e.
          * \param e The Edge.
-         * \return A set of cells.
+         * \return A sorted vector of cells.
          */
-        const std::set<Cell>& cells(Edge e) const {
+        const std::vector<Cell>& cells(Edge e) const {
             return econn_[e].cells_;
         }
 
@@ -2106,6 +2141,7 @@ namespace easy3d {
         Vertex new_vertex()
         {
             vprops_.push_back();
+            touch_topology();
             return Vertex(static_cast<int>(n_vertices()-1));
         }
 
@@ -2114,12 +2150,13 @@ namespace easy3d {
         {
             assert(s != t);
             eprops_.push_back();
+            touch_topology();
             Edge e = Edge(static_cast<int>(n_edges() - 1));
             econn_[e].vertices_ = {s, t};
-            vconn_[s].edges_.insert(e);
-            vconn_[t].edges_.insert(e);
-            vconn_[s].vertices_.insert(t);
-            vconn_[t].vertices_.insert(s);
+            insert(vconn_[s].edges_, e);
+            insert(vconn_[t].edges_, e);
+            insert(vconn_[s].vertices_, t);
+            insert(vconn_[t].vertices_, s);
             return e;
         }
 
@@ -2129,6 +2166,7 @@ namespace easy3d {
             fprops_.push_back();
             hprops_.push_back();
             hprops_.push_back();
+            touch_topology();
             HalfFace h0(static_cast<int>(n_halffaces()-2));
             HalfFace h1(static_cast<int>(n_halffaces()-1));
 
@@ -2142,9 +2180,24 @@ namespace easy3d {
         Cell new_cell()
         {
             cprops_.push_back();
+            touch_topology();
             return Cell(static_cast<int>(n_cells()-1));
         }
 
+        /// add \c num_cells cells in a single pass. \c cell_faces(i, sizes, vertices) appends the number of vertices
+        /// of each face of the i-th cell to \c sizes and the vertex indices of the faces to \c vertices.
+        template <typename CellFaces>
+        unsigned int add_cells_in_bulk(std::size_t num_cells, const CellFaces& cell_faces);
+
+        /// insert \c h into the sorted incidence list \c list (if it is not there yet).
+        template <typename Handle>
+        static void insert(std::vector<Handle>& list, Handle h)
+        {
+            auto pos = std::lower_bound(list.begin(), list.end(), h);
+            if (pos == list.end() || *pos != h)
+                list.insert(pos, h);
+        }
+
     private: //------------------------------------------------------- private data
 
         PropertyContainer vprops_;
@@ -2160,6 +2213,8 @@ namespace easy3d {
         CellProperty<CellConnectivity>          cconn_;
 
         VertexProperty<vec3>    vpoint_;
+
+        friend class BinaryContainer;
     };
 
 
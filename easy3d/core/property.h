@@ -30,6 +30,8 @@
 #include <algorithm>
 #include <typeinfo>
 #include <cassert>
+#include <atomic>
+#include <ostream>
 
 #include <easy3d/util/logging.h>
 
@@ -47,7 +49,8 @@ namespace easy3d {
          * \brief Default constructor.
          * \param name The name of the property array.
          */
-        explicit BasePropertyArray(const std::string& name) : name_(name) {}
+        explicit BasePropertyArray(const std::string& name)
+                : name_(name), id_(next_id()), revision_(0), reallocations_(0) {}
 
         /// Destructor.
         virtual ~BasePropertyArray() = default;
@@ -70,6 +73,28 @@ namespace easy3d {
         /// Extend the number of elements by one.
         virtual void push_back() = 0;
 
+        /**
+         * \brief Extends the number of elements by n (initialized by the default value).
+         * \param n The number of elements to append.
+         */
+        virtual void append(size_t n) = 0;
+
+        /// Returns the number of elements.
+        virtual size_t size() const = 0;
+
+        /// Returns the number of elements the allocated storage can hold.
+        virtual size_t capacity() const = 0;
+
+        /// Returns the size (in bytes) of the allocated storage.
+        virtual size_t memory() const = 0;
+
+        /**
+         * \brief Returns the number of times the storage has been (re)allocated, e.g., when the array grows beyond
+         *      its capacity. Frequent reallocations of a growing array can be avoided by reserving memory (see
+         *      reserve() and PropertyContainer::append()).
+         */
+        std::size_t reallocations() const { return reallocations_; }
+
         /**
          * \brief Resets an element to its default value.
          * \param idx The index of the element to reset.
@@ -145,9 +170,37 @@ namespace easy3d {
             return (name() == other.name() && type() == other.type());
         }
 
+        /**
+         * \brief Returns the unique identifier of the property array.
+         * \details Different from the address, the identifier is never reused by another property array (e.g.,
+         *      one allocated after this one was deleted). Together with revision(), it identifies the data of the
+         *      array, e.g., for caching derived data like ScalarFieldStatistics.
+         */
+        std::size_t id() const { return id_; }
+
+        /**
+         * \brief Returns the revision of the data, which is incremented by the modifications through the interface
+         *      of the property array (resizing, swapping, copying elements, or the non-const access to the vector).
+         * \note The assignments through the element access operator (i.e., operator[]) are not tracked. Call
+         *      touch() after modifying some values this way.
+         */
+        std::size_t revision() const { return revision_; }
+
+        /// Increments the revision, i.e., marks the data as modified.
+        void touch() { ++revision_; }
+
+    private:
+        static std::size_t next_id() {
+            static std::atomic<std::size_t> counter(0);
+            return ++counter;
+        }
+
     protected:
 
         std::string name_;
+        std::size_t id_;
+        std::size_t revision_;
+        std::size_t reallocations_;
     };
 
 
@@ -180,22 +233,45 @@ namespace easy3d {
 
         void reserve(size_t n) override
         {
+            const auto storage = data_.capacity();
             data_.reserve(n);
+            count_reallocation(storage);
         }
 
         void resize(size_t n) override
         {
+            const auto storage = data_.capacity();
             data_.resize(n, value_);
+            count_reallocation(storage);
+            ++revision_;
         }
 
         void push_back() override
         {
+            const auto storage = data_.capacity();
             data_.push_back(value_);
+            count_reallocation(storage);
+            ++revision_;
+        }
+
+        void append(size_t n) override
+        {
+            const auto storage = data_.capacity();
+            data_.insert(data_.end(), n, value_);
+            count_reallocation(storage);
+            ++revision_;
         }
 
+        size_t size() const override { return data_.size(); }
+
+        size_t capacity() const override { return data_.capacity(); }
+
+        size_t memory() const override { return data_.capacity() * sizeof(T); }
+
         void reset(size_t idx) override
         {
             data_[idx] = value_;
+            ++revision_;
         }
 
         bool transfer(const BasePropertyArray& other) override
@@ -203,6 +279,7 @@ namespace easy3d {
             const auto pa = dynamic_cast<const PropertyArray*>(&other);
             if(pa != nullptr){
                 std::copy((*pa).data_.begin(), (*pa).data_.end(), data_.end()-(*pa).data_.size());
+                ++revision_;
                 return true;
             }
             return false;
@@ -214,6 +291,7 @@ namespace easy3d {
             if (pa != nullptr)
             {
                 data_[to] = (*pa)[from];
+                ++revision_;
                 return true;
             }
 
@@ -222,7 +300,9 @@ namespace easy3d {
 
         void shrink_to_fit() override
         {
+            const auto storage = data_.capacity();
             vector_type(data_).swap(data_);
+            count_reallocation(storage);
         }
 
         void swap(size_t i0, size_t i1) override
@@ -230,11 +310,13 @@ namespace easy3d {
             T d(data_[i0]);
             data_[i0]=data_[i1];
             data_[i1]=d;
+            ++revision_;
         }
 
         void copy(size_t from, size_t to) override
         {
             data_[to]=data_[from];
+            ++revision_;
         }
 
         BasePropertyArray* clone() const override
@@ -265,9 +347,20 @@ namespace easy3d {
 
         /**
          * \brief Gets a reference to the underlying vector.
+         * \details The revision is incremented because the data may be modified through the reference.
          * \return A reference to the underlying vector.
          */
         std::vector<T>& vector()
+        {
+            ++revision_;
+            return data_;
+        }
+
+        /**
+         * \brief Const access to the underlying vector.
+         * \return A const reference to the underlying vector.
+         */
+        const std::vector<T>& vector() const
         {
             return data_;
         }
@@ -294,6 +387,13 @@ namespace easy3d {
             return data_[_idx];
         }
 
+    private:
+        // counts a reallocation if the capacity has changed (from \p storage)
+        void count_reallocation(size_t storage) {
+            if (data_.capacity() != storage)
+                ++reallocations_;
+        }
+
     private:
         vector_type data_;
         value_type  value_;
@@ -312,6 +412,14 @@ namespace easy3d {
         return nullptr;
     }
 
+    /// \brief Specialization for bool properties, which are stored as bits.
+    template <>
+    inline size_t
+    PropertyArray<bool>::memory() const
+    {
+        return (data_.capacity() + 7) / 8;
+    }
+
 
 
     //== CLASS DEFINITION =========================================================
@@ -406,7 +514,7 @@ namespace easy3d {
         const std::vector<T>& vector() const
         {
             assert(parray_ != nullptr);
-            return parray_->vector();
+            return static_cast<const PropertyArray<T>*>(parray_)->vector();
         }
 
         /**
@@ -775,6 +883,28 @@ namespace easy3d {
             ++size_;
         }
 
+        /**
+         * \brief Adds n new elements to each vector.
+         * \details Different from calling push_back() n times, the arrays are resized once each. If they have to
+         *      grow beyond their capacity, all of them reserve memory for (at least) twice the current size, so a
+         *      sequence of appends (e.g., when streaming the data in chunks) reallocates the storage only a
+         *      logarithmic number of times.
+         * \param n The number of elements to add.
+         * \return The index of the first new element, i.e., the new elements are [returned value, size()).
+         */
+        size_t append(size_t n)
+        {
+            const size_t first = size_;
+            const size_t required = size_ + n;
+            for(auto pa : parrays_) {
+                if (pa->capacity() < required)
+                    pa->reserve(std::max(required, 2 * size_));
+                pa->append(n);
+            }
+            size_ = required;
+            return first;
+        }
+
         /**
          * \brief Resets an element to its default property values.
          * \param idx The index of the element to reset.
@@ -815,6 +945,31 @@ namespace easy3d {
                 pa->copy(from, to);
         }
 
+        /**
+         * \brief Returns the memory (in bytes) allocated by all the arrays.
+         */
+        size_t memory() const
+        {
+            size_t bytes = 0;
+            for(auto pa : parrays_)
+                bytes += pa->memory();
+            return bytes;
+        }
+
+        /**
+         * \brief Prints the allocation statistics of each array, i.e., its name, size, capacity, allocated memory,
+         *      and the number of (re)allocations.
+         * \param output The output stream.
+         */
+        void print_statistics(std::ostream& output) const
+        {
+            for(auto pa : parrays_) {
+                output << "\t" << pa->name() << ": " << pa->size() << "/" << pa->capacity() << " elements, "
+                       << static_cast<double>(pa->memory()) / (1 << 20) << " MB, "
+                       << pa->reallocations() << " allocations" << std::endl;
+            }
+        }
+
         /**
          * \brief Returns the vector of property arrays (read-only).
          * \return The vector of property arrays.
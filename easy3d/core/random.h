@@ -28,6 +28,8 @@
 #define EASY3D_CORE_RANDOM_H
 
 #include <random>
+#include <array>
+#include <cstdint>
 
 #include <easy3d/core/types.h>
 
@@ -56,6 +58,61 @@ namespace easy3d {
         );
     }
 
+    /**
+     * \brief A counter-based random number generator (Philox4x32-10, by Salmon et al., SC'11).
+     * \details Different from the usual generators that update a state sequentially, each output is a function of
+     *      a key (i.e., the seed) and a counter (e.g., the index of an element). So the random numbers of an element
+     *      do not depend on the order in which the elements are processed, and parallel algorithms give exactly the
+     *      same results no matter how many threads are used.
+     *      Example usage:
+     *      \code
+     *          const CounterRandom rng(seed);
+     *          parallel_for(std::size_t(0), n, [&](std::size_t i) {
+     *              const CounterRandom::Block r = rng(i);  // four random 32-bit integers for the i-th element
+     *              const float u = CounterRandom::to_float(r[0]);
+     *              ...
+     *          });
+     *      \endcode
+     * \class CounterRandom easy3d/core/random.h
+     */
+    class CounterRandom {
+    public:
+        /// \brief The four 32-bit random integers generated for a counter.
+        typedef std::array<uint32_t, 4> Block;
+
+        /// \brief Constructs a generator with the \p seed as the key.
+        explicit CounterRandom(uint64_t seed)
+                : key0_(static_cast<uint32_t>(seed)), key1_(static_cast<uint32_t>(seed >> 32)) {}
+
+        /**
+         * \brief Generates the random integers for a counter.
+         * \param counter The counter, e.g., the index of an element.
+         * \param stream An additional counter, e.g., the iteration, to get more random integers for the same element.
+         */
+        Block operator()(uint64_t counter, uint64_t stream = 0) const {
+            Block c = {static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32),
+                       static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32)};
+            uint32_t k0 = key0_, k1 = key1_;
+            for (int round = 0; round < 10; ++round) {
+                const uint64_t p0 = static_cast<uint64_t>(0xD2511F53u) * c[0];
+                const uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57u) * c[2];
+                c = {static_cast<uint32_t>(p1 >> 32) ^ c[1] ^ k0, static_cast<uint32_t>(p1),
+                     static_cast<uint32_t>(p0 >> 32) ^ c[3] ^ k1, static_cast<uint32_t>(p0)};
+                k0 += 0x9E3779B9u;
+                k1 += 0xBB67AE85u;
+            }
+            return c;
+        }
+
+        /// \brief Converts a random integer into a uniformly distributed float in (0, 1] (i.e., never zero).
+        static float to_float(uint32_t x) {
+            return static_cast<float>((x >> 8) + 1u) * (1.0f / 16777216.0f);
+        }
+
+    private:
+        uint32_t key0_, key1_;
+    };
+
 }
 
 
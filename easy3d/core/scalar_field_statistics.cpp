@@ -0,0 +1,94 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#include <easy3d/core/scalar_field_statistics.h>
+
+#include <list>
+
+
+namespace easy3d {
+
+    const std::size_t ScalarFieldStatistics::num_bins;
+
+
+    namespace internal {
+
+        struct StatisticsEntry {
+            std::size_t id;
+            std::size_t revision;
+            std::size_t size;
+            std::size_t fingerprint;
+            std::shared_ptr<const ScalarFieldStatistics> statistics;
+        };
+
+        // The most recently used entries are at the front. The entries of deleted property arrays are evicted
+        // eventually (their identifiers are never reused).
+        static std::list<StatisticsEntry> statistics_cache;
+        static std::mutex statistics_cache_mutex;
+        static const std::size_t statistics_cache_capacity = 32;
+    }
+
+
+    std::shared_ptr<const ScalarFieldStatistics>
+    ScalarFieldStatistics::find(const BasePropertyArray &field, std::size_t size, std::size_t fingerprint) {
+        std::lock_guard<std::mutex> lock(internal::statistics_cache_mutex);
+        auto &cache = internal::statistics_cache;
+        for (auto pos = cache.begin(); pos != cache.end(); ++pos) {
+            if (pos->id != field.id())
+                continue;
+            if (pos->revision == field.revision() && pos->size == size && pos->fingerprint == fingerprint) {
+                cache.splice(cache.begin(), cache, pos);
+                return pos->statistics;
+            }
+            cache.erase(pos);   // outdated
+            break;
+        }
+        return nullptr;
+    }
+
+
+    void ScalarFieldStatistics::insert(const BasePropertyArray &field, std::size_t size, std::size_t fingerprint,
+                                       const std::shared_ptr<const ScalarFieldStatistics> &statistics) {
+        std::lock_guard<std::mutex> lock(internal::statistics_cache_mutex);
+        auto &cache = internal::statistics_cache;
+        for (auto pos = cache.begin(); pos != cache.end(); ++pos) {
+            if (pos->id == field.id()) {
+                cache.erase(pos);
+                break;
+            }
+        }
+        cache.push_front({field.id(), field.revision(), size, fingerprint, statistics});
+        if (cache.size() > internal::statistics_cache_capacity)
+            cache.pop_back();
+    }
+
+
+    void ScalarFieldStatistics::clear_cache() {
+        std::lock_guard<std::mutex> lock(internal::statistics_cache_mutex);
+        internal::statistics_cache.clear();
+    }
+
+}
@@ -0,0 +1,307 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#ifndef EASY3D_CORE_SCALAR_FIELD_STATISTICS_H
+#define EASY3D_CORE_SCALAR_FIELD_STATISTICS_H
+
+#include <vector>
+#include <map>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <memory>
+#include <limits>
+#include <algorithm>
+
+#include <easy3d/core/property.h>
+#include <easy3d/util/thread_pool.h>
+
+
+namespace easy3d {
+
+    /**
+     * \brief Statistics (i.e., the range, mean, histogram, and percentiles) of a scalar field.
+     * \class ScalarFieldStatistics easy3d/core/scalar_field_statistics.h
+     * \details The statistics of a scalar field (i.e., a property of an arithmetic type, e.g., float, int, bool) are
+     *      computed in parallel in two linear passes over the values (one for the range and the mean, and one for
+     *      the histogram), and they are cached for each property array. A cached entry is reused as long as the
+     *      array has the same size and revision (see BasePropertyArray::revision()), and the same fingerprint, i.e.,
+     *      a hash of all its values (computed in parallel). So the modifications through the element access operator,
+     *      which do not change the revision, are also detected at the cost of a linear pass over the values per query.
+     *      A percentile is answered exactly from the histogram: only the values falling into the bin containing the
+     *      requested rank are collected and partially sorted (by std::nth_element).
+     *
+     *      Example usage:
+     *      \code
+     *          auto curvatures = mesh->get_vertex_property<float>("v:curv-mean");
+     *          auto stats = ScalarFieldStatistics::get(curvatures.array());
+     *          std::cout << "range: [" << stats->min_value() << ", " << stats->max_value() << "]" << std::endl;
+     *          const double median = ScalarFieldStatistics::percentile(curvatures.array(), 0.5f);
+     *      \endcode
+     * \note NaN values are excluded from the statistics.
+     */
+    class ScalarFieldStatistics {
+    public:
+        /// \brief The number of bins of the histogram.
+        static const std::size_t num_bins = 1024;
+
+        /**
+         * \brief Returns the statistics of a scalar field, which are computed if not cached yet.
+         * \details This function is thread-safe. The returned statistics remain valid even if the scalar field is
+         *      modified or deleted.
+         */
+        template<typename FT>
+        static std::shared_ptr<const ScalarFieldStatistics> get(const PropertyArray<FT> &field);
+
+        /**
+         * \brief Returns the value at the position \p p (in [0, 1]) of the sorted values of a scalar field.
+         * \details The value is the one at index floor((count() - 1) * p) of the sorted (non-NaN) values, which is
+         *      cached for later queries.
+         */
+        template<typename FT>
+        static double percentile(const PropertyArray<FT> &field, float p);
+
+        /// \brief Clears the cached statistics of all scalar fields.
+        static void clear_cache();
+
+    public:
+        /// \brief Returns the number of (non-NaN) values.
+        std::size_t count() const { return count_; }
+        /// \brief Returns the number of NaN values, which are excluded from the statistics.
+        std::size_t num_nan() const { return num_nan_; }
+        /// \brief Returns the minimum value.
+        double min_value() const { return min_value_; }
+        /// \brief Returns the maximum value.
+        double max_value() const { return max_value_; }
+        /// \brief Returns the mean of the values.
+        double mean() const { return mean_; }
+
+        /**
+         * \brief Returns the histogram, i.e., the number of values in each of the num_bins bins evenly dividing the
+         *      range [min_value(), max_value()].
+         */
+        const std::vector<std::size_t> &histogram() const { return histogram_; }
+        /// \brief Returns the bin of the histogram containing the value \p v.
+        std::size_t bin(double v) const {
+            return std::min<std::size_t>(num_bins - 1, static_cast<std::size_t>((v - min_value_) * bin_scale_));
+        }
+
+        /**
+         * \brief Returns the value at index \p rank of the sorted values of the scalar field \p field, which must be
+         *      the one these statistics were computed from.
+         */
+        template<typename FT>
+        double value_at_rank(const PropertyArray<FT> &field, std::size_t rank) const;
+
+    private:
+        ScalarFieldStatistics() : count_(0), num_nan_(0), min_value_(0), max_value_(0), mean_(0), bin_scale_(0) {}
+
+        template<typename FT>
+        static std::size_t fingerprint(const std::vector<FT> &values);
+
+        // the cache (it keeps the statistics of the recently used scalar fields)
+        static std::shared_ptr<const ScalarFieldStatistics> find(const BasePropertyArray &field, std::size_t size,
+                                                                 std::size_t fingerprint);
+        static void insert(const BasePropertyArray &field, std::size_t size, std::size_t fingerprint,
+                           const std::shared_ptr<const ScalarFieldStatistics> &statistics);
+
+    private:
+        std::size_t count_;
+        std::size_t num_nan_;
+        double min_value_;
+        double max_value_;
+        double mean_;
+        double bin_scale_;
+        std::vector<std::size_t> histogram_;
+
+        mutable std::mutex mutex_;
+        mutable std::map<std::size_t, double> ranks_;   // the values at the queried ranks
+    };
+
+
+    template<typename FT>
+    std::size_t ScalarFieldStatistics::fingerprint(const std::vector<FT> &values) {
+        // every value is hashed together with its index. The hashes are summed, so the chunks can be hashed in
+        // parallel and combined in any order.
+        auto mix = [](std::uint64_t x) {    // the finalizer of SplitMix64
+            x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+            return x ^ (x >> 31);
+        };
+        const std::uint64_t sum = parallel_reduce(std::size_t(0), values.size(), std::uint64_t(0),
+            [&values, &mix](std::size_t first, std::size_t last) {
+                std::uint64_t s = 0;
+                for (std::size_t i = first; i < last; ++i) {
+                    const double v = static_cast<double>(values[i]);
+                    std::uint64_t bits;
+                    std::memcpy(&bits, &v, sizeof(bits));
+                    s += mix(bits ^ mix(i + 0x9e3779b97f4a7c15ULL));
+                }
+                return s;
+            },
+            [](std::uint64_t a, std::uint64_t b) { return a + b; }
+        );
+        return static_cast<std::size_t>(sum ^ mix(values.size()));
+    }
+
+
+    template<typename FT>
+    std::shared_ptr<const ScalarFieldStatistics> ScalarFieldStatistics::get(const PropertyArray<FT> &field) {
+        const std::vector<FT> &values = field.vector();
+        const std::size_t n = values.size();
+        const std::size_t key = fingerprint(values);
+        auto cached = find(field, n, key);
+        if (cached)
+            return cached;
+
+        std::shared_ptr<ScalarFieldStatistics> stats(new ScalarFieldStatistics);
+
+        // the range and the mean
+        struct Range {
+            std::size_t count, num_nan;
+            double min_value, max_value, sum;
+        };
+        const Range identity = {0, 0, std::numeric_limits<double>::max(), -std::numeric_limits<double>::max(), 0.0};
+        const Range range = parallel_reduce(std::size_t(0), n, identity,
+            [&values](std::size_t first, std::size_t last) {
+                Range r = {0, 0, std::numeric_limits<double>::max(), -std::numeric_limits<double>::max(), 0.0};
+                for (std::size_t i = first; i < last; ++i) {
+                    const double v = static_cast<double>(values[i]);
+                    if (v != v) {   // NaN
+                        ++r.num_nan;
+                        continue;
+                    }
+                    ++r.count;
+                    r.min_value = std::min(r.min_value, v);
+                    r.max_value = std::max(r.max_value, v);
+                    r.sum += v;
+                }
+                return r;
+            },
+            [](const Range &a, const Range &b) {
+                return Range{a.count + b.count, a.num_nan + b.num_nan, std::min(a.min_value, b.min_value),
+                             std::max(a.max_value, b.max_value), a.sum + b.sum};
+            }
+        );
+        stats->count_ = range.count;
+        stats->num_nan_ = range.num_nan;
+        if (range.count > 0) {
+            stats->min_value_ = range.min_value;
+            stats->max_value_ = range.max_value;
+            stats->mean_ = range.sum / static_cast<double>(range.count);
+        }
+        if (stats->max_value_ > stats->min_value_)
+            stats->bin_scale_ = static_cast<double>(num_bins) / (stats->max_value_ - stats->min_value_);
+
+        // the histogram
+        const ScalarFieldStatistics *s = stats.get();
+        stats->histogram_ = parallel_reduce(std::size_t(0), n, std::vector<std::size_t>(num_bins, 0),
+            [&values, s](std::size_t first, std::size_t last) {
+                std::vector<std::size_t> h(num_bins, 0);
+                for (std::size_t i = first; i < last; ++i) {
+                    const double v = static_cast<double>(values[i]);
+                    if (v == v)     // not NaN
+                        ++h[s->bin(v)];
+                }
+                return h;
+            },
+            [](const std::vector<std::size_t> &a, const std::vector<std::size_t> &b) {
+                std::vector<std::size_t> h(a);
+                for (std::size_t i = 0; i < num_bins; ++i)
+                    h[i] += b[i];
+                return h;
+            }
+        );
+
+        insert(field, n, key, stats);
+        return stats;
+    }
+
+
+    template<typename FT>
+    double ScalarFieldStatistics::value_at_rank(const PropertyArray<FT> &field, std::size_t rank) const {
+        if (count_ == 0)
+            return 0.0;
+        rank = std::min(rank, count_ - 1);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto pos = ranks_.find(rank);
+            if (pos != ranks_.end())
+                return pos->second;
+        }
+
+        // the bin containing the rank
+        std::size_t b = 0, before = 0;
+        while (before + histogram_[b] <= rank)
+            before += histogram_[b++];
+
+        // the values in this bin
+        const std::vector<FT> &values = field.vector();
+        std::vector<double> candidates = parallel_reduce(std::size_t(0), values.size(), std::vector<double>(),
+            [&values, b, this](std::size_t first, std::size_t last) {
+                std::vector<double> c;
+                for (std::size_t i = first; i < last; ++i) {
+                    const double v = static_cast<double>(values[i]);
+                    if (v == v && bin(v) == b)
+                        c.push_back(v);
+                }
+                return c;
+            },
+            [](const std::vector<double> &a, const std::vector<double> &c) {
+                std::vector<double> r(a);
+                r.insert(r.end(), c.begin(), c.end());
+                return r;
+            }
+        );
+        if (candidates.size() != histogram_[b]) {
+            LOG(ERROR) << "the scalar field differs from the one the statistics were computed from";
+            if (candidates.empty())
+                return min_value_;
+        }
+
+        const std::size_t k = std::min(rank - before, candidates.size() - 1);
+        std::nth_element(candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(k), candidates.end());
+        const double value = candidates[k];
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        ranks_[rank] = value;
+        return value;
+    }
+
+
+    template<typename FT>
+    double ScalarFieldStatistics::percentile(const PropertyArray<FT> &field, float p) {
+        auto stats = get(field);
+        if (stats->count() == 0)
+            return 0.0;
+        const std::size_t n = stats->count() - 1;
+        return stats->value_at_rank(field, static_cast<std::size_t>(n * p));
+    }
+
+} // namespace easy3d
+
+
+#endif  // EASY3D_CORE_SCALAR_FIELD_STATISTICS_H
@@ -24,6 +24,7 @@
 
 #include <easy3d/core/surface_mesh.h>
 #include <easy3d/util/logging.h>
+#include <easy3d/util/thread_pool.h>
 
 #include <cmath>
 #include <fstream>
@@ -56,6 +57,8 @@ namespace easy3d {
     {
         if (this != &rhs)
         {
+            touch_topology();
+
             // deep copy of property containers
             vprops_ = rhs.vprops_;
             hprops_ = rhs.hprops_;
@@ -150,6 +153,8 @@ namespace easy3d {
     {
         if (this != &rhs)
         {
+            touch_topology();
+
             // clear properties
             vprops_.clear();
             hprops_.clear();
@@ -301,6 +306,8 @@ namespace easy3d {
 
     void SurfaceMesh::clear()
     {
+        touch_topology();
+
         //---- clear without removing properties
 
         vprops_.resize(0);
@@ -363,36 +370,28 @@ namespace easy3d {
                 output << "\t" << p << std::endl;
         }
 
-		props = vertex_properties();
-		if (!props.empty())
+		if (vprops_.n_properties() > 0)
 		{
             output << "vertex properties:\n";
-			for (const auto& p : props)
-                output << "\t" << p << std::endl;
+			vprops_.print_statistics(output);
 		}
 
-		props = halfedge_properties();
-		if (!props.empty())
+		if (hprops_.n_properties() > 0)
 		{
             output << "halfedge properties:\n";
-            for (const auto& p : props)
-                output << "\t" << p << std::endl;
+            hprops_.print_statistics(output);
 		}
 
-		props = edge_properties();
-		if (!props.empty())
+		if (eprops_.n_properties() > 0)
 		{
-            output<< "edge properties:\n";
-            for (const auto& p : props)
-                output << "\t" << p << std::endl;
+            output << "edge properties:\n";
+            eprops_.print_statistics(output);
 		}
 
-		props = face_properties();
-		if (!props.empty())
+		if (fprops_.n_properties() > 0)
 		{
             output << "face properties:\n";
-            for (const auto& p : props)
-                output << "\t" << p << std::endl;
+            fprops_.print_statistics(output);
 		}
 
 		props = model_properties();
@@ -443,6 +442,8 @@ namespace easy3d {
     //-----------------------------------------------------------------------------
 
     void SurfaceMesh::adjust_outgoing_halfedges() {
+        touch_topology();
+
         // We need to take care of isolated vertices
         auto reachable = add_vertex_property<bool>("v:temp:reachable", false);
 
@@ -466,6 +467,8 @@ namespace easy3d {
 
     void SurfaceMesh::adjust_outgoing_halfedge(Vertex v)
     {
+        touch_topology();
+
         Halfedge h  = out_halfedge(v);
         const Halfedge hh = h;
 
@@ -921,6 +924,8 @@ namespace easy3d {
 
 
     void SurfaceMesh::reverse_orientation() {
+        touch_topology();
+
         auto reverse_orientation = [](SurfaceMesh::Halfedge first, SurfaceMesh &mesh) -> void {
             if (first == SurfaceMesh::Halfedge())
                 return;
@@ -962,6 +967,8 @@ namespace easy3d {
 
     void SurfaceMesh::triangulate(Face f)
     {
+        touch_topology();
+
         /*
          Split an arbitrary face into triangles by connecting
          each vertex of fh after its second to vh.
@@ -1008,24 +1015,34 @@ namespace easy3d {
     //-----------------------------------------------------------------------------
 
 
-    void SurfaceMesh::update_face_normals()
+    void SurfaceMesh::update_face_normals(bool lazy)
     {
         if (!fnormal_)
             fnormal_ = face_property<vec3>("f:normal");
+        else if (lazy && is_up_to_date("f:normal", &fnormal_.array()))
+            return;
 
-        FaceIterator fit, fend=faces_end();
-
-        int num_degenerate = 0;
-        for (fit=faces_begin(); fit!=fend; ++fit) {
-            if (is_degenerate(*fit)) {
-                ++num_degenerate;
-                fnormal_[*fit] = vec3(0, 0, 1);
-            } else
-                fnormal_[*fit] = compute_face_normal(*fit);
-        }
+        // the faces are independent: compute their normals in parallel
+        const int num_degenerate = parallel_reduce(0, static_cast<int>(faces_size()), 0, [this](int b, int e) {
+            int count = 0;
+            for (int i = b; i < e; ++i) {
+                const Face f(i);
+                if (is_deleted(f))
+                    continue;
+                if (is_degenerate(f)) {
+                    ++count;
+                    fnormal_[f] = vec3(0, 0, 1);
+                } else
+                    fnormal_[f] = compute_face_normal(f);
+            }
+            return count;
+        }, std::plus<int>());
 
         if (num_degenerate > 0)
             LOG(WARNING) << "model has " << num_degenerate << " degenerate faces";
+
+        fnormal_.array().touch();
+        mark_up_to_date("f:normal", &fnormal_.array());
     }
 
 
@@ -1090,19 +1107,26 @@ namespace easy3d {
     //-----------------------------------------------------------------------------
 
 
-    void SurfaceMesh::update_vertex_normals()
+    void SurfaceMesh::update_vertex_normals(bool lazy)
     {
         if (!vnormal_)
             vnormal_ = vertex_property<vec3>("v:normal");
+        else if (lazy && is_up_to_date("v:normal", &vnormal_.array()))
+            return;
 
         // compute face normals if needed.
         // Note: this is not needed if you compute the face normal on the fly using cross product of two
         //       incident edges of a face (but the "cross product" approach is not stable for concave polygons)
-        if (!fnormal_)
-            update_face_normals();
+        update_face_normals(true);
+
+        parallel_for(0, static_cast<int>(vertices_size()), [this](int i) {
+            const Vertex v(i);
+            if (!is_deleted(v))
+                vnormal_[v] = compute_vertex_normal(v);
+        });
 
-        for (VertexIterator vit=vertices_begin(), vend = vertices_end(); vit!=vend; ++vit)
-            vnormal_[*vit] = compute_vertex_normal(*vit);
+        vnormal_.array().touch();
+        mark_up_to_date("v:normal", &vnormal_.array());
     }
 
 
@@ -1185,6 +1209,8 @@ namespace easy3d {
 
     void SurfaceMesh::split(Face f, Vertex v)
     {
+        touch_topology();
+
         /*
          Split an arbitrary face into triangles by connecting each vertex of fh to vh.
          - fh will remain valid (it will become one of the triangles)
@@ -1237,6 +1263,8 @@ namespace easy3d {
 
     SurfaceMesh::Halfedge SurfaceMesh::split(Edge e, Vertex v)
     {
+        touch_topology();
+
         Halfedge h0 = halfedge(e, 0);
         Halfedge o0 = halfedge(e, 1);
 
@@ -1338,6 +1366,8 @@ namespace easy3d {
 
     SurfaceMesh::Halfedge SurfaceMesh::insert_vertex(Halfedge h0, Vertex v)
     {
+        touch_topology();
+
         // before:
         //
         // v0      h0       v2
@@ -1393,6 +1423,8 @@ namespace easy3d {
 
     SurfaceMesh::Halfedge SurfaceMesh::insert_edge(Halfedge h0, Halfedge h1)
     {
+        touch_topology();
+
         assert(face(h0) == face(h1));
         assert(face(h0).is_valid());
 
@@ -1460,6 +1492,8 @@ namespace easy3d {
 
     void SurfaceMesh::flip(Edge e)
     {
+        touch_topology();
+
         // CAUTION : Flipping a halfedge may result in
         // a non-manifold mesh, hence check for yourself
         // whether this operation is allowed or not!
@@ -1596,6 +1630,8 @@ namespace easy3d {
 
 
     void SurfaceMesh::stitch(Halfedge h0, Halfedge h1) {
+        touch_topology();
+
         // CAUTION : Stitching two halfedges may result in a non-manifold mesh, hence check for yourself
         // whether this operation is allowed or not!
 
@@ -1767,6 +1803,8 @@ namespace easy3d {
 
     void SurfaceMesh::collapse(Halfedge h)
     {
+        touch_topology();
+
         //let's make it sure it is actually checked
         assert(is_collapse_ok(h));
 
@@ -1791,6 +1829,8 @@ namespace easy3d {
 
     void SurfaceMesh::remove_edge(Halfedge h)
     {
+        touch_topology();
+
         Halfedge  hn = next(h);
         Halfedge  hp = prev(h);
 
@@ -1846,6 +1886,8 @@ namespace easy3d {
 
     void SurfaceMesh::remove_loop(Halfedge h)
     {
+        touch_topology();
+
         Halfedge  h0 = h;
         Halfedge  h1 = next(h0);
 
@@ -1899,6 +1941,8 @@ namespace easy3d {
     {
         if (vdeleted_[v])  return;
 
+        touch_topology();
+
         // collect incident faces
         std::vector<Face> incident_faces;
         incident_faces.reserve(6);
@@ -1947,6 +1991,8 @@ namespace easy3d {
     {
         if (fdeleted_[f])  return;
 
+        touch_topology();
+
         // mark face deleted
         if (!fdeleted_[f])
         {
@@ -2062,6 +2108,8 @@ namespace easy3d {
         if (!garbage_)
             return;
 
+        touch_topology();
+
         int  i, i0, i1,
         nV(static_cast<int>(vertices_size())),
         nE(static_cast<int>(edges_size())),
@@ -2289,6 +2337,8 @@ namespace easy3d {
             return false;
         }
 
+        touch_topology();
+
         auto hh = out_halfedge(vt);
         remove_edge(hh);
         return true;
@@ -1470,6 +1470,7 @@ namespace easy3d {
         /// associated properties.
         /// Note: ne is the number of edges. for halfedges, nh = 2 * ne. */
         void resize(unsigned int nv, unsigned int ne, unsigned int nf) {
+            touch_topology();
             vprops_.resize(nv);
             hprops_.resize(2 * ne);
             eprops_.resize(ne);
@@ -1529,6 +1530,8 @@ namespace easy3d {
     public: //---------------------------------------------- low-level connectivity
 
         /// \name Low-level connectivity
+        /// The setters do not increment the topology revision (they are called many times by each topological
+        /// operation, which increments it once). Call touch_topology() after modifying the connectivity with them.
         //@{
 
         /// returns an outgoing halfedge of vertex \c v.
@@ -2476,8 +2479,13 @@ namespace easy3d {
          */
         std::vector<vec3>& points() override { return vpoint_.vector(); }
 
-        /// compute face normals by calling compute_face_normal(Face) for each face.
-        void update_face_normals();
+        /**
+         * \brief Computes face normals by calling compute_face_normal(Face) for each face.
+         * \param lazy If \c true, the face normals are recomputed only if they are outdated, i.e., the geometry
+         *      has changed (see Model::geometry_revision()) or the "f:normal" property has been modified since they
+         *      were last computed. Otherwise (default), they are always recomputed.
+         */
+        void update_face_normals(bool lazy = false);
 
         /**
          * \brief Computes the normal vector of face \c f. This method is robust for concave and general polygonal faces.
@@ -2486,8 +2494,13 @@ namespace easy3d {
          */
         vec3 compute_face_normal(Face f) const;
 
-        /// compute vertex normals by calling compute_vertex_normal(Vertex) for each vertex.
-        void update_vertex_normals();
+        /**
+         * \brief Computes vertex normals by calling compute_vertex_normal(Vertex) for each vertex.
+         * \param lazy If \c true, the vertex normals are recomputed only if they are outdated (see
+         *      update_face_normals()). Otherwise (default), they are always recomputed.
+         * \note The face normals are updated lazily, i.e., only if they are outdated.
+         */
+        void update_vertex_normals(bool lazy = false);
 
         /// compute normal vector of vertex \c v. This is the angle-weighted average of incident face normals.
         /// @note The per-face normals much have been computed.
@@ -2507,6 +2520,7 @@ namespace easy3d {
         Vertex new_vertex()
         {
             vprops_.push_back();
+            touch_topology();
             return Vertex(static_cast<int>(vertices_size()-1));
         }
 
@@ -2532,6 +2546,7 @@ namespace easy3d {
         Face new_face()
         {
             fprops_.push_back();
+            touch_topology();
             return Face(static_cast<int>(faces_size()-1));
         }
 
@@ -2595,6 +2610,7 @@ namespace easy3d {
         NextCache                add_face_next_cache_;
 
 		friend class SurfaceMeshBuilder;
+        friend class BinaryContainer;
     };
 
 
@@ -469,6 +469,8 @@ namespace easy3d {
         // for each umbrella
         for (auto h : non_manifold_cones)
             resolve_non_manifold_vertex(h, mesh, copy_record);
+        if (!non_manifold_cones.empty())
+            mesh->touch_topology();  // the connectivity has been modified by the low-level setters
 
 #if 0    // This is the history how vertices were duplicate.
         for (const auto& copy : dmap) {
@@ -0,0 +1,1004 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#include <easy3d/fileio/binary_container.h>
+
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include <easy3d/core/point_cloud.h>
+#include <easy3d/core/surface_mesh.h>
+#include <easy3d/core/graph.h>
+#include <easy3d/core/poly_mesh.h>
+#include <easy3d/util/logging.h>
+
+
+namespace easy3d {
+
+    namespace internal {
+
+        //------------------------------------------------------------ LZ4 (block format)
+
+        inline std::size_t lz4_bound(std::size_t n) { return n + n / 255 + 16; }
+
+        inline uint32_t lz4_read32(const unsigned char *p) {
+            uint32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        inline void lz4_write_length(unsigned char *&op, std::size_t len) {
+            for (; len >= 255; len -= 255)
+                *op++ = 255;
+            *op++ = static_cast<unsigned char>(len);
+        }
+
+        // Greedy LZ4 compression with a single hash probe. Returns the compressed size. The destination must have at
+        // least lz4_bound(n) bytes.
+        std::size_t lz4_compress(const char *source, std::size_t n, char *dest) {
+            const unsigned char *src = reinterpret_cast<const unsigned char *>(source);
+            unsigned char *op = reinterpret_cast<unsigned char *>(dest);
+
+            const int hash_bits = 16;
+            std::vector<std::size_t> table(std::size_t(1) << hash_bits, std::size_t(-1));
+            std::size_t anchor = 0, i = 0;
+            // the last match must start at least 12 bytes before the end, and the last 5 bytes are literals
+            const std::size_t match_limit = n > 12 ? n - 12 : 0;
+            while (i < match_limit) {
+                const uint32_t seq = lz4_read32(src + i);
+                const std::size_t h = (seq * 2654435761u) >> (32 - hash_bits);
+                const std::size_t ref = table[h];
+                table[h] = i;
+                if (ref == std::size_t(-1) || i - ref > 65535 || lz4_read32(src + ref) != seq) {
+                    ++i;
+                    continue;
+                }
+
+                std::size_t len = 4;
+                while (i + len < n - 5 && src[ref + len] == src[i + len])
+                    ++len;
+
+                const std::size_t num_literals = i - anchor;
+                unsigned char *token = op++;
+                *token = static_cast<unsigned char>((std::min<std::size_t>(num_literals, 15) << 4) |
+                                                    std::min<std::size_t>(len - 4, 15));
+                if (num_literals >= 15)
+                    lz4_write_length(op, num_literals - 15);
+                std::memcpy(op, src + anchor, num_literals);
+                op += num_literals;
+                const std::size_t offset = i - ref;
+                *op++ = static_cast<unsigned char>(offset & 0xff);
+                *op++ = static_cast<unsigned char>(offset >> 8);
+                if (len - 4 >= 15)
+                    lz4_write_length(op, len - 4 - 15);
+
+                i += len;
+                anchor = i;
+            }
+
+            // the last literals
+            const std::size_t num_literals = n - anchor;
+            *op++ = static_cast<unsigned char>(std::min<std::size_t>(num_literals, 15) << 4);
+            if (num_literals >= 15)
+                lz4_write_length(op, num_literals - 15);
+            std::memcpy(op, src + anchor, num_literals);
+            op += num_literals;
+            return static_cast<std::size_t>(op - reinterpret_cast<unsigned char *>(dest));
+        }
+
+        // Decompresses an LZ4 block of size n into dest, which must result in exactly dest_size bytes.
+        bool lz4_decompress(const char *source, std::size_t n, char *dest, std::size_t dest_size) {
+            const unsigned char *ip = reinterpret_cast<const unsigned char *>(source);
+            const unsigned char *const iend = ip + n;
+            unsigned char *const ostart = reinterpret_cast<unsigned char *>(dest);
+            unsigned char *op = ostart;
+            unsigned char *const oend = op + dest_size;
+
+            while (ip < iend) {
+                const unsigned int token = *ip++;
+                std::size_t num_literals = token >> 4;
+                if (num_literals == 15) {
+                    unsigned int b;
+                    do {
+                        if (ip >= iend) return false;
+                        b = *ip++;
+                        num_literals += b;
+                    } while (b == 255);
+                }
+                if (num_literals > static_cast<std::size_t>(iend - ip) ||
+                    num_literals > static_cast<std::size_t>(oend - op))
+                    return false;
+                std::memcpy(op, ip, num_literals);
+                op += num_literals;
+                ip += num_literals;
+                if (ip == iend)  // the last sequence has no match
+                    break;
+
+                if (iend - ip < 2) return false;
+                const std::size_t offset = ip[0] | (static_cast<std::size_t>(ip[1]) << 8);
+                ip += 2;
+                if (offset == 0 || offset > static_cast<std::size_t>(op - ostart))
+                    return false;
+                std::size_t len = (token & 15);
+                if (len == 15) {
+                    unsigned int b;
+                    do {
+                        if (ip >= iend) return false;
+                        b = *ip++;
+                        len += b;
+                    } while (b == 255);
+                }
+                len += 4;
+                if (len > static_cast<std::size_t>(oend - op))
+                    return false;
+                const unsigned char *match = op - offset;
+                for (std::size_t k = 0; k < len; ++k)  // byte by byte, as the match may overlap the output
+                    op[k] = match[k];
+                op += len;
+            }
+            return op == oend;
+        }
+
+
+        //------------------------------------------------------------ memory-mapped file
+
+        class MappedFile {
+        public:
+            explicit MappedFile(const std::string &file_name) : data_(nullptr), size_(0) {
+#ifdef _WIN32
+                file_ = CreateFileA(file_name.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+                mapping_ = nullptr;
+                if (file_ == INVALID_HANDLE_VALUE)
+                    return;
+                LARGE_INTEGER size;
+                if (!GetFileSizeEx(file_, &size) || size.QuadPart == 0)
+                    return;
+                mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (!mapping_)
+                    return;
+                data_ = static_cast<const char *>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+                if (data_)
+                    size_ = static_cast<std::size_t>(size.QuadPart);
+#else
+                fd_ = open(file_name.c_str(), O_RDONLY);
+                if (fd_ < 0)
+                    return;
+                struct stat st;
+                if (fstat(fd_, &st) != 0 || st.st_size == 0)
+                    return;
+                void *addr = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd_, 0);
+                if (addr == MAP_FAILED)
+                    return;
+                data_ = static_cast<const char *>(addr);
+                size_ = static_cast<std::size_t>(st.st_size);
+                madvise(addr, size_, MADV_SEQUENTIAL);
+#endif
+            }
+
+            ~MappedFile() {
+#ifdef _WIN32
+                if (data_) UnmapViewOfFile(data_);
+                if (mapping_) CloseHandle(mapping_);
+                if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+#else
+                if (data_) munmap(const_cast<char *>(data_), size_);
+                if (fd_ >= 0) close(fd_);
+#endif
+            }
+
+            const char *data() const { return data_; }
+            std::size_t size() const { return size_; }
+
+        private:
+            const char *data_;
+            std::size_t size_;
+#ifdef _WIN32
+            HANDLE file_;
+            HANDLE mapping_;
+#else
+            int fd_;
+#endif
+        };
+
+
+        //------------------------------------------------------------ encoding of variable-size values
+
+        class Writer {
+        public:
+            explicit Writer(std::vector<char> &buffer) : buffer_(buffer) {}
+            template<typename T>
+            void put(const T &v) {
+                const char *p = reinterpret_cast<const char *>(&v);
+                buffer_.insert(buffer_.end(), p, p + sizeof(T));
+            }
+            void put(const std::string &s) {
+                put(static_cast<uint64_t>(s.size()));
+                buffer_.insert(buffer_.end(), s.begin(), s.end());
+            }
+            void put(const std::vector<char> &s) {
+                put(static_cast<uint64_t>(s.size()));
+                buffer_.insert(buffer_.end(), s.begin(), s.end());
+            }
+            // a container of handles
+            template<typename Handles>
+            void put_handles(const Handles &handles) {
+                put(static_cast<uint32_t>(handles.size()));
+                for (const auto &h : handles)
+                    put(static_cast<int32_t>(h.idx()));
+            }
+        private:
+            std::vector<char> &buffer_;
+        };
+
+        class Reader {
+        public:
+            Reader(const char *data, std::size_t size) : ptr_(data), end_(data + size), ok_(true) {}
+            template<typename T>
+            T get() {
+                T v = T();
+                if (static_cast<std::size_t>(end_ - ptr_) < sizeof(T)) {
+                    ok_ = false;
+                    ptr_ = end_;
+                    return v;
+                }
+                std::memcpy(&v, ptr_, sizeof(T));
+                ptr_ += sizeof(T);
+                return v;
+            }
+            std::string get_string() {
+                const auto n = get<uint64_t>();
+                if (!ok_ || static_cast<uint64_t>(end_ - ptr_) < n) {
+                    ok_ = false;
+                    return std::string();
+                }
+                std::string s(ptr_, static_cast<std::size_t>(n));
+                ptr_ += n;
+                return s;
+            }
+            std::vector<char> get_bytes() {
+                const std::string s = get_string();
+                return std::vector<char>(s.begin(), s.end());
+            }
+            template<typename Handle>
+            void get_handles(std::vector<Handle> &handles) {
+                const auto n = get<uint32_t>();
+                if (!ok_ || static_cast<std::size_t>(end_ - ptr_) / sizeof(int32_t) < n) {
+                    ok_ = false;
+                    return;
+                }
+                handles.resize(n);
+                for (auto &h : handles)
+                    h = Handle(get<int32_t>());
+            }
+            bool ok() const { return ok_; }
+            bool at_end() const { return ptr_ == end_; }
+        private:
+            const char *ptr_;
+            const char *end_;
+            bool ok_;
+        };
+
+
+        // the values of the connectivity types of Graph and PolyMesh are lists of handles
+
+        void encode_value(Writer &w, const std::string &v) { w.put(v); }
+        void decode_value(Reader &r, std::string &v) { v = r.get_string(); }
+
+        void encode_value(Writer &w, const Graph::VertexConnectivity &v) { w.put_handles(v.edges_); }
+        void decode_value(Reader &r, Graph::VertexConnectivity &v) { r.get_handles(v.edges_); }
+
+        void encode_value(Writer &w, const PolyMesh::VertexConnectivity &v) {
+            w.put_handles(v.vertices_);
+            w.put_handles(v.edges_);
+            w.put_handles(v.halffaces_);
+            w.put_handles(v.cells_);
+        }
+        void decode_value(Reader &r, PolyMesh::VertexConnectivity &v) {
+            r.get_handles(v.vertices_);
+            r.get_handles(v.edges_);
+            r.get_handles(v.halffaces_);
+            r.get_handles(v.cells_);
+        }
+
+        void encode_value(Writer &w, const PolyMesh::EdgeConnectivity &v) {
+            w.put_handles(v.vertices_);
+            w.put_handles(v.halffaces_);
+            w.put_handles(v.cells_);
+        }
+        void decode_value(Reader &r, PolyMesh::EdgeConnectivity &v) {
+            r.get_handles(v.vertices_);
+            r.get_handles(v.halffaces_);
+            r.get_handles(v.cells_);
+        }
+
+        void encode_value(Writer &w, const PolyMesh::HalfFaceConnectivity &v) {
+            w.put_handles(v.vertices_);
+            w.put_handles(v.edges_);
+            w.put(static_cast<int32_t>(v.cell_.idx()));
+            w.put(static_cast<int32_t>(v.opposite_.idx()));
+        }
+        void decode_value(Reader &r, PolyMesh::HalfFaceConnectivity &v) {
+            r.get_handles(v.vertices_);
+            r.get_handles(v.edges_);
+            v.cell_ = PolyMesh::Cell(r.get<int32_t>());
+            v.opposite_ = PolyMesh::HalfFace(r.get<int32_t>());
+        }
+
+        void encode_value(Writer &w, const PolyMesh::CellConnectivity &v) {
+            w.put_handles(v.vertices_);
+            w.put_handles(v.edges_);
+            w.put_handles(v.halffaces_);
+        }
+        void decode_value(Reader &r, PolyMesh::CellConnectivity &v) {
+            r.get_handles(v.vertices_);
+            r.get_handles(v.edges_);
+            r.get_handles(v.halffaces_);
+        }
+
+
+        // A codec for value types that are encoded element by element (using encode_value() and decode_value()).
+        template<typename T>
+        class VariableSizeCodec : public BinaryContainer::TypeCodec {
+        public:
+            const std::type_info &type() const override { return typeid(T); }
+            BasePropertyArray *create(const std::string &name, const std::vector<char> &) const override {
+                return new PropertyArray<T>(name);
+            }
+            void default_value(const BasePropertyArray *, std::vector<char> &value) const override { value.clear(); }
+            void encode(const BasePropertyArray *array, std::vector<char> &buffer, const char *&data,
+                        std::size_t &size) const override {
+                const auto &vec = dynamic_cast<const PropertyArray<T> *>(array)->vector();
+                buffer.clear();
+                Writer w(buffer);
+                for (const auto &v : vec)
+                    encode_value(w, v);
+                data = buffer.data();
+                size = buffer.size();
+            }
+            bool decode(BasePropertyArray *array, std::size_t n, const char *data, std::size_t size) const override {
+                auto &vec = dynamic_cast<PropertyArray<T> *>(array)->vector();
+                vec.resize(n);
+                Reader r(data, size);
+                for (auto &v : vec)
+                    decode_value(r, v);
+                return r.ok() && r.at_end();
+            }
+        };
+
+
+        // std::vector<bool> is not stored contiguously, so each value is stored in a byte.
+        class BoolCodec : public BinaryContainer::TypeCodec {
+        public:
+            const std::type_info &type() const override { return typeid(bool); }
+            BasePropertyArray *create(const std::string &name, const std::vector<char> &default_value) const override {
+                return new PropertyArray<bool>(name, default_value.size() == 1 && default_value[0] != 0);
+            }
+            void default_value(const BasePropertyArray *array, std::vector<char> &value) const override {
+                BasePropertyArray *tmp = array->empty_clone();
+                tmp->push_back();
+                value.assign(1, (*dynamic_cast<PropertyArray<bool> *>(tmp))[0] ? 1 : 0);
+                delete tmp;
+            }
+            void encode(const BasePropertyArray *array, std::vector<char> &buffer, const char *&data,
+                        std::size_t &size) const override {
+                const auto &vec = dynamic_cast<const PropertyArray<bool> *>(array)->vector();
+                buffer.assign(vec.begin(), vec.end());
+                data = buffer.data();
+                size = buffer.size();
+            }
+            bool decode(BasePropertyArray *array, std::size_t n, const char *data, std::size_t size) const override {
+                if (size != n)
+                    return false;
+                auto &vec = dynamic_cast<PropertyArray<bool> *>(array)->vector();
+                vec.assign(data, data + n);
+                return true;
+            }
+        };
+
+
+        // Quat has a user-defined copy constructor and assignment (so it is not trivially copyable). Its values are
+        // stored as their four components, i.e., the same bytes as a plain array.
+        template<typename FT>
+        class QuatCodec : public BinaryContainer::TypeCodec {
+        public:
+            const std::type_info &type() const override { return typeid(Quat<FT>); }
+            BasePropertyArray *create(const std::string &name, const std::vector<char> &default_value) const override {
+                Quat<FT> value;
+                if (default_value.size() == sizeof(FT) * 4)
+                    value = from_bytes(default_value.data());
+                return new PropertyArray<Quat<FT> >(name, value);
+            }
+            void default_value(const BasePropertyArray *array, std::vector<char> &value) const override {
+                BasePropertyArray *tmp = array->empty_clone();
+                tmp->push_back();
+                value.resize(sizeof(FT) * 4);
+                to_bytes((*dynamic_cast<PropertyArray<Quat<FT> > *>(tmp))[0], value.data());
+                delete tmp;
+            }
+            void encode(const BasePropertyArray *array, std::vector<char> &buffer, const char *&data,
+                        std::size_t &size) const override {
+                const auto &vec = dynamic_cast<const PropertyArray<Quat<FT> > *>(array)->vector();
+                buffer.resize(vec.size() * sizeof(FT) * 4);
+                for (std::size_t i = 0; i < vec.size(); ++i)
+                    to_bytes(vec[i], buffer.data() + i * sizeof(FT) * 4);
+                data = buffer.data();
+                size = buffer.size();
+            }
+            bool decode(BasePropertyArray *array, std::size_t n, const char *data, std::size_t size) const override {
+                if (size != n * sizeof(FT) * 4)
+                    return false;
+                auto &vec = dynamic_cast<PropertyArray<Quat<FT> > *>(array)->vector();
+                vec.resize(n);
+                for (std::size_t i = 0; i < n; ++i)
+                    vec[i] = from_bytes(data + i * sizeof(FT) * 4);
+                return true;
+            }
+
+        private:
+            static void to_bytes(const Quat<FT> &q, char *bytes) {
+                const FT v[4] = {q[0], q[1], q[2], q[3]};
+                std::memcpy(bytes, v, sizeof(v));
+            }
+            static Quat<FT> from_bytes(const char *bytes) {
+                FT v[4];
+                std::memcpy(v, bytes, sizeof(v));
+                return Quat<FT>(v[0], v[1], v[2], v[3]);
+            }
+        };
+
+
+        //------------------------------------------------------------ registry of the codecs
+
+        class CodecRegistry {
+        public:
+            static CodecRegistry &instance() {
+                static CodecRegistry registry;
+                return registry;
+            }
+
+            void add(const std::string &tag, BinaryContainer::TypeCodec *codec) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (auto &entry : codecs_) {
+                    if (entry.first == tag || entry.second->type() == codec->type()) {
+                        LOG_IF(entry.first != tag, WARNING) << "type of tag '" << entry.first << "' re-registered as '"
+                                                            << tag << "'";
+                        entry.first = tag;
+                        entry.second.reset(codec);
+                        return;
+                    }
+                }
+                codecs_.emplace_back(tag, std::unique_ptr<BinaryContainer::TypeCodec>(codec));
+            }
+
+            const BinaryContainer::TypeCodec *find(const std::type_info &type, std::string &tag) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (const auto &entry : codecs_) {
+                    if (entry.second->type() == type) {
+                        tag = entry.first;
+                        return entry.second.get();
+                    }
+                }
+                return nullptr;
+            }
+
+            const BinaryContainer::TypeCodec *find(const std::string &tag) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (const auto &entry : codecs_) {
+                    if (entry.first == tag)
+                        return entry.second.get();
+                }
+                return nullptr;
+            }
+
+        private:
+            template<typename T>
+            void add_pod(const std::string &tag) {
+                static_assert(std::is_trivially_copyable<T>::value, "the type must be trivially copyable");
+                codecs_.emplace_back(tag, std::unique_ptr<BinaryContainer::TypeCodec>(new BinaryContainer::PodCodec<T>));
+            }
+            template<typename T>
+            void add_variable_size(const std::string &tag) {
+                codecs_.emplace_back(tag, std::unique_ptr<BinaryContainer::TypeCodec>(new VariableSizeCodec<T>));
+            }
+
+            CodecRegistry() {
+                codecs_.emplace_back("bool", std::unique_ptr<BinaryContainer::TypeCodec>(new BoolCodec));
+                add_pod<char>("char");
+                add_pod<signed char>("signed char");
+                add_pod<unsigned char>("unsigned char");
+                add_pod<short>("short");
+                add_pod<unsigned short>("unsigned short");
+                add_pod<int>("int");
+                add_pod<unsigned int>("unsigned int");
+                add_pod<long>("long");
+                add_pod<unsigned long>("unsigned long");
+                add_pod<long long>("long long");
+                add_pod<unsigned long long>("unsigned long long");
+                add_pod<float>("float");
+                add_pod<double>("double");
+                add_pod<vec2>("vec2");
+                add_pod<vec3>("vec3");
+                add_pod<vec4>("vec4");
+                add_pod<dvec2>("dvec2");
+                add_pod<dvec3>("dvec3");
+                add_pod<dvec4>("dvec4");
+                add_pod<ivec2>("ivec2");
+                add_pod<ivec3>("ivec3");
+                add_pod<ivec4>("ivec4");
+                add_pod<mat2>("mat2");
+                add_pod<mat3>("mat3");
+                add_pod<mat4>("mat4");
+                add_pod<dmat2>("dmat2");
+                add_pod<dmat3>("dmat3");
+                add_pod<dmat4>("dmat4");
+                codecs_.emplace_back("quat", std::unique_ptr<BinaryContainer::TypeCodec>(new QuatCodec<float>));
+                codecs_.emplace_back("dquat", std::unique_ptr<BinaryContainer::TypeCodec>(new QuatCodec<double>));
+                add_variable_size<std::string>("string");
+
+                add_pod<PointCloud::Vertex>("PointCloud::Vertex");
+
+                add_pod<SurfaceMesh::Vertex>("SurfaceMesh::Vertex");
+                add_pod<SurfaceMesh::Halfedge>("SurfaceMesh::Halfedge");
+                add_pod<SurfaceMesh::Edge>("SurfaceMesh::Edge");
+                add_pod<SurfaceMesh::Face>("SurfaceMesh::Face");
+                add_pod<SurfaceMesh::VertexConnectivity>("SurfaceMesh::VertexConnectivity");
+                add_pod<SurfaceMesh::HalfedgeConnectivity>("SurfaceMesh::HalfedgeConnectivity");
+                add_pod<SurfaceMesh::FaceConnectivity>("SurfaceMesh::FaceConnectivity");
+
+                add_pod<Graph::Vertex>("Graph::Vertex");
+                add_pod<Graph::Edge>("Graph::Edge");
+                add_variable_size<Graph::VertexConnectivity>("Graph::VertexConnectivity");
+                add_pod<Graph::EdgeConnectivity>("Graph::EdgeConnectivity");
+
+                add_pod<PolyMesh::Vertex>("PolyMesh::Vertex");
+                add_pod<PolyMesh::Edge>("PolyMesh::Edge");
+                add_pod<PolyMesh::HalfFace>("PolyMesh::HalfFace");
+                add_pod<PolyMesh::Face>("PolyMesh::Face");
+                add_pod<PolyMesh::Cell>("PolyMesh::Cell");
+                add_variable_size<PolyMesh::VertexConnectivity>("PolyMesh::VertexConnectivity");
+                add_variable_size<PolyMesh::EdgeConnectivity>("PolyMesh::EdgeConnectivity");
+                add_variable_size<PolyMesh::HalfFaceConnectivity>("PolyMesh::HalfFaceConnectivity");
+                add_variable_size<PolyMesh::CellConnectivity>("PolyMesh::CellConnectivity");
+            }
+
+        private:
+            std::vector<std::pair<std::string, std::unique_ptr<BinaryContainer::TypeCodec> > > codecs_;
+            std::mutex mutex_;
+        };
+
+
+        //------------------------------------------------------------ file layout
+
+        const char container_magic[8] = {'E', 'A', 'S', 'Y', '3', 'D', 'B', 'C'};
+        const uint32_t container_version = 1;
+        const uint32_t container_byte_order = 0x01020304;
+        const std::size_t container_alignment = 64;
+
+        enum ModelType {
+            MODEL_POINT_CLOUD = 1, MODEL_SURFACE_MESH = 2, MODEL_GRAPH = 3, MODEL_POLY_MESH = 4
+        };
+
+        struct ContainerHeader {
+            char magic[8];
+            uint32_t version;
+            uint32_t byte_order;
+            uint32_t model_type;
+            uint32_t num_sections;
+            uint64_t toc_offset;
+            uint64_t toc_size;
+            char reserved[24];
+        };
+        static_assert(sizeof(ContainerHeader) == container_alignment, "the header must occupy 64 bytes");
+
+        // an entry of the table of contents, i.e., a property array
+        struct Section {
+            char element;               // the property container, e.g., 'v' for vertices
+            uint8_t compression;
+            uint64_t num_elements;
+            uint64_t offset;            // the position of the data in the file
+            uint64_t stored_size;       // the number of bytes in the file
+            uint64_t raw_size;          // the number of bytes after decompression
+            std::string name;
+            std::string tag;
+            std::vector<char> default_value;
+        };
+
+        inline std::size_t align(std::size_t pos) {
+            return (pos + container_alignment - 1) / container_alignment * container_alignment;
+        }
+
+        inline void write_padding(std::ofstream &output, std::size_t &pos) {
+            static const char zeros[container_alignment] = {0};
+            const std::size_t aligned = align(pos);
+            output.write(zeros, static_cast<std::streamsize>(aligned - pos));
+            pos = aligned;
+        }
+
+        inline const char *model_name(uint32_t type) {
+            switch (type) {
+                case MODEL_POINT_CLOUD: return "PointCloud";
+                case MODEL_SURFACE_MESH: return "SurfaceMesh";
+                case MODEL_GRAPH: return "Graph";
+                case MODEL_POLY_MESH: return "PolyMesh";
+                default: return "unknown";
+            }
+        }
+
+
+        bool save_containers(const std::string &file_name, ModelType type,
+                             const std::vector<std::pair<char, PropertyContainer *> > &containers,
+                             BinaryContainer::Compression compression) {
+            std::ofstream output(file_name.c_str(), std::fstream::binary);
+            if (output.fail()) {
+                LOG(ERROR) << "could not open file: " << file_name;
+                return false;
+            }
+
+            ContainerHeader header;
+            std::memset(&header, 0, sizeof(header));
+            std::memcpy(header.magic, container_magic, sizeof(container_magic));
+            header.version = container_version;
+            header.byte_order = container_byte_order;
+            header.model_type = type;
+            output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            std::size_t pos = sizeof(header);
+
+            std::vector<Section> sections;
+            std::vector<char> buffer, compressed;
+            for (const auto &c : containers) {
+                for (const auto array : c.second->arrays()) {
+                    Section s;
+                    const BinaryContainer::TypeCodec *codec = CodecRegistry::instance().find(array->type(), s.tag);
+                    if (!codec) {
+                        LOG(WARNING) << "property '" << array->name() << "' skipped (type " << array->type().name()
+                                     << " is not registered for binary containers)";
+                        continue;
+                    }
+                    const char *data = nullptr;
+                    std::size_t size = 0;
+                    codec->encode(array, buffer, data, size);
+
+                    s.element = c.first;
+                    s.compression = BinaryContainer::COMPRESSION_NONE;
+                    s.num_elements = c.second->size();
+                    s.raw_size = size;
+                    s.name = array->name();
+                    codec->default_value(array, s.default_value);
+                    if (compression == BinaryContainer::COMPRESSION_LZ4 && size > 0) {
+                        compressed.resize(lz4_bound(size));
+                        const std::size_t compressed_size = lz4_compress(data, size, compressed.data());
+                        if (compressed_size < size) {
+                            s.compression = BinaryContainer::COMPRESSION_LZ4;
+                            data = compressed.data();
+                            size = compressed_size;
+                        }
+                    }
+
+                    write_padding(output, pos);
+                    s.offset = pos;
+                    s.stored_size = size;
+                    output.write(data, static_cast<std::streamsize>(size));
+                    pos += size;
+                    sections.push_back(s);
+                }
+            }
+
+            // the table of contents
+            std::vector<char> toc;
+            Writer w(toc);
+            w.put(static_cast<uint32_t>(containers.size()));
+            for (const auto &c : containers) {
+                w.put(c.first);
+                w.put(static_cast<uint64_t>(c.second->size()));
+            }
+            for (const auto &s : sections) {
+                w.put(s.element);
+                w.put(s.compression);
+                w.put(s.num_elements);
+                w.put(s.offset);
+                w.put(s.stored_size);
+                w.put(s.raw_size);
+                w.put(s.name);
+                w.put(s.tag);
+                w.put(s.default_value);
+            }
+            write_padding(output, pos);
+            output.write(toc.data(), static_cast<std::streamsize>(toc.size()));
+
+            header.num_sections = static_cast<uint32_t>(sections.size());
+            header.toc_offset = pos;
+            header.toc_size = toc.size();
+            output.seekp(0);
+            output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            if (output.fail()) {
+                LOG(ERROR) << "failed writing file: " << file_name;
+                return false;
+            }
+            return true;
+        }
+
+
+        bool load_containers(const std::string &file_name, ModelType type,
+                             const std::vector<std::pair<char, PropertyContainer *> > &containers) {
+            MappedFile file(file_name);
+            if (!file.data()) {
+                LOG(ERROR) << "could not open file: " << file_name;
+                return false;
+            }
+
+            ContainerHeader header;
+            if (file.size() < sizeof(header)) {
+                LOG(ERROR) << "not a binary container file: " << file_name;
+                return false;
+            }
+            std::memcpy(&header, file.data(), sizeof(header));
+            if (std::memcmp(header.magic, container_magic, sizeof(container_magic)) != 0) {
+                LOG(ERROR) << "not a binary container file: " << file_name;
+                return false;
+            }
+            if (header.version > container_version) {
+                LOG(ERROR) << "unsupported version (" << header.version << ") of binary container: " << file_name;
+                return false;
+            }
+            if (header.byte_order != container_byte_order) {
+                LOG(ERROR) << "the binary container was created on a platform with a different byte order: "
+                           << file_name;
+                return false;
+            }
+            if (header.model_type != static_cast<uint32_t>(type)) {
+                LOG(ERROR) << "the binary container stores a " << model_name(header.model_type) << " (expected a "
+                           << model_name(type) << "): " << file_name;
+                return false;
+            }
+            if (header.toc_offset > file.size() || header.toc_size > file.size() - header.toc_offset) {
+                LOG(ERROR) << "corrupted binary container: " << file_name;
+                return false;
+            }
+
+            Reader r(file.data() + header.toc_offset, static_cast<std::size_t>(header.toc_size));
+            auto find_container = [&containers](char element) -> PropertyContainer * {
+                for (const auto &c : containers)
+                    if (c.first == element) return c.second;
+                return nullptr;
+            };
+
+            const auto num_containers = r.get<uint32_t>();
+            for (uint32_t i = 0; i < num_containers && r.ok(); ++i) {
+                const char element = r.get<char>();
+                const auto size = r.get<uint64_t>();
+                PropertyContainer *c = find_container(element);
+                if (c && r.ok())
+                    c->resize(static_cast<std::size_t>(size));
+            }
+
+            std::vector<char> buffer;
+            for (uint32_t i = 0; i < header.num_sections && r.ok(); ++i) {
+                Section s;
+                s.element = r.get<char>();
+                s.compression = r.get<uint8_t>();
+                s.num_elements = r.get<uint64_t>();
+                s.offset = r.get<uint64_t>();
+                s.stored_size = r.get<uint64_t>();
+                s.raw_size = r.get<uint64_t>();
+                s.name = r.get_string();
+                s.tag = r.get_string();
+                s.default_value = r.get_bytes();
+                if (!r.ok() || s.offset > file.size() || s.stored_size > file.size() - s.offset)
+                    break;
+
+                PropertyContainer *c = find_container(s.element);
+                if (!c) {
+                    LOG(WARNING) << "property '" << s.name << "' skipped (unknown element type '" << s.element << "')";
+                    continue;
+                }
+                if (c->size() != s.num_elements) {
+                    LOG(ERROR) << "corrupted binary container (inconsistent size of property '" << s.name << "'): "
+                               << file_name;
+                    return false;
+                }
+                const BinaryContainer::TypeCodec *codec = CodecRegistry::instance().find(s.tag);
+                if (!codec) {
+                    LOG(WARNING) << "property '" << s.name << "' skipped (type '" << s.tag
+                                 << "' is not registered for binary containers)";
+                    continue;
+                }
+
+                // load into the existing array (e.g., the connectivity, which the model holds) or a new one
+                BasePropertyArray *array = nullptr;
+                for (auto a : c->arrays()) {
+                    if (a->name() == s.name) {
+                        array = a;
+                        break;
+                    }
+                }
+                if (array && array->type() != codec->type()) {
+                    LOG(WARNING) << "property '" << s.name << "' skipped (it already exists with a different type)";
+                    continue;
+                }
+                const bool is_new = (array == nullptr);
+                if (is_new)
+                    array = codec->create(s.name, s.default_value);
+
+                const char *data = file.data() + s.offset;
+                std::size_t size = static_cast<std::size_t>(s.stored_size);
+                bool success = true;
+                if (s.compression == BinaryContainer::COMPRESSION_LZ4) {
+                    buffer.resize(static_cast<std::size_t>(s.raw_size));
+                    success = lz4_decompress(data, size, buffer.data(), buffer.size());
+                    data = buffer.data();
+                    size = buffer.size();
+                } else if (s.compression != BinaryContainer::COMPRESSION_NONE)
+                    success = false;
+                if (success)
+                    success = codec->decode(array, static_cast<std::size_t>(s.num_elements), data, size);
+
+                if (!success) {
+                    LOG(ERROR) << "failed loading property '" << s.name << "' from file: " << file_name;
+                    if (is_new)
+                        delete array;
+                    return false;
+                }
+                if (is_new)
+                    c->arrays().push_back(array);
+            }
+
+            if (!r.ok()) {
+                LOG(ERROR) << "corrupted binary container: " << file_name;
+                return false;
+            }
+            return true;
+        }
+
+    } // namespace internal
+
+
+    void BinaryContainer::register_codec(const std::string &tag, TypeCodec *codec) {
+        internal::CodecRegistry::instance().add(tag, codec);
+    }
+
+
+    BinaryContainer::Containers BinaryContainer::containers(const PointCloud *cloud) {
+        auto c = const_cast<PointCloud *>(cloud);
+        return {{'v', &c->vprops_}, {'m', &c->mprops_}};
+    }
+
+    BinaryContainer::Containers BinaryContainer::containers(const SurfaceMesh *mesh) {
+        auto m = const_cast<SurfaceMesh *>(mesh);
+        return {{'v', &m->vprops_}, {'h', &m->hprops_}, {'e', &m->eprops_}, {'f', &m->fprops_}, {'m', &m->mprops_}};
+    }
+
+    BinaryContainer::Containers BinaryContainer::containers(const Graph *graph) {
+        auto g = const_cast<Graph *>(graph);
+        return {{'v', &g->vprops_}, {'e', &g->eprops_}, {'m', &g->mprops_}};
+    }
+
+    BinaryContainer::Containers BinaryContainer::containers(const PolyMesh *mesh) {
+        auto m = const_cast<PolyMesh *>(mesh);
+        return {{'v', &m->vprops_}, {'e', &m->eprops_}, {'h', &m->hprops_}, {'f', &m->fprops_}, {'c', &m->cprops_},
+                {'m', &m->mprops_}};
+    }
+
+
+    bool BinaryContainer::save(const std::string &file_name, const PointCloud *cloud, Compression compression) {
+        if (!cloud) {
+            LOG(ERROR) << "null point cloud pointer";
+            return false;
+        }
+        if (cloud->has_garbage()) {  // the deleted vertices are not stored
+            PointCloud copy(*cloud);
+            copy.collect_garbage();
+            return internal::save_containers(file_name, internal::MODEL_POINT_CLOUD, containers(&copy), compression);
+        }
+        return internal::save_containers(file_name, internal::MODEL_POINT_CLOUD, containers(cloud), compression);
+    }
+
+    bool BinaryContainer::save(const std::string &file_name, const SurfaceMesh *mesh, Compression compression) {
+        if (!mesh) {
+            LOG(ERROR) << "null mesh pointer";
+            return false;
+        }
+        if (mesh->has_garbage()) {  // the deleted elements are not stored
+            SurfaceMesh copy(*mesh);
+            copy.collect_garbage();
+            return internal::save_containers(file_name, internal::MODEL_SURFACE_MESH, containers(&copy), compression);
+        }
+        return internal::save_containers(file_name, internal::MODEL_SURFACE_MESH, containers(mesh), compression);
+    }
+
+    bool BinaryContainer::save(const std::string &file_name, const Graph *graph, Compression compression) {
+        if (!graph) {
+            LOG(ERROR) << "null graph pointer";
+            return false;
+        }
+        if (graph->has_garbage()) {  // the deleted elements are not stored
+            Graph copy(*graph);
+            copy.collect_garbage();
+            return internal::save_containers(file_name, internal::MODEL_GRAPH, containers(&copy), compression);
+        }
+        return internal::save_containers(file_name, internal::MODEL_GRAPH, containers(graph), compression);
+    }
+
+    bool BinaryContainer::save(const std::string &file_name, const PolyMesh *mesh, Compression compression) {
+        if (!mesh) {
+            LOG(ERROR) << "null mesh pointer";
+            return false;
+        }
+        return internal::save_containers(file_name, internal::MODEL_POLY_MESH, containers(mesh), compression);
+    }
+
+
+    bool BinaryContainer::load(const std::string &file_name, PointCloud *cloud) {
+        if (!cloud) {
+            LOG(ERROR) << "null point cloud pointer";
+            return false;
+        }
+        cloud->clear();
+        return internal::load_containers(file_name, internal::MODEL_POINT_CLOUD, containers(cloud));
+    }
+
+    bool BinaryContainer::load(const std::string &file_name, SurfaceMesh *mesh) {
+        if (!mesh) {
+            LOG(ERROR) << "null mesh pointer";
+            return false;
+        }
+        mesh->clear();
+        return internal::load_containers(file_name, internal::MODEL_SURFACE_MESH, containers(mesh));
+    }
+
+    bool BinaryContainer::load(const std::string &file_name, Graph *graph) {
+        if (!graph) {
+            LOG(ERROR) << "null graph pointer";
+            return false;
+        }
+        graph->clear();
+        return internal::load_containers(file_name, internal::MODEL_GRAPH, containers(graph));
+    }
+
+    bool BinaryContainer::load(const std::string &file_name, PolyMesh *mesh) {
+        if (!mesh) {
+            LOG(ERROR) << "null mesh pointer";
+            return false;
+        }
+        mesh->clear();
+        return internal::load_containers(file_name, internal::MODEL_POLY_MESH, containers(mesh));
+    }
+
+} // namespace easy3d
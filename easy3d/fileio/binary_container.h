@@ -0,0 +1,183 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#ifndef EASY3D_FILEIO_BINARY_CONTAINER_H
+#define EASY3D_FILEIO_BINARY_CONTAINER_H
+
+#include <string>
+#include <vector>
+#include <typeinfo>
+#include <cstring>
+#include <type_traits>
+
+#include <easy3d/core/property.h>
+
+
+namespace easy3d {
+
+    class PointCloud;
+    class SurfaceMesh;
+    class Graph;
+    class PolyMesh;
+
+    /**
+     * \brief A versioned, chunked binary container storing all the properties of a model.
+     * \class BinaryContainer easy3d/fileio/binary_container.h
+     * \details A binary container (file extension \c .e3d) stores a PointCloud, SurfaceMesh, Graph, or PolyMesh
+     *      with every property array (including the connectivity) of every element type, whatever the name and the
+     *      value type of the property. It is intended as a fast cache format between processing stages on the same
+     *      platform: the data is stored in native byte order and memory layout.
+     *
+     *      The file starts with a 64-byte header, followed by the sections (i.e., one section per property array),
+     *      each starting at a 64-byte aligned offset, and a table of contents at the end. Loading maps the file
+     *      into memory and fills each property array with a single copy of its section (or a single decompression
+     *      if the section is compressed). Each section can be compressed using LZ4 (block format). A section is
+     *      stored uncompressed if compression does not reduce its size.
+     *
+     *      The value types of the properties are identified by tags. The fundamental types, the vector, matrix, and
+     *      quaternion types defined in easy3d/core/types.h, std::string, and the handle and connectivity types of
+     *      the models are supported. Other types can be registered using register_type(). Properties of
+     *      unsupported types are skipped (with a warning).
+     */
+    class BinaryContainer {
+    public:
+        /// \brief The compression method of the sections.
+        enum Compression {
+            COMPRESSION_NONE = 0,
+            COMPRESSION_LZ4 = 1
+        };
+
+        /// \brief Saves a point cloud to a binary container file.
+        static bool save(const std::string &file_name, const PointCloud *cloud, Compression compression = COMPRESSION_NONE);
+        /// \brief Saves a surface mesh to a binary container file.
+        static bool save(const std::string &file_name, const SurfaceMesh *mesh, Compression compression = COMPRESSION_NONE);
+        /// \brief Saves a graph to a binary container file.
+        static bool save(const std::string &file_name, const Graph *graph, Compression compression = COMPRESSION_NONE);
+        /// \brief Saves a polyhedral mesh to a binary container file.
+        static bool save(const std::string &file_name, const PolyMesh *mesh, Compression compression = COMPRESSION_NONE);
+
+        /// \brief Loads a point cloud from a binary container file. Existing data of the point cloud is cleared.
+        static bool load(const std::string &file_name, PointCloud *cloud);
+        /// \brief Loads a surface mesh from a binary container file. Existing data of the mesh is cleared.
+        static bool load(const std::string &file_name, SurfaceMesh *mesh);
+        /// \brief Loads a graph from a binary container file. Existing data of the graph is cleared.
+        static bool load(const std::string &file_name, Graph *graph);
+        /// \brief Loads a polyhedral mesh from a binary container file. Existing data of the mesh is cleared.
+        static bool load(const std::string &file_name, PolyMesh *mesh);
+
+        /**
+         * \brief The interface for storing the property arrays of a value type.
+         * \details Implement this interface for value types that are not trivially copyable. For trivially copyable
+         *      types, simply call register_type().
+         */
+        class TypeCodec {
+        public:
+            virtual ~TypeCodec() = default;
+            /// The value type handled by this codec.
+            virtual const std::type_info &type() const = 0;
+            /// Creates an empty property array of this type with the default value (given as raw bytes).
+            virtual BasePropertyArray *create(const std::string &name, const std::vector<char> &default_value) const = 0;
+            /// Returns the default value of the array in \p value (as raw bytes). Empty if not supported.
+            virtual void default_value(const BasePropertyArray *array, std::vector<char> &value) const = 0;
+            /// Returns the encoded bytes of the array in \p data (and \p size). If the values are stored contiguously
+            /// and trivially copyable, \p data points to the storage of the array. Otherwise, the values are
+            /// encoded into \p buffer.
+            virtual void encode(const BasePropertyArray *array, std::vector<char> &buffer, const char *&data,
+                                std::size_t &size) const = 0;
+            /// Decodes \p n elements from the \p size bytes at \p data into the array.
+            virtual bool decode(BasePropertyArray *array, std::size_t n, const char *data, std::size_t size) const = 0;
+        };
+
+        /**
+         * \brief A codec for trivially copyable value types, which are stored by copying their memory.
+         */
+        template<typename T>
+        class PodCodec : public TypeCodec {
+            static_assert(std::is_trivially_copyable<T>::value, "the type must be trivially copyable");
+        public:
+            const std::type_info &type() const override { return typeid(T); }
+            BasePropertyArray *create(const std::string &name, const std::vector<char> &default_value) const override {
+                T value = T();
+                if (default_value.size() == sizeof(T))
+                    std::memcpy(&value, default_value.data(), sizeof(T));
+                return new PropertyArray<T>(name, value);
+            }
+            void default_value(const BasePropertyArray *array, std::vector<char> &value) const override {
+                // the default value is not accessible, so we get it from a new element of an empty clone
+                BasePropertyArray *tmp = array->empty_clone();
+                tmp->push_back();
+                const T &v = (*dynamic_cast<PropertyArray<T> *>(tmp))[0];
+                value.assign(reinterpret_cast<const char *>(&v), reinterpret_cast<const char *>(&v) + sizeof(T));
+                delete tmp;
+            }
+            void encode(const BasePropertyArray *array, std::vector<char> &, const char *&data,
+                        std::size_t &size) const override {
+                const auto &vec = dynamic_cast<const PropertyArray<T> *>(array)->vector();
+                data = vec.empty() ? nullptr : reinterpret_cast<const char *>(vec.data());
+                size = vec.size() * sizeof(T);
+            }
+            bool decode(BasePropertyArray *array, std::size_t n, const char *data, std::size_t size) const override {
+                if (size != n * sizeof(T))
+                    return false;
+                auto &vec = dynamic_cast<PropertyArray<T> *>(array)->vector();
+                vec.resize(n);
+                if (n > 0)
+                    std::memcpy(vec.data(), data, size);
+                return true;
+            }
+        };
+
+        /**
+         * \brief Registers a value type, so the properties of this type can be stored in binary containers.
+         * \tparam T The value type, which must be trivially copyable (i.e., it can be copied with memcpy).
+         * \param tag A unique name identifying the type in the files, e.g., "MyVertexData". The same tag must be
+         *      registered when loading the files.
+         */
+        template<typename T>
+        static void register_type(const std::string &tag) {
+            static_assert(std::is_trivially_copyable<T>::value, "the type must be trivially copyable");
+            register_codec(tag, new PodCodec<T>);
+        }
+
+        /**
+         * \brief Registers a codec for a value type, so the properties of this type can be stored in binary
+         *      containers. The ownership of the codec is transferred.
+         */
+        static void register_codec(const std::string &tag, TypeCodec *codec);
+
+    private:
+        // the property containers of the models, each identified by a character (the prefix of the property names)
+        typedef std::vector<std::pair<char, PropertyContainer *> > Containers;
+        static Containers containers(const PointCloud *cloud);
+        static Containers containers(const SurfaceMesh *mesh);
+        static Containers containers(const Graph *graph);
+        static Containers containers(const PolyMesh *mesh);
+    };
+
+} // namespace easy3d
+
+
+#endif  // EASY3D_FILEIO_BINARY_CONTAINER_H
@@ -0,0 +1,93 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#include <easy3d/fileio/block_writer.h>
+#include <easy3d/util/logging.h>
+
+
+namespace easy3d {
+
+    namespace io {
+
+        bool BlockWriter::parallel_ = true;
+
+
+        BlockWriter::BlockWriter(const std::string &file_name, std::size_t buffer_size)
+                : file_(nullptr), buffer_(std::max<std::size_t>(buffer_size, 1024)), used_(0), rows_(0), failed_(false)
+        {
+            file_ = std::fopen(file_name.c_str(), "wb");
+            if (!file_)
+                LOG(ERROR) << "could not open file: " << file_name;
+        }
+
+
+        BlockWriter::~BlockWriter() {
+            if (file_)
+                close();
+        }
+
+
+        void BlockWriter::write(const void *data, std::size_t size) {
+            if (!file_ || failed_)
+                return;
+            if (used_ + size <= buffer_.size()) {
+                std::memcpy(buffer_.data() + used_, data, size);
+                used_ += size;
+                return;
+            }
+            flush();
+            if (size >= buffer_.size() / 2) {  // large blocks go to the file directly
+                if (std::fwrite(data, 1, size, file_) != size)
+                    failed_ = true;
+            } else {
+                std::memcpy(buffer_.data(), data, size);
+                used_ = size;
+            }
+        }
+
+
+        void BlockWriter::flush() {
+            if (used_ > 0 && !failed_ && std::fwrite(buffer_.data(), 1, used_, file_) != used_)
+                failed_ = true;
+            used_ = 0;
+        }
+
+
+        bool BlockWriter::close() {
+            if (!file_)
+                return false;
+            flush();
+            if (std::fclose(file_) != 0)
+                failed_ = true;
+            file_ = nullptr;
+            if (failed_)
+                LOG(ERROR) << "failed writing the file";
+            return !failed_;
+        }
+
+    } // namespace io
+
+} // namespace easy3d
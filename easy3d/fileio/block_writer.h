@@ -0,0 +1,192 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#ifndef EASY3D_FILEIO_BLOCK_WRITER_H
+#define EASY3D_FILEIO_BLOCK_WRITER_H
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+
+#include <easy3d/util/string.h>
+#include <easy3d/util/thread_pool.h>
+#include <easy3d/util/progress.h>
+
+
+namespace easy3d {
+
+    namespace io {
+
+        /**
+         * \brief A buffered writer that writes a file in large blocks.
+         * \class BlockWriter easy3d/fileio/block_writer.h
+         * \details This class is internally used by the writers of the PLY, STL, OBJ, OFF, and XYZ formats. Small
+         *      writes are collected into a large buffer, and large writes (e.g., a packed property array) go to the
+         *      file directly. The rows of a model (e.g., its vertices or faces) are written by write_rows(), which
+         *      formats them chunk by chunk, optionally in parallel, and writes the chunks in order. So the output is
+         *      identical regardless of the number of threads, and the memory is bounded by a few chunks.
+         *
+         *      Example usage:
+         *      \code
+         *          BlockWriter writer(file_name);
+         *          writer.write("OFF\n");
+         *          writer.write_rows(points.size(), [&](std::size_t first, std::size_t last, std::string &out) {
+         *              for (std::size_t i = first; i < last; ++i) {
+         *                  append_ascii(out, points[i]);
+         *                  out += '\n';
+         *              }
+         *          });
+         *          return writer.close();
+         *      \endcode
+         */
+        class BlockWriter {
+        public:
+            /**
+             * \brief Opens a file for writing (in binary mode, i.e., no newline conversion).
+             * \param file_name The name of the file.
+             * \param buffer_size The size (in bytes) of the write buffer.
+             */
+            explicit BlockWriter(const std::string &file_name, std::size_t buffer_size = 4u << 20);
+            /// \brief Destructor. It closes the file if it is still open.
+            ~BlockWriter();
+
+            /// \brief Returns whether the file was successfully opened.
+            bool is_open() const { return file_ != nullptr; }
+
+            /// \brief Writes \p size bytes.
+            void write(const void *data, std::size_t size);
+            /// \brief Writes a string.
+            void write(const std::string &str) { write(str.data(), str.size()); }
+
+            /**
+             * \brief Formats and writes \p num rows.
+             * \param num The number of rows.
+             * \param format A function <tt>void(std::size_t first, std::size_t last, std::string &out)</tt> that
+             *      appends the rows in [first, last) to \p out. It can be called concurrently for disjoint ranges.
+             * \param progress An optional progress logger, which is notified after each batch of chunks with the
+             *      total number of rows written by this writer (i.e., accumulated over the calls of write_rows()).
+             * \param chunk_size The number of rows formatted at a time by a thread.
+             * \return False if the progress was canceled or the writing failed.
+             */
+            template<typename Function>
+            bool write_rows(std::size_t num, const Function &format, ProgressLogger *progress = nullptr,
+                            std::size_t chunk_size = 65536);
+
+            /**
+             * \brief Flushes the buffer and closes the file.
+             * \return True if all the data was successfully written.
+             */
+            bool close();
+
+            /**
+             * \brief Enables/Disables parallel formatting of the rows (enabled by default).
+             * \details If enabled, the chunks are formatted using the shared ThreadPool.
+             */
+            static void set_parallel(bool b) { parallel_ = b; }
+            /// \brief Returns whether the rows are formatted in parallel.
+            static bool parallel() { return parallel_; }
+
+        private:
+            void flush();
+
+        private:
+            FILE *file_;
+            std::vector<char> buffer_;
+            std::size_t used_;
+            std::size_t rows_;
+            bool failed_;
+
+            static bool parallel_;
+        };
+
+
+        /// \brief Appends the shortest decimal representation of a float value (see string::to_chars()).
+        inline void append_ascii(std::string &out, float value) {
+            char buf[24];
+            out.append(buf, string::to_chars(buf, value));
+        }
+        /// \brief Appends a double value with 17 significant digits.
+        inline void append_ascii(std::string &out, double value) {
+            char buf[32];
+            out.append(buf, string::to_chars(buf, value));
+        }
+        /// \brief Appends an integer value.
+        inline void append_ascii(std::string &out, int value) {
+            char buf[12];
+            out.append(buf, string::to_chars(buf, value));
+        }
+        /// \brief Appends the coordinates of a vector, separated by spaces.
+        template<typename Vec>
+        inline void append_ascii(std::string &out, const Vec &v, std::size_t dim) {
+            for (std::size_t i = 0; i < dim; ++i) {
+                if (i > 0) out += ' ';
+                append_ascii(out, v[i]);
+            }
+        }
+
+        /// \brief Appends the bytes of a value (in native byte order).
+        template<typename T>
+        inline void append_binary(std::string &out, const T &value) {
+            out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+
+        template<typename Function>
+        bool BlockWriter::write_rows(std::size_t num, const Function &format, ProgressLogger *progress,
+                                     std::size_t chunk_size) {
+            chunk_size = std::max<std::size_t>(chunk_size, 1);
+            const std::size_t num_chunks = (num + chunk_size - 1) / chunk_size;
+            ThreadPool *pool = ThreadPool::instance();
+            // Each thread formats two chunks in a batch, and the chunks of a batch are written in order.
+            const std::size_t batch_size = parallel_ ? std::max<std::size_t>(pool->num_threads() * 2, 1) : 1;
+            std::vector<std::string> chunks(std::min(batch_size, num_chunks));
+
+            for (std::size_t batch = 0; batch < num_chunks; batch += batch_size) {
+                if (progress && progress->is_canceled())
+                    return false;
+                const std::size_t count = std::min(batch_size, num_chunks - batch);
+                parallel_for(std::size_t(0), count, [&](std::size_t i) {
+                    const std::size_t first = (batch + i) * chunk_size;
+                    const std::size_t last = std::min(first + chunk_size, num);
+                    chunks[i].clear();
+                    format(first, last, chunks[i]);
+                }, 1);
+                for (std::size_t i = 0; i < count; ++i)
+                    write(chunks[i]);
+                if (progress)
+                    progress->notify(rows_ + std::min((batch + count) * chunk_size, num));
+            }
+            rows_ += num;
+            return !failed_;
+        }
+
+    } // namespace io
+
+} // namespace easy3d
+
+#endif  // EASY3D_FILEIO_BLOCK_WRITER_H
@@ -25,6 +25,7 @@
  ********************************************************************/
 
 #include <easy3d/fileio/graph_io.h>
+#include <easy3d/fileio/binary_container.h>
 #include <easy3d/core/graph.h>
 #include <easy3d/util/file_system.h>
 #include <easy3d/util/stop_watch.h>
@@ -45,12 +46,14 @@ namespace easy3d {
         const std::string& ext = file_system::extension(file_name, true);
         if (ext == "ply")
             success = io::load_ply(file_name, graph);
+        else if (ext == "e3d")
+            success = BinaryContainer::load(file_name, graph);
         else if (ext.empty()){
             LOG(ERROR) << "unknown file format: no extension" << ext;
             success = false;
         }
         else {
-            LOG(ERROR) << "unknown file format: " << ext << ". Only PLY format is supported for Graph" << ext;
+            LOG(ERROR) << "unknown file format: " << ext << ". Only PLY and E3D formats are supported for Graph";
             return nullptr;
         }
 
@@ -88,8 +91,10 @@ namespace easy3d {
                 final_name = final_name + ".ply";
             }
             success = io::save_ply(final_name, graph, true);
-        } else {
-            LOG(ERROR) << "unknown file format: " << ext << ". Only PLY format is supported for Graph";
+        } else if (ext == "e3d")
+            success = BinaryContainer::save(final_name, graph);
+        else {
+            LOG(ERROR) << "unknown file format: " << ext << ". Only PLY and E3D formats are supported for Graph";
             success = false;
         }
 
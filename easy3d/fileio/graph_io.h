@@ -43,13 +43,13 @@ namespace easy3d {
         /**
          * \brief Reads a graph from file \p file_name.
          * \return The pointer of the graph (nullptr if failed).
-         * \details File extension determines file format (currently only PLY format is supported).
+         * \details File extension determines file format (currently PLY and E3D formats are supported).
          */
         static Graph* load(const std::string& file_name);
 
         /**
          * \brief Saves \p graph to file \p file_name.
-         * \details File extension determines file format (currently only PLY format is supported).
+         * \details File extension determines file format (currently PLY and E3D formats are supported).
          * \return The status of the operation
          *      \arg true if succeeded
          *      \arg false if failed
@@ -28,6 +28,7 @@
 #include <easy3d/fileio/translator.h>
 #include <easy3d/fileio/ply_reader_writer.h>
 #include <easy3d/core/graph.h>
+#include <easy3d/core/point_kernels.h>
 
 
 namespace easy3d {
@@ -268,11 +269,8 @@ namespace easy3d {
                 const dvec3& origin = trans[0];
                 for (auto& prop : element_vertex.vec3_properties) {
                     if (prop.name == "point") {
-                        for (auto& v : prop) {
-                            v.x += static_cast<float>(origin.x);
-                            v.y += static_cast<float>(origin.y);
-                            v.z += static_cast<float>(origin.z);
-                        }
+                        const vec3 offset(static_cast<float>(origin.x), static_cast<float>(origin.y), static_cast<float>(origin.z));
+                        kernels::translate(prop, offset);
                     }
                 }
             }
@@ -25,6 +25,7 @@
  ********************************************************************/
 
 #include <easy3d/fileio/ply_reader_writer.h>
+#include <easy3d/fileio/block_writer.h>
 #include <easy3d/util/logging.h>
 
 #include <cstring>
@@ -85,247 +86,243 @@ namespace easy3d {
         }
 
 
-        bool PlyWriter::write(
-                const std::string &file_name,
-                const std::vector<Element> &elements,
-                const std::string &comment /* = "" */,
-                bool binary /* = false */) {
-            e_ply_storage_mode mode = PLY_DEFAULT;
-            if (binary) {
-                if (is_big_endian())
-                    mode = PLY_BIG_ENDIAN;
-                else
-                    mode = PLY_LITTLE_ENDIAN;
-            } else
-                mode = PLY_ASCII;
-
-            p_ply ply = ply_create(file_name.c_str(), mode, nullptr, 0, nullptr);
-            if (!ply) {
-                LOG(ERROR) << "failed to create ply file: " << file_name;
-                return false;
-            }
-
-            if (!ply_add_comment(ply, "Saved by Easy3D (liangliang.nan@gmail.com)")) {
-                LOG(ERROR) << "failed to add comment";
-                ply_close(ply);
-                return false;
-            }
-            if (!comment.empty() && !ply_add_comment(ply, comment.c_str())) {
-                LOG(ERROR) << "failed to add comment: " << comment;
-                ply_close(ply);
-                return false;
-            }
+        // \cond
+        namespace internal {
 
-            // Liangliang: For most scenarios, the num of vertices in a face is small (i.e., in [0, 255]), and PLY_UCHAR
-            // is enough. In case you want to store faces that have more than 256 vertices, you should choose PLY_UINT.
-            e_ply_type length_type = PLY_UCHAR;
-#ifndef NDEBUG
-            // warn the user if the number of vertices in a face is greater than 255
-            for (const auto& e : elements) {
-                if (e.name == FACE) {
-                    for (const auto& property : e.int_list_properties) {
-                        if (property.name == "vertex_indices") {
-                            for (const auto& p : property) {
-                                if (p.size() > 255) {
-                                    length_type = PLY_UINT;
-                                    LOG(WARNING) << "face has " << p.size()
-                                                 << " vertices, thus the length field of the list property 'vertex_indices'"
-                                                    " is set to PLY_UINT (this might not be recognized by other software)";
-                                }
-                            }
-                            break;
-                        }
-                    }
-                    break;
+            // The names of the scalar properties a vec3 property is stored as.
+            void vec3_names(const std::string &name, std::string names[3]) {
+                if (name == "color") {
+                    names[0] = "red";
+                    names[1] = "green";
+                    names[2] = "blue";
+                } else if (name == "point") {
+                    names[0] = "x";
+                    names[1] = "y";
+                    names[2] = "z";
+                } else if (name == "normal") {
+                    names[0] = "nx";
+                    names[1] = "ny";
+                    names[2] = "nz";
+                } else {
+                    names[0] = name + "_x";
+                    names[1] = name + "_y";
+                    names[2] = name + "_z";
                 }
             }
-#endif
 
-            for (const auto& e : elements) {
-                const std::string &element_name = e.name;
-                const std::size_t num = e.num_instances;
-
-                // add elements
-                if (!ply_add_element(ply, element_name.data(), static_cast<long>(num))) {
-                    LOG(ERROR) << "failed to add element: " << element_name;
-                    ply_close(ply);
-                    return false;
-                }
+            // The names of the scalar properties a vec2 property is stored as.
+            void vec2_names(const std::string &name, std::string names[2]) {
+                names[0] = name + "_x";   // "texcoord" results in "texcoord_x" and "texcoord_y"
+                names[1] = name + "_y";
+            }
 
-                //-------------------------------------------
-                // add properties
+            // Colors are saved in unsigned char format
+            inline unsigned char color_component(float v) {
+                return static_cast<unsigned char>(std::min(std::max(v, 0.0f), 1.0f) * 255);
+            }
 
-                // int list properties
-                for (const auto& property : e.int_list_properties) {
-                    const std::string &name = property.name;
-                    if (!ply_add_property(ply, name.data(), PLY_LIST, length_type, PLY_INT)) {
-                        LOG(ERROR) << "failed to add int_list property '" << name << "' for element '" << element_name
-                                   << "'";
-                        ply_close(ply);
-                        return false;
+            // Appends the instances [first, last) of an element in binary format. The properties are written in the
+            // same order as they are declared in the header.
+            void format_binary(const Element &e, bool uint_length, std::size_t first, std::size_t last,
+                               std::string &out) {
+                for (std::size_t j = first; j < last; ++j) {
+                    for (const auto &property : e.int_list_properties) {
+                        const std::vector<int> &values = property[j];
+                        if (uint_length)
+                            append_binary(out, static_cast<unsigned int>(values.size()));
+                        else
+                            append_binary(out, static_cast<unsigned char>(values.size()));
+                        if (!values.empty())
+                            out.append(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(int));
                     }
-                }
-
-                // float list properties
-                for (const auto& property : e.float_list_properties) {
-                    const std::string &name = property.name;
-                    if (!ply_add_property(ply, name.data(), PLY_LIST, length_type, PLY_FLOAT)) {
-                        LOG(ERROR) << "failed to add float_list property '" << name << "' for element '" << element_name
-                                   << "'";
-                        ply_close(ply);
-                        return false;
+                    for (const auto &property : e.float_list_properties) {
+                        const std::vector<float> &values = property[j];
+                        if (uint_length)
+                            append_binary(out, static_cast<unsigned int>(values.size()));
+                        else
+                            append_binary(out, static_cast<unsigned char>(values.size()));
+                        if (!values.empty())
+                            out.append(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(float));
+                    }
+                    for (const auto &property : e.vec3_properties) {
+                        const vec3 &v = property[j];
+                        if (property.name == "color") {
+                            const unsigned char c[3] = {color_component(v.x), color_component(v.y),
+                                                        color_component(v.z)};
+                            out.append(reinterpret_cast<const char *>(c), 3);
+                        } else
+                            out.append(reinterpret_cast<const char *>(v.data()), sizeof(vec3));
                     }
+                    for (const auto &property : e.vec2_properties)
+                        out.append(reinterpret_cast<const char *>(property[j].data()), sizeof(vec2));
+                    for (const auto &property : e.float_properties)
+                        append_binary(out, property[j]);
+                    for (const auto &property : e.int_properties)
+                        append_binary(out, property[j]);
                 }
+            }
 
-                // vector properties: vec3
-                for (const auto& property : e.vec3_properties) {
-                    const std::string &name = property.name;
-
-                    std::string names[3];
-                    if (name == "color") {
-                        // save colors in unsigned char format (use "r", "g", "b" in case of float values in [0, 1])
-                        names[0] = "red";
-                        names[1] = "green";
-                        names[2] = "blue";
-                        for (const auto& n : names) {
-                            if (!ply_add_property(ply, n.data(), PLY_UCHAR, length_type, PLY_UINT8)) {
-                                LOG(ERROR) << "failed to add float property '" << n << "' for element '"
-                                           << element_name << "'";
-                                ply_close(ply);
-                                return false;
-                            }
+            // Appends the instances [first, last) of an element in ASCII format (one instance per line).
+            void format_ascii(const Element &e, std::size_t first, std::size_t last, std::string &out) {
+                for (std::size_t j = first; j < last; ++j) {
+                    const std::size_t start = out.size();
+                    for (const auto &property : e.int_list_properties) {
+                        const std::vector<int> &values = property[j];
+                        append_ascii(out, static_cast<int>(values.size()));
+                        for (auto value : values) {
+                            out += ' ';
+                            append_ascii(out, value);
                         }
-                    } else {
-                        if (name == "point") {
-                            names[0] = "x";
-                            names[1] = "y";
-                            names[2] = "z";
-                        } else if (name == "normal") {
-                            names[0] = "nx";
-                            names[1] = "ny";
-                            names[2] = "nz";
-                        } else {
-                            names[0] = name + "_x";
-                            names[1] = name + "_y";
-                            names[2] = name + "_z";
+                        out += ' ';
+                    }
+                    for (const auto &property : e.float_list_properties) {
+                        const std::vector<float> &values = property[j];
+                        append_ascii(out, static_cast<int>(values.size()));
+                        for (auto value : values) {
+                            out += ' ';
+                            append_ascii(out, value);
                         }
-
-                        for (const auto& n : names) {
-                            if (!ply_add_property(ply, n.data(), PLY_FLOAT, length_type, PLY_FLOAT)) {
-                                LOG(ERROR) << "failed to add float property '" << n << "' for element '"
-                                           << element_name << "'";
-                                ply_close(ply);
-                                return false;
+                        out += ' ';
+                    }
+                    for (const auto &property : e.vec3_properties) {
+                        const vec3 &v = property[j];
+                        if (property.name == "color") {
+                            for (unsigned short i = 0; i < 3; ++i) {
+                                append_ascii(out, static_cast<int>(color_component(v[i])));
+                                out += ' ';
                             }
+                        } else {
+                            append_ascii(out, v, 3);
+                            out += ' ';
                         }
                     }
+                    for (const auto &property : e.vec2_properties) {
+                        append_ascii(out, property[j], 2);
+                        out += ' ';
+                    }
+                    for (const auto &property : e.float_properties) {
+                        append_ascii(out, property[j]);
+                        out += ' ';
+                    }
+                    for (const auto &property : e.int_properties) {
+                        append_ascii(out, property[j]);
+                        out += ' ';
+                    }
+                    if (out.size() > start)
+                        out.back() = '\n';   // replaces the trailing space
+                    else
+                        out += '\n';
                 }
+            }
 
-                // vector properties: vec2
-                for (const auto& property : e.vec2_properties) {
-                    const std::string &name = property.name;
+        }
+        // \endcond
 
-                    std::string names[2];
-                    if (name == "texcoord") {
-                        names[0] = "texcoord_x";
-                        names[1] = "texcoord_y";
-                    } else {
-                        names[0] = name + "_x";
-                        names[1] = name + "_y";
-                    }
 
-                    for (const auto& n : names) {
-                        if (!ply_add_property(ply, n.data(), PLY_FLOAT, length_type, PLY_FLOAT)) {
-                            LOG(ERROR) << "failed to add float property '" << n << "' for element '"
-                                       << element_name << "'";
-                            ply_close(ply);
-                            return false;
-                        }
-                    }
+        bool PlyWriter::write(
+                const std::string &file_name,
+                const std::vector<Element> &elements,
+                const std::string &comment /* = "" */,
+                bool binary /* = false */) {
+            // Liangliang: For most scenarios, the num of vertices in a face is small (i.e., in [0, 255]), and an
+            // unsigned char length field is enough. In case there are lists that have more than 255 values, the
+            // length field is an unsigned int (this might not be recognized by other software).
+            bool uint_length = false;
+            for (const auto &e : elements) {
+                for (const auto &property : e.int_list_properties) {
+                    for (const auto &p : property)
+                        uint_length = uint_length || p.size() > 255;
                 }
-
-                for (const auto& property : e.float_properties) {
-                    const std::string &name = property.name;
-                    if (!ply_add_property(ply, name.data(), PLY_FLOAT, length_type, PLY_FLOAT)) {
-                        LOG(ERROR) << "failed to add float property '" << name << "' for element '" << element_name
-                                   << "'";
-                        ply_close(ply);
-                        return false;
-                    }
+                for (const auto &property : e.float_list_properties) {
+                    for (const auto &p : property)
+                        uint_length = uint_length || p.size() > 255;
                 }
+            }
+            if (uint_length)
+                LOG(WARNING) << "some list has more than 255 values, thus the length field of the list properties"
+                                " is set to 'uint' (this might not be recognized by other software)";
+            const std::string header = PlyWriter::header(elements, comment, binary, uint_length);
 
-                for (const auto& property : e.int_properties) {
-                    const std::string &name = property.name;
-                    if (!ply_add_property(ply, name.data(), PLY_INT, length_type, PLY_INT)) {
-                        LOG(ERROR) << "failed to add int property '" << name << "' for element '" << element_name
-                                   << "'";
-                        ply_close(ply);
-                        return false;
-                    }
+            BlockWriter writer(file_name);
+            if (!writer.is_open())
+                return false;
+            writer.write(header);
+
+            // the data, formatted in chunks (in parallel) and written in order
+            for (const auto &e : elements) {
+                auto format = [&](std::size_t first, std::size_t last, std::string &out) {
+                    PlyWriter::format(e, first, last, binary, uint_length, out);
+                };
+                if (!writer.write_rows(e.num_instances, format)) {
+                    LOG(ERROR) << "failed writing element '" << e.name << "' to file: " << file_name;
+                    return false;
                 }
             }
 
-            // write output header
-            if (!ply_write_header(ply))
+            if (!writer.close()) {
+                LOG(ERROR) << "failed to close the ply file: " << file_name;
                 return false;
+            }
+            return true;
+        }
 
-            for (const auto& e : elements) {
-                const std::size_t num = e.num_instances;
-
-                for (std::size_t j = 0; j < num; ++j) {
-                    for (const auto& property : e.int_list_properties) {
-                        const std::vector<int> &values = property[j];
-                        ply_write(ply, static_cast<double>(values.size()));
-                        for (const auto& value : values)
-                            ply_write(ply, value);
-                    }
-
-                    for (const auto& property : e.float_list_properties) {
-                        const std::vector<float> &values = property[j];
-                        ply_write(ply, static_cast<double>(values.size()));
-                        for (const auto& value : values)
-                            ply_write(ply, static_cast<double>(value));
-                    }
-
-                    for (const auto& property : e.vec3_properties) {
-                        const vec3 &v = property[j];
-                        const std::string &name = property.name;
-                        if (name == "color") {
-                            // save colors in unsigned char format
-                            ply_write(ply, static_cast<unsigned char>(v.x * 255));
-                            ply_write(ply, static_cast<unsigned char>(v.y * 255));
-                            ply_write(ply, static_cast<unsigned char>(v.z * 255));
-                        }
-                        else {
-                            ply_write(ply, static_cast<double>(v.x));
-                            ply_write(ply, static_cast<double>(v.y));
-                            ply_write(ply, static_cast<double>(v.z));
-                        }
-                    }
-
-                    for (const auto& property : e.vec2_properties) {
-                        const vec2 &v = property[j];
-                        ply_write(ply, static_cast<double>(v.x));
-                        ply_write(ply, static_cast<double>(v.y));
-                    }
-
-                    for (const auto& property : e.float_properties) {
-                        ply_write(ply, static_cast<double>(property[j]));
-                    }
 
-                    for (const auto& property : e.int_properties) {
-                        ply_write(ply, static_cast<double>(property[j]));
-                    }
+        std::string PlyWriter::header(
+                const std::vector<Element> &elements,
+                const std::string &comment,
+                bool binary,
+                bool uint_length /* = false */) {
+            const std::string list_type = uint_length ? "list uint " : "list uchar ";
+
+            std::string header = "ply\nformat ";
+            if (binary)
+                header += is_big_endian() ? "binary_big_endian 1.0\n" : "binary_little_endian 1.0\n";
+            else
+                header += "ascii 1.0\n";
+            header += "comment Saved by Easy3D (liangliang.nan@gmail.com)\n";
+            if (!comment.empty())
+                header += "comment " + comment + "\n";
+
+            for (const auto &e : elements) {
+                header += "element " + e.name + " " + std::to_string(e.num_instances) + "\n";
+                for (const auto &property : e.int_list_properties)
+                    header += "property " + list_type + "int " + property.name + "\n";
+                for (const auto &property : e.float_list_properties)
+                    header += "property " + list_type + "float " + property.name + "\n";
+                for (const auto &property : e.vec3_properties) {
+                    std::string names[3];
+                    internal::vec3_names(property.name, names);
+                    const std::string type = (property.name == "color") ? "uchar " : "float ";
+                    for (const auto &n : names)
+                        header += "property " + type + n + "\n";
+                }
+                for (const auto &property : e.vec2_properties) {
+                    std::string names[2];
+                    internal::vec2_names(property.name, names);
+                    for (const auto &n : names)
+                        header += "property float " + n + "\n";
                 }
+                for (const auto &property : e.float_properties)
+                    header += "property float " + property.name + "\n";
+                for (const auto &property : e.int_properties)
+                    header += "property int " + property.name + "\n";
             }
+            header += "end_header\n";
+            return header;
+        }
 
-            // close up, we are done
-            if (!ply_close(ply)) {
-                LOG(ERROR) << "failed to close the ply file: " << file_name;
-                return false;
-            }
 
-            return true;
+        void PlyWriter::format(
+                const Element &element,
+                std::size_t first,
+                std::size_t last,
+                bool binary,
+                bool uint_length,
+                std::string &out) {
+            if (binary)
+                internal::format_binary(element, uint_length, first, last, out);
+            else
+                internal::format_ascii(element, first, last, out);
         }
 
 
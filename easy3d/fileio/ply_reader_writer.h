@@ -184,6 +184,34 @@ namespace easy3d {
                     bool binary = false
             );
 
+			/**
+			 * \brief Returns the header of a PLY file storing a set of elements.
+			 * \details This function and format() are used for writing a file in parts (e.g., PointCloudWriter).
+			 * \param elements The model elements. Only the names of the properties and the number of instances are
+			 *		used.
+			 * \param comment The comment to be written to the file.
+			 * \param binary True for binary format (in native byte order), otherwise ASCII format.
+			 * \param uint_length True to use 'uint' for the length of the list properties (otherwise 'uchar').
+			 */
+			static std::string header(
+					const std::vector<Element> &elements,
+					const std::string &comment,
+					bool binary,
+					bool uint_length = false
+			);
+
+			/**
+			 * \brief Appends the instances [first, last) of an element to \p out, in the order of the properties
+			 *		declared by header().
+			 */
+			static void format(
+					const Element &element,
+					std::size_t first,
+					std::size_t last,
+					bool binary,
+					bool uint_length,
+					std::string &out
+			);
 		};
 
 		/**
@@ -26,6 +26,7 @@
 
 #include <easy3d/fileio/point_cloud_io.h>
 #include <easy3d/fileio/point_cloud_io_vg.h>
+#include <easy3d/fileio/binary_container.h>
 #include <easy3d/core/point_cloud.h>
 #include <easy3d/util/file_system.h>
 #include <easy3d/util/stop_watch.h>
@@ -57,6 +58,8 @@ namespace easy3d {
             success = io::PointCloudIO_vg::load_vg(file_name, cloud);
         else if (ext == "bvg")
             success = io::PointCloudIO_vg::load_bvg(file_name, cloud);
+        else if (ext == "e3d")
+            success = BinaryContainer::load(file_name, cloud);
 
         else if (ext.empty()) {
             LOG(ERROR) << "unknown file format: no extension";
@@ -109,6 +112,8 @@ namespace easy3d {
             success = io::PointCloudIO_vg::save_vg(file_name, cloud);
         else if (ext == "bvg")
             success = io::PointCloudIO_vg::save_bvg(file_name, cloud);
+        else if (ext == "e3d")
+            success = BinaryContainer::save(final_name, cloud);
         else {
             LOG(ERROR) << "unknown file format: " << ext;
             success = false;
@@ -45,7 +45,7 @@ namespace easy3d {
 	public:
         /**
          * \brief Reads a point cloud from file \p file_name.
-         * \details File extension determines file format (bin, xyz/bxyz, ply, las/laz, vg/bvg)
+         * \details File extension determines file format (bin, xyz/bxyz, ply, las/laz, vg/bvg, e3d)
          * and type (i.e. binary or ASCII).
          * \return The pointer of the point cloud (nullptr if failed).
          */
@@ -53,7 +53,7 @@ namespace easy3d {
 
         /**
          * \brief Saves a point_cloud to a file.
-         * \details File extension determines file format (bin, xyz/bxyz, ply, las/laz, vg/bvg) and type (i.e. binary
+         * \details File extension determines file format (bin, xyz/bxyz, ply, las/laz, vg/bvg, e3d) and type (i.e. binary
          * or ASCII).
          * \param file_name The file name.
          * \param cloud The point cloud.
@@ -30,6 +30,7 @@
 
 #include <easy3d/fileio/translator.h>
 #include <easy3d/core/point_cloud.h>
+#include <easy3d/core/point_kernels.h>
 
 
 namespace easy3d {
@@ -66,8 +67,7 @@ namespace easy3d {
                 const dvec3 origin(p0.data());
                 Translator::instance()->set_translation(origin);
 
-                for (auto& p : positions)
-                    p -= p0;
+                kernels::translate(positions, -p0);
 
                 auto trans = cloud->add_model_property<dvec3>("translation", dvec3(0, 0, 0));
                 trans[0] = origin;
@@ -76,11 +76,8 @@ namespace easy3d {
             } else if (Translator::instance()->status() == Translator::TRANSLATE_USE_LAST_KNOWN_OFFSET) {
                 const dvec3 &origin = Translator::instance()->translation();
                 auto& pts = cloud->get_vertex_property<vec3>("v:point").vector();
-                for (auto& p: pts) {
-                    p.x -= static_cast<float>(origin.x);
-                    p.y -= static_cast<float>(origin.y);
-                    p.z -= static_cast<float>(origin.z);
-                }
+                const vec3 offset(static_cast<float>(origin.x), static_cast<float>(origin.y), static_cast<float>(origin.z));
+                kernels::translate(pts, -offset);
 
                 auto trans = cloud->add_model_property<dvec3>("translation", dvec3(0, 0, 0));
                 trans[0] = origin;
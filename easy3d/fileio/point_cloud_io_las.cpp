@@ -110,9 +110,28 @@ namespace easy3d {
 
             auto colors = cloud->add_vertex_property<vec3>("v:color");
             auto classification = cloud->add_vertex_property<int>("v:classification");
-            auto v = cloud->add_vertex(vec3(float(x0 - origin_x), float(y0 - origin_y), float(z0 - origin_z)));
-            colors[v] = vec3(r, g, b);
-            classification[v] = p0.classification;
+
+            // the points are read in batches, and each batch is added to the point cloud at once
+            const std::size_t batch_size = 1 << 16;
+            std::vector<vec3> points, point_colors;
+            std::vector<int> point_classes;
+            points.reserve(batch_size);
+            point_colors.reserve(batch_size);
+            point_classes.reserve(batch_size);
+            auto add_batch = [&]() {
+                if (points.empty())
+                    return;
+                const auto first = cloud->add_vertices(points).idx();
+                std::copy(point_colors.begin(), point_colors.end(), colors.vector().begin() + first);
+                std::copy(point_classes.begin(), point_classes.end(), classification.vector().begin() + first);
+                points.clear();
+                point_colors.clear();
+                point_classes.clear();
+            };
+
+            points.emplace_back(float(x0 - origin_x), float(y0 - origin_y), float(z0 - origin_z));
+            point_colors.emplace_back(r, g, b);
+            point_classes.push_back(p0.classification);
 
             // now we read the remaining points...
             while (lasreader->read_point()) {
@@ -123,15 +142,18 @@ namespace easy3d {
                 double x = p.coordinates[0] - origin_x;
                 double y = p.coordinates[1] - origin_y;
                 double z = p.coordinates[2] - origin_z;
-                v = cloud->add_vertex(vec3(float(x), float(y), float(z)));
+                points.emplace_back(float(x), float(y), float(z));
 
                 r = p.have_rgb ? static_cast<float>(p.get_R()) : static_cast<float>(p.intensity % 255);
                 g = p.have_rgb ? static_cast<float>(p.get_G()) : static_cast<float>(p.intensity % 255);
                 b = p.have_rgb ? static_cast<float>(p.get_B()) : static_cast<float>(p.intensity % 255);
 
-                colors[v] = vec3(r, g, b);
-                classification[v] = p.classification;
+                point_colors.emplace_back(r, g, b);
+                point_classes.push_back(p.classification);
+                if (points.size() == batch_size)
+                    add_batch();
             }
+            add_batch();
 
             // now bring the colors into the right range
             float range = (max_rgb < 256) ? 255.0f : USHRT_MAX;
@@ -29,6 +29,7 @@
 #include <easy3d/fileio/ply_reader_writer.h>
 #include <easy3d/core/point_cloud.h>
 #include <easy3d/core/types.h>
+#include <easy3d/core/point_kernels.h>
 #include <easy3d/util/logging.h>
 
 
@@ -92,8 +93,7 @@ namespace easy3d {
                 const dvec3 origin(p0.data());
                 Translator::instance()->set_translation(origin);
 
-                for (auto& p: points)
-                    p -= p0;
+                kernels::translate(points, -p0);
 
                 auto trans = cloud->add_model_property<dvec3>("translation", dvec3(0, 0, 0));
                 trans[0] = origin;
@@ -102,11 +102,8 @@ namespace easy3d {
             } else if (Translator::instance()->status() == Translator::TRANSLATE_USE_LAST_KNOWN_OFFSET) {
                 const dvec3 &origin = Translator::instance()->translation();
                 auto& points = cloud->get_vertex_property<vec3>("v:point").vector();
-                for (auto& p: points) {
-                    p.x -= static_cast<float>(origin.x);
-                    p.y -= static_cast<float>(origin.y);
-                    p.z -= static_cast<float>(origin.z);
-                }
+                const vec3 offset(static_cast<float>(origin.x), static_cast<float>(origin.y), static_cast<float>(origin.z));
+                kernels::translate(points, -offset);
 
                 auto trans = cloud->add_model_property<dvec3>("translation", dvec3(0, 0, 0));
                 trans[0] = origin;
@@ -156,11 +153,8 @@ namespace easy3d {
                 const dvec3& origin = trans[0];
                 for (auto& prop : element_vertex.vec3_properties) {
                     if (prop.name == "point") {
-                        for (auto& v : prop) {
-                            v.x += static_cast<float>(origin.x);
-                            v.y += static_cast<float>(origin.y);
-                            v.z += static_cast<float>(origin.z);
-                        }
+                        const vec3 offset(static_cast<float>(origin.x), static_cast<float>(origin.y), static_cast<float>(origin.z));
+                        kernels::translate(prop, offset);
                     }
                 }
             }
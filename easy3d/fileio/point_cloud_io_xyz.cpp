@@ -29,7 +29,9 @@
 #include <fstream>
 
 #include <easy3d/fileio/translator.h>
+#include <easy3d/fileio/block_writer.h>
 #include <easy3d/core/point_cloud.h>
+#include <easy3d/core/point_kernels.h>
 #include <easy3d/util/line_stream.h>
 #include <easy3d/util/logging.h>
 #include <easy3d/util/progress.h>
@@ -103,42 +105,36 @@ namespace easy3d {
 
 
 		bool save_xyz(const std::string& file_name, const PointCloud* cloud) {
-			std::ofstream output(file_name.c_str());
-			if (output.fail()) {
-                LOG(ERROR) << "could not open file: " << file_name;
-				return false;
-			}
-			output.precision(16);
+            BlockWriter writer(file_name);
+            if (!writer.is_open())
+                return false;
 
 			auto points = cloud->get_vertex_property<vec3>("v:point");
             auto trans = cloud->get_model_property<dvec3>("translation");
 
-            ProgressLogger progress(cloud->n_vertices(), true, false);
-            if (trans) { // has translation
-                const dvec3 &origin = trans[0];
-                for (auto v: cloud->vertices()) {
-                    if (progress.is_canceled()) {
-                        LOG(WARNING) << "saving point cloud file cancelled";
-                        return false;
-                    }
-                    output << points[v].x + origin.x << " "
-                           << points[v].y + origin.y << " "
-                           << points[v].z + origin.z << std::endl;
-                    progress.next();
-                }
-            }
-            else {
-                for (auto v: cloud->vertices()) {
-                    if (progress.is_canceled()) {
-                        LOG(WARNING) << "saving point cloud file cancelled";
-                        return false;
-                    }
-                    output << points[v] << std::endl;
-                    progress.next();
+            // the points are formatted in parallel (chunk by chunk) and written in order
+            ProgressLogger progress(cloud->vertices_size(), true, false);
+            auto format = [&](std::size_t first, std::size_t last, std::string &out) {
+                for (std::size_t i = first; i < last; ++i) {
+                    const PointCloud::Vertex v(static_cast<int>(i));
+                    if (cloud->is_deleted(v))
+                        continue;
+                    const vec3 &p = points[v];
+                    if (trans) { // has translation
+                        const dvec3 &origin = trans[0];
+                        append_ascii(out, dvec3(p.x + origin.x, p.y + origin.y, p.z + origin.z), 3);
+                    } else
+                        append_ascii(out, p, 3);
+                    out += '\n';
                 }
+            };
+            if (!writer.write_rows(cloud->vertices_size(), format, &progress)) {
+                if (progress.is_canceled())
+                    LOG(WARNING) << "saving point cloud file cancelled";
+                return false;
             }
 
-			return true;
+			return writer.close();
 		}
 
 
@@ -179,8 +175,7 @@ namespace easy3d {
                 const dvec3 origin(p0.data());
                 Translator::instance()->set_translation(origin);
 
-                for (auto& p : positions)
-                    p -= p0;
+                kernels::translate(positions, -p0);
 
                 auto trans = cloud->add_model_property<dvec3>("translation", dvec3(0, 0, 0));
                 trans[0] = origin;
@@ -189,11 +184,8 @@ namespace easy3d {
             } else if (Translator::instance()->status() == Translator::TRANSLATE_USE_LAST_KNOWN_OFFSET) {
                 const dvec3 &origin = Translator::instance()->translation();
                 auto& pts = cloud->get_vertex_property<vec3>("v:point").vector();
-                for (auto& p: pts) {
-                    p.x -= static_cast<float>(origin.x);
-                    p.y -= static_cast<float>(origin.y);
-                    p.z -= static_cast<float>(origin.z);
-                }
+                const vec3 offset(static_cast<float>(origin.x), static_cast<float>(origin.y), static_cast<float>(origin.z));
+                kernels::translate(pts, -offset);
 
                 auto trans = cloud->add_model_property<dvec3>("translation", dvec3(0, 0, 0));
                 trans[0] = origin;
@@ -207,27 +199,28 @@ namespace easy3d {
 
 		bool save_bxyz(const std::string& file_name, const PointCloud* cloud) {
 			// open file
-			std::ofstream output(file_name.c_str(), std::fstream::binary);
-			if (output.fail()) {
-				LOG(ERROR) << "could not open file: " << file_name;
-				return false;
-			}
+            BlockWriter writer(file_name);
+            if (!writer.is_open())
+                return false;
 
 			auto points = cloud->get_vertex_property<vec3>("v:point");
             auto trans = cloud->get_model_property<dvec3>("translation");
             if (trans) { // has translation
                 const dvec3& origin = trans[0];
-                for (auto v : cloud->vertices()) {
-                    const vec3& p = points[v];
-                    for (unsigned short i=0; i<3; ++i) {
-                        auto value = static_cast<float>(p[i] + origin[i]);
-                        output.write((char *)&value, sizeof(float));
+                auto format = [&](std::size_t first, std::size_t last, std::string &out) {
+                    out.reserve((last - first) * sizeof(vec3));
+                    for (std::size_t i = first; i < last; ++i) {
+                        const vec3& p = points[PointCloud::Vertex(static_cast<int>(i))];
+                        const vec3 q(static_cast<float>(p.x + origin.x), static_cast<float>(p.y + origin.y),
+                                     static_cast<float>(p.z + origin.z));
+                        out.append(reinterpret_cast<const char *>(q.data()), sizeof(vec3));
                     }
-                }
+                };
+                writer.write_rows(cloud->n_vertices(), format);
             }
-            else
-                output.write((char*)points.data(), static_cast<long>(cloud->n_vertices() * sizeof(vec3)));
-			return true;
+            else    // the whole array is written at once
+                writer.write(points.data(), cloud->n_vertices() * sizeof(vec3));
+			return writer.close();
 		}
 
 	} // namespace io
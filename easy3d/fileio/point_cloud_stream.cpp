@@ -0,0 +1,1320 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#include <easy3d/fileio/point_cloud_stream.h>
+
+#include <cstdio>
+#include <cstring>
+#include <cctype>
+#include <algorithm>
+#include <cstdint>
+#include <climits>  // for USHRT_MAX
+#include <cfloat>
+
+#include <easy3d/fileio/translator.h>
+#include <easy3d/fileio/block_writer.h>
+#include <easy3d/fileio/ply_reader_writer.h>
+#include <easy3d/core/point_cloud.h>
+#include <easy3d/core/point_kernels.h>
+#include <easy3d/util/file_system.h>
+#include <easy3d/util/string.h>
+#include <easy3d/util/stop_watch.h>
+#include <easy3d/util/logging.h>
+#include <3rd_party/lastools/LASlib/inc/lasreader.hpp>
+#include <3rd_party/lastools/LASlib/inc/laswriter.hpp>
+
+
+namespace easy3d {
+
+    // \cond
+    namespace internal {
+
+        // Sets the position of a file (which can be larger than 2 GB).
+        inline bool seek_file(FILE *file, int64_t offset) {
+#ifdef _WIN32
+            return _fseeki64(file, offset, SEEK_SET) == 0;
+#else
+            return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+        }
+
+
+        // A buffered input from a file, for binary values, ASCII numbers, and lines.
+        class InputBuffer {
+        public:
+            explicit InputBuffer(FILE *file, std::size_t size = 4u << 20)
+                    : file_(file), buffer_(size + 1, '\0'), pos_(0), end_(0) {}
+
+            // Makes (at least) n bytes available unless at the end of the file. Returns the available size.
+            std::size_t fill(std::size_t n) {
+                if (end_ - pos_ >= n || !file_)
+                    return end_ - pos_;
+                std::memmove(buffer_.data(), buffer_.data() + pos_, end_ - pos_);
+                end_ -= pos_;
+                pos_ = 0;
+                end_ += std::fread(buffer_.data() + end_, 1, buffer_.size() - 1 - end_, file_);
+                buffer_[end_] = '\0';   // so strtod() stops at the end of the data
+                return end_ - pos_;
+            }
+
+            bool read(void *data, std::size_t size) {
+                char *out = static_cast<char *>(data);
+                while (size > 0) {
+                    if (pos_ == end_ && fill(1) == 0)
+                        return false;
+                    const std::size_t n = std::min(size, end_ - pos_);
+                    std::memcpy(out, buffer_.data() + pos_, n);
+                    pos_ += n;
+                    out += n;
+                    size -= n;
+                }
+                return true;
+            }
+
+            // Reads a whitespace-separated number in ASCII format.
+            bool read_number(double &value) {
+                while (true) {
+                    if (pos_ == end_ && fill(1) == 0)
+                        return false;
+                    if (!std::isspace(static_cast<unsigned char>(buffer_[pos_])))
+                        break;
+                    ++pos_;
+                }
+                fill(128);  // a number is much shorter
+                char *begin = buffer_.data() + pos_;
+                char *stop = nullptr;
+                value = std::strtod(begin, &stop);
+                if (stop == begin)
+                    return false;
+                pos_ += static_cast<std::size_t>(stop - begin);
+                return true;
+            }
+
+            // Reads a line (without the line ending).
+            bool read_line(std::string &line) {
+                line.clear();
+                while (true) {
+                    if (pos_ == end_ && fill(1) == 0)
+                        return !line.empty();
+                    const char *begin = buffer_.data() + pos_;
+                    const char *newline = static_cast<const char *>(std::memchr(begin, '\n', end_ - pos_));
+                    if (newline) {
+                        line.append(begin, newline);
+                        pos_ += static_cast<std::size_t>(newline - begin) + 1;
+                        if (!line.empty() && line.back() == '\r')
+                            line.pop_back();
+                        return true;
+                    }
+                    line.append(begin, end_ - pos_);
+                    pos_ = end_;
+                }
+            }
+
+        private:
+            FILE *file_;
+            std::vector<char> buffer_;
+            std::size_t pos_;
+            std::size_t end_;
+        };
+
+
+        // The format-specific reading of the chunks.
+        class PointCloudSource {
+        public:
+            PointCloudSource() : num_points(0), failed(false), has_first_point_(false), translate_(false),
+                                 origin_(0, 0, 0) {}
+            virtual ~PointCloudSource() = default;
+
+            // Reads at most max_num points into the (empty) chunk. Returns the number of points read.
+            virtual std::size_t read(PointCloud *chunk, std::size_t max_num) = 0;
+            virtual bool bounding_box(Box3 &box) const { (void) box; return false; }
+
+            // Stores the origin as the model property "translation" of a chunk.
+            void set_translation(PointCloud *chunk) const {
+                if (translate_)
+                    chunk->model_property<dvec3>("translation", dvec3(0, 0, 0))[0] = origin_;
+            }
+
+            std::size_t num_points;   // 0 if unknown
+            bool failed;
+
+        protected:
+            // Determines the origin from the first point (according to the status of the Translator).
+            void set_first_point(const dvec3 &p) {
+                has_first_point_ = true;
+                if (Translator::instance()->status() == Translator::TRANSLATE_USE_FIRST_POINT) {
+                    origin_ = p;
+                    Translator::instance()->set_translation(origin_);
+                    translate_ = true;
+                    LOG(INFO) << "model translated w.r.t. the first vertex (" << origin_
+                              << "), stored as ModelProperty<dvec3>(\"translation\") of each chunk";
+                } else if (Translator::instance()->status() == Translator::TRANSLATE_USE_LAST_KNOWN_OFFSET) {
+                    origin_ = Translator::instance()->translation();
+                    translate_ = true;
+                    LOG(INFO) << "model translated w.r.t. last known reference point (" << origin_
+                              << "), stored as ModelProperty<dvec3>(\"translation\") of each chunk";
+                }
+            }
+
+            // Converts a point of the file into the (translated) coordinates of the chunks.
+            vec3 local(double x, double y, double z) {
+                if (!has_first_point_)
+                    set_first_point(dvec3(x, y, z));
+                return vec3(static_cast<float>(x - origin_.x), static_cast<float>(y - origin_.y),
+                            static_cast<float>(z - origin_.z));
+            }
+
+        private:
+            bool has_first_point_;
+            bool translate_;
+            dvec3 origin_;
+        };
+
+
+        //----------------------------------------------------------------------------------------------------------
+
+
+        // XYZ: each line has the x, y, z coordinates of a point (lines starting with '#' are comments)
+        class XyzSource : public PointCloudSource {
+        public:
+            explicit XyzSource(FILE *file) : file_(file), input_(file) {}
+            ~XyzSource() override { std::fclose(file_); }
+
+            std::size_t read(PointCloud *chunk, std::size_t max_num) override {
+                chunk->resize(static_cast<unsigned int>(max_num));
+                auto &points = chunk->points();
+                std::size_t count = 0;
+                while (count < max_num && input_.read_line(line_)) {
+                    if (line_.empty() || line_[0] == '#')
+                        continue;
+                    const char *str = line_.c_str();
+                    char *stop = nullptr;
+                    double xyz[3];
+                    bool ok = true;
+                    for (auto &c : xyz) {
+                        c = std::strtod(str, &stop);
+                        ok = ok && (stop != str);
+                        str = stop;
+                    }
+                    if (ok)
+                        points[count++] = local(xyz[0], xyz[1], xyz[2]);
+                }
+                chunk->resize(static_cast<unsigned int>(count));
+                return count;
+            }
+
+        private:
+            FILE *file_;
+            InputBuffer input_;
+            std::string line_;
+        };
+
+
+        // BXYZ: the x, y, z coordinates (float) of all points
+        class BxyzSource : public PointCloudSource {
+        public:
+            BxyzSource(FILE *file, std::size_t file_size) : file_(file), remaining_(file_size / sizeof(vec3)) {
+                num_points = remaining_;
+            }
+            ~BxyzSource() override { std::fclose(file_); }
+
+            std::size_t read(PointCloud *chunk, std::size_t max_num) override {
+                const std::size_t num = std::min(max_num, remaining_);
+                chunk->resize(static_cast<unsigned int>(num));
+                auto &points = chunk->points();
+                if (num > 0 && std::fread(points.data(), sizeof(vec3), num, file_) != num) {
+                    LOG(ERROR) << "failed reading points";
+                    failed = true;
+                    chunk->resize(0);
+                    return 0;
+                }
+                for (auto &p : points)
+                    p = local(p.x, p.y, p.z);
+                remaining_ -= num;
+                return num;
+            }
+
+        private:
+            FILE *file_;
+            std::size_t remaining_;
+        };
+
+
+        // BIN: three blocks storing points, colors (optional), and normals (optional), each led by the number of
+        // entries (int). Each block is read through its own file handle.
+        class BinSource : public PointCloudSource {
+        public:
+            explicit BinSource(const std::string &file_name) : files_{nullptr, nullptr, nullptr}, read_(0) {
+                for (auto &f : files_) {
+                    f = std::fopen(file_name.c_str(), "rb");
+                    if (!f) {
+                        failed = true;
+                        return;
+                    }
+                }
+                int counts[3] = {0, 0, 0};
+                int64_t offset = 0;
+                for (int i = 0; i < 3; ++i) {
+                    if (!seek_file(files_[i], offset) || std::fread(&counts[i], sizeof(int), 1, files_[i]) != 1)
+                        counts[i] = 0;  // the optional blocks may be missing
+                    offset += static_cast<int64_t>(sizeof(int)) + static_cast<int64_t>(counts[i]) * sizeof(vec3);
+                }
+                num_points = counts[0] > 0 ? static_cast<std::size_t>(counts[0]) : 0;
+                has_colors_ = counts[1] > 0;
+                has_normals_ = counts[2] > 0;
+                if (num_points == 0)
+                    failed = true;
+            }
+            ~BinSource() override {
+                for (auto f : files_) {
+                    if (f)
+                        std::fclose(f);
+                }
+            }
+
+            std::size_t read(PointCloud *chunk, std::size_t max_num) override {
+                const std::size_t num = std::min(max_num, num_points - read_);
+                chunk->resize(static_cast<unsigned int>(num));
+                if (num == 0)
+                    return 0;
+                auto &points = chunk->points();
+                bool ok = std::fread(points.data(), sizeof(vec3), num, files_[0]) == num;
+                if (has_colors_) {
+                    auto colors = chunk->vertex_property<vec3>("v:color");
+                    ok = ok && std::fread(colors.vector().data(), sizeof(vec3), num, files_[1]) == num;
+                }
+                if (has_normals_) {
+                    auto normals = chunk->vertex_property<vec3>("v:normal");
+                    ok = ok && std::fread(normals.vector().data(), sizeof(vec3), num, files_[2]) == num;
+                }
+                if (!ok) {
+                    LOG(ERROR) << "failed reading points";
+                    failed = true;
+                    chunk->resize(0);
+                    return 0;
+                }
+                for (auto &p : points)
+                    p = local(p.x, p.y, p.z);
+                read_ += num;
+                return num;
+            }
+
+        private:
+            FILE *files_[3];
+            bool has_colors_;
+            bool has_normals_;
+            std::size_t read_;
+        };
+
+
+        // PLY: the "vertex" element (the other elements are skipped)
+        class PlySource : public PointCloudSource {
+        public:
+            explicit PlySource(FILE *file) : file_(file), input_(file), binary_(false), swap_(false), vertex_(-1),
+                                             read_(0) {
+                failed = !read_header() || !skip_elements();
+            }
+            ~PlySource() override { std::fclose(file_); }
+
+            std::size_t read(PointCloud *chunk, std::size_t max_num) override {
+                const std::size_t num = std::min(max_num, num_points - read_);
+                chunk->resize(static_cast<unsigned int>(num));
+                if (num == 0)
+                    return 0;
+
+                auto &points = chunk->points();
+                std::vector<vec3> *normals = has_[NORMAL] ? &chunk->vertex_property<vec3>("v:normal").vector() : nullptr;
+                std::vector<vec3> *colors = (has_[COLOR] || has_[COLOR_255]) ? &chunk->vertex_property<vec3>("v:color").vector() : nullptr;
+                std::vector<vec2> *texcoords = has_[TEXCOORD] ? &chunk->vertex_property<vec2>("v:texcoord").vector() : nullptr;
+                std::vector<std::vector<float> *> floats;
+                for (const auto &name : float_names_)
+                    floats.push_back(&chunk->vertex_property<float>(name).vector());
+                std::vector<std::vector<int> *> ints;
+                for (const auto &name : int_names_)
+                    ints.push_back(&chunk->vertex_property<int>(name).vector());
+
+                for (std::size_t i = 0; i < num; ++i) {
+                    double xyz[3] = {0, 0, 0};
+                    for (const auto &c : columns_) {
+                        double v = 0;
+                        if (c.property->list) {
+                            if (!skip_list(*c.property)) return stop(chunk, i);
+                            continue;
+                        }
+                        if (!value(c.property->type, v)) return stop(chunk, i);
+                        switch (c.target) {
+                            case POINT:     xyz[c.index] = v; break;
+                            case NORMAL:    (*normals)[i][c.index] = static_cast<float>(v); break;
+                            case COLOR:     (*colors)[i][c.index] = static_cast<float>(v); break;
+                            case COLOR_255: (*colors)[i][c.index] = static_cast<float>(v / 255.0); break;
+                            case TEXCOORD:  (*texcoords)[i][c.index] = static_cast<float>(v); break;
+                            case FLOAT:     (*floats[c.index])[i] = static_cast<float>(v); break;
+                            case FLOAT_255: (*floats[c.index])[i] = static_cast<float>(v / 255.0); break;
+                            case INT:       (*ints[c.index])[i] = static_cast<int>(v); break;
+                            default: break;
+                        }
+                    }
+                    points[i] = local(xyz[0], xyz[1], xyz[2]);
+                }
+                read_ += num;
+                return num;
+            }
+
+        private:
+            enum Type { INT8, UINT8, INT16, UINT16, INT32, UINT32, FLOAT32, FLOAT64, UNKNOWN };
+            enum Target { POINT, NORMAL, COLOR, COLOR_255, TEXCOORD, FLOAT, FLOAT_255, INT, NUM_TARGETS };
+
+            struct Property {
+                std::string name;
+                Type type;          // the value type of a list
+                Type length_type;   // lists only
+                bool list;
+            };
+            struct Element {
+                std::string name;
+                std::size_t count;
+                std::vector<Property> properties;
+            };
+            struct Column {
+                const Property *property;
+                Target target;
+                int index;          // the component of a vector, or the index of a scalar property
+            };
+
+            static Type type_of(const std::string &s) {
+                if (s == "char" || s == "int8") return INT8;
+                if (s == "uchar" || s == "uint8") return UINT8;
+                if (s == "short" || s == "int16") return INT16;
+                if (s == "ushort" || s == "uint16") return UINT16;
+                if (s == "int" || s == "int32") return INT32;
+                if (s == "uint" || s == "uint32") return UINT32;
+                if (s == "float" || s == "float32") return FLOAT32;
+                if (s == "double" || s == "float64") return FLOAT64;
+                return UNKNOWN;
+            }
+
+            bool read_header() {
+                std::string line;
+                if (!input_.read_line(line) || line != "ply") {
+                    LOG(ERROR) << "not a ply file";
+                    return false;
+                }
+                while (input_.read_line(line)) {
+                    std::vector<std::string> words;
+                    string::split(line, ' ', words);
+                    if (words.empty() || words[0] == "comment" || words[0] == "obj_info")
+                        continue;
+                    if (words[0] == "end_header")
+                        break;
+                    if (words[0] == "format" && words.size() >= 2) {
+                        binary_ = words[1] != "ascii";
+                        const bool big_endian = words[1] == "binary_big_endian";
+                        swap_ = binary_ && (big_endian != io::is_big_endian());
+                    } else if (words[0] == "element" && words.size() >= 3) {
+                        elements_.push_back({words[1], std::stoull(words[2]), {}});
+                    } else if (words[0] == "property" && !elements_.empty()) {
+                        Property p;
+                        p.list = words.size() >= 5 && words[1] == "list";
+                        p.length_type = p.list ? type_of(words[2]) : UNKNOWN;
+                        p.type = type_of(p.list ? words[3] : words[1]);
+                        p.name = words.back();
+                        if (p.type == UNKNOWN || (p.list && p.length_type == UNKNOWN)) {
+                            LOG(ERROR) << "unknown type of property: " << line;
+                            return false;
+                        }
+                        elements_.back().properties.push_back(p);
+                    }
+                }
+
+                for (std::size_t i = 0; i < elements_.size(); ++i) {
+                    if (elements_[i].name == "vertex")
+                        vertex_ = static_cast<int>(i);
+                }
+                if (vertex_ < 0) {
+                    LOG(ERROR) << "no vertex element in the ply file";
+                    return false;
+                }
+                num_points = elements_[vertex_].count;
+                return setup_columns();
+            }
+
+            // Maps the properties of the vertex element to the properties of the chunks.
+            bool setup_columns() {
+                const auto &properties = elements_[vertex_].properties;
+                auto find = [&](const char *name) -> int {
+                    for (std::size_t i = 0; i < properties.size(); ++i) {
+                        if (properties[i].name == name && !properties[i].list) return static_cast<int>(i);
+                    }
+                    return -1;
+                };
+                auto is_float = [](Type t) { return t == FLOAT32 || t == FLOAT64; };
+
+                columns_.resize(properties.size());
+                for (std::size_t i = 0; i < properties.size(); ++i)
+                    columns_[i] = {&properties[i], NUM_TARGETS, 0};
+                for (auto &h : has_) h = false;
+
+                // vectors: all three (or two) components must exist (in either float or integer type)
+                struct Group { const char *names[3]; Target target; bool integer; };
+                const Group groups[] = {
+                        {{"x", "y", "z"}, POINT, false}, {{"X", "Y", "Z"}, POINT, false},
+                        {{"nx", "ny", "nz"}, NORMAL, false}, {{"normal_x", "normal_y", "normal_z"}, NORMAL, false},
+                        {{"r", "g", "b"}, COLOR, false},
+                        {{"red", "green", "blue"}, COLOR_255, true},
+                        {{"diffuse_red", "diffuse_green", "diffuse_blue"}, COLOR_255, true},
+                        {{"texcoord_x", "texcoord_y", nullptr}, TEXCOORD, false}
+                };
+                for (const auto &g : groups) {
+                    const Target t = (g.target == COLOR_255) ? COLOR : g.target;
+                    if (has_[t] || (t == COLOR && has_[COLOR_255]))
+                        continue;
+                    int idx[3] = {-1, -1, -1};
+                    bool complete = true;
+                    for (int k = 0; k < 3 && g.names[k]; ++k) {
+                        idx[k] = find(g.names[k]);
+                        complete = complete && idx[k] >= 0 && is_float(properties[idx[k]].type) != g.integer;
+                    }
+                    if (!complete)
+                        continue;
+                    for (int k = 0; k < 3 && g.names[k]; ++k)
+                        columns_[idx[k]] = {&properties[idx[k]], g.target, k};
+                    has_[g.target] = true;
+                }
+                if (!has_[POINT]) {
+                    LOG(ERROR) << "no vertex coordinates in the ply file";
+                    return false;
+                }
+
+                // the other scalar properties
+                for (std::size_t i = 0; i < properties.size(); ++i) {
+                    auto &c = columns_[i];
+                    if (c.target != NUM_TARGETS || properties[i].list)
+                        continue;
+                    std::string name = properties[i].name;
+                    if (name == "a") name = "alpha";
+                    if (name.find("v:") == std::string::npos)
+                        name = "v:" + name;
+                    if (is_float(properties[i].type)) {
+                        c = {&properties[i], FLOAT, static_cast<int>(float_names_.size())};
+                        float_names_.push_back(name);
+                    } else if (name == "v:alpha") {
+                        c = {&properties[i], FLOAT_255, static_cast<int>(float_names_.size())};
+                        float_names_.push_back(name);
+                    } else {
+                        c = {&properties[i], INT, static_cast<int>(int_names_.size())};
+                        int_names_.push_back(name);
+                    }
+                }
+                for (const auto &p : properties)
+                    LOG_IF(p.list, WARNING) << "list property '" << p.name << "' of the vertices skipped";
+                return true;
+            }
+
+            // Skips the elements before the vertices.
+            bool skip_elements() {
+                for (int e = 0; e < vertex_; ++e) {
+                    for (std::size_t i = 0; i < elements_[e].count; ++i) {
+                        for (const auto &p : elements_[e].properties) {
+                            double v = 0;
+                            if (p.list ? !skip_list(p) : !value(p.type, v)) {
+                                LOG(ERROR) << "failed reading element '" << elements_[e].name << "'";
+                                return false;
+                            }
+                        }
+                    }
+                }
+                return true;
+            }
+
+            bool skip_list(const Property &p) {
+                double length = 0, v = 0;
+                if (!value(p.length_type, length))
+                    return false;
+                for (int k = 0; k < static_cast<int>(length); ++k) {
+                    if (!value(p.type, v))
+                        return false;
+                }
+                return true;
+            }
+
+            bool value(Type type, double &v) {
+                if (!binary_)
+                    return input_.read_number(v);
+                static const std::size_t sizes[] = {1, 1, 2, 2, 4, 4, 4, 8};
+                unsigned char bytes[8];
+                const std::size_t size = sizes[type];
+                if (!input_.read(bytes, size))
+                    return false;
+                if (swap_)
+                    std::reverse(bytes, bytes + size);
+                switch (type) {
+                    case INT8:    { int8_t x;   std::memcpy(&x, bytes, 1); v = x; break; }
+                    case UINT8:   { uint8_t x;  std::memcpy(&x, bytes, 1); v = x; break; }
+                    case INT16:   { int16_t x;  std::memcpy(&x, bytes, 2); v = x; break; }
+                    case UINT16:  { uint16_t x; std::memcpy(&x, bytes, 2); v = x; break; }
+                    case INT32:   { int32_t x;  std::memcpy(&x, bytes, 4); v = x; break; }
+                    case UINT32:  { uint32_t x; std::memcpy(&x, bytes, 4); v = x; break; }
+                    case FLOAT32: { float x;    std::memcpy(&x, bytes, 4); v = x; break; }
+                    case FLOAT64: { double x;   std::memcpy(&x, bytes, 8); v = x; break; }
+                    default: return false;
+                }
+                return true;
+            }
+
+            std::size_t stop(PointCloud *chunk, std::size_t count) {
+                LOG(ERROR) << "failed reading vertex " << read_ + count;
+                failed = true;
+                chunk->resize(static_cast<unsigned int>(count));
+                read_ = num_points;
+                return count;
+            }
+
+        private:
+            FILE *file_;
+            InputBuffer input_;
+            bool binary_;
+            bool swap_;
+            std::vector<Element> elements_;
+            int vertex_;
+            std::vector<Column> columns_;
+            bool has_[NUM_TARGETS];
+            std::vector<std::string> float_names_;
+            std::vector<std::string> int_names_;
+            std::size_t read_;
+        };
+
+
+        // LAS/LAZ (using LASlib)
+        class LasSource : public PointCloudSource {
+        public:
+            explicit LasSource(const std::string &file_name) : reader_(nullptr), color_range_(0) {
+                LASreadOpener opener;
+                opener.set_file_name(file_name.c_str(), true);
+                reader_ = opener.open();
+                if (!reader_ || reader_->npoints <= 0) {
+                    failed = true;
+                    return;
+                }
+                num_points = static_cast<std::size_t>(reader_->npoints);
+            }
+            ~LasSource() override {
+                if (reader_) {
+                    reader_->close();
+                    delete reader_;
+                }
+            }
+
+            bool bounding_box(Box3 &box) const override {
+                if (!reader_)
+                    return false;
+                const LASheader &h = reader_->header;
+                box = Box3(vec3(static_cast<float>(h.min_x), static_cast<float>(h.min_y), static_cast<float>(h.min_z)),
+                           vec3(static_cast<float>(h.max_x), static_cast<float>(h.max_y), static_cast<float>(h.max_z)));
+                return true;
+            }
+
+            std::size_t read(PointCloud *chunk, std::size_t max_num) override {
+                chunk->resize(static_cast<unsigned int>(max_num));
+                auto &points = chunk->points();
+                auto &colors = chunk->vertex_property<vec3>("v:color").vector();
+                auto &classification = chunk->vertex_property<int>("v:classification").vector();
+                std::size_t count = 0;
+                float max_rgb = 0.0f;
+                while (count < max_num && reader_->read_point()) {
+                    LASpoint &p = reader_->point;
+                    // compute the actual coordinates as double floating point values
+                    p.compute_coordinates();
+                    points[count] = local(p.coordinates[0], p.coordinates[1], p.coordinates[2]);
+                    const float r = p.have_rgb ? static_cast<float>(p.get_R()) : static_cast<float>(p.intensity % 255);
+                    const float g = p.have_rgb ? static_cast<float>(p.get_G()) : static_cast<float>(p.intensity % 255);
+                    const float b = p.have_rgb ? static_cast<float>(p.get_B()) : static_cast<float>(p.intensity % 255);
+                    max_rgb = std::max(max_rgb, std::max(r, std::max(g, b)));
+                    colors[count] = vec3(r, g, b);
+                    classification[count] = p.classification;
+                    ++count;
+                }
+                chunk->resize(static_cast<unsigned int>(count));
+
+                // The colors are 16-bit or 8-bit values. Different from PointCloudIO::load(), the range is determined
+                // by the first chunk (instead of all points).
+                if (color_range_ == 0)
+                    color_range_ = (max_rgb < 256) ? 255.0f : USHRT_MAX;
+                for (auto &c : colors)
+                    c /= color_range_;
+                return count;
+            }
+
+        private:
+            LASreader *reader_;
+            float color_range_;
+        };
+
+    } // namespace internal
+    // \endcond
+
+
+    //--------------------------------------------------------------------------------------------------------------
+
+
+    PointCloudReader *PointCloudReader::open(const std::string &file_name, std::size_t chunk_size, bool prefetch) {
+        const std::string ext = string::to_lowercase(file_system::extension(file_name));
+        internal::PointCloudSource *source = nullptr;
+        if (ext == "las" || ext == "laz")
+            source = new internal::LasSource(file_name);
+        else if (ext == "bin")
+            source = new internal::BinSource(file_name);
+        else if (ext == "xyz" || ext == "bxyz" || ext == "ply") {
+            FILE *file = std::fopen(file_name.c_str(), "rb");
+            if (!file) {
+                LOG(ERROR) << "could not open file: " << file_name;
+                return nullptr;
+            }
+            if (ext == "xyz")
+                source = new internal::XyzSource(file);
+            else if (ext == "bxyz")
+                source = new internal::BxyzSource(file, static_cast<std::size_t>(file_system::file_size(file_name)));
+            else
+                source = new internal::PlySource(file);
+        } else {
+            LOG(ERROR) << "streaming is not supported for the file format: " << ext;
+            return nullptr;
+        }
+
+        if (source->failed) {
+            LOG(ERROR) << "could not open file: " << file_name;
+            delete source;
+            return nullptr;
+        }
+        return new PointCloudReader(source, chunk_size, prefetch);
+    }
+
+
+    PointCloudReader::PointCloudReader(internal::PointCloudSource *source, std::size_t chunk_size, bool prefetch)
+            : source_(source), chunk_size_(std::max<std::size_t>(chunk_size, 1)), prefetch_(prefetch),
+              chunks_{new PointCloud, new PointCloud}, counts_{0, 0}, current_(-1), ended_(false) {
+    }
+
+
+    PointCloudReader::~PointCloudReader() {
+        try {
+            group_.wait();  // the chunk being read in the background
+        }
+        catch (...) {
+        }
+        delete source_;
+        delete chunks_[0];
+        delete chunks_[1];
+    }
+
+
+    std::size_t PointCloudReader::num_points() const {
+        return source_->num_points;
+    }
+
+
+    bool PointCloudReader::bounding_box(Box3 &box) const {
+        return source_->bounding_box(box);
+    }
+
+
+    bool PointCloudReader::failed() const {
+        return source_->failed;
+    }
+
+
+    void PointCloudReader::read_chunk(int index) {
+        PointCloud *chunk = chunks_[index];
+        chunk->clear();
+        counts_[index] = source_->failed ? 0 : source_->read(chunk, chunk_size_);
+        source_->set_translation(chunk);
+    }
+
+
+    PointCloud *PointCloudReader::next() {
+        if (ended_)
+            return nullptr;     // no chunk is being read, and the other chunk has already been returned
+
+        const int index = (current_ + 1) % 2;
+        if (current_ < 0 || !prefetch_)
+            read_chunk(index);      // the first chunk, or no prefetching
+        else {
+            try {
+                group_.wait();      // the chunk has been requested at the previous call
+            }
+            catch (const std::exception &e) {
+                LOG(ERROR) << "failed reading the chunk: " << e.what();
+                source_->failed = true;
+                ended_ = true;
+                return nullptr;
+            }
+        }
+        current_ = index;
+        if (counts_[index] == 0) {
+            ended_ = true;
+            return nullptr;
+        }
+
+        // read the next chunk while this one is being processed
+        if (prefetch_) {
+            const int other = (index + 1) % 2;
+            group_.run([this, other]() { read_chunk(other); });
+        }
+        return chunks_[index];
+    }
+
+
+    //--------------------------------------------------------------------------------------------------------------
+
+
+    // \cond
+    namespace internal {
+
+        // Returns the translation of a chunk (zero if it doesn't have the "translation" model property).
+        inline dvec3 translation_of(const PointCloud *chunk) {
+            auto trans = chunk->get_model_property<dvec3>("translation");
+            return trans ? trans[0] : dvec3(0, 0, 0);
+        }
+
+
+        // Collects the values of a property at the non-deleted points of a chunk.
+        template<typename T>
+        inline void collect_values(const PointCloud *chunk, const std::string &name, std::vector<T> &values) {
+            values.clear();
+            auto prop = chunk->get_vertex_property<T>(name);
+            if (!prop) {
+                LOG_N_TIMES(1, ERROR) << "chunk has no property '" << name << "' (the first chunk has it)";
+                values.resize(chunk->n_vertices());
+                return;
+            }
+            values.reserve(chunk->n_vertices());
+            for (auto v : chunk->vertices())
+                values.push_back(prop[v]);
+        }
+
+
+        class XyzWriter : public PointCloudWriter {
+        public:
+            explicit XyzWriter(const std::string &file_name) : writer_(file_name) {}
+            ~XyzWriter() override {
+                if (!closed_)
+                    close();
+            }
+            bool is_open() const { return writer_.is_open(); }
+
+            bool write(const PointCloud *chunk) override {
+                auto points = chunk->get_vertex_property<vec3>("v:point");
+                const dvec3 origin = translation_of(chunk);
+                auto format = [&](std::size_t first, std::size_t last, std::string &out) {
+                    for (std::size_t i = first; i < last; ++i) {
+                        const PointCloud::Vertex v(static_cast<int>(i));
+                        if (chunk->is_deleted(v))
+                            continue;
+                        const vec3 &p = points[v];
+                        io::append_ascii(out, dvec3(p.x + origin.x, p.y + origin.y, p.z + origin.z), 3);
+                        out += '\n';
+                    }
+                };
+                num_points_ += chunk->n_vertices();
+                return writer_.write_rows(chunk->vertices_size(), format);
+            }
+
+            bool close() override {
+                closed_ = true;
+                return writer_.close();
+            }
+
+        private:
+            io::BlockWriter writer_;
+        };
+
+
+        class BxyzWriter : public PointCloudWriter {
+        public:
+            explicit BxyzWriter(const std::string &file_name) : writer_(file_name) {}
+            ~BxyzWriter() override {
+                if (!closed_)
+                    close();
+            }
+            bool is_open() const { return writer_.is_open(); }
+
+            bool write(const PointCloud *chunk) override {
+                auto trans = chunk->get_model_property<dvec3>("translation");
+                const auto &points = chunk->points();
+                if (!trans && !chunk->has_garbage())
+                    writer_.write(points.data(), points.size() * sizeof(vec3));   // the entire block
+                else {
+                    const dvec3 origin = translation_of(chunk);
+                    std::string out;
+                    out.reserve(chunk->n_vertices() * sizeof(vec3));
+                    for (auto v : chunk->vertices()) {
+                        const vec3 &p = points[v.idx()];
+                        io::append_binary(out, vec3(static_cast<float>(p.x + origin.x), static_cast<float>(p.y + origin.y),
+                                                    static_cast<float>(p.z + origin.z)));
+                    }
+                    writer_.write(out);
+                }
+                num_points_ += chunk->n_vertices();
+                return true;
+            }
+
+            bool close() override {
+                closed_ = true;
+                return writer_.close();
+            }
+
+        private:
+            io::BlockWriter writer_;
+        };
+
+
+        // The colors and normals blocks are written to temporary files, which are appended to the points block by
+        // close() (the blocks are led by the number of points, which is not known in advance).
+        class BinWriter : public PointCloudWriter {
+        public:
+            explicit BinWriter(const std::string &file_name)
+                    : file_name_(file_name), points_(file_name), colors_(nullptr), normals_(nullptr), first_(true) {
+                const int placeholder = 0;
+                points_.write(&placeholder, sizeof(int));
+            }
+            ~BinWriter() override {
+                if (!closed_)
+                    close();
+                delete colors_;
+                delete normals_;
+            }
+            bool is_open() const { return points_.is_open(); }
+
+            bool write(const PointCloud *chunk) override {
+                if (first_) {
+                    first_ = false;
+                    if (chunk->get_vertex_property<vec3>("v:color"))
+                        colors_ = new io::BlockWriter(file_name_ + ".colors.tmp");
+                    if (chunk->get_vertex_property<vec3>("v:normal"))
+                        normals_ = new io::BlockWriter(file_name_ + ".normals.tmp");
+                }
+
+                const dvec3 origin = translation_of(chunk);
+                std::string out;
+                out.reserve(chunk->n_vertices() * sizeof(vec3));
+                const auto &points = chunk->points();
+                for (auto v : chunk->vertices()) {
+                    const vec3 &p = points[v.idx()];
+                    io::append_binary(out, vec3(static_cast<float>(p.x + origin.x), static_cast<float>(p.y + origin.y),
+                                                static_cast<float>(p.z + origin.z)));
+                }
+                points_.write(out);
+
+                std::vector<vec3> values;
+                if (colors_) {
+                    collect_values(chunk, "v:color", values);
+                    colors_->write(values.data(), values.size() * sizeof(vec3));
+                }
+                if (normals_) {
+                    collect_values(chunk, "v:normal", values);
+                    normals_->write(values.data(), values.size() * sizeof(vec3));
+                }
+                num_points_ += chunk->n_vertices();
+                return true;
+            }
+
+            bool close() override {
+                closed_ = true;
+                const int num = static_cast<int>(num_points_);
+                bool success = append(colors_, file_name_ + ".colors.tmp", num);
+                success = append(normals_, file_name_ + ".normals.tmp", num) && success;
+                success = points_.close() && success;
+
+                // now the number of points is known
+                FILE *file = std::fopen(file_name_.c_str(), "r+b");
+                if (!file)
+                    return false;
+                success = std::fwrite(&num, sizeof(int), 1, file) == 1 && success;
+                std::fclose(file);
+                return success;
+            }
+
+        private:
+            // Appends a block (and deletes its temporary file).
+            bool append(io::BlockWriter *&block, const std::string &tmp_file, int num) {
+                if (!block) {
+                    const int zero = 0;
+                    points_.write(&zero, sizeof(int));
+                    return true;
+                }
+                points_.write(&num, sizeof(int));
+                bool success = block->close();
+                delete block;
+                block = nullptr;
+
+                FILE *file = std::fopen(tmp_file.c_str(), "rb");
+                if (file) {
+                    std::vector<char> buffer(4u << 20);
+                    std::size_t n = 0;
+                    while ((n = std::fread(buffer.data(), 1, buffer.size(), file)) > 0)
+                        points_.write(buffer.data(), n);
+                    std::fclose(file);
+                } else
+                    success = false;
+                file_system::delete_file(tmp_file);
+                return success;
+            }
+
+        private:
+            std::string file_name_;
+            io::BlockWriter points_;
+            io::BlockWriter *colors_;
+            io::BlockWriter *normals_;
+            bool first_;
+        };
+
+
+        // The number of vertices in the header is a fixed-width field, which is updated by close().
+        class PlyStreamWriter : public PointCloudWriter {
+        public:
+            explicit PlyStreamWriter(const std::string &file_name)
+                    : file_name_(file_name), writer_(file_name), binary_(file_name.find("ascii") == std::string::npos),
+                      count_offset_(0) {}
+            ~PlyStreamWriter() override {
+                if (!closed_)
+                    close();
+            }
+            bool is_open() const { return writer_.is_open(); }
+
+            bool write(const PointCloud *chunk) override {
+                if (vec3_names_.empty() && !write_header(chunk))
+                    return false;
+
+                io::Element element("vertex", chunk->n_vertices());
+                for (const auto &name : vec3_names_) {
+                    element.vec3_properties.emplace_back(name.substr(2));
+                    collect_values(chunk, name, element.vec3_properties.back());
+                }
+                for (const auto &name : vec2_names_) {
+                    element.vec2_properties.emplace_back(name.substr(2));
+                    collect_values(chunk, name, element.vec2_properties.back());
+                }
+                for (const auto &name : float_names_) {
+                    element.float_properties.emplace_back(name.substr(2));
+                    collect_values(chunk, name, element.float_properties.back());
+                }
+                for (const auto &name : int_names_) {
+                    element.int_properties.emplace_back(name.substr(2));
+                    collect_values(chunk, name, element.int_properties.back());
+                }
+
+                auto trans = chunk->get_model_property<dvec3>("translation");
+                if (trans) { // has translation
+                    const dvec3 &origin = trans[0];
+                    const vec3 offset(static_cast<float>(origin.x), static_cast<float>(origin.y), static_cast<float>(origin.z));
+                    kernels::translate(element.vec3_properties[0], offset);    // "v:point" is the first one
+                }
+
+                auto format = [&](std::size_t first, std::size_t last, std::string &out) {
+                    io::PlyWriter::format(element, first, last, binary_, false, out);
+                };
+                num_points_ += element.num_instances;
+                return writer_.write_rows(element.num_instances, format);
+            }
+
+            bool close() override {
+                closed_ = true;
+                if (vec3_names_.empty()) {
+                    LOG(ERROR) << "no points written";
+                    writer_.close();
+                    return false;
+                }
+                if (!writer_.close())
+                    return false;
+                // now the number of points is known
+                FILE *file = std::fopen(file_name_.c_str(), "r+b");
+                if (!file)
+                    return false;
+                const std::string count = std::to_string(num_points_);
+                bool success = seek_file(file, static_cast<int64_t>(count_offset_)) &&
+                               std::fwrite(count.data(), 1, count.size(), file) == count.size();
+                std::fclose(file);
+                return success;
+            }
+
+        private:
+            // The properties (except the list properties) of the first chunk determine the properties of the file.
+            bool write_header(const PointCloud *chunk) {
+                vec3_names_.push_back("v:point");
+                for (const auto &name : chunk->vertex_properties()) {
+                    if (name == "v:point")
+                        continue;
+                    if (chunk->get_vertex_property<vec3>(name))
+                        vec3_names_.push_back(name);
+                    else if (chunk->get_vertex_property<vec2>(name))
+                        vec2_names_.push_back(name);
+                    else if (chunk->get_vertex_property<float>(name))
+                        float_names_.push_back(name);
+                    else if (chunk->get_vertex_property<int>(name))
+                        int_names_.push_back(name);
+                }
+
+                std::vector<io::Element> elements(1, io::Element("vertex", 0));
+                io::Element &element = elements[0];
+                for (const auto &name : vec3_names_)
+                    element.vec3_properties.emplace_back(name.substr(2));
+                for (const auto &name : vec2_names_)
+                    element.vec2_properties.emplace_back(name.substr(2));
+                for (const auto &name : float_names_)
+                    element.float_properties.emplace_back(name.substr(2));
+                for (const auto &name : int_names_)
+                    element.int_properties.emplace_back(name.substr(2));
+                std::string header = io::PlyWriter::header(elements, "", binary_);
+
+                // reserve a fixed-width field for the number of vertices (filled with spaces)
+                const std::string key = "element vertex ";
+                const std::size_t pos = header.find(key + "0\n");
+                if (pos == std::string::npos) {
+                    LOG(ERROR) << "unexpected ply header";
+                    return false;
+                }
+                count_offset_ = pos + key.size();
+                header.replace(count_offset_, 1, std::string(20, ' '));
+                writer_.write(header);
+                LOG_IF(!binary_, WARNING) << "you're writing an ASCII ply file. Use binary format for better performance";
+                return true;
+            }
+
+        private:
+            std::string file_name_;
+            io::BlockWriter writer_;
+            bool binary_;
+            std::size_t count_offset_;
+            std::vector<std::string> vec3_names_;
+            std::vector<std::string> vec2_names_;
+            std::vector<std::string> float_names_;
+            std::vector<std::string> int_names_;
+        };
+
+
+        // LAS/LAZ (using LASlib). The point format, offset, and scale factors are determined by the first chunk.
+        class LasStreamWriter : public PointCloudWriter {
+        public:
+            explicit LasStreamWriter(const std::string &file_name) : writer_(nullptr), has_colors_(false) {
+                opener_.set_file_name(file_name.c_str());
+            }
+            ~LasStreamWriter() override {
+                if (!closed_)
+                    close();
+            }
+            bool is_open() const { return opener_.active(); }
+
+            bool write(const PointCloud *chunk) override {
+                const dvec3 origin = translation_of(chunk);
+                if (!writer_ && !open(chunk, origin))
+                    return false;
+
+                auto points = chunk->get_vertex_property<vec3>("v:point");
+                auto colors = chunk->get_vertex_property<vec3>("v:color");
+                auto classification = chunk->get_vertex_property<int>("v:classification");
+                const double height = std::max<double>(box_.range(2), DBL_EPSILON);
+                for (auto v : chunk->vertices()) {
+                    const vec3 &p = points[v];
+                    point_.coordinates[0] = p[0] + origin.x;
+                    point_.coordinates[1] = p[1] + origin.y;
+                    point_.coordinates[2] = p[2] + origin.z;
+                    // populate the point
+                    point_.compute_XYZ();
+                    if (has_colors_ && colors) {
+                        const vec3 &c = colors[v];
+                        point_.set_R(static_cast<unsigned short>(clamp(c[0], 0.0f, 1.0f) * USHRT_MAX));
+                        point_.set_G(static_cast<unsigned short>(clamp(c[1], 0.0f, 1.0f) * USHRT_MAX));
+                        point_.set_B(static_cast<unsigned short>(clamp(c[2], 0.0f, 1.0f) * USHRT_MAX));
+                    } else {
+                        // if the model doesn't have color, I store the height values as the intensity
+                        const double h = (point_.coordinates[2] - box_.min_coord(2)) / height;
+                        point_.set_intensity(static_cast<unsigned short>(clamp(h, 0.0, 1.0) * 255));
+                    }
+                    if (classification)
+                        point_.set_classification(static_cast<U8>(classification[v]));
+                    point_.set_gps_time(0.0006 * static_cast<double>(num_points_));
+                    // write the point
+                    writer_->write_point(&point_);
+                    // add it to the inventory
+                    writer_->update_inventory(&point_);
+                    ++num_points_;
+                }
+                return true;
+            }
+
+            bool close() override {
+                closed_ = true;
+                if (!writer_) {
+                    LOG(ERROR) << "no points written";
+                    return false;
+                }
+                // update the header
+                writer_->update_header(&header_, TRUE);
+                // close the writer
+                I64 total_bytes = writer_->close();
+                LOG(INFO) << total_bytes << " bytes for " << writer_->npoints << " points";
+                const bool success = writer_->npoints > 0;
+                delete writer_;
+                writer_ = nullptr;
+                return success;
+            }
+
+        private:
+            bool open(const PointCloud *chunk, const dvec3 &origin) {
+                if (!box_.is_valid()) {
+                    // the points of the following chunks may be far away from the first chunk. Since the integers
+                    // saved in LAS files are coded on 32 bits (i.e., +/-2.10^9), a scale factor of 5.10^-7 times the
+                    // extent of the first chunk allows to store points up to 1000 times the extent.
+                    const Box3 &box = chunk->bounding_box();
+                    const vec3 o(static_cast<float>(origin.x), static_cast<float>(origin.y), static_cast<float>(origin.z));
+                    box_ = Box3(box.min_point() + o, box.max_point() + o);
+                    for (int i = 0; i < 3; ++i)
+                        scale_[i] = 5.0e-7 * std::max<double>(box_.range(i), 1.0e-3);
+                } else {
+                    //optimal scale (for accuracy) --> 1e-9 because the maximum integer is roughly +/-2e+9
+                    for (int i = 0; i < 3; ++i)
+                        scale_[i] = 1.0e-9 * std::max<double>(box_.range(i), DBL_EPSILON);
+                }
+                header_.x_scale_factor = scale_[0];
+                header_.y_scale_factor = scale_[1];
+                header_.z_scale_factor = scale_[2];
+                header_.x_offset = box_.center().x;
+                header_.y_offset = box_.center().y;
+                header_.z_offset = box_.center().z;
+
+                // we need a new LAS point type for adding RGB
+                has_colors_ = static_cast<bool>(chunk->get_vertex_property<vec3>("v:color"));
+                if (has_colors_) {
+                    header_.point_data_format = 3;
+                    header_.point_data_record_length = 34;  // 28 + 6
+                } else {
+                    header_.point_data_format = 1;
+                    header_.point_data_record_length = 28;
+                }
+                LOG_IF(chunk->get_vertex_property<vec3>("v:normal"), WARNING)
+                                << "normals discarded when saving to LAS or LAZ format";
+
+                point_.init(&header_, header_.point_data_format, header_.point_data_record_length, nullptr);
+                writer_ = opener_.open(&header_);
+                if (!writer_) {
+                    LOG(ERROR) << "could not save file";
+                    return false;
+                }
+                return true;
+            }
+
+        private:
+            LASwriteOpener opener_;
+            LASwriter *writer_;
+            LASheader header_;
+            LASpoint point_;
+            double scale_[3];
+            bool has_colors_;
+        };
+
+    } // namespace internal
+    // \endcond
+
+
+    PointCloudWriter *PointCloudWriter::create(const std::string &file_name) {
+        const std::string ext = string::to_lowercase(file_system::extension(file_name));
+        PointCloudWriter *writer = nullptr;
+        bool is_open = false;
+        if (ext == "ply") {
+            auto w = new internal::PlyStreamWriter(file_name);
+            is_open = w->is_open();
+            writer = w;
+        } else if (ext == "xyz") {
+            auto w = new internal::XyzWriter(file_name);
+            is_open = w->is_open();
+            writer = w;
+        } else if (ext == "bxyz") {
+            auto w = new internal::BxyzWriter(file_name);
+            is_open = w->is_open();
+            writer = w;
+        } else if (ext == "bin") {
+            auto w = new internal::BinWriter(file_name);
+            is_open = w->is_open();
+            writer = w;
+        } else if (ext == "las" || ext == "laz") {
+            auto w = new internal::LasStreamWriter(file_name);
+            is_open = w->is_open();
+            writer = w;
+        } else {
+            LOG(ERROR) << "streaming is not supported for the file format: " << ext;
+            return nullptr;
+        }
+
+        if (!is_open) {
+            LOG(ERROR) << "could not create file: " << file_name;
+            writer->closed_ = true;     // nothing to complete
+            delete writer;
+            return nullptr;
+        }
+        return writer;
+    }
+
+
+    //--------------------------------------------------------------------------------------------------------------
+
+
+    bool PointCloudStream::process(const std::string &input_file, const std::string &output_file,
+                                   const std::function<void(PointCloud *chunk)> &func, std::size_t chunk_size) {
+        StopWatch w;
+        PointCloudReader *reader = PointCloudReader::open(input_file, chunk_size);
+        if (!reader)
+            return false;
+        PointCloudWriter *writer = PointCloudWriter::create(output_file);
+        if (!writer) {
+            delete reader;
+            return false;
+        }
+
+        Box3 box;
+        if (reader->bounding_box(box))
+            writer->set_bounding_box(box);
+
+        std::size_t num_read = 0;
+        bool success = true;
+        while (PointCloud *chunk = reader->next()) {
+            num_read += chunk->n_vertices();
+            if (func)
+                func(chunk);
+            if (!writer->write(chunk)) {
+                success = false;
+                break;
+            }
+        }
+        success = success && !reader->failed();
+        success = writer->close() && success;
+
+        LOG(INFO) << num_read << " points read, " << writer->num_points() << " points written. "
+                  << w.time_string();
+        delete writer;
+        delete reader;
+        return success;
+    }
+
+} // namespace easy3d
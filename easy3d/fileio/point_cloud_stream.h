@@ -0,0 +1,211 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#ifndef EASY3D_FILEIO_POINT_CLOUD_STREAM_H
+#define EASY3D_FILEIO_POINT_CLOUD_STREAM_H
+
+#include <string>
+#include <functional>
+
+#include <easy3d/core/types.h>
+#include <easy3d/util/thread_pool.h>
+
+
+namespace easy3d {
+
+    class PointCloud;
+
+    namespace internal {
+        class PointCloudSource;
+    }
+
+    /**
+     * \brief Reads a point cloud file chunk by chunk, without loading the whole file into memory.
+     * \class PointCloudReader easy3d/fileio/point_cloud_stream.h
+     * \details Each chunk is a PointCloud holding up to chunk_size() consecutive points of the file with their
+     *      attributes (the same properties as PointCloudIO::load() would create). The supported formats are
+     *      XYZ, BXYZ, BIN, PLY (the "vertex" element), and LAS/LAZ. If the Translator is enabled, the points of all
+     *      chunks are translated w.r.t. the same origin, which is stored as the model property "translation" of
+     *      each chunk. While a chunk is being processed, the next chunk is read by a worker of the ThreadPool
+     *      (unless prefetching is disabled).
+     *
+     *      Example usage:
+     *      \code
+     *          PointCloudReader* reader = PointCloudReader::open(file_name);
+     *          while (PointCloud* chunk = reader->next()) {
+     *              // process the chunk
+     *          }
+     *          delete reader;
+     *      \endcode
+     * \see PointCloudWriter, PointCloudStream
+     */
+    class PointCloudReader {
+    public:
+        /**
+         * \brief Opens a point cloud file for reading. The file format is determined by the file extension.
+         * \param file_name The name of the file.
+         * \param chunk_size The maximum number of points of each chunk.
+         * \param prefetch True to read the next chunk in the background while the current one is being processed.
+         * \return The reader (to be deleted by the caller), or nullptr if the file could not be opened.
+         */
+        static PointCloudReader *open(const std::string &file_name, std::size_t chunk_size = 1u << 20,
+                                      bool prefetch = true);
+
+        ~PointCloudReader();
+
+        /// \brief Returns the number of points in the file, or 0 if it is not known in advance (e.g., XYZ).
+        std::size_t num_points() const;
+        /// \brief Returns the maximum number of points of each chunk.
+        std::size_t chunk_size() const { return chunk_size_; }
+
+        /**
+         * \brief Returns the bounding box of the points (without translation) if it is known in advance (e.g., from
+         *      the header of a LAS file).
+         * \return False if the bounding box is not known.
+         */
+        bool bounding_box(Box3 &box) const;
+
+        /**
+         * \brief Reads the next chunk.
+         * \return The next chunk, which is owned by the reader and remains valid until the next call. It can be
+         *      modified, e.g., by an algorithm before writing it. nullptr is returned at the end of the file or if
+         *      an error occurred (see failed()), and by all the subsequent calls.
+         */
+        PointCloud *next();
+
+        /// \brief Returns whether an error occurred while reading the file.
+        bool failed() const;
+
+    private:
+        PointCloudReader(internal::PointCloudSource *source, std::size_t chunk_size, bool prefetch);
+        void read_chunk(int index);
+
+    private:
+        internal::PointCloudSource *source_;    // the format-specific reading
+        std::size_t chunk_size_;
+        bool prefetch_;
+        PointCloud *chunks_[2];     // double buffering: one being used, the other one being read
+        std::size_t counts_[2];
+        int current_;               // the chunk returned by next(), -1 before the first call
+        bool ended_;                // the end of the file (or an error) has been reached
+        TaskGroup group_;
+
+        //copying disabled
+        PointCloudReader(const PointCloudReader &);
+        PointCloudReader &operator=(const PointCloudReader &);
+    };
+
+
+    /**
+     * \brief Writes a point cloud file chunk by chunk, without holding the whole point cloud in memory.
+     * \class PointCloudWriter easy3d/fileio/point_cloud_stream.h
+     * \details The supported formats are XYZ, BXYZ, BIN, PLY (binary, unless the file name contains "ascii"), and
+     *      LAS/LAZ. The attributes written are determined by the first chunk, and all the following chunks must
+     *      have the same attributes. The "translation" model property of the chunks (if exists) is added back to
+     *      the points. The number of points is not needed in advance: the headers are completed by close().
+     * \see PointCloudReader, PointCloudStream
+     */
+    class PointCloudWriter {
+    public:
+        /**
+         * \brief Creates a point cloud file for writing. The file format is determined by the file extension.
+         * \return The writer (to be deleted by the caller), or nullptr if the file could not be created.
+         */
+        static PointCloudWriter *create(const std::string &file_name);
+
+        /**
+         * \brief Destructor. The file is completed by close() if it has not been called, but then failures are not
+         *      reported. So call close() explicitly to check the result.
+         */
+        virtual ~PointCloudWriter() = default;
+
+        /**
+         * \brief Sets the bounding box of all the points (without translation) before the first chunk is written.
+         * \details This is only used by the LAS format to choose the offset and the scale factors. If not set, they
+         *      are determined from the first chunk such that points up to 1000 times its extent can be stored.
+         */
+        void set_bounding_box(const Box3 &box) { box_ = box; }
+
+        /// \brief Appends the (non-deleted) points of a chunk to the file.
+        virtual bool write(const PointCloud *chunk) = 0;
+
+        /**
+         * \brief Completes the header (if needed) and closes the file.
+         * \return True if all the points were successfully written.
+         */
+        virtual bool close() = 0;
+
+        /// \brief Returns the number of points written so far.
+        std::size_t num_points() const { return num_points_; }
+
+    protected:
+        PointCloudWriter() : num_points_(0), closed_(false) {}
+
+    protected:
+        std::size_t num_points_;
+        Box3 box_;
+        bool closed_;   // set by close(). The destructors of the writers call close() if it has not been called.
+    };
+
+
+    /**
+     * \brief Processes point cloud files chunk by chunk in constant memory.
+     * \class PointCloudStream easy3d/fileio/point_cloud_stream.h
+     * \details Chunk-wise algorithms can be applied to huge files, e.g.,
+     *      \code
+     *          // adds noise to the points and converts a LAS file into a PLY file
+     *          PointCloudStream::process("input.las", "output.ply", [&](PointCloud *chunk) {
+     *              GaussianNoise::apply(chunk, sigma);
+     *          });
+     *          // grid simplification (see StreamingGridSimplification)
+     *          StreamingGridSimplification grid(cell_size);
+     *          PointCloudStream::process("input.ply", "output.ply", [&](PointCloud *chunk) { grid.apply(chunk); });
+     *      \endcode
+     */
+    class PointCloudStream {
+    public:
+        /**
+         * \brief Reads a file chunk by chunk, applies a function to each chunk, and writes the chunks to a file.
+         * \param input_file The input file.
+         * \param output_file The output file.
+         * \param func The function applied to each chunk before writing it. It can modify the chunk, e.g., transform
+         *      the points or delete some of them. It can be empty.
+         * \param chunk_size The maximum number of points of each chunk.
+         * \return True on success.
+         */
+        static bool process(const std::string &input_file, const std::string &output_file,
+                            const std::function<void(PointCloud *chunk)> &func, std::size_t chunk_size = 1u << 20);
+
+        /// \brief Converts a point cloud file into another format in constant memory.
+        static bool convert(const std::string &input_file, const std::string &output_file,
+                            std::size_t chunk_size = 1u << 20) {
+            return process(input_file, output_file, nullptr, chunk_size);
+        }
+    };
+
+} // namespace easy3d
+
+#endif  // EASY3D_FILEIO_POINT_CLOUD_STREAM_H
@@ -25,6 +25,7 @@
  ********************************************************************/
 
 #include <easy3d/fileio/poly_mesh_io.h>
+#include <easy3d/fileio/binary_container.h>
 #include <easy3d/core/poly_mesh.h>
 #include <easy3d/util/file_system.h>
 #include <easy3d/util/stop_watch.h>
@@ -48,6 +49,8 @@ namespace easy3d {
             success = io::load_pm(file_name, mesh);
         else if (ext == "mesh")
             success = io::load_mesh(file_name, mesh);
+        else if (ext == "e3d")
+            success = BinaryContainer::load(file_name, mesh);
         else if (ext.empty()) {
             LOG(ERROR) << "unknown file format: no extension" << ext;
             success = false;
@@ -101,6 +104,8 @@ namespace easy3d {
             success = io::save_pm(final_name, mesh);
         else if (ext == "mesh")
             success = io::save_mesh(file_name, mesh);
+        else if (ext == "e3d")
+            success = BinaryContainer::save(final_name, mesh);
         else {
             LOG(ERROR) << "unknown file format: " << ext;
             success = false;
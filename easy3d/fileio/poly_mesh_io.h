@@ -46,7 +46,7 @@ namespace easy3d {
 
         /**
          * \brief Reads a polyhedral mesh from a file.
-         * \details File extension determines file format (now only '*.plm' format is supported).
+         * \details File extension determines file format (plm, pm, mesh, e3d).
          * \param file_name The file name.
          * \return The pointer of the polyhedral mesh (nullptr if failed).
          */
@@ -54,7 +54,7 @@ namespace easy3d {
 
         /**
          * \brief Saves a polyhedral mesh to a file.
-         * \details File extension determines file format (now only '*.plm' format is supported).
+         * \details File extension determines file format (plm, pm, mesh, e3d).
          * \param file_name The file name.
          * \param mesh The polyhedral mesh.
          * \return The status of the operation
@@ -27,6 +27,7 @@
 #include <easy3d/fileio/poly_mesh_io.h>
 
 #include <cstring> //for strcmp
+#include <set>
 
 #include <easy3d/fileio/translator.h>
 #include <easy3d/core/poly_mesh.h>
@@ -197,7 +198,8 @@ namespace easy3d {
 
                     LOG(INFO) << "reading " << number_of_tetrahedra << " tetrahedra...";
 
-                    // tet indices
+                    // tet indices (all tetrahedra are added at once, see PolyMesh::add_tetras())
+                    std::vector<unsigned int> tets(number_of_tetrahedra * 4);
                     int indices[4];
                     for (int i = 0; i < number_of_tetrahedra; i++) {
                         if (5 != fscanf(mesh_file, " %d %d %d %d %d",
@@ -207,14 +209,17 @@ namespace easy3d {
                             fclose(mesh_file);
                             return false;
                         }
-                        mesh->add_tetra(
-                                vertices[indices[0] - 1],
-                                vertices[indices[1] - 1],
-                                vertices[indices[2] - 1],
-                                vertices[indices[3] - 1]
-                        );
+                        for (int j = 0; j < 4; ++j) {
+                            if (indices[j] < 1 || indices[j] > static_cast<int>(vertices.size())) {
+                                LOG(ERROR) << "vertex index out of range: " << indices[j];
+                                fclose(mesh_file);
+                                return false;
+                            }
+                            tets[i * 4 + j] = vertices[indices[j] - 1].idx();
+                        }
                         progress.notify(ftell(mesh_file));
                     }
+                    mesh->add_tetras(tets);
                 } else if (0 == strcmp(str, "Hexahedra")) {
                     int number_of_hexahedra(0);
                     if (2 != sscanf(line, "%s %d", str, &number_of_hexahedra)) {
@@ -228,7 +233,8 @@ namespace easy3d {
 
                     LOG(INFO) << "reading " << number_of_hexahedra << " hexahedra...";
 
-                    // hex indices
+                    // hex indices (all hexahedra are added at once, see PolyMesh::add_hexas())
+                    std::vector<unsigned int> hexes(number_of_hexahedra * 8);
                     int indices[8];
                     for (int i = 0; i < number_of_hexahedra; i++) {
                         if (9 != fscanf(mesh_file, " %d %d %d %d %d %d %d %d %d",
@@ -239,18 +245,17 @@ namespace easy3d {
                             fclose(mesh_file);
                             return false;
                         }
-                        mesh->add_hexa(
-                                vertices[indices[0] - 1],
-                                vertices[indices[1] - 1],
-                                vertices[indices[2] - 1],
-                                vertices[indices[3] - 1],
-                                vertices[indices[4] - 1],
-                                vertices[indices[5] - 1],
-                                vertices[indices[6] - 1],
-                                vertices[indices[7] - 1]
-                        );
+                        for (int j = 0; j < 8; ++j) {
+                            if (indices[j] < 1 || indices[j] > static_cast<int>(vertices.size())) {
+                                LOG(ERROR) << "vertex index out of range: " << indices[j];
+                                fclose(mesh_file);
+                                return false;
+                            }
+                            hexes[i * 8 + j] = vertices[indices[j] - 1].idx();
+                        }
                         progress.notify(ftell(mesh_file));
                     }
+                    mesh->add_hexas(hexes);
                 } else if (0 == strcmp(str, "End")) {
                     break;
                 } else {
@@ -92,22 +92,28 @@ namespace easy3d {
                 LOG(INFO) << "model translated w.r.t. last known reference point (" << origin << "), stored as ModelProperty<dvec3>(\"translation\")";
             }
 
-            int num_halffaces(0), num_valence(0), idx(0);
+            // the cells are collected in the layout of PolyMesh::add_cells() and then added at once
+            std::vector<unsigned int> cells;
+            cells.reserve(num_cells * 17); // the size for tetrahedra
+            unsigned int num_halffaces(0), num_valence(0), idx(0);
             for (std::size_t c = 0; c < num_cells; ++c) {
                 input >> num_halffaces;
-                std::vector<PolyMesh::HalfFace> halffaces(num_halffaces);
+                cells.push_back(num_halffaces);
                 for (std::size_t hf = 0; hf < num_halffaces; ++hf) {
                     input >> num_valence;
-                    std::vector<PolyMesh::Vertex> vts(num_valence);
+                    cells.push_back(num_valence);
                     for (std::size_t v = 0; v < num_valence; ++v) {
                         input >> idx;
-                        vts[v] = PolyMesh::Vertex(idx);
+                        cells.push_back(idx);
                     }
-                    halffaces[hf] = mesh->add_face(vts);
                 }
-                mesh->add_cell(halffaces);
+                if (input.fail()) {
+                    LOG(ERROR) << "failed reading cell " << c;
+                    return false;
+                }
                 progress.next();
             }
+            mesh->add_cells(cells);
 
             return (mesh->n_vertices() > 0 && mesh->n_faces() > 0 && mesh->n_cells() > 0);
         }
@@ -25,6 +25,7 @@
  ********************************************************************/
 
 #include <easy3d/fileio/surface_mesh_io.h>
+#include <easy3d/fileio/binary_container.h>
 #include <easy3d/core/surface_mesh.h>
 #include <easy3d/util/file_system.h>
 #include <easy3d/util/stop_watch.h>
@@ -56,6 +57,8 @@ namespace easy3d {
             success = io::load_trilist(file_name, mesh);
         else if (ext == "geojson")
             success = io::load_geojson(file_name, mesh);
+        else if (ext == "e3d")
+            success = BinaryContainer::load(file_name, mesh);
 
         else if (ext.empty()) {
             LOG(ERROR) << "unknown file format: no extension" << ext;
@@ -107,6 +110,8 @@ namespace easy3d {
             success = io::save_off(final_name, mesh);
         else if (ext == "stl")
             success = io::save_stl(final_name, mesh);
+        else if (ext == "e3d")
+            success = BinaryContainer::save(final_name, mesh);
 
         else {
             LOG(ERROR) << "unknown file format: " << ext;
@@ -46,7 +46,7 @@ namespace easy3d {
 
         /**
          * \brief Reads a surface mesh from a file.
-         * \details File extension determines file format (ply, obj, off, stl, poly) and type (i.e. binary or ASCII).
+         * \details File extension determines file format (ply, obj, off, stl, sm, e3d) and type (i.e. binary or ASCII).
          * \param file_name The file name.
          * \return The pointer of the surface mesh (nullptr if failed).
          */
@@ -54,7 +54,7 @@ namespace easy3d {
 
         /**
          * \brief Saves a surface mesh to a file.
-         * \details File extension determines file format (ply, obj, off, stl, poly) and type (i.e. binary or ASCII).
+         * \details File extension determines file format (ply, obj, off, stl, sm, e3d) and type (i.e. binary or ASCII).
          * \param file_name The file name.
          * \param mesh The surface mesh.
          * \return The status of the operation
@@ -88,8 +88,9 @@ namespace easy3d {
 
         /// Reads a surface mesh from a \p STL format file.
 		bool load_stl(const std::string& file_name, SurfaceMesh* mesh);
-        /// Saves a surface mesh to a \p STL format file.
-		bool save_stl(const std::string& file_name, const SurfaceMesh* mesh);
+        /// Saves a surface mesh to a \p STL format file (ASCII by default, or binary if \p binary is \c true). The
+        /// mesh must be a triangle mesh.
+		bool save_stl(const std::string& file_name, const SurfaceMesh* mesh, bool binary = false);
 
 		/// Reads a set of triangles (each line has coordinates of 3 points)
 		/// Mainly used for easily saving triangles for debugging.
@@ -30,6 +30,7 @@
 #include <unordered_map>
 
 #include <easy3d/fileio/translator.h>
+#include <easy3d/fileio/block_writer.h>
 #include <easy3d/core/surface_mesh.h>
 #include <easy3d/core/surface_mesh_builder.h>
 #include <easy3d/util/file_system.h>
@@ -861,78 +862,95 @@ namespace easy3d {
                 return false;
             }
 
-            std::ofstream out(file_name.c_str());
-            if (out.fail()) {
-                LOG(ERROR) << "could not open file: " << file_name;
+            BlockWriter writer(file_name);
+            if (!writer.is_open())
                 return false;
-            }
 
             // comment
-            out << "# OBJ exported from Easy3D (liangliang.nan@gmail.com)\n";
+            writer.write("# OBJ exported from Easy3D (liangliang.nan@gmail.com)\n");
+
+            // The elements are visited by their indices (skipping the deleted ones), so each section can be
+            // formatted in parallel.
+            bool success = true;
 
             //vertices
+            auto points = mesh->get_vertex_property<vec3>("v:point");
             auto trans = mesh->get_model_property<dvec3>("translation");
-            if (trans) { // has translation
-                const dvec3& origin = trans[0];
-                auto points = mesh->get_vertex_property<vec3>("v:point");
-                for (auto vit = mesh->vertices_begin(); vit != mesh->vertices_end(); ++vit) {
-                    const vec3 &p = points[*vit];
-                    out << "v " << p.x + origin.x << " " << p.y + origin.y << " " << p.z + origin.z << "\n";
+            auto format_vertices = [&](std::size_t first, std::size_t last, std::string &out) {
+                for (std::size_t i = first; i < last; ++i) {
+                    const SurfaceMesh::Vertex v(static_cast<int>(i));
+                    if (mesh->is_deleted(v))
+                        continue;
+                    const vec3 &p = points[v];
+                    out += "v ";
+                    if (trans) { // has translation
+                        const dvec3 &origin = trans[0];
+                        append_ascii(out, dvec3(p.x + origin.x, p.y + origin.y, p.z + origin.z), 3);
+                    } else
+                        append_ascii(out, p, 3);
+                    out += '\n';
                 }
-            } else { // no translation
-                auto points = mesh->get_vertex_property<vec3>("v:point");
-                for (auto vit = mesh->vertices_begin(); vit != mesh->vertices_end(); ++vit)
-                    out << "v " << points[*vit] << "\n";
-            }
+            };
+            success = success && writer.write_rows(mesh->vertices_size(), format_vertices);
 
             //normals
             auto normals = mesh->get_vertex_property<vec3>("v:normal");
             if (normals) {
-                for (auto vit = mesh->vertices_begin(); vit != mesh->vertices_end(); ++vit) {
-                    const vec3 &n = normals[*vit];
-                    out << "vn " << n << "\n";
-                }
+                auto format_normals = [&](std::size_t first, std::size_t last, std::string &out) {
+                    for (std::size_t i = first; i < last; ++i) {
+                        const SurfaceMesh::Vertex v(static_cast<int>(i));
+                        if (mesh->is_deleted(v))
+                            continue;
+                        out += "vn ";
+                        append_ascii(out, normals[v], 3);
+                        out += '\n';
+                    }
+                };
+                success = success && writer.write_rows(mesh->vertices_size(), format_normals);
             }
 
             //optionally texture coordinates
-            // do we have them?
-            auto h_props = mesh->halfedge_properties();
-            bool with_tex_coord = false;
-            auto h_prop_end = h_props.end(), h_prop_start = h_props.begin();
-            while (h_prop_start != h_prop_end) {
-                if (*h_prop_start == "h:texcoord")
-                    with_tex_coord = true;
-                ++h_prop_start;
-            }
-
-            //if so then add
-            if (with_tex_coord) {
-                auto tex_coord = mesh->get_halfedge_property<vec2>("h:texcoord");
-                for (auto hit = mesh->halfedges_begin(); hit != mesh->halfedges_end(); ++hit) {
-                    const vec2 &tex = tex_coord[*hit];
-                    out << "vt " << tex << "\n";
-                }
+            auto tex_coord = mesh->get_halfedge_property<vec2>("h:texcoord");
+            if (tex_coord) {
+                auto format_texcoords = [&](std::size_t first, std::size_t last, std::string &out) {
+                    for (std::size_t i = first; i < last; ++i) {
+                        const SurfaceMesh::Halfedge h(static_cast<int>(i));
+                        if (mesh->is_deleted(mesh->edge(h)))
+                            continue;
+                        out += "vt ";
+                        append_ascii(out, tex_coord[h], 2);
+                        out += '\n';
+                    }
+                };
+                success = success && writer.write_rows(mesh->halfedges_size(), format_texcoords);
             }
 
-            //faces
-            for (auto fit = mesh->faces_begin(); fit != mesh->faces_end(); ++fit) {
-                out << "f ";
-                auto fvit = mesh->vertices(*fit), fvend = fvit;
-                auto fhit = mesh->halfedges(*fit);
-                do {
-                    if (with_tex_coord) {
-                        // write vertex index, tex_coord index and normal index
-                        out << (*fvit).idx() + 1 << "/" << (*fhit).idx() + 1 << "/" << (*fvit).idx() + 1 << " ";
-                        ++fhit;
-                    } else {
-                        // write vertex index and normal index
-                        out << (*fvit).idx() + 1 << "/" << (*fvit).idx() + 1 << " ";
+            //faces: each corner is written as "v", "v/vt", "v//vn", or "v/vt/vn"
+            auto format_faces = [&](std::size_t first, std::size_t last, std::string &out) {
+                for (std::size_t i = first; i < last; ++i) {
+                    const SurfaceMesh::Face f(static_cast<int>(i));
+                    if (mesh->is_deleted(f))
+                        continue;
+                    out += 'f';
+                    for (auto h : mesh->halfedges(f)) {
+                        const int v = mesh->target(h).idx() + 1;
+                        out += ' ';
+                        append_ascii(out, v);
+                        if (tex_coord) {
+                            out += '/';
+                            append_ascii(out, h.idx() + 1);
+                        }
+                        if (normals) {
+                            out += tex_coord ? "/" : "//";
+                            append_ascii(out, v);
+                        }
                     }
-                } while (++fvit != fvend);
-                out << "\n";
-            }
+                    out += '\n';
+                }
+            };
+            success = success && writer.write_rows(mesh->faces_size(), format_faces);
 
-            return true;
+            return writer.close() && success;
         }
 
 
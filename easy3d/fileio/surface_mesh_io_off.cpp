@@ -26,6 +26,7 @@
 
 #include <easy3d/fileio/surface_mesh_io.h>
 #include <easy3d/fileio/translator.h>
+#include <easy3d/fileio/block_writer.h>
 #include <easy3d/core/types.h>
 #include <easy3d/core/surface_mesh.h>
 #include <easy3d/core/surface_mesh_builder.h>
@@ -191,50 +192,56 @@ namespace easy3d {
 				return false;
 			}
 
-            std::ofstream out(file_name.c_str()) ;
-            if(out.fail()) {
-				LOG(ERROR) << "could not open file: " << file_name;
-                return false ;
-            }
-            out.precision(10) ;
+            BlockWriter writer(file_name);
+            if (!writer.is_open())
+                return false;
 
-            out << "OFF" << std::endl;
-            out << mesh->n_vertices() << " " << mesh->n_faces() << " 0" << std::endl;
+            writer.write("OFF\n");
+            writer.write(std::to_string(mesh->n_vertices()) + " " + std::to_string(mesh->n_faces()) + " 0\n");
 
             ProgressLogger progress(mesh->n_vertices() + mesh->n_faces(), true, false);
 
-            // Output Vertices
+            // The elements are visited by their indices (skipping the deleted ones), so they can be formatted in
+            // parallel. Off files numbering starts with 0.
 
+            // Output Vertices
             auto trans = mesh->get_model_property<dvec3>("translation");
-            dvec3 origin(0, 0, 0);
-            if (trans)  // has translation
-                origin = trans[0];
-
-            // Off files numbering starts with 0
             auto points = mesh->get_vertex_property<vec3>("v:point");
-            for (auto v : mesh->vertices()) {
-                const auto& p = points[v];
-                out << p.x + origin.x << " "
-                    << p.y + origin.y << " "
-                    << p.z + origin.z << " " << std::endl;
-                progress.next();
-            }
+            auto format_vertices = [&](std::size_t first, std::size_t last, std::string &out) {
+                for (std::size_t i = first; i < last; ++i) {
+                    const SurfaceMesh::Vertex v(static_cast<int>(i));
+                    if (mesh->is_deleted(v))
+                        continue;
+                    const vec3 &p = points[v];
+                    if (trans) { // has translation
+                        const dvec3 &origin = trans[0];
+                        append_ascii(out, dvec3(p.x + origin.x, p.y + origin.y, p.z + origin.z), 3);
+                    } else
+                        append_ascii(out, p, 3);
+                    out += '\n';
+                }
+            };
+            if (!writer.write_rows(mesh->vertices_size(), format_vertices, &progress))
+                return false;
 
             // Output facets
-            for (auto f : mesh->faces()) {
-                out << mesh->valence(f);
-
-                SurfaceMesh::VertexAroundFaceCirculator fvit = mesh->vertices(f), fvend = fvit;
-                do {
-                    SurfaceMesh::Vertex v = (*fvit);
-                    out << " " << v.idx();
-                    ++fvit;
-                } while (fvit != fvend);
-                out << std::endl;
-                progress.next();
-            }
+            auto format_faces = [&](std::size_t first, std::size_t last, std::string &out) {
+                for (std::size_t i = first; i < last; ++i) {
+                    const SurfaceMesh::Face f(static_cast<int>(i));
+                    if (mesh->is_deleted(f))
+                        continue;
+                    append_ascii(out, static_cast<int>(mesh->valence(f)));
+                    for (auto v : mesh->vertices(f)) {
+                        out += ' ';
+                        append_ascii(out, v.idx());
+                    }
+                    out += '\n';
+                }
+            };
+            if (!writer.write_rows(mesh->faces_size(), format_faces, &progress))
+                return false;
 
-            return true;
+            return writer.close();
 		}
 
 	} // namespace io
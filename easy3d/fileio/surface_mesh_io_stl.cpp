@@ -28,12 +28,14 @@
 
 #include <cstdio>
 #include <cstring>
+#include <cstdint>
 #include <map>
 #include <fstream>
 #include <cfloat>
 
 #include <easy3d/core/surface_mesh.h>
 #include <easy3d/core/surface_mesh_builder.h>
+#include <easy3d/fileio/block_writer.h>
 #include <easy3d/util/logging.h>
 
 
@@ -274,8 +276,7 @@ namespace easy3d {
 
 		//-----------------------------------------------------------------------------
 
-        // currently we save in ASCII format
-		bool save_stl(const std::string& file_name, const SurfaceMesh* mesh)
+		bool save_stl(const std::string& file_name, const SurfaceMesh* mesh, bool binary)
 		{
 			if (!mesh) {
 				LOG(ERROR) << "null mesh pointer";
@@ -288,44 +289,63 @@ namespace easy3d {
 				return false;
 			}
 
-			auto fnormals = mesh->get_face_property<vec3>("f:normal");
-			if (!fnormals)
-			{
-				fnormals = const_cast<SurfaceMesh*>(mesh)->add_face_property<vec3>("f:normal");
-				for (auto f : mesh->faces())
-					fnormals[f] = mesh->compute_face_normal(f);
-			}
+            // use the face normals if available, otherwise compute them on the fly
+            auto fnormals = mesh->get_face_property<vec3>("f:normal");
+            auto points = mesh->get_vertex_property<vec3>("v:point");
 
-			std::ofstream ofs(file_name.c_str());
-            if (ofs.fail()) {
-                LOG(ERROR) << "could not open file: " << file_name;
+            BlockWriter writer(file_name);
+            if (!writer.is_open())
                 return false;
-            }
-
-			auto points = mesh->get_vertex_property<vec3>("v:point");
 
-			ofs << "solid stl" << std::endl;
-			vec3 n;
-			vec3 p;
+            // the faces are visited by their indices (skipping the deleted ones), so they can be formatted in parallel
+            const std::size_t num = mesh->faces_size();
+            bool success = false;
+            if (binary) {
+                // 80-byte header, the number of triangles, and then a 50-byte record for each triangle
+                char header[80] = {0};
+                std::strncpy(header, "binary stl saved by Easy3D", sizeof(header) - 1);
+                writer.write(header, sizeof(header));
+                const auto num_triangles = static_cast<uint32_t>(mesh->n_faces());
+                writer.write(&num_triangles, sizeof(uint32_t));
+
+                success = writer.write_rows(num, [&](std::size_t first, std::size_t last, std::string &out) {
+                    out.reserve((last - first) * 50);
+                    for (std::size_t i = first; i < last; ++i) {
+                        const SurfaceMesh::Face f(static_cast<int>(i));
+                        if (mesh->is_deleted(f))
+                            continue;
+                        const vec3 n = fnormals ? fnormals[f] : mesh->compute_face_normal(f);
+                        out.append(reinterpret_cast<const char *>(n.data()), sizeof(vec3));
+                        for (auto v : mesh->vertices(f))
+                            out.append(reinterpret_cast<const char *>(points[v].data()), sizeof(vec3));
+                        const uint16_t attribute = 0;
+                        out.append(reinterpret_cast<const char *>(&attribute), sizeof(uint16_t));
+                    }
+                });
+            }
+            else {
+                writer.write("solid stl\n");
+                success = writer.write_rows(num, [&](std::size_t first, std::size_t last, std::string &out) {
+                    for (std::size_t i = first; i < last; ++i) {
+                        const SurfaceMesh::Face f(static_cast<int>(i));
+                        if (mesh->is_deleted(f))
+                            continue;
+                        const vec3 n = fnormals ? fnormals[f] : mesh->compute_face_normal(f);
+                        out += "  facet normal ";
+                        append_ascii(out, n, 3);
+                        out += "\n    outer loop\n";
+                        for (auto v : mesh->vertices(f)) {
+                            out += "      vertex ";
+                            append_ascii(out, points[v], 3);
+                            out += '\n';
+                        }
+                        out += "    endloop\n  endfacet\n";
+                    }
+                });
+                writer.write("endsolid\n");
+            }
 
-			for (auto f : mesh->faces())
-			{
-				n = fnormals[f];
-				ofs << "  facet normal ";
-				ofs << n[0] << " " << n[1] << " " << n[2] << std::endl;
-				ofs << "    outer loop" << std::endl;
-				for (auto v : mesh->vertices(f))
-				{
-					p = points[v];
-					ofs << "      vertex ";
-					ofs << p[0] << " " << p[1] << " " << p[2] << std::endl;
-				}
-				ofs << "    endloop" << std::endl;
-				ofs << "  endfacet" << std::endl;
-			}
-			ofs << "endsolid" << std::endl;
-			ofs.close();
-			return true;
+            return writer.close() && success;
 		}
 
 	} // namespace io
@@ -0,0 +1,84 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#include <easy3d/gui/picker_instance.h>
+#include <easy3d/renderer/opengl_error.h>
+#include <easy3d/renderer/drawable_instanced.h>
+#include <easy3d/renderer/framebuffer_object.h>
+
+
+namespace easy3d {
+
+    InstancePicker::InstancePicker(const Camera *cam) : Picker(cam) {
+        use_gpu_if_supported_ = true;
+    }
+
+
+    int InstancePicker::pick(const InstancedDrawable *drawable, int x, int y) {
+        if (!drawable || !drawable->is_visible() || drawable->num_instances() == 0)
+            return -1;
+
+        int viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        int width = viewport[2];
+        int height = viewport[3];
+        setup_framebuffer(width, height);
+
+        // Bind the offscreen fbo for drawing
+        fbo_->bind();
+        easy3d_debug_log_gl_error
+        easy3d_debug_log_frame_buffer_error
+
+        float color[4];
+        glGetFloatv(GL_COLOR_CLEAR_VALUE, color);
+        glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        drawable->draw_instance_ids(camera());
+
+        glFlush();
+        glFinish();
+
+        int gl_x, gl_y;
+        screen_to_opengl(x, y, gl_x, gl_y, width, height);
+
+        unsigned char c[4];
+        fbo_->read_color(c, gl_x, gl_y);
+
+        // switch back to the previous fbo
+        fbo_->release();
+        easy3d_debug_log_gl_error
+        easy3d_debug_log_frame_buffer_error
+
+        // restore the clear color
+        glClearColor(color[0], color[1], color[2], color[3]);
+        easy3d_debug_log_gl_error
+
+        // Convert the color back to the index of the instance
+        return drawable->picked_instance(color::encode(c[0], c[1], c[2], c[3]));
+    }
+
+}
@@ -27,6 +27,7 @@
 
 #include <easy3d/gui/picker_point_cloud.h>
 #include <easy3d/core/point_cloud.h>
+#include <easy3d/core/point_kernels.h>
 #include <easy3d/renderer/manipulator.h>
 #include <easy3d/renderer/renderer.h>
 #include <easy3d/renderer/shader_manager.h>
@@ -34,6 +35,7 @@
 #include <easy3d/renderer/framebuffer_object.h>
 #include <easy3d/renderer/opengl_error.h>
 #include <easy3d/util/logging.h>
+#include <easy3d/util/thread_pool.h>
 
 
 namespace easy3d {
@@ -104,22 +106,15 @@ namespace easy3d {
         const mat4 MANIP = model->manipulator() ? model->manipulator()->matrix() : mat4::identity();
         const mat4& m = MVP * MANIP;
 
-#pragma omp parallel for
-        for (int i = 0; i < num; ++i) {
-            const vec3& p = points[i];
-            float x = m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12];
-            float y = m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13];
-            //float z = m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14]; // I don't need z
-            float w = m[3] * p.x + m[7] * p.y + m[11] * p.z + m[15];
-            x /= w;
-            y /= w;
-            x = 0.5f * x + 0.5f;
-            y = 0.5f * y + 0.5f;
-            if (distance2(vec2(x, y), vec2(static_cast<float>(px), static_cast<float>(py))) < sqr_dist_thresh) {
+        std::vector<vec2> projected;
+        kernels::project(points, m, projected);
+
+        parallel_for(0, static_cast<int>(num), [&](int i) {
+            if (distance2(projected[i], vec2(static_cast<float>(px), static_cast<float>(py))) < sqr_dist_thresh) {
                 status[i] = 1;
-                sqr_dist_to_near[i] = distance2(p, p_near);
+                sqr_dist_to_near[i] = distance2(points[i], p_near);
             }
-        }
+        });
 
         int idx = -1;
         float min_s_dist = FLT_MAX;
@@ -293,19 +288,12 @@ namespace easy3d {
 
         auto &select = model->vertex_property<bool>("v:select").vector();
 
-#pragma omp parallel for
+        std::vector<vec2> projected;
+        kernels::project(points, m, projected);
+
         for (int i = 0; i < num; ++i) {
-            const vec3 &p = points[i];
-            float x = m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12];
-            float y = m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13];
-            //float z = m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14]; // I don't need z
-            float w = m[3] * p.x + m[7] * p.y + m[11] * p.z + m[15];
-            x /= w;
-            y /= w;
-            x = 0.5f * x + 0.5f;
-            y = 0.5f * y + 0.5f;
-
-            if (x >= xmin && x <= xmax && y >= ymin && y <= ymax)
+            const vec2 &q = projected[i];
+            if (q.x >= xmin && q.x <= xmax && q.y >= ymin && q.y <= ymax)
                 select[i] = !deselect;
         }
 
@@ -344,22 +332,19 @@ namespace easy3d {
 
         auto& select = model->vertex_property<bool>("v:select").vector();
 
-#pragma omp parallel for
+        std::vector<vec2> projected;
+        kernels::project(points, m, projected);
+
+        // std::vector<bool> can not be written concurrently, so the points inside are marked first
+        std::vector<char> inside(num, 0);
+        parallel_for(0, num, [&](int i) {
+            const vec2 &q = projected[i];
+            if (q.x >= xmin && q.x <= xmax && q.y >= ymin && q.y <= ymax)
+                inside[i] = geom::point_in_polygon(q, region);
+        });
         for (int i = 0; i < num; ++i) {
-            const vec3 &p = points[i];
-            float x = m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12];
-            float y = m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13];
-            //float z = m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14]; // I don't need z
-            float w = m[3] * p.x + m[7] * p.y + m[11] * p.z + m[15];
-            x /= w;
-            y /= w;
-            x = 0.5f * x + 0.5f;
-            y = 0.5f * y + 0.5f;
-
-            if (x >= xmin && x <= xmax && y >= ymin && y <= ymax) {
-                if (geom::point_in_polygon(vec2(x, y), region))
-                    select[i] = !deselect;
-            }
+            if (inside[i])
+                select[i] = !deselect;
         }
 
         auto count = std::count(select.begin(), select.end(), true);
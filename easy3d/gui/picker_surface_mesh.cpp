@@ -34,6 +34,7 @@
 #include <easy3d/renderer/drawable_triangles.h>
 #include <easy3d/renderer/manipulator.h>
 #include <easy3d/util/logging.h>
+#include <easy3d/util/thread_pool.h>
 
 
 namespace easy3d {
@@ -203,11 +204,10 @@ namespace easy3d {
         const OrientedLine3 oline(p_near, p_far);
 
         std::vector<char> status(num, 0);
-#pragma omp parallel for
-        for (int i = 0; i < num; ++i) {
+        parallel_for(0, num, [&](int i) {
             if (do_intersect(model, SurfaceMesh::Face(i), oline))
                 status[i] = 1;
-        }
+        });
 
         picked_face_ = SurfaceMesh::Face();
         double squared_distance = FLT_MAX;
@@ -372,10 +372,8 @@ namespace easy3d {
         const mat4 MANIP = model->manipulator() ? model->manipulator()->matrix() : mat4::identity();
         const mat4 &m = camera()->modelViewProjectionMatrix() * MANIP;
 
-        std::vector<bool> status(num, false);
-
-#pragma omp parallel for
-        for (int i = 0; i < num; ++i) {
+        std::vector<char> status(num, 0);  // not std::vector<bool>, which can not be written concurrently
+        parallel_for(0, num, [&](int i) {
             const vec3 &p = points[i];
             float x = m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12];
             float y = m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13];
@@ -387,8 +385,8 @@ namespace easy3d {
             y = 0.5f * y + 0.5f;
 
             if (x >= xmin && x <= xmax && y >= ymin && y <= ymax)
-                status[i] = true;
-        }
+                status[i] = 1;
+        });
 
         // a face is selected if all its vertices are selected
         for (auto f : model->faces()) {
@@ -437,10 +435,8 @@ namespace easy3d {
         const mat4 MANIP = model->manipulator() ? model->manipulator()->matrix() : mat4::identity();
         const mat4 &m = camera()->modelViewProjectionMatrix() * MANIP;
 
-        std::vector<bool> select_vertices(num, false);
-
-#pragma omp parallel for
-        for (int i = 0; i < num; ++i) {
+        std::vector<char> select_vertices(num, 0);  // not std::vector<bool>, which can not be written concurrently
+        parallel_for(0, num, [&](int i) {
             const vec3& p = points[i];
             float x = m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12];
             float y = m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13];
@@ -453,9 +449,9 @@ namespace easy3d {
 
             if (x >= xmin && x <= xmax && y >= ymin && y <= ymax) {
                 if (geom::point_in_polygon(vec2(x, y), region))
-                    select_vertices[i] = true;
+                    select_vertices[i] = 1;
             }
-        }
+        });
 
         // a face is selected if all its vertices are selected
         for (auto f : model->faces()) {
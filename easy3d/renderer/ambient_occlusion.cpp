@@ -43,6 +43,7 @@
 #include <easy3d/renderer/renderer.h>
 #include <easy3d/renderer/clipping_plane.h>
 #include <easy3d/renderer/manipulator.h>
+#include <easy3d/renderer/frame_profiler.h>
 
 
 const int  KERNEL_SIZE = 64;
@@ -142,6 +143,8 @@ namespace easy3d {
 
 
     unsigned int AmbientOcclusion::generate(const std::vector< std::shared_ptr<Model> >& models) {
+        FrameProfiler::Scope scope("SSAO");
+
         int viewport[4];
         glGetIntegerv(GL_VIEWPORT, viewport);
         init(viewport[2], viewport[3]);
@@ -34,6 +34,7 @@
 #include <easy3d/renderer/shape.h>
 #include <easy3d/renderer/transform.h>
 #include <easy3d/renderer/clipping_plane.h>
+#include <easy3d/renderer/frame_profiler.h>
 #include <easy3d/util/setting.h>
 
 
@@ -137,6 +138,8 @@ namespace easy3d {
         if (surfaces.empty())
             return;
 
+        FrameProfiler::Scope scope("average color blending");
+
         int viewport[4];
         glGetIntegerv(GL_VIEWPORT, viewport);
         const int w = viewport[2];
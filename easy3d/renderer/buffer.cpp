@@ -32,6 +32,7 @@
 #include <easy3d/core/point_cloud.h>
 #include <easy3d/core/surface_mesh.h>
 #include <easy3d/core/poly_mesh.h>
+#include <easy3d/core/scalar_field_statistics.h>
 #include <easy3d/renderer/renderer.h>
 #include <easy3d/renderer/drawable_points.h>
 #include <easy3d/renderer/drawable_lines.h>
@@ -48,29 +49,28 @@ namespace easy3d {
 
             // clamps scalar field values by the percentages specified by dummy_lower and dummy_upper.
             // min_value and max_value return the expected value range.
+            // The statistics are cached for each property, so switching between scalar fields (or updating the
+            // drawable without modifying the scalar field) doesn't need to visit the values again.
             template<typename FT>
             inline void
-            clamp_scalar_field(const std::vector<FT> &property, float &min_value, float &max_value,
+            clamp_scalar_field(const PropertyArray<FT> &property, float &min_value, float &max_value,
                                float dummy_lower_percent,
                                float dummy_upper_percent) {
-                if (property.empty()) {
+                const auto stats = ScalarFieldStatistics::get(property);
+                if (stats->count() == 0) {
                     LOG(WARNING) << "empty property";
                     return;
                 }
 
-                // sort curvature values
-                std::vector<FT> values = property;
-                std::sort(values.begin(), values.end());
-
-                const std::size_t n = values.size() - 1;
+                const std::size_t n = stats->count() - 1;
                 const std::size_t index_lower = n * dummy_lower_percent;
                 const std::size_t index_upper = n - n * dummy_upper_percent;
 
-                min_value = values[index_lower];
-                max_value = values[index_upper];
+                min_value = static_cast<float>(index_lower == 0 ? stats->min_value() : stats->value_at_rank(property, index_lower));
+                max_value = static_cast<float>(index_upper == n ? stats->max_value() : stats->value_at_rank(property, index_upper));
                 if (min_value >= max_value) { // if so, we cannot clamp
-                    min_value = values.front();
-                    max_value = values.back();
+                    min_value = static_cast<float>(stats->min_value());
+                    max_value = static_cast<float>(stats->max_value());
                 }
 
                 // special treatment for boolean scalar fields if the values are the same
@@ -81,9 +81,9 @@ namespace easy3d {
 
                 const int lower = static_cast<int>(dummy_lower_percent * 100);
                 const int upper = static_cast<int>(dummy_upper_percent * 100);
-                if ((lower > 0 || upper > 0) && values.front() < values.back())
+                if ((lower > 0 || upper > 0) && stats->min_value() < stats->max_value())
                     LOG(INFO) << "scalar field range ["
-                              << static_cast<float>(values.front()) << ", " << static_cast<float>(values.back()) << "]"
+                              << static_cast<float>(stats->min_value()) << ", " << static_cast<float>(stats->max_value()) << "]"
                               << " clamped (" << lower << "%, " << upper << "%) to [" << min_value << ", " << max_value
                               << "]";
             }
@@ -105,7 +105,7 @@ namespace easy3d {
                 const float dummy_upper = (drawable->clamp_range() ? drawable->clamp_upper() : 0.0f);
                 float min_value = std::numeric_limits<float>::max();
                 float max_value = -std::numeric_limits<float>::max();
-                internal::clamp_scalar_field(prop.vector(), min_value, max_value, dummy_lower, dummy_upper);
+                internal::clamp_scalar_field(prop.array(), min_value, max_value, dummy_lower, dummy_upper);
 
                 auto points = model->template get_vertex_property<vec3>("v:point");
 
@@ -140,7 +140,7 @@ namespace easy3d {
                 const float dummy_upper = (drawable->clamp_range() ? drawable->clamp_upper() : 0.0f);
                 float min_value = std::numeric_limits<float>::max();
                 float max_value = -std::numeric_limits<float>::max();
-                internal::clamp_scalar_field(prop.vector(), min_value, max_value, dummy_lower, dummy_upper);
+                internal::clamp_scalar_field(prop.array(), min_value, max_value, dummy_lower, dummy_upper);
 
                 auto points = model->template get_vertex_property<vec3>("v:point");
                 std::vector<vec3> d_points;
@@ -178,7 +178,7 @@ namespace easy3d {
                 const float dummy_upper = (drawable->clamp_range() ? drawable->clamp_upper() : 0.0f);
                 float min_value = std::numeric_limits<float>::max();
                 float max_value = -std::numeric_limits<float>::max();
-                internal::clamp_scalar_field(prop.vector(), min_value, max_value, dummy_lower, dummy_upper);
+                internal::clamp_scalar_field(prop.array(), min_value, max_value, dummy_lower, dummy_upper);
 
                 auto points = model->template get_vertex_property<vec3>("v:point");
                 drawable->update_vertex_buffer(points.vector());
@@ -217,14 +217,14 @@ namespace easy3d {
 
                 if (model->is_triangle_mesh()) {
                     auto points = model->get_vertex_property<vec3>("v:point");
-                    model->update_vertex_normals();
+                    model->update_vertex_normals(true);
                     auto normals = model->get_vertex_property<vec3>("v:normal");
 
                     const float dummy_lower = (drawable->clamp_range() ? drawable->clamp_lower() : 0.0f);
                     const float dummy_upper = (drawable->clamp_range() ? drawable->clamp_upper() : 0.0f);
                     float min_value = std::numeric_limits<float>::max();
                     float max_value = -std::numeric_limits<float>::max();
-                    internal::clamp_scalar_field(prop.vector(), min_value, max_value, dummy_lower, dummy_upper);
+                    internal::clamp_scalar_field(prop.array(), min_value, max_value, dummy_lower, dummy_upper);
 
                     std::vector<vec3> d_points, d_normals;
                     std::vector<vec2> d_texcoords;
@@ -275,11 +275,11 @@ namespace easy3d {
                      */
 
                     auto points = model->get_vertex_property<vec3>("v:point");
-                    model->update_vertex_normals();
+                    model->update_vertex_normals(true);
                     auto vnormals = model->get_vertex_property<vec3>("v:normal");
                     auto fnormals = model->get_face_property<vec3>("f:normal");
                     if (!fnormals) {
-                        model->update_face_normals();
+                        model->update_face_normals(true);
                         fnormals = model->get_face_property<vec3>("f:normal");
                     }
 
@@ -287,7 +287,7 @@ namespace easy3d {
                     const float dummy_upper = (drawable->clamp_range() ? drawable->clamp_upper() : 0.0f);
                     float min_value = std::numeric_limits<float>::max();
                     float max_value = -std::numeric_limits<float>::max();
-                    internal::clamp_scalar_field(prop.vector(), min_value, max_value, dummy_lower, dummy_upper);
+                    internal::clamp_scalar_field(prop.array(), min_value, max_value, dummy_lower, dummy_upper);
 
                     std::vector<vec3> d_points, d_normals;
                     std::vector<vec2> d_texcoords;
@@ -357,14 +357,14 @@ namespace easy3d {
 
                 if (model->is_triangle_mesh()) {
                     auto points = model->get_vertex_property<vec3>("v:point");
-                    model->update_vertex_normals();
+                    model->update_vertex_normals(true);
                     auto normals = model->get_vertex_property<vec3>("v:normal");
 
                     const float dummy_lower = (drawable->clamp_range() ? drawable->clamp_lower() : 0.0f);
                     const float dummy_upper = (drawable->clamp_range() ? drawable->clamp_upper() : 0.0f);
                     float min_value = std::numeric_limits<float>::max();
                     float max_value = -std::numeric_limits<float>::max();
-                    internal::clamp_scalar_field(prop.vector(), min_value, max_value, dummy_lower, dummy_upper);
+                    internal::clamp_scalar_field(prop.array(), min_value, max_value, dummy_lower, dummy_upper);
 
                     std::vector<vec2> d_texcoords;
                     d_texcoords.reserve(model->n_vertices());
@@ -419,11 +419,11 @@ namespace easy3d {
                      */
 
                     auto points = model->get_vertex_property<vec3>("v:point");
-                    model->update_vertex_normals();
+                    model->update_vertex_normals(true);
                     auto vnormals = model->get_vertex_property<vec3>("v:normal");
                     auto fnormals = model->get_face_property<vec3>("f:normal");
                     if (!fnormals) {
-                        model->update_face_normals();
+                        model->update_face_normals(true);
                         fnormals = model->get_face_property<vec3>("f:normal");
                     }
 
@@ -431,7 +431,7 @@ namespace easy3d {
                     const float dummy_upper = (drawable->clamp_range() ? drawable->clamp_upper() : 0.0f);
                     float min_value = std::numeric_limits<float>::max();
                     float max_value = -std::numeric_limits<float>::max();
-                    internal::clamp_scalar_field(prop.vector(), min_value, max_value, dummy_lower, dummy_upper);
+                    internal::clamp_scalar_field(prop.array(), min_value, max_value, dummy_lower, dummy_upper);
 
                     for (auto face : model->faces()) {
                         tessellator.begin_polygon(fnormals[face]);
@@ -766,7 +766,7 @@ namespace easy3d {
                 const float dummy_upper = (drawable->clamp_range() ? drawable->clamp_upper() : 0.0f);
                 float min_value = std::numeric_limits<float>::max();
                 float max_value = -std::numeric_limits<float>::max();
-                internal::clamp_scalar_field(prop.vector(), min_value, max_value, dummy_lower, dummy_upper);
+                internal::clamp_scalar_field(prop.array(), min_value, max_value, dummy_lower, dummy_upper);
 
                 /**
                  * We use the Tessellator to eliminate duplicate vertices. This allows us to take advantage of element
@@ -837,7 +837,7 @@ namespace easy3d {
                 const float dummy_upper = (drawable->clamp_range() ? drawable->clamp_upper() : 0.0f);
                 float min_value = std::numeric_limits<float>::max();
                 float max_value = -std::numeric_limits<float>::max();
-                internal::clamp_scalar_field(prop.vector(), min_value, max_value, dummy_lower, dummy_upper);
+                internal::clamp_scalar_field(prop.array(), min_value, max_value, dummy_lower, dummy_upper);
 
                 /**
                  * We use the Tessellator to eliminate duplicate vertices. This allows us to take advantage of element
@@ -940,7 +940,7 @@ namespace easy3d {
                 }
 
                 if (model->is_triangle_mesh()) {
-                    model->update_vertex_normals();
+                    model->update_vertex_normals(true);
                     auto normals = model->get_vertex_property<vec3>("v:normal");
 
                     std::vector<unsigned int> d_indices;
@@ -987,11 +987,11 @@ namespace easy3d {
                      */
 
                     auto points = model->get_vertex_property<vec3>("v:point");
-                    model->update_vertex_normals();
+                    model->update_vertex_normals(true);
                     auto vnormals = model->get_vertex_property<vec3>("v:normal");
                     auto fnormals = model->get_face_property<vec3>("f:normal");
                     if (!fnormals) {
-                        model->update_face_normals();
+                        model->update_face_normals(true);
                         fnormals = model->get_face_property<vec3>("f:normal");
                     }
 
@@ -1069,7 +1069,7 @@ namespace easy3d {
 
                 if (model->is_triangle_mesh()) {
                     auto points = model->get_vertex_property<vec3>("v:point");
-                    model->update_vertex_normals();
+                    model->update_vertex_normals(true);
                     auto normals = model->get_vertex_property<vec3>("v:normal");
 
                     std::vector<vec3> d_points, d_normals, d_colors;
@@ -1125,11 +1125,11 @@ namespace easy3d {
                      */
 
                     auto points = model->get_vertex_property<vec3>("v:point");
-                    model->update_vertex_normals();
+                    model->update_vertex_normals(true);
                     auto vnormals = model->get_vertex_property<vec3>("v:normal");
                     auto fnormals = model->get_face_property<vec3>("f:normal");
                     if (!fnormals) {
-                        model->update_face_normals();
+                        model->update_face_normals(true);
                         fnormals = model->get_face_property<vec3>("f:normal");
                     }
 
@@ -1193,7 +1193,7 @@ namespace easy3d {
 
                 if (model->is_triangle_mesh()) {
                     auto points = model->get_vertex_property<vec3>("v:point");
-                    model->update_vertex_normals();
+                    model->update_vertex_normals(true);
                     auto normals = model->get_vertex_property<vec3>("v:normal");
 
                     std::vector<unsigned int> d_indices;
@@ -1241,11 +1241,11 @@ namespace easy3d {
                      * between flat and smooth shading without transferring different data to the GPU.
                      */
                     auto points = model->get_vertex_property<vec3>("v:point");
-                    model->update_vertex_normals();
+                    model->update_vertex_normals(true);
                     auto vnormals = model->get_vertex_property<vec3>("v:normal");
                     auto fnormals = model->get_face_property<vec3>("f:normal");
                     if (!fnormals) {
-                        model->update_face_normals();
+                        model->update_face_normals(true);
                         fnormals = model->get_face_property<vec3>("f:normal");
                     }
 
@@ -1309,7 +1309,7 @@ namespace easy3d {
 
                 if (model->is_triangle_mesh()) {
                     auto points = model->get_vertex_property<vec3>("v:point");
-                    model->update_vertex_normals();
+                    model->update_vertex_normals(true);
                     auto normals = model->get_vertex_property<vec3>("v:normal");
 
                     std::vector<unsigned int> d_indices;
@@ -1358,11 +1358,11 @@ namespace easy3d {
                      */
 
                     auto points = model->get_vertex_property<vec3>("v:point");
-                    model->update_vertex_normals();
+                    model->update_vertex_normals(true);
                     auto vnormals = model->get_vertex_property<vec3>("v:normal");
                     auto fnormals = model->get_face_property<vec3>("f:normal");
                     if (!fnormals) {
-                        model->update_face_normals();
+                        model->update_face_normals(true);
                         fnormals = model->get_face_property<vec3>("f:normal");
                     }
 
@@ -1427,7 +1427,7 @@ namespace easy3d {
 
                 if (model->is_triangle_mesh()) {
                     auto points = model->get_vertex_property<vec3>("v:point");
-                    model->update_vertex_normals();
+                    model->update_vertex_normals(true);
                     auto normals = model->get_vertex_property<vec3>("v:normal");
 
                     std::vector<vec3> d_points, d_normals;
@@ -1483,11 +1483,11 @@ namespace easy3d {
                      */
 
                     auto points = model->get_vertex_property<vec3>("v:point");
-                    model->update_vertex_normals();
+                    model->update_vertex_normals(true);
                     auto vnormals = model->get_vertex_property<vec3>("v:normal");
                     auto fnormals = model->get_face_property<vec3>("f:normal");
                     if (!fnormals) {
-                        model->update_face_normals();
+                        model->update_face_normals(true);
                         fnormals = model->get_face_property<vec3>("f:normal");
                     }
 
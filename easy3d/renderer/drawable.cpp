@@ -26,7 +26,12 @@
 
 #include <easy3d/renderer/drawable.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <unordered_set>
 
 #include <easy3d/core/model.h>
 #include <easy3d/renderer/opengl.h>
@@ -35,18 +40,92 @@
 #include <easy3d/renderer/texture_manager.h>
 #include <easy3d/renderer/opengl_error.h>
 #include <easy3d/renderer/buffer.h>
+#include <easy3d/renderer/frame_profiler.h>
 #include <easy3d/renderer/manipulator.h>
 #include <easy3d/util/logging.h>
 #include <easy3d/util/setting.h>
 #include <easy3d/util/stop_watch.h>
+#include <easy3d/util/thread_pool.h>
 
 
 namespace easy3d {
 
+    namespace internal {
+
+        // The maximum number of chunks of quantized positions. It must match the size of the uniform arrays
+        // "quantization_offset" and "quantization_scale" declared in resources/shaders/include/vertex_position.glsl.
+        const std::size_t max_quantization_chunks = 32;
+        // The minimum number of vertices in a chunk of quantized positions.
+        const std::size_t min_quantization_chunk_size = 65536;
+        // The grain of the parallel packing loops.
+        const std::size_t packing_grain = 16384;
+        // The minimum number of points/lines/triangles for a drawable to have a coarse level of detail.
+        const std::size_t min_decimated_primitives = 65536;
+        // The average number of vertices merged into one by the vertex clustering of the coarse level of detail.
+        const float vertices_per_cluster = 8.0f;
+
+        inline short to_snorm16(float v) {
+            v = std::max(-1.0f, std::min(1.0f, v));
+            return static_cast<short>(std::round(v * 32767.0f));
+        }
+
+        inline unsigned char to_unorm8(float v) {
+            v = std::max(0.0f, std::min(1.0f, v));
+            return static_cast<unsigned char>(std::round(v * 255.0f));
+        }
+
+        // Encodes a unit vector by projecting it onto the octahedron and unfolding the lower half. See
+        // Cigolle et al. "A Survey of Efficient Representations for Independent Unit Vectors", JCGT 2014.
+        // A zero vector is encoded as (0, 0), which decodes to (0, 0, 1).
+        inline void encode_octahedral(const vec3 &n, short *out) {
+            const float l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+            if (l1 < 1e-20f) {
+                out[0] = out[1] = 0;
+                return;
+            }
+            float x = n.x / l1;
+            float y = n.y / l1;
+            if (n.z < 0.0f) {
+                const float ox = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+                const float oy = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+                x = ox;
+                y = oy;
+            }
+            out[0] = to_snorm16(x);
+            out[1] = to_snorm16(y);
+        }
+
+        // Sets an integer/bool uniform of the current program if it is active in the program.
+        inline void set_uniform_if_active(GLint program, const char *name, int value) {
+            const GLint location = glGetUniformLocation(static_cast<GLuint>(program), name);
+            if (location >= 0)
+                glUniform1i(location, value);
+        }
+
+        // Sets a vec3 array uniform of the current program if it is active in the program.
+        inline void set_uniform_if_active(GLint program, const char *name, const std::vector<vec3> &values) {
+            const GLint location = glGetUniformLocation(static_cast<GLuint>(program), name);
+            if (location >= 0 && !values.empty())
+                glUniform3fv(location, static_cast<GLsizei>(values.size()), values[0].data());
+        }
+
+        // The programs whose decoding uniforms were last set for compact attributes. The other programs still have
+        // the default values (i.e., false), so drawing plain attributes with them requires no uniform update.
+        inline std::unordered_set<GLint> &programs_decoding_compact_attributes() {
+            static std::unordered_set<GLint> programs;
+            return programs;
+        }
+
+    }
+
+
     Drawable::Drawable(const std::string &name, Model *model)
             : name_(name), model_(model), vao_(nullptr), num_vertices_(0), num_indices_(0),
               update_needed_(false), update_func_(nullptr), vertex_buffer_(0), color_buffer_(0), normal_buffer_(0),
-              texcoord_buffer_(0), element_buffer_(0), manipulator_(nullptr) {
+              texcoord_buffer_(0), element_buffer_(0), compact_formats_(setting::drawable_compact_buffers),
+              quantized_positions_(false), octahedral_normals_(false), rgba8_colors_(false),
+              index_type_(GL_UNSIGNED_INT), decimation_(1), decimated_buffer_(0), num_decimated_indices_(0),
+              decimated_buffer_built_(false), updating_buffers_(false), manipulator_(nullptr) {
         vao_ = std::unique_ptr<VertexArrayObject>(new VertexArrayObject);
         material_ = Material(setting::material_ambient, setting::material_specular, setting::material_shininess);
     }
@@ -69,15 +148,18 @@ namespace easy3d {
         if (vertex_buffer()) {
             output << "\t" << name() << std::endl;
             output << "\t\tvertex buffer:     " << num_vertices_ << " vertices, "
-                   << num_vertices_ * sizeof(vec3) << " bytes" << std::endl;
+                   << num_vertices_ * (quantized_positions_ ? 4 * sizeof(unsigned short) : sizeof(vec3)) << " bytes"
+                   << (quantized_positions_ ? " (quantized)" : "") << std::endl;
         }
         if (normal_buffer()) {
             output << "\t\tnormal buffer:     " << num_vertices_ << " normals, "
-                   << num_vertices_ * sizeof(vec3) << " bytes" << std::endl;
+                   << num_vertices_ * (octahedral_normals_ ? 2 * sizeof(short) : sizeof(vec3)) << " bytes"
+                   << (octahedral_normals_ ? " (octahedral)" : "") << std::endl;
         }
         if (color_buffer()) {
             output << "\t\tcolor buffer:      " << num_vertices_ << " colors, "
-                   << num_vertices_ * sizeof(vec3) << " bytes" << std::endl;
+                   << num_vertices_ * (rgba8_colors_ ? 4 * sizeof(unsigned char) : sizeof(vec3)) << " bytes"
+                   << (rgba8_colors_ ? " (rgba8)" : "") << std::endl;
         }
         if (texcoord_buffer()) {
             output << "\t\ttexcoord buffer:   " << num_vertices_ << " texcoords, "
@@ -85,7 +167,8 @@ namespace easy3d {
         }
         if (element_buffer()) {
             output << "\t\tindex buffer:      " << num_indices_ << " indices, "
-                   << num_indices_ * sizeof(unsigned int) << " bytes" << std::endl;
+                   << num_indices_ * (index_type_ == GL_UNSIGNED_SHORT ? sizeof(unsigned short) : sizeof(unsigned int))
+                   << " bytes" << std::endl;
         }
     }
 
@@ -93,6 +176,9 @@ namespace easy3d {
     void Drawable::update() {
         bbox_.clear();
         update_needed_ = true;
+        // the model may have been modified, so the derived data (e.g., normals) has to be recomputed
+        if (model_)
+            model_->touch_geometry();
     }
 
 
@@ -102,16 +188,27 @@ namespace easy3d {
         VertexArrayObject::release_buffer(normal_buffer_);
         VertexArrayObject::release_buffer(texcoord_buffer_);
         VertexArrayObject::release_buffer(element_buffer_);
+        release_decimated_elements();
+        decimation_clusters_.clear();
 
         num_vertices_ = 0;
         num_indices_ = 0;
         bbox_.clear();
+
+        quantized_positions_ = false;
+        octahedral_normals_ = false;
+        rgba8_colors_ = false;
+        index_type_ = GL_UNSIGNED_INT;
+        quantization_offsets_.clear();
+        quantization_scales_.clear();
     }
 
 
     void Drawable::disable_element_buffer() {
         VertexArrayObject::release_buffer(element_buffer_);
+        release_decimated_elements();
         num_indices_ = 0;
+        index_type_ = GL_UNSIGNED_INT;
     }
 
 
@@ -126,10 +223,19 @@ namespace easy3d {
         }
 
         StopWatch w;
-        if (update_func_)
-            update_func_(model_, this);
-        else
-            buffer::update(model_, this);
+        {
+            FrameProfiler::Scope scope("buffer::update", false);
+            updating_buffers_ = true;
+            if (update_func_)
+                update_func_(model_, this);
+            else
+                buffer::update(model_, this);
+            updating_buffers_ = false;
+        }
+
+        // the coarse level of detail of a drawable with an element buffer is built by update_element_buffer()
+        if (setting::progressive_refinement_enabled && !element_buffer_ && !decimated_buffer_built_)
+            build_decimated_elements(nullptr);
 
         LOG_IF(w.elapsed_seconds() > 0.5, INFO) << "updating rendering buffers for drawable '" << name()
                                                 << "' took " << w.time_string();
@@ -138,9 +244,64 @@ namespace easy3d {
 
     void Drawable::update_vertex_buffer(const std::vector<vec3> &vertices, bool dynamic) {
         assert(vao_);
+        release_decimated_elements();
+
+        bool success = false;
+        quantized_positions_ = (compact_formats_ & COMPACT_POSITION) && !vertices.empty();
+        if (quantized_positions_) {
+            // The positions are quantized to 16 bits relative to the bounding box of their chunk. The 4th component
+            // records the chunk, which the vertex shaders use to look up the offset and scale of the chunk.
+            const std::size_t n = vertices.size();
+            const std::size_t chunk_size = std::max(internal::min_quantization_chunk_size,
+                    (n + internal::max_quantization_chunks - 1) / internal::max_quantization_chunks);
+            const std::size_t num_chunks = (n + chunk_size - 1) / chunk_size;
+            quantization_offsets_.assign(num_chunks, vec3(0.0f));
+            quantization_scales_.assign(num_chunks, vec3(0.0f));
+            std::vector<vec3> inverse_scales(num_chunks, vec3(0.0f));
+            for (std::size_t c = 0; c < num_chunks; ++c) {
+                const std::size_t first = c * chunk_size;
+                const std::size_t last = std::min(first + chunk_size, n);
+                const Box3 box = parallel_reduce(first, last, Box3(),
+                        [&vertices](std::size_t b, std::size_t e) {
+                            Box3 result;
+                            for (std::size_t i = b; i < e; ++i)
+                                result.grow(vertices[i]);
+                            return result;
+                        },
+                        [](const Box3 &a, const Box3 &b) {
+                            Box3 result = a;
+                            result.grow(b);
+                            return result;
+                        }, internal::packing_grain);
+                quantization_offsets_[c] = box.min_point();
+                const vec3 extent = box.diagonal_vector();
+                for (unsigned int k = 0; k < 3; ++k) {
+                    quantization_scales_[c][k] = extent[k] / 65535.0f;
+                    inverse_scales[c][k] = extent[k] > 0.0f ? 65535.0f / extent[k] : 0.0f;
+                }
+            }
 
-        bool success = vao_->create_array_buffer(vertex_buffer_, ShaderProgram::POSITION, vertices.data(),
-                                                 vertices.size() * sizeof(vec3), 3, dynamic);
+            std::vector<unsigned short> packed(n * 4);
+            parallel_for(std::size_t(0), n, [&](std::size_t i) {
+                const std::size_t c = i / chunk_size;
+                const vec3 &offset = quantization_offsets_[c];
+                const vec3 &inverse_scale = inverse_scales[c];
+                for (unsigned int k = 0; k < 3; ++k) {
+                    const float q = (vertices[i][k] - offset[k]) * inverse_scale[k];
+                    packed[i * 4 + k] = static_cast<unsigned short>(std::max(0.0f, std::min(65535.0f, q + 0.5f)));
+                }
+                packed[i * 4 + 3] = static_cast<unsigned short>(c);
+            }, internal::packing_grain);
+
+            success = vao_->create_array_buffer(vertex_buffer_, ShaderProgram::POSITION, packed.data(),
+                                                packed.size() * sizeof(unsigned short), 4, GL_UNSIGNED_SHORT, false,
+                                                dynamic);
+        } else {
+            quantization_offsets_.clear();
+            quantization_scales_.clear();
+            success = vao_->create_array_buffer(vertex_buffer_, ShaderProgram::POSITION, vertices.data(),
+                                                vertices.size() * sizeof(vec3), 3, dynamic);
+        }
 
         LOG_IF(!success, ERROR) << "failed creating vertex buffer";
 
@@ -158,22 +319,55 @@ namespace easy3d {
                     bbox_.grow(p);
             }
         }
+
+        decimation_clusters_.clear();
+        if (success && setting::progressive_refinement_enabled) {
+            if (type() != DT_POINTS)
+                compute_decimation_clusters(vertices);
+            // without an element buffer, the coarse level of detail depends on the vertices only (it is built once
+            // all the buffers are updated if called from update_buffers_internal())
+            if (!element_buffer_ && !updating_buffers_)
+                build_decimated_elements(nullptr);
+        }
     }
 
 
     void Drawable::update_color_buffer(const std::vector<vec3> &colors, bool dynamic) {
         assert(vao_);
 
-        bool success = vao_->create_array_buffer(color_buffer_, ShaderProgram::COLOR, colors.data(),
-                                                 colors.size() * sizeof(vec3), 3, dynamic);
+        bool success = false;
+        rgba8_colors_ = (compact_formats_ & COMPACT_COLOR) && !colors.empty();
+        if (rgba8_colors_) {
+            std::vector<unsigned char> packed(colors.size() * 4);
+            parallel_for(std::size_t(0), colors.size(), [&](std::size_t i) {
+                for (unsigned int k = 0; k < 3; ++k)
+                    packed[i * 4 + k] = internal::to_unorm8(colors[i][k]);
+                packed[i * 4 + 3] = 255;
+            }, internal::packing_grain);
+            success = vao_->create_array_buffer(color_buffer_, ShaderProgram::COLOR, packed.data(),
+                                                packed.size() * sizeof(unsigned char), 4, GL_UNSIGNED_BYTE, true,
+                                                dynamic);
+        } else
+            success = vao_->create_array_buffer(color_buffer_, ShaderProgram::COLOR, colors.data(),
+                                                colors.size() * sizeof(vec3), 3, dynamic);
         LOG_IF(!success, ERROR) << "failed updating color buffer";
     }
 
 
     void Drawable::update_normal_buffer(const std::vector<vec3> &normals, bool dynamic) {
         assert(vao_);
-        bool success = vao_->create_array_buffer(normal_buffer_, ShaderProgram::NORMAL, normals.data(),
-                                                 normals.size() * sizeof(vec3), 3, dynamic);
+        bool success = false;
+        octahedral_normals_ = (compact_formats_ & COMPACT_NORMAL) && !normals.empty();
+        if (octahedral_normals_) {
+            std::vector<short> packed(normals.size() * 2);
+            parallel_for(std::size_t(0), normals.size(), [&](std::size_t i) {
+                internal::encode_octahedral(normals[i], packed.data() + i * 2);
+            }, internal::packing_grain);
+            success = vao_->create_array_buffer(normal_buffer_, ShaderProgram::NORMAL, packed.data(),
+                                                packed.size() * sizeof(short), 2, GL_SHORT, true, dynamic);
+        } else
+            success = vao_->create_array_buffer(normal_buffer_, ShaderProgram::NORMAL, normals.data(),
+                                                normals.size() * sizeof(vec3), 3, dynamic);
         LOG_IF(!success, ERROR) << "failed updating normal buffer";
     }
 
@@ -189,12 +383,35 @@ namespace easy3d {
 
     void Drawable::update_element_buffer(const std::vector<unsigned int> &indices) {
         assert(vao_);
-
-        bool status = vao_->create_element_buffer(element_buffer_, indices.data(), indices.size() * sizeof(unsigned int));
+        release_decimated_elements();
+
+        bool status = false;
+        const unsigned int max_index = parallel_reduce(std::size_t(0), indices.size(), 0u,
+                [&indices](std::size_t b, std::size_t e) {
+                    unsigned int result = 0;
+                    for (std::size_t i = b; i < e; ++i)
+                        result = std::max(result, indices[i]);
+                    return result;
+                },
+                [](unsigned int a, unsigned int b) { return std::max(a, b); }, internal::packing_grain);
+        if ((compact_formats_ & COMPACT_INDEX) && !indices.empty() && max_index <= 0xFFFF) {
+            std::vector<unsigned short> packed(indices.size());
+            parallel_for(std::size_t(0), indices.size(), [&](std::size_t i) {
+                packed[i] = static_cast<unsigned short>(indices[i]);
+            }, internal::packing_grain);
+            status = vao_->create_element_buffer(element_buffer_, packed.data(), packed.size() * sizeof(unsigned short));
+            index_type_ = GL_UNSIGNED_SHORT;
+        } else {
+            status = vao_->create_element_buffer(element_buffer_, indices.data(), indices.size() * sizeof(unsigned int));
+            index_type_ = GL_UNSIGNED_INT;
+        }
         if (!status)
             num_indices_ = 0;
-        else
+        else {
             num_indices_ = indices.size();
+            if (setting::progressive_refinement_enabled)
+                build_decimated_elements(&indices);
+        }
     }
 
 
@@ -219,6 +436,19 @@ namespace easy3d {
 
 
     void Drawable::gl_draw() const {
+        gl_draw_internal(0);
+    }
+
+
+    void Drawable::gl_draw_instanced(std::size_t num_instances) const {
+        if (num_instances > 0)
+            gl_draw_internal(num_instances);
+    }
+
+
+    void Drawable::gl_draw_internal(std::size_t num_instances) const {
+        FrameProfiler::Scope scope(name_.c_str());
+
         if (update_needed_ || vertex_buffer_ == 0) {
             const_cast<Drawable *>(this)->update_buffers_internal();
             const_cast<Drawable *>(this)->update_needed_ = false;
@@ -229,23 +459,193 @@ namespace easy3d {
             << "element buffer provided but vertex buffer filled with 0 vertices";
 #endif
 
+        // Let the vertex shaders decode the compact attributes. A program is shared by drawables with and without
+        // compact attributes, so the decoding uniforms are reset after drawing compact attributes. Nothing is
+        // queried or set if no drawable uses compact attributes (the default).
+        auto &compact_programs = internal::programs_decoding_compact_attributes();
+        const bool compact = quantized_positions_ || octahedral_normals_;
+        if (compact || !compact_programs.empty()) {
+            GLint program = 0;
+            glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+            if (program && compact) {
+                internal::set_uniform_if_active(program, "quantized_position", quantized_positions_);
+                if (quantized_positions_) {
+                    internal::set_uniform_if_active(program, "quantization_offset", quantization_offsets_);
+                    internal::set_uniform_if_active(program, "quantization_scale", quantization_scales_);
+                }
+                internal::set_uniform_if_active(program, "octahedral_normal", octahedral_normals_);
+                compact_programs.insert(program);
+            }
+            else if (program && compact_programs.erase(program)) {
+                internal::set_uniform_if_active(program, "quantized_position", 0);
+                internal::set_uniform_if_active(program, "octahedral_normal", 0);
+            }
+            easy3d_debug_log_gl_error
+        }
+
         vao_->bind();
+        issue_draw_call(num_instances);
+        vao_->release();
+        easy3d_debug_log_gl_error
+    }
+
+
+    void Drawable::issue_draw_call(std::size_t num_instances) const {
+        if (num_instances == 0 && decimation_ > 1) {
+            if (decimated_buffer_) {
+                std::size_t count = num_decimated_indices_;
+                if (type() == DT_POINTS) {
+                    // the points are ordered such that every k-th point (k is a power of 2) comes first
+                    std::size_t k = 1;
+                    while (k * 2 <= decimation_)
+                        k *= 2;
+                    count = (count + k - 1) / k;
+                }
+                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, decimated_buffer_);
+                easy3d_debug_log_gl_error
+                glDrawElements(type(), GLsizei(count), GL_UNSIGNED_INT, nullptr);
+                easy3d_debug_log_gl_error
+                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+                return;
+            }
+        }
 
         if (element_buffer_) {
             glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, element_buffer_);
             easy3d_debug_log_gl_error
 
             // index buffer must be bound if using glDrawElements()
-            glDrawElements(type(), GLsizei(num_indices_), GL_UNSIGNED_INT, nullptr);
+            if (num_instances > 0)
+                glDrawElementsInstanced(type(), GLsizei(num_indices_), index_type_, nullptr, GLsizei(num_instances));
+            else
+                glDrawElements(type(), GLsizei(num_indices_), index_type_, nullptr);
             easy3d_debug_log_gl_error
 
             glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-        } else
+        } else if (num_instances > 0)
+            glDrawArraysInstanced(type(), 0, GLsizei(num_vertices_), GLsizei(num_instances));
+        else
             glDrawArrays(type(), 0, GLsizei(num_vertices_));
         easy3d_debug_log_gl_error
+    }
 
-        vao_->release();
-        easy3d_debug_log_gl_error
+
+    void Drawable::release_decimated_elements() {
+        VertexArrayObject::release_buffer(decimated_buffer_);
+        num_decimated_indices_ = 0;
+        decimated_buffer_built_ = false;
+    }
+
+
+    void Drawable::compute_decimation_clusters(const std::vector<vec3> &vertices) {
+        // Vertex clustering: the vertices falling into the same cell of a uniform grid are represented by the
+        // first of them.
+        const std::size_t n = vertices.size();
+        Box3 box;
+        for (const auto &p : vertices)
+            box.grow(p);
+        const float resolution = std::max(8.0f, std::min(1024.0f,
+                std::sqrt(static_cast<float>(n) / internal::vertices_per_cluster)));
+        const float cell = std::max(box.max_range() / resolution, std::numeric_limits<float>::min());
+        std::size_t dims[3];
+        for (unsigned int k = 0; k < 3; ++k)
+            dims[k] = static_cast<std::size_t>(box.range(k) / cell) + 1;
+
+        // sort the vertices by their cells (a cell id is less than 1025^3, which fits in the upper 32 bits)
+        std::vector<uint64_t> keys(n);
+        parallel_for(std::size_t(0), n, [&](std::size_t i) {
+            std::size_t id[3];
+            for (unsigned int k = 0; k < 3; ++k)
+                id[k] = std::min(dims[k] - 1, static_cast<std::size_t>((vertices[i][k] - box.min_coord(k)) / cell));
+            keys[i] = (static_cast<uint64_t>((id[0] * dims[1] + id[1]) * dims[2] + id[2]) << 32) | i;
+        }, internal::packing_grain);
+        std::sort(keys.begin(), keys.end());
+
+        decimation_clusters_.resize(n);
+        for (std::size_t b = 0, e = 0; b < n; b = e) {
+            const auto representative = static_cast<unsigned int>(keys[b] & 0xFFFFFFFFu);
+            for (e = b; e < n && (keys[e] >> 32) == (keys[b] >> 32); ++e)
+                decimation_clusters_[keys[e] & 0xFFFFFFFFu] = representative;
+        }
+    }
+
+
+    void Drawable::build_decimated_elements(const std::vector<unsigned int> *indices) {
+        release_decimated_elements();
+        decimated_buffer_built_ = true;
+
+        const std::size_t num = indices ? indices->size() : num_vertices_;
+        if (num == 0 || !vertex_buffer_)
+            return;
+
+        // small drawables are cheap to draw in full detail and not worth a second index buffer
+        const std::size_t vertices_per_primitive = (type() == DT_POINTS) ? 1 : ((type() == DT_LINES) ? 2 : 3);
+        const std::size_t num_primitives = num / vertices_per_primitive;
+        if (num_primitives < internal::min_decimated_primitives)
+            return;
+
+        StopWatch w;
+        std::vector<unsigned int> elements;
+        if (type() == DT_POINTS) {
+            // Order the points by levels such that, for any power of 2 k, the first ceil(num/k) points are exactly
+            // every k-th point: the 1st point, then the odd multiples of the largest power of 2, ..., and finally
+            // the odd points.
+            elements.reserve(num);
+            elements.push_back(0);
+            int top = 0;
+            while ((std::size_t(2) << top) < num)
+                ++top;
+            for (int level = top; level >= 0; --level) {
+                for (std::size_t i = std::size_t(1) << level; i < num; i += std::size_t(2) << level)
+                    elements.push_back(static_cast<unsigned int>(i));
+            }
+            if (indices) {
+                parallel_for(std::size_t(0), num, [&](std::size_t i) {
+                    elements[i] = (*indices)[elements[i]];
+                }, internal::packing_grain);
+            }
+        } else {
+            // the vertices are clustered when they are uploaded
+            const std::vector<unsigned int> &representative = decimation_clusters_;
+            if (representative.size() != num_vertices_)
+                return;
+
+            // the primitives that collapse are discarded
+            std::vector<unsigned int> remapped(num_primitives * vertices_per_primitive);
+            std::vector<unsigned char> valid(num_primitives, 0);
+            parallel_for(std::size_t(0), num_primitives, [&](std::size_t f) {
+                for (std::size_t j = 0; j < vertices_per_primitive; ++j) {
+                    const std::size_t e = f * vertices_per_primitive + j;
+                    const std::size_t v = indices ? (*indices)[e] : e;
+                    if (v >= num_vertices_)
+                        return;
+                    remapped[e] = representative[v];
+                }
+                const unsigned int *v = remapped.data() + f * vertices_per_primitive;
+                valid[f] = (vertices_per_primitive == 2) ? (v[0] != v[1])
+                                                         : (v[0] != v[1] && v[1] != v[2] && v[2] != v[0]);
+            }, internal::packing_grain);
+
+            elements.reserve(num / 4);
+            for (std::size_t f = 0; f < num_primitives; ++f) {
+                if (valid[f]) {
+                    for (std::size_t j = 0; j < vertices_per_primitive; ++j)
+                        elements.push_back(remapped[f * vertices_per_primitive + j]);
+                }
+            }
+
+            // not worth a second index buffer
+            if (elements.empty() || elements.size() * 2 > num)
+                return;
+        }
+
+        if (vao_->create_element_buffer(decimated_buffer_, elements.data(), elements.size() * sizeof(unsigned int)))
+            num_decimated_indices_ = elements.size();
+        else
+            VertexArrayObject::release_buffer(decimated_buffer_);
+
+        LOG_IF(w.elapsed_seconds() > 0.5, INFO) << "building the decimated elements for drawable '" << name()
+                                                << "' took " << w.time_string();
     }
 
 
@@ -31,6 +31,7 @@
 #include <vector>
 #include <memory>
 #include <functional>
+#include <algorithm>
 
 #include <easy3d/core/types.h>
 #include <easy3d/renderer/state.h>
@@ -66,6 +67,24 @@ namespace easy3d {
             DT_TRIANGLES = 0x0004   //!< Triangles drawable (GL_TRIANGLES).
         };
 
+        /**
+         * \brief The compact formats of the vertex attributes stored on the GPU.
+         * \details The flags can be combined, e.g., COMPACT_POSITION | COMPACT_NORMAL.
+         *  - COMPACT_POSITION: positions are quantized to 16 bits per coordinate relative to the bounding box of
+         *    their chunk (8 bytes instead of 12 per vertex, the 4th component records the chunk).
+         *  - COMPACT_NORMAL: normals are octahedral-encoded into two 16-bit integers (4 bytes instead of 12).
+         *  - COMPACT_COLOR: colors are stored as 8-bit RGBA (4 bytes instead of 12).
+         *  - COMPACT_INDEX: indices are stored as 16-bit integers if there are at most 65536 vertices.
+         */
+        enum CompactFormat {
+            COMPACT_NONE = 0x0000,      //!< Full-precision float attributes and 32-bit indices.
+            COMPACT_POSITION = 0x0001,  //!< 16-bit quantized positions.
+            COMPACT_NORMAL = 0x0002,    //!< Octahedral normals in 2x16 bits.
+            COMPACT_COLOR = 0x0004,     //!< 8-bit RGBA colors.
+            COMPACT_INDEX = 0x0008,     //!< 16-bit indices when possible.
+            COMPACT_ALL = 0x000F        //!< All the above.
+        };
+
     public:
         /**
          * \brief Constructor that initializes the drawable with a name and an optional model.
@@ -116,7 +135,7 @@ namespace easy3d {
          * \brief Returns the bounding box of the drawable.
          * \return The bounding box of the drawable.
          */
-        const Box3 &bounding_box() const;
+        virtual const Box3 &bounding_box() const;
 
         /**
          * \brief Returns the state of the drawable.
@@ -217,6 +236,25 @@ namespace easy3d {
          */
         void disable_element_buffer();
 
+        /**
+         * \brief Sets the compact formats of the vertex attributes.
+         * \details Compact buffers reduce the GPU memory and bandwidth by about a factor of 2 to 3. The packing is
+         *      done (in parallel) by the update_*_buffer() functions and the decoding by the vertex shaders of
+         *      Easy3D, so the change takes effect when the buffers are updated next time. The default value is
+         *      given by setting::drawable_compact_buffers.
+         * \param formats A bitwise combination of CompactFormat flags.
+         * \note Custom shaders must decode the compact attributes (e.g., by including the shader sources in
+         *      resources/shaders/include, like surface/surface.vert does), and mapping
+         *      the vertex buffer for direct modification (e.g., Tutorial_311_Animation) requires float positions.
+         * \sa update()
+         */
+        void set_compact_buffers(int formats) { compact_formats_ = formats; }
+        /**
+         * \brief Returns the requested compact formats of the vertex attributes.
+         * \return A bitwise combination of CompactFormat flags.
+         */
+        int compact_buffers() const { return compact_formats_; }
+
         ///@}
         /**
          * \brief Returns the number of vertices.
@@ -240,10 +278,41 @@ namespace easy3d {
          */
         void gl_draw() const;
 
+        /**
+         * \brief Draws multiple instances of the drawable using OpenGL.
+         * \details Same as gl_draw() but issues an instanced draw call. The per-instance attributes must have been
+         *          set up in the vertex array object (see VertexArrayObject::create_instance_buffer()).
+         * \param num_instances The number of instances to draw.
+         */
+        void gl_draw_instanced(std::size_t num_instances) const;
+
+        /**
+         * \brief Sets the decimation of the subsequent (non-instanced) draw calls.
+         * \details A decimation \p k > 1 draws a coarse subset of the drawable, e.g., for fast rendering during
+         *      camera interaction (see ProgressiveRefinement):
+         *          - points: only every k-th point is drawn (\p k is rounded down to a power of 2);
+         *          - lines and triangles: a coarse level of detail computed by vertex clustering is drawn. It
+         *            shares the vertex buffer of the drawable, so all attributes remain valid.
+         *      Only large drawables (i.e., at least 65536 primitives) are decimated; smaller ones are always drawn
+         *      with full detail.
+         *      The coarse index buffer is built from the data uploaded by update_element_buffer() (or, without an
+         *      element buffer, by update_vertex_buffer()) if setting::progressive_refinement_enabled is true, so
+         *      drawables uploaded before enabling it have no coarse level of detail until they are updated.
+         *      Modifications to the mapped buffers are not reflected by it.
+         * \param k The decimation. The default value 1 means full detail.
+         */
+        void set_decimation(std::size_t k) { decimation_ = std::max<std::size_t>(1, k); }
+        /**
+         * \brief Returns the decimation of the draw calls.
+         */
+        std::size_t decimation() const { return decimation_; }
+
         /**
          * \brief Requests an update of the OpenGL buffers.
          * \details This function sets the status to trigger an update of the OpenGL buffers. The actual update does
-         *      not occur immediately but is deferred to the rendering phase.
+         *      not occur immediately but is deferred to the rendering phase. It also marks the geometry of the model
+         *      as modified (see Model::touch_geometry()), so the derived data (e.g., normals) is recomputed once
+         *      and then shared by all drawables of the model.
          * \note This method works for both standard drawables (no update function required) and non-standard
          *      drawable (update function required). Standard drawables include:
          *            - SurfaceMesh: "faces", "edges", "vertices", "borders", and "locks";
@@ -317,6 +386,23 @@ namespace easy3d {
         // clears all buffers
         void clear();
 
+        // issues the draw call(s) while the vertex array object is bound. A non-instanced draw call is issued if
+        // num_instances is 0.
+        virtual void issue_draw_call(std::size_t num_instances) const;
+
+    private:
+        // the draw call shared by gl_draw() and gl_draw_instanced(). A non-instanced draw call is issued if
+        // num_instances is 0.
+        void gl_draw_internal(std::size_t num_instances) const;
+
+        // clusters the vertices of lines and triangles for their coarse level of detail
+        void compute_decimation_clusters(const std::vector<vec3> &vertices);
+        // builds the coarse index buffer used by the decimated draw calls from the indices (nullptr for the
+        // implicit order of the vertices)
+        void build_decimated_elements(const std::vector<unsigned int> *indices);
+        // releases the coarse index buffer (e.g., when the buffers change)
+        void release_decimated_elements();
+
     protected:
         std::string name_;  //!< The name of the drawable.
         Model *model_;      //!< The model to which the drawable is attached.
@@ -337,8 +423,26 @@ namespace easy3d {
         unsigned int texcoord_buffer_;  //!< The texture coordinate buffer ID.
         unsigned int element_buffer_;   //!< The element buffer ID.
 
+        int compact_formats_;           //!< The requested compact formats (CompactFormat flags).
+        bool quantized_positions_;      //!< Whether the vertex buffer holds quantized positions.
+        bool octahedral_normals_;       //!< Whether the normal buffer holds octahedral normals.
+        bool rgba8_colors_;             //!< Whether the color buffer holds 8-bit colors.
+        unsigned int index_type_;       //!< The type of the indices (GL_UNSIGNED_INT or GL_UNSIGNED_SHORT).
+        std::vector<vec3> quantization_offsets_;    //!< The per-chunk offsets of the quantized positions.
+        std::vector<vec3> quantization_scales_;     //!< The per-chunk scales of the quantized positions.
+
+        std::size_t decimation_;            //!< The decimation of the draw calls (1 means full detail).
+        unsigned int decimated_buffer_;     //!< The coarse index buffer ID used by the decimated draw calls.
+        std::size_t num_decimated_indices_; //!< The number of indices in the coarse index buffer.
+        bool decimated_buffer_built_;       //!< Whether the coarse index buffer has been built (if worth it).
+        std::vector<unsigned int> decimation_clusters_; //!< The representative vertex of the cluster of each vertex.
+        bool updating_buffers_;             //!< Whether the buffers are being updated by update_buffers_internal().
+
         // drawables not attached to a model can also be manipulated
         std::shared_ptr<Manipulator> manipulator_;   //!< The manipulator for the drawable.
+
+        // a batch copies the buffers of its drawables
+        friend class TrianglesBatch;
     };
 
 }
@@ -0,0 +1,520 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#include <easy3d/renderer/drawable_batch.h>
+
+#include <algorithm>
+#include <iterator>
+
+#include <easy3d/renderer/opengl.h>
+#include <easy3d/renderer/opengl_error.h>
+#include <easy3d/renderer/vertex_array_object.h>
+#include <easy3d/renderer/shader_program.h>
+#include <easy3d/util/logging.h>
+
+
+namespace easy3d {
+
+    namespace internal {
+
+        // The minimum capacities of the arenas (in number of vertices and indices).
+        const std::size_t min_batch_vertices = 65536;
+        const std::size_t min_batch_indices = 3 * 65536;
+
+        // Copies a range of a buffer object into another buffer object.
+        void copy_buffer_range(GLuint src, GLuint dst, std::size_t src_offset, std::size_t dst_offset, std::size_t size) {
+            if (size == 0)
+                return;
+            glBindBuffer(GL_COPY_READ_BUFFER, src);                 easy3d_debug_log_gl_error
+            glBindBuffer(GL_COPY_WRITE_BUFFER, dst);                easy3d_debug_log_gl_error
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(src_offset),
+                                static_cast<GLintptr>(dst_offset), static_cast<GLsizeiptr>(size));
+            easy3d_debug_log_gl_error
+            glBindBuffer(GL_COPY_READ_BUFFER, 0);                   easy3d_debug_log_gl_error
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);                  easy3d_debug_log_gl_error
+        }
+
+        // Creates a buffer object of the given size and copies the contents of the old buffer (if any) into it.
+        // The old buffer is untouched. Returns 0 on failure.
+        GLuint create_grown_buffer(GLuint old_buffer, std::size_t old_size, std::size_t new_size) {
+            GLuint buffer = 0;
+            glGenBuffers(1, &buffer);                               easy3d_debug_log_gl_error
+            if (buffer == 0)
+                return 0;
+            glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);             easy3d_debug_log_gl_error
+            glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(new_size), nullptr, GL_DYNAMIC_DRAW);
+            const bool success = (glGetError() == GL_NO_ERROR);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);                  easy3d_debug_log_gl_error
+            if (!success) {
+                VertexArrayObject::release_buffer(buffer);
+                return 0;
+            }
+            if (old_buffer)
+                copy_buffer_range(old_buffer, buffer, 0, 0, old_size);
+            return buffer;
+        }
+
+        // Makes a buffer the source of a vertex attribute of a vertex array object.
+        void attach_array_buffer(VertexArrayObject *vao, GLuint buffer, GLuint index, int dim, GLenum type,
+                                 bool normalized) {
+            vao->bind();
+            glBindBuffer(GL_ARRAY_BUFFER, buffer);                  easy3d_debug_log_gl_error
+            glEnableVertexAttribArray(index);                       easy3d_debug_log_gl_error
+            glVertexAttribPointer(index, dim, type, normalized ? GL_TRUE : GL_FALSE, 0, nullptr);
+            easy3d_debug_log_gl_error
+            glBindBuffer(GL_ARRAY_BUFFER, 0);                       easy3d_debug_log_gl_error
+            vao->release();
+        }
+
+    }
+
+
+    const std::size_t TrianglesBatch::RangeAllocator::npos = static_cast<std::size_t>(-1);
+
+
+    std::size_t TrianglesBatch::RangeAllocator::allocate(std::size_t count) {
+        for (auto it = free_.begin(); it != free_.end(); ++it) {
+            if (it->second < count)
+                continue;
+            const std::size_t offset = it->first;
+            const std::size_t remaining = it->second - count;
+            free_.erase(it);
+            if (remaining > 0)
+                free_[offset + count] = remaining;
+            return offset;
+        }
+        return npos;
+    }
+
+
+    void TrianglesBatch::RangeAllocator::release(std::size_t offset, std::size_t count) {
+        if (count == 0)
+            return;
+        auto next = free_.lower_bound(offset);
+        // merge with the following free range
+        if (next != free_.end() && next->first == offset + count) {
+            count += next->second;
+            next = free_.erase(next);
+        }
+        // merge with the preceding free range
+        if (next != free_.begin()) {
+            auto prev = std::prev(next);
+            if (prev->first + prev->second == offset) {
+                prev->second += count;
+                return;
+            }
+        }
+        free_[offset] = count;
+    }
+
+
+    void TrianglesBatch::RangeAllocator::grow(std::size_t old_capacity, std::size_t new_capacity) {
+        if (new_capacity > old_capacity)
+            release(old_capacity, new_capacity - old_capacity);
+    }
+
+
+    TrianglesBatch::TrianglesBatch(const std::string &name)
+            : TrianglesDrawable(name)
+            , indexed_(false)
+            , has_normals_(false)
+            , has_colors_(false)
+            , has_texcoords_(false)
+            , vertex_capacity_(0)
+            , index_capacity_(0)
+            , commands_changed_(true)
+    {
+    }
+
+
+    bool TrianglesBatch::is_compatible(const TrianglesDrawable *d) const {
+        if (!d || d == this || d->quantized_positions_)
+            return false;
+        if (entries_.empty())
+            return true;
+
+        // the buffer layout
+        if ((d->element_buffer_ != 0) != indexed_ || (d->normal_buffer_ != 0) != has_normals_ ||
+            (d->color_buffer_ != 0) != has_colors_ || (d->texcoord_buffer_ != 0) != has_texcoords_)
+            return false;
+        if ((has_normals_ && d->octahedral_normals_ != octahedral_normals_) ||
+            (has_colors_ && d->rgba8_colors_ != rgba8_colors_) || (indexed_ && d->index_type_ != index_type_))
+            return false;
+
+        // the rendering state
+        return d->coloring_method() == coloring_method() && d->color() == color() &&
+               d->lighting() == lighting() && d->lighting_two_sides() == lighting_two_sides() &&
+               d->distinct_back_color() == distinct_back_color() && d->back_color() == back_color() &&
+               d->texture() == texture() && d->texture_repeat() == texture_repeat() &&
+               d->texture_fractional_repeat() == texture_fractional_repeat() &&
+               d->material().ambient == material().ambient && d->material().specular == material().specular &&
+               d->material().shininess == material().shininess && d->smooth_shading() == smooth_shading() &&
+               d->opacity() == opacity();
+    }
+
+
+    bool TrianglesBatch::add_drawable(TrianglesDrawable *d) {
+        if (!d || d == this || contains(d))
+            return false;
+
+        // make sure the drawable has its buffers
+        if (d->update_needed_ || d->vertex_buffer_ == 0) {
+            d->update_buffers_internal();
+            d->update_needed_ = false;
+        }
+        if (d->num_vertices_ == 0 || d->vertex_buffer_ == 0 || !is_compatible(d))
+            return false;
+
+        if (entries_.empty()) {
+            // the first drawable determines the layout and the state of the batch
+            clear();
+            vertex_ranges_.clear();
+            index_ranges_.clear();
+            vertex_capacity_ = 0;
+            index_capacity_ = 0;
+
+            indexed_ = (d->element_buffer_ != 0);
+            has_normals_ = (d->normal_buffer_ != 0);
+            has_colors_ = (d->color_buffer_ != 0);
+            has_texcoords_ = (d->texcoord_buffer_ != 0);
+            octahedral_normals_ = has_normals_ && d->octahedral_normals_;
+            rgba8_colors_ = has_colors_ && d->rgba8_colors_;
+            index_type_ = indexed_ ? d->index_type_ : GL_UNSIGNED_INT;
+
+            set_state(d->state());
+            set_visible(true);
+            set_smooth_shading(d->smooth_shading());
+            set_opacity(d->opacity());
+        }
+
+        Entry entry;
+        entry.num_vertices = d->num_vertices_;
+        entry.num_indices = indexed_ ? d->num_indices_ : 0;
+        entry.vertex_offset = 0;
+        entry.index_offset = 0;
+        entry.visible = true;
+        entry.box = d->bounding_box();
+        if (!copy_buffers(d, entry))
+            return false;
+
+        entries_[d] = entry;
+        commands_changed_ = true;
+        bbox_.grow(entry.box);
+        return true;
+    }
+
+
+    bool TrianglesBatch::remove_drawable(const TrianglesDrawable *d) {
+        auto pos = entries_.find(d);
+        if (pos == entries_.end())
+            return false;
+
+        const Entry &entry = pos->second;
+        vertex_ranges_.release(entry.vertex_offset, entry.num_vertices);
+        index_ranges_.release(entry.index_offset, entry.num_indices);
+        entries_.erase(pos);
+        commands_changed_ = true;
+        update_bounding_box();
+        return true;
+    }
+
+
+    bool TrianglesBatch::update_drawable(TrianglesDrawable *d) {
+        if (!remove_drawable(d))
+            return false;
+        return add_drawable(d);
+    }
+
+
+    void TrianglesBatch::set_drawable_visible(const TrianglesDrawable *d, bool b) {
+        auto pos = entries_.find(d);
+        if (pos != entries_.end() && pos->second.visible != b) {
+            pos->second.visible = b;
+            commands_changed_ = true;
+        }
+    }
+
+
+    bool TrianglesBatch::is_drawable_visible(const TrianglesDrawable *d) const {
+        auto pos = entries_.find(d);
+        return pos != entries_.end() && pos->second.visible;
+    }
+
+
+    bool TrianglesBatch::reserve(std::size_t num_vertices, std::size_t num_indices) {
+        const bool grow_vertices = num_vertices > vertex_capacity_;
+        const bool grow_indices = indexed_ && num_indices > index_capacity_;
+        if (!grow_vertices && !grow_indices)
+            return true;
+
+        const std::size_t vertex_capacity = grow_vertices ?
+                std::max(num_vertices, std::max(2 * vertex_capacity_, internal::min_batch_vertices)) : vertex_capacity_;
+        const std::size_t index_capacity = grow_indices ?
+                std::max(num_indices, std::max(2 * index_capacity_, internal::min_batch_indices)) : index_capacity_;
+
+        // the arenas to grow
+        struct Arena {
+            GLuint *buffer;
+            std::size_t old_size, new_size;
+            bool attribute;     // a vertex attribute (otherwise the element buffer)
+            GLuint index;
+            int dim;
+            GLenum type;
+            bool normalized;
+            GLuint grown;
+        };
+        std::vector<Arena> arenas;
+        auto add_vertex_arena = [&](GLuint *buffer, std::size_t size, GLuint index, int dim, GLenum type,
+                                    bool normalized) {
+            arenas.push_back({buffer, vertex_capacity_ * size, vertex_capacity * size, true, index, dim, type,
+                              normalized, 0});
+        };
+        if (grow_vertices) {
+            add_vertex_arena(&vertex_buffer_, sizeof(vec3), ShaderProgram::POSITION, 3, GL_FLOAT, false);
+            if (has_normals_) {
+                if (octahedral_normals_)
+                    add_vertex_arena(&normal_buffer_, 2 * sizeof(short), ShaderProgram::NORMAL, 2, GL_SHORT, true);
+                else
+                    add_vertex_arena(&normal_buffer_, sizeof(vec3), ShaderProgram::NORMAL, 3, GL_FLOAT, false);
+            }
+            if (has_colors_) {
+                if (rgba8_colors_)
+                    add_vertex_arena(&color_buffer_, 4 * sizeof(unsigned char), ShaderProgram::COLOR, 4,
+                                     GL_UNSIGNED_BYTE, true);
+                else
+                    add_vertex_arena(&color_buffer_, sizeof(vec3), ShaderProgram::COLOR, 3, GL_FLOAT, false);
+            }
+            if (has_texcoords_)
+                add_vertex_arena(&texcoord_buffer_, sizeof(vec2), ShaderProgram::TEXCOORD, 2, GL_FLOAT, false);
+        }
+        if (grow_indices) {
+            const std::size_t size = (index_type_ == GL_UNSIGNED_SHORT) ? sizeof(unsigned short) : sizeof(unsigned int);
+            arenas.push_back({&element_buffer_, index_capacity_ * size, index_capacity * size, false, 0, 0, 0, false,
+                              0});
+        }
+
+        // Allocate all the new buffers first. If any allocation fails, the batch keeps its current arenas (which
+        // the entries refer to).
+        for (auto &arena : arenas) {
+            arena.grown = internal::create_grown_buffer(*arena.buffer, arena.old_size, arena.new_size);
+            if (arena.grown == 0) {
+                LOG(ERROR) << "failed growing the arenas of batch '" << name() << "' to " << vertex_capacity
+                           << " vertices and " << index_capacity << " indices";
+                for (auto &a : arenas)
+                    VertexArrayObject::release_buffer(a.grown);
+                return false;
+            }
+        }
+
+        // all allocations succeeded: swap in the new buffers
+        for (auto &arena : arenas) {
+            VertexArrayObject::release_buffer(*arena.buffer);
+            *arena.buffer = arena.grown;
+            if (arena.attribute)
+                internal::attach_array_buffer(vao_.get(), arena.grown, arena.index, arena.dim, arena.type,
+                                              arena.normalized);
+        }
+
+        if (grow_vertices) {
+            vertex_ranges_.grow(vertex_capacity_, vertex_capacity);
+            vertex_capacity_ = vertex_capacity;
+            num_vertices_ = vertex_capacity;
+        }
+        if (grow_indices) {
+            index_ranges_.grow(index_capacity_, index_capacity);
+            index_capacity_ = index_capacity;
+            num_indices_ = index_capacity;
+        }
+        return true;
+    }
+
+
+    bool TrianglesBatch::copy_buffers(const TrianglesDrawable *d, Entry &entry) {
+        entry.vertex_offset = vertex_ranges_.allocate(entry.num_vertices);
+        if (entry.vertex_offset == RangeAllocator::npos) {
+            if (!reserve(vertex_capacity_ + entry.num_vertices, 0))
+                return false;
+            entry.vertex_offset = vertex_ranges_.allocate(entry.num_vertices);
+        }
+        if (indexed_) {
+            entry.index_offset = index_ranges_.allocate(entry.num_indices);
+            if (entry.index_offset == RangeAllocator::npos) {
+                if (!reserve(0, index_capacity_ + entry.num_indices)) {
+                    vertex_ranges_.release(entry.vertex_offset, entry.num_vertices);
+                    return false;
+                }
+                entry.index_offset = index_ranges_.allocate(entry.num_indices);
+            }
+        }
+
+        const std::size_t n = entry.num_vertices;
+        const std::size_t v = entry.vertex_offset;
+        internal::copy_buffer_range(d->vertex_buffer_, vertex_buffer_, 0, v * sizeof(vec3), n * sizeof(vec3));
+        if (has_normals_) {
+            const std::size_t size = octahedral_normals_ ? 2 * sizeof(short) : sizeof(vec3);
+            internal::copy_buffer_range(d->normal_buffer_, normal_buffer_, 0, v * size, n * size);
+        }
+        if (has_colors_) {
+            const std::size_t size = rgba8_colors_ ? 4 * sizeof(unsigned char) : sizeof(vec3);
+            internal::copy_buffer_range(d->color_buffer_, color_buffer_, 0, v * size, n * size);
+        }
+        if (has_texcoords_)
+            internal::copy_buffer_range(d->texcoord_buffer_, texcoord_buffer_, 0, v * sizeof(vec2), n * sizeof(vec2));
+        if (indexed_) {
+            // the indices are copied as they are and offset by the base vertex of the draw command
+            const std::size_t size = (index_type_ == GL_UNSIGNED_SHORT) ? sizeof(unsigned short) : sizeof(unsigned int);
+            internal::copy_buffer_range(d->element_buffer_, element_buffer_, 0, entry.index_offset * size,
+                                        entry.num_indices * size);
+        }
+        return true;
+    }
+
+
+    void TrianglesBatch::update_bounding_box() {
+        bbox_.clear();
+        for (const auto &e : entries_)
+            bbox_.grow(e.second.box);
+    }
+
+
+    void TrianglesBatch::update_commands() const {
+        std::vector<const Entry *> visible;
+        visible.reserve(entries_.size());
+        for (const auto &e : entries_) {
+            if (e.second.visible)
+                visible.push_back(&e.second);
+        }
+        // follow the memory order of the arena
+        std::sort(visible.begin(), visible.end(), [](const Entry *a, const Entry *b) {
+            return a->vertex_offset < b->vertex_offset;
+        });
+
+        const std::size_t index_size = (index_type_ == GL_UNSIGNED_SHORT) ? sizeof(unsigned short) : sizeof(unsigned int);
+        counts_.resize(visible.size());
+        firsts_.resize(visible.size());
+        offsets_.resize(indexed_ ? visible.size() : 0);
+        for (std::size_t i = 0; i < visible.size(); ++i) {
+            const Entry *e = visible[i];
+            firsts_[i] = static_cast<int>(e->vertex_offset);
+            if (indexed_) {
+                counts_[i] = static_cast<int>(e->num_indices);
+                offsets_[i] = reinterpret_cast<const void *>(e->index_offset * index_size);
+            } else
+                counts_[i] = static_cast<int>(e->num_vertices);
+        }
+        commands_changed_ = false;
+    }
+
+
+    void TrianglesBatch::draw(const Camera *camera) const {
+        if (commands_changed_)
+            update_commands();
+        if (counts_.empty())
+            return;
+        TrianglesDrawable::draw(camera);
+    }
+
+
+    void TrianglesBatch::issue_draw_call(std::size_t num_instances) const {
+        LOG_IF(num_instances > 0, WARNING) << "instanced drawing of a batch is not supported";
+        if (commands_changed_)
+            update_commands();
+        if (counts_.empty())
+            return;
+
+        const GLsizei count = static_cast<GLsizei>(counts_.size());
+        if (indexed_) {
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, element_buffer_);
+            easy3d_debug_log_gl_error
+            glMultiDrawElementsBaseVertex(type(), counts_.data(), index_type_, offsets_.data(), count, firsts_.data());
+            easy3d_debug_log_gl_error
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        } else
+            glMultiDrawArrays(type(), firsts_.data(), counts_.data(), count);
+        easy3d_debug_log_gl_error
+    }
+
+
+    TrianglesBatch *DrawableBatcher::add(TrianglesDrawable *drawable) {
+        if (!drawable)
+            return nullptr;
+        auto pos = owners_.find(drawable);
+        if (pos != owners_.end())
+            return pos->second;
+
+        for (const auto &b : batches_) {
+            if (b->add_drawable(drawable)) {
+                owners_[drawable] = b.get();
+                return b.get();
+            }
+        }
+
+        std::shared_ptr<TrianglesBatch> batch(new TrianglesBatch("batch_" + std::to_string(batches_.size())));
+        if (!batch->add_drawable(drawable))
+            return nullptr;
+        batches_.push_back(batch);
+        owners_[drawable] = batch.get();
+        return batch.get();
+    }
+
+
+    bool DrawableBatcher::remove(const TrianglesDrawable *drawable) {
+        auto pos = owners_.find(drawable);
+        if (pos == owners_.end())
+            return false;
+        pos->second->remove_drawable(drawable);
+        owners_.erase(pos);
+        return true;
+    }
+
+
+    TrianglesBatch *DrawableBatcher::batch(const TrianglesDrawable *drawable) const {
+        auto pos = owners_.find(drawable);
+        return pos == owners_.end() ? nullptr : pos->second;
+    }
+
+
+    void DrawableBatcher::set_visible(const TrianglesDrawable *drawable, bool b) {
+        auto pos = owners_.find(drawable);
+        if (pos != owners_.end())
+            pos->second->set_drawable_visible(drawable, b);
+    }
+
+
+    void DrawableBatcher::draw(const Camera *camera) const {
+        for (const auto &b : batches_) {
+            if (b->is_visible())
+                b->draw(camera);
+        }
+    }
+
+
+    void DrawableBatcher::clear() {
+        batches_.clear();
+        owners_.clear();
+    }
+
+}
@@ -0,0 +1,237 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#ifndef EASY3D_RENDERER_DRAWABLE_BATCH_H
+#define EASY3D_RENDERER_DRAWABLE_BATCH_H
+
+#include <easy3d/renderer/drawable_triangles.h>
+
+#include <map>
+#include <unordered_map>
+
+
+namespace easy3d {
+
+
+    /**
+     * \brief A drawable that renders many compatible TrianglesDrawables using shared buffers and a single draw call.
+     * \class TrianglesBatch easy3d/renderer/drawable_batch.h
+     * \details The vertex attributes and indices of the drawables are copied (on the GPU) into large shared buffers
+     *      (i.e., arenas), in which each drawable occupies a sub-range. All visible drawables are then rendered by a
+     *      single glMultiDrawElementsBaseVertex() (or glMultiDrawArrays() for non-indexed drawables) call, so the
+     *      per-drawable state changes and draw calls are eliminated. The free ranges of the arenas are recycled, so
+     *      adding and removing drawables does not rebuild the batch. The arenas grow geometrically if needed.
+     *
+     *      Drawables are compatible if they share the buffer layout (i.e., which buffers exist and their formats) and
+     *      the rendering state (e.g., coloring method, uniform color, lighting, and material). The batch takes the
+     *      state of its first drawable. Since a batch is rendered with its own manipulation matrix, the drawables of
+     *      models that are manipulated individually should not be batched.
+     *
+     * \note The batch copies the buffers of a drawable when it is added. If the drawable is updated later, call
+     *      update_drawable() to copy the new buffers. The batch does not own the drawables, and the drawables
+     *      themselves are still rendered by the viewer unless they are hidden.
+     * \sa DrawableBatcher
+     */
+    class TrianglesBatch : public TrianglesDrawable {
+    public:
+        /**
+         * \brief Constructor.
+         * \param name The name of the batch.
+         */
+        explicit TrianglesBatch(const std::string &name = "batch");
+
+        /**
+         * \brief Checks if a drawable is compatible with this batch.
+         * \details An empty batch is compatible with any drawable whose vertex positions are not quantized (see
+         *      Drawable::set_compact_buffers()).
+         */
+        bool is_compatible(const TrianglesDrawable *drawable) const;
+
+        /**
+         * \brief Adds a drawable to the batch.
+         * \details The rendering buffers of the drawable are created first if needed.
+         * \return true if the drawable was added, false if it is incompatible, empty, or already in the batch.
+         */
+        bool add_drawable(TrianglesDrawable *drawable);
+        /**
+         * \brief Removes a drawable from the batch. Its ranges in the arenas are released for reuse.
+         * \return true if the drawable was in the batch.
+         */
+        bool remove_drawable(const TrianglesDrawable *drawable);
+        /**
+         * \brief Copies the (updated) buffers of a drawable into the batch again.
+         * \return true if the drawable is (still) in the batch.
+         */
+        bool update_drawable(TrianglesDrawable *drawable);
+        /**
+         * \brief Checks if a drawable is in the batch.
+         */
+        bool contains(const TrianglesDrawable *drawable) const { return entries_.find(drawable) != entries_.end(); }
+        /**
+         * \brief Returns the number of drawables in the batch.
+         */
+        std::size_t num_drawables() const { return entries_.size(); }
+
+        /**
+         * \brief Shows/Hides a drawable in the batch. Hidden drawables are skipped by the draw command list.
+         */
+        void set_drawable_visible(const TrianglesDrawable *drawable, bool b);
+        /**
+         * \brief Returns whether a drawable in the batch is visible.
+         */
+        bool is_drawable_visible(const TrianglesDrawable *drawable) const;
+
+        /**
+         * \brief Returns the capacity of the vertex arena (in number of vertices).
+         */
+        std::size_t vertex_capacity() const { return vertex_capacity_; }
+        /**
+         * \brief Returns the capacity of the index arena (in number of indices).
+         */
+        std::size_t index_capacity() const { return index_capacity_; }
+
+        /**
+         * \brief Draws all visible drawables in the batch.
+         * \param camera The camera used for rendering.
+         */
+        void draw(const Camera *camera) const override;
+
+    protected:
+        // the buffers are filled by add_drawable()
+        void update_buffers_internal() override {}
+        // issues a single multi-draw call for the visible drawables
+        void issue_draw_call(std::size_t num_instances) const override;
+
+    private:
+        struct Entry {
+            std::size_t vertex_offset;
+            std::size_t num_vertices;
+            std::size_t index_offset;
+            std::size_t num_indices;
+            bool visible;
+            Box3 box;
+        };
+
+        // a first-fit sub-allocator of a range of elements, which merges adjacent free ranges
+        class RangeAllocator {
+        public:
+            static const std::size_t npos;
+            std::size_t allocate(std::size_t count);
+            void release(std::size_t offset, std::size_t count);
+            void grow(std::size_t old_capacity, std::size_t new_capacity);
+            void clear() { free_.clear(); }
+        private:
+            std::map<std::size_t, std::size_t> free_; // offset -> count
+        };
+
+        bool copy_buffers(const TrianglesDrawable *drawable, Entry &entry);
+        // grows the arenas (preserving their contents) to hold at least the requested numbers of elements
+        bool reserve(std::size_t num_vertices, std::size_t num_indices);
+        void update_bounding_box();
+        void update_commands() const;
+
+    private:
+        // the buffer layout shared by all drawables in the batch
+        bool indexed_;
+        bool has_normals_;
+        bool has_colors_;
+        bool has_texcoords_;
+
+        std::size_t vertex_capacity_;
+        std::size_t index_capacity_;
+        RangeAllocator vertex_ranges_;
+        RangeAllocator index_ranges_;
+
+        std::unordered_map<const TrianglesDrawable *, Entry> entries_;
+
+        // the draw command list
+        mutable bool commands_changed_;
+        mutable std::vector<int> counts_;
+        mutable std::vector<int> firsts_;               // first vertices (non-indexed) or base vertices (indexed)
+        mutable std::vector<const void *> offsets_;     // offsets into the index arena (indexed)
+    };
+
+
+    /**
+     * \brief Groups TrianglesDrawables into batches of compatible drawables.
+     * \class DrawableBatcher easy3d/renderer/drawable_batch.h
+     * \details Example usage:
+     *      \code
+     *          DrawableBatcher batcher;
+     *          for (auto model : viewer.models()) {
+     *              auto faces = model->renderer()->get_triangles_drawable("faces");
+     *              if (batcher.add(faces))
+     *                  faces->set_visible(false);  // now rendered by its batch
+     *          }
+     *          for (auto batch : batcher.batches())
+     *              viewer.add_drawable(batch);
+     *      \endcode
+     * \sa TrianglesBatch
+     */
+    class DrawableBatcher {
+    public:
+        /**
+         * \brief Adds a drawable to a compatible batch (a new batch is created if there is none).
+         * \return The batch holding the drawable, or nullptr if the drawable cannot be batched.
+         */
+        TrianglesBatch *add(TrianglesDrawable *drawable);
+        /**
+         * \brief Removes a drawable from its batch. Empty batches are kept for reuse.
+         * \return true if the drawable was batched.
+         */
+        bool remove(const TrianglesDrawable *drawable);
+        /**
+         * \brief Returns the batch holding a drawable, or nullptr if the drawable is not batched.
+         */
+        TrianglesBatch *batch(const TrianglesDrawable *drawable) const;
+        /**
+         * \brief Shows/Hides a batched drawable.
+         */
+        void set_visible(const TrianglesDrawable *drawable, bool b);
+
+        /**
+         * \brief Returns all batches.
+         */
+        const std::vector<std::shared_ptr<TrianglesBatch> > &batches() const { return batches_; }
+        /**
+         * \brief Draws all batches.
+         * \param camera The camera used for rendering.
+         */
+        void draw(const Camera *camera) const;
+        /**
+         * \brief Deletes all batches.
+         */
+        void clear();
+
+    private:
+        std::vector<std::shared_ptr<TrianglesBatch> > batches_;
+        std::unordered_map<const TrianglesDrawable *, TrianglesBatch *> owners_;
+    };
+
+}
+
+
+#endif  // EASY3D_RENDERER_DRAWABLE_BATCH_H
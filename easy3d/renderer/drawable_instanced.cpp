@@ -0,0 +1,312 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#include <easy3d/renderer/drawable_instanced.h>
+#include <easy3d/renderer/camera.h>
+#include <easy3d/renderer/shader_program.h>
+#include <easy3d/renderer/shader_manager.h>
+#include <easy3d/renderer/texture_manager.h>
+#include <easy3d/renderer/clipping_plane.h>
+#include <easy3d/renderer/vertex_array_object.h>
+#include <easy3d/renderer/transform.h>
+#include <easy3d/util/setting.h>
+#include <easy3d/util/logging.h>
+#include <easy3d/util/thread_pool.h>
+
+
+namespace easy3d {
+
+    InstancedDrawable::InstancedDrawable(const std::string& name, Model* prototype)
+            : TrianglesDrawable(name, prototype)
+            , per_instance_coloring_(false)
+            , instances_changed_(true)
+            , transform_buffer_(0)
+            , normal_matrix_buffer_(0)
+            , instance_color_buffer_(0)
+            , instances_box_changed_(true)
+    {
+    }
+
+
+    InstancedDrawable::~InstancedDrawable() {
+        VertexArrayObject::release_buffer(transform_buffer_);
+        VertexArrayObject::release_buffer(normal_matrix_buffer_);
+        VertexArrayObject::release_buffer(instance_color_buffer_);
+    }
+
+
+    std::size_t InstancedDrawable::add_instance(const mat4& transform, const vec4& color, int id) {
+        const std::size_t index = transforms_.size();
+        transforms_.push_back(transform);
+        colors_.push_back(color);
+        visible_.push_back(1);
+        ids_.push_back(id < 0 ? static_cast<int>(index) : id);
+        instances_changed_ = true;
+        instances_box_changed_ = true;
+        return index;
+    }
+
+
+    void InstancedDrawable::clear_instances() {
+        transforms_.clear();
+        colors_.clear();
+        visible_.clear();
+        ids_.clear();
+        instances_changed_ = true;
+        instances_box_changed_ = true;
+    }
+
+
+    std::size_t InstancedDrawable::num_visible_instances() const {
+        std::size_t num = 0;
+        for (auto v : visible_)
+            num += v;
+        return num;
+    }
+
+
+    void InstancedDrawable::set_instance_transform(std::size_t i, const mat4& transform) {
+        transforms_[i] = transform;
+        instances_changed_ = true;
+        instances_box_changed_ = true;
+    }
+
+
+    void InstancedDrawable::set_instance_color(std::size_t i, const vec4& color) {
+        colors_[i] = color;
+        instances_changed_ = true;
+    }
+
+
+    void InstancedDrawable::set_instance_visible(std::size_t i, bool b) {
+        if (is_instance_visible(i) == b)
+            return;
+        visible_[i] = b ? 1 : 0;
+        instances_changed_ = true;
+        instances_box_changed_ = true;
+    }
+
+
+    const Box3& InstancedDrawable::bounding_box() const {
+        if (!instances_box_changed_)
+            return instances_box_;
+
+        const Box3& box = Drawable::bounding_box();
+        instances_box_.clear();
+        if (box.is_valid()) {
+            const vec3& a = box.min_point();
+            const vec3& b = box.max_point();
+            const vec3 corners[8] = {
+                    vec3(a.x, a.y, a.z), vec3(b.x, a.y, a.z), vec3(a.x, b.y, a.z), vec3(b.x, b.y, a.z),
+                    vec3(a.x, a.y, b.z), vec3(b.x, a.y, b.z), vec3(a.x, b.y, b.z), vec3(b.x, b.y, b.z)
+            };
+            instances_box_ = parallel_reduce(std::size_t(0), transforms_.size(), Box3(),
+                    [&](std::size_t first, std::size_t last) {
+                        Box3 result;
+                        for (std::size_t i = first; i < last; ++i) {
+                            if (!visible_[i])
+                                continue;
+                            for (const auto& p : corners)
+                                result.grow(transforms_[i] * p);
+                        }
+                        return result;
+                    },
+                    [](const Box3& x, const Box3& y) {
+                        Box3 result = x;
+                        result.grow(y);
+                        return result;
+                    }, 4096);
+            // the prototype geometry may not be available yet
+            instances_box_changed_ = false;
+        }
+        return instances_box_;
+    }
+
+
+    void InstancedDrawable::update_instance_buffers() const {
+        uploaded_.clear();
+        for (std::size_t i = 0; i < visible_.size(); ++i) {
+            if (visible_[i])
+                uploaded_.push_back(i);
+        }
+
+        const std::size_t num = uploaded_.size();
+        std::vector<mat4> transforms(num);
+        std::vector<mat3> normal_matrices(num);
+        std::vector<vec4> colors(num);
+        parallel_for(std::size_t(0), num, [&](std::size_t k) {
+            const std::size_t i = uploaded_[k];
+            transforms[k] = transforms_[i];
+            normal_matrices[k] = transform::normal_matrix(transforms_[i]);
+            colors[k] = colors_[i];
+        }, 4096);
+
+        auto vao = const_cast<VertexArrayObject*>(vao_.get());
+        if (num == 0) {
+            VertexArrayObject::release_buffer(transform_buffer_);
+            VertexArrayObject::release_buffer(normal_matrix_buffer_);
+            VertexArrayObject::release_buffer(instance_color_buffer_);
+        } else {
+            bool success = vao->create_instance_buffer(transform_buffer_, ShaderProgram::INSTANCE_TRANSFORM,
+                                                       transforms.data(), num * sizeof(mat4), 4, 4);
+            success = success && vao->create_instance_buffer(normal_matrix_buffer_, ShaderProgram::INSTANCE_NORMAL_MATRIX,
+                                                             normal_matrices.data(), num * sizeof(mat3), 3, 3);
+            success = success && vao->create_instance_buffer(instance_color_buffer_, ShaderProgram::INSTANCE_COLOR,
+                                                             colors.data(), num * sizeof(vec4), 4, 1);
+            if (!success) {
+                LOG(ERROR) << "failed creating instance buffers for drawable '" << name() << "'";
+                uploaded_.clear();
+            }
+        }
+        instances_changed_ = false;
+    }
+
+
+    void InstancedDrawable::draw(const Camera *camera) const {
+        if (update_needed_ || vertex_buffer_ == 0) {
+            const_cast<InstancedDrawable *>(this)->update_buffers_internal();
+            const_cast<InstancedDrawable *>(this)->update_needed_ = false;
+            instances_box_changed_ = true;
+        }
+        if (instances_changed_)
+            update_instance_buffers();
+        if (uploaded_.empty())
+            return;
+
+        const std::string vert_file = "surface/surface_instanced.vert";
+        const std::string frag_file = "surface/surface.frag";
+        ShaderProgram *program = ShaderManager::get_program(vert_file + frag_file);
+        if (!program) {
+            std::vector<ShaderProgram::Attribute> attributes = {
+                    ShaderProgram::Attribute(ShaderProgram::POSITION, "vtx_position"),
+                    ShaderProgram::Attribute(ShaderProgram::TEXCOORD, "vtx_texcoord"),
+                    ShaderProgram::Attribute(ShaderProgram::COLOR, "vtx_color"),
+                    ShaderProgram::Attribute(ShaderProgram::NORMAL, "vtx_normal"),
+                    ShaderProgram::Attribute(ShaderProgram::INSTANCE_TRANSFORM, "instance_transform"),
+                    ShaderProgram::Attribute(ShaderProgram::INSTANCE_NORMAL_MATRIX, "instance_normal_matrix"),
+                    ShaderProgram::Attribute(ShaderProgram::INSTANCE_COLOR, "instance_color")
+            };
+            program = ShaderManager::create_program_from_files(vert_file, frag_file, "", "", "", "", attributes);
+        }
+
+        if (!program)
+            return;
+
+        const mat4 &MVP = camera->modelViewProjectionMatrix();
+        // camera position is defined in world coordinate system.
+        const vec3 &wCamPos = camera->position();
+        const mat4 &MV = camera->modelViewMatrix();
+        const vec4 &wLightPos = inverse(MV) * setting::light_position;
+
+        // transformation introduced by manipulation
+        const mat4 MANIP = manipulated_matrix();
+        const mat3 NORMAL = transform::normal_matrix(MANIP);
+
+        program->bind();
+        program->set_uniform("MVP", MVP)
+                ->set_uniform("MANIP", MANIP)
+                ->set_uniform( "NORMAL", NORMAL)
+                ->set_uniform("lighting", lighting())
+                ->set_uniform("wLightPos", wLightPos)
+                ->set_uniform("wCamPos", wCamPos)
+                ->set_uniform("two_sides_lighting", lighting_two_sides())
+                ->set_uniform("distinct_back_color", distinct_back_color())
+                ->set_uniform("backside_color", back_color())
+                ->set_uniform("smooth_shading", smooth_shading())
+                ->set_uniform("ssaoEnabled", is_ssao_enabled())
+                ->set_uniform("per_instance_color", per_instance_coloring())
+                ->set_uniform("per_vertex_color", coloring_method() != State::UNIFORM_COLOR && color_buffer())
+                ->set_uniform("default_color", color())
+                ->set_block_uniform("Material", "ambient", material().ambient)
+                ->set_block_uniform("Material", "specular", material().specular)
+                ->set_block_uniform("Material", "shininess", &material().shininess)
+                ->set_uniform("highlight", highlight())
+                ->set_uniform("highlight_id_min", highlight_range().first)
+                ->set_uniform("highlight_id_max", highlight_range().second)
+                ->set_uniform("selected", is_selected())
+                ->set_uniform("highlight_color", setting::highlight_color);
+
+        bool use_texture = (texture() && (coloring_method() == State::SCALAR_FIELD || coloring_method() == State::TEXTURED));
+        program->set_uniform("use_texture", use_texture);
+        if (use_texture)
+            program->bind_texture("textureID", texture()->id(), 0)
+                ->set_uniform("texture_repeat", texture_repeat())
+                ->set_uniform("fractional_repeat", texture_fractional_repeat());
+
+        ClippingPlane::instance()->set_program(program);
+        ClippingPlane::instance()->set_discard_primitives(program, plane_clip_discard_primitive());
+
+        if (is_ssao_enabled())
+            program->bind_texture("ssaoTexture", ssao_texture_, 1);
+        gl_draw_instanced(uploaded_.size());
+        if (is_ssao_enabled())
+            program->release_texture();
+
+        if (use_texture)
+            program->release_texture();
+        program->release();
+    }
+
+
+    void InstancedDrawable::draw_instance_ids(const Camera *camera) const {
+        if (update_needed_ || vertex_buffer_ == 0) {
+            const_cast<InstancedDrawable *>(this)->update_buffers_internal();
+            const_cast<InstancedDrawable *>(this)->update_needed_ = false;
+            instances_box_changed_ = true;
+        }
+        if (instances_changed_)
+            update_instance_buffers();
+        if (uploaded_.empty())
+            return;
+
+        const std::string name = "selection/selection_instance";
+        ShaderProgram *program = ShaderManager::get_program(name);
+        if (!program) {
+            std::vector<ShaderProgram::Attribute> attributes = {
+                    ShaderProgram::Attribute(ShaderProgram::POSITION, "vtx_position"),
+                    ShaderProgram::Attribute(ShaderProgram::INSTANCE_TRANSFORM, "instance_transform")
+            };
+            program = ShaderManager::create_program_from_files(name, attributes);
+        }
+
+        if (!program)
+            return;
+
+        program->bind();
+        program->set_uniform("MVP", camera->modelViewProjectionMatrix())
+                ->set_uniform("MANIP", manipulated_matrix());
+        gl_draw_instanced(uploaded_.size());
+        program->release();
+    }
+
+
+    int InstancedDrawable::picked_instance(int encoded_color) const {
+        if (encoded_color < 0 || static_cast<std::size_t>(encoded_color) >= uploaded_.size())
+            return -1;
+        return static_cast<int>(uploaded_[encoded_color]);
+    }
+
+}
@@ -0,0 +1,194 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#ifndef EASY3D_RENDERER_DRAWABLE_INSTANCED_H
+#define EASY3D_RENDERER_DRAWABLE_INSTANCED_H
+
+#include <easy3d/renderer/drawable_triangles.h>
+
+
+namespace easy3d {
+
+
+    /**
+     * \brief The drawable for rendering many copies (i.e., instances) of the same geometry.
+     * \class InstancedDrawable easy3d/renderer/drawable_instanced.h
+     * \details The geometry (e.g., a SurfaceMesh, called the prototype) is uploaded to the GPU only once and each
+     *      instance is specified by a transformation, a color, a visibility flag, and an id. All visible instances
+     *      are rendered by a single instanced draw call (i.e., glDrawElementsInstanced()), so a scene consisting of
+     *      hundreds of thousands of copies of a few parts requires only one drawable (and one draw call) per part.
+     *      Example usage:
+     *      \code
+     *          auto bolt = SurfaceMeshIO::load("bolt.ply");   // the prototype, not necessarily added to the viewer
+     *          auto drawable = new InstancedDrawable("bolts", bolt);
+     *          for (const auto& m : placements)
+     *              drawable->add_instance(m);
+     *          viewer.add_drawable(drawable);
+     *      \endcode
+     *      The rendering buffers of the prototype are created like the "faces" drawable of a SurfaceMesh (see
+     *      buffer::update()), or by the update function if it is provided (see set_update_func()).
+     * \note The drawable does not own the prototype model, which must outlive the drawable. The manipulation of the
+     *      drawable (see Drawable::manipulated_matrix()) is applied on top of the transformations of the instances.
+     * \sa TrianglesDrawable, InstancePicker
+     */
+    class InstancedDrawable : public TrianglesDrawable {
+    public:
+        /**
+         * \brief Constructor that initializes the drawable with a name and the prototype model.
+         * \param name The name of the drawable.
+         * \param prototype The model to be placed many times (can be nullptr if an update function is provided).
+         */
+        explicit InstancedDrawable(const std::string& name = "", Model* prototype = nullptr);
+        /**
+         * \brief Destructor.
+         */
+        ~InstancedDrawable() override;
+
+        /// \name Instances
+        /// @{
+        /**
+         * \brief Adds an instance.
+         * \param transform The transformation placing the prototype in the scene.
+         * \param color The color of the instance, used if per-instance coloring is enabled.
+         * \param id The id of the instance (e.g., the id of the part it represents in the application), which can
+         *      be queried by instance_id(). A negative value uses the index of the instance.
+         * \note Picking (see picked_instance() and InstancePicker) reports the index of the instance, not its id.
+         * \return The index of the new instance.
+         */
+        std::size_t add_instance(const mat4& transform, const vec4& color = vec4(1.0f, 1.0f, 1.0f, 1.0f), int id = -1);
+        /**
+         * \brief Removes all instances.
+         */
+        void clear_instances();
+
+        /**
+         * \brief Returns the number of instances.
+         */
+        std::size_t num_instances() const { return transforms_.size(); }
+        /**
+         * \brief Returns the number of visible instances.
+         */
+        std::size_t num_visible_instances() const;
+
+        /**
+         * \brief Returns the transformation of the \p i-th instance.
+         */
+        const mat4& instance_transform(std::size_t i) const { return transforms_[i]; }
+        /**
+         * \brief Sets the transformation of the \p i-th instance.
+         */
+        void set_instance_transform(std::size_t i, const mat4& transform);
+
+        /**
+         * \brief Returns the color of the \p i-th instance.
+         */
+        const vec4& instance_color(std::size_t i) const { return colors_[i]; }
+        /**
+         * \brief Sets the color of the \p i-th instance.
+         */
+        void set_instance_color(std::size_t i, const vec4& color);
+
+        /**
+         * \brief Returns whether the \p i-th instance is visible.
+         */
+        bool is_instance_visible(std::size_t i) const { return visible_[i] != 0; }
+        /**
+         * \brief Shows/Hides the \p i-th instance. Hidden instances are not uploaded to the GPU.
+         */
+        void set_instance_visible(std::size_t i, bool b);
+
+        /**
+         * \brief Returns the id of the \p i-th instance.
+         */
+        int instance_id(std::size_t i) const { return ids_[i]; }
+        /**
+         * \brief Sets the id of the \p i-th instance.
+         */
+        void set_instance_id(std::size_t i, int id) { ids_[i] = id; }
+
+        /**
+         * \brief Returns whether each instance is rendered in its own color.
+         * \details If disabled (default), the coloring method of the drawable (see State) is used for all instances.
+         */
+        bool per_instance_coloring() const { return per_instance_coloring_; }
+        /**
+         * \brief Sets whether each instance is rendered in its own color.
+         */
+        void set_per_instance_coloring(bool b) { per_instance_coloring_ = b; }
+        /// @}
+
+        /**
+         * \brief Returns the bounding box of all visible instances.
+         */
+        const Box3& bounding_box() const override;
+
+        /**
+         * \brief Draws all visible instances.
+         * \param camera The camera used for rendering.
+         */
+        void draw(const Camera* camera) const override;
+
+        /**
+         * \brief Draws all visible instances, each in a color encoding its position in the list of visible
+         *      instances (see color::encode()). This is used for picking.
+         * \param camera The camera used for rendering.
+         * \sa picked_instance(), InstancePicker
+         */
+        void draw_instance_ids(const Camera* camera) const;
+        /**
+         * \brief Converts the encoded color read back from a rendering of draw_instance_ids() into the index of the
+         *      instance.
+         * \param encoded_color The color encoded as an integer (see color::encode()).
+         * \return The index of the instance, or -1 if no instance is encoded by the color.
+         */
+        int picked_instance(int encoded_color) const;
+
+    protected:
+        // uploads the per-instance buffers of the visible instances
+        void update_instance_buffers() const;
+
+    private:
+        std::vector<mat4> transforms_;
+        std::vector<vec4> colors_;
+        std::vector<unsigned char> visible_;
+        std::vector<int> ids_;
+        bool per_instance_coloring_;
+
+        // the indices of the instances uploaded to the GPU (i.e., the visible ones), in the order of the uploading
+        mutable std::vector<std::size_t> uploaded_;
+        mutable bool instances_changed_;
+        mutable unsigned int transform_buffer_;
+        mutable unsigned int normal_matrix_buffer_;
+        mutable unsigned int instance_color_buffer_;
+
+        mutable Box3 instances_box_;
+        mutable bool instances_box_changed_;
+    };
+
+}
+
+
+#endif  // EASY3D_RENDERER_DRAWABLE_INSTANCED_H
@@ -38,6 +38,7 @@
 #include <easy3d/renderer/transform.h>
 #include <easy3d/renderer/clipping_plane.h>
 #include <easy3d/renderer/texture.h>
+#include <easy3d/renderer/frame_profiler.h>
 #include <easy3d/util/setting.h>
 
 //#define SAVE_INTERMEDIATE_FBO
@@ -314,6 +315,8 @@ namespace easy3d {
         if (surfaces.empty())
             return;
 
+        FrameProfiler::Scope scope("dual depth peeling");
+
         int viewport[4];
         glGetIntegerv(GL_VIEWPORT, viewport);
         width_ = viewport[2];
@@ -31,6 +31,7 @@
 #include <easy3d/renderer/opengl_error.h>
 #include <easy3d/renderer/shape.h>
 #include <easy3d/renderer/camera.h>
+#include <easy3d/renderer/frame_profiler.h>
 
 
 namespace easy3d {
@@ -293,6 +294,9 @@ namespace easy3d {
 
     void EyeDomeLighting::begin()
     {
+        // the scene is drawn between begin() and end(), so the setup and the shading are measured separately
+        FrameProfiler::Scope scope("EDL (setup)");
+
         int viewport[4];
         glGetIntegerv(GL_VIEWPORT, viewport);
         width_ = viewport[2];
@@ -322,6 +326,8 @@ namespace easy3d {
 
     void EyeDomeLighting::end()
     {
+        FrameProfiler::Scope scope("EDL");
+
         projection_fbo_->release();
 
         // full resolution pass
@@ -0,0 +1,329 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#include <easy3d/renderer/frame_profiler.h>
+
+#include <iomanip>
+#include <sstream>
+
+#include <easy3d/renderer/opengl.h>
+#include <easy3d/renderer/opengl_util.h>
+#include <easy3d/renderer/opengl_error.h>
+#include <easy3d/util/logging.h>
+
+
+namespace easy3d {
+
+    namespace internal {
+        // The maximum number of CPU scopes kept between two frames (e.g., if no frame is rendered at all).
+        const std::size_t max_outside_scopes = 1024;
+
+        inline std::string escape_json(const std::string &s) {
+            std::string result;
+            result.reserve(s.size());
+            for (char c : s) {
+                if (c == '"' || c == '\\')
+                    result += '\\';
+                if (static_cast<unsigned char>(c) >= 0x20)
+                    result += c;
+            }
+            return result;
+        }
+    }
+
+
+    FrameProfiler::Scope::Scope(const char *name, bool gpu) {
+        FrameProfiler *profiler = FrameProfiler::instance();
+        // the scopes of other threads (e.g., buffer updates on worker threads) are ignored
+        active_ = profiler->is_enabled() && profiler->is_rendering_thread() && profiler->begin_scope(name, gpu);
+    }
+
+
+    FrameProfiler::Scope::~Scope() {
+        if (active_)
+            FrameProfiler::instance()->end_scope();
+    }
+
+
+    FrameProfiler::FrameProfiler()
+            : enabled_(false)
+            , timer_supported_(-1)
+            , current_(0)
+            , in_frame_(false)
+            , num_frames_(0)
+            , num_dropped_frames_(0)
+    {
+    }
+
+
+    FrameProfiler::~FrameProfiler() {
+        // The query objects are not deleted here because the OpenGL context may not exist anymore. Call clear()
+        // before destroying the context.
+        if (trace_.is_open())
+            trace_.close();
+    }
+
+
+    FrameProfiler *FrameProfiler::instance() {
+        static FrameProfiler profiler;
+        return &profiler;
+    }
+
+
+    void FrameProfiler::set_enabled(bool b) {
+        rendering_thread_ = std::this_thread::get_id();
+        if (enabled_ == b)
+            return;
+        enabled_ = b;
+        // discard the frames in flight
+        in_frame_ = false;
+        stack_.clear();
+        outside_scopes_.clear();
+        for (auto &slot : slots_)
+            slot.pending = false;
+    }
+
+
+    void FrameProfiler::clear() {
+        for (auto &slot : slots_) {
+            if (!slot.queries.empty()) {
+                glDeleteQueries(static_cast<GLsizei>(slot.queries.size()), slot.queries.data());
+                easy3d_debug_log_gl_error
+            }
+            slot = Slot();
+        }
+        in_frame_ = false;
+        stack_.clear();
+        outside_scopes_.clear();
+        timer_supported_ = -1;
+    }
+
+
+    int FrameProfiler::issue_query(Slot &slot) {
+        if (timer_supported_ < 0) {
+            timer_supported_ = OpenglUtil::is_supported("GL_ARB_timer_query") ? 1 : 0;
+            LOG_IF(!timer_supported_, WARNING) << "GL_ARB_timer_query not supported. Only CPU times are measured";
+        }
+        if (!timer_supported_)
+            return -1;
+
+        if (slot.num_used_queries == slot.queries.size()) {
+            const std::size_t old_size = slot.queries.size();
+            slot.queries.resize(std::max<std::size_t>(32, old_size * 2), 0);
+            glGenQueries(static_cast<GLsizei>(slot.queries.size() - old_size), slot.queries.data() + old_size);
+            easy3d_debug_log_gl_error
+        }
+        const std::size_t index = slot.num_used_queries++;
+        glQueryCounter(slot.queries[index], GL_TIMESTAMP);
+        easy3d_debug_log_gl_error
+        return static_cast<int>(index);
+    }
+
+
+    void FrameProfiler::begin_frame() {
+        if (!enabled_)
+            return;
+        rendering_thread_ = std::this_thread::get_id();
+        if (in_frame_) {
+            LOG_N_TIMES(3, WARNING) << "begin_frame() called twice without end_frame(). " << COUNTER;
+            end_frame();
+        }
+
+        current_ = (current_ + 1) % num_slots;
+        Slot &slot = slots_[current_];
+        // the queries of the slot are reused, so its results have to be collected (or dropped) first
+        if (slot.pending && !collect(slot)) {
+            ++num_dropped_frames_;
+            slot.pending = false;
+        }
+
+        slot.frame_index = num_frames_++;
+        slot.scopes.clear();
+        slot.num_used_queries = 0;
+        slot.cpu_time = clock_.elapsed_seconds(6) * 1000.0;
+        slot.query_begin = issue_query(slot);
+        slot.query_end = -1;
+
+        // the CPU scopes recorded since the last frame (e.g., buffer updates)
+        if (!stack_.empty()) {
+            LOG_N_TIMES(3, WARNING) << stack_.size() << " scope(s) not ended before the frame. " << COUNTER;
+            stack_.clear();
+        }
+        slot.scopes.swap(outside_scopes_);
+        outside_scopes_.clear();
+
+        in_frame_ = true;
+    }
+
+
+    void FrameProfiler::end_frame() {
+        if (!enabled_ || !in_frame_)
+            return;
+
+        Slot &slot = slots_[current_];
+        if (!stack_.empty()) {
+            LOG_N_TIMES(3, WARNING) << stack_.size() << " scope(s) not ended within the frame. " << COUNTER;
+            while (!stack_.empty())
+                end_scope();
+        }
+        slot.query_end = issue_query(slot);
+        slot.cpu_time = clock_.elapsed_seconds(6) * 1000.0 - slot.cpu_time;
+        slot.pending = true;
+        in_frame_ = false;
+
+        // Collect the previous frame if its results are available already. This does not wait for the GPU.
+        Slot &previous = slots_[(current_ + num_slots - 1) % num_slots];
+        if (previous.pending)
+            collect(previous);
+    }
+
+
+    bool FrameProfiler::begin_scope(const char *name, bool gpu) {
+        if (!enabled_ || (gpu && !in_frame_) || !is_rendering_thread())
+            return false;
+
+        std::vector<PendingScope> &scopes = in_frame_ ? slots_[current_].scopes : outside_scopes_;
+        if (!in_frame_ && scopes.size() >= internal::max_outside_scopes)
+            return false;
+
+        PendingScope scope;
+        scope.name = name;
+        scope.depth = static_cast<int>(stack_.size());
+        scope.cpu_begin = clock_.elapsed_seconds(6) * 1000.0;
+        scope.cpu_end = scope.cpu_begin;
+        scope.query_begin = gpu ? issue_query(slots_[current_]) : -1;
+        scope.query_end = -1;
+        stack_.push_back(scopes.size());
+        scopes.push_back(scope);
+        return true;
+    }
+
+
+    void FrameProfiler::end_scope() {
+        if (stack_.empty())
+            return;
+
+        std::vector<PendingScope> &scopes = in_frame_ ? slots_[current_].scopes : outside_scopes_;
+        const std::size_t index = stack_.back();
+        stack_.pop_back();
+        if (index >= scopes.size())
+            return;
+        PendingScope &scope = scopes[index];
+        if (scope.query_begin >= 0)
+            scope.query_end = issue_query(slots_[current_]);
+        scope.cpu_end = clock_.elapsed_seconds(6) * 1000.0;
+    }
+
+
+    bool FrameProfiler::collect(Slot &slot) {
+        std::vector<GLuint64> timestamps;
+        if (slot.num_used_queries > 0) {
+            // if the last query is available, all the previous ones are available as well
+            GLint available = 0;
+            glGetQueryObjectiv(slot.queries[slot.num_used_queries - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+            easy3d_debug_log_gl_error
+            if (!available)
+                return false;
+
+            timestamps.resize(slot.num_used_queries, 0);
+            for (std::size_t i = 0; i < slot.num_used_queries; ++i)
+                glGetQueryObjectui64v(slot.queries[i], GL_QUERY_RESULT, &timestamps[i]);
+            easy3d_debug_log_gl_error
+        }
+
+        const auto elapsed = [&timestamps](int begin, int end) -> double {
+            if (begin < 0 || end < 0 || timestamps[end] < timestamps[begin])
+                return -1.0;
+            return static_cast<double>(timestamps[end] - timestamps[begin]) / 1000000.0;
+        };
+
+        Frame frame;
+        frame.index = slot.frame_index;
+        frame.cpu_time = slot.cpu_time;
+        frame.gpu_time = elapsed(slot.query_begin, slot.query_end);
+        frame.records.reserve(slot.scopes.size());
+        for (const auto &scope : slot.scopes)
+            frame.records.push_back({scope.name, scope.depth, scope.cpu_end - scope.cpu_begin,
+                                     elapsed(scope.query_begin, scope.query_end)});
+        slot.pending = false;
+
+        last_frame_ = std::move(frame);
+        if (trace_.is_open())
+            write_trace(last_frame_);
+        return true;
+    }
+
+
+    std::vector<std::string> FrameProfiler::report() const {
+        std::vector<std::string> lines;
+        std::ostringstream line;
+        line << std::fixed << std::setprecision(2) << "frame " << last_frame_.index << ": CPU "
+             << last_frame_.cpu_time << " ms, GPU ";
+        if (last_frame_.gpu_time >= 0.0)
+            line << last_frame_.gpu_time << " ms";
+        else
+            line << "-";
+        lines.push_back(line.str());
+
+        for (const auto &record : last_frame_.records) {
+            line.str("");
+            line << std::string(static_cast<std::size_t>(record.depth + 1) * 2, ' ') << record.name << ": CPU "
+                 << record.cpu_time << " ms";
+            if (record.gpu_time >= 0.0)
+                line << ", GPU " << record.gpu_time << " ms";
+            lines.push_back(line.str());
+        }
+        return lines;
+    }
+
+
+    bool FrameProfiler::set_trace_file(const std::string &file_name) {
+        if (trace_.is_open())
+            trace_.close();
+        if (file_name.empty())
+            return true;
+
+        trace_.open(file_name.c_str());
+        if (trace_.fail()) {
+            LOG(ERROR) << "could not open file: " << file_name;
+            return false;
+        }
+        return true;
+    }
+
+
+    void FrameProfiler::write_trace(const Frame &frame) {
+        trace_ << "{\"frame\":" << frame.index << ",\"cpu_ms\":" << frame.cpu_time << ",\"gpu_ms\":"
+               << frame.gpu_time << ",\"scopes\":[";
+        for (std::size_t i = 0; i < frame.records.size(); ++i) {
+            const Record &r = frame.records[i];
+            trace_ << (i > 0 ? "," : "") << "{\"name\":\"" << internal::escape_json(r.name) << "\",\"depth\":"
+                   << r.depth << ",\"cpu_ms\":" << r.cpu_time << ",\"gpu_ms\":" << r.gpu_time << "}";
+        }
+        trace_ << "]}\n";
+    }
+
+}
@@ -0,0 +1,220 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#ifndef EASY3D_RENDERER_FRAME_PROFILER_H
+#define EASY3D_RENDERER_FRAME_PROFILER_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <atomic>
+#include <thread>
+
+#include <easy3d/util/stop_watch.h>
+
+
+namespace easy3d {
+
+    /**
+     * \brief A profiler of the rendering frames with nested CPU and GPU scopes.
+     * \class FrameProfiler easy3d/renderer/frame_profiler.h
+     * \details The profiler measures named scopes of each frame, e.g., the draw calls of the drawables, the effect
+     *      passes (SSAO, shadow, transparency, EDL), the text rendering, and the updates of the rendering buffers.
+     *      Scopes can be nested. A GPU scope measures both the CPU time and the GPU time, and a CPU scope measures
+     *      only the CPU time (e.g., for buffer updates).
+     *
+     *      Different from OpenGLTimer, the GPU times are measured by timestamp queries, which allows nesting, and the
+     *      queries are double-buffered: the results of a frame are collected after the next frame is submitted, so
+     *      the profiler never waits for the GPU. As a result, last_frame() lags one or two frames behind. If the
+     *      results of a frame are not available when its queries have to be reused, the frame is dropped.
+     *
+     *      The profiler is disabled by default, and the scopes cost almost nothing then. The completed frames can
+     *      be written into a trace file, one JSON object per line (see set_trace_file()).
+     *
+     *      Example usage:
+     *          \code
+     *              FrameProfiler::instance()->set_enabled(true);
+     *              // in the rendering loop
+     *              FrameProfiler::instance()->begin_frame();
+     *              {
+     *                  FrameProfiler::Scope scope("SSAO");
+     *                  ssao->generate(models);
+     *              }
+     *              ...
+     *              FrameProfiler::instance()->end_frame();
+     *              // e.g., in an overlay
+     *              for (const auto& line : FrameProfiler::instance()->report())
+     *                  std::cout << line << std::endl;
+     *          \endcode
+     * \note All the functions must be called from the rendering thread with the OpenGL context current, except
+     *      that scopes can be started from any thread: the scopes of the threads other than the rendering thread
+     *      (i.e., the one that called set_enabled() or begin_frame() last), e.g., buffer updates by worker threads,
+     *      are ignored.
+     */
+    class FrameProfiler {
+    public:
+        /**
+         * \brief The timing of a scope.
+         */
+        struct Record {
+            std::string name;   ///< The name of the scope.
+            int depth;          ///< The nesting depth (0 for the top-level scopes).
+            double cpu_time;    ///< The CPU time (in milliseconds).
+            double gpu_time;    ///< The GPU time (in milliseconds), negative for CPU scopes or if not supported.
+        };
+
+        /**
+         * \brief The timing of a frame.
+         */
+        struct Frame {
+            std::size_t index = 0;          ///< The index of the frame.
+            double cpu_time = 0.0;          ///< The CPU time of the frame (in milliseconds).
+            double gpu_time = -1.0;         ///< The GPU time of the frame (in milliseconds), negative if unknown.
+            std::vector<Record> records;    ///< The scopes in the order they were started.
+        };
+
+        /**
+         * \brief A scope that is measured from its construction to its destruction.
+         */
+        class Scope {
+        public:
+            /**
+             * \brief Starts a scope of the profiler.
+             * \param name The name of the scope.
+             * \param gpu \c true to also measure the GPU time (only within a frame).
+             */
+            explicit Scope(const char *name, bool gpu = true);
+            /**
+             * \brief Ends the scope.
+             */
+            ~Scope();
+        private:
+            bool active_;
+        };
+
+    public:
+        FrameProfiler();
+        ~FrameProfiler();
+
+        /// returns the instance of the profiler. The entire program has only one profiler.
+        static FrameProfiler *instance();
+
+        /// enables/disables the profiler.
+        void set_enabled(bool b);
+        /// returns whether the profiler is enabled.
+        bool is_enabled() const { return enabled_; }
+        /// returns whether the calling thread is the rendering thread, whose scopes are recorded.
+        bool is_rendering_thread() const { return std::this_thread::get_id() == rendering_thread_; }
+
+        /// starts a frame.
+        void begin_frame();
+        /// ends the frame started by begin_frame().
+        void end_frame();
+        /// returns whether a frame has been started (and not ended yet).
+        bool in_frame() const { return in_frame_; }
+
+        /**
+         * \brief Starts a scope. Each begin_scope() must be paired with an end_scope() (see Scope).
+         * \details Outside a frame, a GPU scope is ignored and a CPU scope is reported with the next frame. A scope
+         *      started from a thread other than the rendering thread is ignored.
+         * \return \c true if the scope is recorded. Only then end_scope() must be called.
+         */
+        bool begin_scope(const char *name, bool gpu);
+        /// ends the scope started last.
+        void end_scope();
+
+        /// returns the latest frame whose results have been collected.
+        const Frame &last_frame() const { return last_frame_; }
+        /// returns the number of frames dropped because their GPU results were not available in time.
+        std::size_t num_dropped_frames() const { return num_dropped_frames_; }
+
+        /**
+         * \brief Returns a human-readable report of last_frame(), one line per scope (indented by nesting depth),
+         *      e.g., for an overlay.
+         */
+        std::vector<std::string> report() const;
+
+        /**
+         * \brief Writes each completed frame into \p file_name as a line of JSON, e.g.,
+         *      {"frame":12,"cpu_ms":3.1,"gpu_ms":5.2,"scopes":[{"name":"faces","depth":0,"cpu_ms":0.2,"gpu_ms":4.9}]}.
+         * \param file_name The trace file. An empty string stops tracing.
+         * \return \c true on success.
+         */
+        bool set_trace_file(const std::string &file_name);
+
+        /// releases the OpenGL query objects. It must be called before the OpenGL context is destroyed.
+        void clear();
+
+    private:
+        // a scope whose results have not been collected yet
+        struct PendingScope {
+            std::string name;
+            int depth;
+            double cpu_begin;
+            double cpu_end;
+            int query_begin;    // index of the timestamp query, -1 for a CPU scope
+            int query_end;
+        };
+
+        // the scopes and the queries of a frame in flight
+        struct Slot {
+            std::size_t frame_index = 0;
+            bool pending = false;
+            double cpu_time = 0.0;
+            std::vector<PendingScope> scopes;
+            int query_begin = -1;  // the timestamp queries of the whole frame
+            int query_end = -1;
+            std::vector<unsigned int> queries;
+            std::size_t num_used_queries = 0;
+        };
+
+        int issue_query(Slot &slot);
+        bool collect(Slot &slot);
+        void write_trace(const Frame &frame);
+
+    private:
+        std::atomic<bool> enabled_;
+        std::atomic<std::thread::id> rendering_thread_;
+        int timer_supported_;  // -1: not checked yet
+
+        static const int num_slots = 2;
+        Slot slots_[num_slots];
+        int current_;
+        bool in_frame_;
+        std::size_t num_frames_;
+        std::size_t num_dropped_frames_;
+        std::vector<std::size_t> stack_;                // the open scopes (of the current slot or between frames)
+        std::vector<PendingScope> outside_scopes_;      // CPU scopes recorded between frames
+
+        StopWatch clock_;
+        Frame last_frame_;
+        std::ofstream trace_;
+    };
+
+}
+
+
+#endif  // EASY3D_RENDERER_FRAME_PROFILER_H
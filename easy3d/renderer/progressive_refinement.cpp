@@ -0,0 +1,174 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#include <easy3d/renderer/progressive_refinement.h>
+
+#include <algorithm>
+#include <fstream>
+
+#include <easy3d/util/setting.h>
+#include <easy3d/util/logging.h>
+
+
+namespace easy3d {
+
+    namespace internal {
+        // the largest power of 2 that is not greater than k (and at least 1)
+        inline std::size_t floor_power_of_two(std::size_t k) {
+            std::size_t p = 1;
+            while (p * 2 <= k)
+                p *= 2;
+            return p;
+        }
+    }
+
+
+    ProgressiveRefinement::ProgressiveRefinement()
+            : enabled_(setting::progressive_refinement_enabled)
+            , frame_budget_(setting::progressive_refinement_frame_budget)
+            , max_decimation_(internal::floor_power_of_two(
+                    static_cast<std::size_t>(std::max(1, setting::progressive_refinement_max_decimation))))
+            , idle_delay_(150.0f)
+            , pressed_(false)
+            , touched_(false)
+            , decimation_(1)
+            , interaction_decimation_(1)
+            , frame_interacting_(false)
+            , last_frame_time_(0.0)
+            , log_enabled_(false)
+    {
+    }
+
+
+    void ProgressiveRefinement::set_enabled(bool b) {
+        enabled_ = b;
+        if (!enabled_) {
+            decimation_ = 1;
+            interaction_decimation_ = 1;
+        }
+    }
+
+
+    void ProgressiveRefinement::set_max_decimation(std::size_t k) {
+        max_decimation_ = internal::floor_power_of_two(k);
+        decimation_ = std::min(decimation_, max_decimation_);
+        interaction_decimation_ = std::min(interaction_decimation_, max_decimation_);
+    }
+
+
+    void ProgressiveRefinement::begin_interaction() {
+        if (enabled_ && !pressed_)
+            decimation_ = std::max(decimation_, interaction_decimation_);
+        pressed_ = true;
+    }
+
+
+    void ProgressiveRefinement::end_interaction() {
+        pressed_ = false;
+    }
+
+
+    void ProgressiveRefinement::touch() {
+        if (enabled_ && !is_interacting())
+            decimation_ = std::max(decimation_, interaction_decimation_);
+        touched_ = true;
+        touch_watch_.restart();
+    }
+
+
+    bool ProgressiveRefinement::is_interacting() const {
+        return pressed_ || (touched_ && touch_watch_.elapsed_seconds(6) * 1000.0 < idle_delay_);
+    }
+
+
+    bool ProgressiveRefinement::needs_refinement() const {
+        // - the decimated frames have to be refined;
+        // - the end of a discrete interaction has to be noticed;
+        // - the last frame skipped the expensive passes.
+        return enabled_ && !pressed_ && (decimation_ > 1 || touched_ || frame_interacting_);
+    }
+
+
+    std::size_t ProgressiveRefinement::begin_frame() {
+        frame_watch_.restart();
+        if (touched_ && !is_interacting())
+            touched_ = false;
+        frame_interacting_ = is_interacting();
+        if (!enabled_)
+            decimation_ = 1;
+        return decimation_;
+    }
+
+
+    void ProgressiveRefinement::end_frame() {
+        end_frame(frame_watch_.elapsed_seconds(6) * 1000.0);
+    }
+
+
+    void ProgressiveRefinement::end_frame(double frame_time) {
+        last_frame_time_ = frame_time;
+        if (log_enabled_)
+            log_.push_back({clock_.elapsed_seconds(6) * 1000.0, frame_time, decimation_, frame_interacting_});
+
+        if (!enabled_)
+            return;
+
+        if (frame_interacting_) {
+            if (frame_time > frame_budget_ && decimation_ < max_decimation_)
+                decimation_ *= 2;
+            else if (frame_time < frame_budget_ * 0.5 && decimation_ > 1)
+                decimation_ /= 2;
+            interaction_decimation_ = decimation_;
+        } else if (decimation_ > 1) {
+            // The frame time is roughly proportional to the number of the drawn primitives, i.e., inversely
+            // proportional to the decimation. Refine at least by a factor of 2 and further as long as the predicted
+            // frame time fits the budget.
+            std::size_t k = decimation_ / 2;
+            while (k > 1 && frame_time * static_cast<double>(decimation_) / static_cast<double>(k / 2) <= frame_budget_)
+                k /= 2;
+            decimation_ = k;
+        } else if (frame_time <= frame_budget_)
+            interaction_decimation_ = 1;    // the full detail fits the budget
+    }
+
+
+    bool ProgressiveRefinement::save_frame_log(const std::string &file_name) const {
+        std::ofstream output(file_name.c_str());
+        if (output.fail()) {
+            LOG(ERROR) << "could not open file: " << file_name;
+            return false;
+        }
+
+        output << "frame,timestamp_ms,frame_time_ms,decimation,interacting" << std::endl;
+        for (std::size_t i = 0; i < log_.size(); ++i) {
+            const FrameRecord &r = log_[i];
+            output << i << "," << r.timestamp << "," << r.frame_time << "," << r.decimation << ","
+                   << (r.interacting ? 1 : 0) << "\n";
+        }
+        return !output.fail();
+    }
+
+}
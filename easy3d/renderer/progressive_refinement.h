@@ -0,0 +1,241 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#ifndef EASY3D_RENDERER_PROGRESSIVE_REFINEMENT_H
+#define EASY3D_RENDERER_PROGRESSIVE_REFINEMENT_H
+
+#include <string>
+#include <vector>
+
+#include <easy3d/util/stop_watch.h>
+
+
+namespace easy3d {
+
+    /**
+     * \brief Progressive refinement rendering during camera interaction.
+     * \class ProgressiveRefinement easy3d/renderer/progressive_refinement.h
+     * \details While the camera moves, a decimated subset of the scene is rendered (see Drawable::set_decimation())
+     *      and the expensive passes (e.g., SSAO, shadows, transparency, and EDL) are skipped, so that the frame time
+     *      stays within a budget. The decimation adapts to the measured frame time: it is doubled when a frame
+     *      exceeds the budget and halved when a frame takes less than half of the budget. Once the camera stops,
+     *      the decimation is reduced over the following idle frames (as much as the budget allows per frame) until
+     *      the full detail is restored, and then the expensive passes are enabled again.
+     *
+     *      The frame times can be logged to analyze the interaction performance (see save_frame_log()).
+     *
+     *      Example usage:
+     *          \code
+     *              // in the event handlers
+     *              refinement.begin_interaction();     // e.g., mouse dragged
+     *              refinement.end_interaction();       // e.g., mouse released
+     *              refinement.touch();                 // e.g., mouse wheel (no explicit end)
+     *
+     *              // in the rendering loop
+     *              const std::size_t k = refinement.begin_frame();
+     *              for (auto d : drawables)
+     *                  d->set_decimation(k);
+     *              if (refinement.effects_allowed())
+     *                  ssao->generate(...);
+     *              draw();
+     *              swap_buffers();
+     *              refinement.end_frame();
+     *              if (refinement.needs_refinement())
+     *                  update();   // request another frame
+     *          \endcode
+     */
+    class ProgressiveRefinement {
+    public:
+        /**
+         * \brief A record of the frame-time log.
+         */
+        struct FrameRecord {
+            double timestamp;       ///< The end of the frame (in milliseconds since the construction).
+            double frame_time;      ///< The frame time (in milliseconds).
+            std::size_t decimation; ///< The decimation used by the frame.
+            bool interacting;       ///< Whether the camera was interacted with during the frame.
+        };
+
+    public:
+        /**
+         * \brief Constructor. The parameters are initialized from setting::progressive_refinement_enabled (disabled
+         *      by default), setting::progressive_refinement_frame_budget, and
+         *      setting::progressive_refinement_max_decimation.
+         */
+        ProgressiveRefinement();
+
+        /**
+         * \brief Enables/Disables progressive refinement. If disabled, the frames are always rendered with full
+         *      detail and all passes.
+         */
+        void set_enabled(bool b);
+        /**
+         * \brief Returns whether progressive refinement is enabled.
+         */
+        bool is_enabled() const { return enabled_; }
+
+        /**
+         * \brief Sets the frame-time budget (in milliseconds). The default value is 33 (i.e., 30 fps).
+         */
+        void set_frame_budget(float ms) { frame_budget_ = ms; }
+        /**
+         * \brief Returns the frame-time budget (in milliseconds).
+         */
+        float frame_budget() const { return frame_budget_; }
+
+        /**
+         * \brief Sets the maximum decimation. It is rounded down to a power of 2. The default value is 64.
+         */
+        void set_max_decimation(std::size_t k);
+        /**
+         * \brief Returns the maximum decimation.
+         */
+        std::size_t max_decimation() const { return max_decimation_; }
+
+        /**
+         * \brief Sets the time (in milliseconds) after a touch() during which the camera is still considered in
+         *      motion. The default value is 150.
+         */
+        void set_idle_delay(float ms) { idle_delay_ = ms; }
+        /**
+         * \brief Returns the time (in milliseconds) after a touch() during which the camera is still considered in
+         *      motion.
+         */
+        float idle_delay() const { return idle_delay_; }
+
+        /// \name Interaction
+        //@{
+        /**
+         * \brief Notifies the start of a continuous interaction, e.g., when the mouse is dragged. Calling it again
+         *      before end_interaction() has no effect.
+         * \details The decimation that was sufficient for the previous interaction is used immediately, so the
+         *      first frames of the interaction are not slow.
+         */
+        void begin_interaction();
+        /**
+         * \brief Notifies the end of a continuous interaction, e.g., when a mouse button is released.
+         */
+        void end_interaction();
+        /**
+         * \brief Notifies a discrete interaction without an explicit end, e.g., a mouse wheel event. The camera is
+         *      considered in motion until idle_delay() milliseconds later.
+         */
+        void touch();
+        /**
+         * \brief Returns whether the camera is being interacted with.
+         */
+        bool is_interacting() const;
+        //@}
+
+        /// \name Frames
+        //@{
+        /**
+         * \brief Starts a frame.
+         * \return The decimation to be used by all drawables in this frame (1 means full detail).
+         */
+        std::size_t begin_frame();
+        /**
+         * \brief Ends a frame and adapts the decimation to the time elapsed since begin_frame(). To include the
+         *      GPU work, call it after swapping the buffers.
+         */
+        void end_frame();
+        /**
+         * \brief Ends a frame and adapts the decimation to the given frame time, e.g., measured by an OpenGLTimer.
+         * \param frame_time The frame time (in milliseconds).
+         */
+        void end_frame(double frame_time);
+
+        /**
+         * \brief Returns the current decimation (1 means full detail).
+         */
+        std::size_t decimation() const { return decimation_; }
+        /**
+         * \brief Returns whether the expensive passes (e.g., SSAO, shadows, transparency, and EDL) should be
+         *      rendered, i.e., the camera is idle and the frame has full detail.
+         */
+        bool effects_allowed() const { return !enabled_ || (decimation_ == 1 && !is_interacting()); }
+        /**
+         * \brief Returns whether more frames are needed to restore the full detail, i.e., the caller should
+         *      request another frame (even if no event occurs).
+         */
+        bool needs_refinement() const;
+        /**
+         * \brief Returns the time of the last frame (in milliseconds).
+         */
+        double last_frame_time() const { return last_frame_time_; }
+        //@}
+
+        /// \name Frame-time log
+        //@{
+        /**
+         * \brief Enables/Disables the frame-time log. It is disabled by default.
+         */
+        void set_frame_log_enabled(bool b) { log_enabled_ = b; }
+        /**
+         * \brief Returns whether the frame-time log is enabled.
+         */
+        bool frame_log_enabled() const { return log_enabled_; }
+        /**
+         * \brief Returns the recorded frames.
+         */
+        const std::vector<FrameRecord> &frame_log() const { return log_; }
+        /**
+         * \brief Clears the recorded frames.
+         */
+        void clear_frame_log() { log_.clear(); }
+        /**
+         * \brief Saves the recorded frames into a CSV file with the columns "frame", "timestamp_ms",
+         *      "frame_time_ms", "decimation", and "interacting".
+         * \return \c true on success.
+         */
+        bool save_frame_log(const std::string &file_name) const;
+        //@}
+
+    private:
+        bool enabled_;
+        float frame_budget_;
+        std::size_t max_decimation_;
+        float idle_delay_;
+
+        bool pressed_;              // a continuous interaction is ongoing
+        bool touched_;              // a discrete interaction occurred (see touch_watch_)
+        StopWatch touch_watch_;     // the time since the last discrete interaction
+        StopWatch frame_watch_;     // the time since the start of the frame
+        StopWatch clock_;           // the time since the construction
+
+        std::size_t decimation_;
+        std::size_t interaction_decimation_;    // the decimation reached by the last interaction
+        bool frame_interacting_;                // whether the current frame is rendered during interaction
+        double last_frame_time_;
+
+        bool log_enabled_;
+        std::vector<FrameRecord> log_;
+    };
+
+}
+
+
+#endif  // EASY3D_RENDERER_PROGRESSIVE_REFINEMENT_H
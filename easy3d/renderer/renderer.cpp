@@ -32,6 +32,7 @@
 #include <easy3d/renderer/drawable_points.h>
 #include <easy3d/renderer/drawable_lines.h>
 #include <easy3d/renderer/drawable_triangles.h>
+#include <easy3d/renderer/frame_profiler.h>
 #include <easy3d/util/logging.h>
 #include <easy3d/util/setting.h>
 
@@ -320,6 +321,7 @@ namespace easy3d {
 
 
     void Renderer::update() {
+        FrameProfiler::Scope scope("Renderer::update", false);
         for (auto d : points_drawables_)
             d->update();
         for (auto d : lines_drawables_)
@@ -79,7 +79,10 @@ namespace easy3d {
 			POSITION,	///< Position
 			COLOR,		///< Color
 			NORMAL,		///< Normal
-			TEXCOORD	///< Texture coordinates
+			TEXCOORD,	///< Texture coordinates
+			INSTANCE_TRANSFORM = 4,		///< Per-instance transformation (a mat4 occupying locations 4 to 7)
+			INSTANCE_NORMAL_MATRIX = 8,	///< Per-instance normal matrix (a mat3 occupying locations 8 to 10)
+			INSTANCE_COLOR = 11			///< Per-instance color
 		};
 		/// Attribute: a pair of attribute type and attribute name
 		typedef std::pair<AttribType, std::string> Attribute;
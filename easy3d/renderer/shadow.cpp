@@ -35,6 +35,7 @@
 #include <easy3d/renderer/drawable_lines.h>
 #include <easy3d/renderer/drawable_triangles.h>
 #include <easy3d/renderer/clipping_plane.h>
+#include <easy3d/renderer/frame_profiler.h>
 #include <easy3d/util/setting.h>
 
 // for debugging
@@ -142,6 +143,8 @@ namespace easy3d {
 
     void Shadow::draw(const std::vector<TrianglesDrawable*>& surfaces)
     {
+        FrameProfiler::Scope scope("shadow");
+
         int viewport[4];
         glGetIntegerv(GL_VIEWPORT, viewport);
         const int w = viewport[2];
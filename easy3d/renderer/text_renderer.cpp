@@ -710,6 +710,7 @@ namespace easy3d {
 #include <easy3d/renderer/shader_program.h>
 #include <easy3d/renderer/shader_manager.h>
 #include <easy3d/renderer/vertex_array_object.h>
+#include <easy3d/renderer/frame_profiler.h>
 #include <easy3d/util/logging.h>
 #include <easy3d/util/file_system.h>
 
@@ -817,6 +818,7 @@ namespace easy3d {
     float TextRenderer::draw(const std::string &text, float x, float y, float font_size, int font_id,
                              const vec3 &font_color, bool upper_left) const
     {
+        FrameProfiler::Scope scope("text");
         float end_x = 0.0f;
         if (!stash_) {
             LOG_N_TIMES(3, ERROR) << "couldn't draw() due to the failure in initialization. " << COUNTER;
@@ -936,6 +938,7 @@ namespace easy3d {
 
     Rect TextRenderer::draw(const std::string &text, float x0, float y0, float font_size, Align align,
                           int font_id, const vec3 &font_color, float line_spacing, bool upper_left) const {
+        FrameProfiler::Scope scope("text");
         Rect rect(0.0f, 0.0f, 0.0f, 0.0f);
         if (!stash_) {
             LOG_N_TIMES(3, ERROR) << "couldn't draw() due to the failure in initialization. " << COUNTER;
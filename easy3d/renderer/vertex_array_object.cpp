@@ -98,6 +98,12 @@ namespace easy3d {
 
 
     bool VertexArrayObject::create_array_buffer(GLuint& buffer, GLuint index, const void* data, std::size_t size, std::size_t dim, bool dynamic) {
+        return create_array_buffer(buffer, index, data, size, dim, GL_FLOAT, false, dynamic);
+    }
+
+
+    bool VertexArrayObject::create_array_buffer(GLuint& buffer, GLuint index, const void* data, std::size_t size,
+                                                std::size_t dim, GLenum type, bool normalized, bool dynamic) {
         release_buffer(buffer);
 		bind();
         glGenBuffers(1, &buffer);                       easy3d_debug_log_gl_error
@@ -105,7 +111,7 @@ namespace easy3d {
         glBindBuffer(GL_ARRAY_BUFFER, buffer);			easy3d_debug_log_gl_error
         glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(size), data, dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);		easy3d_debug_log_gl_error
         glEnableVertexAttribArray(index);               easy3d_debug_log_gl_error
-        glVertexAttribPointer(index, int(dim), GL_FLOAT, GL_FALSE, 0, nullptr);		easy3d_debug_log_gl_error
+        glVertexAttribPointer(index, int(dim), type, normalized ? GL_TRUE : GL_FALSE, 0, nullptr);		easy3d_debug_log_gl_error
         if (glGetError() != GL_NO_ERROR) {
             glBindBuffer(GL_ARRAY_BUFFER, 0);           easy3d_debug_log_gl_error
             glDeleteBuffers(1, &buffer);                easy3d_debug_log_gl_error
@@ -118,6 +124,34 @@ namespace easy3d {
     }
 
 
+    bool VertexArrayObject::create_instance_buffer(GLuint& buffer, GLuint index, const void* data, std::size_t size,
+                                                   std::size_t dim, std::size_t columns, bool dynamic) {
+        release_buffer(buffer);
+		bind();
+        glGenBuffers(1, &buffer);                       easy3d_debug_log_gl_error
+        LOG_IF(buffer == 0, ERROR) << "failed creating instance buffer";
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);			easy3d_debug_log_gl_error
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(size), data, dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);		easy3d_debug_log_gl_error
+        const GLsizei stride = static_cast<GLsizei>(columns * dim * sizeof(float));
+        for (std::size_t c = 0; c < columns; ++c) {
+            const GLuint location = static_cast<GLuint>(index + c);
+            const void* offset = reinterpret_cast<const void*>(c * dim * sizeof(float));
+            glEnableVertexAttribArray(location);        easy3d_debug_log_gl_error
+            glVertexAttribPointer(location, int(dim), GL_FLOAT, GL_FALSE, stride, offset);		easy3d_debug_log_gl_error
+            glVertexAttribDivisor(location, 1);         easy3d_debug_log_gl_error
+        }
+        if (glGetError() != GL_NO_ERROR) {
+            glBindBuffer(GL_ARRAY_BUFFER, 0);           easy3d_debug_log_gl_error
+            glDeleteBuffers(1, &buffer);                easy3d_debug_log_gl_error
+            buffer = 0;
+            LOG(ERROR) << "failed creating instance buffer";
+		}
+        glBindBuffer(GL_ARRAY_BUFFER, 0);               easy3d_debug_log_gl_error
+        release();
+        return (glGetError() == GL_NO_ERROR && buffer != 0);
+    }
+
+
     bool VertexArrayObject::create_element_buffer(GLuint &buffer, const void *data, std::size_t size, bool dynamic) {
         release_buffer(buffer);
 		bind();
@@ -96,6 +96,39 @@ namespace easy3d {
 		 * \return True if the buffer was created successfully, false otherwise.
 		 */
         bool create_array_buffer(GLuint& buffer, GLuint index, const void* data, std::size_t size, std::size_t dim, bool dynamic = false);
+		/**
+		 * \brief Creates an OpenGL array buffer of a non-float component type and uploads data to the buffer.
+		 * \details This is used for compact vertex attributes, e.g., 16-bit quantized positions, octahedral normals
+		 *		packed into two 16-bit integers, and 8-bit colors.
+		 * \param buffer The name of the buffer object.
+		 * \param index  The index of the generic vertex attribute to be enabled.
+		 * \param data   The pointer to the data.
+		 * \param size   The size of the data in bytes.
+		 * \param dim    The number of components per generic vertex attribute. Must be 1, 2, 3, or 4.
+		 * \param type   The data type of each component, e.g., GL_FLOAT, GL_SHORT, GL_UNSIGNED_SHORT, GL_UNSIGNED_BYTE.
+		 * \param normalized Whether the fixed-point values are normalized to [-1, 1] (signed) or [0, 1] (unsigned)
+		 *		when they are accessed. If false, they are converted to floats directly.
+		 * \param dynamic The expected usage pattern is GL_STATIC_DRAW or GL_DYNAMIC_DRAW.
+		 * \return True if the buffer was created successfully, false otherwise.
+		 */
+		bool create_array_buffer(GLuint& buffer, GLuint index, const void* data, std::size_t size, std::size_t dim,
+								 GLenum type, bool normalized, bool dynamic = false);
+		/**
+		 * \brief Creates an OpenGL array buffer of per-instance attributes and uploads data to the buffer.
+		 * \details The attributes advance once per instance (i.e., the attribute divisor is 1) in instanced draw
+		 *		calls. A matrix attribute occupies consecutive locations, one for each of its columns, e.g., a mat4 is
+		 *		specified by \p dim = 4 and \p columns = 4 and it occupies the locations \p index to \p index + 3.
+		 * \param buffer The name of the buffer object.
+		 * \param index  The index of the (first) generic vertex attribute to be enabled.
+		 * \param data   The pointer to the (float) data.
+		 * \param size   The size of the data in bytes.
+		 * \param dim    The number of components per column. Must be 1, 2, 3, or 4.
+		 * \param columns The number of columns, e.g., 1 for a vector attribute and 3 for a mat3 attribute.
+		 * \param dynamic The expected usage pattern is GL_STATIC_DRAW or GL_DYNAMIC_DRAW.
+		 * \return True if the buffer was created successfully, false otherwise.
+		 */
+		bool create_instance_buffer(GLuint& buffer, GLuint index, const void* data, std::size_t size, std::size_t dim,
+									std::size_t columns = 1, bool dynamic = false);
 		/**
 		 * \brief Creates an OpenGL element buffer and uploads data to the buffer.
 		 * \param buffer The name of the buffer object.
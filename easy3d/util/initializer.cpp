@@ -32,11 +32,13 @@
 #include <easy3d/util/logging.h>
 #include <easy3d/util/setting.h>
 #include <easy3d/util/resource.h>
+#include <easy3d/util/thread_pool.h>
 
 
 namespace easy3d {
 
-    void initialize(bool info_to_stdout, bool use_log_file, bool use_setting_file, const std::string& resource_dir) {
+    void initialize(bool info_to_stdout, bool use_log_file, bool use_setting_file, const std::string& resource_dir,
+                    unsigned int num_threads) {
         // initialize random number generator
         std::srand(std::time(0)); // Use the current time as the seed
 
@@ -46,6 +48,8 @@ namespace easy3d {
         setting::initialize(use_setting_file ? "default" : "");
         // initialize the resource directory
         resource::initialize(resource_dir);
+        // initialize the shared thread pool
+        ThreadPool::initialize(num_threads);
     }
 
 } // namespace easy3d
@@ -34,8 +34,9 @@ namespace easy3d {
 
     /**
      * @brief Initialization of Easy3D.
-     * @details This function initializes logging, setting, and resources. Internally it calls (and is thus identical
-     *    to calling) logging::initialize(), setting::initialize(), and resource::initialize().
+     * @details This function initializes logging, setting, resources, and the thread pool. Internally it calls (and is
+     *    thus identical to calling) logging::initialize(), setting::initialize(), resource::initialize(), and
+     *    ThreadPool::initialize().
      *    For more fine-grained initializations, please refer to the documentation of these functions.
      * @param info_to_stdout \c true to log messages at a the \c INFO level to standard output.
      *    \c WARNING and \c ERROR (including \c FATAL) levels are always logged to standard output.
@@ -46,14 +47,19 @@ namespace easy3d {
      * @param resource_dir The resource directory containing color maps, shaders, textures, fonts, etc.
      *    \c Easy3D_RESOURCE_DIR is the default value, which is the directory coming with the Easy3D distribution.
      *    In most cases you should use the default resource directory (unless you want to use different resources).
+     * @param num_threads The number of threads of the shared thread pool used by the algorithms and the file I/O. It
+     *    also caps the threads of the OpenMP-parallelized Poisson surface reconstruction. \c 0 (the default) means
+     *    using the number of hardware threads. When Easy3D is embedded in a multi-threaded application, a smaller
+     *    value avoids oversubscription.
      *
-     * @sa logging::initialize(), setting::initialize(), and resource::initialize().
+     * @sa logging::initialize(), setting::initialize(), resource::initialize(), and ThreadPool::initialize().
      */
     void initialize(
             bool info_to_stdout = false,
             bool use_log_file = true,
             bool use_setting_file = false,
-            const std::string &resource_dir = Easy3D_RESOURCE_DIR
+            const std::string &resource_dir = Easy3D_RESOURCE_DIR,
+            unsigned int num_threads = 0
     );
 
 
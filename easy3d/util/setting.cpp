@@ -58,6 +58,14 @@ namespace easy3d {
         float effect_shadow_softness = 0.5f;
         float effect_shadow_darkness = 0.6f;
 
+        // drawable
+        int drawable_compact_buffers = 0;
+
+        // progressive refinement
+        bool progressive_refinement_enabled = false;
+        float progressive_refinement_frame_budget = 33.0f;
+        int progressive_refinement_max_decimation = 64;
+
         // points drawable
         bool points_drawable_two_side_lighting = true;
         bool points_drawable_distinct_backside_color = false;
@@ -215,6 +223,14 @@ namespace easy3d {
             ENCODE("effect", effect_shadow_softness)
             ENCODE("effect", effect_shadow_darkness)
 
+            // drawable
+            ENCODE("drawable", drawable_compact_buffers)
+
+            // progressive refinement
+            ENCODE("progressive refinement", progressive_refinement_enabled)
+            ENCODE("progressive refinement", progressive_refinement_frame_budget)
+            ENCODE("progressive refinement", progressive_refinement_max_decimation)
+
             // points drawable
             ENCODE("points drawable", points_drawable_two_side_lighting)
             ENCODE("points drawable", points_drawable_distinct_backside_color)
@@ -331,6 +347,14 @@ namespace easy3d {
             DECODE("effect", effect_shadow_softness)
             DECODE("effect", effect_shadow_darkness)
 
+            // drawable
+            DECODE("drawable", drawable_compact_buffers)
+
+            // progressive refinement
+            DECODE("progressive refinement", progressive_refinement_enabled)
+            DECODE("progressive refinement", progressive_refinement_frame_budget)
+            DECODE("progressive refinement", progressive_refinement_max_decimation)
+
             // points drawable
             DECODE("points drawable", points_drawable_two_side_lighting)
             DECODE("points drawable", points_drawable_distinct_backside_color)
@@ -115,6 +115,24 @@ namespace easy3d {
         /// @details This variable controls the darkness of the shadow effect, which determines how dark the shadows appear.
         extern EASY3D_UTIL_EXPORT float effect_shadow_darkness;
 
+        // Drawable settings
+        /// @brief The compact buffer formats used by new drawables by default.
+        /// @details This variable is a bitwise combination of Drawable::CompactFormat flags (e.g., 15 for all).
+        ///     The default value 0 means full-precision float buffers. See Drawable::set_compact_buffers().
+        extern EASY3D_UTIL_EXPORT int drawable_compact_buffers;
+
+        // Progressive refinement settings
+        /// @brief Whether progressive refinement is enabled for camera interaction. It is disabled by default.
+        /// @details If enabled, a decimated subset of the drawables is rendered while the camera moves and the
+        ///     expensive effects are skipped, and the full detail is restored progressively once the camera stops.
+        ///     Only large drawables (i.e., at least 65536 primitives) are decimated. See ProgressiveRefinement.
+        extern EASY3D_UTIL_EXPORT bool progressive_refinement_enabled;
+        /// @brief The frame-time budget (in milliseconds) of progressive refinement.
+        /// @details The decimation increases while the frames exceed this budget during camera interaction.
+        extern EASY3D_UTIL_EXPORT float progressive_refinement_frame_budget;
+        /// @brief The maximum decimation (i.e., only every k-th point is drawn) of progressive refinement.
+        extern EASY3D_UTIL_EXPORT int progressive_refinement_max_decimation;
+
         // Points drawable settings
         /// @brief Whether two-side lighting is enabled for points drawable.
         /// @details This variable enables or disables two-side lighting for points, which ensures both sides of the points are illuminated.
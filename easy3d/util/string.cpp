@@ -14,6 +14,11 @@
 #include <cstdarg>
 #include <iomanip>
 #include <cmath> // for std::isnan
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <limits>
 #include <codecvt>
 #include <ctime>
 #include <chrono>
@@ -131,6 +136,191 @@ namespace easy3d {
         }
 
         // \cond
+        namespace internal {
+            // Powers of ten in [1e-64, 1e64], each correctly rounded to the nearest double.
+            class Pow10Table {
+            public:
+                Pow10Table() {
+                    char str[8];
+                    for (int i = -64; i <= 64; ++i) {
+                        std::snprintf(str, sizeof(str), "1e%d", i);
+                        values_[i + 64] = std::strtod(str, nullptr);
+                    }
+                }
+                double operator()(int e) const { return values_[e + 64]; }
+            private:
+                double values_[129];
+            };
+
+            const Pow10Table &pow10() {
+                static const Pow10Table table;
+                return table;
+            }
+
+            std::size_t write_digits(char *buffer, uint32_t value) {
+                char tmp[10];
+                std::size_t n = 0;
+                do {
+                    tmp[n++] = static_cast<char>('0' + value % 10);
+                    value /= 10;
+                } while (value);
+                for (std::size_t i = 0; i < n; ++i)
+                    buffer[i] = tmp[n - 1 - i];
+                return n;
+            }
+        }
+
+        std::size_t to_chars(char *buffer, float value) {
+            char *p = buffer;
+            if (std::isnan(value)) {
+                std::memcpy(p, "nan", 3);
+                return 3;
+            }
+            if (std::signbit(value)) {
+                *p++ = '-';
+                value = -value;
+            }
+            if (std::isinf(value)) {
+                std::memcpy(p, "inf", 3);
+                return static_cast<std::size_t>(p - buffer) + 3;
+            }
+            if (value == 0.0f) {
+                *p++ = '0';
+                return static_cast<std::size_t>(p - buffer);
+            }
+
+            // The decimals in the open interval (lo, hi) read back to the same float. The midpoints between the
+            // float and its neighbors are exact in double.
+            uint32_t bits = 0;
+            std::memcpy(&bits, &value, sizeof(float));
+            const uint32_t prev_bits = bits - 1, next_bits = bits + 1;
+            float prev_value = 0.0f, next_value = 0.0f;
+            std::memcpy(&prev_value, &prev_bits, sizeof(float));
+            std::memcpy(&next_value, &next_bits, sizeof(float));
+            const double d = value, prev = prev_value, next = next_value;
+            const double lo = (d + prev) * 0.5;
+            const double hi = std::isinf(next_value) ? d + (d - prev) * 0.5 : (d + next) * 0.5;
+
+            // Scale the value (and the interval) to have 9 integral digits. Then the candidates with k significant
+            // digits are the multiples of 10^(9-k), and we look for the coarsest one inside the interval. The scaled
+            // values have a small rounding error (far below one unit), so a candidate must be inside the interval
+            // by a safe margin, except for 9 digits, which always round-trip. Integral candidates of large values
+            // are exact, and for them the ties are resolved exactly, i.e., a midpoint reads back to the float with
+            // an even mantissa. The rare candidates within the margin (e.g., a midpoint that reads back to the
+            // float) are parsed back to decide.
+            const bool even = (bits & 1u) == 0;
+
+            const internal::Pow10Table &p10 = internal::pow10();
+            int e2 = static_cast<int>(bits >> 23) - 126;  // the binary exponent, i.e., d in [2^(e2-1), 2^e2)
+            if (e2 == -126)  // subnormal
+                std::frexp(d, &e2);
+            int e10 = static_cast<int>(std::floor((e2 - 1) * 0.30102999566398120));
+            if (p10(e10 + 1) <= d) ++e10;
+            const int s = 8 - e10;
+            const double scale = p10(s);
+            const double scaled = d * scale;
+            const double scaled_lo = lo * scale + 1e-5;
+            const double scaled_hi = hi * scale - 1e-5;
+            const bool exact = s <= 0 && s >= -22;
+
+            // Returns the multiple of 10^j inside the interval that is the nearest to the value (or -1 if none).
+            static const double powers[9] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8};
+            static const double inv_powers[9] = {1e0, 1e-1, 1e-2, 1e-3, 1e-4, 1e-5, 1e-6, 1e-7, 1e-8};
+            auto inside = [&](double c) -> bool {
+                if (exact) {
+                    const double v = c * p10(-s);
+                    if (v < 9007199254740992.0)
+                        return even ? (v >= lo && v <= hi) : (v > lo && v < hi);
+                }
+                if (c > scaled_lo && c < scaled_hi)
+                    return true;
+                if (c < scaled_lo - 2e-5 || c > scaled_hi + 2e-5)
+                    return false;
+                char str[40];
+                std::snprintf(str, sizeof(str), "%.0fe%d", c, -s);
+                return std::strtof(str, nullptr) == value;
+            };
+            auto candidate = [&](int j) -> double {
+                const double down = static_cast<double>(static_cast<int64_t>(scaled * inv_powers[j])) * powers[j];
+                const double up = down + powers[j];
+                const double first = scaled - down < up - scaled ? down : up;  // try the nearer one first
+                const double second = first == down ? up : down;
+                if (inside(first)) return first;
+                if (inside(second)) return second;
+                return -1.0;
+            };
+
+            // If a multiple of 10^j is inside the interval, so are the multiples of 10^(j-1). So we go from the
+            // finest level up and stop at the first one without a candidate. Most values need 7 or 8 digits, and
+            // this takes only a few steps.
+            double n = std::floor(scaled + 0.5);  // the 9-digit candidate
+            for (int j = 1; j <= 8; ++j) {
+                const double c = candidate(j);
+                if (c < 0.0)
+                    break;
+                n = c;
+            }
+
+            uint32_t digits = static_cast<uint32_t>(n);
+            int q = -s;  // the value is digits * 10^q
+            while (digits % 10 == 0) {
+                digits /= 10;
+                ++q;
+            }
+
+            char str[10];
+            const int len = static_cast<int>(internal::write_digits(str, digits));
+            const int exp = q + len - 1;  // the decimal exponent in scientific notation
+            if (exp >= -4 && exp <= 8) {
+                if (exp >= len - 1) {  // an integer
+                    std::memcpy(p, str, len);
+                    p += len;
+                    for (int i = 0; i < exp - (len - 1); ++i)
+                        *p++ = '0';
+                } else if (exp >= 0) {
+                    std::memcpy(p, str, exp + 1);
+                    p += exp + 1;
+                    *p++ = '.';
+                    std::memcpy(p, str + exp + 1, len - exp - 1);
+                    p += len - exp - 1;
+                } else {
+                    *p++ = '0';
+                    *p++ = '.';
+                    for (int i = 0; i < -exp - 1; ++i)
+                        *p++ = '0';
+                    std::memcpy(p, str, len);
+                    p += len;
+                }
+            } else {
+                *p++ = str[0];
+                if (len > 1) {
+                    *p++ = '.';
+                    std::memcpy(p, str + 1, len - 1);
+                    p += len - 1;
+                }
+                *p++ = 'e';
+                if (exp < 0)
+                    *p++ = '-';
+                p += internal::write_digits(p, static_cast<uint32_t>(std::abs(exp)));
+            }
+            return static_cast<std::size_t>(p - buffer);
+        }
+
+        std::size_t to_chars(char *buffer, double value) {
+            const int n = std::snprintf(buffer, 32, "%.17g", value);
+            return n > 0 ? static_cast<std::size_t>(n) : 0;
+        }
+
+        std::size_t to_chars(char *buffer, int value) {
+            char *p = buffer;
+            uint32_t v = static_cast<uint32_t>(value);
+            if (value < 0) {
+                *p++ = '-';
+                v = 0u - v;
+            }
+            return static_cast<std::size_t>(p - buffer) + internal::write_digits(p, v);
+        }
+
         void append_v(std::string &dst, const char *format, va_list ap) {
             // First try with a small fixed size buffer.
             static const int kFixedBufferSize = 1024;
@@ -140,6 +140,29 @@ namespace easy3d {
          */
         std::string to_string(int value, int width, char fill = '0');
 
+        /**
+         * \brief Writes the shortest decimal representation of a float \p value into \p buffer.
+         * \details The result has the fewest significant digits (at most 9) that read back to exactly the same
+         *      float, e.g., 0.1f is written as "0.1" instead of "0.100000001". It uses the fixed notation for
+         *      decimal exponents in [-4, 8] and the scientific notation otherwise. It is much faster than printf()
+         *      and the iostreams, and it is locale-independent.
+         * \param buffer The output buffer, which must have room for at least 24 characters. No terminating null
+         *      character is written.
+         * \return The number of characters written.
+         */
+        std::size_t to_chars(char *buffer, float value);
+        /**
+         * \brief Writes a double \p value into \p buffer with 17 significant digits (i.e., it reads back to the
+         *      same double). The buffer must have room for at least 32 characters.
+         * \return The number of characters written.
+         */
+        std::size_t to_chars(char *buffer, double value);
+        /**
+         * \brief Writes an integer \p value into \p buffer. The buffer must have room for at least 12 characters.
+         * \return The number of characters written.
+         */
+        std::size_t to_chars(char *buffer, int value);
+
         /**
          * Return a C++ string and work like printf.
          */
@@ -0,0 +1,252 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#include <easy3d/util/thread_pool.h>
+#include <easy3d/util/progress.h>
+#include <easy3d/util/logging.h>
+
+
+namespace easy3d {
+
+    namespace internal {
+        // the pool and the index of the worker queue owned by the current thread (if it is a worker)
+        thread_local ThreadPool *current_pool = nullptr;
+        thread_local std::size_t current_queue = 0;
+
+        std::mutex shared_pool_mutex;
+        std::unique_ptr<ThreadPool> shared_pool;
+    }
+
+
+    ThreadPool::ThreadPool(unsigned int num_threads) : pending_(0), stop_(false) {
+        if (num_threads == 0)
+            num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+        num_threads_ = num_threads;
+
+        const std::size_t num_workers = std::max(num_threads_, 2u) - 1;
+        for (std::size_t i = 0; i <= num_workers; ++i)
+            queues_.emplace_back(new Queue);
+        for (std::size_t i = 0; i < num_workers; ++i)
+            workers_.emplace_back(&ThreadPool::worker_loop, this, i);
+    }
+
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        condition_.notify_all();
+        for (auto &t : workers_)
+            t.join();
+    }
+
+
+    void ThreadPool::submit(std::function<void()> task) {
+        // a worker pushes to its own queue, and the other threads push to the shared one
+        const std::size_t index = (internal::current_pool == this) ? internal::current_queue : queues_.size() - 1;
+        {
+            std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+            queues_[index]->tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++pending_;
+        }
+        condition_.notify_one();
+    }
+
+
+    bool ThreadPool::pop_task(std::size_t index, std::function<void()> &task) {
+        if (pending_ <= 0)
+            return false;
+
+        const std::size_t num = queues_.size();
+        // the own queue first (LIFO for locality), then the shared queue and the other workers (FIFO, i.e., stealing)
+        for (std::size_t k = 0; k < num; ++k) {
+            Queue &q = *queues_[(index + k) % num];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (q.tasks.empty())
+                continue;
+            if (k == 0) {
+                task = std::move(q.tasks.back());
+                q.tasks.pop_back();
+            } else {
+                task = std::move(q.tasks.front());
+                q.tasks.pop_front();
+            }
+            --pending_;
+            return true;
+        }
+        return false;
+    }
+
+
+    void ThreadPool::execute(std::function<void()> &task) {
+        try {
+            task();
+        }
+        catch (const std::exception &e) {
+            LOG(ERROR) << "uncaught exception in a task: " << e.what();
+        }
+        catch (...) {
+            LOG(ERROR) << "uncaught exception in a task";
+        }
+    }
+
+
+    void ThreadPool::worker_loop(std::size_t index) {
+        internal::current_pool = this;
+        internal::current_queue = index;
+
+        std::function<void()> task;
+        while (true) {
+            if (pop_task(index, task)) {
+                execute(task);
+                task = nullptr;
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this]() { return stop_ || pending_ > 0; });
+            if (stop_)
+                return;
+        }
+    }
+
+
+    ThreadPool *ThreadPool::instance() {
+        std::lock_guard<std::mutex> lock(internal::shared_pool_mutex);
+        if (!internal::shared_pool)
+            internal::shared_pool.reset(new ThreadPool);
+        return internal::shared_pool.get();
+    }
+
+
+    void ThreadPool::initialize(unsigned int num_threads) {
+        if (num_threads == 0)
+            num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+        std::lock_guard<std::mutex> lock(internal::shared_pool_mutex);
+        if (internal::shared_pool) {
+            if (num_threads == internal::shared_pool->num_threads())
+                return;
+            internal::shared_pool.reset();
+        }
+        internal::shared_pool.reset(new ThreadPool(num_threads));
+        LOG(INFO) << "thread pool initialized with " << internal::shared_pool->num_threads() << " threads";
+    }
+
+
+    //_________________________________________________________
+
+
+    TaskGroup::TaskGroup(const ProgressLogger *progress, ThreadPool *pool)
+            : pool_(pool ? pool : ThreadPool::instance()), state_(std::make_shared<State>()) {
+        state_->progress = progress;
+        state_->canceled = false;
+        state_->unfinished = 0;
+    }
+
+
+    TaskGroup::~TaskGroup() {
+        try {
+            wait();
+        }
+        catch (...) {
+        }
+    }
+
+
+    bool TaskGroup::State::is_canceled() const {
+        return canceled || (progress && progress->is_canceled());
+    }
+
+
+    bool TaskGroup::is_canceled() const {
+        return state_->is_canceled();
+    }
+
+
+    bool TaskGroup::State::run_next() {
+        std::function<void()> task;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (tasks.empty())
+                return false;
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+
+        if (!is_canceled()) {
+            try {
+                task();
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!exception)
+                    exception = std::current_exception();
+                canceled = true;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--unfinished == 0)
+            condition.notify_all();
+        return true;
+    }
+
+
+    void TaskGroup::run(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            state_->tasks.push_back(std::move(task));
+            ++state_->unfinished;
+        }
+        // the pool task may find the queue empty if the waiting thread has taken the task
+        std::shared_ptr<State> state = state_;
+        pool_->submit([state]() { state->run_next(); });
+    }
+
+
+    void TaskGroup::wait() {
+        State &state = *state_;
+        while (state.unfinished > 0) {
+            // help executing the pending tasks of this group instead of blocking
+            if (state.run_next())
+                continue;
+            std::unique_lock<std::mutex> lock(state.mutex);
+            state.condition.wait(lock, [&state]() { return state.unfinished == 0; });
+        }
+
+        std::exception_ptr e;
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            std::swap(e, state.exception);
+        }
+        if (e)
+            std::rethrow_exception(e);
+    }
+
+} // namespace easy3d
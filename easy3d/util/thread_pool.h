@@ -0,0 +1,299 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#ifndef EASY3D_UTIL_THREAD_POOL_H
+#define EASY3D_UTIL_THREAD_POOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+#include <algorithm>
+#include <memory>
+
+
+namespace easy3d {
+
+    class ProgressLogger;
+
+    /**
+     * \brief A work-stealing thread pool shared by the whole library.
+     * \class ThreadPool easy3d/util/thread_pool.h
+     * \details Each worker thread owns a task queue. A worker takes the most recently submitted task from its own
+     *      queue, and when its queue is empty, it steals the oldest task from the queue of another worker. Tasks
+     *      submitted by threads outside the pool go to a shared queue. Threads waiting for a group of tasks (see
+     *      TaskGroup::wait()) execute the pending tasks of that group instead of blocking, so nested parallelism
+     *      does not deadlock and does not create extra threads.
+     *
+     *      The library uses a single shared pool (see instance()) for compute tasks. The number of threads can be
+     *      specified by initialize() or easy3d::initialize(). Use parallel_for() and parallel_reduce() for data
+     *      parallelism and TaskGroup for task parallelism.
+     */
+    class ThreadPool {
+    public:
+        /**
+         * \brief Constructor.
+         * \param num_threads The number of threads that execute the tasks, including the thread that waits for the
+         *      tasks. So num_threads - 1 worker threads are created (at least one). A value 0 means using the
+         *      number of hardware threads.
+         */
+        explicit ThreadPool(unsigned int num_threads = 0);
+        /**
+         * \brief Destructor. It waits for the running tasks and discards the pending ones.
+         */
+        ~ThreadPool();
+
+        /**
+         * \brief Returns the number of threads that execute the tasks (including the waiting thread).
+         */
+        unsigned int num_threads() const { return num_threads_; }
+
+        /**
+         * \brief Submits a task to the pool.
+         * \details The task is executed asynchronously by a worker thread. Exceptions escaping from the task are
+         *      logged and ignored. Use TaskGroup to wait for tasks and to get their exceptions.
+         */
+        void submit(std::function<void()> task);
+
+        /**
+         * \brief Returns the shared pool. It is created on first use.
+         */
+        static ThreadPool *instance();
+
+        /**
+         * \brief Re-creates the shared pool with the specified number of threads.
+         * \param num_threads The number of threads (see ThreadPool()). 0 means using the number of hardware threads.
+         * \attention This function should be called at startup (e.g., by easy3d::initialize()), i.e., it must not
+         *      be called when tasks are running in the shared pool.
+         */
+        static void initialize(unsigned int num_threads = 0);
+
+    private:
+        struct Queue {
+            std::mutex mutex;
+            std::deque<std::function<void()> > tasks;
+        };
+
+        void worker_loop(std::size_t index);
+        bool pop_task(std::size_t index, std::function<void()> &task);
+        static void execute(std::function<void()> &task);
+
+    private:
+        unsigned int num_threads_;
+        // one queue for each worker, and the last one is shared by the threads outside the pool
+        std::vector<std::unique_ptr<Queue> > queues_;
+        std::vector<std::thread> workers_;
+
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        std::atomic<int> pending_;
+        bool stop_;
+    };
+
+
+    /**
+     * \brief A group of tasks that can be waited for and canceled together.
+     * \class TaskGroup easy3d/util/thread_pool.h
+     * \details Example usage:
+     *      \code
+     *          TaskGroup group(&progress);
+     *          for (auto& part : parts)
+     *              group.run([&]() { process(part); });
+     *          group.wait();
+     *      \endcode
+     *      A canceled group does not start its pending tasks, and the running tasks can check is_canceled() to
+     *      stop early. The group is also canceled if the associated ProgressLogger is canceled (e.g., by the user).
+     */
+    class TaskGroup {
+    public:
+        /**
+         * \brief Constructor.
+         * \param progress An optional progress logger. The group is considered canceled once the progress is
+         *      canceled.
+         * \param pool The pool to run the tasks. Default is the shared pool.
+         */
+        explicit TaskGroup(const ProgressLogger *progress = nullptr, ThreadPool *pool = nullptr);
+        /**
+         * \brief Destructor. It waits for all the tasks (exceptions are not rethrown).
+         */
+        ~TaskGroup();
+
+        /**
+         * \brief Runs a task asynchronously. The task is skipped if the group has been canceled when the task
+         *      starts.
+         */
+        void run(std::function<void()> task);
+
+        /**
+         * \brief Waits for all the tasks of this group. The calling thread executes the pending tasks of this group
+         *      (but not those of other groups or the pool) while waiting.
+         * \details If a task threw an exception, the group is canceled and the first exception is rethrown here.
+         */
+        void wait();
+
+        /**
+         * \brief Cancels the group, i.e., the tasks that have not started will be skipped.
+         */
+        void cancel() { state_->canceled = true; }
+
+        /**
+         * \brief Returns whether the group (or the associated progress) has been canceled.
+         */
+        bool is_canceled() const;
+
+    private:
+        // The tasks of the group are queued here, and each task submitted to the pool runs the next one of them.
+        // The state is shared with these pool tasks, which may outlive the group (when the waiting thread has
+        // already run the corresponding task).
+        struct State {
+            const ProgressLogger *progress;
+            std::atomic<bool> canceled;
+            std::atomic<int> unfinished;
+
+            std::mutex mutex;
+            std::condition_variable condition;
+            std::deque<std::function<void()> > tasks;
+            std::exception_ptr exception;
+
+            bool is_canceled() const;
+            // runs the next task of the group, if any
+            bool run_next();
+        };
+
+    private:
+        ThreadPool *pool_;
+        std::shared_ptr<State> state_;
+
+        //copying disabled
+        TaskGroup(const TaskGroup &);
+        TaskGroup &operator=(const TaskGroup &);
+    };
+
+
+    namespace internal {
+        // The default grain size that results in a few chunks per thread for load balancing.
+        inline std::size_t default_grain(std::size_t n, unsigned int num_threads) {
+            return std::max<std::size_t>(1, n / (8 * std::max(num_threads, 1u)));
+        }
+    }
+
+
+    /**
+     * \brief Executes \p func(i) for each index i in the range [\p begin, \p end) in parallel using the shared pool.
+     * \details The range is split into chunks of \p grain consecutive indices, and each chunk is a task. The loop
+     *      runs in the calling thread if the range is not larger than the grain or if the pool has a single thread.
+     * \param begin The first index.
+     * \param end The index past the last one.
+     * \param func The function to be applied, i.e., void func(Index i).
+     * \param grain The number of indices in each chunk. A value 0 chooses a grain resulting in a few chunks per
+     *      thread. Use a larger grain if the work per index is small.
+     * \param progress An optional progress logger. Once it is canceled, the remaining chunks are skipped.
+     */
+    template<typename Index, typename Function>
+    void parallel_for(Index begin, Index end, const Function &func, std::size_t grain = 0,
+                      const ProgressLogger *progress = nullptr) {
+        if (end <= begin)
+            return;
+        const std::size_t n = static_cast<std::size_t>(end - begin);
+        ThreadPool *pool = ThreadPool::instance();
+        if (grain == 0)
+            grain = internal::default_grain(n, pool->num_threads());
+        if (n <= grain || pool->num_threads() <= 1) {
+            for (Index i = begin; i < end; ++i)
+                func(i);
+            return;
+        }
+
+        TaskGroup group(progress, pool);
+        for (std::size_t first = 0; first < n; first += grain) {
+            const Index b = static_cast<Index>(begin + first);
+            const Index e = static_cast<Index>(begin + std::min(first + grain, n));
+            group.run([&func, b, e]() {
+                for (Index i = b; i < e; ++i)
+                    func(i);
+            });
+        }
+        group.wait();
+    }
+
+
+    /**
+     * \brief Computes a reduction over the range [\p begin, \p end) in parallel using the shared pool.
+     * \details The range is split into chunks of \p grain consecutive indices. Each chunk is mapped to a partial
+     *      result by \p map, and the partial results are combined by \p reduce in the order of the chunks. So the
+     *      result is deterministic for a given grain (even for floating-point sums), independent of the number of
+     *      threads and the scheduling.
+     * \param begin The first index.
+     * \param end The index past the last one.
+     * \param identity The identity of the reduction, which is returned for an empty range.
+     * \param map The function computing the partial result of a chunk, i.e., Value map(Index first, Index last),
+     *      where last is past the end of the chunk.
+     * \param reduce The function combining two partial results, i.e., Value reduce(const Value&, const Value&).
+     * \param grain The number of indices in each chunk. A value 0 chooses a grain resulting in a few chunks per
+     *      thread.
+     * \return The result of the reduction.
+     */
+    template<typename Index, typename Value, typename Map, typename Reduce>
+    Value parallel_reduce(Index begin, Index end, const Value &identity, const Map &map, const Reduce &reduce,
+                          std::size_t grain = 0) {
+        if (end <= begin)
+            return identity;
+        const std::size_t n = static_cast<std::size_t>(end - begin);
+        ThreadPool *pool = ThreadPool::instance();
+        if (grain == 0)
+            grain = internal::default_grain(n, pool->num_threads());
+
+        const std::size_t num_chunks = (n + grain - 1) / grain;
+        std::deque<Value> partial(num_chunks, identity);  // not std::vector, which is not thread-safe for bool
+        auto map_chunk = [&](std::size_t c) {
+            const Index b = static_cast<Index>(begin + c * grain);
+            const Index e = static_cast<Index>(begin + std::min((c + 1) * grain, n));
+            partial[c] = map(b, e);
+        };
+        if (num_chunks == 1 || pool->num_threads() <= 1) {
+            for (std::size_t c = 0; c < num_chunks; ++c)
+                map_chunk(c);
+        } else {
+            TaskGroup group(nullptr, pool);
+            for (std::size_t c = 0; c < num_chunks; ++c)
+                group.run([&map_chunk, c]() { map_chunk(c); });
+            group.wait();
+        }
+
+        Value result = identity;
+        for (const auto &v : partial)
+            result = reduce(result, v);
+        return result;
+    }
+
+} // namespace easy3d
+
+
+#endif  // EASY3D_UTIL_THREAD_POOL_H
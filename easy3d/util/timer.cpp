@@ -0,0 +1,203 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#include <easy3d/util/timer.h>
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <algorithm>
+
+#include <easy3d/util/logging.h>
+
+
+namespace easy3d {
+
+    namespace internal {
+
+        /// A hashed timer wheel driven by a single thread. Each slot of the wheel holds the tasks expiring at the
+        /// ticks congruent to its index, and a task farther than a full turn waits for the corresponding number of
+        /// rounds. The thread only runs when there are scheduled tasks.
+        /// The expired tasks are executed by the runner threads of the wheel (not by the ThreadPool), so timer
+        /// functions that block (e.g., animations) never delay compute tasks and are never executed by a thread
+        /// waiting for compute tasks. Idle runners are reused, and a runner is added only if all are busy.
+        class TimerWheel {
+        public:
+            static TimerWheel &instance() {
+                static TimerWheel wheel;
+                return wheel;
+            }
+
+            void add(int delay, int interval, const std::function<bool()> &task) {
+                if (destroyed_)  // at exit
+                    return;
+                const std::size_t ticks = static_cast<std::size_t>(std::max(delay, 1));
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (count_ == 0)  // the wheel was idle, so the next tick starts from now
+                    next_tick_ = Clock::now() + Tick(1);
+                const Entry entry = {(ticks - 1) / num_slots, interval, task};
+                slots_[(current_ + ticks) % num_slots].push_back(entry);
+                ++count_;
+                if (!thread_.joinable())
+                    thread_ = std::thread(&TimerWheel::run, this);
+                condition_.notify_one();
+            }
+
+        private:
+            typedef std::chrono::steady_clock Clock;
+            typedef std::chrono::milliseconds Tick;
+            static const std::size_t num_slots = 512;
+
+            struct Entry {
+                std::size_t rounds;
+                int interval;
+                std::function<bool()> task;
+            };
+
+            TimerWheel() : slots_(num_slots), current_(0), count_(0), stop_(false), idle_runners_(0) {}
+
+            ~TimerWheel() {
+                destroyed_ = true;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    stop_ = true;
+                }
+                condition_.notify_one();
+                runner_condition_.notify_all();
+                if (thread_.joinable())
+                    thread_.join();
+                for (auto &t : runners_)
+                    t.join();
+            }
+
+            // queues an expired task for the runners (the lock must be held)
+            void dispatch(std::function<void()> task) {
+                ready_.push_back(std::move(task));
+                if (ready_.size() > idle_runners_)
+                    runners_.emplace_back(&TimerWheel::run_tasks, this);
+                else
+                    runner_condition_.notify_one();
+            }
+
+            void run_tasks() {
+                std::unique_lock<std::mutex> lock(mutex_);
+                while (true) {
+                    ++idle_runners_;
+                    runner_condition_.wait(lock, [this]() { return stop_ || !ready_.empty(); });
+                    --idle_runners_;
+                    if (stop_)
+                        return;
+                    std::function<void()> task = std::move(ready_.front());
+                    ready_.pop_front();
+                    lock.unlock();
+                    try {
+                        task();
+                    }
+                    catch (const std::exception &e) {
+                        LOG(ERROR) << "uncaught exception in a timer function: " << e.what();
+                    }
+                    catch (...) {
+                        LOG(ERROR) << "uncaught exception in a timer function";
+                    }
+                    lock.lock();
+                }
+            }
+
+            void run() {
+                std::vector<Entry> expired;
+                std::unique_lock<std::mutex> lock(mutex_);
+                while (!stop_) {
+                    if (count_ == 0) {
+                        condition_.wait(lock, [this]() { return stop_ || count_ > 0; });
+                        continue;
+                    }
+                    if (condition_.wait_until(lock, next_tick_, [this]() { return stop_; }))
+                        break;
+
+                    // advance the wheel (by more than one slot if this thread was late)
+                    const auto now = Clock::now();
+                    while (next_tick_ <= now && count_ > 0) {
+                        current_ = (current_ + 1) % num_slots;
+                        next_tick_ += Tick(1);
+                        auto &slot = slots_[current_];
+                        const std::size_t num_expired = expired.size();
+                        std::size_t kept = 0;
+                        for (auto &e: slot) {
+                            if (e.rounds == 0)
+                                expired.push_back(std::move(e));
+                            else {
+                                --e.rounds;
+                                slot[kept++] = std::move(e);
+                            }
+                        }
+                        slot.resize(kept);
+                        count_ -= expired.size() - num_expired;
+                    }
+                    for (auto &e: expired) {
+                        const int interval = e.interval;
+                        const std::function<bool()> task = std::move(e.task);
+                        dispatch([interval, task]() {
+                            if (task() && interval > 0)
+                                TimerWheel::instance().add(interval, interval, task);
+                        });
+                    }
+                    expired.clear();
+                }
+            }
+
+        private:
+            std::vector<std::vector<Entry> > slots_;
+            std::size_t current_;
+            std::size_t count_;
+            Clock::time_point next_tick_;
+
+            std::mutex mutex_;
+            std::condition_variable condition_;
+            bool stop_;
+            std::thread thread_;
+            static std::atomic<bool> destroyed_;
+
+            // the expired tasks and the threads running them
+            std::deque<std::function<void()> > ready_;
+            std::vector<std::thread> runners_;
+            std::size_t idle_runners_;
+            std::condition_variable runner_condition_;
+        };
+
+        std::atomic<bool> TimerWheel::destroyed_(false);
+
+
+        void schedule_timer_task(int delay, int interval, const std::function<bool()> &task) {
+            TimerWheel::instance().add(delay, interval, task);
+        }
+
+    } // namespace internal
+
+} // namespace easy3d
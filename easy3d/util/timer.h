@@ -27,28 +27,45 @@
 #ifndef EASY3D_UTIL_TIMER_H
 #define EASY3D_UTIL_TIMER_H
 
-#include <thread>
-#include <chrono>
+#include <atomic>
+#include <memory>
 #include <functional>
 
 namespace easy3d {
 
+    namespace internal {
+        /**
+         * \brief Schedules a task on the shared timer wheel.
+         * \details All timers share a single thread that advances a hashed timer wheel in steps of one millisecond.
+         *      Expired tasks are executed by a few runner threads dedicated to the timers (separate from the
+         *      ThreadPool for compute tasks). The runners are reused, so no thread is created per task.
+         * \param delay The time (in milliseconds) after which the task is executed.
+         * \param interval If positive, the task is executed again every \p interval milliseconds (measured from the
+         *      end of the previous execution) as long as it returns \c true.
+         * \param task The task to be executed.
+         */
+        void schedule_timer_task(int delay, int interval, const std::function<bool()> &task);
+    }
+
     /**
      * \brief A light-weight implementation of the timer mechanism.
      * \class Timer easy3d/util/timer.h
      * \details Timer functionalities are usually implemented in large libraries
      *      (e.g., the [QTimer of Qt](http://doc.qt.io/archives/qt-5.5/qtimer.html)).
-     *      This Timer class provides a single-header implementation.
-     *      With Timer, tasks (i.e., calling to functions) can be easily scheduled at either constant intervals
-     *      or after a specified period. Timer supports any types of functions with any number of arguments.
+     *      This Timer class provides a light-weight alternative. With Timer, tasks (i.e., calling to functions) can
+     *      be easily scheduled at either constant intervals or after a specified period. Timer supports any types
+     *      of functions with any number of arguments.
+     *      The timers share a timer wheel, and the functions are executed by threads dedicated to the timers, which
+     *      are reused across calls. A function that blocks for a long time (e.g., an animation loop) occupies one of
+     *      these threads, but it does not delay the other timers or the compute tasks of the ThreadPool.
      */
 
     template<class... Args>
     class Timer {
     public:
-        Timer() : stopped_(false), paused_(false) {}
+        Timer() : state_(std::make_shared<State>()) {}
 
-        ~Timer() { stopped_ = true; }
+        ~Timer() { state_->stopped = true; }
 
         /**
          * \brief Executes function \p func after \p delay milliseconds.
@@ -160,37 +177,43 @@ namespace easy3d {
          *      temporarily pause a timer, call pause().
          * \sa  is_stopped(), pause().
          */
-        void stop() { stopped_ = true; }
+        void stop() { state_->stopped = true; }
 
         /**
          * \brief Returns whether the timer has been stopped. If a timer is stopped, it cannot be restarted again.
          * \sa stop(), is_paused().
          */
-        bool is_stopped() const { return stopped_; }
+        bool is_stopped() const { return state_->stopped; }
 
         /**
          * \brief Pauses the timer. After a timer is paused, it can be resumed by calling resume(). You can
          *      permanently stop the timer by stop().
          * \sa is_paused(), resume(), stop().
          */
-        void pause() { paused_ = true; }
+        void pause() { state_->paused = true; }
 
         /**
          * \brief Returns whether the timer has been paused. After a timer is paused, it can be resumed by
          *      calling resume()
          * \sa pause(), resume(), is_stopped().
          */
-        bool is_paused() const { return paused_; }
+        bool is_paused() const { return state_->paused; }
 
         /**
          * \brief Resumes the timer. This will be effective only when the timer has been paused and not stopped.
          * \sa pause(), is_paused(), stop().
          */
-        void resume() { if (!stopped_ && paused_) paused_ = false; }
+        void resume() { if (!state_->stopped && state_->paused) state_->paused = false; }
 
     private:
-        bool stopped_;
-        bool paused_;
+        // The state is shared with the scheduled tasks, so a task that expires after the timer has been destroyed
+        // finds it stopped (instead of accessing the destroyed timer).
+        struct State {
+            State() : stopped(false), paused(false) {}
+            std::atomic<bool> stopped;
+            std::atomic<bool> paused;
+        };
+        std::shared_ptr<State> state_;
     };
 
 
@@ -200,123 +223,112 @@ namespace easy3d {
 
     template<class... Args>
     void Timer<Args...>::single_shot(int delay, std::function<void(Args...)> const &func, Args... args) {
-        std::thread t([=]() {
-            std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+        internal::schedule_timer_task(delay, 0, [=]() -> bool {
             func(args...);
+            return false;
         });
-        t.detach();
     }
 
 
     template<class... Args>
     template<class Class>
     void Timer<Args...>::single_shot(int delay, Class *inst, void (Class::*func)(Args...), Args... args) {
-        std::thread t([=]() {
-            std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+        internal::schedule_timer_task(delay, 0, [=]() -> bool {
             (inst->*func)(args...);
+            return false;
         });
-        t.detach();
     }
 
 
     template<class... Args>
     template<class Class>
     void Timer<Args...>::single_shot(int delay, Class const *inst, void (Class::*func)(Args...) const, Args... args) {
-        std::thread t([=]() {
-            std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+        internal::schedule_timer_task(delay, 0, [=]() -> bool {
             (inst->*func)(args...);
+            return false;
         });
-        t.detach();
     }
 
 
     template<class... Args>
     void Timer<Args...>::set_timeout(int delay, std::function<void(Args...)> const &func, Args... args) const {
-        const_cast<Timer<Args...>*>(this)->stopped_ = false;
-        std::thread t([=]() {
-            if (stopped_) return;
-            std::this_thread::sleep_for(std::chrono::milliseconds(delay));
-            if (stopped_) return;
-            func(args...);
+        std::shared_ptr<State> state = state_;
+        state->stopped = false;
+        internal::schedule_timer_task(delay, 0, [=]() -> bool {
+            if (!state->stopped)
+                func(args...);
+            return false;
         });
-        t.detach();
     }
 
 
     template<class... Args>
     template<class Class>
     void Timer<Args...>::set_timeout(int delay, Class *inst, void (Class::*func)(Args...), Args... args) const {
-        const_cast<Timer<Args...>*>(this)->stopped_ = false;
-        std::thread t([=]() {
-            if (stopped_) return;
-            std::this_thread::sleep_for(std::chrono::milliseconds(delay));
-            if (stopped_) return;
-            (inst->*func)(args...);
+        std::shared_ptr<State> state = state_;
+        state->stopped = false;
+        internal::schedule_timer_task(delay, 0, [=]() -> bool {
+            if (!state->stopped)
+                (inst->*func)(args...);
+            return false;
         });
-        t.detach();
     }
 
 
     template<class... Args>
     template<class Class>
     void Timer<Args...>::set_timeout(int delay, Class const *inst, void (Class::*func)(Args...) const, Args... args) const {
-        const_cast<Timer<Args...>*>(this)->stopped_ = false;
-        std::thread t([=]() {
-            if (stopped_) return;
-            std::this_thread::sleep_for(std::chrono::milliseconds(delay));
-            if (stopped_) return;
-            (inst->*func)(args...);
+        std::shared_ptr<State> state = state_;
+        state->stopped = false;
+        internal::schedule_timer_task(delay, 0, [=]() -> bool {
+            if (!state->stopped)
+                (inst->*func)(args...);
+            return false;
         });
-        t.detach();
     }
 
 
     template<class... Args>
     void Timer<Args...>::set_interval(int interval, std::function<void(Args...)> const &func, Args... args) const {
-        const_cast<Timer<Args...>*>(this)->stopped_ = false;
-        std::thread t([=]() {
-            while (true) {
-                if (stopped_) return;
-                std::this_thread::sleep_for(std::chrono::milliseconds(interval));
-                if (paused_) continue;
-                else if (stopped_) return;
+        std::shared_ptr<State> state = state_;
+        state->stopped = false;
+        internal::schedule_timer_task(interval, interval, [=]() -> bool {
+            if (state->stopped)
+                return false;
+            if (!state->paused)
                 func(args...);
-            }
+            return !state->stopped;
         });
-        t.detach();
     }
 
 
     template<class... Args>
     template<class Class>
     void Timer<Args...>::set_interval(int interval, Class *inst, void (Class::*func)(Args...), Args... args) const {
-        const_cast<Timer<Args...>*>(this)->stopped_ = false;
-        std::thread t([=]() {
-            while (true) {
-                if (stopped_) return;
-                std::this_thread::sleep_for(std::chrono::milliseconds(interval));
-                if (paused_) continue;
-                else if (stopped_) return;
+        std::shared_ptr<State> state = state_;
+        state->stopped = false;
+        internal::schedule_timer_task(interval, interval, [=]() -> bool {
+            if (state->stopped)
+                return false;
+            if (!state->paused)
                 (inst->*func)(args...);
-            }
+            return !state->stopped;
         });
-        t.detach();
     }
 
+
     template<class... Args>
     template<class Class>
     void Timer<Args...>::set_interval(int interval, Class const *inst, void (Class::*func)(Args...) const, Args... args) const {
-        const_cast<Timer<Args...>*>(this)->stopped_ = false;
-        std::thread t([=]() {
-            while (true) {
-                if (stopped_) return;
-                std::this_thread::sleep_for(std::chrono::milliseconds(interval));
-                if (paused_) continue;
-                else if (stopped_) return;
+        std::shared_ptr<State> state = state_;
+        state->stopped = false;
+        internal::schedule_timer_task(interval, interval, [=]() -> bool {
+            if (state->stopped)
+                return false;
+            if (!state->paused)
                 (inst->*func)(args...);
-            }
+            return !state->stopped;
         });
-        t.detach();
     }
 
 
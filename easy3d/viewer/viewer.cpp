@@ -49,6 +49,8 @@
 #include <easy3d/renderer/camera.h>
 #include <easy3d/renderer/manipulated_camera_frame.h>
 #include <easy3d/renderer/key_frame_interpolator.h>
+#include <easy3d/renderer/frame_profiler.h>
+#include <easy3d/renderer/progressive_refinement.h>
 #include <easy3d/renderer/opengl_util.h>
 #include <easy3d/renderer/opengl_error.h>
 #include <easy3d/renderer/text_renderer.h>
@@ -104,6 +106,7 @@ namespace easy3d {
         , pressed_key_(-1)
         , show_pivot_point_(false)
         , show_frame_rate_(false)
+        , show_profiler_(false)
         , show_camera_path_(false)
         , model_idx_(-1)
     {
@@ -133,6 +136,8 @@ namespace easy3d {
         kfi_ = std::unique_ptr<KeyFrameInterpolator>(new KeyFrameInterpolator(camera_->frame()));
         easy3d::connect(&kfi_->interpolation_stopped, this, &Viewer::update);
 
+        refinement_ = std::unique_ptr<ProgressiveRefinement>(new ProgressiveRefinement);
+
         snprintf(framerate_, sizeof(framerate_), "fps: ?? (?? ms/frame)");
 
         /* Poll for events once before starting a potentially lengthy loading process.*/
@@ -144,6 +149,7 @@ namespace easy3d {
             "--------------------------------------------------------------\n"
             "  F1:                      Show help                          \n"
             "  F2:                      Toggle animation (if available)    \n"
+            "  F3:                      Toggle frame profiler              \n"
             "  Ctrl + 'o':              Open file                          \n"
             "  Ctrl + 's':              Save file                          \n"
             "  Fn + Delete:             Delete current model               \n"
@@ -427,8 +433,10 @@ namespace easy3d {
             int dy = py - mouse_current_y_;
             mouse_current_x_ = px;
             mouse_current_y_ = py;
-            if (drag_active_)
+            if (drag_active_) {
+                refinement_->begin_interaction();
                 return mouse_drag_event(px, py, dx, dy, pressed_button_, modifiers_);
+            }
             else
                 return mouse_free_move_event(px, py, dx, dy, modifiers_);
         }
@@ -450,6 +458,7 @@ namespace easy3d {
                 return mouse_press_event(mouse_current_x_, mouse_current_y_, button, modifiers);
             } else if (action == GLFW_RELEASE) {
                 drag_active_ = false;
+                refinement_->end_interaction();
                 return mouse_release_event(mouse_current_x_, mouse_current_y_, button, modifiers);
             } else {
                 drag_active_ = false;
@@ -506,6 +515,7 @@ namespace easy3d {
 
     bool Viewer::callback_event_scroll(double dx, double dy) {
         try {
+            refinement_->touch();
             return mouse_scroll_event(mouse_current_x_, mouse_current_y_, static_cast<int>(dx), static_cast<int>(dy));
         }
         catch (const std::exception &e) {
@@ -579,6 +589,7 @@ namespace easy3d {
 
         ShaderManager::terminate();
         TextureManager::terminate();
+        FrameProfiler::instance()->clear();
 
         glfwDestroyWindow(window_);
         window_ = nullptr;
@@ -789,6 +800,9 @@ namespace easy3d {
             is_animating_ = !is_animating_;
             if (is_animating_ && !animation_func_)
                 LOG(WARNING) << "animation is enabled but the animation function (i.e., animation_func_) is missing";
+        } else if (key == GLFW_KEY_F3 && modifiers == 0) {
+            show_profiler_ = !show_profiler_;
+            FrameProfiler::instance()->set_enabled(show_profiler_);
         } else if (key == GLFW_KEY_LEFT && modifiers == 0) {
             auto angle = static_cast<float>(1 * M_PI / 180.0); // turn left, 1 degrees each step
             camera_->frame()->action_turn(angle, camera());
@@ -1157,10 +1171,30 @@ namespace easy3d {
                     }
                 }
 
+                // render a decimated subset of the scene while the camera moves
+                const std::size_t decimation = refinement_->begin_frame();
+                for (const auto m : models_) {
+                    for (auto d : m->renderer()->points_drawables())
+                        d->set_decimation(decimation);
+                    for (auto d : m->renderer()->lines_drawables())
+                        d->set_decimation(decimation);
+                    for (auto d : m->renderer()->triangles_drawables())
+                        d->set_decimation(decimation);
+                }
+                for (auto d : drawables_)
+                    d->set_decimation(decimation);
+
+                FrameProfiler::instance()->begin_frame();
                 pre_draw();
                 draw();
                 post_draw();
                 glfwSwapBuffers(window_);
+                FrameProfiler::instance()->end_frame();
+
+                // restore the full detail progressively over the following frames
+                refinement_->end_frame();
+                if (refinement_->needs_refinement())
+                    update();
 
                 // Don't call 'glfwPollEvents()' at the beginning of the main loop.
                 // Reason: first frame needs time to complete.
@@ -1627,6 +1661,17 @@ namespace easy3d {
                 y += font_size * 1.5f * dpi_scaling();
                 texter_->draw(hint_, x, y, font_size, TextRenderer::ALIGN_LEFT, 1, vec3(0, 0, 1));
             }
+
+            // draw the timing of the scopes of the last profiled frame
+            if (show_profiler_) {
+                const float profiler_font_size = 12.0f;
+                for (const auto &line : FrameProfiler::instance()->report()) {
+                    y += profiler_font_size * 1.5f * dpi_scaling();
+                    if (y > static_cast<float>(height()) * dpi_scaling())
+                        break;
+                    texter_->draw(line, x, y, profiler_font_size, 1, vec3(0.8f, 0.2f, 0.0f));
+                }
+            }
         }
 
         // shown only when it is not animating
@@ -46,6 +46,7 @@ namespace easy3d {
     class TrianglesDrawable;
     class TextRenderer;
     class KeyFrameInterpolator;
+    class ProgressiveRefinement;
 
     /**
      * \brief The built-in Easy3D viewer.
@@ -181,6 +182,18 @@ namespace easy3d {
         Camera* camera() { return camera_.get(); }
         /// \brief Returns the camera used by the viewer. See \c Camera.
         const Camera* camera() const { return camera_.get(); }
+
+        /**
+         * \brief Returns the progressive refinement of the viewer. While the camera moves, a decimated subset of the
+         *      scene is rendered to keep the frame time within a budget, and the full detail is restored over the
+         *      following frames. It is disabled by default; enable it with setting::progressive_refinement_enabled
+         *      before creating the viewer and loading the models (the coarse levels of detail of the drawables are
+         *      built when their buffers are uploaded), or with progressive_refinement()->set_enabled(true).
+         *      See \c ProgressiveRefinement.
+         * \note Subclasses rendering expensive passes (e.g., SSAO, shadows, or EDL) should skip them unless
+         *      progressive_refinement()->effects_allowed().
+         */
+        ProgressiveRefinement* progressive_refinement() { return refinement_.get(); }
         //@}
 
         /// \name File IO
@@ -616,6 +629,8 @@ namespace easy3d {
         std::unique_ptr<KeyFrameInterpolator> kfi_;
         bool    is_animating_;
 
+        std::unique_ptr<ProgressiveRefinement> refinement_;
+
         std::string manual_;
 		std::string hint_; // shown in the top-left corner of the screen
 
@@ -643,6 +658,7 @@ namespace easy3d {
 
 		bool    show_pivot_point_;
 		bool    show_frame_rate_;
+		bool    show_profiler_;     // show the timing of the last frame (see FrameProfiler)
 
 		//----------------- viewer data -------------------
 
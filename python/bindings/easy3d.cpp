@@ -66,6 +66,7 @@ void bind_easy3d_algo_point_cloud_normals(pybind11::module_ &m);
 void bind_easy3d_algo_point_cloud_poisson_reconstruction(pybind11::module_ &m);
 void bind_easy3d_algo_point_cloud_ransac(pybind11::module_ &m);
 void bind_easy3d_algo_point_cloud_simplification(pybind11::module_ &m);
+void bind_easy3d_algo_point_transform(pybind11::module_ &m);
 void bind_easy3d_algo_polygon_partition(pybind11::module_ &m);
 void bind_easy3d_algo_surface_mesh_components(pybind11::module_ &m);
 void bind_easy3d_algo_surface_mesh_curvature(pybind11::module_ &m);
@@ -87,6 +88,7 @@ void bind_easy3d_algo_surface_mesh_subdivision(pybind11::module_ &m);
 void bind_easy3d_algo_surface_mesh_tetrahedralization(pybind11::module_ &m);
 void bind_easy3d_algo_surface_mesh_topology(pybind11::module_ &m);
 void bind_easy3d_algo_surface_mesh_triangulation(pybind11::module_ &m);
+void bind_easy3d_algo_surface_mesh_validation(pybind11::module_ &m);
 void bind_easy3d_algo_tessellator(pybind11::module_ &m);
 void bind_easy3d_algo_text_mesher(pybind11::module_ &m);
 void bind_easy3d_algo_triangle_mesh_kdtree(pybind11::module_ &m);
@@ -172,6 +174,7 @@ void bind_algo(pybind11::module_ &m) {
     bind_easy3d_algo_point_cloud_poisson_reconstruction(m);
     bind_easy3d_algo_point_cloud_ransac(m);
     bind_easy3d_algo_point_cloud_simplification(m);
+    bind_easy3d_algo_point_transform(m);
     bind_easy3d_algo_polygon_partition(m);
     bind_easy3d_algo_surface_mesh_components(m);
     bind_easy3d_algo_surface_mesh_curvature(m);
@@ -193,6 +196,7 @@ void bind_algo(pybind11::module_ &m) {
     bind_easy3d_algo_surface_mesh_tetrahedralization(m);
     bind_easy3d_algo_surface_mesh_topology(m);
     bind_easy3d_algo_surface_mesh_triangulation(m);
+    bind_easy3d_algo_surface_mesh_validation(m);
     bind_easy3d_algo_tessellator(m);
     bind_easy3d_algo_text_mesher(m);
     bind_easy3d_algo_triangle_mesh_kdtree(m);
@@ -198,8 +198,6 @@ void bind_easy3d_algo_delaunay(pybind11::module_& m)
 		pybind11::class_<easy3d::Delaunay, std::shared_ptr<easy3d::Delaunay>, PyCallBack_easy3d_Delaunay> cl(m, "Delaunay", "Base class for Delaunay triangulation.\n \n\n\n \n Delaunay2D, Delaunay3D.");
 		cl.def( pybind11::init<unsigned int>(), pybind11::arg("dimension") );
 
-		cl.def( pybind11::init( [](PyCallBack_easy3d_Delaunay const &o){ return new PyCallBack_easy3d_Delaunay(o); } ) );
-		cl.def( pybind11::init( [](easy3d::Delaunay const &o){ return new easy3d::Delaunay(o); } ) );
 		cl.def("dimension", (unsigned int (easy3d::Delaunay::*)() const) &easy3d::Delaunay::dimension, "Returns the dimension.\n\nC++: easy3d::Delaunay::dimension() const --> unsigned int");
 		cl.def("cell_size", (unsigned int (easy3d::Delaunay::*)() const) &easy3d::Delaunay::cell_size, "Returns the size of the cell.\n\nC++: easy3d::Delaunay::cell_size() const --> unsigned int");
 		cl.def("set_vertices", (void (easy3d::Delaunay::*)(unsigned int, const float *)) &easy3d::Delaunay::set_vertices, "Sets the vertices.\n\nC++: easy3d::Delaunay::set_vertices(unsigned int, const float *) --> void", pybind11::arg("nb_vertices"), pybind11::arg("vertices"));
@@ -218,13 +216,10 @@ void bind_easy3d_algo_delaunay(pybind11::module_& m)
 		cl.def("next_around_vertex", (unsigned int (easy3d::Delaunay::*)(unsigned int, unsigned int) const) &easy3d::Delaunay::next_around_vertex, "C++: easy3d::Delaunay::next_around_vertex(unsigned int, unsigned int) const --> unsigned int", pybind11::arg("c"), pybind11::arg("lv"));
 		cl.def("get_neighbors", (void (easy3d::Delaunay::*)(unsigned int, class std::vector<unsigned int> &) const) &easy3d::Delaunay::get_neighbors, "Retrieves the one-ring neighbors of vertex v.\n\nC++: easy3d::Delaunay::get_neighbors(unsigned int, class std::vector<unsigned int> &) const --> void", pybind11::arg("v"), pybind11::arg("neighbors"));
 		cl.def("check_duplicate_vertices", (bool (easy3d::Delaunay::*)()) &easy3d::Delaunay::check_duplicate_vertices, "Checks for duplicate vertices in stored neighbor lists.\n Returns true if there where some duplicate vertices.\n\nC++: easy3d::Delaunay::check_duplicate_vertices() --> bool");
-		cl.def("assign", (class easy3d::Delaunay & (easy3d::Delaunay::*)(const class easy3d::Delaunay &)) &easy3d::Delaunay::operator=, "C++: easy3d::Delaunay::operator=(const class easy3d::Delaunay &) --> class easy3d::Delaunay &", pybind11::return_value_policy::automatic, pybind11::arg(""));
 	}
 	{ // easy3d::Delaunay2 file:easy3d/algo/delaunay_2d.h line:26
 		pybind11::class_<easy3d::Delaunay2, std::shared_ptr<easy3d::Delaunay2>, PyCallBack_easy3d_Delaunay2, easy3d::Delaunay> cl(m, "Delaunay2", "2D Delaunay triangulation, using Jonathan Richard Shewchuk's \"triangle\" implementation.\n \n\n\n \n Delaunay, Delaunay3.");
 		cl.def( pybind11::init( [](){ return new easy3d::Delaunay2(); }, [](){ return new PyCallBack_easy3d_Delaunay2(); } ) );
-		cl.def( pybind11::init( [](PyCallBack_easy3d_Delaunay2 const &o){ return new PyCallBack_easy3d_Delaunay2(o); } ) );
-		cl.def( pybind11::init( [](easy3d::Delaunay2 const &o){ return new easy3d::Delaunay2(o); } ) );
 		cl.def("set_vertices", (void (easy3d::Delaunay2::*)(unsigned int, const float *)) &easy3d::Delaunay2::set_vertices, "Sets the vertices from an array of floating point numbers in which each consecutive number pair\n denotes a 2D point.\n\nC++: easy3d::Delaunay2::set_vertices(unsigned int, const float *) --> void", pybind11::arg("nb_vertices"), pybind11::arg("pts"));
 		cl.def("set_vertices", (void (easy3d::Delaunay2::*)(const class std::vector<class easy3d::Vec<2, float> > &)) &easy3d::Delaunay2::set_vertices, "Sets the vertices from an array of 2D points.\n\nC++: easy3d::Delaunay2::set_vertices(const class std::vector<class easy3d::Vec<2, float> > &) --> void", pybind11::arg("vertices"));
 		cl.def("nearest_vertex", (unsigned int (easy3d::Delaunay2::*)(const float *) const) &easy3d::Delaunay2::nearest_vertex, "C++: easy3d::Delaunay2::nearest_vertex(const float *) const --> unsigned int", pybind11::arg("p"));
@@ -236,13 +231,10 @@ void bind_easy3d_algo_delaunay(pybind11::module_& m)
 		cl.def("nb_triangles", (unsigned int (easy3d::Delaunay2::*)() const) &easy3d::Delaunay2::nb_triangles, "Returns the number of triangles.\n\nC++: easy3d::Delaunay2::nb_triangles() const --> unsigned int");
 		cl.def("tri_vertex", (int (easy3d::Delaunay2::*)(unsigned int, unsigned int) const) &easy3d::Delaunay2::tri_vertex, "Returns the index of the  vertex in the  triangle.\n\nC++: easy3d::Delaunay2::tri_vertex(unsigned int, unsigned int) const --> int", pybind11::arg("t"), pybind11::arg("lv"));
 		cl.def("tri_adjacent", (int (easy3d::Delaunay2::*)(unsigned int, unsigned int) const) &easy3d::Delaunay2::tri_adjacent, "C++: easy3d::Delaunay2::tri_adjacent(unsigned int, unsigned int) const --> int", pybind11::arg("t"), pybind11::arg("le"));
-		cl.def("assign", (class easy3d::Delaunay2 & (easy3d::Delaunay2::*)(const class easy3d::Delaunay2 &)) &easy3d::Delaunay2::operator=, "C++: easy3d::Delaunay2::operator=(const class easy3d::Delaunay2 &) --> class easy3d::Delaunay2 &", pybind11::return_value_policy::automatic, pybind11::arg(""));
 	}
 	{ // easy3d::Delaunay3 file:easy3d/algo/delaunay_3d.h line:31
 		pybind11::class_<easy3d::Delaunay3, std::shared_ptr<easy3d::Delaunay3>, PyCallBack_easy3d_Delaunay3, easy3d::Delaunay> cl(m, "Delaunay3", "3D Delaunay triangulation, using Hang Si's tetgen.\n \n\n\n \n Delaunay, Delaunay2.");
 		cl.def( pybind11::init( [](){ return new easy3d::Delaunay3(); }, [](){ return new PyCallBack_easy3d_Delaunay3(); } ) );
-		cl.def( pybind11::init( [](PyCallBack_easy3d_Delaunay3 const &o){ return new PyCallBack_easy3d_Delaunay3(o); } ) );
-		cl.def( pybind11::init( [](easy3d::Delaunay3 const &o){ return new easy3d::Delaunay3(o); } ) );
 		cl.def("set_vertices", (void (easy3d::Delaunay3::*)(unsigned int, const float *)) &easy3d::Delaunay3::set_vertices, "Sets the vertices from an array of floating point numbers in which each consecutive number triple\n denotes a 3D point.\n\nC++: easy3d::Delaunay3::set_vertices(unsigned int, const float *) --> void", pybind11::arg("nb_vertices"), pybind11::arg("vertices"));
 		cl.def("set_vertices", (void (easy3d::Delaunay3::*)(const class std::vector<class easy3d::Vec<3, float> > &)) &easy3d::Delaunay3::set_vertices, "Sets the vertices from an array of 3D points.\n\nC++: easy3d::Delaunay3::set_vertices(const class std::vector<class easy3d::Vec<3, float> > &) --> void", pybind11::arg("vertices"));
 		cl.def("nb_tets", (unsigned int (easy3d::Delaunay3::*)() const) &easy3d::Delaunay3::nb_tets, "Returns the number of tetrahedra.\n\nC++: easy3d::Delaunay3::nb_tets() const --> unsigned int");
@@ -261,7 +253,6 @@ void bind_easy3d_algo_delaunay(pybind11::module_& m)
 		cl.def("tet_circumcenter", (class easy3d::Vec<3, float> (easy3d::Delaunay3::*)(unsigned int) const) &easy3d::Delaunay3::tet_circumcenter, "C++: easy3d::Delaunay3::tet_circumcenter(unsigned int) const --> class easy3d::Vec<3, float>", pybind11::arg("t"));
 		cl.def("get_voronoi_cell", [](easy3d::Delaunay3 const &o, unsigned int const & a0, class easy3d::VoronoiCell3d & a1) -> void { return o.get_voronoi_cell(a0, a1); }, "", pybind11::arg("v"), pybind11::arg("cell"));
 		cl.def("get_voronoi_cell", (void (easy3d::Delaunay3::*)(unsigned int, class easy3d::VoronoiCell3d &, bool) const) &easy3d::Delaunay3::get_voronoi_cell, "Returns the Voronoi cell associated with vertex v.\n\nC++: easy3d::Delaunay3::get_voronoi_cell(unsigned int, class easy3d::VoronoiCell3d &, bool) const --> void", pybind11::arg("v"), pybind11::arg("cell"), pybind11::arg("geometry"));
-		cl.def("assign", (class easy3d::Delaunay3 & (easy3d::Delaunay3::*)(const class easy3d::Delaunay3 &)) &easy3d::Delaunay3::operator=, "C++: easy3d::Delaunay3::operator=(const class easy3d::Delaunay3 &) --> class easy3d::Delaunay3 &", pybind11::return_value_policy::automatic, pybind11::arg(""));
 	}
 	{ // easy3d::VoronoiCell3d file:easy3d/algo/delaunay_3d.h line:167
 		pybind11::class_<easy3d::VoronoiCell3d, std::shared_ptr<easy3d::VoronoiCell3d>> cl(m, "VoronoiCell3d", "A data structure for 3D Voronoi cells\n \n\n\n \n A 3D Voronoi cell stores the dual facets in a Compressed Row Storage array.\n - Each facet knows the bisector it is on, and the list of vertices/edges.\n    - Each vertex knows the tet it is dual to.\n    - Each edge knows the other bisector it is on (an edge is defined as the\n intersection between the facet bisector and the edge bisector).");
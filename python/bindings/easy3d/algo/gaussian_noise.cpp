@@ -20,6 +20,8 @@ void bind_easy3d_algo_gaussian_noise(pybind11::module_& m)
         cl.def( pybind11::init( [](){ return new easy3d::GaussianNoise(); } ) );
         cl.def_static("apply", (void (*)(class easy3d::SurfaceMesh *, float)) &easy3d::GaussianNoise::apply, "Add Gaussian noise (that has a normal distribution) to the surface mesh.\n \n\n The surface mesh.\n \n\n The standard deviation of the noise distribution. So about 68 percent of the noise values are\n              within one standard deviation of the mean (mathematically, μ ± σ, where μ is the arithmetic\n              mean), about 95 percent are within two standard deviations (μ ± 2σ).\n\nC++: easy3d::GaussianNoise::apply(class easy3d::SurfaceMesh *, float) --> void", pybind11::arg("mesh"), pybind11::arg("sigma"));
         cl.def_static("apply", (void (*)(class easy3d::PointCloud *, float)) &easy3d::GaussianNoise::apply, "Add Gaussian noise (that has a normal distribution) to a point cloud.\n \n\n The point cloud.\n \n\n The standard deviation of the noise distribution. So about 68 percent of the noise values are\n              within one standard deviation of the mean (mathematically, μ ± σ, where μ is the arithmetic\n              mean), about 95 percent are within two standard deviations (μ ± 2σ).\n\nC++: easy3d::GaussianNoise::apply(class easy3d::PointCloud *, float) --> void", pybind11::arg("cloud"), pybind11::arg("sigma"));
+        cl.def_static("apply", (void (*)(class easy3d::SurfaceMesh *, float, uint64_t)) &easy3d::GaussianNoise::apply, "Add Gaussian noise to the surface mesh, using a specified seed.\n\nC++: easy3d::GaussianNoise::apply(class easy3d::SurfaceMesh *, float, uint64_t) --> void", pybind11::arg("mesh"), pybind11::arg("sigma"), pybind11::arg("seed"));
+        cl.def_static("apply", (void (*)(class easy3d::PointCloud *, float, uint64_t)) &easy3d::GaussianNoise::apply, "Add Gaussian noise to the point cloud, using a specified seed.\n\nC++: easy3d::GaussianNoise::apply(class easy3d::PointCloud *, float, uint64_t) --> void", pybind11::arg("cloud"), pybind11::arg("sigma"), pybind11::arg("seed"));
     }
 
 }
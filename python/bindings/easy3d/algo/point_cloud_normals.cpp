@@ -56,4 +56,24 @@ void bind_easy3d_algo_point_cloud_normals(pybind11::module_& m)
                 bool: True if successful, False otherwise.
             )doc");
 	}
+	{ // easy3d::IncrementalPointCloudNormals file:easy3d/algo/point_cloud_normals.h line:93
+		pybind11::class_<easy3d::IncrementalPointCloudNormals, std::shared_ptr<easy3d::IncrementalPointCloudNormals>> cl(m, "IncrementalPointCloudNormals", "Estimates the normals of a growing point cloud, e.g., during scanning. Only the new points and the\n existing points whose neighborhoods change are (re-)estimated in each batch.\n");
+		cl.def( pybind11::init<easy3d::PointCloud *, unsigned int, bool, float>(), pybind11::keep_alive<1, 2>(),
+				pybind11::arg("cloud"), pybind11::arg("k") = 16, pybind11::arg("compute_curvature") = false, pybind11::arg("cell_size") = 0.0f );
+
+		{ // easy3d::IncrementalPointCloudNormals::BatchStats file:easy3d/algo/point_cloud_normals.h line:96
+			auto & enclosing_class = cl;
+			pybind11::class_<easy3d::IncrementalPointCloudNormals::BatchStats, std::shared_ptr<easy3d::IncrementalPointCloudNormals::BatchStats>> cl(enclosing_class, "BatchStats", "The cost of processing a batch of points.");
+			cl.def( pybind11::init( [](){ return new easy3d::IncrementalPointCloudNormals::BatchStats(); } ) );
+			cl.def_readwrite("new_points", &easy3d::IncrementalPointCloudNormals::BatchStats::new_points);
+			cl.def_readwrite("updated_points", &easy3d::IncrementalPointCloudNormals::BatchStats::updated_points);
+			cl.def_readwrite("seconds", &easy3d::IncrementalPointCloudNormals::BatchStats::seconds);
+		}
+
+		cl.def("update", [](easy3d::IncrementalPointCloudNormals &o) { return o.update(); },
+				"Estimates the normals of the points added since the last call, and updates the normals of the existing points whose neighborhoods changed.\n\nReturns:\n    BatchStats: The cost of processing the batch.");
+		cl.def("last_batch", [](const easy3d::IncrementalPointCloudNormals &o) { return o.last_batch(); }, "Returns the cost of the last batch.");
+		cl.def("num_processed", &easy3d::IncrementalPointCloudNormals::num_processed, "Returns the number of points that have been processed.");
+		cl.def("reset", &easy3d::IncrementalPointCloudNormals::reset, "Forgets all the processed points, i.e., the next update() processes all the points.");
+	}
 }
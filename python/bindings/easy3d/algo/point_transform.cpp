@@ -0,0 +1,22 @@
+#include <easy3d/algo/point_transform.h>
+
+#include <memory>
+
+#include <pybind11/pybind11.h>
+
+#ifndef BINDER_PYBIND11_TYPE_CASTER
+	#define BINDER_PYBIND11_TYPE_CASTER
+	PYBIND11_DECLARE_HOLDER_TYPE(T, std::shared_ptr<T>, false)
+	PYBIND11_DECLARE_HOLDER_TYPE(T, T*, false)
+	PYBIND11_MAKE_OPAQUE(std::shared_ptr<void>)
+#endif
+
+void bind_easy3d_algo_point_transform(pybind11::module_& m)
+{
+    { // easy3d::PointTransform file:easy3d/algo/point_transform.h line:53
+        pybind11::class_<easy3d::PointTransform, std::shared_ptr<easy3d::PointTransform>> cl(m, "PointTransform", "Parallel transformations of the points (and normals) of models, e.g., for data augmentation.\n");
+        cl.def( pybind11::init( [](){ return new easy3d::PointTransform(); } ) );
+        cl.def_static("apply", &easy3d::PointTransform::apply, "Transforms a model by an affine transformation. The points are transformed by the matrix, and the\n normals (\"v:normal\" and \"f:normal\") by the inverse transpose of its upper-left 3x3 sub-matrix.\n\nC++: easy3d::PointTransform::apply(class easy3d::Model *, const class easy3d::Mat4<float> &) --> void", pybind11::arg("model"), pybind11::arg("m"));
+        cl.def_static("add_noise", &easy3d::PointTransform::add_noise, "Adds Gaussian noise to the points. Each point is moved along a random direction by a distance\n following N(0, sigma). The result is reproducible with the same seed.\n\nC++: easy3d::PointTransform::add_noise(class easy3d::Model *, float, uint64_t) --> void", pybind11::arg("model"), pybind11::arg("sigma"), pybind11::arg("seed"));
+    }
+}
@@ -19,10 +19,12 @@ void bind_easy3d_algo_surface_mesh_curvature(pybind11::module_& m)
 		cl.def( pybind11::init<class easy3d::SurfaceMesh *>(), pybind11::arg("mesh") );
 
 		cl.def("analyze", [](easy3d::SurfaceMeshCurvature &o) -> void { return o.analyze(); }, "");
-		cl.def("analyze", (void (easy3d::SurfaceMeshCurvature::*)(unsigned int)) &easy3d::SurfaceMeshCurvature::analyze, "Computes principle curvature information for each vertex, optionally followed by some smoothing iterations\n of the curvature values. Upon finish, the principle curvatures are stored as vertex properties \"v:curv-min\"\n and \"v:curv-max\", respectively.\n\nC++: easy3d::SurfaceMeshCurvature::analyze(unsigned int) --> void", pybind11::arg("post_smoothing_steps"));
+		cl.def("analyze", [](easy3d::SurfaceMeshCurvature &o, unsigned int const & a0) -> void { return o.analyze(a0); }, "", pybind11::arg("post_smoothing_steps"));
+		cl.def("analyze", (void (easy3d::SurfaceMeshCurvature::*)(unsigned int, bool)) &easy3d::SurfaceMeshCurvature::analyze, "Computes principle curvature information for each vertex, optionally followed by some smoothing iterations\n of the curvature values. Upon finish, the principle curvatures are stored as vertex properties \"v:curv-min\"\n and \"v:curv-max\", respectively. If lazy is true, the computation is skipped if the mesh has not changed.\n\nC++: easy3d::SurfaceMeshCurvature::analyze(unsigned int, bool) --> void", pybind11::arg("post_smoothing_steps"), pybind11::arg("lazy"));
 		cl.def("analyze_tensor", [](easy3d::SurfaceMeshCurvature &o) -> void { return o.analyze_tensor(); }, "");
 		cl.def("analyze_tensor", [](easy3d::SurfaceMeshCurvature &o, unsigned int const & a0) -> void { return o.analyze_tensor(a0); }, "", pybind11::arg("post_smoothing_steps"));
-		cl.def("analyze_tensor", (void (easy3d::SurfaceMeshCurvature::*)(unsigned int, bool)) &easy3d::SurfaceMeshCurvature::analyze_tensor, "Computes principle curvature information for each vertex, optionally followed by some smoothing iterations\n of the curvature values. Upon finish, the principle curvatures are stored as vertex properties \"v:curv-min\"\n and \"v:curv-max\", respectively.\n\nC++: easy3d::SurfaceMeshCurvature::analyze_tensor(unsigned int, bool) --> void", pybind11::arg("post_smoothing_steps"), pybind11::arg("two_ring_neighborhood"));
+		cl.def("analyze_tensor", [](easy3d::SurfaceMeshCurvature &o, unsigned int const & a0, bool const & a1) -> void { return o.analyze_tensor(a0, a1); }, "", pybind11::arg("post_smoothing_steps"), pybind11::arg("two_ring_neighborhood"));
+		cl.def("analyze_tensor", (void (easy3d::SurfaceMeshCurvature::*)(unsigned int, bool, bool)) &easy3d::SurfaceMeshCurvature::analyze_tensor, "Computes principle curvature information for each vertex, optionally followed by some smoothing iterations\n of the curvature values. Upon finish, the principle curvatures are stored as vertex properties \"v:curv-min\"\n and \"v:curv-max\", respectively. If lazy is true, the computation is skipped if the mesh has not changed.\n\nC++: easy3d::SurfaceMeshCurvature::analyze_tensor(unsigned int, bool, bool) --> void", pybind11::arg("post_smoothing_steps"), pybind11::arg("two_ring_neighborhood"), pybind11::arg("lazy"));
 		cl.def("compute_mean_curvature", (void (easy3d::SurfaceMeshCurvature::*)()) &easy3d::SurfaceMeshCurvature::compute_mean_curvature, "Computes the mean curvature.\n \n\n This function must be called after calling to the \"analyze\" function.\n\nC++: easy3d::SurfaceMeshCurvature::compute_mean_curvature() --> void");
 		cl.def("compute_gauss_curvature", (void (easy3d::SurfaceMeshCurvature::*)()) &easy3d::SurfaceMeshCurvature::compute_gauss_curvature, "Computes the Gaussian curvature.\n \n\n This function must be called after calling to the \"analyze\" function.\n\nC++: easy3d::SurfaceMeshCurvature::compute_gauss_curvature() --> void");
 		cl.def("compute_max_abs_curvature", (void (easy3d::SurfaceMeshCurvature::*)()) &easy3d::SurfaceMeshCurvature::compute_max_abs_curvature, "Computes the max. abs. curvature.\n \n\n This function must be called after calling to the \"analyze\" function.\n\nC++: easy3d::SurfaceMeshCurvature::compute_max_abs_curvature() --> void");
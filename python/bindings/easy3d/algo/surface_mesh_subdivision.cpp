@@ -19,7 +19,9 @@ void bind_easy3d_algo_surface_mesh_subdivision(pybind11::module_& m)
 		pybind11::class_<easy3d::SurfaceMeshSubdivision, std::shared_ptr<easy3d::SurfaceMeshSubdivision>> cl(m, "SurfaceMeshSubdivision", "SurfaceMeshSubdivision implement several well-known subdivision algorithms.\n \n");
 		cl.def( pybind11::init( [](){ return new easy3d::SurfaceMeshSubdivision(); } ) );
 		cl.def_static("catmull_clark", (bool (*)(class easy3d::SurfaceMesh *)) &easy3d::SurfaceMeshSubdivision::catmull_clark, "The Catmull-Clark subdivision. \n\nC++: easy3d::SurfaceMeshSubdivision::catmull_clark(class easy3d::SurfaceMesh *) --> bool", pybind11::arg("mesh"));
+		cl.def_static("catmull_clark", (bool (*)(class easy3d::SurfaceMesh *, unsigned int)) &easy3d::SurfaceMeshSubdivision::catmull_clark, "The Catmull-Clark subdivision applied  times, each level building the refined mesh out of place.\n\nC++: easy3d::SurfaceMeshSubdivision::catmull_clark(class easy3d::SurfaceMesh *, unsigned int) --> bool", pybind11::arg("mesh"), pybind11::arg("levels"));
 		cl.def_static("loop", (bool (*)(class easy3d::SurfaceMesh *)) &easy3d::SurfaceMeshSubdivision::loop, "The Loop subdivision. \n\nC++: easy3d::SurfaceMeshSubdivision::loop(class easy3d::SurfaceMesh *) --> bool", pybind11::arg("mesh"));
+		cl.def_static("loop", (bool (*)(class easy3d::SurfaceMesh *, unsigned int)) &easy3d::SurfaceMeshSubdivision::loop, "The Loop subdivision applied  times, each level building the refined mesh out of place.\n\nC++: easy3d::SurfaceMeshSubdivision::loop(class easy3d::SurfaceMesh *, unsigned int) --> bool", pybind11::arg("mesh"), pybind11::arg("levels"));
 		cl.def_static("sqrt3", (bool (*)(class easy3d::SurfaceMesh *)) &easy3d::SurfaceMeshSubdivision::sqrt3, "The sqrt3 subdivision. \n\nC++: easy3d::SurfaceMeshSubdivision::sqrt3(class easy3d::SurfaceMesh *) --> bool", pybind11::arg("mesh"));
 	}
 
@@ -0,0 +1,56 @@
+#include <easy3d/algo/surface_mesh_validation.h>
+
+#include <memory>
+
+#include <pybind11/pybind11.h>
+
+#ifndef BINDER_PYBIND11_TYPE_CASTER
+	#define BINDER_PYBIND11_TYPE_CASTER
+	PYBIND11_DECLARE_HOLDER_TYPE(T, std::shared_ptr<T>, false)
+	PYBIND11_DECLARE_HOLDER_TYPE(T, T*, false)
+	PYBIND11_MAKE_OPAQUE(std::shared_ptr<void>)
+#endif
+
+void bind_easy3d_algo_surface_mesh_validation(pybind11::module_& m)
+{
+	{ // easy3d::SurfaceMeshValidation file:easy3d/algo/surface_mesh_validation.h line:41
+		pybind11::class_<easy3d::SurfaceMeshValidation, std::shared_ptr<easy3d::SurfaceMeshValidation>> cl(m, "SurfaceMeshValidation", "Validation and repair of the topology of a surface mesh.");
+		cl.def( pybind11::init<class easy3d::SurfaceMesh *>(), pybind11::arg("mesh") );
+
+		pybind11::enum_<easy3d::SurfaceMeshValidation::Problem>(cl, "Problem", pybind11::arithmetic(), "The problems that can be detected (and some of them repaired). They can be combined as bit flags.")
+			.value("ISOLATED_VERTICES", easy3d::SurfaceMeshValidation::ISOLATED_VERTICES)
+			.value("NON_MANIFOLD_VERTICES", easy3d::SurfaceMeshValidation::NON_MANIFOLD_VERTICES)
+			.value("DEGENERATE_FACES", easy3d::SurfaceMeshValidation::DEGENERATE_FACES)
+			.value("DUPLICATE_FACES", easy3d::SurfaceMeshValidation::DUPLICATE_FACES)
+			.value("COINCIDENT_BORDERS", easy3d::SurfaceMeshValidation::COINCIDENT_BORDERS)
+			.value("SMALL_COMPONENTS", easy3d::SurfaceMeshValidation::SMALL_COMPONENTS)
+			.value("ALL", easy3d::SurfaceMeshValidation::ALL)
+			.export_values();
+
+		{ // easy3d::SurfaceMeshValidation::Report file:easy3d/algo/surface_mesh_validation.h line:60
+			auto & enclosing_class = cl;
+			pybind11::class_<easy3d::SurfaceMeshValidation::Report, std::shared_ptr<easy3d::SurfaceMeshValidation::Report>> cl(enclosing_class, "Report", "The summary of a validation (or the numbers of elements fixed by a repair).");
+			cl.def( pybind11::init( [](){ return new easy3d::SurfaceMeshValidation::Report(); } ) );
+			cl.def_readwrite("isolated_vertices", &easy3d::SurfaceMeshValidation::Report::isolated_vertices);
+			cl.def_readwrite("non_manifold_vertices", &easy3d::SurfaceMeshValidation::Report::non_manifold_vertices);
+			cl.def_readwrite("degenerate_faces", &easy3d::SurfaceMeshValidation::Report::degenerate_faces);
+			cl.def_readwrite("duplicate_faces", &easy3d::SurfaceMeshValidation::Report::duplicate_faces);
+			cl.def_readwrite("unstitched_borders", &easy3d::SurfaceMeshValidation::Report::unstitched_borders);
+			cl.def_readwrite("incompatible_borders", &easy3d::SurfaceMeshValidation::Report::incompatible_borders);
+			cl.def_readwrite("components", &easy3d::SurfaceMeshValidation::Report::components);
+			cl.def_readwrite("small_components", &easy3d::SurfaceMeshValidation::Report::small_components);
+			cl.def_readwrite("small_component_faces", &easy3d::SurfaceMeshValidation::Report::small_component_faces);
+			cl.def("is_clean", (bool (easy3d::SurfaceMeshValidation::Report::*)() const) &easy3d::SurfaceMeshValidation::Report::is_clean, "Returns true if no problem was found.\n\nC++: easy3d::SurfaceMeshValidation::Report::is_clean() const --> bool");
+			cl.def("to_string", (std::string (easy3d::SurfaceMeshValidation::Report::*)() const) &easy3d::SurfaceMeshValidation::Report::to_string, "Returns a one-line summary of the report.\n\nC++: easy3d::SurfaceMeshValidation::Report::to_string() const --> std::string");
+		}
+
+		cl.def("set_degenerate_threshold", (void (easy3d::SurfaceMeshValidation::*)(float)) &easy3d::SurfaceMeshValidation::set_degenerate_threshold, "Sets the threshold for degenerate faces (relative to the bounding box diagonal).\n\nC++: easy3d::SurfaceMeshValidation::set_degenerate_threshold(float) --> void", pybind11::arg("t"));
+		cl.def("set_min_component_size", (void (easy3d::SurfaceMeshValidation::*)(std::size_t)) &easy3d::SurfaceMeshValidation::set_min_component_size, "Sets the minimum size (number of faces) of a connected component.\n\nC++: easy3d::SurfaceMeshValidation::set_min_component_size(std::size_t) --> void", pybind11::arg("n"));
+		cl.def("validate", [](easy3d::SurfaceMeshValidation &o) -> easy3d::SurfaceMeshValidation::Report { return o.validate(); }, "");
+		cl.def("validate", [](easy3d::SurfaceMeshValidation &o, int problems) -> easy3d::SurfaceMeshValidation::Report { return o.validate(problems); }, "Checks the mesh for the specified problems.\n\nC++: easy3d::SurfaceMeshValidation::validate(int) --> const struct easy3d::SurfaceMeshValidation::Report &", pybind11::arg("problems"));
+		cl.def("repair", [](easy3d::SurfaceMeshValidation &o) -> easy3d::SurfaceMeshValidation::Report { return o.repair(); }, "");
+		cl.def("repair", (struct easy3d::SurfaceMeshValidation::Report (easy3d::SurfaceMeshValidation::*)(int)) &easy3d::SurfaceMeshValidation::repair, "Repairs the specified problems in a single batch.\n\nC++: easy3d::SurfaceMeshValidation::repair(int) --> struct easy3d::SurfaceMeshValidation::Report", pybind11::arg("problems"));
+		cl.def("report", [](easy3d::SurfaceMeshValidation const &o) -> easy3d::SurfaceMeshValidation::Report { return o.report(); }, "Returns the report of the last validation.");
+	}
+
+}
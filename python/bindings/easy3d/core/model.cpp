@@ -80,6 +80,11 @@ void bind_easy3d_core_model(pybind11::module_& m)
         cl.def("bounding_box", [](easy3d::Model const &o) -> const easy3d::GenericBox<3, float> & { return o.bounding_box(); }, "", pybind11::return_value_policy::automatic);
 		cl.def("bounding_box", (const class easy3d::GenericBox<3, float> & (easy3d::Model::*)(bool) const) &easy3d::Model::bounding_box, "The bounding box of the model.\n \n\n If  or if the bounding box is not known, it computes and returns the bounding\n      box of the model. Otherwise, it returns the known bounding box.\n \n\n Manipulation transformation is not handled.\n \n\n invalidate_bounding_box().\n\nC++: easy3d::Model::bounding_box(bool) const --> const class easy3d::GenericBox<3, float> &", pybind11::return_value_policy::automatic, pybind11::arg("recompute"));
 		cl.def("invalidate_bounding_box", (void (easy3d::Model::*)()) &easy3d::Model::invalidate_bounding_box, "Invalidates the bounding box of the model. So when bounding_box() is called, the bounding box will\n be re-computed. This function is typically called when the geometry of a model is changed.\n\nC++: easy3d::Model::invalidate_bounding_box() --> void");
+		cl.def("geometry_revision", (std::size_t (easy3d::Model::*)() const) &easy3d::Model::geometry_revision, "Returns the revision of the geometry of the model, which is increased whenever the geometry or the topology changes.\n\nC++: easy3d::Model::geometry_revision() const --> std::size_t");
+		cl.def("topology_revision", (std::size_t (easy3d::Model::*)() const) &easy3d::Model::topology_revision, "Returns the revision of the topology of the model, which is increased whenever elements are added, removed, or reconnected.\n\nC++: easy3d::Model::topology_revision() const --> std::size_t");
+		cl.def("touch_geometry", (void (easy3d::Model::*)()) &easy3d::Model::touch_geometry, "Notifies the model that its geometry (e.g., vertex positions) has been modified.\n\nC++: easy3d::Model::touch_geometry() --> void");
+		cl.def("touch_topology", (void (easy3d::Model::*)()) &easy3d::Model::touch_topology, "Notifies the model that its topology has been modified. This also increases the geometry revision.\n\nC++: easy3d::Model::touch_topology() --> void");
+		cl.def("mark_outdated", (void (easy3d::Model::*)(const std::string &)) &easy3d::Model::mark_outdated, "Forces the derived data  to be recomputed the next time it is requested.\n\nC++: easy3d::Model::mark_outdated(const std::string &) --> void", pybind11::arg("name"));
 		cl.def("points", (class std::vector<class easy3d::Vec<3, float> > & (easy3d::Model::*)()) &easy3d::Model::points, "The vertices of the model. \n\nC++: easy3d::Model::points() --> class std::vector<class easy3d::Vec<3, float> > &", pybind11::return_value_policy::automatic);
         cl.def("points", (const class std::vector<class easy3d::Vec<3, float> > & (easy3d::Model::*)() const) &easy3d::Model::points, "The vertices of the model. \n\nC++: easy3d::Model::points() --> class std::vector<class easy3d::Vec<3, float> > &", pybind11::return_value_policy::automatic);
 		cl.def("empty", (bool (easy3d::Model::*)() const) &easy3d::Model::empty, "Tests if the model is empty. \n\nC++: easy3d::Model::empty() const --> bool");
@@ -127,9 +127,7 @@ void bind_easy3d_core_point_cloud(pybind11::module_& m)
         // Initialize PointCloud from an array of 3D points
         cl.def(pybind11::init([](const class std::vector<class easy3d::Vec<3, float> >& points) {
             auto pc = std::make_shared<easy3d::PointCloud>();
-            for (const auto& p : points) {
-                pc->add_vertex(p);
-            }
+            pc->add_vertices(points);
             return pc;
         }), "Initialize PointCloud from an array of 3D points");
 
@@ -319,6 +317,7 @@ void bind_easy3d_core_point_cloud(pybind11::module_& m)
 		cl.def("vertices_size", (unsigned int (easy3d::PointCloud::*)() const) &easy3d::PointCloud::vertices_size, "returns number of (deleted and valid) vertices in the cloud\n\nC++: easy3d::PointCloud::vertices_size() const --> unsigned int");
 		cl.def("n_vertices", (unsigned int (easy3d::PointCloud::*)() const) &easy3d::PointCloud::n_vertices, "returns number of vertices in the cloud\n\nC++: easy3d::PointCloud::n_vertices() const --> unsigned int");
 		cl.def("clear", (void (easy3d::PointCloud::*)()) &easy3d::PointCloud::clear, "clear cloud: remove all vertices\n\nC++: easy3d::PointCloud::clear() --> void");
+		cl.def("add_vertices", (struct easy3d::PointCloud::Vertex (easy3d::PointCloud::*)(const class std::vector<class easy3d::Vec<3, float> > &)) &easy3d::PointCloud::add_vertices, "Add new vertices with positions  (all the vertex properties grow once). Returns the first added vertex.\n\nC++: easy3d::PointCloud::add_vertices(const class std::vector<class easy3d::Vec<3, float> > &) --> struct easy3d::PointCloud::Vertex", pybind11::arg("points"));
 		cl.def("resize", (void (easy3d::PointCloud::*)(unsigned int)) &easy3d::PointCloud::resize, "resize space for vertices and their currently associated properties.\n\nC++: easy3d::PointCloud::resize(unsigned int) --> void", pybind11::arg("nv"));
 		cl.def("has_garbage", (bool (easy3d::PointCloud::*)() const) &easy3d::PointCloud::has_garbage, "are there deleted vertices?\n\nC++: easy3d::PointCloud::has_garbage() const --> bool");
 		cl.def("collect_garbage", (void (easy3d::PointCloud::*)()) &easy3d::PointCloud::collect_garbage, "remove deleted vertices\n\nC++: easy3d::PointCloud::collect_garbage() --> void");
@@ -901,6 +901,9 @@ void bind_easy3d_core_poly_mesh(pybind11::module_& m)
 		cl.def("add_cell", (struct easy3d::PolyMesh::Cell (easy3d::PolyMesh::*)(const class std::vector<struct easy3d::PolyMesh::HalfFace> &)) &easy3d::PolyMesh::add_cell, "add a new cell defined by \n \n\n The input faces created by add_face(), add_triangle(), or add_quad().\n \n\n add_face(), add_triangle(), add_quad(), add_tetra(), add_hexa()\n\nC++: easy3d::PolyMesh::add_cell(const class std::vector<struct easy3d::PolyMesh::HalfFace> &) --> struct easy3d::PolyMesh::Cell", pybind11::arg("faces"));
 		cl.def("add_tetra", (struct easy3d::PolyMesh::Cell (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::HalfFace, struct easy3d::PolyMesh::HalfFace, struct easy3d::PolyMesh::HalfFace, struct easy3d::PolyMesh::HalfFace)) &easy3d::PolyMesh::add_tetra, "add a new tetrahedron defined by its faces.\n \n\n f1, f2, f3} The input faces created by add_face() or add_triangle().\n \n\n add_cell(), add_tetra(), add_face(), add_triangle().\n\nC++: easy3d::PolyMesh::add_tetra(struct easy3d::PolyMesh::HalfFace, struct easy3d::PolyMesh::HalfFace, struct easy3d::PolyMesh::HalfFace, struct easy3d::PolyMesh::HalfFace) --> struct easy3d::PolyMesh::Cell", pybind11::arg("f0"), pybind11::arg("f1"), pybind11::arg("f2"), pybind11::arg("f3"));
 		cl.def("add_tetra", (struct easy3d::PolyMesh::Cell (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::Vertex, struct easy3d::PolyMesh::Vertex, struct easy3d::PolyMesh::Vertex, struct easy3d::PolyMesh::Vertex)) &easy3d::PolyMesh::add_tetra, "add a new tetrahedron connecting vertices    \n \n\n v1, v2, v3} The input vertices created by add_vertex().\n \n\n It creates all the faces and the cell, and adds them to the mesh.\n \n\n add_vertex()\n\nC++: easy3d::PolyMesh::add_tetra(struct easy3d::PolyMesh::Vertex, struct easy3d::PolyMesh::Vertex, struct easy3d::PolyMesh::Vertex, struct easy3d::PolyMesh::Vertex) --> struct easy3d::PolyMesh::Cell", pybind11::arg("v0"), pybind11::arg("v1"), pybind11::arg("v2"), pybind11::arg("v3"));
+		cl.def("add_tetras", (unsigned int (easy3d::PolyMesh::*)(const class std::vector<unsigned int> &)) &easy3d::PolyMesh::add_tetras, "add a set of tetrahedra in a single pass.\n \n\n The vertex indices of the tetrahedra, four per tetrahedron.\n \n\n The number of tetrahedra added.\n\nC++: easy3d::PolyMesh::add_tetras(const class std::vector<unsigned int> &) --> unsigned int", pybind11::arg("indices"));
+		cl.def("add_hexas", (unsigned int (easy3d::PolyMesh::*)(const class std::vector<unsigned int> &)) &easy3d::PolyMesh::add_hexas, "add a set of hexahedra in a single pass.\n \n\n The vertex indices of the hexahedra, eight per hexahedron.\n \n\n The number of hexahedra added.\n\nC++: easy3d::PolyMesh::add_hexas(const class std::vector<unsigned int> &) --> unsigned int", pybind11::arg("indices"));
+		cl.def("add_cells", (unsigned int (easy3d::PolyMesh::*)(const class std::vector<unsigned int> &)) &easy3d::PolyMesh::add_cells, "add a set of general polyhedral cells in a single pass.\n \n\n The cells given as a flat sequence: each cell is given by its number of faces followed by its faces, and each face is given by its number of vertices followed by its vertex indices.\n \n\n The number of cells added.\n\nC++: easy3d::PolyMesh::add_cells(const class std::vector<unsigned int> &) --> unsigned int", pybind11::arg("cells"));
 		cl.def("add_hexa", (struct easy3d::PolyMesh::Cell (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::Vertex, struct easy3d::PolyMesh::Vertex, struct easy3d::PolyMesh::Vertex, struct easy3d::PolyMesh::Vertex, struct easy3d::PolyMesh::Vertex, struct easy3d::PolyMesh::Vertex, struct easy3d::PolyMesh::Vertex, struct easy3d::PolyMesh::Vertex)) &easy3d::PolyMesh::add_hexa, "add a new hexahedron connecting vertices        \n \n\n v1, v2, v3, v4, v5, v6, v7} The input vertices created by add_vertex().\n     The vertices must be ordered as bellow:\n             3--------------------2\n             |\\                   |\\\n        ///             | \\                  | \\\n        ///             |  \\                 |  \\\n        ///             |   7----------------+---6\n             |   |                |   |\n             0---+----------------1   |\n              \\  |                 \\  |\n               \\ |                  \\ |\n                \\|                   \\|\n                 4--------------------5\n \n\n It creates all the faces and the cell, and adds them to the mesh.\n \n\n add_vertex()\n\nC++: easy3d::PolyMesh::add_hexa(struct easy3d::PolyMesh::Vertex, struct easy3d::PolyMesh::Vertex, struct easy3d::PolyMesh::Vertex, struct easy3d::PolyMesh::Vertex, struct easy3d::PolyMesh::Vertex, struct easy3d::PolyMesh::Vertex, struct easy3d::PolyMesh::Vertex, struct easy3d::PolyMesh::Vertex) --> struct easy3d::PolyMesh::Cell", pybind11::arg("v0"), pybind11::arg("v1"), pybind11::arg("v2"), pybind11::arg("v3"), pybind11::arg("v4"), pybind11::arg("v5"), pybind11::arg("v6"), pybind11::arg("v7"));
 		cl.def("add_face", (struct easy3d::PolyMesh::HalfFace (easy3d::PolyMesh::*)(const class std::vector<struct easy3d::PolyMesh::Vertex> &)) &easy3d::PolyMesh::add_face, "add a new face connecting \n \n\n The input vertices created by add_vertex().\n \n\n add_triangle(), add_quad()\n\nC++: easy3d::PolyMesh::add_face(const class std::vector<struct easy3d::PolyMesh::Vertex> &) --> struct easy3d::PolyMesh::HalfFace", pybind11::arg("vertices"));
 		cl.def("add_triangle", (struct easy3d::PolyMesh::HalfFace (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::Vertex, struct easy3d::PolyMesh::Vertex, struct easy3d::PolyMesh::Vertex)) &easy3d::PolyMesh::add_triangle, "add a new triangle face connecting vertices   \n \n\n v1, v2} The input vertices created by add_vertex().\n \n\n add_face(), add_quad()\n\nC++: easy3d::PolyMesh::add_triangle(struct easy3d::PolyMesh::Vertex, struct easy3d::PolyMesh::Vertex, struct easy3d::PolyMesh::Vertex) --> struct easy3d::PolyMesh::HalfFace", pybind11::arg("v0"), pybind11::arg("v1"), pybind11::arg("v2"));
@@ -957,22 +960,22 @@ void bind_easy3d_core_poly_mesh(pybind11::module_& m)
 		cl.def("cells_begin", (class easy3d::PolyMesh::CellIterator (easy3d::PolyMesh::*)() const) &easy3d::PolyMesh::cells_begin, "returns start iterator for cells\n\nC++: easy3d::PolyMesh::cells_begin() const --> class easy3d::PolyMesh::CellIterator");
 		cl.def("cells_end", (class easy3d::PolyMesh::CellIterator (easy3d::PolyMesh::*)() const) &easy3d::PolyMesh::cells_end, "returns end iterator for cells\n\nC++: easy3d::PolyMesh::cells_end() const --> class easy3d::PolyMesh::CellIterator");
 		cl.def("cells", (class easy3d::PolyMesh::CellContainer (easy3d::PolyMesh::*)() const) &easy3d::PolyMesh::cells, "returns cell container for C++11 range-based for-loops\n\nC++: easy3d::PolyMesh::cells() const --> class easy3d::PolyMesh::CellContainer");
-		cl.def("vertices", (const class std::set<struct easy3d::PolyMesh::Vertex> & (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::Vertex) const) &easy3d::PolyMesh::vertices, "returns the vertices around vertex \n\nC++: easy3d::PolyMesh::vertices(struct easy3d::PolyMesh::Vertex) const --> const class std::set<struct easy3d::PolyMesh::Vertex> &", pybind11::return_value_policy::automatic, pybind11::arg("v"));
+		cl.def("vertices", (const class std::vector<struct easy3d::PolyMesh::Vertex> & (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::Vertex) const) &easy3d::PolyMesh::vertices, "returns the vertices around vertex \n\nC++: easy3d::PolyMesh::vertices(struct easy3d::PolyMesh::Vertex) const --> const class std::vector<struct easy3d::PolyMesh::Vertex> &", pybind11::return_value_policy::automatic, pybind11::arg("v"));
 		cl.def("halfface", (struct easy3d::PolyMesh::HalfFace (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::Face, unsigned int) const) &easy3d::PolyMesh::halfface, "returns the  halfface of face   has to be 0 or 1.\n\nC++: easy3d::PolyMesh::halfface(struct easy3d::PolyMesh::Face, unsigned int) const --> struct easy3d::PolyMesh::HalfFace", pybind11::arg("f"), pybind11::arg("i"));
 		cl.def("face", (struct easy3d::PolyMesh::Face (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::HalfFace) const) &easy3d::PolyMesh::face, "returns the face of HalfFace \n\nC++: easy3d::PolyMesh::face(struct easy3d::PolyMesh::HalfFace) const --> struct easy3d::PolyMesh::Face", pybind11::arg("h"));
 		cl.def("opposite", (struct easy3d::PolyMesh::HalfFace (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::HalfFace) const) &easy3d::PolyMesh::opposite, "returns the twin halfface of halfface \n\nC++: easy3d::PolyMesh::opposite(struct easy3d::PolyMesh::HalfFace) const --> struct easy3d::PolyMesh::HalfFace", pybind11::arg("h"));
 		cl.def("vertex", (struct easy3d::PolyMesh::Vertex (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::Edge, unsigned int) const) &easy3d::PolyMesh::vertex, "returns the  vertex of edge   has to be 0 or 1.\n\nC++: easy3d::PolyMesh::vertex(struct easy3d::PolyMesh::Edge, unsigned int) const --> struct easy3d::PolyMesh::Vertex", pybind11::arg("e"), pybind11::arg("i"));
 		cl.def("vertices", (const class std::vector<struct easy3d::PolyMesh::Vertex> & (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::HalfFace) const) &easy3d::PolyMesh::vertices, "returns the set of vertices around halfface \n The vertices are ordered in a way such that its normal points outside of the cell associated with \n\nC++: easy3d::PolyMesh::vertices(struct easy3d::PolyMesh::HalfFace) const --> const class std::vector<struct easy3d::PolyMesh::Vertex> &", pybind11::return_value_policy::automatic, pybind11::arg("h"));
 		cl.def("vertices", (const class std::vector<struct easy3d::PolyMesh::Vertex> & (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::Face) const) &easy3d::PolyMesh::vertices, "returns the set of vertices around face \n\nC++: easy3d::PolyMesh::vertices(struct easy3d::PolyMesh::Face) const --> const class std::vector<struct easy3d::PolyMesh::Vertex> &", pybind11::return_value_policy::automatic, pybind11::arg("f"));
-		cl.def("vertices", (const class std::set<struct easy3d::PolyMesh::Vertex> & (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::Cell) const) &easy3d::PolyMesh::vertices, "returns the set of vertices around cell \n\nC++: easy3d::PolyMesh::vertices(struct easy3d::PolyMesh::Cell) const --> const class std::set<struct easy3d::PolyMesh::Vertex> &", pybind11::return_value_policy::automatic, pybind11::arg("c"));
-		cl.def("edges", (const class std::set<struct easy3d::PolyMesh::Edge> & (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::Vertex) const) &easy3d::PolyMesh::edges, "returns the set of edges around vertex \n\nC++: easy3d::PolyMesh::edges(struct easy3d::PolyMesh::Vertex) const --> const class std::set<struct easy3d::PolyMesh::Edge> &", pybind11::return_value_policy::automatic, pybind11::arg("v"));
-		cl.def("edges", (const class std::set<struct easy3d::PolyMesh::Edge> & (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::HalfFace) const) &easy3d::PolyMesh::edges, "returns the set of edges around halfface \n\nC++: easy3d::PolyMesh::edges(struct easy3d::PolyMesh::HalfFace) const --> const class std::set<struct easy3d::PolyMesh::Edge> &", pybind11::return_value_policy::automatic, pybind11::arg("h"));
-		cl.def("edges", (const class std::set<struct easy3d::PolyMesh::Edge> & (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::Cell) const) &easy3d::PolyMesh::edges, "returns the set of edges around cell \n\nC++: easy3d::PolyMesh::edges(struct easy3d::PolyMesh::Cell) const --> const class std::set<struct easy3d::PolyMesh::Edge> &", pybind11::return_value_policy::automatic, pybind11::arg("c"));
-		cl.def("halffaces", (const class std::set<struct easy3d::PolyMesh::HalfFace> & (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::Vertex) const) &easy3d::PolyMesh::halffaces, "returns the set of halffaces around vertex \n\nC++: easy3d::PolyMesh::halffaces(struct easy3d::PolyMesh::Vertex) const --> const class std::set<struct easy3d::PolyMesh::HalfFace> &", pybind11::return_value_policy::automatic, pybind11::arg("v"));
-		cl.def("halffaces", (const class std::set<struct easy3d::PolyMesh::HalfFace> & (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::Edge) const) &easy3d::PolyMesh::halffaces, "returns the set of halffaces around edge \n\nC++: easy3d::PolyMesh::halffaces(struct easy3d::PolyMesh::Edge) const --> const class std::set<struct easy3d::PolyMesh::HalfFace> &", pybind11::return_value_policy::automatic, pybind11::arg("e"));
+		cl.def("vertices", (const class std::vector<struct easy3d::PolyMesh::Vertex> & (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::Cell) const) &easy3d::PolyMesh::vertices, "returns the set of vertices around cell \n\nC++: easy3d::PolyMesh::vertices(struct easy3d::PolyMesh::Cell) const --> const class std::vector<struct easy3d::PolyMesh::Vertex> &", pybind11::return_value_policy::automatic, pybind11::arg("c"));
+		cl.def("edges", (const class std::vector<struct easy3d::PolyMesh::Edge> & (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::Vertex) const) &easy3d::PolyMesh::edges, "returns the set of edges around vertex \n\nC++: easy3d::PolyMesh::edges(struct easy3d::PolyMesh::Vertex) const --> const class std::vector<struct easy3d::PolyMesh::Edge> &", pybind11::return_value_policy::automatic, pybind11::arg("v"));
+		cl.def("edges", (const class std::vector<struct easy3d::PolyMesh::Edge> & (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::HalfFace) const) &easy3d::PolyMesh::edges, "returns the set of edges around halfface \n\nC++: easy3d::PolyMesh::edges(struct easy3d::PolyMesh::HalfFace) const --> const class std::vector<struct easy3d::PolyMesh::Edge> &", pybind11::return_value_policy::automatic, pybind11::arg("h"));
+		cl.def("edges", (const class std::vector<struct easy3d::PolyMesh::Edge> & (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::Cell) const) &easy3d::PolyMesh::edges, "returns the set of edges around cell \n\nC++: easy3d::PolyMesh::edges(struct easy3d::PolyMesh::Cell) const --> const class std::vector<struct easy3d::PolyMesh::Edge> &", pybind11::return_value_policy::automatic, pybind11::arg("c"));
+		cl.def("halffaces", (const class std::vector<struct easy3d::PolyMesh::HalfFace> & (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::Vertex) const) &easy3d::PolyMesh::halffaces, "returns the set of halffaces around vertex \n\nC++: easy3d::PolyMesh::halffaces(struct easy3d::PolyMesh::Vertex) const --> const class std::vector<struct easy3d::PolyMesh::HalfFace> &", pybind11::return_value_policy::automatic, pybind11::arg("v"));
+		cl.def("halffaces", (const class std::vector<struct easy3d::PolyMesh::HalfFace> & (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::Edge) const) &easy3d::PolyMesh::halffaces, "returns the set of halffaces around edge \n\nC++: easy3d::PolyMesh::halffaces(struct easy3d::PolyMesh::Edge) const --> const class std::vector<struct easy3d::PolyMesh::HalfFace> &", pybind11::return_value_policy::automatic, pybind11::arg("e"));
 		cl.def("halffaces", (const class std::vector<struct easy3d::PolyMesh::HalfFace> & (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::Cell) const) &easy3d::PolyMesh::halffaces, "returns the set of halffaces around cell \n\nC++: easy3d::PolyMesh::halffaces(struct easy3d::PolyMesh::Cell) const --> const class std::vector<struct easy3d::PolyMesh::HalfFace> &", pybind11::return_value_policy::automatic, pybind11::arg("c"));
-		cl.def("cells", (const class std::set<struct easy3d::PolyMesh::Cell> & (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::Vertex) const) &easy3d::PolyMesh::cells, "returns the set of cells around vertex \n\nC++: easy3d::PolyMesh::cells(struct easy3d::PolyMesh::Vertex) const --> const class std::set<struct easy3d::PolyMesh::Cell> &", pybind11::return_value_policy::automatic, pybind11::arg("v"));
-		cl.def("cells", (const class std::set<struct easy3d::PolyMesh::Cell> & (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::Edge) const) &easy3d::PolyMesh::cells, "returns the set of cells around edge \n\nC++: easy3d::PolyMesh::cells(struct easy3d::PolyMesh::Edge) const --> const class std::set<struct easy3d::PolyMesh::Cell> &", pybind11::return_value_policy::automatic, pybind11::arg("e"));
+		cl.def("cells", (const class std::vector<struct easy3d::PolyMesh::Cell> & (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::Vertex) const) &easy3d::PolyMesh::cells, "returns the set of cells around vertex \n\nC++: easy3d::PolyMesh::cells(struct easy3d::PolyMesh::Vertex) const --> const class std::vector<struct easy3d::PolyMesh::Cell> &", pybind11::return_value_policy::automatic, pybind11::arg("v"));
+		cl.def("cells", (const class std::vector<struct easy3d::PolyMesh::Cell> & (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::Edge) const) &easy3d::PolyMesh::cells, "returns the set of cells around edge \n\nC++: easy3d::PolyMesh::cells(struct easy3d::PolyMesh::Edge) const --> const class std::vector<struct easy3d::PolyMesh::Cell> &", pybind11::return_value_policy::automatic, pybind11::arg("e"));
 		cl.def("cell", (struct easy3d::PolyMesh::Cell (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::HalfFace) const) &easy3d::PolyMesh::cell, "returns the cell associated with halfface \n\nC++: easy3d::PolyMesh::cell(struct easy3d::PolyMesh::HalfFace) const --> struct easy3d::PolyMesh::Cell", pybind11::arg("h"));
 		cl.def("is_tetraheral_mesh", (bool (easy3d::PolyMesh::*)() const) &easy3d::PolyMesh::is_tetraheral_mesh, "returns whether the mesh a tetrahedral mesh, i.e., every cell is a tetrahedron.\n\nC++: easy3d::PolyMesh::is_tetraheral_mesh() const --> bool");
 		cl.def("is_border", (bool (easy3d::PolyMesh::*)(struct easy3d::PolyMesh::Vertex) const) &easy3d::PolyMesh::is_border, "returns whether  is a boundary vertex, i.e., at least one of its incident halfface\n is not associated with a cell.\n\nC++: easy3d::PolyMesh::is_border(struct easy3d::PolyMesh::Vertex) const --> bool", pybind11::arg("v"));
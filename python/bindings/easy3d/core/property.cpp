@@ -152,6 +152,58 @@ struct PyCallBack_easy3d_BasePropertyArray : public easy3d::BasePropertyArray {
 		}
 		pybind11::pybind11_fail("Tried to call pure virtual function \"BasePropertyArray::push_back\"");
 	}
+	void append(size_t a0) override {
+		pybind11::gil_scoped_acquire gil;
+		pybind11::function overload = pybind11::get_overload(static_cast<const easy3d::BasePropertyArray *>(this), "append");
+		if (overload) {
+			auto o = overload.operator()<pybind11::return_value_policy::reference>(a0);
+			if (pybind11::detail::cast_is_temporary_value_reference<void>::value) {
+				static pybind11::detail::override_caster_t<void> caster;
+				return pybind11::detail::cast_ref<void>(std::move(o), caster);
+			}
+			return pybind11::detail::cast_safe<void>(std::move(o));
+		}
+		pybind11::pybind11_fail("Tried to call pure virtual function \"BasePropertyArray::append\"");
+	}
+	size_t size() const override {
+		pybind11::gil_scoped_acquire gil;
+		pybind11::function overload = pybind11::get_overload(static_cast<const easy3d::BasePropertyArray *>(this), "size");
+		if (overload) {
+			auto o = overload.operator()<pybind11::return_value_policy::reference>();
+			if (pybind11::detail::cast_is_temporary_value_reference<size_t>::value) {
+				static pybind11::detail::override_caster_t<size_t> caster;
+				return pybind11::detail::cast_ref<size_t>(std::move(o), caster);
+			}
+			return pybind11::detail::cast_safe<size_t>(std::move(o));
+		}
+		pybind11::pybind11_fail("Tried to call pure virtual function \"BasePropertyArray::size\"");
+	}
+	size_t capacity() const override {
+		pybind11::gil_scoped_acquire gil;
+		pybind11::function overload = pybind11::get_overload(static_cast<const easy3d::BasePropertyArray *>(this), "capacity");
+		if (overload) {
+			auto o = overload.operator()<pybind11::return_value_policy::reference>();
+			if (pybind11::detail::cast_is_temporary_value_reference<size_t>::value) {
+				static pybind11::detail::override_caster_t<size_t> caster;
+				return pybind11::detail::cast_ref<size_t>(std::move(o), caster);
+			}
+			return pybind11::detail::cast_safe<size_t>(std::move(o));
+		}
+		pybind11::pybind11_fail("Tried to call pure virtual function \"BasePropertyArray::capacity\"");
+	}
+	size_t memory() const override {
+		pybind11::gil_scoped_acquire gil;
+		pybind11::function overload = pybind11::get_overload(static_cast<const easy3d::BasePropertyArray *>(this), "memory");
+		if (overload) {
+			auto o = overload.operator()<pybind11::return_value_policy::reference>();
+			if (pybind11::detail::cast_is_temporary_value_reference<size_t>::value) {
+				static pybind11::detail::override_caster_t<size_t> caster;
+				return pybind11::detail::cast_ref<size_t>(std::move(o), caster);
+			}
+			return pybind11::detail::cast_safe<size_t>(std::move(o));
+		}
+		pybind11::pybind11_fail("Tried to call pure virtual function \"BasePropertyArray::memory\"");
+	}
 	void reset(size_t a0) override {
 		pybind11::gil_scoped_acquire gil;
 		pybind11::function overload = pybind11::get_overload(static_cast<const easy3d::BasePropertyArray *>(this), "reset");
@@ -301,6 +353,58 @@ struct PyCallBack_easy3d_PropertyArray_bool_t : public easy3d::PropertyArray<boo
         }
         return PropertyArray::push_back();
     }
+    void append(size_t a0) override {
+        pybind11::gil_scoped_acquire gil;
+        pybind11::function overload = pybind11::get_overload(static_cast<const easy3d::PropertyArray<bool> *>(this), "append");
+        if (overload) {
+            auto o = overload.operator()<pybind11::return_value_policy::reference>(a0);
+            if (pybind11::detail::cast_is_temporary_value_reference<void>::value) {
+                static pybind11::detail::override_caster_t<void> caster;
+                return pybind11::detail::cast_ref<void>(std::move(o), caster);
+            }
+            return pybind11::detail::cast_safe<void>(std::move(o));
+        }
+        return PropertyArray::append(a0);
+    }
+    size_t size() const override {
+        pybind11::gil_scoped_acquire gil;
+        pybind11::function overload = pybind11::get_overload(static_cast<const easy3d::PropertyArray<bool> *>(this), "size");
+        if (overload) {
+            auto o = overload.operator()<pybind11::return_value_policy::reference>();
+            if (pybind11::detail::cast_is_temporary_value_reference<size_t>::value) {
+                static pybind11::detail::override_caster_t<size_t> caster;
+                return pybind11::detail::cast_ref<size_t>(std::move(o), caster);
+            }
+            return pybind11::detail::cast_safe<size_t>(std::move(o));
+        }
+        return PropertyArray::size();
+    }
+    size_t capacity() const override {
+        pybind11::gil_scoped_acquire gil;
+        pybind11::function overload = pybind11::get_overload(static_cast<const easy3d::PropertyArray<bool> *>(this), "capacity");
+        if (overload) {
+            auto o = overload.operator()<pybind11::return_value_policy::reference>();
+            if (pybind11::detail::cast_is_temporary_value_reference<size_t>::value) {
+                static pybind11::detail::override_caster_t<size_t> caster;
+                return pybind11::detail::cast_ref<size_t>(std::move(o), caster);
+            }
+            return pybind11::detail::cast_safe<size_t>(std::move(o));
+        }
+        return PropertyArray::capacity();
+    }
+    size_t memory() const override {
+        pybind11::gil_scoped_acquire gil;
+        pybind11::function overload = pybind11::get_overload(static_cast<const easy3d::PropertyArray<bool> *>(this), "memory");
+        if (overload) {
+            auto o = overload.operator()<pybind11::return_value_policy::reference>();
+            if (pybind11::detail::cast_is_temporary_value_reference<size_t>::value) {
+                static pybind11::detail::override_caster_t<size_t> caster;
+                return pybind11::detail::cast_ref<size_t>(std::move(o), caster);
+            }
+            return pybind11::detail::cast_safe<size_t>(std::move(o));
+        }
+        return PropertyArray::memory();
+    }
     void reset(size_t a0) override {
         pybind11::gil_scoped_acquire gil;
         pybind11::function overload = pybind11::get_overload(static_cast<const easy3d::PropertyArray<bool> *>(this), "reset");
@@ -484,6 +588,58 @@ struct PyCallBack_easy3d_PropertyArray_easy3d_Vec_3_float_t : public easy3d::Pro
         }
         return PropertyArray::push_back();
     }
+    void append(size_t a0) override {
+        pybind11::gil_scoped_acquire gil;
+        pybind11::function overload = pybind11::get_overload(static_cast<const easy3d::PropertyArray<easy3d::Vec<3, float>> *>(this), "append");
+        if (overload) {
+            auto o = overload.operator()<pybind11::return_value_policy::reference>(a0);
+            if (pybind11::detail::cast_is_temporary_value_reference<void>::value) {
+                static pybind11::detail::override_caster_t<void> caster;
+                return pybind11::detail::cast_ref<void>(std::move(o), caster);
+            }
+            return pybind11::detail::cast_safe<void>(std::move(o));
+        }
+        return PropertyArray::append(a0);
+    }
+    size_t size() const override {
+        pybind11::gil_scoped_acquire gil;
+        pybind11::function overload = pybind11::get_overload(static_cast<const easy3d::PropertyArray<easy3d::Vec<3, float>> *>(this), "size");
+        if (overload) {
+            auto o = overload.operator()<pybind11::return_value_policy::reference>();
+            if (pybind11::detail::cast_is_temporary_value_reference<size_t>::value) {
+                static pybind11::detail::override_caster_t<size_t> caster;
+                return pybind11::detail::cast_ref<size_t>(std::move(o), caster);
+            }
+            return pybind11::detail::cast_safe<size_t>(std::move(o));
+        }
+        return PropertyArray::size();
+    }
+    size_t capacity() const override {
+        pybind11::gil_scoped_acquire gil;
+        pybind11::function overload = pybind11::get_overload(static_cast<const easy3d::PropertyArray<easy3d::Vec<3, float>> *>(this), "capacity");
+        if (overload) {
+            auto o = overload.operator()<pybind11::return_value_policy::reference>();
+            if (pybind11::detail::cast_is_temporary_value_reference<size_t>::value) {
+                static pybind11::detail::override_caster_t<size_t> caster;
+                return pybind11::detail::cast_ref<size_t>(std::move(o), caster);
+            }
+            return pybind11::detail::cast_safe<size_t>(std::move(o));
+        }
+        return PropertyArray::capacity();
+    }
+    size_t memory() const override {
+        pybind11::gil_scoped_acquire gil;
+        pybind11::function overload = pybind11::get_overload(static_cast<const easy3d::PropertyArray<easy3d::Vec<3, float>> *>(this), "memory");
+        if (overload) {
+            auto o = overload.operator()<pybind11::return_value_policy::reference>();
+            if (pybind11::detail::cast_is_temporary_value_reference<size_t>::value) {
+                static pybind11::detail::override_caster_t<size_t> caster;
+                return pybind11::detail::cast_ref<size_t>(std::move(o), caster);
+            }
+            return pybind11::detail::cast_safe<size_t>(std::move(o));
+        }
+        return PropertyArray::memory();
+    }
     void reset(size_t a0) override {
         pybind11::gil_scoped_acquire gil;
         pybind11::function overload = pybind11::get_overload(static_cast<const easy3d::PropertyArray<easy3d::Vec<3, float>> *>(this), "reset");
@@ -703,6 +859,8 @@ void bind_easy3d_core_property(pybind11::module_& m)
 		cl.def("resize_property_array", (void (easy3d::PropertyContainer::*)(unsigned long)) &easy3d::PropertyContainer::resize_property_array, "C++: easy3d::PropertyContainer::resize_property_array(unsigned long) --> void", pybind11::arg("n"));
 		cl.def("shrink_to_fit", (void (easy3d::PropertyContainer::*)() const) &easy3d::PropertyContainer::shrink_to_fit, "C++: easy3d::PropertyContainer::shrink_to_fit() const --> void");
 		cl.def("push_back", (void (easy3d::PropertyContainer::*)()) &easy3d::PropertyContainer::push_back, "C++: easy3d::PropertyContainer::push_back() --> void");
+		cl.def("append", (unsigned long (easy3d::PropertyContainer::*)(unsigned long)) &easy3d::PropertyContainer::append, "Adds n new elements to each vector.\n\nC++: easy3d::PropertyContainer::append(unsigned long) --> unsigned long", pybind11::arg("n"));
+		cl.def("memory", (unsigned long (easy3d::PropertyContainer::*)() const) &easy3d::PropertyContainer::memory, "Returns the memory (in bytes) allocated by all the arrays.\n\nC++: easy3d::PropertyContainer::memory() const --> unsigned long");
 		cl.def("reset", (void (easy3d::PropertyContainer::*)(unsigned long)) &easy3d::PropertyContainer::reset, "C++: easy3d::PropertyContainer::reset(unsigned long) --> void", pybind11::arg("idx"));
 		cl.def("swap", (void (easy3d::PropertyContainer::*)(size_t, size_t) const) &easy3d::PropertyContainer::swap, "C++: easy3d::PropertyContainer::swap(size_t, size_t) const --> void", pybind11::arg("i0"), pybind11::arg("i1"));
 		cl.def("swap", (void (easy3d::PropertyContainer::*)(class easy3d::PropertyContainer &)) &easy3d::PropertyContainer::swap, "C++: easy3d::PropertyContainer::swap(class easy3d::PropertyContainer &) --> void", pybind11::arg("other"));
@@ -734,6 +892,11 @@ void bind_easy3d_core_property(pybind11::module_& m)
         cl.def("resize", (void (easy3d::BasePropertyArray::*)(unsigned long)) &easy3d::BasePropertyArray::resize, "Resize storage to hold n elements.\n\nC++: easy3d::BasePropertyArray::resize(unsigned long) --> void", pybind11::arg("n"));
         cl.def("shrink_to_fit", (void (easy3d::BasePropertyArray::*)()) &easy3d::BasePropertyArray::shrink_to_fit, "Free unused memory.\n\nC++: easy3d::BasePropertyArray::shrink_to_fit() --> void");
         cl.def("push_back", (void (easy3d::BasePropertyArray::*)()) &easy3d::BasePropertyArray::push_back, "Extend the number of elements by one.\n\nC++: easy3d::BasePropertyArray::push_back() --> void");
+        cl.def("append", (void (easy3d::BasePropertyArray::*)(unsigned long)) &easy3d::BasePropertyArray::append, "Extends the number of elements by n.\n\nC++: easy3d::BasePropertyArray::append(unsigned long) --> void", pybind11::arg("n"));
+        cl.def("size", (unsigned long (easy3d::BasePropertyArray::*)() const) &easy3d::BasePropertyArray::size, "Returns the number of elements.\n\nC++: easy3d::BasePropertyArray::size() const --> unsigned long");
+        cl.def("capacity", (unsigned long (easy3d::BasePropertyArray::*)() const) &easy3d::BasePropertyArray::capacity, "Returns the number of elements the allocated storage can hold.\n\nC++: easy3d::BasePropertyArray::capacity() const --> unsigned long");
+        cl.def("memory", (unsigned long (easy3d::BasePropertyArray::*)() const) &easy3d::BasePropertyArray::memory, "Returns the size (in bytes) of the allocated storage.\n\nC++: easy3d::BasePropertyArray::memory() const --> unsigned long");
+        cl.def("reallocations", (unsigned long (easy3d::BasePropertyArray::*)() const) &easy3d::BasePropertyArray::reallocations, "Returns the number of times the storage has been (re)allocated.\n\nC++: easy3d::BasePropertyArray::reallocations() const --> unsigned long");
         cl.def("reset", (void (easy3d::BasePropertyArray::*)(unsigned long)) &easy3d::BasePropertyArray::reset, "Reset element to default value\n\nC++: easy3d::BasePropertyArray::reset(unsigned long) --> void", pybind11::arg("idx"));
         cl.def("transfer", (bool (easy3d::BasePropertyArray::*)(const class easy3d::BasePropertyArray &)) &easy3d::BasePropertyArray::transfer, "Copy the entire properties from \n\nC++: easy3d::BasePropertyArray::transfer(const class easy3d::BasePropertyArray &) --> bool", pybind11::arg("other"));
         cl.def("transfer", (bool (easy3d::BasePropertyArray::*)(const class easy3d::BasePropertyArray &, std::size_t, std::size_t)) &easy3d::BasePropertyArray::transfer, "Copy the property[from] of  to this->property[to].\n\nC++: easy3d::BasePropertyArray::transfer(const class easy3d::BasePropertyArray &, std::size_t, std::size_t) --> bool", pybind11::arg("other"), pybind11::arg("from"), pybind11::arg("to"));
@@ -758,6 +921,10 @@ void bind_easy3d_core_property(pybind11::module_& m)
         cl.def("reserve", (void (easy3d::PropertyArray<easy3d::Vec<3, float>>::*)(unsigned long)) &easy3d::PropertyArray<easy3d::Vec<3, float>>::reserve, "C++: easy3d::PropertyArray<easy3d::Vec<3, float>>::reserve(unsigned long) --> void", pybind11::arg("n"));
         cl.def("resize", (void (easy3d::PropertyArray<easy3d::Vec<3, float>>::*)(unsigned long)) &easy3d::PropertyArray<easy3d::Vec<3, float>>::resize, "C++: easy3d::PropertyArray<easy3d::Vec<3, float>>::resize(unsigned long) --> void", pybind11::arg("n"));
         cl.def("push_back", (void (easy3d::PropertyArray<easy3d::Vec<3, float>>::*)()) &easy3d::PropertyArray<easy3d::Vec<3, float>>::push_back, "C++: easy3d::PropertyArray<easy3d::Vec<3, float>>::push_back() --> void");
+        cl.def("append", (void (easy3d::PropertyArray<easy3d::Vec<3, float>>::*)(unsigned long)) &easy3d::PropertyArray<easy3d::Vec<3, float>>::append, "C++: easy3d::PropertyArray<easy3d::Vec<3, float>>::append(unsigned long) --> void", pybind11::arg("n"));
+        cl.def("size", (unsigned long (easy3d::PropertyArray<easy3d::Vec<3, float>>::*)() const) &easy3d::PropertyArray<easy3d::Vec<3, float>>::size, "C++: easy3d::PropertyArray<easy3d::Vec<3, float>>::size() const --> unsigned long");
+        cl.def("capacity", (unsigned long (easy3d::PropertyArray<easy3d::Vec<3, float>>::*)() const) &easy3d::PropertyArray<easy3d::Vec<3, float>>::capacity, "C++: easy3d::PropertyArray<easy3d::Vec<3, float>>::capacity() const --> unsigned long");
+        cl.def("memory", (unsigned long (easy3d::PropertyArray<easy3d::Vec<3, float>>::*)() const) &easy3d::PropertyArray<easy3d::Vec<3, float>>::memory, "C++: easy3d::PropertyArray<easy3d::Vec<3, float>>::memory() const --> unsigned long");
         cl.def("reset", (void (easy3d::PropertyArray<easy3d::Vec<3, float>>::*)(unsigned long)) &easy3d::PropertyArray<easy3d::Vec<3, float>>::reset, "C++: easy3d::PropertyArray<easy3d::Vec<3, float>>::reset(unsigned long) --> void", pybind11::arg("idx"));
         cl.def("transfer", (bool (easy3d::PropertyArray<easy3d::Vec<3, float>>::*)(const class easy3d::BasePropertyArray &)) &easy3d::PropertyArray<easy3d::Vec<3, float>>::transfer, "C++: easy3d::PropertyArray<easy3d::Vec<3, float>>::transfer(const class easy3d::BasePropertyArray &) --> bool", pybind11::arg("other"));
         cl.def("transfer", (bool (easy3d::PropertyArray<easy3d::Vec<3, float>>::*)(const class easy3d::BasePropertyArray &, std::size_t, std::size_t)) &easy3d::PropertyArray<easy3d::Vec<3, float>>::transfer, "C++: easy3d::PropertyArray<easy3d::Vec<3, float>>::transfer(const class easy3d::BasePropertyArray &, std::size_t, std::size_t) --> bool", pybind11::arg("other"), pybind11::arg("from"), pybind11::arg("to"));
@@ -775,6 +942,11 @@ void bind_easy3d_core_property(pybind11::module_& m)
         cl.def("resize", (void (easy3d::BasePropertyArray::*)(unsigned long)) &easy3d::BasePropertyArray::resize, "Resize storage to hold n elements.\n\nC++: easy3d::BasePropertyArray::resize(unsigned long) --> void", pybind11::arg("n"));
         cl.def("shrink_to_fit", (void (easy3d::BasePropertyArray::*)()) &easy3d::BasePropertyArray::shrink_to_fit, "Free unused memory.\n\nC++: easy3d::BasePropertyArray::shrink_to_fit() --> void");
         cl.def("push_back", (void (easy3d::BasePropertyArray::*)()) &easy3d::BasePropertyArray::push_back, "Extend the number of elements by one.\n\nC++: easy3d::BasePropertyArray::push_back() --> void");
+        cl.def("append", (void (easy3d::BasePropertyArray::*)(unsigned long)) &easy3d::BasePropertyArray::append, "Extends the number of elements by n.\n\nC++: easy3d::BasePropertyArray::append(unsigned long) --> void", pybind11::arg("n"));
+        cl.def("size", (unsigned long (easy3d::BasePropertyArray::*)() const) &easy3d::BasePropertyArray::size, "Returns the number of elements.\n\nC++: easy3d::BasePropertyArray::size() const --> unsigned long");
+        cl.def("capacity", (unsigned long (easy3d::BasePropertyArray::*)() const) &easy3d::BasePropertyArray::capacity, "Returns the number of elements the allocated storage can hold.\n\nC++: easy3d::BasePropertyArray::capacity() const --> unsigned long");
+        cl.def("memory", (unsigned long (easy3d::BasePropertyArray::*)() const) &easy3d::BasePropertyArray::memory, "Returns the size (in bytes) of the allocated storage.\n\nC++: easy3d::BasePropertyArray::memory() const --> unsigned long");
+        cl.def("reallocations", (unsigned long (easy3d::BasePropertyArray::*)() const) &easy3d::BasePropertyArray::reallocations, "Returns the number of times the storage has been (re)allocated.\n\nC++: easy3d::BasePropertyArray::reallocations() const --> unsigned long");
         cl.def("reset", (void (easy3d::BasePropertyArray::*)(unsigned long)) &easy3d::BasePropertyArray::reset, "Reset element to default value\n\nC++: easy3d::BasePropertyArray::reset(unsigned long) --> void", pybind11::arg("idx"));
         cl.def("transfer", (bool (easy3d::BasePropertyArray::*)(const class easy3d::BasePropertyArray &)) &easy3d::BasePropertyArray::transfer, "Copy the entire properties from \n\nC++: easy3d::BasePropertyArray::transfer(const class easy3d::BasePropertyArray &) --> bool", pybind11::arg("other"));
         cl.def("transfer", (bool (easy3d::BasePropertyArray::*)(const class easy3d::BasePropertyArray &, std::size_t, std::size_t)) &easy3d::BasePropertyArray::transfer, "Copy the property[from] of  to this->property[to].\n\nC++: easy3d::BasePropertyArray::transfer(const class easy3d::BasePropertyArray &, std::size_t, std::size_t) --> bool", pybind11::arg("other"), pybind11::arg("from"), pybind11::arg("to"));
@@ -799,6 +971,10 @@ void bind_easy3d_core_property(pybind11::module_& m)
         cl.def("reserve", (void (easy3d::PropertyArray<bool>::*)(unsigned long)) &easy3d::PropertyArray<bool>::reserve, "C++: easy3d::PropertyArray<bool>::reserve(unsigned long) --> void", pybind11::arg("n"));
         cl.def("resize", (void (easy3d::PropertyArray<bool>::*)(unsigned long)) &easy3d::PropertyArray<bool>::resize, "C++: easy3d::PropertyArray<bool>::resize(unsigned long) --> void", pybind11::arg("n"));
         cl.def("push_back", (void (easy3d::PropertyArray<bool>::*)()) &easy3d::PropertyArray<bool>::push_back, "C++: easy3d::PropertyArray<bool>::push_back() --> void");
+        cl.def("append", (void (easy3d::PropertyArray<bool>::*)(unsigned long)) &easy3d::PropertyArray<bool>::append, "C++: easy3d::PropertyArray<bool>::append(unsigned long) --> void", pybind11::arg("n"));
+        cl.def("size", (unsigned long (easy3d::PropertyArray<bool>::*)() const) &easy3d::PropertyArray<bool>::size, "C++: easy3d::PropertyArray<bool>::size() const --> unsigned long");
+        cl.def("capacity", (unsigned long (easy3d::PropertyArray<bool>::*)() const) &easy3d::PropertyArray<bool>::capacity, "C++: easy3d::PropertyArray<bool>::capacity() const --> unsigned long");
+        cl.def("memory", (unsigned long (easy3d::PropertyArray<bool>::*)() const) &easy3d::PropertyArray<bool>::memory, "C++: easy3d::PropertyArray<bool>::memory() const --> unsigned long");
         cl.def("reset", (void (easy3d::PropertyArray<bool>::*)(unsigned long)) &easy3d::PropertyArray<bool>::reset, "C++: easy3d::PropertyArray<bool>::reset(unsigned long) --> void", pybind11::arg("idx"));
         cl.def("transfer", (bool (easy3d::PropertyArray<bool>::*)(const class easy3d::BasePropertyArray &)) &easy3d::PropertyArray<bool>::transfer, "C++: easy3d::PropertyArray<bool>::transfer(const class easy3d::BasePropertyArray &) --> bool", pybind11::arg("other"));
         cl.def("transfer", (bool (easy3d::PropertyArray<bool>::*)(const class easy3d::BasePropertyArray &, std::size_t, std::size_t)) &easy3d::PropertyArray<bool>::transfer, "C++: easy3d::PropertyArray<bool>::transfer(const class easy3d::BasePropertyArray &, std::size_t, std::size_t) --> bool", pybind11::arg("other"), pybind11::arg("from"), pybind11::arg("to"));
@@ -815,6 +991,11 @@ void bind_easy3d_core_property(pybind11::module_& m)
         cl.def("resize", (void (easy3d::BasePropertyArray::*)(unsigned long)) &easy3d::BasePropertyArray::resize, "Resize storage to hold n elements.\n\nC++: easy3d::BasePropertyArray::resize(unsigned long) --> void", pybind11::arg("n"));
         cl.def("shrink_to_fit", (void (easy3d::BasePropertyArray::*)()) &easy3d::BasePropertyArray::shrink_to_fit, "Free unused memory.\n\nC++: easy3d::BasePropertyArray::shrink_to_fit() --> void");
         cl.def("push_back", (void (easy3d::BasePropertyArray::*)()) &easy3d::BasePropertyArray::push_back, "Extend the number of elements by one.\n\nC++: easy3d::BasePropertyArray::push_back() --> void");
+        cl.def("append", (void (easy3d::BasePropertyArray::*)(unsigned long)) &easy3d::BasePropertyArray::append, "Extends the number of elements by n.\n\nC++: easy3d::BasePropertyArray::append(unsigned long) --> void", pybind11::arg("n"));
+        cl.def("size", (unsigned long (easy3d::BasePropertyArray::*)() const) &easy3d::BasePropertyArray::size, "Returns the number of elements.\n\nC++: easy3d::BasePropertyArray::size() const --> unsigned long");
+        cl.def("capacity", (unsigned long (easy3d::BasePropertyArray::*)() const) &easy3d::BasePropertyArray::capacity, "Returns the number of elements the allocated storage can hold.\n\nC++: easy3d::BasePropertyArray::capacity() const --> unsigned long");
+        cl.def("memory", (unsigned long (easy3d::BasePropertyArray::*)() const) &easy3d::BasePropertyArray::memory, "Returns the size (in bytes) of the allocated storage.\n\nC++: easy3d::BasePropertyArray::memory() const --> unsigned long");
+        cl.def("reallocations", (unsigned long (easy3d::BasePropertyArray::*)() const) &easy3d::BasePropertyArray::reallocations, "Returns the number of times the storage has been (re)allocated.\n\nC++: easy3d::BasePropertyArray::reallocations() const --> unsigned long");
         cl.def("reset", (void (easy3d::BasePropertyArray::*)(unsigned long)) &easy3d::BasePropertyArray::reset, "Reset element to default value\n\nC++: easy3d::BasePropertyArray::reset(unsigned long) --> void", pybind11::arg("idx"));
         cl.def("transfer", (bool (easy3d::BasePropertyArray::*)(const class easy3d::BasePropertyArray &)) &easy3d::BasePropertyArray::transfer, "Copy the entire properties from \n\nC++: easy3d::BasePropertyArray::transfer(const class easy3d::BasePropertyArray &) --> bool", pybind11::arg("other"));
         cl.def("transfer", (bool (easy3d::BasePropertyArray::*)(const class easy3d::BasePropertyArray &, std::size_t, std::size_t)) &easy3d::BasePropertyArray::transfer, "Copy the property[from] of  to this->property[to].\n\nC++: easy3d::BasePropertyArray::transfer(const class easy3d::BasePropertyArray &, std::size_t, std::size_t) --> bool", pybind11::arg("other"), pybind11::arg("from"), pybind11::arg("to"));
@@ -1355,9 +1355,11 @@ void bind_easy3d_core_surface_mesh(pybind11::module_& m)
 		cl.def("position", (class easy3d::Vec<3, float> & (easy3d::SurfaceMesh::*)(struct easy3d::SurfaceMesh::Vertex)) &easy3d::SurfaceMesh::position, "position of a vertex\n\nC++: easy3d::SurfaceMesh::position(struct easy3d::SurfaceMesh::Vertex) --> class easy3d::Vec<3, float> &", pybind11::return_value_policy::automatic, pybind11::arg("v"));
 		cl.def("points", (class std::vector<class easy3d::Vec<3, float> > & (easy3d::SurfaceMesh::*)()) &easy3d::SurfaceMesh::points, "vector of vertex positions\n\nC++: easy3d::SurfaceMesh::points() --> class std::vector<class easy3d::Vec<3, float> > &", pybind11::return_value_policy::automatic);
 		cl.def("points", (const class std::vector<class easy3d::Vec<3, float> > & (easy3d::SurfaceMesh::*)() const) &easy3d::SurfaceMesh::points, "vector of vertex positions\n\nC++: easy3d::SurfaceMesh::points() --> class std::vector<class easy3d::Vec<3, float> > &", pybind11::return_value_policy::automatic);
-		cl.def("update_face_normals", (void (easy3d::SurfaceMesh::*)()) &easy3d::SurfaceMesh::update_face_normals, "compute face normals by calling compute_face_normal(Face) for each face.\n\nC++: easy3d::SurfaceMesh::update_face_normals() --> void");
+		cl.def("update_face_normals", [](easy3d::SurfaceMesh &o) -> void { return o.update_face_normals(); }, "");
+		cl.def("update_face_normals", (void (easy3d::SurfaceMesh::*)(bool)) &easy3d::SurfaceMesh::update_face_normals, "compute face normals by calling compute_face_normal(Face) for each face. If  is true, the computation is skipped if the normals are still up to date.\n\nC++: easy3d::SurfaceMesh::update_face_normals(bool) --> void", pybind11::arg("lazy"));
 		cl.def("compute_face_normal", (class easy3d::Vec<3, float> (easy3d::SurfaceMesh::*)(struct easy3d::SurfaceMesh::Face) const) &easy3d::SurfaceMesh::compute_face_normal, "compute normal vector of face  This method is robust for concave and general polygonal faces.\n\nC++: easy3d::SurfaceMesh::compute_face_normal(struct easy3d::SurfaceMesh::Face) const --> class easy3d::Vec<3, float>", pybind11::arg("f"));
-		cl.def("update_vertex_normals", (void (easy3d::SurfaceMesh::*)()) &easy3d::SurfaceMesh::update_vertex_normals, "compute vertex normals by calling compute_vertex_normal(Vertex) for each vertex.\n\nC++: easy3d::SurfaceMesh::update_vertex_normals() --> void");
+		cl.def("update_vertex_normals", [](easy3d::SurfaceMesh &o) -> void { return o.update_vertex_normals(); }, "");
+		cl.def("update_vertex_normals", (void (easy3d::SurfaceMesh::*)(bool)) &easy3d::SurfaceMesh::update_vertex_normals, "compute vertex normals by calling compute_vertex_normal(Vertex) for each vertex. If  is true, the computation is skipped if the normals are still up to date.\n\nC++: easy3d::SurfaceMesh::update_vertex_normals(bool) --> void", pybind11::arg("lazy"));
 		cl.def("compute_vertex_normal", (class easy3d::Vec<3, float> (easy3d::SurfaceMesh::*)(struct easy3d::SurfaceMesh::Vertex) const) &easy3d::SurfaceMesh::compute_vertex_normal, "compute normal vector of vertex  This is the angle-weighted average of incident face normals.\n \n\n The per-face normals much have been computed.\n\nC++: easy3d::SurfaceMesh::compute_vertex_normal(struct easy3d::SurfaceMesh::Vertex) const --> class easy3d::Vec<3, float>", pybind11::arg("v"));
 		cl.def("edge_length", (float (easy3d::SurfaceMesh::*)(struct easy3d::SurfaceMesh::Edge) const) &easy3d::SurfaceMesh::edge_length, "compute the length of edge \n\nC++: easy3d::SurfaceMesh::edge_length(struct easy3d::SurfaceMesh::Edge) const --> float", pybind11::arg("e"));
 		cl.def("edge_length", (float (easy3d::SurfaceMesh::*)(struct easy3d::SurfaceMesh::Halfedge) const) &easy3d::SurfaceMesh::edge_length, "compute the length of an edge denoted by one of its halfedge \n\nC++: easy3d::SurfaceMesh::edge_length(struct easy3d::SurfaceMesh::Halfedge) const --> float", pybind11::arg("h"));
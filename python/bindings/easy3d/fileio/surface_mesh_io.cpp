@@ -61,8 +61,9 @@ void bind_easy3d_fileio_surface_mesh_io(pybind11::module_ &m)
 		// easy3d::io::load_stl(const std::string &, class easy3d::SurfaceMesh *) file:easy3d/fileio/surface_mesh_io.h line:90
 		m.def("load_stl", (bool (*)(const std::string &, class easy3d::SurfaceMesh *)) &easy3d::io::load_stl, "Reads a surface mesh from a  format file.\n\nC++: easy3d::io::load_stl(const std::string &, class easy3d::SurfaceMesh *) --> bool", pybind11::arg("file_name"), pybind11::arg("mesh"));
 
-		// easy3d::io::save_stl(const std::string &, const class easy3d::SurfaceMesh *) file:easy3d/fileio/surface_mesh_io.h line:92
-		m.def("save_stl", (bool (*)(const std::string &, const class easy3d::SurfaceMesh *)) &easy3d::io::save_stl, "Saves a surface mesh to a  format file.\n\nC++: easy3d::io::save_stl(const std::string &, const class easy3d::SurfaceMesh *) --> bool", pybind11::arg("file_name"), pybind11::arg("mesh"));
+		// easy3d::io::save_stl(const std::string &, const class easy3d::SurfaceMesh *, bool) file:easy3d/fileio/surface_mesh_io.h line:92
+		m.def("save_stl", [](const std::string & a0, const class easy3d::SurfaceMesh * a1) -> bool { return easy3d::io::save_stl(a0, a1); }, "", pybind11::arg("file_name"), pybind11::arg("mesh"));
+		m.def("save_stl", (bool (*)(const std::string &, const class easy3d::SurfaceMesh *, bool)) &easy3d::io::save_stl, "Saves a surface mesh to a  format file (ASCII by default).\n\nC++: easy3d::io::save_stl(const std::string &, const class easy3d::SurfaceMesh *, bool) --> bool", pybind11::arg("file_name"), pybind11::arg("mesh"), pybind11::arg("binary"));
 
 		// easy3d::io::load_trilist(const std::string &, class easy3d::SurfaceMesh *) file:easy3d/fileio/surface_mesh_io.h line:96
 		m.def("load_trilist", (bool (*)(const std::string &, class easy3d::SurfaceMesh *)) &easy3d::io::load_trilist, "Reads a set of triangles (each line has coordinates of 3 points)\n Mainly used for easily saving triangles for debugging.\n\nC++: easy3d::io::load_trilist(const std::string &, class easy3d::SurfaceMesh *) --> bool", pybind11::arg("file_name"), pybind11::arg("mesh"));
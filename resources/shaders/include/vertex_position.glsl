@@ -0,0 +1,41 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+// Decodes the vertex positions, which are quantized to 16-bit integers relative to the bounding box of their chunk
+// if the drawable uses compact buffers (see Drawable::set_compact_buffers()). The including shader declares
+// "in vec4 vtx_position", whose 4th component stores the chunk index.
+
+uniform bool quantized_position = false;
+uniform vec3 quantization_offset[32];
+uniform vec3 quantization_scale[32];
+
+vec3 vertex_position() {
+    if (quantized_position) {
+        int chunk = int(vtx_position.w + 0.5);
+        return quantization_offset[chunk] + vtx_position.xyz * quantization_scale[chunk];
+    }
+    return vtx_position.xyz;
+}
@@ -45,15 +45,18 @@ uniform bool crossSectionEnabled = false;
 uniform vec4 clippingPlane0;
 uniform vec4 clippingPlane1;
 
-in  vec3 vtx_position;	// point position
+in  vec4 vtx_position;	// point position
 in  vec3 vtx_color;		// point color
 
 out vec4  vOutColor;
 out float vOutClipped;
 
+// Decodes the (possibly compact) vertex attributes. See Drawable::set_compact_buffers().
+#include ../include/vertex_position.glsl
+
 void main()
 {
-    vec4 new_position = MANIP * vec4(vtx_position, 1.0);
+    vec4 new_position = MANIP * vec4(vertex_position(), 1.0);
 
     vOutClipped = 0.0;
     if (clippingPlaneEnabled) {
@@ -26,7 +26,7 @@
 
 #version 150
 
-in  vec3 vtx_position;	// point position
+in  vec4 vtx_position;	// point position
 in  vec3 vtx_color;	// point color
 
 uniform mat4 MVP;
@@ -46,9 +46,12 @@ out Data{
     float clipped;
 } DataOut;
 
+// Decodes the (possibly compact) vertex attributes. See Drawable::set_compact_buffers().
+#include ../include/vertex_position.glsl
+
 void main()
 {
-    vec4 new_position = MANIP * vec4(vtx_position, 1.0);
+    vec4 new_position = MANIP * vec4(vertex_position(), 1.0);
 
     DataOut.clipped = 0.0;
     if (clippingPlaneEnabled) {
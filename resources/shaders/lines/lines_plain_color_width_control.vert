@@ -44,7 +44,7 @@ uniform vec4 clippingPlane1;
 uniform vec4 default_color;
 uniform bool per_vertex_color;
 
-in  vec3 vtx_position;	// point position
+in  vec4 vtx_position;	// point position
 in  vec3 vtx_color;	// point color
 
 out Data {
@@ -52,9 +52,12 @@ out Data {
     float clipped;
 } DataOut;
 
+// Decodes the (possibly compact) vertex attributes. See Drawable::set_compact_buffers().
+#include ../include/vertex_position.glsl
+
 void main()
 {
-    vec4 new_position = MANIP * vec4(vtx_position, 1.0);
+    vec4 new_position = MANIP * vec4(vertex_position(), 1.0);
 
     DataOut.clipped = 0.0;
     if (clippingPlaneEnabled) {
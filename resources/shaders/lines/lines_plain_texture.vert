@@ -30,7 +30,7 @@
 uniform mat4 MVP;
 uniform mat4 MANIP = mat4(1.0);
 
-in  vec3 vtx_position;	// point position
+in  vec4 vtx_position;	// point position
 in  vec2 vtx_texcoord;
 
 uniform bool planeClippingDiscard = false;
@@ -42,9 +42,12 @@ uniform vec4 clippingPlane1;
 out vec2  vOutTexcoord;
 out float vOutClipped;
 
+// Decodes the (possibly compact) vertex attributes. See Drawable::set_compact_buffers().
+#include ../include/vertex_position.glsl
+
 void main()
 {
-	vec4 new_position = MANIP * vec4(vtx_position, 1.0);
+	vec4 new_position = MANIP * vec4(vertex_position(), 1.0);
 
 	vOutClipped = 0.0;
 	if (clippingPlaneEnabled) {
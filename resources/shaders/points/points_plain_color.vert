@@ -26,7 +26,7 @@
 
 #version 150
 
-in  vec3 vtx_position;// point position
+in  vec4 vtx_position;// point position
 in  vec3 vtx_color;// point color
 in  vec3 vtx_normal;// point normal
 
@@ -49,11 +49,15 @@ out Data{
 } DataOut;
 
 
+// Decodes the (possibly compact) vertex attributes. See Drawable::set_compact_buffers().
+#include ../include/vertex_position.glsl
+#include ../include/vertex_normal.glsl
+
 void main(void) {
-    vec4 new_position = MANIP * vec4(vtx_position, 1.0);
+    vec4 new_position = MANIP * vec4(vertex_position(), 1.0);
 
-    DataOut.position = vtx_position;
-    DataOut.normal = NORMAL * vtx_normal;
+    DataOut.position = vertex_position();
+    DataOut.normal = NORMAL * vertex_normal();
 
     if (per_vertex_color)
         DataOut.color = vec4(vtx_color, 1.0);
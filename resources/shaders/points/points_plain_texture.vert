@@ -27,7 +27,7 @@
 #version 150
 
 
-in vec3 vtx_position;
+in vec4 vtx_position;
 in vec2 vtx_texcoord;
 in vec3 vtx_normal;
 
@@ -49,12 +49,16 @@ out Data{
 } DataOut;
 
 
+// Decodes the (possibly compact) vertex attributes. See Drawable::set_compact_buffers().
+#include ../include/vertex_position.glsl
+#include ../include/vertex_normal.glsl
+
 void main() {
-    vec4 new_position = MANIP * vec4(vtx_position, 1.0);
+    vec4 new_position = MANIP * vec4(vertex_position(), 1.0);
 
-    DataOut.position = vtx_position;
+    DataOut.position = vertex_position();
     DataOut.texcoord = vtx_texcoord;
-    DataOut.normal = NORMAL * vtx_normal;
+    DataOut.normal = NORMAL * vertex_normal();
 
     if (clippingPlaneEnabled) {
         gl_ClipDistance[0] = dot(new_position, clippingPlane0);
@@ -27,7 +27,7 @@
 #version 330 core
 
 
-in vec3  vtx_position;
+in vec4  vtx_position;
 in vec3  vtx_color;
 
 uniform vec4 default_color;
@@ -37,9 +37,12 @@ uniform mat4 MANIP = mat4(1.0);
 
 out vec4 sphere_color_in;
 
+// Decodes the (possibly compact) vertex attributes. See Drawable::set_compact_buffers().
+#include ../include/vertex_position.glsl
+
 void main()
 {
-    vec4 new_position = MANIP * vec4(vtx_position, 1.0);
+    vec4 new_position = MANIP * vec4(vertex_position(), 1.0);
 
     gl_Position = new_position;
 
@@ -29,14 +29,17 @@
 
 uniform mat4 MANIP = mat4(1.0);
 
-in vec3  vtx_position;
+in vec4  vtx_position;
 in vec2  vtx_texcoord;
 
 out vec2 texcoord;
 
+// Decodes the (possibly compact) vertex attributes. See Drawable::set_compact_buffers().
+#include ../include/vertex_position.glsl
+
 void main()
 {
-	vec4 new_position = MANIP * vec4(vtx_position, 1.0);
+	vec4 new_position = MANIP * vec4(vertex_position(), 1.0);
 
 	texcoord = vtx_texcoord;
 
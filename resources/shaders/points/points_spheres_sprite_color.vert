@@ -32,7 +32,7 @@ uniform mat4 PROJ;
 uniform mat4 MANIP = mat4(1.0);
 
 
-in vec3  vtx_position;
+in vec4  vtx_position;
 in vec3  vtx_color;
 //in float sphere_radius;
 
@@ -49,9 +49,12 @@ out Data {
 } DataOut;
 
 
+// Decodes the (possibly compact) vertex attributes. See Drawable::set_compact_buffers().
+#include ../include/vertex_position.glsl
+
 void main()
 {
-    vec4 new_position = MANIP * vec4(vtx_position, 1.0);
+    vec4 new_position = MANIP * vec4(vertex_position(), 1.0);
 
 	if (per_vertex_color)
         DataOut.sphere_color = vec4(vtx_color, 1.0);
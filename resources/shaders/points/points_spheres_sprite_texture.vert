@@ -41,7 +41,7 @@ layout(std140) uniform Matrices {
 	vec4 clippingPlane1;
 };
 
-in vec3  vtx_position;
+in vec4  vtx_position;
 in vec2  vtx_texcoord;
 //in float sphere_radius;
 
@@ -55,9 +55,12 @@ out Data{
 	//float	sphere_radius;
 } DataOut;
 
+// Decodes the (possibly compact) vertex attributes. See Drawable::set_compact_buffers().
+#include ../include/vertex_position.glsl
+
 void main()
 {
-	vec4 new_position = MANIP * vec4(vtx_position, 1.0);
+	vec4 new_position = MANIP * vec4(vertex_position(), 1.0);
 
 	DataOut.texcoord = vtx_texcoord;
 
@@ -27,7 +27,7 @@
 #version 330 core
 
 
-in  vec3 vtx_position;// point position
+in  vec4 vtx_position;// point position
 in  vec3 vtx_color;// point color
 in  vec3 vtx_normal;// point normal
 
@@ -44,9 +44,13 @@ out VertexData
 } vertexOut;
 
 
+// Decodes the (possibly compact) vertex attributes. See Drawable::set_compact_buffers().
+#include ../include/vertex_position.glsl
+#include ../include/vertex_normal.glsl
+
 void main()
 {
-    vec4 new_position = MANIP * vec4(vtx_position, 1.0);
+    vec4 new_position = MANIP * vec4(vertex_position(), 1.0);
 
     gl_Position = new_position;
 
@@ -55,5 +59,5 @@ void main()
     else
         vertexOut.color = default_color;
 
-    vertexOut.normal = NORMAL * vtx_normal;
+    vertexOut.normal = NORMAL * vertex_normal();
 }
@@ -27,7 +27,7 @@
 #version 330 core
 
 
-in  vec3 vtx_position;  // point position
+in  vec4 vtx_position;  // point position
 in  vec2 vtx_texcoord;  // texture coordinate
 in  vec3 vtx_normal;    // point normal
 
@@ -41,12 +41,16 @@ out VertexData
 } vertexOut;
 
 
+// Decodes the (possibly compact) vertex attributes. See Drawable::set_compact_buffers().
+#include ../include/vertex_position.glsl
+#include ../include/vertex_normal.glsl
+
 void main()
 {
-    vec4 new_position = MANIP * vec4(vtx_position, 1.0);
+    vec4 new_position = MANIP * vec4(vertex_position(), 1.0);
 
     gl_Position = new_position;
 
     vertexOut.texcoord = vtx_texcoord;
-    vertexOut.normal = NORMAL * vtx_normal;
+    vertexOut.normal = NORMAL * vertex_normal();
 }
@@ -27,7 +27,7 @@
 #version 430
 
 
-in  vec3		vtx_position;	// vertex position
+in  vec4		vtx_position;	// vertex position
 
 uniform mat4 MVP;
 uniform mat4 MANIP = mat4(1.0);
@@ -70,9 +70,12 @@ bool point_in_polygon(vec2 p)
 }
 
 
+// Decodes the (possibly compact) vertex attributes. See Drawable::set_compact_buffers().
+#include ../include/vertex_position.glsl
+
 void main()
 {
-	vec4 p = MVP * MANIP * vec4(vtx_position, 1.0);
+	vec4 p = MVP * MANIP * vec4(vertex_position(), 1.0);
 	float x = p.x / p.w * 0.5 + 0.5;
 	float y = p.y / p.w * 0.5 + 0.5;
 	x = x * viewport[2] + viewport[0];
@@ -28,7 +28,7 @@
 
 
 
-in vec3  vtx_position;
+in vec4  vtx_position;
 
 uniform mat4	MV;
 uniform mat4	PROJ;
@@ -40,9 +40,12 @@ uniform float	sphere_radius;
 
 out vec4	position; // in eye space
 
+// Decodes the (possibly compact) vertex attributes. See Drawable::set_compact_buffers().
+#include ../include/vertex_position.glsl
+
 void main()
 {
-	position = MV * MANIP * vec4(vtx_position, 1.0);
+	position = MV * MANIP * vec4(vertex_position(), 1.0);
 
 	// http://stackoverflow.com/questions/8608844/resizing-point-sprites-based-on-distance-from-the-camera
 	vec4 projCorner = PROJ * vec4(sphere_radius, sphere_radius, position.z, position.w);
@@ -27,12 +27,15 @@
 #version 150
 
 
-in  vec3    vtx_position;// vertex position
+in  vec4    vtx_position;// vertex position
 
 uniform mat4 MVP;
 uniform mat4 MANIP = mat4(1.0);
 
+// Decodes the (possibly compact) vertex attributes. See Drawable::set_compact_buffers().
+#include ../include/vertex_position.glsl
+
 void main()
 {
-    gl_Position = MVP * MANIP * vec4(vtx_position, 1.0);
+    gl_Position = MVP * MANIP * vec4(vertex_position(), 1.0);
 } 
\ No newline at end of file
@@ -26,7 +26,7 @@
 
 #version 150
 
-in  vec3 vtx_position;// vertex position
+in  vec4 vtx_position;// vertex position
 
 uniform mat4 MVP;
 uniform mat4 MANIP = mat4(1.0);
@@ -39,8 +39,11 @@ uniform vec4 clippingPlane1;
 
 out float clipped;
 
+// Decodes the (possibly compact) vertex attributes. See Drawable::set_compact_buffers().
+#include ../include/vertex_position.glsl
+
 void main() {
-    vec4 new_position = MANIP * vec4(vtx_position, 1.0);
+    vec4 new_position = MANIP * vec4(vertex_position(), 1.0);
 
     clipped = 0.0;
     if (clippingPlaneEnabled) {
@@ -26,7 +26,7 @@
 
 #version 150
 
-in  vec3 vtx_position;	// vertex position
+in  vec4 vtx_position;	// vertex position
 in  vec3 vtx_normal;	// vertex normal
 in  vec3 vtx_color;		// vertex color
 in  vec2 vtx_texcoord;
@@ -56,8 +56,12 @@ out Data {
 } DataOut;
 
 
+// Decodes the (possibly compact) vertex attributes. See Drawable::set_compact_buffers().
+#include ../include/vertex_position.glsl
+#include ../include/vertex_normal.glsl
+
 void main() {
-        vec4 new_position = MANIP * vec4(vtx_position, 1.0);
+        vec4 new_position = MANIP * vec4(vertex_position(), 1.0);
 
         DataOut.clipped = 0.0;
         if (clippingPlaneEnabled) {
@@ -76,7 +80,7 @@ void main() {
         else
                 DataOut.color = default_color;
 
-        DataOut.normal = NORMAL * vtx_normal;
+        DataOut.normal = NORMAL * vertex_normal();
         DataOut.position = new_position.xyz;
         DataOut.shadowCoord = SHADOW * new_position;
         DataOut.texcoord = vtx_texcoord;
@@ -26,7 +26,7 @@
 
 #version 150
 
-in vec3 vtx_position;
+in vec4 vtx_position;
 in vec3 vtx_normal;
 
 uniform mat4 MV;
@@ -48,9 +48,13 @@ out Data{
 } DataOut;
 
 
+// Decodes the (possibly compact) vertex attributes. See Drawable::set_compact_buffers().
+#include ../include/vertex_position.glsl
+#include ../include/vertex_normal.glsl
+
 void main()
 {
-    vec4 new_position = MANIP * vec4(vtx_position, 1.0);
+    vec4 new_position = MANIP * vec4(vertex_position(), 1.0);
 
     DataOut.clipped = 0.0;
     if (clippingPlaneEnabled) {
@@ -67,7 +71,7 @@ void main()
     vec4 viewPos = MV * new_position;
     DataOut.position = viewPos.xyz;
 
-    DataOut.normal = invMV * NORMAL * vtx_normal;
+    DataOut.normal = invMV * NORMAL * vertex_normal();
     
     gl_Position = PROJ * viewPos;
 }
@@ -40,9 +40,12 @@ uniform vec4 clippingPlane1;
 out vec2  texCoord;
 out float clipped;
 
+// Decodes the (possibly compact) vertex attributes. See Drawable::set_compact_buffers().
+#include ../include/vertex_position.glsl
+
 void main()
 {
-	vec4 new_position = MANIP * vtx_position;
+	vec4 new_position = MANIP * vec4(vertex_position(), 1.0);
 
 	clipped = 0.0;
 	if (clippingPlaneEnabled) {
@@ -39,9 +39,12 @@ uniform vec4 clippingPlane1;
 
 out float clipped;
 
+// Decodes the (possibly compact) vertex attributes. See Drawable::set_compact_buffers().
+#include ../include/vertex_position.glsl
+
 void main(void)
 {
-     vec4 new_position = MANIP * vtx_position;
+     vec4 new_position = MANIP * vec4(vertex_position(), 1.0);
 
      clipped = 0.0;
      if (clippingPlaneEnabled) {
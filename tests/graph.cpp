@@ -163,5 +163,28 @@ int test_graph() {
         delete graph;
     }
 
+    {   // revisions and the cache of derived data
+        Graph g;
+        const std::size_t topology = g.topology_revision();
+        auto v0 = g.add_vertex(vec3(0, 0, 0));
+        auto v1 = g.add_vertex(vec3(1, 0, 0));
+        const bool vertex_added = g.topology_revision() > topology;
+
+        auto valences = g.add_vertex_property<int>("v:valence");
+        g.mark_up_to_date("valence", &valences.array(), true);
+        const bool up_to_date = g.is_up_to_date("valence", &valences.array());
+        g.add_edge(v0, v1);
+        const bool edge_added = !g.is_up_to_date("valence", &valences.array());
+        g.mark_up_to_date("valence", &valences.array(), true);
+        g.clear();
+        const bool cleared = !g.is_up_to_date("valence", &valences.array());
+        if (!vertex_added || !up_to_date || !edge_added || !cleared ||
+            g.geometry_revision() < g.topology_revision()) {
+            std::cerr << "the revisions of the graph are not correctly maintained" << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "revisions of the graph correctly maintained" << std::endl;
+    }
+
     return EXIT_SUCCESS;
 }
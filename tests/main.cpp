@@ -32,6 +32,7 @@
 
 int test_timer();
 int test_signal();
+int test_string();
 
 int test_linear_solvers();
 int test_spline();
@@ -61,6 +62,8 @@ int test_texture_mesh(int duration);
 int test_text_rendering(int duration);
 int test_text_mesher(int duration);
 int test_animation(int duration);
+int test_batching(int duration);
+int test_instancing(int duration);
 int test_multithread();
 int test_cross_section(int duration);
 int test_ambient_occlusion(int duration);
@@ -89,6 +92,7 @@ int main(int argc, char* argv[]) {
 
     result += test_timer();
     result += test_signal();
+    result += test_string();
 
     result += test_linear_solvers();
     result += test_spline();
@@ -120,6 +124,8 @@ int main(int argc, char* argv[]) {
     result += test_text_rendering(duration);
     result += test_text_mesher(duration);
     result += test_animation(duration);
+    result += test_batching(duration);
+    result += test_instancing(duration);
     result += test_multithread();
     result += test_cross_section(duration);
     result += test_ambient_occlusion(duration);
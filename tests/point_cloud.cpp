@@ -25,8 +25,11 @@
  ********************************************************************/
 
 #include <easy3d/core/point_cloud.h>
+#include <easy3d/core/point_kernels.h>
 #include <easy3d/core/random.h>
+#include <easy3d/core/scalar_field_statistics.h>
 #include <easy3d/fileio/point_cloud_io.h>
+#include <easy3d/fileio/point_cloud_stream.h>
 #include <easy3d/util/resource.h>
 #include <easy3d/util/file_system.h>
 
@@ -67,6 +70,42 @@ int test_point_cloud() {
         
     }
 
+    //  - the statistics of a scalar field (cached until the values are modified)
+    {
+        PointCloud pcd;
+        auto values = pcd.add_vertex_property<float>("v:value");
+        for (int i = 0; i < 100000; ++i) {
+            auto v = pcd.add_vertex(vec3(0, 0, 0));
+            values[v] = random_float() * random_float() * 100.0f;  // skewed
+        }
+        std::vector<float> sorted = values.vector();
+        std::sort(sorted.begin(), sorted.end());
+
+        auto stats = ScalarFieldStatistics::get(values.array());
+        bool correct = stats->min_value() == sorted.front() && stats->max_value() == sorted.back();
+        for (float p : {0.0f, 0.01f, 0.05f, 0.5f, 0.95f, 0.99f, 1.0f}) {
+            const auto index = static_cast<std::size_t>((sorted.size() - 1) * p);
+            correct = correct && ScalarFieldStatistics::percentile(values.array(), p) == sorted[index];
+        }
+        // cached
+        correct = correct && ScalarFieldStatistics::get(values.array()) == stats;
+        // the values are modified through the vector
+        for (auto &v : values.vector())
+            v *= 2.0f;
+        auto modified = ScalarFieldStatistics::get(values.array());
+        correct = correct && modified != stats && modified->max_value() == 2.0f * sorted.back();
+        // a single value is modified through operator[] (which does not change the revision)
+        values[PointCloud::Vertex(1)] = -1.0f;
+        auto single = ScalarFieldStatistics::get(values.array());
+        correct = correct && single != modified && single->min_value() == -1.0f;
+        if (!correct) {
+            std::cerr << "incorrect statistics of the scalar field" << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "scalar field statistics: range [" << modified->min_value() << ", " << modified->max_value()
+                  << "], mean " << modified->mean() << std::endl;
+    }
+
 
     //  - load a point cloud from a file;
     //  - save a point cloud to a file.
@@ -109,7 +148,214 @@ int test_point_cloud() {
             else
                 std::cerr << "failed to delete the saved file" << std::endl;
         }
+
+        // The round trip of each format. The ASCII formats use the shortest decimal representation of the
+        // coordinates that reads back to the same float, so the points survive the round trip.
+        for (const std::string ext : {"ply", "bxyz", "xyz"}) {
+            const std::string format_file_name = "./bunny-copy." + ext;
+            const bool saved = PointCloudIO::save(format_file_name, cloud);
+            PointCloud* loaded = saved ? PointCloudIO::load(format_file_name) : nullptr;
+            file_system::delete_file(format_file_name);
+            if (!loaded) {
+                std::cerr << "failed to save/load the " << ext << " file" << std::endl;
+                return EXIT_FAILURE;
+            }
+            const bool same = loaded->n_vertices() == cloud->n_vertices() &&
+                              loaded->get_vertex_property<vec3>("v:point").vector() ==
+                              cloud->get_vertex_property<vec3>("v:point").vector();
+            delete loaded;
+            if (!same) {
+                std::cerr << "the point cloud loaded from the " << ext << " file differs from the saved one" << std::endl;
+                return EXIT_FAILURE;
+            }
+            std::cout << ext << " round trip succeeded" << std::endl;
+        }
+
+        // Convert the file chunk by chunk (a tiny chunk size here to have many chunks), and convert the result back
+        // into the BIN format. The LAS format stores the coordinates as scaled integers, so it is not lossless.
+        const std::string input_file = resource::directory() + "/data/bunny.bin";
+        for (const std::string ext : {"ply", "bxyz", "xyz", "bin", "las"}) {
+            const std::string stream_file_name = "./bunny-stream." + ext;
+            const std::string back_file_name = "./bunny-stream-back.bin";
+            const bool converted = PointCloudStream::convert(input_file, stream_file_name, 1000) &&
+                                   PointCloudStream::convert(stream_file_name, back_file_name, 999);
+            PointCloud* loaded = converted ? PointCloudIO::load(back_file_name) : nullptr;
+            file_system::delete_file(stream_file_name);
+            file_system::delete_file(back_file_name);
+            if (!loaded) {
+                std::cerr << "failed to convert the point cloud into the " << ext << " file by streaming" << std::endl;
+                return EXIT_FAILURE;
+            }
+            bool same = loaded->n_vertices() == cloud->n_vertices();
+            const float tolerance = (ext == "las") ? cloud->bounding_box().radius() * 1e-4f : 0.0f;
+            for (auto v : cloud->vertices()) {
+                if (!same)
+                    break;
+                same = distance(loaded->position(v), cloud->position(v)) <= tolerance;
+            }
+            delete loaded;
+            if (!same) {
+                std::cerr << "the point cloud converted by streaming into the " << ext << " file differs" << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+
+        // Reading past the end of the file keeps returning nullptr (with and without prefetching)
+        for (bool prefetch : {true, false}) {
+            PointCloudReader *reader = PointCloudReader::open(input_file, 10000, prefetch);
+            std::size_t count = 0;
+            while (PointCloud *chunk = reader ? reader->next() : nullptr)
+                count += chunk->n_vertices();
+            bool ended = reader && count == cloud->n_vertices();
+            for (int i = 0; i < 3 && ended; ++i)
+                ended = reader->next() == nullptr;
+            delete reader;
+            if (!ended) {
+                std::cerr << "the reader returned a chunk after the end of the file (prefetch: " << prefetch << ")"
+                          << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+
+        // A writer deleted without close() completes the file
+        for (const std::string ext : {"ply", "bin"}) {
+            const std::string file_name = "./bunny-unclosed." + ext;
+            PointCloudWriter *writer = PointCloudWriter::create(file_name);
+            const bool written = writer && writer->write(cloud);
+            delete writer;
+            PointCloud* loaded = written ? PointCloudIO::load(file_name) : nullptr;
+            file_system::delete_file(file_name);
+            const bool complete = loaded && loaded->n_vertices() == cloud->n_vertices();
+            delete loaded;
+            if (!complete) {
+                std::cerr << "the " << ext << " file written without close() is incomplete" << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+
+        delete cloud;
     }
     
+    // Adding points in bulk grows every vertex property once, instead of once per point.
+    {
+        const std::size_t num = 1 << 16;
+        std::vector<vec3> points(num);
+        for (auto &p: points)
+            p = vec3(random_float(), random_float(), random_float());
+
+        PointCloud one_by_one;
+        auto colors = one_by_one.add_vertex_property<vec3>("v:color", vec3(1, 0, 0));
+        for (const auto &p: points)
+            one_by_one.add_vertex(p);
+
+        PointCloud bulk;
+        auto bulk_colors = bulk.add_vertex_property<vec3>("v:color", vec3(1, 0, 0));
+        // in chunks, as in streaming
+        for (std::size_t first = 0; first < num; first += 1000) {
+            const std::vector<vec3> chunk(points.begin() + first, points.begin() + std::min(first + 1000, num));
+            const PointCloud::Vertex v = bulk.add_vertices(chunk);
+            if (v.idx() != static_cast<int>(first)) {
+                std::cerr << "add_vertices() returned a wrong vertex" << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+
+        if (bulk.points() != one_by_one.points() || bulk_colors.vector() != colors.vector() ||
+            bulk.n_vertices() != num || bulk.add_vertices(std::vector<vec3>()).is_valid()) {
+            std::cerr << "the points added in bulk differ from those added one by one" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        // geometric growth: a logarithmic number of allocations (instead of one per chunk)
+        const std::size_t reallocations[] = {
+                bulk.get_vertex_property<vec3>("v:point").array().reallocations(),
+                bulk.get_vertex_property<bool>("v:deleted").array().reallocations(),
+                bulk_colors.array().reallocations()
+        };
+        for (auto count : reallocations) {
+            if (count > 12) {
+                std::cerr << "a vertex property was reallocated " << count << " times" << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+        std::cout << num << " points added in chunks of 1000 (" << reallocations[0] << " reallocations)" << std::endl;
+    }
+
+    // The vectorized kernels must give the same results as the scalar code (up to rounding for the kernels using
+    // FMA). The numbers of points exercise the remainders of the SIMD loops and the parallel chunks.
+    {
+        const kernels::InstructionSet best = kernels::best_instruction_set();
+        std::cout << "point kernels: " << kernels::instruction_set_name(best) << std::endl;
+
+        mat4 m = mat4::identity();
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 4; ++c)
+                m(r, c) = random_float(-1.0f, 1.0f);
+        }
+        mat4 proj = m;
+        proj(3, 0) = 0.01f;
+        proj(3, 1) = 0.02f;
+        proj(3, 2) = 0.03f;
+        proj(3, 3) = 20.0f;
+        const Plane3 plane(vec3(1, 2, 3), normalize(vec3(1, -1, 2)));
+
+        for (std::size_t n : {0, 1, 3, 7, 8, 13, 17, 31, 1000003}) {
+            std::vector<vec3> points(n);
+            for (auto &p: points)
+                p = vec3(random_float(-10, 10), random_float(-10, 10), random_float(-10, 10));
+            if (n > 5)
+                points[5] = vec3(0, 0, 0);    // a zero vector for normalize()
+
+            std::vector<vec3> translated[2], transformed[2], normalized[2];
+            std::vector<vec2> projected[2];
+            std::vector<float> distances[2];
+            Box3 box[2];
+            for (int k = 0; k < 2; ++k) {
+                kernels::set_instruction_set(k == 0 ? kernels::SCALAR : best);
+                box[k] = kernels::bounding_box(points);
+                translated[k] = points;
+                kernels::translate(translated[k], vec3(1.5f, -2.0f, 0.25f));
+                transformed[k] = points;
+                kernels::transform(transformed[k], m);
+                normalized[k] = points;
+                kernels::normalize(normalized[k]);
+                kernels::project(points, proj, projected[k]);
+                kernels::distance_to_plane(points, plane, distances[k]);
+            }
+
+            const kernels::SoAPoints soa(points);
+            std::vector<float> soa_distances;
+            kernels::distance_to_plane(soa, plane, soa_distances);
+            const Box3 soa_box = kernels::bounding_box(soa);
+            std::vector<vec3> stored(soa.size());
+            soa.store(stored.data());
+
+            bool same = (n == 0 ? !box[0].is_valid() && !box[1].is_valid() && !soa_box.is_valid()
+                                : box[0].min_point() == box[1].min_point() && box[0].max_point() == box[1].max_point() &&
+                                  soa_box.min_point() == box[0].min_point() && soa_box.max_point() == box[0].max_point())
+                        && translated[0] == translated[1] && normalized[0] == normalized[1] && stored == points;
+            for (std::size_t i = 0; same && i < n; ++i) {
+                same = distance(transformed[0][i], transformed[1][i]) < 1e-4f &&
+                       distance(projected[0][i], projected[1][i]) < 1e-5f &&
+                       std::abs(distances[0][i] - distances[1][i]) < 1e-4f &&
+                       std::abs(soa_distances[i] - distances[0][i]) < 1e-4f;
+            }
+            if (n == 0)
+                same = same && projected[1].empty() && distances[1].empty();
+            else {
+                const vec3 &p = points[n - 1];
+                const vec4 q = m * vec4(p.x, p.y, p.z, 1.0f);
+                same = same && distance(transformed[0][n - 1], vec3(q.x, q.y, q.z)) < 1e-4f &&
+                       std::abs(distances[0][n - 1] - plane.value(p)) < 1e-4f;
+            }
+            if (!same) {
+                std::cerr << "the point kernels (" << kernels::instruction_set_name(best)
+                          << ") give different results for " << n << " points" << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+        kernels::set_instruction_set(best);
+    }
+
     return EXIT_SUCCESS;
 }
@@ -32,8 +32,16 @@
 #include <easy3d/algo/delaunay_2d.h>
 #include <easy3d/algo/delaunay_3d.h>
 #include <easy3d/algo/point_cloud_simplification.h>
+#include <easy3d/algo/point_transform.h>
+#include <easy3d/algo/gaussian_noise.h>
+#include <easy3d/core/random.h>
 #include <easy3d/fileio/point_cloud_io.h>
 #include <easy3d/util/resource.h>
+#include <easy3d/util/thread_pool.h>
+
+#include <random>
+#include <limits>
+#include <cmath>
 
 
 using namespace easy3d;
@@ -50,6 +58,76 @@ bool test_algo_point_cloud_normal_estimation() {
 
     std::cout << "estimating point cloud normals..." << std::endl;
     if (algo.estimate(cloud, 16)) {
+        // The points arrive in batches, and the incremental estimation must give the same normals.
+        std::cout << "estimating point cloud normals incrementally..." << std::endl;
+        const auto &points = cloud->points();
+        const auto &normals = cloud->get_vertex_property<vec3>("v:normal").vector();
+        PointCloud growing;
+        IncrementalPointCloudNormals incremental(&growing, 16);
+        const std::size_t batch_size = 1000;
+        std::size_t updated = 0;
+        for (std::size_t first = 0; first < points.size(); first += batch_size) {
+            const std::size_t last = std::min(first + batch_size, points.size());
+            growing.add_vertices(std::vector<vec3>(points.begin() + first, points.begin() + last));
+            const auto &stats = incremental.update();
+            if (stats.new_points != last - first) {
+                std::cerr << "wrong number of new points: " << stats.new_points << std::endl;
+                delete cloud;
+                return false;
+            }
+            updated += stats.updated_points;
+        }
+
+        const auto &incremental_normals = growing.get_vertex_property<vec3>("v:normal").vector();
+        std::size_t different = 0;
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            if (std::abs(dot(incremental_normals[i], normals[i])) < 0.999f)
+                ++different;
+        }
+        std::cout << points.size() << " points in batches of " << batch_size << ": " << updated
+                  << " normals updated, " << different << " different" << std::endl;
+        // ties of the k-th neighbors (e.g., duplicated points) may give different neighborhoods
+        if (different > points.size() / 1000) {
+            std::cerr << "the incremental normal estimation differs from the estimation of the whole point cloud"
+                      << std::endl;
+            delete cloud;
+            return false;
+        }
+
+        // A strip growing by identical (wavy) patches: the cost of a batch (i.e., the number of the updated points
+        // and of the visited cells) must not grow with the point cloud.
+        PointCloud strip;
+        IncrementalPointCloudNormals strip_normals(&strip, 16, false, 0.04f);
+        std::size_t min_updated = std::numeric_limits<std::size_t>::max(), max_updated = 0;
+        std::size_t min_visited = std::numeric_limits<std::size_t>::max(), max_visited = 0;
+        for (int patch = 0; patch < 20; ++patch) {
+            std::vector<vec3> patch_points;
+            for (int i = 0; i < 40; ++i) {
+                for (int j = 0; j < 25; ++j) {
+                    const float x = static_cast<float>(patch * 40 + i) * 0.01f;
+                    const float y = static_cast<float>(j) * 0.01f;
+                    const float z = 0.05f * std::sin(static_cast<float>(i) * 2.0f * static_cast<float>(M_PI) / 40.0f);
+                    patch_points.emplace_back(x, y, z);
+                }
+            }
+            strip.add_vertices(patch_points);
+            const auto &stats = strip_normals.update();
+            if (patch < 2) // the first batches visit all the cells
+                continue;
+            min_updated = std::min(min_updated, stats.updated_points);
+            max_updated = std::max(max_updated, stats.updated_points);
+            min_visited = std::min(min_visited, stats.visited_cells);
+            max_visited = std::max(max_visited, stats.visited_cells);
+        }
+        std::cout << strip.n_vertices() << " points in a strip: " << min_updated << "-" << max_updated
+                  << " normals updated and " << min_visited << "-" << max_visited << " cells visited per batch"
+                  << std::endl;
+        if (min_updated == 0 || max_updated > min_updated * 3 / 2 || max_visited > min_visited * 3 / 2) {
+            std::cerr << "the cost of a batch grows with the point cloud" << std::endl;
+            delete cloud;
+            return false;
+        }
+
         std::cout << "reorienting point cloud normals..." << std::endl;
         if (algo.reorient(cloud, 16)) {
             delete cloud;
@@ -114,12 +192,25 @@ bool test_algo_point_cloud_poisson_reconstruction() {
     algo.set_depth(depth);
     std::cout << "Poisson surface reconstruction (depth = " << depth << ")..." << std::endl;
     Model *surface = algo.apply(cloud);
-    delete cloud;
+    if (!surface) {
+        delete cloud;
+        return false;
+    }
+    delete surface;
 
-    if (surface)
-        return true;
+    algo.set_depth(depth - 1);
+    algo.set_tiles(2);
+    std::cout << "tiled Poisson surface reconstruction (depth = " << depth - 1 << ", 2 tiles)..." << std::endl;
+    surface = algo.apply(cloud);
+    delete cloud;
+    if (!surface)
+        return false;
+    delete surface;
 
-    return false;
+    const PoissonReconstruction::Profile &profile = algo.profile();
+    std::cout << "\toctree: " << profile.octree << "s, solve: " << profile.solve << "s, extraction: "
+              << profile.extraction << "s, stitching: " << profile.stitching << "s" << std::endl;
+    return true;
 }
 
 
@@ -166,6 +257,122 @@ bool test_algo_point_cloud_delaunay_triangulation_3D() {
 }
 
 
+bool test_algo_point_cloud_delaunay_point_location() {
+    const std::string file = resource::directory() + "/data/bunny.bin";
+    PointCloud *cloud = PointCloudIO::load(file);
+    if (!cloud) {
+        std::cerr << "Error: failed to load model. Please make sure the file exists and format is correct." << std::endl;
+        return false;
+    }
+
+    const std::vector<vec3>& points = cloud->points();
+    std::vector<vec2> points_2d;
+    for (std::size_t i = 0; i < points.size(); ++i)
+        points_2d.push_back(vec2(points[i]));
+
+    // query points scattered over (and a bit beyond) the bounding box
+    const Box3& box = cloud->bounding_box();
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> uniform(-0.1f, 1.1f);
+    std::vector<vec3> queries(200);
+    for (auto& q : queries) {
+        for (int d = 0; d < 3; ++d)
+            q[d] = box.min_coord(d) + uniform(rng) * box.range(d);
+    }
+    std::vector<vec2> queries_2d;
+    for (const auto& q : queries)
+        queries_2d.push_back(vec2(q));
+
+    auto orient_2d = [](const vec2& a, const vec2& b, const vec2& c) -> double {
+        return (double(b.x) - a.x) * (double(c.y) - a.y) - (double(b.y) - a.y) * (double(c.x) - a.x);
+    };
+    auto orient_3d = [](const vec3& a, const vec3& b, const vec3& c, const vec3& d) -> double {
+        return dot(dvec3(b - a), cross(dvec3(c - a), dvec3(d - a)));
+    };
+
+    std::cout << "Delaunay 2D: nearest vertex and point location..." << std::endl;
+    Delaunay2 delaunay_2d;
+    delaunay_2d.set_vertices(points_2d);
+    auto in_triangle = [&](int t, const vec2& p) -> bool {
+        const vec2& a = delaunay_2d.vertex(delaunay_2d.tri_vertex(t, 0));
+        const vec2& b = delaunay_2d.vertex(delaunay_2d.tri_vertex(t, 1));
+        const vec2& c = delaunay_2d.vertex(delaunay_2d.tri_vertex(t, 2));
+        const double s0 = orient_2d(a, b, p), s1 = orient_2d(b, c, p), s2 = orient_2d(c, a, p);
+        return (s0 >= 0 && s1 >= 0 && s2 >= 0) || (s0 <= 0 && s1 <= 0 && s2 <= 0);
+    };
+
+    std::vector<unsigned int> nearest;
+    delaunay_2d.nearest_vertices(queries_2d, nearest);
+    std::vector<int> located;
+    delaunay_2d.locate(queries_2d, located);
+    for (std::size_t i = 0; i < queries_2d.size(); ++i) {
+        const vec2& q = queries_2d[i];
+        float min_dist = distance2(q, delaunay_2d.vertex(0));
+        for (unsigned int v = 1; v < delaunay_2d.nb_vertices(); ++v)
+            min_dist = std::min(min_dist, distance2(q, delaunay_2d.vertex(v)));
+        if (distance2(q, delaunay_2d.vertex(nearest[i])) > min_dist) {
+            std::cerr << "wrong nearest vertex for query point " << i << std::endl;
+            return false;
+        }
+
+        int brute = -1;
+        for (unsigned int t = 0; t < delaunay_2d.nb_triangles() && brute < 0; ++t) {
+            if (in_triangle(static_cast<int>(t), q))
+                brute = static_cast<int>(t);
+        }
+        const int t = delaunay_2d.locate(q);
+        if (t != located[i] || (t < 0) != (brute < 0) || (t >= 0 && !in_triangle(t, q))) {
+            std::cerr << "wrong triangle for query point " << i << std::endl;
+            return false;
+        }
+    }
+
+    std::cout << "Delaunay 3D: nearest vertex and point location..." << std::endl;
+    Delaunay3 delaunay_3d;
+    delaunay_3d.set_vertices(points);
+    auto in_tet = [&](int t, const vec3& p) -> bool {
+        const vec3& a = delaunay_3d.vertex(delaunay_3d.tet_vertex(t, 0));
+        const vec3& b = delaunay_3d.vertex(delaunay_3d.tet_vertex(t, 1));
+        const vec3& c = delaunay_3d.vertex(delaunay_3d.tet_vertex(t, 2));
+        const vec3& d = delaunay_3d.vertex(delaunay_3d.tet_vertex(t, 3));
+        const double s = orient_3d(a, b, c, d);
+        const double s0 = orient_3d(p, b, c, d), s1 = orient_3d(a, p, c, d);
+        const double s2 = orient_3d(a, b, p, d), s3 = orient_3d(a, b, c, p);
+        if (s > 0)
+            return s0 >= 0 && s1 >= 0 && s2 >= 0 && s3 >= 0;
+        else
+            return s0 <= 0 && s1 <= 0 && s2 <= 0 && s3 <= 0;
+    };
+
+    delaunay_3d.nearest_vertices(queries, nearest);
+    delaunay_3d.locate(queries, located);
+    for (std::size_t i = 0; i < queries.size(); ++i) {
+        const vec3& q = queries[i];
+        float min_dist = distance2(q, delaunay_3d.vertex(0));
+        for (unsigned int v = 1; v < delaunay_3d.nb_vertices(); ++v)
+            min_dist = std::min(min_dist, distance2(q, delaunay_3d.vertex(v)));
+        if (distance2(q, delaunay_3d.vertex(nearest[i])) > min_dist) {
+            std::cerr << "wrong nearest vertex for query point " << i << std::endl;
+            return false;
+        }
+
+        int brute = -1;
+        for (unsigned int t = 0; t < delaunay_3d.nb_tets() && brute < 0; ++t) {
+            if (in_tet(static_cast<int>(t), q))
+                brute = static_cast<int>(t);
+        }
+        const int t = delaunay_3d.locate(q);
+        if (t != located[i] || (t < 0) != (brute < 0) || (t >= 0 && !in_tet(t, q))) {
+            std::cerr << "wrong tetrahedron for query point " << i << std::endl;
+            return false;
+        }
+    }
+
+    delete cloud;
+    return true;
+}
+
+
 bool test_algo_point_cloud_downsampling() {
     const std::string file = resource::directory() + "/data/bunny.bin";
     PointCloud *cloud = PointCloudIO::load(file);
@@ -185,6 +392,25 @@ bool test_algo_point_cloud_downsampling() {
             pcd.delete_vertex(PointCloud::Vertex(id));
         pcd.collect_garbage();
         std::cout << " " << total_num << " -> " << pcd.n_vertices() << std::endl;
+
+        // the same simplification, chunk by chunk
+        std::cout << "streaming grid downsampling using distance threshold " << threshold << "...";
+        StreamingGridSimplification grid(threshold);
+        const auto &points = cloud->points();
+        std::size_t num_kept = 0;
+        for (std::size_t first = 0; first < points.size(); first += 1000) {
+            PointCloud chunk;
+            for (std::size_t i = first; i < std::min(first + 1000, points.size()); ++i)
+                chunk.add_vertex(points[i]);
+            grid.apply(&chunk);
+            num_kept += chunk.n_vertices();
+        }
+        std::cout << " " << total_num << " -> " << num_kept << std::endl;
+        if (num_kept != pcd.n_vertices() || grid.num_cells() != num_kept) {
+            std::cerr << "streaming grid downsampling differs from grid downsampling" << std::endl;
+            delete cloud;
+            return false;
+        }
     }
 
     std::cout << "uniform downsampling using distance threshold " << threshold << "...";
@@ -213,10 +439,89 @@ bool test_algo_point_cloud_downsampling() {
 }
 
 
+bool test_algo_point_cloud_transformation() {
+    // the known answer of Philox4x32-10 (from the Random123 library)
+    const CounterRandom::Block block = CounterRandom(0)(0);
+    if (block[0] != 0x6627e8d5u || block[1] != 0xe169c58du || block[2] != 0xbc57ac4cu || block[3] != 0x9b00dbd8u) {
+        std::cerr << "unexpected random numbers from CounterRandom" << std::endl;
+        return false;
+    }
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+    PointCloud cloud;
+    auto normal = cloud.add_vertex_property<vec3>("v:normal");
+    for (int i = 0; i < 200000; ++i) {
+        auto v = cloud.add_vertex(vec3(distribution(generator), distribution(generator), distribution(generator)));
+        normal[v] = normalize(vec3(distribution(generator), distribution(generator), distribution(generator)));
+    }
+
+    std::cout << "transforming points and normals..." << std::endl;
+    {
+        const mat4 m = mat4::translation(1.0f, -2.0f, 3.0f) * mat4::rotation(normalize(vec3(1, 2, 3)), 0.7f) *
+                       mat4::scale(2.0f, 0.5f, 1.0f, 1.0f);
+        const mat3 N = transpose(inverse(mat3(m)));
+        PointCloud result = cloud;
+        PointTransform::apply(&result, m);
+        const auto &points = result.points();
+        const auto &normals = result.get_vertex_property<vec3>("v:normal").vector();
+        for (auto v : cloud.vertices()) {
+            const vec3 p = m * cloud.position(v);
+            const vec3 n = normalize(N * normal[v]);
+            if (distance(p, points[v.idx()]) > 1e-4f || dot(n, normals[v.idx()]) < 0.99999f) {
+                std::cerr << "point/normal " << v << " transformed incorrectly" << std::endl;
+                return false;
+            }
+        }
+    }
+
+    std::cout << "adding Gaussian noise with 1 and 4 threads..." << std::endl;
+    {
+        const float sigma = 0.01f;
+        const uint64_t seed = 12345;
+        PointCloud single = cloud;
+        ThreadPool::initialize(1);
+        PointTransform::add_noise(&single, sigma, seed);
+        PointCloud multiple = cloud;
+        ThreadPool::initialize(4);
+        PointTransform::add_noise(&multiple, sigma, seed);
+        ThreadPool::initialize();
+        if (single.points() != multiple.points()) {
+            std::cerr << "the noise depends on the number of threads" << std::endl;
+            return false;
+        }
+
+        PointCloud noisy = cloud;
+        GaussianNoise::apply(&noisy, sigma, seed);
+        if (noisy.points() != single.points()) {
+            std::cerr << "GaussianNoise differs from PointTransform::add_noise() with the same seed" << std::endl;
+            return false;
+        }
+
+        // the squared offsets should average to sigma^2
+        double sum = 0.0;
+        for (auto v : cloud.vertices())
+            sum += distance2(cloud.position(v), noisy.position(v));
+        const double variance = sum / static_cast<double>(cloud.n_vertices());
+        std::cout << "    standard deviation of the noise: " << std::sqrt(variance) << " (sigma: " << sigma << ")"
+                  << std::endl;
+        if (std::abs(std::sqrt(variance) - sigma) > 0.02 * sigma) {
+            std::cerr << "the noise does not follow the normal distribution" << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
 int test_point_cloud_algorithms() {
     if (!test_algo_point_cloud_normal_estimation())
         return EXIT_FAILURE;
 
+    if (!test_algo_point_cloud_transformation())
+        return EXIT_FAILURE;
+
     if (!test_algo_point_cloud_plane_extraction())
         return EXIT_FAILURE;
 
@@ -229,6 +534,9 @@ int test_point_cloud_algorithms() {
     if (!test_algo_point_cloud_delaunay_triangulation_3D())
         return EXIT_FAILURE;
 
+    if (!test_algo_point_cloud_delaunay_point_location())
+        return EXIT_FAILURE;
+
     if (!test_algo_point_cloud_downsampling())
         return EXIT_FAILURE;
 
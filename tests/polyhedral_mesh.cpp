@@ -26,8 +26,10 @@
 
 #include <easy3d/core/poly_mesh.h>
 #include <easy3d/fileio/poly_mesh_io.h>
+#include <easy3d/fileio/binary_container.h>
 #include <easy3d/util/resource.h>
 #include <easy3d/util/file_system.h>
+#include <easy3d/util/stop_watch.h>
 
 
 using namespace easy3d;
@@ -305,10 +307,166 @@ int test_polyhedral_mesh() {
         else
             std::cerr << "failed to delete the saved file" << std::endl;
 
+        // A binary container stores all the properties including the connectivity.
+        const std::string container_file_name = "./sphere-copy.e3d";
+        PolyMesh copy;
+        if (!BinaryContainer::save(container_file_name, mesh) || !BinaryContainer::load(container_file_name, &copy)) {
+            std::cerr << "failed to save/load the binary container" << std::endl;
+            return EXIT_FAILURE;
+        }
+        file_system::delete_file(container_file_name);
+        bool identical = copy.n_vertices() == mesh->n_vertices() && copy.n_edges() == mesh->n_edges() &&
+                         copy.n_faces() == mesh->n_faces() && copy.n_cells() == mesh->n_cells();
+        for (auto c : mesh->cells())
+            identical = identical && copy.vertices(c) == mesh->vertices(c) && copy.halffaces(c) == mesh->halffaces(c);
+        for (auto h : mesh->halffaces())
+            identical = identical && copy.vertices(h) == mesh->vertices(h) && copy.opposite(h) == mesh->opposite(h);
+        if (!identical) {
+            std::cerr << "the mesh loaded from the binary container differs from the saved one" << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "binary container round trip succeeded" << std::endl;
+
+        // the loader adds all cells at once, which must be the same as adding the faces and cells one by one
+        PolyMesh one_by_one;
+        for (auto v : mesh->vertices())
+            one_by_one.add_vertex(mesh->position(v));
+        for (auto c : mesh->cells()) {
+            std::vector<PolyMesh::HalfFace> faces;
+            for (auto h : mesh->halffaces(c))
+                faces.push_back(one_by_one.add_face(mesh->vertices(h)));
+            one_by_one.add_cell(faces);
+        }
+        identical = one_by_one.n_edges() == mesh->n_edges() && one_by_one.n_faces() == mesh->n_faces() &&
+                    one_by_one.n_cells() == mesh->n_cells();
+        for (auto c : mesh->cells())
+            identical = identical && one_by_one.halffaces(c) == mesh->halffaces(c) &&
+                        one_by_one.edges(c) == mesh->edges(c);
+        for (auto v : mesh->vertices())
+            identical = identical && one_by_one.halffaces(v) == mesh->halffaces(v) &&
+                        one_by_one.vertices(v) == mesh->vertices(v);
+        if (!identical) {
+            std::cerr << "the mesh loaded in a single pass differs from the one built face by face" << std::endl;
+            return EXIT_FAILURE;
+        }
+
         // delete the mesh (i.e., release memory)
         delete mesh;
     }
 
+    // build a tetrahedral mesh both tetrahedron by tetrahedron and in a single pass, and compare the results
+    {
+        // a regular grid of cubes, each split into 6 tetrahedra sharing the cube diagonal (0, 6)
+        const int n = 20;
+        const int cube_tetra[6][4] = {{0, 1, 2, 6}, {0, 2, 3, 6}, {0, 3, 7, 6}, {0, 7, 4, 6}, {0, 4, 5, 6}, {0, 5, 1, 6}};
+        auto id = [n](int i, int j, int k) { return static_cast<unsigned int>((k * (n + 1) + j) * (n + 1) + i); };
+        std::vector<unsigned int> indices;
+        for (int k = 0; k < n; ++k) {
+            for (int j = 0; j < n; ++j) {
+                for (int i = 0; i < n; ++i) {
+                    const unsigned int corners[8] = {
+                            id(i, j, k), id(i + 1, j, k), id(i + 1, j + 1, k), id(i, j + 1, k),
+                            id(i, j, k + 1), id(i + 1, j, k + 1), id(i + 1, j + 1, k + 1), id(i, j + 1, k + 1)
+                    };
+                    for (const auto& t : cube_tetra) {
+                        for (int c : t)
+                            indices.push_back(corners[c]);
+                    }
+                }
+            }
+        }
+
+        PolyMesh one_by_one, bulk;
+        for (int k = 0; k <= n; ++k) {
+            for (int j = 0; j <= n; ++j) {
+                for (int i = 0; i <= n; ++i) {
+                    one_by_one.add_vertex(vec3(i, j, k));
+                    bulk.add_vertex(vec3(i, j, k));
+                }
+            }
+        }
+
+        StopWatch w;
+        for (std::size_t i = 0; i < indices.size(); i += 4) {
+            one_by_one.add_tetra(PolyMesh::Vertex(indices[i]), PolyMesh::Vertex(indices[i + 1]),
+                                 PolyMesh::Vertex(indices[i + 2]), PolyMesh::Vertex(indices[i + 3]));
+        }
+        const double one_by_one_time = w.elapsed_seconds(6);
+
+        w.restart();
+        if (bulk.add_tetras(indices) != indices.size() / 4) {
+            std::cerr << "failed to add the tetrahedra in a single pass" << std::endl;
+            return EXIT_FAILURE;
+        }
+        const double bulk_time = w.elapsed_seconds(6);
+
+        bool identical = one_by_one.n_vertices() == bulk.n_vertices() && one_by_one.n_edges() == bulk.n_edges() &&
+                         one_by_one.n_faces() == bulk.n_faces() && one_by_one.n_cells() == bulk.n_cells();
+        std::size_t memory = 0; // the memory (in bytes) of the incidence lists
+        for (auto v : bulk.vertices()) {
+            identical = identical && one_by_one.vertices(v) == bulk.vertices(v) &&
+                        one_by_one.edges(v) == bulk.edges(v) && one_by_one.halffaces(v) == bulk.halffaces(v) &&
+                        one_by_one.cells(v) == bulk.cells(v);
+            memory += (bulk.vertices(v).capacity() + bulk.edges(v).capacity() + bulk.halffaces(v).capacity() +
+                       bulk.cells(v).capacity()) * sizeof(int);
+        }
+        for (auto e : bulk.edges()) {
+            identical = identical && one_by_one.vertex(e, 0) == bulk.vertex(e, 0) &&
+                        one_by_one.vertex(e, 1) == bulk.vertex(e, 1) &&
+                        one_by_one.halffaces(e) == bulk.halffaces(e) && one_by_one.cells(e) == bulk.cells(e);
+            memory += (2 + bulk.halffaces(e).capacity() + bulk.cells(e).capacity()) * sizeof(int);
+        }
+        for (auto h : bulk.halffaces()) {
+            identical = identical && one_by_one.vertices(h) == bulk.vertices(h) &&
+                        one_by_one.edges(h) == bulk.edges(h) && one_by_one.cell(h) == bulk.cell(h) &&
+                        one_by_one.opposite(h) == bulk.opposite(h);
+            memory += (bulk.vertices(h).capacity() + bulk.edges(h).capacity() + 2) * sizeof(int);
+        }
+        for (auto c : bulk.cells()) {
+            identical = identical && one_by_one.vertices(c) == bulk.vertices(c) &&
+                        one_by_one.edges(c) == bulk.edges(c) && one_by_one.halffaces(c) == bulk.halffaces(c);
+            memory += (bulk.vertices(c).capacity() + bulk.edges(c).capacity() + bulk.halffaces(c).capacity()) *
+                      sizeof(int);
+        }
+        if (!identical || !bulk.is_tetraheral_mesh()) {
+            std::cerr << "the tetrahedra added in a single pass differ from the ones added one by one" << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << bulk.n_cells() << " tetrahedra added one by one in " << one_by_one_time << " seconds and in a "
+                  << "single pass in " << bulk_time << " seconds. The incidence lists take "
+                  << memory / (1024.0 * 1024.0) << " MB" << std::endl;
+    }
+
+    {   // revisions and the cache of derived data
+        PolyMesh m;
+        const std::size_t topology = m.topology_revision();
+        auto v0 = m.add_vertex(vec3(0, 0, 0));
+        auto v1 = m.add_vertex(vec3(1, 0, 0));
+        auto v2 = m.add_vertex(vec3(0, 1, 0));
+        auto v3 = m.add_vertex(vec3(0, 0, 1));
+        m.add_vertex(vec3(1, 1, 1));
+        const bool vertex_added = m.topology_revision() > topology;
+
+        auto volumes = m.add_cell_property<float>("c:volume");
+        m.mark_up_to_date("volume", &volumes.array());
+        const bool up_to_date = m.is_up_to_date("volume", &volumes.array());
+        m.add_tetra(v0, v1, v2, v3);
+        const bool cell_added = !m.is_up_to_date("volume", &volumes.array());
+        m.mark_up_to_date("volume", &volumes.array());
+        const std::vector<unsigned int> indices = {1, 2, 3, 4};
+        m.add_tetras(indices);
+        const bool cells_added_in_bulk = !m.is_up_to_date("volume", &volumes.array());
+        m.mark_up_to_date("volume", &volumes.array());
+        m.clear();
+        const bool cleared = !m.is_up_to_date("volume", &volumes.array());
+        if (!vertex_added || !up_to_date || !cell_added || !cells_added_in_bulk || !cleared ||
+            m.geometry_revision() < m.topology_revision()) {
+            std::cerr << "the revisions of the polyhedral mesh are not correctly maintained" << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "revisions of the polyhedral mesh correctly maintained" << std::endl;
+    }
+
     return EXIT_SUCCESS;
 }
 
@@ -27,6 +27,7 @@
 #include <easy3d/core/surface_mesh.h>
 #include <easy3d/core/surface_mesh_builder.h>
 #include <easy3d/fileio/surface_mesh_io.h>
+#include <easy3d/fileio/binary_container.h>
 #include <easy3d/util/resource.h>
 #include <easy3d/util/file_system.h>
 
@@ -315,6 +316,158 @@ int test_surface_mesh() {
             std::cout << "the saved file has been deleted"  << std::endl;
         else
             std::cerr << "failed to delete the saved file" << std::endl;
+
+        // A binary container stores all the properties (whatever the type and name) and can be compressed.
+        auto quality = mesh->add_vertex_property<float>("v:quality", 0.5f);
+        for (auto v : mesh->vertices())
+            quality[v] = static_cast<float>(v.idx()) * 0.1f;
+        auto selected = mesh->add_face_property<bool>("f:selected");
+        for (auto f : mesh->faces())
+            selected[f] = (f.idx() % 3 == 0);
+        mesh->add_model_property<std::string>("author")[0] = "easy3d";
+        auto rotation = mesh->add_face_property<quat>("f:rotation", quat(0, 0, 1, 0));
+        for (auto f : mesh->faces())
+            rotation[f] = quat(vec3(0, 0, 1), static_cast<float>(f.idx()) * 0.01f);
+
+        const std::string container_file_name = "./sphere-copy.e3d";
+        const std::size_t quality_revision = quality.array().revision();
+        if (!BinaryContainer::save(container_file_name, mesh, BinaryContainer::COMPRESSION_LZ4)) {
+            std::cerr << "failed to save the binary container" << std::endl;
+            return EXIT_FAILURE;
+        }
+        // saving does not modify the properties (so the data derived from them remains valid)
+        if (quality.array().revision() != quality_revision) {
+            std::cerr << "saving the binary container modified the revision of the properties" << std::endl;
+            return EXIT_FAILURE;
+        }
+        SurfaceMesh* copy = SurfaceMeshIO::load(container_file_name);
+        file_system::delete_file(container_file_name);
+        if (!copy) {
+            std::cerr << "failed to load the binary container" << std::endl;
+            return EXIT_FAILURE;
+        }
+        auto copy_quality = copy->get_vertex_property<float>("v:quality");
+        auto copy_selected = copy->get_face_property<bool>("f:selected");
+        auto copy_author = copy->get_model_property<std::string>("author");
+        auto copy_rotation = copy->get_face_property<quat>("f:rotation");
+        bool identical = copy->n_vertices() == mesh->n_vertices() && copy->n_halfedges() == mesh->n_halfedges() &&
+                         copy->n_faces() == mesh->n_faces() && copy_quality && copy_selected && copy_author &&
+                         copy_author[0] == "easy3d" && copy_quality.vector() == quality.vector() &&
+                         copy_selected.vector() == selected.vector() && copy_rotation;
+        for (auto f : mesh->faces()) {
+            for (int k = 0; k < 4; ++k)
+                identical = identical && copy_rotation[f][k] == rotation[f][k];
+        }
+        for (auto h : mesh->halfedges())
+            identical = identical && copy->target(h) == mesh->target(h) && copy->next(h) == mesh->next(h);
+        for (auto v : mesh->vertices())
+            identical = identical && copy->position(v) == mesh->position(v);
+        // new elements get the default value of the loaded property
+        identical = identical && copy_quality[copy->add_vertex(vec3(0, 0, 0))] == 0.5f;
+        const auto f = copy->add_triangle(copy->add_vertex(vec3(1, 0, 0)), copy->add_vertex(vec3(0, 1, 0)),
+                                          copy->add_vertex(vec3(0, 0, 1)));
+        identical = identical && copy_rotation[f][2] == 1.0f;
+        delete copy;
+        if (!identical) {
+            std::cerr << "the mesh loaded from the binary container differs from the saved one" << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "binary container round trip succeeded" << std::endl;
+
+        // The round trip of each format. The coordinates are written in binary, or in ASCII using the shortest
+        // decimal representation that reads back to the same float, so the vertices survive the round trip.
+        const std::vector<std::string> formats = {"ply", "ply (ASCII)", "obj", "off", "stl", "stl (ASCII)"};
+        for (const auto& format : formats) {
+            const std::string ext = format.substr(0, 3);
+            const bool binary = format.find("ASCII") == std::string::npos;
+            const std::string format_file_name = "./sphere-copy." + ext;
+            bool saved = false;
+            if (ext == "ply")
+                saved = io::save_ply(format_file_name, mesh, binary);
+            else if (ext == "stl")
+                saved = io::save_stl(format_file_name, mesh, binary);
+            else
+                saved = SurfaceMeshIO::save(format_file_name, mesh);
+            SurfaceMesh* loaded = saved ? SurfaceMeshIO::load(format_file_name) : nullptr;
+            file_system::delete_file(format_file_name);
+            if (!loaded) {
+                std::cerr << "failed to save/load the " << format << " file" << std::endl;
+                return EXIT_FAILURE;
+            }
+            bool same = loaded->n_faces() == mesh->n_faces();
+            if (ext != "stl") { // STL has no shared vertices (they are merged by the reader)
+                same = same && loaded->n_vertices() == mesh->n_vertices();
+                for (auto v : mesh->vertices())
+                    same = same && loaded->position(v) == mesh->position(v);
+            }
+            delete loaded;
+            if (!same) {
+                std::cerr << "the mesh loaded from the " << format << " file differs from the saved one" << std::endl;
+                return EXIT_FAILURE;
+            }
+            std::cout << format << " round trip succeeded" << std::endl;
+        }
+
+        delete mesh;
+    }
+
+    {   // revisions and the cache of derived data
+        SurfaceMesh mesh;
+        const std::size_t topology = mesh.topology_revision();
+        auto v0 = mesh.add_vertex(vec3(0, 0, 0));
+        auto v1 = mesh.add_vertex(vec3(1, 0, 0));
+        auto v2 = mesh.add_vertex(vec3(0, 1, 0));
+        auto f = mesh.add_triangle(v0, v1, v2);
+        if (mesh.topology_revision() <= topology || mesh.geometry_revision() < mesh.topology_revision()) {
+            std::cerr << "adding elements did not increase the revisions" << std::endl;
+            return EXIT_FAILURE;
+        }
+        // a topological operation increases the revision a few times (not once per modified link)
+        SurfaceMesh split(mesh);
+        const std::size_t before_split = split.topology_revision();
+        split.split(f, vec3(0.2f, 0.2f, 0));
+        const std::size_t increments = split.topology_revision() - before_split;
+        if (increments == 0 || increments > 8) {
+            std::cerr << "splitting a face increased the topology revision " << increments << " times" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        mesh.update_vertex_normals(true);
+        auto normals = mesh.get_vertex_property<vec3>("v:normal");
+        const std::size_t normal_revision = normals.array().revision();
+        mesh.update_vertex_normals(true);   // nothing changed: skipped
+        if (normals.array().revision() != normal_revision) {
+            std::cerr << "up-to-date vertex normals were recomputed" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        const float width = mesh.bounding_box().max_coord(0);
+        mesh.position(v1) = vec3(2, 0, 0);
+        mesh.position(v2) = vec3(0, 0, 1);
+        mesh.touch_geometry();
+        mesh.update_vertex_normals(true);   // the geometry changed: recomputed
+        if (normals.array().revision() == normal_revision || distance(normals[v0], vec3(0, -1, 0)) > 1e-6f ||
+            mesh.bounding_box().max_coord(0) == width) {
+            std::cerr << "derived data was not updated after the geometry changed" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        auto data = mesh.add_vertex_property<float>("v:data");
+        mesh.mark_up_to_date("data", &data.array(), true);
+        mesh.touch_geometry();      // "data" depends on the topology only
+        const bool up_to_date = mesh.is_up_to_date("data", &data.array());
+        data.array().touch();       // the data itself has been modified
+        const bool modified = !mesh.is_up_to_date("data", &data.array());
+        mesh.mark_up_to_date("data", &data.array(), true);
+        mesh.add_vertex(vec3(1, 1, 1));
+        const bool topology_changed = !mesh.is_up_to_date("data", &data.array());
+        mesh.mark_up_to_date("data", &data.array(), true);
+        mesh.mark_outdated("data");
+        if (!up_to_date || !modified || !topology_changed || mesh.is_up_to_date("data", &data.array())) {
+            std::cerr << "the cache of derived data is not correctly maintained" << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "revisions and derived data correctly maintained" << std::endl;
     }
 
     return EXIT_SUCCESS;
@@ -27,9 +27,11 @@
 #include <easy3d/core/point_cloud.h>
 #include <easy3d/core/surface_mesh.h>
 #include <easy3d/core/poly_mesh.h>
+#include <easy3d/algo/collider.h>
 #include <easy3d/algo/surface_mesh_components.h>
 #include <easy3d/algo/surface_mesh_curvature.h>
 #include <easy3d/algo/surface_mesh_enumerator.h>
+#include <easy3d/algo/surface_mesh_factory.h>
 #include <easy3d/algo/surface_mesh_fairing.h>
 #include <easy3d/algo/surface_mesh_geodesic.h>
 #include <easy3d/algo/surface_mesh_hole_filling.h>
@@ -45,6 +47,8 @@
 #include <easy3d/algo/surface_mesh_topology.h>
 #include <easy3d/algo/surface_mesh_triangulation.h>
 #include <easy3d/algo/surface_mesh_features.h>
+#include <easy3d/algo/surface_mesh_validation.h>
+#include <easy3d/algo/virtual_scanner.h>
 #include <easy3d/fileio/surface_mesh_io.h>
 #include <easy3d/util/resource.h>
 
@@ -151,6 +155,51 @@ bool test_algo_surface_mesh_curvature() {
 
     std::cout << "computing surface mesh max absolute curvatures..." << std::endl;
     analyzer.compute_max_abs_curvature();
+    delete mesh;
+
+    // the principal curvatures of a sphere are the inverse of its radius
+    mesh = SurfaceMeshIO::load(resource::directory() + "/data/sphere.obj");
+    if (!mesh) {
+        std::cerr << "Error: failed to load model. Please make sure the file exists and format is correct."
+                  << std::endl;
+        return false;
+    }
+    const vec3 center = mesh->bounding_box().center();
+    float radius = 0.0f;
+    for (auto v : mesh->vertices())
+        radius += distance(mesh->position(v), center);
+    radius /= static_cast<float>(mesh->n_vertices());
+
+    SurfaceMeshCurvature sphere_analyzer(mesh);
+    for (int method = 0; method < 2; ++method) {
+        if (method == 0)
+            sphere_analyzer.analyze_tensor(0, true);
+        else
+            sphere_analyzer.analyze(0);
+        double error = 0.0;
+        for (auto v : mesh->vertices()) {
+            const double kmin = std::abs(sphere_analyzer.min_curvature(v)) * radius;
+            const double kmax = std::abs(sphere_analyzer.max_curvature(v)) * radius;
+            error = std::max(error, std::max(std::abs(kmin - 1.0), std::abs(kmax - 1.0)));
+        }
+        std::cout << "max relative curvature error on a sphere: " << error << std::endl;
+        if (error > 0.2) {   // the sphere is coarse (42 vertices)
+            delete mesh;
+            return false;
+        }
+    }
+
+    // moving the vertices (without Model::touch_geometry()) must not give outdated curvatures
+    for (auto v : mesh->vertices())
+        mesh->position(v) = center + (mesh->position(v) - center) * 2.0f;
+    sphere_analyzer.analyze(0);
+    const auto v0 = *mesh->vertices().begin();
+    const double kmax = std::abs(sphere_analyzer.max_curvature(v0)) * radius * 2.0;
+    std::cout << "curvature after scaling the sphere: " << kmax << " (expected 1)" << std::endl;
+    if (std::abs(kmax - 1.0) > 0.2) {
+        delete mesh;
+        return false;
+    }
 
     delete mesh;
     return true;
@@ -509,8 +558,84 @@ bool test_algo_surface_mesh_subdivision() {
         delete mesh;
         return false;
     }
-
     delete mesh;
+
+    // checks the links between the halfedges, faces, and vertices
+    auto is_consistent = [](const SurfaceMesh *m) -> bool {
+        for (auto h : m->halfedges()) {
+            if (m->prev(m->next(h)) != h || m->face(m->next(h)) != m->face(h) ||
+                m->source(m->next(h)) != m->target(h) || m->opposite(m->opposite(h)) != h)
+                return false;
+        }
+        for (auto v : m->vertices()) {
+            if (m->source(m->out_halfedge(v)) != v || (m->is_border(v) && !m->is_border(m->out_halfedge(v))))
+                return false;
+        }
+        for (auto f : m->faces()) {
+            if (m->face(m->halfedge(f)) != f)
+                return false;
+        }
+        return true;
+    };
+
+    // the out-of-place subdivision results in the same mesh as the in-place one
+    const std::string open_file = resource::directory() + "/data/hemisphere.ply";
+    for (const std::string method : {"Loop", "CatmullClark"}) {
+        for (const auto &name : {file, open_file}) {
+            SurfaceMesh *in_place = SurfaceMeshIO::load(name);
+            SurfaceMesh *out_of_place = SurfaceMeshIO::load(name);
+            if (!in_place || !out_of_place) {
+                delete in_place;
+                delete out_of_place;
+                return false;
+            }
+            bool same = false;
+            if (method == "Loop")
+                same = SurfaceMeshSubdivision::loop(in_place) && SurfaceMeshSubdivision::loop(out_of_place, 1);
+            else
+                same = SurfaceMeshSubdivision::catmull_clark(in_place) &&
+                       SurfaceMeshSubdivision::catmull_clark(out_of_place, 1);
+            same = same && is_consistent(out_of_place) && in_place->n_vertices() == out_of_place->n_vertices() &&
+                   in_place->n_edges() == out_of_place->n_edges() && in_place->n_faces() == out_of_place->n_faces() &&
+                   in_place->points() == out_of_place->points();
+            delete in_place;
+            delete out_of_place;
+            if (!same) {
+                std::cerr << method << " subdivision out of place differs from the in-place one" << std::endl;
+                return false;
+            }
+        }
+
+        // several levels at once
+        mesh = SurfaceMeshIO::load(file);
+        for (unsigned int levels = 1; levels <= 2; ++levels) {
+            SurfaceMesh in_place(*mesh), out_of_place(*mesh);
+            for (unsigned int i = 0; i < levels; ++i) {
+                if (method == "Loop")
+                    SurfaceMeshSubdivision::loop(&in_place);
+                else
+                    SurfaceMeshSubdivision::catmull_clark(&in_place);
+            }
+            if (method == "Loop")
+                SurfaceMeshSubdivision::loop(&out_of_place, levels);
+            else
+                SurfaceMeshSubdivision::catmull_clark(&out_of_place, levels);
+            const Box3 &box = in_place.bounding_box();
+            const Box3 &refined_box = out_of_place.bounding_box();
+            const bool same = is_consistent(&out_of_place) && in_place.n_vertices() == out_of_place.n_vertices() &&
+                              in_place.n_edges() == out_of_place.n_edges() && in_place.n_faces() == out_of_place.n_faces() &&
+                              distance(box.min_point(), refined_box.min_point()) < 1e-5f &&
+                              distance(box.max_point(), refined_box.max_point()) < 1e-5f;
+            if (!same) {
+                std::cerr << method << " subdivision (" << levels << " levels) out of place differs from the in-place one"
+                          << std::endl;
+                delete mesh;
+                return false;
+            }
+        }
+        delete mesh;
+    }
+
     return true;
 }
 
@@ -557,6 +682,212 @@ bool test_algo_surface_mesh_triangulation() {
 }
 
 
+bool test_algo_surface_mesh_validation() {
+    std::cout << "validating and repairing surface mesh..." << std::endl;
+
+    SurfaceMesh mesh;
+    // a 4x4 grid (18 faces)
+    std::vector<SurfaceMesh::Vertex> grid;
+    for (int j = 0; j < 4; ++j) {
+        for (int i = 0; i < 4; ++i)
+            grid.push_back(mesh.add_vertex(vec3(i, j, 0)));
+    }
+    for (int j = 0; j < 3; ++j) {
+        for (int i = 0; i < 3; ++i) {
+            const auto v00 = grid[j * 4 + i], v10 = grid[j * 4 + i + 1];
+            const auto v01 = grid[j * 4 + i + 4], v11 = grid[j * 4 + i + 5];
+            mesh.add_triangle(v00, v10, v11);
+            mesh.add_triangle(v00, v11, v01);
+        }
+    }
+    // a degenerate face on the border of the grid
+    mesh.add_triangle(grid[1], grid[0], mesh.add_vertex(vec3(0.5f, 0, 0)));
+    // a strip of two faces touching the grid only at a corner (non-manifold vertex)
+    const auto a = mesh.add_vertex(vec3(4, 3.5f, 0));
+    const auto b = mesh.add_vertex(vec3(3.5f, 4, 0));
+    const auto c = mesh.add_vertex(vec3(4.5f, 4.5f, 0));
+    mesh.add_triangle(grid[15], a, c);
+    mesh.add_triangle(grid[15], c, b);
+    // a small component of a single face
+    mesh.add_triangle(mesh.add_vertex(vec3(10, 0, 0)), mesh.add_vertex(vec3(11, 0, 0)), mesh.add_vertex(vec3(10, 1, 0)));
+    // two faces with the same vertices
+    const auto p0 = mesh.add_vertex(vec3(20, 0, 0));
+    const auto p1 = mesh.add_vertex(vec3(21, 0, 0));
+    const auto p2 = mesh.add_vertex(vec3(20, 1, 0));
+    mesh.add_triangle(p0, p1, p2);
+    mesh.add_triangle(p0, p2, p1);
+    // two faces meeting at an unstitched edge
+    mesh.add_triangle(mesh.add_vertex(vec3(30, 0, 0)), mesh.add_vertex(vec3(31, 0, 0)), mesh.add_vertex(vec3(30, 1, 0)));
+    mesh.add_triangle(mesh.add_vertex(vec3(31, 0, 0)), mesh.add_vertex(vec3(30, 0, 0)), mesh.add_vertex(vec3(30, -1, 0)));
+    // an isolated vertex
+    mesh.add_vertex(vec3(50, 50, 50));
+
+    SurfaceMeshValidation validation(&mesh);
+    validation.set_min_component_size(2);
+    const auto &report = validation.validate();
+    std::cout << "    " << report.to_string() << std::endl;
+    if (report.isolated_vertices != 1 || report.non_manifold_vertices != 1 || report.degenerate_faces != 1 ||
+        report.duplicate_faces != 1 || report.unstitched_borders != 2 || report.incompatible_borders != 0 ||
+        report.components != 6 || report.small_components != 3 || report.small_component_faces != 3) {
+        std::cerr << "Error: unexpected validation report" << std::endl;
+        return false;
+    }
+
+    validation.repair();
+    // the remaining copy of the duplicate faces is a new small component
+    if (!validation.validate(SurfaceMeshValidation::ALL & ~SurfaceMeshValidation::SMALL_COMPONENTS).is_clean() ||
+        mesh.n_vertices() != 23 || mesh.n_faces() != 21) {
+        std::cerr << "Error: unexpected result of repair: " << validation.report().to_string() << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+bool test_algo_surface_mesh_collision_detection() {
+    const std::string file = resource::directory() + "/data/bunny.ply";
+    SurfaceMesh *mesh = SurfaceMeshIO::load(file);
+    if (!mesh) {
+        std::cerr << "Error: failed to load model. Please make sure the file exists and format is correct."
+                  << std::endl;
+        return false;
+    }
+
+    std::cout << "collision detection for a scene of 100 meshes..." << std::endl;
+    const float spacing = mesh->bounding_box().radius() * 0.9f;
+    SceneCollider collider;
+    for (int i = 0; i < 10; ++i) {
+        for (int j = 0; j < 10; ++j) {
+            const mat4 T = mat4::translation(vec3(i * spacing, j * spacing, 0)) * mat4::rotation(vec3(0, 0, 1), 0.1f * (i + j));
+            if (collider.add_mesh(mesh, T) < 0) {
+                delete mesh;
+                return false;
+            }
+        }
+    }
+
+    const auto contacts = collider.detect();
+    std::cout << contacts.size() << " pairs of colliding meshes" << std::endl;
+
+    // move a single mesh: only the pairs involving it are re-tested
+    collider.set_transform(0, mat4::translation(vec3(0, 0, spacing * 0.01f)) * collider.transform(0));
+    collider.detect();
+    const bool incremental = collider.num_narrow_phase_pairs() < collider.num_broad_phase_pairs();
+
+    // invalid ids are rejected
+    auto is_identity = [](const mat4 &m) -> bool {
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 4; ++j) {
+                if (m(i, j) != (i == j ? 1.0f : 0.0f))
+                    return false;
+            }
+        }
+        return true;
+    };
+    const bool checked = is_identity(collider.transform(-1)) && is_identity(collider.transform(100));
+
+    delete mesh;
+    return !contacts.empty() && incremental && checked;
+}
+
+
+bool test_algo_surface_mesh_virtual_scanner() {
+    // A cube (with half side length 'a') is scanned without noise, so the points must lie exactly on its faces.
+    const SurfaceMesh cube = SurfaceMeshFactory::hexahedron();
+    const float a = cube.position(SurfaceMesh::Vertex(6)).x;
+    VirtualScanner scanner;
+    scanner.add_mesh(&cube);
+
+    // The number of rays hitting the cube, computed by the slab test. Rays grazing the cube (within 'margin')
+    // may or may not hit it, so they are counted in 'max_hits' only.
+    auto count_hits = [a](const VirtualScanner::Sensor &sensor, std::size_t &min_hits, std::size_t &max_hits) {
+        const float margin = 1e-4f;
+        min_hits = max_hits = 0;
+        vec3 origin, dir;
+        for (std::size_t i = 0; i < sensor.num_rays(); ++i) {
+            sensor.ray(i, origin, dir);
+            for (float half : {a - margin, a + margin}) {
+                float t_min = 0.0f, t_max = std::numeric_limits<float>::max();
+                for (int k = 0; k < 3; ++k) {
+                    if (std::abs(dir[k]) < 1e-12f) {
+                        if (std::abs(origin[k]) > half)
+                            t_max = -1.0f;
+                        continue;
+                    }
+                    float t0 = (-half - origin[k]) / dir[k], t1 = (half - origin[k]) / dir[k];
+                    if (t0 > t1)
+                        std::swap(t0, t1);
+                    t_min = std::max(t_min, t0);
+                    t_max = std::min(t_max, t1);
+                }
+                if (t_min <= t_max) {
+                    if (half < a)
+                        ++min_hits;
+                    else
+                        ++max_hits;
+                }
+            }
+        }
+    };
+
+    // Scans the cube and checks the points: on the faces, with the normals facing the sensor, and with consistent
+    // ranges, intensities, and beams.
+    auto check = [&](const VirtualScanner::Sensor &sensor, const vec3 &position, const std::string &name) -> bool {
+        std::size_t min_hits = 0, max_hits = 0;
+        count_hits(sensor, min_hits, max_hits);
+        PointCloud *cloud = scanner.scan(sensor);
+        const std::size_t num = cloud ? cloud->n_vertices() : 0;
+        bool correct = cloud && num >= min_hits && num <= max_hits;
+        if (correct) {
+            auto normals = cloud->get_vertex_property<vec3>("v:normal");
+            auto intensities = cloud->get_vertex_property<float>("v:intensity");
+            auto ranges = cloud->get_vertex_property<float>("v:range");
+            auto beams = cloud->get_vertex_property<int>("v:beam");
+            auto meshes = cloud->get_vertex_property<int>("v:mesh");
+            correct = normals && intensities && ranges && beams && meshes;
+            for (auto v : cloud->vertices()) {
+                if (!correct)
+                    break;
+                const vec3 &p = cloud->position(v);
+                const vec3 &n = normals[v];
+                const float on_face = std::max(std::abs(p.x), std::max(std::abs(p.y), std::abs(p.z)));
+                const vec3 to_sensor = position - p;
+                correct = std::abs(on_face - a) < 1e-4f && std::abs(length(n) - 1.0f) < 1e-4f &&
+                          dot(n, to_sensor) > 0.0f && std::abs(ranges[v] - length(to_sensor)) < 1e-4f &&
+                          std::abs(intensities[v] - dot(n, normalize(to_sensor))) < 1e-4f &&
+                          intensities[v] >= 0.0f && intensities[v] <= 1.0f && beams[v] >= 0 && meshes[v] == 0;
+            }
+        }
+        std::cout << "virtual scanning (" << name << "): " << num << " points (" << sensor.num_rays() << " rays, "
+                  << min_hits << " to " << max_hits << " expected)" << std::endl;
+        delete cloud;
+        if (!correct)
+            std::cerr << "the points scanned by the " << name << " sensor are not correct" << std::endl;
+        return correct;
+    };
+
+    // inside the cube: every ray hits (the sensor is off-center, so no ray passes along the diagonals of the faces)
+    const vec3 inside(0.1f, -0.05f, 0.07f);
+    if (!check(VirtualScanner::PinholeSensor(inside, inside + vec3(1, 0.2f, 0), vec3(0, 0, 1), 60.0f, 64, 48),
+               inside, "pinhole, inside") ||
+        !check(VirtualScanner::SphericalSensor(inside, 72, 36), inside, "spherical, inside") ||
+        !check(VirtualScanner::MultiBeamSensor(inside, 32, -30.0f, 10.0f, 360), inside, "multi-beam, inside"))
+        return false;
+
+    // outside the cube: only a part of the rays hits
+    const vec3 outside(0.3f, -0.2f, 3.0f);
+    if (!check(VirtualScanner::PinholeSensor(outside, vec3(0, 0, 0), vec3(0, 1, 0), 60.0f, 64, 48),
+               outside, "pinhole, outside") ||
+        !check(VirtualScanner::SphericalSensor(outside, 360, 180), outside, "spherical, outside") ||
+        !check(VirtualScanner::MultiBeamSensor(vec3(2.5f, 0.1f, 0.2f), 64, -30.0f, 30.0f, 720),
+               vec3(2.5f, 0.1f, 0.2f), "multi-beam, outside"))
+        return false;
+
+    return true;
+}
+
+
 #ifdef HAS_CGAL
 
 int test_surface_mesh_remesh_self_intersections() {
@@ -731,6 +1062,15 @@ int test_surface_mesh_algorithms() {
     if (!test_algo_surface_mesh_triangulation())
         return EXIT_FAILURE;
 
+    if (!test_algo_surface_mesh_validation())
+        return EXIT_FAILURE;
+
+    if (!test_algo_surface_mesh_collision_detection())
+        return EXIT_FAILURE;
+
+    if (!test_algo_surface_mesh_virtual_scanner())
+        return EXIT_FAILURE;
+
 #ifdef HAS_CGAL
     if (!test_surface_mesh_remesh_self_intersections())
         return EXIT_FAILURE;
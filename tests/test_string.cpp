@@ -0,0 +1,179 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#include <easy3d/util/string.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <limits>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+
+
+using namespace easy3d;
+
+
+namespace {
+
+    uint32_t bits_of(float value) {
+        uint32_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(float));
+        return bits;
+    }
+
+    float float_of(uint32_t bits) {
+        float value = 0.0f;
+        std::memcpy(&value, &bits, sizeof(float));
+        return value;
+    }
+
+    // The number of significant digits of the shortest "%.*g" output that reads back to the same float.
+    int shortest_printf_digits(float value) {
+        char buffer[64];
+        for (int digits = 1; digits < 9; ++digits) {
+            std::snprintf(buffer, sizeof(buffer), "%.*g", digits, value);
+            if (std::strtof(buffer, nullptr) == value)
+                return digits;
+        }
+        return 9;
+    }
+
+    // The number of significant digits of a decimal written by to_chars(), e.g., 3 for "-1.25e-05".
+    int significant_digits(const std::string &text) {
+        int digits = 0;
+        bool leading = true;
+        int trailing_zeros = 0;
+        for (char c : text) {
+            if (c == 'e')
+                break;
+            if (c < '0' || c > '9')
+                continue;
+            if (leading && c == '0')
+                continue;
+            leading = false;
+            ++digits;
+            trailing_zeros = (c == '0') ? trailing_zeros + 1 : 0;
+        }
+        return digits - trailing_zeros;
+    }
+
+    // Writes a float and parses it back. Returns false if it does not read back to the same bits, or if it is
+    // longer than the shortest round-tripping output of printf().
+    bool round_trip(float value, bool check_shortest) {
+        char buffer[32];
+        const std::size_t n = string::to_chars(buffer, value);
+        const std::string text(buffer, n);
+        const float parsed = std::strtof(text.c_str(), nullptr);
+        if (bits_of(parsed) != bits_of(value)) {
+            std::cerr << "to_chars(" << bits_of(value) << ") wrote \"" << text << "\", which reads back to "
+                      << bits_of(parsed) << std::endl;
+            return false;
+        }
+        if (check_shortest && significant_digits(text) > shortest_printf_digits(value)) {
+            std::cerr << "to_chars() wrote \"" << text << "\", which is not the shortest representation" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+}
+
+
+int test_string() {
+    // the values at the limits of the float range and special values
+    std::vector<float> values = {
+            0.0f, -0.0f, 1.0f, -1.0f, 0.1f, 0.2f, 0.3f, 1.0f / 3.0f, 2.0f / 3.0f, 3.14159265f, 1e-4f, 1e8f, 1e9f,
+            123456789.0f, 16777216.0f, 16777217.0f, 0.000099999997f, 99999999.0f,
+            std::numeric_limits<float>::min(),          // the smallest normal
+            std::numeric_limits<float>::max(),
+            std::numeric_limits<float>::lowest(),
+            std::numeric_limits<float>::denorm_min(),   // the smallest subnormal
+            std::numeric_limits<float>::epsilon(),
+            float_of(0x007fffffu),                      // the largest subnormal
+            float_of(0x7f7ffffeu),                      // the neighbor of the largest float
+    };
+    // the powers of 2 and 10 (and their neighbors) over the whole exponent range
+    for (int e = -149; e <= 127; ++e)
+        values.push_back(std::ldexp(1.0f, e));
+    for (int e = -45; e <= 38; ++e)
+        values.push_back(std::strtof(("1e" + std::to_string(e)).c_str(), nullptr));
+    const std::size_t num_exact = values.size();
+    for (std::size_t i = 0; i < num_exact; ++i) {
+        const uint32_t bits = bits_of(values[i]) & 0x7fffffffu;
+        if (bits > 0)
+            values.push_back(float_of(bits - 1));
+        if (bits < 0x7f7fffffu)
+            values.push_back(float_of(bits + 1));
+    }
+
+    bool success = true;
+    for (float v : values) {
+        success = round_trip(v, true) && success;
+        success = round_trip(-v, true) && success;
+    }
+
+    // random bit patterns (all finite floats are equally likely)
+    std::mt19937 rng(0);
+    std::uniform_int_distribution<uint32_t> distribution(0, 0xffffffffu);
+    std::size_t num_random = 0;
+    while (num_random < 200000) {
+        const float v = float_of(distribution(rng));
+        if (std::isnan(v) || std::isinf(v))
+            continue;
+        success = round_trip(v, num_random < 20000) && success;     // printf() is slow
+        ++num_random;
+    }
+
+    // non-finite values
+    char buffer[32];
+    success = std::string(buffer, string::to_chars(buffer, std::numeric_limits<float>::infinity())) == "inf" && success;
+    success = std::string(buffer, string::to_chars(buffer, -std::numeric_limits<float>::infinity())) == "-inf" && success;
+    success = std::string(buffer, string::to_chars(buffer, std::numeric_limits<float>::quiet_NaN())) == "nan" && success;
+
+    // doubles and integers
+    for (double v : {0.1, -1.0 / 3.0, std::numeric_limits<double>::max(), std::numeric_limits<double>::min(),
+                     std::numeric_limits<double>::denorm_min(), -std::numeric_limits<double>::lowest()}) {
+        const std::string text(buffer, string::to_chars(buffer, v));
+        success = std::strtod(text.c_str(), nullptr) == v && success;
+    }
+    for (int v : {0, 1, -1, 9, 10, -10, 123456789, INT_MAX, INT_MIN}) {
+        const std::string text(buffer, string::to_chars(buffer, v));
+        success = text == std::to_string(v) && success;
+    }
+
+    if (!success) {
+        std::cerr << "string::to_chars() failed the round trip test" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "string::to_chars(): " << values.size() * 2 + num_random << " floats read back exactly" << std::endl;
+    return EXIT_SUCCESS;
+}
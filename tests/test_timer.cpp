@@ -26,10 +26,16 @@
 
 
 #include <easy3d/util/timer.h>
+#include <easy3d/util/thread_pool.h>
 
 #include <iostream>
 #include <string>
 #include <mutex>
+#include <thread>
+#include <atomic>
+#include <numeric>
+#include <vector>
+#include <stdexcept>
 
 std::mutex mutex;
 
@@ -253,7 +259,125 @@ void test_timer_for_lambda_functions(Car *car) {
 }
 
 
+bool test_thread_pool(unsigned int num_threads) {
+    ThreadPool::initialize(num_threads);
+    std::cout << "thread pool with " << ThreadPool::instance()->num_threads() << " threads\n";
+
+    // parallel_for: each index is visited exactly once
+    const int n = 100000;
+    std::vector<int> visits(n, 0);
+    parallel_for(0, n, [&](int i) { ++visits[i]; }, 1000);
+    for (int i = 0; i < n; ++i) {
+        if (visits[i] != 1) {
+            std::cerr << "parallel_for visited index " << i << " " << visits[i] << " times" << std::endl;
+            return false;
+        }
+    }
+
+    // parallel_reduce: the result is deterministic
+    std::vector<double> values(n);
+    for (int i = 0; i < n; ++i)
+        values[i] = 1.0 / (i + 1.0);
+    auto partial_sum = [&](int first, int last) { return std::accumulate(values.begin() + first, values.begin() + last, 0.0); };
+    auto plus = [](double a, double b) { return a + b; };
+    const double sum = parallel_reduce(0, n, 0.0, partial_sum, plus, 997);
+    double expected = 0.0;  // the same chunks combined in the same order
+    for (int first = 0; first < n; first += 997)
+        expected += std::accumulate(values.begin() + first, values.begin() + std::min(first + 997, n), 0.0);
+    if (sum != expected) {
+        std::cerr << "parallel_reduce is not deterministic: " << sum << " vs. " << expected << std::endl;
+        return false;
+    }
+
+    // nested parallelism does not deadlock
+    std::atomic<int> count(0);
+    parallel_for(0, 16, [&](int) {
+        parallel_for(0, 100, [&](int) { ++count; }, 10);
+    }, 1);
+    if (count != 1600) {
+        std::cerr << "nested parallel_for executed " << count << " tasks (expected 1600)" << std::endl;
+        return false;
+    }
+
+    // canceled groups skip the pending tasks, and the first exception is rethrown by wait()
+    TaskGroup group;
+    group.cancel();
+    bool executed = false;
+    group.run([&]() { executed = true; });
+    group.wait();
+    if (executed) {
+        std::cerr << "a task of a canceled group was executed" << std::endl;
+        return false;
+    }
+    TaskGroup failing_group;
+    failing_group.run([]() { throw std::runtime_error("expected failure"); });
+    try {
+        failing_group.wait();
+        std::cerr << "the exception of the task was not rethrown" << std::endl;
+        return false;
+    }
+    catch (const std::runtime_error &) {
+    }
+
+    // waiting for a group executes only the tasks of that group
+    std::atomic<bool> foreign_done(false);
+    std::thread::id foreign_thread;
+    ThreadPool::instance()->submit([&]() {
+        foreign_thread = std::this_thread::get_id();
+        foreign_done = true;
+    });
+    parallel_for(0, 64, [&](int) { std::this_thread::sleep_for(std::chrono::microseconds(100)); }, 1);
+    while (!foreign_done)
+        std::this_thread::yield();
+    if (foreign_thread == std::this_thread::get_id()) {
+        std::cerr << "a task of the pool was executed by a thread waiting for another group" << std::endl;
+        return false;
+    }
+
+    // a blocking timer function delays neither the compute tasks nor the other timers
+    std::atomic<bool> blocking_started(false);
+    Timer<>::single_shot(1, [&]() {
+        blocking_started = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    });
+    while (!blocking_started)
+        std::this_thread::yield();
+    const auto start = std::chrono::steady_clock::now();
+    std::atomic<bool> other_fired(false);
+    Timer<>::single_shot(1, [&]() { other_fired = true; });
+    parallel_for(0, 64, [&](int) { std::this_thread::sleep_for(std::chrono::microseconds(100)); }, 1);
+    while (!other_fired && std::chrono::steady_clock::now() - start < std::chrono::seconds(1))
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    if (!other_fired || std::chrono::steady_clock::now() - start > std::chrono::milliseconds(250)) {
+        std::cerr << "a blocking timer function delayed the other tasks" << std::endl;
+        return false;
+    }
+
+    // many timers share a few threads and a stopped timer does not fire any more
+    std::atomic<int> fired(0);
+    for (int i = 0; i < 1000; ++i)
+        Timer<>::single_shot(10 + i % 20, [&]() { ++fired; });
+    Timer<> interval_timer;
+    std::atomic<int> ticks(0);
+    interval_timer.set_interval(5, [&]() { ++ticks; });
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    interval_timer.stop();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    const int stopped_ticks = ticks;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    if (fired != 1000 || stopped_ticks == 0 || ticks != stopped_ticks) {
+        std::cerr << "timers fired " << fired << " (expected 1000) and " << ticks << " ticks" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
 int test_timer() {
+    // the number of threads is also tested explicitly because it may be 1 for the default (on a single core)
+    if (!test_thread_pool(4) || !test_thread_pool(0))
+        return EXIT_FAILURE;
+
     Car car(100);
 
     std::cout << "triggers a class member ------------------------------------------------------------------\n";
@@ -0,0 +1,136 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#include <easy3d/viewer/viewer.h>
+#include <easy3d/renderer/drawable_batch.h>
+#include <easy3d/util/resource.h>
+#include <easy3d/core/types.h>
+#include <easy3d/util/timer.h>
+
+using namespace easy3d;
+
+
+int test_batching(int duration) {
+    Viewer viewer("Batching");
+
+    const std::vector<vec3> &points = resource::bunny_vertices;
+    const std::vector<unsigned int> &indices = resource::bunny_indices;
+    const Box3 &box = geom::bounding_box<Box3, std::vector<vec3> >(points);
+    const float step = box.diagonal_length();
+
+    // A grid of bunnies, all sharing the same rendering state, so they can be rendered by a single batch.
+    // There are enough of them to make the arenas grow.
+    const int rows = 16, cols = 16;
+    std::vector<std::shared_ptr<TrianglesDrawable> > bunnies;
+    DrawableBatcher batcher;
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            std::vector<vec3> translated(points);
+            for (auto &p : translated)
+                p += vec3(static_cast<float>(j) * step, static_cast<float>(i) * step, 0.0f);
+            std::shared_ptr<TrianglesDrawable> bunny(new TrianglesDrawable("bunny_" + std::to_string(bunnies.size())));
+            bunny->update_vertex_buffer(translated);
+            bunny->update_element_buffer(indices);
+            bunny->set_uniform_coloring(vec4(0.8f, 0.6f, 0.2f, 1.0f));
+            if (!batcher.add(bunny.get())) {
+                std::cerr << "failed adding " << bunny->name() << " to a batch" << std::endl;
+                return EXIT_FAILURE;
+            }
+            bunnies.push_back(bunny);
+        }
+    }
+    if (batcher.batches().size() != 1) {
+        std::cerr << "compatible drawables are in " << batcher.batches().size() << " batches" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    TrianglesBatch *batch = batcher.batch(bunnies.front().get());
+    const std::size_t vertex_capacity = batch->vertex_capacity();
+    const std::size_t index_capacity = batch->index_capacity();
+    // the arenas start with 65536 vertices and 3 * 65536 indices
+    if (batch->num_drawables() != bunnies.size() || vertex_capacity < bunnies.size() * points.size() ||
+        index_capacity < bunnies.size() * indices.size() || vertex_capacity <= 65536 || index_capacity <= 3 * 65536) {
+        std::cerr << "the arenas did not grow: " << vertex_capacity << " vertices, " << index_capacity << " indices"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Removing and adding back a row of bunnies reuses the released ranges of the arenas.
+    for (int j = 0; j < cols; ++j)
+        batcher.remove(bunnies[j].get());
+    if (batch->num_drawables() != bunnies.size() - cols || batch->contains(bunnies.front().get())) {
+        std::cerr << "failed removing drawables from the batch" << std::endl;
+        return EXIT_FAILURE;
+    }
+    for (int j = 0; j < cols; ++j) {
+        if (batcher.add(bunnies[j].get()) != batch) {
+            std::cerr << "failed adding back " << bunnies[j]->name() << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    if (batch->num_drawables() != bunnies.size() || batch->vertex_capacity() != vertex_capacity ||
+        batch->index_capacity() != index_capacity) {
+        std::cerr << "the released ranges of the arenas were not reused" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Hide the bunnies on the diagonal.
+    for (int i = 0; i < rows; ++i)
+        batcher.set_visible(bunnies[i * cols + i].get(), false);
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            if (batch->is_drawable_visible(bunnies[i * cols + j].get()) != (i != j)) {
+                std::cerr << "wrong visibility of " << bunnies[i * cols + j]->name() << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    // A drawable with a different color cannot join the batch.
+    std::shared_ptr<TrianglesDrawable> red(new TrianglesDrawable("red_bunny"));
+    std::vector<vec3> translated(points);
+    for (auto &p : translated)
+        p += vec3(-step, -step, 0.0f);
+    red->update_vertex_buffer(translated);
+    red->update_element_buffer(indices);
+    red->set_uniform_coloring(vec4(1.0f, 0.0f, 0.0f, 1.0f));
+    if (batcher.add(red.get()) == batch || batcher.batches().size() != 2) {
+        std::cerr << "an incompatible drawable was added to the batch" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // The batches are rendered by the viewer (the bunnies themselves are not added to the viewer).
+    for (const auto &b : batcher.batches())
+        viewer.add_drawable(b);
+
+    // Make sure everything is within the visible region of the viewer.
+    viewer.fit_screen();
+
+    viewer.set_usage("testing batching...");
+
+    Timer<>::single_shot(duration, (Viewer*)&viewer, &Viewer::exit);
+    return viewer.run();
+}
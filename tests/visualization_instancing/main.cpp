@@ -0,0 +1,90 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#include <easy3d/viewer/viewer.h>
+#include <easy3d/renderer/camera.h>
+#include <easy3d/renderer/drawable_instanced.h>
+#include <easy3d/gui/picker_instance.h>
+#include <easy3d/algo/surface_mesh_factory.h>
+#include <easy3d/util/timer.h>
+
+using namespace easy3d;
+
+
+int test_instancing(int duration) {
+    // The prototype must outlive the drawable (which is owned by the viewer).
+    SurfaceMesh sphere = SurfaceMeshFactory::icosphere(2);
+
+    Viewer viewer("Instancing");
+
+    // A grid of spheres, all rendered by a single instanced draw call.
+    const int rows = 20, cols = 20;
+    auto drawable = new InstancedDrawable("spheres", &sphere);
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            const vec3 center(static_cast<float>(j) * 3.0f, static_cast<float>(i) * 3.0f, 0.0f);
+            const vec4 color(static_cast<float>(j) / cols, static_cast<float>(i) / rows, 0.8f, 1.0f);
+            // the ids are not the indices of the instances
+            drawable->add_instance(mat4::translation(center), color, 1000 + i * cols + j);
+        }
+    }
+    drawable->set_per_instance_coloring(true);
+    // hide an instance, so the instances uploaded to the GPU are not all the instances
+    drawable->set_instance_visible(0, false);
+    viewer.add_drawable(std::shared_ptr<InstancedDrawable>(drawable));
+
+    // Make sure everything is within the visible region of the viewer.
+    viewer.fit_screen();
+
+    // Pick an instance at the projection of its center (once the viewer is running).
+    const std::size_t target = (rows / 2) * cols + cols / 2;
+    bool picked = false, correct = false;
+    viewer.animation_func_ = [&](Viewer *v) -> bool {
+        if (picked)
+            return false;
+        picked = true;
+        const vec3 center = drawable->instance_transform(target) * vec3(0.0f, 0.0f, 0.0f);
+        const vec3 p = v->camera()->projectedCoordinatesOf(center);
+        InstancePicker picker(v->camera());
+        const int index = picker.pick(drawable, static_cast<int>(p.x), static_cast<int>(p.y));
+        correct = (index == static_cast<int>(target)) &&
+                  (drawable->instance_id(index) == 1000 + static_cast<int>(target));
+        if (correct) {
+            // highlight the picked instance
+            drawable->set_instance_color(index, vec4(1.0f, 0.0f, 0.0f, 1.0f));
+            v->update();
+        } else
+            std::cerr << "picked instance " << index << " instead of " << target << std::endl;
+        return true;
+    };
+    viewer.set_animation(true);
+
+    viewer.set_usage("testing instancing...");
+
+    Timer<>::single_shot(duration, (Viewer*)&viewer, &Viewer::exit);
+    const int result = viewer.run();
+    return correct ? result : EXIT_FAILURE;
+}
@@ -25,11 +25,16 @@
  ********************************************************************/
 
 #include <easy3d/core/point_cloud.h>
+#include <easy3d/core/point_kernels.h>
+#include <easy3d/core/random.h>
 #include <easy3d/util/initializer.h>
+#include <easy3d/util/stop_watch.h>
 
 /**
  * \example{lineno} Tutorial_101_PointCloud/main.cpp
- * This example shows how to create a point cloud from a set of points
+ * This example shows how to
+ *      - create a point cloud from a set of points;
+ *      - process the points with the vectorized kernels (and compare their time with the scalar code).
  */
 
 
@@ -53,5 +58,45 @@ int main(int argc, char** argv) {
 	// Delete the point cloud (i.e., release memory)
 	delete cloud;
 
+    // The kernels process large sets of points using the best instruction set of the CPU (e.g., AVX2). Here we
+    // time them on 4M random points, with the scalar code and with the best instruction set.
+    std::vector<vec3> points(1 << 22);
+    for (auto &p: points)
+        p = vec3(random_float(-10, 10), random_float(-10, 10), random_float(-10, 10));
+    const mat4 m = mat4::translation(vec3(1, 0, 0)) * mat4::rotation(vec3(0, 0, 1), 0.5f);
+    const Plane3 plane(vec3(1, 2, 3), normalize(vec3(1, -1, 2)));
+    std::vector<vec2> projected;
+    std::vector<float> distances;
+    const kernels::SoAPoints soa(points);
+    const kernels::InstructionSet best = kernels::best_instruction_set();
+    for (auto isa : {kernels::SCALAR, best}) {
+        kernels::set_instruction_set(isa);
+        std::cout << kernels::instruction_set_name(isa) << " (" << points.size() << " points):";
+        StopWatch w;
+        kernels::bounding_box(points);
+        std::cout << " bbox " << w.time_string(2);
+        w.restart();
+        kernels::translate(points, vec3(1, 2, 3));
+        std::cout << ", translate " << w.time_string(2);
+        w.restart();
+        kernels::transform(points, m);
+        std::cout << ", transform " << w.time_string(2);
+        w.restart();
+        kernels::project(points, m, projected);
+        std::cout << ", project " << w.time_string(2);
+        w.restart();
+        kernels::distance_to_plane(points, plane, distances);
+        std::cout << ", distance " << w.time_string(2);
+        w.restart();
+        kernels::normalize(points);
+        std::cout << ", normalize " << w.time_string(2);
+        w.restart();
+        kernels::bounding_box(soa);
+        std::cout << ", bbox (SoA) " << w.time_string(2);
+        w.restart();
+        kernels::distance_to_plane(soa, plane, distances);
+        std::cout << ", distance (SoA) " << w.time_string(2) << std::endl;
+    }
+
     return EXIT_SUCCESS;
 }
@@ -28,10 +28,13 @@
 #include <easy3d/fileio/point_cloud_io.h>
 #include <easy3d/util/resource.h>
 #include <easy3d/util/initializer.h>
+#include <easy3d/util/file_system.h>
+#include <easy3d/util/stop_watch.h>
 
 /**
  * \example{lineno} Tutorial_103_PointCloud_IO/main.cpp
- * This example shows how to load a point cloud from a file and save a point cloud to a file.
+ * This example shows how to load a point cloud from a file and save a point cloud to a file. It also compares the
+ * save throughput of the supported formats.
  */
 
 
@@ -75,6 +78,20 @@ int main(int argc, char** argv) {
         std::cout << "point cloud saved to './bunny-copy.txt'" << std::endl;
     }
 
+    // The time to save the point cloud in each format (the temporary files are deleted).
+    for (const std::string ext : {"ply", "bxyz", "xyz"}) {
+        const std::string format_file_name = "./bunny-copy-timing." + ext;
+        StopWatch w;
+        if (!PointCloudIO::save(format_file_name, cloud)) {
+            std::cerr << "failed to save the point cloud in the " << ext << " format" << std::endl;
+            continue;
+        }
+        const double seconds = w.elapsed_seconds(5);
+        const double megabytes = static_cast<double>(file_system::file_size(format_file_name)) / (1 << 20);
+        std::cout << ext << ": " << megabytes << " MB saved in " << seconds << " seconds" << std::endl;
+        file_system::delete_file(format_file_name);
+    }
+
     // Delete the point cloud (i.e., release memory)
     delete cloud;
 
@@ -28,12 +28,15 @@
 #include <easy3d/fileio/surface_mesh_io.h>
 #include <easy3d/util/resource.h>
 #include <easy3d/util/initializer.h>
+#include <easy3d/util/file_system.h>
+#include <easy3d/util/stop_watch.h>
 
 /**
  * \example{lineno} Tutorial_107_SurfaceMesh_IO/main.cpp
  * This example shows how to
  *      - load a surface mesh from a file;
- *      - save a surface mesh into a file.
+ *      - save a surface mesh into a file;
+ *      - compare the save throughput of the supported formats.
  */
 
 using namespace easy3d;
@@ -66,6 +69,20 @@ int main(int argc, char** argv) {
     else
         std::cerr << "failed create the new file" << std::endl;
 
+    // The time to save the mesh in each format (the temporary files are deleted).
+    for (const std::string ext : {"ply", "obj", "off", "stl"}) {
+        const std::string format_file_name = "./sphere-copy-timing." + ext;
+        StopWatch w;
+        if (!SurfaceMeshIO::save(format_file_name, mesh)) {
+            std::cerr << "failed to save the mesh in the " << ext << " format" << std::endl;
+            continue;
+        }
+        const double seconds = w.elapsed_seconds(5);
+        const double megabytes = static_cast<double>(file_system::file_size(format_file_name)) / (1 << 20);
+        std::cout << ext << ": " << megabytes << " MB saved in " << seconds << " seconds" << std::endl;
+        file_system::delete_file(format_file_name);
+    }
+
 	// delete the mesh (i.e., release memory)
 	delete mesh;
 
@@ -31,6 +31,7 @@
 #include <easy3d/core/surface_mesh.h>
 #include <easy3d/renderer/text_renderer.h>
 #include <easy3d/renderer/camera.h>
+#include <easy3d/renderer/frame_profiler.h>
 
 #include <3rd_party/glfw/include/GLFW/glfw3.h>  // for glfw functions
 
@@ -191,6 +192,15 @@ namespace easy3d {
 			ImGui::End();
 		}
 
+        if (show_profiler_) {
+            ImGui::SetNextWindowPos(ImVec2(10.0f, menu_height_ + 10.0f), ImGuiCond_FirstUseEver);
+            ImGui::Begin("Frame Profiler", &show_profiler_, ImGuiWindowFlags_AlwaysAutoResize);
+            for (const auto& line : FrameProfiler::instance()->report())
+                ImGui::TextUnformatted(line.c_str());
+            ImGui::End();
+            FrameProfiler::instance()->set_enabled(show_profiler_);
+        }
+
         ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(5, 8));
         if (ImGui::BeginMainMenuBar())
 		{
@@ -210,13 +220,17 @@ namespace easy3d {
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData()); 
 
         // workaround to draw the Easy3D logo and framerate at a different location (due to the menu bar)
+        // the profiler is shown in an ImGui window
         auto show_logo = show_easy3d_logo_;
         auto show_fps = show_frame_rate_;
+        auto show_profiler = show_profiler_;
         show_easy3d_logo_ = false;
         show_frame_rate_ = false;
+        show_profiler_ = false;
         Viewer::post_draw();
         show_easy3d_logo_ = show_logo;
         show_frame_rate_ = show_fps;
+        show_profiler_ = show_profiler;
 
         // draw Easy3D logo (on the right side)
         if (texter_) {
@@ -259,6 +273,9 @@ namespace easy3d {
             if (ImGui::MenuItem("Snapshot", nullptr))
                 snapshot();
 
+            if (ImGui::MenuItem("Frame Profiler", "F3", &show_profiler_))
+                FrameProfiler::instance()->set_enabled(show_profiler_);
+
             ImGui::EndMenu();
         }
     }
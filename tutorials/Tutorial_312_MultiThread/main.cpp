@@ -46,9 +46,15 @@ void edit_model(PointCloud *cloud, Viewer *viewer) {
     if (cloud->n_vertices() >= 1000000) // stop growing when the model is too big
         return;
 
+    // add the points at once, which is faster than adding them one by one
+    std::vector<vec3> points(100);
+    for (auto& p : points)
+        p = vec3(random_float(), random_float(), random_float());
+    auto first = cloud->add_vertices(points);
+
     auto colors = cloud->vertex_property<vec3>("v:color");
     for (int i = 0; i < 100; ++i) {
-        auto v = cloud->add_vertex(vec3(random_float(), random_float(), random_float()));
+        const PointCloud::Vertex v(first.idx() + i);
         colors[v] = vec3(random_float(), random_float(), random_float()); // we use a random color
     }
 
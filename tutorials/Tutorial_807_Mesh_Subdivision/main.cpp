@@ -0,0 +1,90 @@
+/********************************************************************
+ * Copyright (C) 2015 Liangliang Nan <liangliang.nan@gmail.com>
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++ library
+ *      for processing and rendering 3D data.
+ *      Journal of Open Source Software, 6(64), 3255, 2021.
+ * ------------------------------------------------------------------
+ *
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ ********************************************************************/
+
+#include <easy3d/core/surface_mesh.h>
+#include <easy3d/fileio/surface_mesh_io.h>
+#include <easy3d/algo/surface_mesh_subdivision.h>
+#include <easy3d/util/resource.h>
+#include <easy3d/util/initializer.h>
+#include <easy3d/util/stop_watch.h>
+
+/**
+ * \example{lineno} Tutorial_807_Mesh_Subdivision/main.cpp
+ * This example shows how to
+ *      - subdivide a surface mesh (Loop and Catmull-Clark);
+ *      - apply several levels of subdivision at once, and compare the time with subdividing level by level.
+ */
+
+using namespace easy3d;
+
+
+int main(int argc, char** argv) {
+    // initialize Easy3D.
+    initialize();
+
+    const std::string file_name = resource::directory() + "/data/sphere.obj";
+    SurfaceMesh* mesh = SurfaceMeshIO::load(file_name);
+    if (!mesh) {
+        LOG(ERROR) << "failed to load model. Please make sure the file exists and format is correct.";
+        return EXIT_FAILURE;
+    }
+    // a finer mesh to have measurable times
+    SurfaceMeshSubdivision::loop(mesh, 2);
+    std::cout << "mesh loaded and subdivided. faces: " << mesh->n_faces() << std::endl;
+
+    for (const std::string method : {"Loop", "CatmullClark"}) {
+        for (unsigned int levels = 1; levels <= 4; ++levels) {
+            // each level in place, i.e., the connectivity of the mesh is modified level by level
+            SurfaceMesh in_place(*mesh);
+            StopWatch w;
+            for (unsigned int i = 0; i < levels; ++i) {
+                if (method == "Loop")
+                    SurfaceMeshSubdivision::loop(&in_place);
+                else
+                    SurfaceMeshSubdivision::catmull_clark(&in_place);
+            }
+            const double in_place_time = w.elapsed_seconds(5);
+
+            // all levels at once, i.e., the subdivided mesh is generated out of place
+            SurfaceMesh out_of_place(*mesh);
+            w.restart();
+            if (method == "Loop")
+                SurfaceMeshSubdivision::loop(&out_of_place, levels);
+            else
+                SurfaceMeshSubdivision::catmull_clark(&out_of_place, levels);
+            const double out_of_place_time = w.elapsed_seconds(5);
+
+            std::cout << method << " subdivision, " << levels << " level(s), " << out_of_place.n_faces() << " faces: "
+                      << in_place_time << " seconds level by level, " << out_of_place_time << " seconds at once"
+                      << std::endl;
+        }
+    }
+
+    // delete the mesh (i.e., release memory)
+    delete mesh;
+
+    return EXIT_SUCCESS;
+}